@@ -840,6 +840,7 @@ rm -rf %{buildroot}%{_libdir}/ecore/system/upower
 %{_bindir}/efreetd
 %{_libdir}/efreet/*/efreet_desktop_cache_create
 %{_libdir}/efreet/*/efreet_icon_cache_create
+%{_libdir}/efreet/*/efreet_mime_cache_create
 %{_libdir}/libefreet.so.*
 %{_libdir}/libefreet_mime.so.*
 %{_libdir}/libefreet_trash.so.*
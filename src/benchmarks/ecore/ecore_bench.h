@@ -0,0 +1,6 @@
+#ifndef ECORE_BENCH_H_
+#define ECORE_BENCH_H_
+
+void ecore_bench_timer(Eina_Benchmark *bench);
+
+#endif
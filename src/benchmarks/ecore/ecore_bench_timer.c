@@ -0,0 +1,102 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdlib.h>
+
+#include <Eina.h>
+
+#include "Ecore.h"
+#include "ecore_bench.h"
+
+static int fired = 0;
+
+static Eina_Bool
+_timer_cb(void *data EINA_UNUSED)
+{
+   fired++;
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static Ecore_Timer **
+_timers_add(int request, double base)
+{
+   Ecore_Timer **timers;
+   int i;
+
+   timers = malloc(request * sizeof (Ecore_Timer *));
+   if (!timers) return NULL;
+
+   srand(request);
+   for (i = 0; i < request; i++)
+     timers[i] = ecore_timer_add(base + (rand() % 10000) / 1000.0,
+                                 _timer_cb, NULL);
+   return timers;
+}
+
+static void
+bench_timer_add_del(int request)
+{
+   Ecore_Timer **timers;
+   int i;
+
+   timers = _timers_add(request, 60.0);
+   if (!timers) return;
+
+   for (i = 0; i < request; i++)
+     ecore_timer_del(timers[i]);
+
+   /* let the main loop reclaim the deleted timers */
+   ecore_main_loop_iterate();
+   free(timers);
+}
+
+static void
+bench_timer_delay(int request)
+{
+   Ecore_Timer **timers;
+   int i;
+
+   timers = _timers_add(request, 60.0);
+   if (!timers) return;
+
+   /* move every timer once into the loop's schedule then shuffle them */
+   ecore_main_loop_iterate();
+   for (i = 0; i < request; i++)
+     ecore_timer_delay(timers[i], (rand() % 1000) / 1000.0);
+   for (i = 0; i < request; i++)
+     ecore_timer_reset(timers[i]);
+
+   for (i = 0; i < request; i++)
+     ecore_timer_del(timers[i]);
+   ecore_main_loop_iterate();
+   free(timers);
+}
+
+static void
+bench_timer_fire(int request)
+{
+   Ecore_Timer **timers;
+   int i;
+
+   fired = 0;
+   timers = _timers_add(request, 0.0);
+   if (!timers) return;
+
+   /* pull every timer into the past so they all expire in shuffled order */
+   for (i = 0; i < request; i++)
+     ecore_timer_delay(timers[i], -20.0);
+   while (fired < request)
+     ecore_main_loop_iterate();
+   free(timers);
+}
+
+void ecore_bench_timer(Eina_Benchmark *bench)
+{
+   eina_benchmark_register(bench, "add_del",
+         EINA_BENCHMARK(bench_timer_add_del), 1000, 11000, 1000);
+   eina_benchmark_register(bench, "delay_reset",
+         EINA_BENCHMARK(bench_timer_delay), 1000, 11000, 1000);
+   eina_benchmark_register(bench, "fire",
+         EINA_BENCHMARK(bench_timer_fire), 1000, 11000, 1000);
+}
@@ -0,0 +1,61 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <limits.h>
+
+#include <Eina.h>
+
+#include "Efreet.h"
+/* no logging */
+#define EFREET_MODULE_LOG_DOM
+#include "efreet_private.h"
+#include "efreet_bench.h"
+
+typedef struct _Eina_Benchmark_Case Eina_Benchmark_Case;
+struct _Eina_Benchmark_Case
+{
+   const char *bench_case;
+   void (*build)(Eina_Benchmark *bench);
+   void (*cleanup)(void);
+};
+
+static const Eina_Benchmark_Case etc[] = {
+   { "efreet_mime", efreet_bench_mime, efreet_bench_mime_cleanup },
+   { NULL, NULL, NULL }
+};
+
+int
+main(int argc, char **argv)
+{
+   Eina_Benchmark *test;
+   unsigned int i;
+
+   if (argc != 2)
+      return -1;
+
+   eina_init();
+   /* measure efreet alone, efreetd must not be started nor listened to */
+   efreet_cache_update = 0;
+
+   for (i = 0; etc[i].bench_case; ++i)
+     {
+        test = eina_benchmark_new(etc[i].bench_case, argv[1]);
+        if (!test)
+           continue;
+
+        etc[i].build(test);
+
+        eina_benchmark_run(test);
+
+        eina_benchmark_free(test);
+
+        if (etc[i].cleanup) etc[i].cleanup();
+     }
+
+   eina_shutdown();
+
+   return 0;
+}
@@ -0,0 +1,7 @@
+#ifndef EFREET_BENCH_H_
+#define EFREET_BENCH_H_
+
+void efreet_bench_mime(Eina_Benchmark *bench);
+void efreet_bench_mime_cleanup(void);
+
+#endif
@@ -0,0 +1,328 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <Eina.h>
+#include <Eet.h>
+
+#include "Efreet.h"
+#include "Efreet_Mime.h"
+/* no logging */
+#define EFREET_MODULE_LOG_DOM
+#include "efreet_private.h"
+#include "efreet_cache_private.h"
+#include "efreet_bench.h"
+
+/*
+ * Synthetic shared-mime-info data about the size of the real one: mostly
+ * "*.ext" globs, some literal, "*tail" and other patterns, and magics at
+ * the first bytes of the file, a few with nested rules.
+ */
+#define GLOB_COUNT 1000
+#define MAGIC_COUNT 400
+#define NAME_COUNT 4096
+#define FILE_COUNT 256
+#define FILE_SIZE 1024
+
+static Eina_Tmpstr *root = NULL;
+static char *names[NAME_COUNT];
+static char *files[FILE_COUNT];
+
+static void
+_magic_signature(int i, unsigned char *sig)
+{
+   sig[0] = 0x7f;
+   sig[1] = 'A' + (i % 26);
+   sig[2] = i & 0xff;
+   sig[3] = (i >> 8) & 0xff;
+}
+
+static Eina_Bool
+_globs_write(const char *path)
+{
+   FILE *f;
+   int i;
+
+   f = fopen(path, "wb");
+   if (!f) return EINA_FALSE;
+
+   fprintf(f, "# This file was automatically generated by efreet_bench\n");
+   for (i = 0; i < GLOB_COUNT; i++)
+     {
+        fprintf(f, "application/x-bench-%i:", i);
+        switch (i % 20)
+          {
+           case 16: fprintf(f, "Name%i\n", i); break;
+           case 17: fprintf(f, "*-%i~\n", i); break;
+           case 18: fprintf(f, "[Rr]eadme%i*\n", i); break;
+           case 19: fprintf(f, "*.%i.part\n", i); break;
+           default: fprintf(f, "*.e%i\n", i); break;
+          }
+     }
+   fclose(f);
+
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_magic_write(const char *path)
+{
+   FILE *f;
+   unsigned char sig[4];
+   int i;
+
+   f = fopen(path, "wb");
+   if (!f) return EINA_FALSE;
+
+   fwrite("MIME-Magic\0\n", 1, 12, f);
+   for (i = 0; i < MAGIC_COUNT; i++)
+     {
+        /* sorted by priority, as update-mime-database does */
+        fprintf(f, "[%i:application/x-magic-%i]\n",
+                90 - (i * 70) / MAGIC_COUNT, i);
+        _magic_signature(i, sig);
+        fprintf(f, ">%i=", i % 8);
+        fputc(0, f);
+        fputc(sizeof(sig), f);
+        fwrite(sig, 1, sizeof(sig), f);
+        fputc('\n', f);
+        if (!(i % 10))
+          {
+             fprintf(f, "1>%i=", 16 + (i % 8));
+             fputc(0, f);
+             fputc(2, f);
+             fwrite("ok", 1, 2, f);
+             fputc('\n', f);
+          }
+     }
+   fclose(f);
+
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_file_write(const char *path, int i)
+{
+   unsigned char buffer[FILE_SIZE];
+   FILE *f;
+   int j;
+
+   /* text, which none of the magics match */
+   for (j = 0; j < FILE_SIZE; j++)
+     buffer[j] = 'a' + (j % 26);
+   if (i % 4)
+     {
+        _magic_signature((i * 7) % MAGIC_COUNT, buffer + ((i * 7) % MAGIC_COUNT) % 8);
+        memcpy(buffer + 16 + ((i * 7) % MAGIC_COUNT) % 8, "ok", 2);
+     }
+
+   f = fopen(path, "wb");
+   if (!f) return EINA_FALSE;
+   fwrite(buffer, 1, sizeof(buffer), f);
+   fclose(f);
+
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_data_create(void)
+{
+   char path[PATH_MAX];
+   int i;
+
+   if (!eina_file_mkdtemp("efreet_bench_XXXXXX", &root))
+     return EINA_FALSE;
+
+   /* only our data, not the data of the system the benchmark runs on */
+   snprintf(path, sizeof(path), "%s/data", root);
+   setenv("XDG_DATA_HOME", path, 1);
+   snprintf(path, sizeof(path), "%s/none", root);
+   setenv("XDG_DATA_DIRS", path, 1);
+   snprintf(path, sizeof(path), "%s/cache", root);
+   setenv("XDG_CACHE_HOME", path, 1);
+   if (mkdir(path, 0700) != 0) return EINA_FALSE;
+   snprintf(path, sizeof(path), "%s/cache/efreet", root);
+   if (mkdir(path, 0700) != 0) return EINA_FALSE;
+
+   snprintf(path, sizeof(path), "%s/data", root);
+   if (mkdir(path, 0755) != 0) return EINA_FALSE;
+   snprintf(path, sizeof(path), "%s/data/mime", root);
+   if (mkdir(path, 0755) != 0) return EINA_FALSE;
+   snprintf(path, sizeof(path), "%s/data/mime/globs", root);
+   if (!_globs_write(path)) return EINA_FALSE;
+   snprintf(path, sizeof(path), "%s/data/mime/magic", root);
+   if (!_magic_write(path)) return EINA_FALSE;
+
+   snprintf(path, sizeof(path), "%s/files", root);
+   if (mkdir(path, 0755) != 0) return EINA_FALSE;
+   for (i = 0; i < FILE_COUNT; i++)
+     {
+        snprintf(path, sizeof(path), "%s/files/%i.dat", root, i);
+        if (!_file_write(path, i)) return EINA_FALSE;
+        files[i] = strdup(path);
+     }
+
+   /* what a file manager shows, with a fair share of files no glob knows */
+   for (i = 0; i < NAME_COUNT; i++)
+     {
+        int g = (i * 13) % GLOB_COUNT;
+
+        switch (i % 8)
+          {
+           case 0: snprintf(path, sizeof(path), "Name%i", g - (g % 20) + 16); break;
+           case 1: snprintf(path, sizeof(path), "backup-%i~", g - (g % 20) + 17); break;
+           case 2: snprintf(path, sizeof(path), "README%i.txt", g - (g % 20) + 18); break;
+           case 3: snprintf(path, sizeof(path), "NAME%i", g - (g % 20) + 16); break;
+           case 4: snprintf(path, sizeof(path), "unknown-%i", i); break;
+           case 5: snprintf(path, sizeof(path), "notes.%i.txt", i); break;
+           default: snprintf(path, sizeof(path), "photo_%i.E%i", i, g - (g % 20)); break;
+          }
+        names[i] = strdup(path);
+     }
+
+   return EINA_TRUE;
+}
+
+static void
+_tree_remove(const char *path)
+{
+   Eina_Iterator *it;
+   const char *file;
+
+   it = eina_file_ls(path);
+   EINA_ITERATOR_FOREACH(it, file)
+     {
+        if (unlink(file) != 0) _tree_remove(file);
+        eina_stringshare_del(file);
+     }
+   eina_iterator_free(it);
+   rmdir(path);
+}
+
+static void
+_cache_remove(void)
+{
+   efreet_init();
+   unlink(efreet_mime_cache_file());
+   efreet_shutdown();
+}
+
+static void
+_cache_create(void)
+{
+   efreet_init();
+   if (!efreet_mime_cache_valid(efreet_mime_cache_file()))
+     efreet_mime_cache_write(efreet_mime_cache_file());
+   efreet_shutdown();
+}
+
+static void
+_init(int request)
+{
+   int i;
+
+   for (i = 0; i < request; i++)
+     {
+        efreet_mime_init();
+        efreet_mime_shutdown();
+     }
+}
+
+static void
+bench_init_parsed(int request)
+{
+   _cache_remove();
+   _init(request);
+}
+
+static void
+bench_init_cached(int request)
+{
+   _cache_create();
+   _init(request);
+}
+
+static void
+_globs_type_get(int request)
+{
+   int i;
+
+   efreet_mime_init();
+   for (i = 0; i < request; i++)
+     efreet_mime_globs_type_get(names[i % NAME_COUNT]);
+   efreet_mime_shutdown();
+}
+
+static void
+bench_globs_parsed(int request)
+{
+   _cache_remove();
+   _globs_type_get(request);
+}
+
+static void
+bench_globs_cached(int request)
+{
+   _cache_create();
+   _globs_type_get(request);
+}
+
+static void
+bench_type_get(int request)
+{
+   int i;
+
+   _cache_create();
+   efreet_mime_init();
+   for (i = 0; i < request; i++)
+     efreet_mime_type_get(files[i % FILE_COUNT]);
+   efreet_mime_shutdown();
+}
+
+void efreet_bench_mime(Eina_Benchmark *bench)
+{
+   if (!_data_create())
+     {
+        fprintf(stderr, "efreet_bench: could not create the mime data\n");
+        return;
+     }
+
+   eina_benchmark_register(bench, "init_parsed",
+         EINA_BENCHMARK(bench_init_parsed), 10, 110, 20);
+   eina_benchmark_register(bench, "init_cached",
+         EINA_BENCHMARK(bench_init_cached), 10, 110, 20);
+   eina_benchmark_register(bench, "globs_type_get_parsed",
+         EINA_BENCHMARK(bench_globs_parsed), 10000, 110000, 20000);
+   eina_benchmark_register(bench, "globs_type_get_cached",
+         EINA_BENCHMARK(bench_globs_cached), 10000, 110000, 20000);
+   eina_benchmark_register(bench, "type_get",
+         EINA_BENCHMARK(bench_type_get), 256, 2816, 512);
+}
+
+void efreet_bench_mime_cleanup(void)
+{
+   int i;
+
+   for (i = 0; i < NAME_COUNT; i++)
+     {
+        free(names[i]);
+        names[i] = NULL;
+     }
+   for (i = 0; i < FILE_COUNT; i++)
+     {
+        free(files[i]);
+        files[i] = NULL;
+     }
+   if (!root) return;
+
+   _tree_remove(root);
+
+   eina_tmpstr_del(root);
+   root = NULL;
+}
@@ -273,6 +273,186 @@ eina_bench_lookup_superfast(int request)
    eina_hash_free(hash);
 }
 
+static void
+eina_bench_lookup_superfast_flat(int request)
+{
+   Eina_Hash *hash = NULL;
+   int *tmp_val;
+   unsigned int i;
+   unsigned int j;
+
+   hash = eina_hash_string_flat_new(free);
+
+   for (i = 0; i < (unsigned int)request; ++i)
+     {
+        char tmp_key[10];
+
+        tmp_val = malloc(sizeof (int));
+
+        if (!tmp_val)
+           continue;
+
+        eina_convert_itoa(i, tmp_key);
+        *tmp_val = i;
+
+        eina_hash_add(hash, tmp_key, tmp_val);
+     }
+
+   srand(time(NULL));
+
+   for (j = 0; j < 200; ++j)
+      for (i = 0; i < (unsigned int)request; ++i)
+        {
+           char tmp_key[10];
+
+           eina_convert_itoa(rand() % request, tmp_key);
+           tmp_val = eina_hash_find(hash, tmp_key);
+        }
+
+   eina_hash_free(hash);
+}
+
+static void
+_eina_bench_lookup_int32(Eina_Hash *hash, int request)
+{
+   unsigned int *tmp_val;
+   unsigned int i;
+   unsigned int j;
+
+   for (i = 0; i < (unsigned int)request; ++i)
+     {
+        tmp_val = malloc(sizeof (unsigned int));
+
+        if (!tmp_val)
+           continue;
+
+        /* sparse keys, as object ids or handles would be */
+        *tmp_val = i * 7919;
+
+        eina_hash_direct_add(hash, tmp_val, tmp_val);
+     }
+
+   srand(time(NULL));
+
+   for (j = 0; j < 200; ++j)
+      for (i = 0; i < (unsigned int)request; ++i)
+        {
+           unsigned int tmp_key;
+
+           tmp_key = (rand() % request) * 7919;
+           tmp_val = eina_hash_find(hash, &tmp_key);
+        }
+
+   eina_hash_free(hash);
+}
+
+static void
+eina_bench_lookup_int32(int request)
+{
+   _eina_bench_lookup_int32(eina_hash_int32_new(free), request);
+}
+
+static void
+eina_bench_lookup_int32_flat(int request)
+{
+   _eina_bench_lookup_int32(eina_hash_int32_flat_new(free), request);
+}
+
+static void
+_eina_bench_lookup_int64(Eina_Hash *hash, int request)
+{
+   unsigned long long int *tmp_val;
+   unsigned int i;
+   unsigned int j;
+
+   for (i = 0; i < (unsigned int)request; ++i)
+     {
+        tmp_val = malloc(sizeof (unsigned long long int));
+
+        if (!tmp_val)
+           continue;
+
+        *tmp_val = (unsigned long long int)i * 0x100000001ULL;
+
+        eina_hash_direct_add(hash, tmp_val, tmp_val);
+     }
+
+   srand(time(NULL));
+
+   for (j = 0; j < 200; ++j)
+      for (i = 0; i < (unsigned int)request; ++i)
+        {
+           unsigned long long int tmp_key;
+
+           tmp_key = (unsigned long long int)(rand() % request) * 0x100000001ULL;
+           tmp_val = eina_hash_find(hash, &tmp_key);
+        }
+
+   eina_hash_free(hash);
+}
+
+static void
+eina_bench_lookup_int64(int request)
+{
+   _eina_bench_lookup_int64(eina_hash_int64_new(free), request);
+}
+
+static void
+eina_bench_lookup_int64_flat(int request)
+{
+   _eina_bench_lookup_int64(eina_hash_int64_flat_new(free), request);
+}
+
+static void
+_eina_bench_lookup_pointer(Eina_Hash *hash, int request)
+{
+   void **keys;
+   int *tmp_val;
+   unsigned int i;
+   unsigned int j;
+
+   keys = malloc(request * sizeof (void *));
+   if (!keys)
+     {
+        eina_hash_free(hash);
+        return;
+     }
+
+   for (i = 0; i < (unsigned int)request; ++i)
+     {
+        tmp_val = malloc(sizeof (int));
+        keys[i] = tmp_val;
+
+        if (!tmp_val)
+           continue;
+
+        *tmp_val = i;
+
+        eina_hash_add(hash, &keys[i], tmp_val);
+     }
+
+   srand(time(NULL));
+
+   for (j = 0; j < 200; ++j)
+      for (i = 0; i < (unsigned int)request; ++i)
+        tmp_val = eina_hash_find(hash, &keys[rand() % request]);
+
+   eina_hash_free(hash);
+   free(keys);
+}
+
+static void
+eina_bench_lookup_pointer(int request)
+{
+   _eina_bench_lookup_pointer(eina_hash_pointer_new(free), request);
+}
+
+static void
+eina_bench_lookup_pointer_flat(int request)
+{
+   _eina_bench_lookup_pointer(eina_hash_pointer_flat_new(free), request);
+}
+
 static void
 eina_bench_lookup_djb2(int request)
 {
@@ -515,6 +695,27 @@ void eina_bench_hash(Eina_Benchmark *bench)
    eina_benchmark_register(bench, "superfast-lookup",
                            EINA_BENCHMARK(
                               eina_bench_lookup_superfast),   10, 10000, 10);
+   eina_benchmark_register(bench, "superfast-flat-lookup",
+                           EINA_BENCHMARK(
+                              eina_bench_lookup_superfast_flat), 10, 10000, 10);
+   eina_benchmark_register(bench, "int32-lookup",
+                           EINA_BENCHMARK(
+                              eina_bench_lookup_int32),       10, 10000, 10);
+   eina_benchmark_register(bench, "int32-flat-lookup",
+                           EINA_BENCHMARK(
+                              eina_bench_lookup_int32_flat),  10, 10000, 10);
+   eina_benchmark_register(bench, "int64-lookup",
+                           EINA_BENCHMARK(
+                              eina_bench_lookup_int64),       10, 10000, 10);
+   eina_benchmark_register(bench, "int64-flat-lookup",
+                           EINA_BENCHMARK(
+                              eina_bench_lookup_int64_flat),  10, 10000, 10);
+   eina_benchmark_register(bench, "pointer-lookup",
+                           EINA_BENCHMARK(
+                              eina_bench_lookup_pointer),     10, 10000, 10);
+   eina_benchmark_register(bench, "pointer-flat-lookup",
+                           EINA_BENCHMARK(
+                              eina_bench_lookup_pointer_flat), 10, 10000, 10);
    eina_benchmark_register(bench, "djb2-lookup",
                            EINA_BENCHMARK(
                               eina_bench_lookup_djb2),        10, 10000, 10);
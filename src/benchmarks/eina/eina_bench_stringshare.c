@@ -35,6 +35,9 @@
 #include "eina_bench.h"
 #include "eina_convert.h"
 #include "eina_main.h"
+#include "eina_thread.h"
+
+#define EINA_BENCH_STRINGSHARE_THREADS 4
 
 static void
 eina_bench_stringshare_job(int request)
@@ -69,6 +72,58 @@ eina_bench_stringshare_job(int request)
    eina_shutdown();
 }
 
+static void *
+_eina_bench_stringshare_thread(void *data, Eina_Thread t)
+{
+   const char **strings;
+   int request = *(int *)data;
+   unsigned int seed = (unsigned int)t;
+   unsigned int j;
+   int i;
+
+   strings = malloc(request * sizeof (const char *));
+   if (!strings) return NULL;
+
+   /* Every thread walks the same set of strings, so they share nodes and
+    * keep adding and dropping references on them concurrently. */
+   for (j = 0; j < 50; ++j)
+     {
+        for (i = 0; i < request; ++i)
+          {
+             char build[64] = "string_";
+
+             eina_convert_xtoa(rand_r(&seed) % request, build + 7);
+             strings[i] = eina_stringshare_add(build);
+          }
+        for (i = 0; i < request; ++i)
+          eina_stringshare_del(strings[i]);
+     }
+
+   free(strings);
+   return NULL;
+}
+
+static void
+eina_bench_stringshare_threads_job(int request)
+{
+   Eina_Thread threads[EINA_BENCH_STRINGSHARE_THREADS];
+   unsigned int i;
+
+   eina_init();
+   eina_threads_init();
+
+   for (i = 0; i < EINA_BENCH_STRINGSHARE_THREADS; ++i)
+     if (!eina_thread_create(&threads[i], EINA_THREAD_NORMAL, -1,
+                             _eina_bench_stringshare_thread, &request))
+       break;
+
+   while (i > 0)
+     eina_thread_join(threads[--i]);
+
+   eina_threads_shutdown();
+   eina_shutdown();
+}
+
 #ifdef EINA_BENCH_HAVE_GLIB
 static void
 eina_bench_stringchunk_job(int request)
@@ -171,6 +226,9 @@ void eina_bench_stringshare(Eina_Benchmark *bench)
    eina_benchmark_register(bench, "stringshare",
                            EINA_BENCHMARK(
                               eina_bench_stringshare_job), 100, 20100, 500);
+   eina_benchmark_register(bench, "stringshare (threads)",
+                           EINA_BENCHMARK(
+                              eina_bench_stringshare_threads_job), 100, 20100, 500);
 #ifdef EINA_BENCH_HAVE_GLIB
    eina_benchmark_register(bench, "stringchunk (glib)",
                            EINA_BENCHMARK(
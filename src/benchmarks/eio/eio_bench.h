@@ -0,0 +1,7 @@
+#ifndef EIO_BENCH_H_
+#define EIO_BENCH_H_
+
+void eio_bench_dir_copy(Eina_Benchmark *bench);
+void eio_bench_dir_copy_cleanup(void);
+
+#endif
@@ -0,0 +1,162 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <Eina.h>
+#include <Ecore.h>
+
+#include "Eio.h"
+#include "eio_bench.h"
+
+/* theme like trees: a few directories holding lots of small files */
+#define DIR_COUNT 16
+#define FILE_SIZE 4096
+
+#define REQUEST_MIN 250
+#define REQUEST_MAX 2250
+#define REQUEST_STEP 500
+
+static Eina_Tmpstr *root = NULL;
+static int copies = 0;
+
+static void
+_done_cb(void *data EINA_UNUSED, Eio_File *handler EINA_UNUSED)
+{
+   ecore_main_loop_quit();
+}
+
+static void
+_error_cb(void *data EINA_UNUSED, Eio_File *handler EINA_UNUSED, int error)
+{
+   fprintf(stderr, "eio_bench: %s\n", strerror(error));
+   ecore_main_loop_quit();
+}
+
+static void
+_source_tree_path(int request, char *path, size_t length)
+{
+   snprintf(path, length, "%s/src_%i", root, request);
+}
+
+static Eina_Bool
+_source_tree_build(int request)
+{
+   char buffer[FILE_SIZE];
+   char path[PATH_MAX];
+   char file[PATH_MAX];
+   int i;
+
+   /* every case copies the same tree, only build it once */
+   _source_tree_path(request, path, sizeof (path));
+   if (mkdir(path, 0755) != 0)
+     return errno == EEXIST;
+
+   memset(buffer, 'E', sizeof (buffer));
+   for (i = 0; i < DIR_COUNT; i++)
+     {
+        snprintf(file, sizeof (file), "%s/%i", path, i);
+        if (mkdir(file, 0755) != 0) return EINA_FALSE;
+     }
+   for (i = 0; i < request; i++)
+     {
+        int fd;
+
+        snprintf(file, sizeof (file), "%s/%i/%i.png", path, i % DIR_COUNT, i);
+        fd = open(file, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) return EINA_FALSE;
+        if (write(fd, buffer, sizeof (buffer)) != sizeof (buffer))
+          {
+             close(fd);
+             return EINA_FALSE;
+          }
+        close(fd);
+     }
+
+   return EINA_TRUE;
+}
+
+static void
+_dir_copy(int request, unsigned int concurrency)
+{
+   char source[PATH_MAX];
+   char dest[PATH_MAX];
+
+   if (!root) return;
+   _source_tree_path(request, source, sizeof (source));
+   snprintf(dest, sizeof (dest), "%s/dst_%i", root, copies++);
+
+   eio_dir_copy_concurrency_set(concurrency);
+   if (eio_dir_copy(source, dest, NULL, NULL, _done_cb, _error_cb, NULL))
+     ecore_main_loop_begin();
+   eio_dir_copy_concurrency_set(1);
+
+   /* don't let the copies pile up, every case pays the same for it */
+   if (eio_dir_unlink(dest, NULL, NULL, _done_cb, _error_cb, NULL))
+     ecore_main_loop_begin();
+   rmdir(dest);
+}
+
+static void
+bench_dir_copy_sequential(int request)
+{
+   _dir_copy(request, 1);
+}
+
+static void
+bench_dir_copy_4(int request)
+{
+   _dir_copy(request, 4);
+}
+
+static void
+bench_dir_copy_16(int request)
+{
+   _dir_copy(request, 16);
+}
+
+void eio_bench_dir_copy(Eina_Benchmark *bench)
+{
+   int request;
+
+   /* build the trees now, so that no case times their creation */
+   if (!eina_file_mkdtemp("eio_bench_XXXXXX", &root))
+     return;
+   for (request = REQUEST_MIN; request < REQUEST_MAX; request += REQUEST_STEP)
+     if (!_source_tree_build(request))
+       {
+          fprintf(stderr, "eio_bench: could not build the tree of %i files\n",
+                  request);
+          eio_bench_dir_copy_cleanup();
+          return;
+       }
+
+   eina_benchmark_register(bench, "sequential",
+         EINA_BENCHMARK(bench_dir_copy_sequential),
+         REQUEST_MIN, REQUEST_MAX, REQUEST_STEP);
+   eina_benchmark_register(bench, "concurrent_4",
+         EINA_BENCHMARK(bench_dir_copy_4),
+         REQUEST_MIN, REQUEST_MAX, REQUEST_STEP);
+   eina_benchmark_register(bench, "concurrent_16",
+         EINA_BENCHMARK(bench_dir_copy_16),
+         REQUEST_MIN, REQUEST_MAX, REQUEST_STEP);
+}
+
+void eio_bench_dir_copy_cleanup(void)
+{
+   if (!root) return;
+
+   if (eio_dir_unlink(root, NULL, NULL, _done_cb, _error_cb, NULL))
+     ecore_main_loop_begin();
+   rmdir(root);
+
+   eina_tmpstr_del(root);
+   root = NULL;
+}
@@ -0,0 +1,58 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <limits.h>
+
+#include <Eina.h>
+
+#include "Embryo.h"
+#include "embryo_bench.h"
+
+typedef struct _Eina_Benchmark_Case Eina_Benchmark_Case;
+struct _Eina_Benchmark_Case
+{
+   const char *bench_case;
+   void (*build)(Eina_Benchmark *bench);
+   void (*cleanup)(void);
+};
+
+static const Eina_Benchmark_Case etc[] = {
+   { "embryo_amx", embryo_bench_amx, embryo_bench_amx_cleanup },
+   { NULL, NULL, NULL }
+};
+
+int
+main(int argc, char **argv)
+{
+   Eina_Benchmark *test;
+   unsigned int i;
+
+   if (argc != 2)
+      return -1;
+
+   eina_init();
+   embryo_init();
+
+   for (i = 0; etc[i].bench_case; ++i)
+     {
+        test = eina_benchmark_new(etc[i].bench_case, argv[1]);
+        if (!test)
+           continue;
+
+        etc[i].build(test);
+
+        eina_benchmark_run(test);
+
+        eina_benchmark_free(test);
+
+        if (etc[i].cleanup) etc[i].cleanup();
+     }
+
+   embryo_shutdown();
+   eina_shutdown();
+
+   return 0;
+}
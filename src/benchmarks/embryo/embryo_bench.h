@@ -0,0 +1,7 @@
+#ifndef EMBRYO_BENCH_H_
+#define EMBRYO_BENCH_H_
+
+void embryo_bench_amx(Eina_Benchmark *bench);
+void embryo_bench_amx_cleanup(void);
+
+#endif
@@ -0,0 +1,113 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <Eina.h>
+
+#include "Embryo.h"
+#include "embryo_bench.h"
+
+/*
+ * Every function of embryo_bench.sma, run by the threaded code embryo
+ * translates programs to when loading them, and by the classic
+ * interpreter it falls back to.
+ */
+#define AMX_FILE PACKAGE_BUILD_DIR "/src/benchmarks/embryo/embryo_bench.amx"
+
+static Embryo_Program *threaded = NULL;
+static Embryo_Program *classic = NULL;
+
+static Embryo_Cell
+_bench_native(Embryo_Program *ep EINA_UNUSED, Embryo_Cell *params)
+{
+   return params[1] & 7;
+}
+
+static Embryo_Program *
+_program_load(Eina_Bool use_threaded)
+{
+   Embryo_Program *ep;
+
+   /* only looked at when the program is loaded */
+   if (use_threaded) unsetenv("EMBRYO_NO_THREADED");
+   else setenv("EMBRYO_NO_THREADED", "1", 1);
+   ep = embryo_program_load(AMX_FILE);
+   unsetenv("EMBRYO_NO_THREADED");
+   if (!ep) return NULL;
+
+   embryo_program_native_call_add(ep, "bench_native", _bench_native);
+   /* as edje does it */
+   embryo_program_max_cycle_run_set(ep, 5000000);
+   embryo_program_vm_push(ep);
+   return ep;
+}
+
+static void
+_run(Embryo_Program *ep, const char *func, int request)
+{
+   Embryo_Function fn;
+
+   fn = embryo_program_function_find(ep, func);
+   embryo_parameter_cell_push(ep, request);
+   if (embryo_program_run(ep, fn) != EMBRYO_PROGRAM_OK)
+     fprintf(stderr, "embryo_bench: %s failed: %s\n", func,
+             embryo_error_string_get(embryo_program_error_get(ep)));
+}
+
+#define BENCH(func) \
+static void \
+bench_##func##_threaded(int request) \
+{ \
+   _run(threaded, #func, request); \
+} \
+static void \
+bench_##func##_classic(int request) \
+{ \
+   _run(classic, #func, request); \
+}
+
+BENCH(arith)
+BENCH(loops)
+BENCH(calls)
+BENCH(natives)
+BENCH(cases)
+BENCH(floats)
+
+#undef BENCH
+
+void embryo_bench_amx(Eina_Benchmark *bench)
+{
+   threaded = _program_load(EINA_TRUE);
+   classic = _program_load(EINA_FALSE);
+   if ((!threaded) || (!classic))
+     {
+        fprintf(stderr, "embryo_bench: could not load %s\n", AMX_FILE);
+        return;
+     }
+
+#define BENCH(func, start, end, step) \
+   eina_benchmark_register(bench, #func "_threaded", \
+         EINA_BENCHMARK(bench_##func##_threaded), start, end, step); \
+   eina_benchmark_register(bench, #func "_classic", \
+         EINA_BENCHMARK(bench_##func##_classic), start, end, step)
+
+   BENCH(arith, 10000, 110000, 20000);
+   BENCH(loops, 100, 1100, 200);
+   BENCH(calls, 100, 1100, 200);
+   BENCH(natives, 10000, 110000, 20000);
+   BENCH(cases, 10000, 110000, 20000);
+   BENCH(floats, 10000, 110000, 20000);
+
+#undef BENCH
+}
+
+void embryo_bench_amx_cleanup(void)
+{
+   if (threaded) embryo_program_free(threaded);
+   if (classic) embryo_program_free(classic);
+   threaded = NULL;
+   classic = NULL;
+}
@@ -10,20 +10,27 @@
 EAPI Eo_Op SIMPLE_BASE_ID = 0;
 
 static void
-_a_set(Eo *obj EINA_UNUSED, void *class_data, va_list *list)
+_a_set_direct(Eo *obj EINA_UNUSED, void *class_data, int a)
 {
    Simple_Public_Data *pd = class_data;
+
+   pd->a = a;
+}
+
+static void
+_a_set(Eo *obj, void *class_data, va_list *list)
+{
    int a;
    a = va_arg(*list, int);
 
-   pd->a = a;
+   _a_set_direct(obj, class_data, a);
 }
 
 static void
 _class_constructor(Eo_Class *klass)
 {
    const Eo_Op_Func_Description func_desc[] = {
-        EO_OP_FUNC(SIMPLE_ID(SIMPLE_SUB_ID_A_SET), _a_set),
+        EO_OP_FUNC_DIRECT(SIMPLE_ID(SIMPLE_SUB_ID_A_SET), _a_set, simple_a_set_func, _a_set_direct),
         EO_OP_FUNC_SENTINEL
    };
 
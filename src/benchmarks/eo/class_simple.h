@@ -17,6 +17,8 @@ typedef struct
 
 #define simple_a_set(a) SIMPLE_ID(SIMPLE_SUB_ID_A_SET), EO_TYPECHECK(int, a)
 
+typedef void (*simple_a_set_func)(Eo *obj, void *class_data, int a);
+
 #define SIMPLE_CLASS simple_class_get()
 const Eo_Class *simple_class_get(void);
 
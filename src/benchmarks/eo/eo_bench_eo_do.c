@@ -19,6 +19,19 @@ bench_eo_do_general(int request)
    eo_unref(obj);
 }
 
+static void
+bench_eo_do_direct(int request)
+{
+   int i;
+   Eo *obj = eo_add(SIMPLE_CLASS, NULL);
+   for (i = 0 ; i < request ; i++)
+     {
+        eo_do_direct(obj, simple_a_set_func, simple_a_set(i));
+     }
+
+   eo_unref(obj);
+}
+
 static const Eo_Class *cur_klass;
 
 static void
@@ -70,6 +83,8 @@ void eo_bench_eo_do(Eina_Benchmark *bench)
 {
    eina_benchmark_register(bench, "various",
          EINA_BENCHMARK(bench_eo_do_general), 1000, 100000, 500);
+   eina_benchmark_register(bench, "direct",
+         EINA_BENCHMARK(bench_eo_do_direct), 1000, 100000, 500);
    eina_benchmark_register(bench, "super",
          EINA_BENCHMARK(bench_eo_do_super), 1000, 100000, 500);
 }
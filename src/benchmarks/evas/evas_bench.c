@@ -0,0 +1,101 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <limits.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include <Eina.h>
+
+#include "evas_bench.h"
+
+typedef struct _Evas_Benchmark_Case Evas_Benchmark_Case;
+struct _Evas_Benchmark_Case
+{
+   const char *bench_case;
+   void (*run)(FILE *out);
+};
+
+static const Evas_Benchmark_Case etc[] = {
+   { "evas_pipe", evas_bench_pipe },
+   { "evas_textblock", evas_bench_textblock },
+   { "evas_filters", evas_bench_filters },
+   { NULL, NULL }
+};
+
+double
+evas_bench_time_get(void)
+{
+   struct timespec t;
+
+   clock_gettime(CLOCK_MONOTONIC, &t);
+   return (double)t.tv_sec + ((double)t.tv_nsec / 1000000000.0);
+}
+
+/* Some settings are only read once per process, when evas is first set
+ * up: run gets a child of its own, with threads_env set to threads and
+ * the NULL terminated list of variables in env set to 1. */
+void
+evas_bench_threads_run(FILE *out, const char *threads_env, int threads,
+                       const char *const *env,
+                       Evas_Bench_Threads_Cb run, void *data)
+{
+   char buf[16];
+   pid_t pid;
+
+   fflush(out);
+   pid = fork();
+   if (pid < 0) return;
+   if (pid > 0)
+     {
+        waitpid(pid, NULL, 0);
+        return;
+     }
+
+   snprintf(buf, sizeof (buf), "%i", threads);
+   setenv(threads_env, buf, 1);
+   for (; env && *env; env++)
+     setenv(*env, "1", 1);
+
+   run(out, threads, data);
+   fflush(out);
+
+   _exit(0);
+}
+
+int
+main(int argc, char **argv)
+{
+   char buf[PATH_MAX];
+   unsigned int i;
+
+   if (argc != 2)
+      return -1;
+
+   /* evas itself is only set up inside each case, as some of them fork */
+   eina_init();
+
+   for (i = 0; etc[i].bench_case; ++i)
+     {
+        FILE *out;
+
+        snprintf(buf, sizeof (buf), "bench_%s_%s.data",
+                 etc[i].bench_case, argv[1]);
+        out = fopen(buf, "w");
+        if (!out)
+           continue;
+
+        etc[i].run(out);
+
+        fclose(out);
+     }
+
+   eina_shutdown();
+
+   return 0;
+}
@@ -0,0 +1,18 @@
+#ifndef EVAS_BENCH_H_
+#define EVAS_BENCH_H_
+
+/* eina_benchmark only counts the cpu time of the calling process, so the
+ * cases here measure wall clock time themselves and write one
+ * bench_<case>_<run>.data file each */
+void evas_bench_pipe(FILE *out);
+void evas_bench_textblock(FILE *out);
+void evas_bench_filters(FILE *out);
+
+typedef void (*Evas_Bench_Threads_Cb)(FILE *out, int threads, void *data);
+
+double evas_bench_time_get(void);
+void evas_bench_threads_run(FILE *out, const char *threads_env, int threads,
+                            const char *const *env,
+                            Evas_Bench_Threads_Cb run, void *data);
+
+#endif
@@ -0,0 +1,174 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <Eina.h>
+
+#include "Evas.h"
+#include "Evas_Engine_Buffer.h"
+#include "evas_bench.h"
+
+#define OUT_W 1920
+#define OUT_H 1080
+#define FRAMES 10
+#define THREADS_MAX 8
+#define BLUR_RADIUS_MAX 64
+
+/* filter programs are only reachable through the Eo API */
+#if defined(EFL_EO_API_SUPPORT) && defined(EFL_BETA_API_SUPPORT)
+
+typedef struct _Filter_Case Filter_Case;
+struct _Filter_Case
+{
+   const char *name;
+   const char *code;
+};
+
+/* a big text shadow, a glow, and both at once where the two chains don't
+ * depend on each other */
+static const Filter_Case cases[] = {
+   { "blur", "blur(12);" },
+   { "grow", "grow(6);" },
+   { "blend", "buffer:a(alpha);buffer:b(alpha);"
+     "blur(8,dst=a);grow(4,dst=b);"
+     "blend(src=a,ox=6,oy=6,color=black);"
+     "blend(src=b,color=yellow);blend();" },
+   { NULL, NULL }
+};
+
+static double
+_filter_render(unsigned int *pixels, const char *code)
+{
+   Evas *evas;
+   Evas_Engine_Info_Buffer *einfo;
+   Evas_Object *o;
+   double t0, t;
+   int f;
+
+   evas_init();
+   evas = evas_new();
+   evas_output_method_set(evas, evas_render_method_lookup("buffer"));
+   einfo = (Evas_Engine_Info_Buffer *)evas_engine_info_get(evas);
+   einfo->info.depth_type = EVAS_ENGINE_BUFFER_DEPTH_ARGB32;
+   einfo->info.dest_buffer = pixels;
+   einfo->info.dest_buffer_row_bytes = OUT_W * sizeof (unsigned int);
+   einfo->info.use_color_key = 0;
+   einfo->info.alpha_threshold = 0;
+   einfo->info.func.new_update_region = NULL;
+   einfo->info.func.free_update_region = NULL;
+   evas_engine_info_set(evas, (Evas_Engine_Info *)einfo);
+   evas_output_size_set(evas, OUT_W, OUT_H);
+   evas_output_viewport_set(evas, 0, 0, OUT_W, OUT_H);
+
+   o = evas_object_rectangle_add(evas);
+   evas_object_color_set(o, 40, 60, 80, 255);
+   evas_object_resize(o, OUT_W, OUT_H);
+   evas_object_show(o);
+
+   o = evas_object_text_add(evas);
+   evas_object_text_font_set(o, "Sans", 160);
+   evas_object_text_text_set(o, "Filtered label");
+   evas_object_move(o, 40, 300);
+   evas_object_show(o);
+   eo_do(o, evas_obj_text_filter_program_set(code));
+
+   /* the first frame also parses the program and sets everything up */
+   evas_render(evas);
+
+   t0 = evas_bench_time_get();
+   for (f = 0; f < FRAMES; f++)
+     {
+        /* a text change is needed for the filter to run again */
+        evas_object_text_text_set(o, (f & 1) ? "Filtered label" :
+                                  "Filtered Label");
+        evas_render(evas);
+     }
+   t = (evas_bench_time_get() - t0) / FRAMES;
+
+   evas_free(evas);
+   evas_shutdown();
+
+   return t;
+}
+
+typedef struct _Filter_Run Filter_Run;
+struct _Filter_Run
+{
+   const char *name;
+   const char *code;
+   Eina_Bool simd;
+};
+
+static const char *const no_simd[] = {
+   "EVAS_CPU_NO_SSE3", "EVAS_CPU_NO_AVX2", "EVAS_CPU_NO_NEON", NULL
+};
+
+static void
+_filter_render_run(FILE *out, int threads, void *data)
+{
+   const Filter_Run *fr = data;
+   unsigned int *pixels;
+   double t;
+
+   pixels = malloc(OUT_W * OUT_H * sizeof (unsigned int));
+   if (!pixels) return;
+
+   t = _filter_render(pixels, fr->code);
+   fprintf(out, "%s\t%i\t%s\t%.3f\n", fr->name, threads,
+           fr->simd ? "simd" : "c", t * 1000.0);
+   fprintf(stderr, "Run filter_%s: %i threads %s %.3f ms/frame\n",
+           fr->name, threads, fr->simd ? "simd" : "c", t * 1000.0);
+
+   free(pixels);
+}
+
+/* the cpu features are read when evas is first set up, so every run
+ * needs a fresh process */
+static void
+_filter_run(FILE *out, const char *name, const char *code, int threads,
+            Eina_Bool simd)
+{
+   Filter_Run fr = { name, code, simd };
+
+   evas_bench_threads_run(out, "EVAS_POOL_THREADS", threads,
+                          simd ? NULL : no_simd, _filter_render_run, &fr);
+}
+
+/* one thread, so that this is about the blur loops themselves */
+static void
+_blur_radius_run(FILE *out, const char *type)
+{
+   char name[32], code[64];
+   int r;
+
+   for (r = 1; r <= BLUR_RADIUS_MAX; r *= 2)
+     {
+        snprintf(name, sizeof (name), "%s(%i)", type, r);
+        snprintf(code, sizeof (code), "blur(%i,type=%s);", r, type);
+        _filter_run(out, name, code, 1, EINA_FALSE);
+        _filter_run(out, name, code, 1, EINA_TRUE);
+     }
+}
+#endif
+
+void evas_bench_filters(FILE *out)
+{
+#if defined(EFL_EO_API_SUPPORT) && defined(EFL_BETA_API_SUPPORT)
+   const Filter_Case *fc;
+   int i;
+
+   fprintf(out, "# filter\tthreads\tcpu\tms per frame (%ix%i, %i frames)\n",
+           OUT_W, OUT_H, FRAMES);
+   for (fc = cases; fc->name; fc++)
+     for (i = 1; i <= THREADS_MAX; i++)
+       _filter_run(out, fc->name, fc->code, i, EINA_TRUE);
+
+   _blur_radius_run(out, "box");
+   _blur_radius_run(out, "gaussian");
+#else
+   fprintf(out, "# filters need the Eo and beta API\n");
+#endif
+}
@@ -0,0 +1,152 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <Eina.h>
+
+#include "Evas.h"
+#include "Evas_Engine_Buffer.h"
+#include "evas_bench.h"
+
+#define OUT_W 3840
+#define OUT_H 2160
+#define IMG_W 256
+#define IMG_H 192
+#define FRAMES 20
+#define THREADS_MAX 16
+
+static void
+_image_fill(unsigned int *data)
+{
+   int x, y;
+
+   for (y = 0; y < IMG_H; y++)
+     for (x = 0; x < IMG_W; x++)
+       {
+          unsigned int a = (x + y) & 0xff;
+
+          data[(y * IMG_W) + x] = (a << 24) |
+            (((x * a) / IMG_W) << 16) | (((y * a) / IMG_H) << 8) | (a / 2);
+       }
+}
+
+static double
+_scene_render(unsigned int *pixels, unsigned int *img)
+{
+   Evas *evas;
+   Evas_Engine_Info_Buffer *einfo;
+   Evas_Object *objs[64];
+   Evas_Object *o;
+   double t0, t;
+   int i, f, n = 0;
+
+   evas_init();
+   evas = evas_new();
+   evas_output_method_set(evas, evas_render_method_lookup("buffer"));
+   einfo = (Evas_Engine_Info_Buffer *)evas_engine_info_get(evas);
+   einfo->info.depth_type = EVAS_ENGINE_BUFFER_DEPTH_ARGB32;
+   einfo->info.dest_buffer = pixels;
+   einfo->info.dest_buffer_row_bytes = OUT_W * sizeof (unsigned int);
+   einfo->info.use_color_key = 0;
+   einfo->info.alpha_threshold = 0;
+   einfo->info.func.new_update_region = NULL;
+   einfo->info.func.free_update_region = NULL;
+   evas_engine_info_set(evas, (Evas_Engine_Info *)einfo);
+   evas_output_size_set(evas, OUT_W, OUT_H);
+   evas_output_viewport_set(evas, 0, 0, OUT_W, OUT_H);
+
+   o = evas_object_rectangle_add(evas);
+   evas_object_color_set(o, 20, 40, 60, 255);
+   evas_object_resize(o, OUT_W, OUT_H);
+   evas_object_show(o);
+
+   /* a grid of alpha images, every other one scaled up smoothly */
+   for (i = 0; i < 24; i++)
+     {
+        o = evas_object_image_filled_add(evas);
+        evas_object_image_size_set(o, IMG_W, IMG_H);
+        evas_object_image_alpha_set(o, EINA_TRUE);
+        evas_object_image_data_copy_set(o, img);
+        evas_object_image_smooth_scale_set(o, i & 1);
+        evas_object_move(o, (i % 6) * 620 + 20, (i / 6) * 520 + 40);
+        evas_object_resize(o, (i & 1) ? 600 : IMG_W, (i & 1) ? 450 : IMG_H);
+        evas_object_show(o);
+        objs[n++] = o;
+     }
+
+   /* and translucent rectangles across them */
+   for (i = 0; i < 40; i++)
+     {
+        o = evas_object_rectangle_add(evas);
+        evas_object_color_set(o, (i * 37) & 0x7f, (i * 91) & 0x7f,
+                              (i * 53) & 0x7f, 128);
+        evas_object_move(o, (i * 97) % (OUT_W - 500), (i * 61) % (OUT_H - 300));
+        evas_object_resize(o, 200 + (i * 13) % 300, 100 + (i * 7) % 200);
+        evas_object_show(o);
+        objs[n++] = o;
+     }
+
+   /* the first frame also loads and sets everything up */
+   evas_render(evas);
+
+   t0 = evas_bench_time_get();
+   for (f = 0; f < FRAMES; f++)
+     {
+        for (i = 0; i < n; i++)
+          {
+             Evas_Coord x, y;
+
+             evas_object_geometry_get(objs[i], &x, &y, NULL, NULL);
+             evas_object_move(objs[i], x + ((f & 1) ? -1 : 1), y);
+          }
+        evas_damage_rectangle_add(evas, 0, 0, OUT_W, OUT_H);
+        evas_render(evas);
+     }
+   t = (evas_bench_time_get() - t0) / FRAMES;
+
+   evas_free(evas);
+   evas_shutdown();
+
+   return t;
+}
+
+static void
+_pipe_render(FILE *out, int threads, void *data EINA_UNUSED)
+{
+   unsigned int *pixels, *img;
+   double t;
+
+   pixels = malloc(OUT_W * OUT_H * sizeof (unsigned int));
+   img = malloc(IMG_W * IMG_H * sizeof (unsigned int));
+   if ((!pixels) || (!img))
+     {
+        free(img);
+        free(pixels);
+        return;
+     }
+   _image_fill(img);
+
+   t = _scene_render(pixels, img);
+   fprintf(out, "%i\t%.3f\n", threads, t * 1000.0);
+   fprintf(stderr, "Run render_4k: %i threads %.3f ms/frame\n",
+           threads, t * 1000.0);
+
+   free(img);
+   free(pixels);
+}
+
+/* without --enable-pipe-render all runs draw on the main thread */
+void evas_bench_pipe(FILE *out)
+{
+   int i;
+
+   fprintf(out, "# threads\tms per frame (%ix%i, %i frames)\n",
+           OUT_W, OUT_H, FRAMES);
+   /* the pipe starts its threads once per process */
+   for (i = 1; i <= THREADS_MAX; i++)
+     evas_bench_threads_run(out, "EVAS_PIPE_THREADS", i, NULL,
+                            _pipe_render, NULL);
+}
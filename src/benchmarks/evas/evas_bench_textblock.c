@@ -0,0 +1,121 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <Eina.h>
+
+#include "Evas.h"
+#include "Evas_Engine_Buffer.h"
+#include "evas_thread_pool.h"
+#include "evas_bench.h"
+
+#define PARAGRAPHS 5000
+#define LAYOUTS 5
+#define THREADS_MAX 8
+
+static char *
+_markup_get(void)
+{
+   Eina_Strbuf *buf;
+   char *ret;
+   int i;
+
+   buf = eina_strbuf_new();
+   for (i = 0; i < PARAGRAPHS; i++)
+     {
+        eina_strbuf_append_printf(buf,
+              "Paragraph %i of a long document, long enough to wrap over "
+              "a few lines at the width the bench lays it out at, with "
+              "some <b>bold</b> and <i>italic</i> words thrown in.", i);
+        eina_strbuf_append(buf, "<ps/>");
+     }
+   ret = eina_strbuf_string_steal(buf);
+   eina_strbuf_free(buf);
+
+   return ret;
+}
+
+static double
+_document_load(const char *markup)
+{
+   Evas *evas;
+   Evas_Engine_Info *einfo;
+   Evas_Textblock_Style *st;
+   Evas_Object *tb;
+   Evas_Coord w, h;
+   double t0;
+   int i;
+
+   evas_init();
+   evas = evas_new();
+   evas_output_method_set(evas, evas_render_method_lookup("buffer"));
+   einfo = evas_engine_info_get(evas);
+   evas_engine_info_set(evas, einfo);
+   evas_output_size_set(evas, 500, 500);
+   evas_output_viewport_set(evas, 0, 0, 500, 500);
+
+   st = evas_textblock_style_new();
+   evas_textblock_style_set(st,
+         "DEFAULT='font=Sans font_size=10 color=#000 wrap=word'"
+         "b='+ font_weight=bold'"
+         "i='+ font_style=italic'");
+
+   tb = evas_object_textblock_add(evas);
+   evas_object_textblock_style_set(tb, st);
+
+   /* a new document, then the window being resized a few times */
+   t0 = evas_bench_time_get();
+   evas_object_textblock_text_markup_set(tb, markup);
+   for (i = 0; i < LAYOUTS; i++)
+     {
+        evas_object_resize(tb, 300 + (i * 40), 500);
+        evas_object_textblock_size_formatted_get(tb, &w, &h);
+     }
+   t0 = (evas_bench_time_get() - t0) / LAYOUTS;
+
+   evas_object_del(tb);
+   evas_textblock_style_free(st);
+   evas_free(evas);
+   evas_shutdown();
+
+   return t0;
+}
+
+/* the pool is resized between runs, evas stays up in a single child as
+ * eo can't be set up again in the bench process once shut down */
+static void
+_textblock_loads(FILE *out, int threads EINA_UNUSED, void *data)
+{
+   const char *markup = data;
+   double t;
+   int i;
+
+   evas_init();
+   for (i = 1; i <= THREADS_MAX; i++)
+     {
+        evas_thread_pool_threads_set(i);
+        t = _document_load(markup);
+        fprintf(out, "%i\t%.3f\n", i, t * 1000.0);
+        fprintf(stderr, "Run textblock_load: %i threads %.3f ms/layout\n",
+                i, t * 1000.0);
+     }
+   evas_shutdown();
+}
+
+void evas_bench_textblock(FILE *out)
+{
+   char *markup;
+
+   markup = _markup_get();
+   if (!markup) return;
+
+   fprintf(out, "# threads\tms per layout (%i paragraphs, %i layouts)\n",
+           PARAGRAPHS, LAYOUTS);
+   evas_bench_threads_run(out, "EVAS_POOL_THREADS", 1, NULL,
+                          _textblock_loads, markup);
+
+   free(markup);
+}
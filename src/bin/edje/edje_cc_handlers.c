@@ -8890,6 +8890,9 @@ st_collections_group_programs_program_name(void)
         Signals may be globbed, but only one signal keyword per program
         may be used. ex: signal: "mouse,clicked,*"; (clicking any mouse button
         that matches source starts program).
+        When a signal starts several programs, each runs once. Those with a
+        globbed signal or source run first, in a fixed order that does not
+        depend on the signal, those matching it literally run after them.
     @endproperty
 */
 static void
@@ -1110,6 +1110,13 @@ data_thread_group(void *data, Ecore_Thread *thread EINA_UNUSED)
    snprintf(buf, sizeof(buf), "edje/collections/%i", gw->pc->id);
    eet_data_write(gw->ef, edd_edje_part_collection, buf, gw->pc,
                   compress_mode);
+   if (!_edje_programs_automata_write(gw->ef, gw->pc))
+     {
+        snprintf(buf, sizeof(buf),
+                 "Unable to write the signal automata of group \"%s\"",
+                 gw->pc->part);
+        gw->errstr = strdup(buf);
+     }
    return;
 }
 
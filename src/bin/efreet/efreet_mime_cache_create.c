@@ -0,0 +1,159 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef HAVE_SYS_RESOURCE_H
+#include <sys/time.h>
+#include <sys/resource.h>
+#endif
+
+#include <Eina.h>
+#include <Eet.h>
+#include <Ecore.h>
+#include <Ecore_File.h>
+
+#define EFREET_MODULE_LOG_DOM _efreet_mime_cache_log_dom
+static int _efreet_mime_cache_log_dom = -1;
+
+#include "Efreet.h"
+#include "efreet_private.h"
+#include "efreet_cache_private.h"
+
+static int
+cache_lock_file(void)
+{
+    char file[PATH_MAX];
+    struct flock fl;
+    int lockfd;
+
+    snprintf(file, sizeof(file), "%s/efreet/mime_data.lock", efreet_cache_home_get());
+    lockfd = open(file, O_CREAT | O_RDWR, S_IRUSR | S_IWUSR);
+    if (lockfd < 0) return -1;
+    efreet_fsetowner(lockfd);
+
+    memset(&fl, 0, sizeof(struct flock));
+    fl.l_type = F_WRLCK;
+    fl.l_whence = SEEK_SET;
+    if (fcntl(lockfd, F_SETLK, &fl) < 0)
+    {
+        INF("LOCKED! You may want to delete %s if this persists", file);
+        close(lockfd);
+        return -1;
+    }
+
+    return lockfd;
+}
+
+int
+main(int argc, char **argv)
+{
+    int lockfd = -1, tmpfd;
+    int changed = 0;
+    int i;
+    char file[PATH_MAX] = { '\0' };
+    mode_t um;
+
+    if (!eina_init()) goto eina_error;
+    _efreet_mime_cache_log_dom =
+        eina_log_domain_register("efreet_mime_cache", EFREET_DEFAULT_LOG_COLOR);
+    if (_efreet_mime_cache_log_dom < 0)
+    {
+        EINA_LOG_ERR("Efreet: Could not create a log domain for efreet_mime_cache.");
+        return -1;
+    }
+
+    for (i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "-v"))
+            eina_log_domain_level_set("efreet_mime_cache", EINA_LOG_LEVEL_DBG);
+        else if ((!strcmp(argv[i], "-h")) ||
+                 (!strcmp(argv[i], "-help")) ||
+                 (!strcmp(argv[i], "--h")) ||
+                 (!strcmp(argv[i], "--help")))
+        {
+            printf("Options:\n");
+            printf("  -v              Verbose mode\n");
+            exit(0);
+        }
+    }
+
+#ifdef HAVE_SYS_RESOURCE_H
+    setpriority(PRIO_PROCESS, 0, 19);
+#elif _WIN32
+    SetPriorityClass(GetCurrentProcess(), IDLE_PRIORITY_CLASS);
+#endif
+
+    /* init external subsystems */
+    if (!ecore_init()) goto ecore_error;
+
+    efreet_cache_update = 0;
+    /* finish efreet init */
+    if (!efreet_init()) goto efreet_error;
+
+    /* create homedir */
+    snprintf(file, sizeof(file), "%s/efreet", efreet_cache_home_get());
+    if (!ecore_file_exists(file))
+    {
+        if (!ecore_file_mkpath(file)) goto efreet_error;
+        efreet_setowner(file);
+    }
+
+    /* lock process, so that we only run one copy of this program */
+    lockfd = cache_lock_file();
+    if (lockfd == -1) goto efreet_error;
+
+    /* nothing to do if none of the globs and magic files changed */
+    if (!efreet_mime_cache_valid(efreet_mime_cache_file()))
+    {
+        /* create cache */
+        snprintf(file, sizeof(file), "%s.XXXXXX", efreet_mime_cache_file());
+        /* set secure umask for temporary files */
+        um = umask(0077);
+        tmpfd = mkstemp(file);
+        umask(um);
+        if (tmpfd < 0) goto error;
+        close(tmpfd);
+
+        INF("Compiling %s", efreet_mime_cache_file());
+        if (!efreet_mime_cache_write(file))
+        {
+            unlink(file);
+            goto error;
+        }
+
+        /* replace the old cache, clients still using it keep their map */
+        if (rename(file, efreet_mime_cache_file()) < 0)
+        {
+            unlink(file);
+            goto error;
+        }
+        efreet_setowner(efreet_mime_cache_file());
+        changed = 1;
+    }
+
+    {
+        char c = 'n';
+
+        if (changed) c = 'c';
+        printf("%c\n", c);
+    }
+
+    efreet_shutdown();
+    ecore_shutdown();
+    eina_log_domain_unregister(_efreet_mime_cache_log_dom);
+    eina_shutdown();
+    close(lockfd);
+    return 0;
+error:
+    efreet_shutdown();
+efreet_error:
+    ecore_shutdown();
+ecore_error:
+    eina_log_domain_unregister(_efreet_mime_cache_log_dom);
+    eina_shutdown();
+eina_error:
+    if (lockfd >= 0) close(lockfd);
+    return 1;
+}
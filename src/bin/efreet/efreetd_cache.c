@@ -12,6 +12,7 @@
 #include "Efreet.h"
 #define EFREET_MODULE_LOG_DOM efreetd_log_dom
 #include "efreet_private.h"
+#include "efreet_cache_private.h"
 #include "efreetd_cache.h"
 
 #include <sys/types.h>
@@ -20,13 +21,16 @@
 
 static Eina_Hash *icon_change_monitors = NULL;
 static Eina_Hash *desktop_change_monitors = NULL;
+static Eina_Hash *mime_change_monitors = NULL;
 
 static Ecore_Event_Handler *cache_exe_del_handler = NULL;
 static Ecore_Event_Handler *cache_exe_data_handler = NULL;
 static Ecore_Exe           *icon_cache_exe = NULL;
 static Ecore_Exe           *desktop_cache_exe = NULL;
+static Ecore_Exe           *mime_cache_exe = NULL;
 static Ecore_Timer         *icon_cache_timer = NULL;
 static Ecore_Timer         *desktop_cache_timer = NULL;
+static Ecore_Timer         *mime_cache_timer = NULL;
 static Eina_Prefix         *pfx = NULL;
 
 static Eina_Bool  desktop_exists = EINA_FALSE;
@@ -39,11 +43,13 @@ static Eina_Bool  icon_flush = EINA_FALSE;
 
 static Eina_Bool desktop_queue = EINA_FALSE;
 static Eina_Bool icon_queue = EINA_FALSE;
+static Eina_Bool mime_queue = EINA_FALSE;
 
 static void desktop_changes_monitor_add(const char *path);
 
 static void icon_changes_listen(void);
 static void desktop_changes_listen(void);
+static void mime_changes_listen(void);
 
 /* internal */
 static Eina_Bool
@@ -144,6 +150,35 @@ desktop_cache_update_cache_cb(void *data EINA_UNUSED)
    return ECORE_CALLBACK_CANCEL;
 }
 
+static Eina_Bool
+mime_cache_update_cache_cb(void *data EINA_UNUSED)
+{
+   char file[PATH_MAX];
+
+   mime_cache_timer = NULL;
+
+   if (mime_cache_exe)
+     {
+        mime_queue = EINA_TRUE;
+        return ECORE_CALLBACK_CANCEL;
+     }
+   mime_queue = EINA_FALSE;
+
+   if (mime_change_monitors) eina_hash_free(mime_change_monitors);
+   mime_change_monitors = eina_hash_string_superfast_new
+     (EINA_FREE_CB(ecore_file_monitor_del));
+   mime_changes_listen();
+
+   snprintf(file, sizeof(file),
+            "%s/efreet/" MODULE_ARCH "/efreet_mime_cache_create",
+            eina_prefix_lib_get(pfx));
+   INF("Run mime cache creation: %s", file);
+   mime_cache_exe = ecore_exe_pipe_run
+     (file, ECORE_EXE_PIPE_READ | ECORE_EXE_PIPE_READ_LINE_BUFFERED, NULL);
+
+   return ECORE_CALLBACK_CANCEL;
+}
+
 static void
 cache_icon_update(Eina_Bool flush)
 {
@@ -159,6 +194,33 @@ cache_desktop_update(void)
    desktop_cache_timer = ecore_timer_add(0.2, desktop_cache_update_cache_cb, NULL);
 }
 
+static void
+cache_mime_update(void)
+{
+   if (mime_cache_timer) ecore_timer_del(mime_cache_timer);
+   mime_cache_timer = ecore_timer_add(0.2, mime_cache_update_cache_cb, NULL);
+}
+
+/* the same files efreet_mime reads */
+static Eina_List *
+mime_sources_get(void)
+{
+   Eina_List *sources = NULL, *l;
+   char buf[PATH_MAX];
+   const char *dir;
+
+   snprintf(buf, sizeof(buf), "%s/mime", efreet_data_home_get());
+   sources = eina_list_append(sources, eina_stringshare_add(buf));
+   EINA_LIST_FOREACH(efreet_data_dirs_get(), l, dir)
+     {
+        snprintf(buf, sizeof(buf), "%s/mime", dir);
+        sources = eina_list_append(sources, eina_stringshare_add(buf));
+     }
+   sources = eina_list_append(sources, eina_stringshare_add("/etc/mime.types"));
+
+   return sources;
+}
+
 static void
 icon_changes_cb(void *data EINA_UNUSED, Ecore_File_Monitor *em EINA_UNUSED,
                 Ecore_File_Event event, const char *path EINA_UNUSED)
@@ -222,6 +284,41 @@ desktop_changes_cb(void *data EINA_UNUSED, Ecore_File_Monitor *em EINA_UNUSED,
      }
 }
 
+static void
+mime_changes_cb(void *data EINA_UNUSED, Ecore_File_Monitor *em EINA_UNUSED,
+                Ecore_File_Event event, const char *path EINA_UNUSED)
+{
+   /* globs, magic or mime.types changed, or a mime dir came or went */
+   if (event != ECORE_FILE_EVENT_NONE)
+     cache_mime_update();
+}
+
+static void
+mime_parent_changes_cb(void *data EINA_UNUSED, Ecore_File_Monitor *em EINA_UNUSED,
+                       Ecore_File_Event event, const char *path)
+{
+   Eina_List *sources;
+   const char *source;
+   Eina_Bool wanted = EINA_FALSE;
+   size_t len;
+
+   if (event == ECORE_FILE_EVENT_NONE) return;
+
+   /* this stands in for mime sources that don't exist yet, only them or
+    * one of their parents showing up matters. The update monitors again,
+    * closer to them */
+   len = strlen(path);
+   sources = mime_sources_get();
+   EINA_LIST_FREE(sources, source)
+     {
+        if ((!strncmp(source, path, len)) &&
+            ((source[len] == '/') || (!source[len])))
+          wanted = EINA_TRUE;
+        eina_stringshare_del(source);
+     }
+   if (wanted) cache_mime_update();
+}
+
 static void
 icon_changes_monitor_add(const char *path)
 {
@@ -248,6 +345,27 @@ desktop_changes_monitor_add(const char *path)
      eina_hash_add(desktop_change_monitors, path, mon);
 }
 
+static void
+mime_changes_monitor_add(const char *path)
+{
+   Ecore_File_Monitor *mon;
+   char *watch;
+
+   /* a missing path is watched for through its nearest existing parent */
+   watch = efreet_cache_watch_path_get(path);
+   if (!watch) return;
+   if (!eina_hash_find(mime_change_monitors, watch))
+     {
+        if (!strcmp(watch, path))
+          mon = ecore_file_monitor_add(watch, mime_changes_cb, NULL);
+        else
+          mon = ecore_file_monitor_add(watch, mime_parent_changes_cb, NULL);
+        if (mon)
+          eina_hash_add(mime_change_monitors, watch, mon);
+     }
+   free(watch);
+}
+
 static int
 stat_cmp(const void *a, const void *b)
 {
@@ -396,6 +514,20 @@ desktop_changes_listen(void)
    eina_inarray_free(stack);
 }
 
+static void
+mime_changes_listen(void)
+{
+   Eina_List *sources;
+   const char *source;
+
+   sources = mime_sources_get();
+   EINA_LIST_FREE(sources, source)
+     {
+        mime_changes_monitor_add(source);
+        eina_stringshare_del(source);
+     }
+}
+
 static void
 fill_list(const char *file, Eina_List **l)
 {
@@ -488,6 +620,11 @@ cache_exe_del_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
         icon_cache_exe = NULL;
         if (icon_queue) cache_icon_update(EINA_FALSE);
      }
+   else if (ev->exe == mime_cache_exe)
+     {
+        mime_cache_exe = NULL;
+        if (mime_queue) cache_mime_update();
+     }
    return ECORE_CALLBACK_RENEW;
 }
 
@@ -583,6 +720,8 @@ cache_init(void)
      (EINA_FREE_CB(ecore_file_monitor_del));
    desktop_change_monitors = eina_hash_string_superfast_new
      (EINA_FREE_CB(ecore_file_monitor_del));
+   mime_change_monitors = eina_hash_string_superfast_new
+     (EINA_FREE_CB(ecore_file_monitor_del));
 
    efreet_cache_update = 0;
    if (!efreet_init()) goto error;
@@ -597,8 +736,10 @@ cache_init(void)
                                                       efreet_data_dirs_get(), "desktop-directories"));
    icon_changes_listen();
    desktop_changes_listen();
+   mime_changes_listen();
    cache_icon_update(EINA_FALSE);
    cache_desktop_update();
+   cache_mime_update();
 
    return EINA_TRUE;
 error:
@@ -628,6 +769,8 @@ cache_shutdown(void)
    icon_change_monitors = NULL;
    if (desktop_change_monitors) eina_hash_free(desktop_change_monitors);
    desktop_change_monitors = NULL;
+   if (mime_change_monitors) eina_hash_free(mime_change_monitors);
+   mime_change_monitors = NULL;
    EINA_LIST_FREE(desktop_system_dirs, data)
       eina_stringshare_del(data);
    EINA_LIST_FREE(desktop_extra_dirs, data)
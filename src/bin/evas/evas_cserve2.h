@@ -240,6 +240,7 @@ typedef enum {
 typedef enum {
    CSERVE2_REQ_IMAGE_OPEN = 0,
    CSERVE2_REQ_IMAGE_LOAD,
+   CSERVE2_REQ_IMAGE_PRELOAD,
    CSERVE2_REQ_IMAGE_SPEC_LOAD,
    CSERVE2_REQ_FONT_LOAD,
    CSERVE2_REQ_FONT_GLYPHS_LOAD,
@@ -313,6 +314,13 @@ void cserve2_command_run(Client *client, Message_Type type);
 void cserve2_scale_init(void);
 void cserve2_scale_shutdown(void);
 
+void cserve2_disk_cache_init(void);
+void cserve2_disk_cache_shutdown(void);
+Shm_Handle *cserve2_disk_cache_load(const char *path, const char *key, const Evas_Image_Load_Opts *opts, int *w, int *h, Eina_Bool *alpha, Eina_Bool *alpha_sparse);
+void cserve2_disk_cache_save(const char *path, const char *key, const Evas_Image_Load_Opts *opts, const void *data, int w, int h, Eina_Bool alpha, Eina_Bool alpha_sparse);
+void cserve2_disk_cache_flush(void);
+void cserve2_disk_cache_file_changed(const char *path);
+
 void cserve2_cache_init(void);
 void cserve2_cache_shutdown(void);
 void cserve2_cache_client_new(Client *client);
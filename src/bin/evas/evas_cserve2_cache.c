@@ -809,6 +809,7 @@ _scaling_do(Shm_Handle *scale_shm, Image_Data *idata, Image_Entry *original)
    char *scale_map, *orig_map;
    void *src_data, *dst_data;
    Image_Data *orig_idata;
+   File_Data *fd;
 
    orig_idata = _image_data_find(original->base.id);
    if (!orig_idata)
@@ -853,12 +854,52 @@ _scaling_do(Shm_Handle *scale_shm, Image_Data *idata, Image_Entry *original)
             idata->opts.scale_load.dst_w, idata->opts.scale_load.dst_h,
             idata->alpha, idata->opts.scale_load.smooth);
 
+   fd = _file_data_find(idata->file_id);
+   if (fd)
+     cserve2_disk_cache_save(cserve2_shared_string_get(fd->path),
+                             cserve2_shared_string_get(fd->key),
+                             &idata->opts, dst_data,
+                             idata->opts.scale_load.dst_w,
+                             idata->opts.scale_load.dst_h,
+                             idata->alpha, idata->alpha_sparse);
+
    cserve2_shm_unmap(original->shm);
    cserve2_shm_unmap(scale_shm);
 
    return 0;
 }
 
+static Eina_Bool
+_scaled_image_disk_load(Image_Entry *ientry)
+{
+   Image_Data *idata;
+   File_Data *fd;
+   Shm_Handle *shm;
+   int w, h;
+   Eina_Bool alpha, alpha_sparse;
+
+   idata = _image_data_find(ENTRYID(ientry));
+   if (!idata) return EINA_FALSE;
+   fd = _file_data_find(idata->file_id);
+   if (!fd || fd->changed) return EINA_FALSE;
+
+   shm = cserve2_disk_cache_load(cserve2_shared_string_get(fd->path),
+                                 cserve2_shared_string_get(fd->key),
+                                 &idata->opts, &w, &h, &alpha, &alpha_sparse);
+   if (!shm) return EINA_FALSE;
+
+   if (ientry->shm)
+     cserve2_shm_unref(ientry->shm);
+   ientry->shm = shm;
+   idata->w = w;
+   idata->h = h;
+   idata->alpha = alpha;
+   idata->alpha_sparse = alpha_sparse;
+   _entry_load_finish(ASENTRY(ientry));
+
+   return EINA_TRUE;
+}
+
 static int
 _scaling_prepare_and_do(Image_Entry *ientry, Image_Data *idata)
 {
@@ -1177,6 +1218,8 @@ _file_watch_free(void *data)
 {
    File_Watch *fw = data;
    cserve2_file_change_watch_del(fw->path);
+   /* it may change unnoticed from now on */
+   cserve2_disk_cache_file_changed(fw->path);
    eina_stringshare_del(fw->path);
    eina_list_free(fw->entries);
    free(fw);
@@ -1671,12 +1714,14 @@ _image_entry_new(Client *client, int rid,
 }
 
 static void
-_file_changed_cb(const char *path EINA_UNUSED, Eina_Bool deleted EINA_UNUSED, void *data)
+_file_changed_cb(const char *path, Eina_Bool deleted EINA_UNUSED, void *data)
 {
    File_Watch *fw = data;
    File_Entry *fentry;
    Eina_List *l, *l_next;
 
+   cserve2_disk_cache_file_changed(path);
+
    EINA_LIST_FOREACH_SAFE(fw->entries, l, l_next, fentry)
      {
         Eina_List *ll, *ll_next;
@@ -2903,6 +2948,8 @@ cserve2_cache_image_entry_create(Client *client, int rid,
 
    if (opts && opts->scale_load.dst_w && opts->scale_load.dst_h)
      {
+        if (_scaled_image_disk_load(ientry))
+          return 0;
         if (!_cserve2_cache_fast_scaling_check(client, ientry, client_file_id))
           return 0;
      }
@@ -2915,8 +2962,9 @@ cserve2_cache_image_entry_create(Client *client, int rid,
    return 0;
 }
 
-void
-cserve2_cache_image_load(Client *client, unsigned int client_image_id, unsigned int rid)
+static void
+_image_load_request(Client *client, unsigned int client_image_id,
+                    unsigned int rid, Slave_Request_Type type)
 {
    Image_Entry *ientry;
    Image_Data *idata;
@@ -2956,18 +3004,14 @@ cserve2_cache_image_load(Client *client, unsigned int client_image_id, unsigned
    if (ASENTRY(ientry)->request)
      {
         cserve2_request_waiter_add(ASENTRY(ientry)->request, rid, client);
-        if (!idata->doload)
-          {
-             cserve2_request_type_set(ASENTRY(ientry)->request,
-                                      CSERVE2_REQ_IMAGE_LOAD);
-          }
+        cserve2_request_type_set(ASENTRY(ientry)->request, type);
      }
    else if (ientry->shm)
      _image_loaded_send(client, ientry, idata, rid);
    else
      {
         File_Entry *fentry = _file_entry_find(idata->file_id);
-        ASENTRY(ientry)->request = cserve2_request_add(CSERVE2_REQ_IMAGE_LOAD,
+        ASENTRY(ientry)->request = cserve2_request_add(type,
                                                        rid, client,
                                                        ASENTRY(fentry)->request,
                                                        &_load_funcs,
@@ -2977,11 +3021,17 @@ cserve2_cache_image_load(Client *client, unsigned int client_image_id, unsigned
    idata->doload = EINA_TRUE;
 }
 
+void
+cserve2_cache_image_load(Client *client, unsigned int client_image_id, unsigned int rid)
+{
+   _image_load_request(client, client_image_id, rid, CSERVE2_REQ_IMAGE_LOAD);
+}
+
 void
 cserve2_cache_image_preload(Client *client, unsigned int client_image_id, unsigned int rid)
 {
-   // Same as normal load (for now)
-   return cserve2_cache_image_load(client, client_image_id, rid);
+   // Same as a normal load, but waits behind the images being shown
+   _image_load_request(client, client_image_id, rid, CSERVE2_REQ_IMAGE_PRELOAD);
 }
 
 void
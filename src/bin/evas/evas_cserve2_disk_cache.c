@@ -0,0 +1,740 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "evas_cserve2.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <time.h>
+#include <unistd.h>
+#include <utime.h>
+
+/* On-disk cache of scaled images, so thumbnails and scaled backgrounds
+ * survive a restart of the server. It is off unless
+ * EVAS_CSERVE2_DISK_CACHE_SIZE gives its size limit in kbytes. Entries
+ * live in EVAS_CSERVE2_DISK_CACHE_DIR, or evas_cserve2 in the user's cache
+ * directory, one file per scaled image, and the least recently used ones
+ * go first once the cache is full.
+ *
+ * The name of a file is a hash of the source file path, key, size and
+ * mtime plus the load and scale options; the full key is stored in the
+ * file too, to catch collisions. The source file is only stat()ed the
+ * first time it is looked up, until the server sees it change.
+ *
+ * Entries are written by a thread, in order, so the main loop never waits
+ * for the disk when it saves. They count in the cache size as soon as they
+ * are queued and are only looked up once they are on disk. */
+
+#define DISK_CACHE_MAGIC ('E' | 'C' << 8 | 'S' << 16 | '1' << 24)
+#define DISK_CACHE_SUFFIX ".img"
+#define DISK_CACHE_QUEUE_MAX 8
+#define DISK_CACHE_STAMPS_MAX 4096
+
+typedef struct _Disk_Cache_Header Disk_Cache_Header;
+typedef struct _Disk_Cache_Entry Disk_Cache_Entry;
+typedef struct _Disk_Cache_Job Disk_Cache_Job;
+
+struct _Disk_Cache_Header
+{
+   uint32_t magic;
+   uint32_t key_len; // including the terminating '\0'
+   uint32_t data_offset;
+   int32_t w, h;
+   uint8_t alpha;
+   uint8_t alpha_sparse;
+   uint8_t _reserved[2];
+};
+
+struct _Disk_Cache_Entry
+{
+   EINA_INLIST;
+   char name[24];
+   size_t size;
+   time_t used;
+};
+
+struct _Disk_Cache_Job
+{
+   EINA_INLIST;
+   Disk_Cache_Header header;
+   char name[24];
+   char *key;
+   void *data;
+   size_t size;
+   Eina_List *evicted; // names of the files to remove first
+   Eina_Bool written;
+};
+
+static char *_cache_dir = NULL;
+static size_t _cache_max_size = 0;
+static size_t _cache_size = 0; // including the entries being written
+static Eina_Hash *_cache_entries = NULL; // file name --> entry
+static Eina_Inlist *_cache_lru = NULL; // least recently used first
+static Eina_Hash *_cache_stamps = NULL; // source path --> size, mtime, inode
+
+/* The writer thread and what it shares with the main loop, under
+ * _writer_lock. Its pipe wakes the main loop up when jobs are done. */
+static Eina_Thread _writer;
+static Eina_Bool _writer_running = EINA_FALSE;
+static Eina_Bool _writer_exit = EINA_FALSE;
+static Eina_Lock _writer_lock;
+static Eina_Condition _writer_cond;
+static Eina_Inlist *_writer_queue = NULL;
+static Eina_Inlist *_writer_done = NULL;
+static Disk_Cache_Job *_writer_job = NULL;
+static unsigned int _writer_count = 0; // queued or being written
+static int _writer_pipe[2] = { -1, -1 };
+
+static const char *
+_disk_cache_stamp_get(const char *path)
+{
+   const char *stamp;
+   struct stat st;
+   char buf[64];
+
+   stamp = eina_hash_find(_cache_stamps, path);
+   if (stamp) return stamp;
+
+   /* forget the files not looked up for a while rather than grow */
+   if (eina_hash_population(_cache_stamps) >= DISK_CACHE_STAMPS_MAX)
+     eina_hash_free_buckets(_cache_stamps);
+
+   if (stat(path, &st) || !S_ISREG(st.st_mode))
+     return NULL;
+
+   snprintf(buf, sizeof(buf), "%lld:%lld:%llu",
+            (long long) st.st_size, (long long) st.st_mtime,
+            (unsigned long long) st.st_ino);
+   stamp = strdup(buf);
+   if (!stamp || !eina_hash_add(_cache_stamps, path, stamp))
+     {
+        free((char *) stamp);
+        return NULL;
+     }
+
+   return stamp;
+}
+
+static Eina_Bool
+_disk_cache_key_get(const char *path, const char *key,
+                    const Evas_Image_Load_Opts *opts, char *buf, int size)
+{
+   const char *stamp;
+   int len;
+
+   stamp = _disk_cache_stamp_get(path);
+   if (!stamp) return EINA_FALSE;
+
+   len = snprintf(buf, size,
+                  "%s:%s:%s:%0.3f:%dx%d:%d:%d,%d+%dx%d:"
+                  "[%d,%d:%dx%d]-[%dx%d:%d]:%d:%d",
+                  path, key ? key : "", stamp,
+                  opts->dpi, opts->w, opts->h, opts->scale_down_by,
+                  opts->region.x, opts->region.y,
+                  opts->region.w, opts->region.h,
+                  opts->scale_load.src_x, opts->scale_load.src_y,
+                  opts->scale_load.src_w, opts->scale_load.src_h,
+                  opts->scale_load.dst_w, opts->scale_load.dst_h,
+                  opts->scale_load.smooth, opts->degree,
+                  opts->orientation);
+
+   return ((len > 0) && (len < size));
+}
+
+static void
+_disk_cache_name_get(const char *key, char *name, size_t size)
+{
+   int len = strlen(key);
+
+   snprintf(name, size, "%08x%08x" DISK_CACHE_SUFFIX,
+            (unsigned int) eina_hash_superfast(key, len),
+            (unsigned int) eina_hash_djb2(key, len));
+}
+
+static void
+_disk_cache_file_path_get(const char *name, char *path, size_t size)
+{
+   snprintf(path, size, "%s/%s", _cache_dir, name);
+}
+
+static void
+_disk_cache_entry_del(Disk_Cache_Entry *dce, Eina_Bool unlink_file)
+{
+   if (unlink_file)
+     {
+        char path[PATH_MAX];
+
+        _disk_cache_file_path_get(dce->name, path, sizeof(path));
+        if (unlink(path) && (errno != ENOENT))
+          WRN("Could not remove disk cache entry %s: %m", path);
+     }
+
+   _cache_size -= dce->size;
+   _cache_lru = eina_inlist_remove(_cache_lru, EINA_INLIST_GET(dce));
+   eina_hash_del_by_key(_cache_entries, dce->name);
+}
+
+static void
+_disk_cache_entry_add(const char *name, size_t size, time_t used)
+{
+   Disk_Cache_Entry *dce, *old;
+
+   old = eina_hash_find(_cache_entries, name);
+   if (old)
+     _disk_cache_entry_del(old, EINA_FALSE);
+
+   dce = calloc(1, sizeof(*dce));
+   if (!dce) return;
+
+   eina_strlcpy(dce->name, name, sizeof(dce->name));
+   dce->size = size;
+   dce->used = used;
+   _cache_size += size;
+
+   /* Entries found at startup are not added in order of use */
+   EINA_INLIST_FOREACH(_cache_lru, old)
+     if (old->used > used) break;
+   if (old)
+     _cache_lru = eina_inlist_prepend_relative(_cache_lru,
+                                              EINA_INLIST_GET(dce),
+                                              EINA_INLIST_GET(old));
+   else
+     _cache_lru = eina_inlist_append(_cache_lru, EINA_INLIST_GET(dce));
+
+   eina_hash_add(_cache_entries, dce->name, dce);
+}
+
+static void
+_disk_cache_entry_used(Disk_Cache_Entry *dce)
+{
+   char path[PATH_MAX];
+
+   dce->used = time(NULL);
+   _cache_lru = eina_inlist_demote(_cache_lru, EINA_INLIST_GET(dce));
+
+   /* the modification time keeps the order across restarts */
+   _disk_cache_file_path_get(dce->name, path, sizeof(path));
+   utime(path, NULL);
+}
+
+/* Makes room for needed more bytes. The files of the evicted entries are
+ * removed right away, or by the writer before it writes job. */
+static void
+_disk_cache_trim(size_t needed, Disk_Cache_Job *job)
+{
+   while (_cache_lru && ((_cache_size + needed) > _cache_max_size))
+     {
+        Disk_Cache_Entry *dce;
+
+        dce = EINA_INLIST_CONTAINER_GET(_cache_lru, Disk_Cache_Entry);
+        DBG("Evicting %s (%zu bytes) from the disk cache.",
+            dce->name, dce->size);
+        if (job)
+          job->evicted = eina_list_append(job->evicted, strdup(dce->name));
+        _disk_cache_entry_del(dce, !job);
+     }
+}
+
+static void
+_disk_cache_job_free(Disk_Cache_Job *job)
+{
+   char *name;
+
+   EINA_LIST_FREE(job->evicted, name)
+     free(name);
+   free(job->key);
+   free(job->data);
+   free(job);
+}
+
+/* Runs on the writer thread, only touches the job and _cache_dir */
+static Eina_Bool
+_disk_cache_job_write(Disk_Cache_Job *job)
+{
+   char file[PATH_MAX], tmp[PATH_MAX];
+   size_t image_size;
+   const char *name;
+   Eina_List *l;
+   ssize_t ret;
+   int fd;
+
+   EINA_LIST_FOREACH(job->evicted, l, name)
+     {
+        _disk_cache_file_path_get(name, file, sizeof(file));
+        if (unlink(file) && (errno != ENOENT))
+          WRN("Could not remove disk cache entry %s: %m", file);
+     }
+
+   /* Written aside and renamed, so a crash never leaves half an image */
+   _disk_cache_file_path_get(job->name, file, sizeof(file));
+   snprintf(tmp, sizeof(tmp), "%s.tmp", file);
+   fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR);
+   if (fd == -1)
+     {
+        ERR("Could not create disk cache entry %s: %m", tmp);
+        return EINA_FALSE;
+     }
+
+   image_size = job->size - job->header.data_offset;
+   if (ftruncate(fd, job->size))
+     goto error;
+
+   ret = pwrite(fd, &job->header, sizeof(job->header), 0);
+   if (ret != (ssize_t) sizeof(job->header)) goto error;
+   ret = pwrite(fd, job->key, job->header.key_len, sizeof(job->header));
+   if (ret != (ssize_t) job->header.key_len) goto error;
+   ret = pwrite(fd, job->data, image_size, job->header.data_offset);
+   if (ret != (ssize_t) image_size) goto error;
+
+   close(fd);
+   if (rename(tmp, file))
+     {
+        ERR("Could not rename disk cache entry %s: %m", tmp);
+        unlink(tmp);
+        return EINA_FALSE;
+     }
+
+   return EINA_TRUE;
+
+error:
+   ERR("Could not write disk cache entry %s: %m", tmp);
+   close(fd);
+   unlink(tmp);
+   return EINA_FALSE;
+}
+
+static void *
+_disk_cache_writer_cb(void *data EINA_UNUSED, Eina_Thread t EINA_UNUSED)
+{
+   char c = 0;
+
+   eina_lock_take(&_writer_lock);
+   while (1)
+     {
+        while (!_writer_queue && !_writer_exit)
+          eina_condition_wait(&_writer_cond);
+        if (!_writer_queue) break;
+
+        _writer_job = EINA_INLIST_CONTAINER_GET(_writer_queue, Disk_Cache_Job);
+        _writer_queue = eina_inlist_remove(_writer_queue, _writer_queue);
+        eina_lock_release(&_writer_lock);
+
+        _writer_job->written = _disk_cache_job_write(_writer_job);
+
+        eina_lock_take(&_writer_lock);
+        _writer_done = eina_inlist_append(_writer_done,
+                                          EINA_INLIST_GET(_writer_job));
+        _writer_job = NULL;
+        eina_condition_broadcast(&_writer_cond);
+        if (write(_writer_pipe[1], &c, 1) != 1)
+          WRN("Could not wake the main loop up: %m");
+     }
+   eina_lock_release(&_writer_lock);
+
+   return NULL;
+}
+
+/* Back on the main loop: written entries can be looked up now */
+static void
+_disk_cache_jobs_done(void)
+{
+   Eina_Inlist *done;
+   Disk_Cache_Job *job;
+
+   eina_lock_take(&_writer_lock);
+   done = _writer_done;
+   _writer_done = NULL;
+   eina_lock_release(&_writer_lock);
+
+   while (done)
+     {
+        job = EINA_INLIST_CONTAINER_GET(done, Disk_Cache_Job);
+        done = eina_inlist_remove(done, done);
+        _writer_count--;
+
+        /* it was counted in the cache size until now */
+        _cache_size -= job->size;
+        if (job->written)
+          {
+             _disk_cache_entry_add(job->name, job->size, time(NULL));
+             DBG("Saved %dx%d scaled image to the disk cache as %s.",
+                 job->header.w, job->header.h, job->name);
+          }
+        _disk_cache_job_free(job);
+     }
+}
+
+static void
+_disk_cache_writer_wake_cb(int fd, Fd_Flags flags EINA_UNUSED,
+                           void *data EINA_UNUSED)
+{
+   char buf[64];
+
+   while (read(fd, buf, sizeof(buf)) > 0)
+     ;
+   _disk_cache_jobs_done();
+}
+
+static Eina_Bool
+_disk_cache_writer_start(void)
+{
+   if (pipe(_writer_pipe))
+     {
+        ERR("Could not create the disk cache writer pipe: %m");
+        return EINA_FALSE;
+     }
+   fcntl(_writer_pipe[0], F_SETFL, O_NONBLOCK);
+   fcntl(_writer_pipe[0], F_SETFD, FD_CLOEXEC);
+   fcntl(_writer_pipe[1], F_SETFD, FD_CLOEXEC);
+
+   if (!eina_lock_new(&_writer_lock))
+     goto on_error;
+   if (!eina_condition_new(&_writer_cond, &_writer_lock))
+     {
+        eina_lock_free(&_writer_lock);
+        goto on_error;
+     }
+
+   _writer_exit = EINA_FALSE;
+   if (!eina_thread_create(&_writer, EINA_THREAD_BACKGROUND, -1,
+                           _disk_cache_writer_cb, NULL))
+     {
+        ERR("Could not start the disk cache writer.");
+        eina_condition_free(&_writer_cond);
+        eina_lock_free(&_writer_lock);
+        goto on_error;
+     }
+
+   cserve2_fd_watch_add(_writer_pipe[0], FD_READ,
+                        _disk_cache_writer_wake_cb, NULL);
+   _writer_running = EINA_TRUE;
+   return EINA_TRUE;
+
+on_error:
+   close(_writer_pipe[0]);
+   close(_writer_pipe[1]);
+   _writer_pipe[0] = _writer_pipe[1] = -1;
+   return EINA_FALSE;
+}
+
+static void
+_disk_cache_writer_stop(void)
+{
+   if (!_writer_running) return;
+
+   cserve2_disk_cache_flush();
+
+   eina_lock_take(&_writer_lock);
+   _writer_exit = EINA_TRUE;
+   eina_condition_broadcast(&_writer_cond);
+   eina_lock_release(&_writer_lock);
+   eina_thread_join(_writer);
+   _writer_running = EINA_FALSE;
+
+   cserve2_fd_watch_del(_writer_pipe[0]);
+   close(_writer_pipe[0]);
+   close(_writer_pipe[1]);
+   _writer_pipe[0] = _writer_pipe[1] = -1;
+   eina_condition_free(&_writer_cond);
+   eina_lock_free(&_writer_lock);
+}
+
+static Eina_Bool
+_disk_cache_dir_setup(void)
+{
+   const char *env;
+   char buf[PATH_MAX];
+
+   env = getenv("EVAS_CSERVE2_DISK_CACHE_DIR");
+   if (env && env[0])
+     eina_strlcpy(buf, env, sizeof(buf));
+   else
+     {
+        env = getenv("XDG_CACHE_HOME");
+        if (env && env[0])
+          snprintf(buf, sizeof(buf), "%s/evas_cserve2", env);
+        else
+          {
+             env = getenv("HOME");
+             if (!env || !env[0])
+               return EINA_FALSE;
+             snprintf(buf, sizeof(buf), "%s/.cache", env);
+             mkdir(buf, S_IRWXU);
+             snprintf(buf, sizeof(buf), "%s/.cache/evas_cserve2", env);
+          }
+     }
+
+   if (mkdir(buf, S_IRWXU) && (errno != EEXIST))
+     {
+        ERR("Could not create disk cache directory %s: %m", buf);
+        return EINA_FALSE;
+     }
+
+   _cache_dir = strdup(buf);
+   return !!_cache_dir;
+}
+
+static void
+_disk_cache_scan(void)
+{
+   Eina_Iterator *it;
+   Eina_File_Direct_Info *info;
+
+   it = eina_file_direct_ls(_cache_dir);
+   if (!it) return;
+
+   EINA_ITERATOR_FOREACH(it, info)
+     {
+        const char *name = info->path + info->name_start;
+        struct stat st;
+
+        if ((info->type != EINA_FILE_REG) ||
+            !eina_str_has_suffix(name, DISK_CACHE_SUFFIX) ||
+            (strlen(name) >= sizeof(((Disk_Cache_Entry *) 0)->name)))
+          {
+             /* leftovers of an interrupted write */
+             if (eina_str_has_suffix(name, ".tmp"))
+               unlink(info->path);
+             continue;
+          }
+        if (stat(info->path, &st))
+          continue;
+
+        _disk_cache_entry_add(name, st.st_size, st.st_mtime);
+     }
+   eina_iterator_free(it);
+
+   /* the limit may have been lowered since the last run */
+   _disk_cache_trim(0, NULL);
+
+   DBG("Disk cache at %s holds %d entries, %zu bytes.", _cache_dir,
+       eina_hash_population(_cache_entries), _cache_size);
+}
+
+void
+cserve2_disk_cache_init(void)
+{
+   const char *env;
+   long size;
+
+   env = getenv("EVAS_CSERVE2_DISK_CACHE_SIZE");
+   if (!env) return;
+
+   size = atol(env);
+   if (size <= 0) return;
+
+   if (!_disk_cache_dir_setup())
+     return;
+
+   _cache_max_size = (size_t) size * 1024;
+   _cache_entries = eina_hash_string_superfast_new(free);
+   _cache_stamps = eina_hash_string_superfast_new(free);
+   _disk_cache_scan();
+
+   if (!_disk_cache_writer_start())
+     cserve2_disk_cache_shutdown();
+}
+
+void
+cserve2_disk_cache_shutdown(void)
+{
+   if (!_cache_dir) return;
+
+   _disk_cache_writer_stop();
+
+   _cache_lru = NULL;
+   eina_hash_free(_cache_entries);
+   _cache_entries = NULL;
+   eina_hash_free(_cache_stamps);
+   _cache_stamps = NULL;
+   _cache_size = 0;
+   free(_cache_dir);
+   _cache_dir = NULL;
+}
+
+void
+cserve2_disk_cache_flush(void)
+{
+   if (!_writer_running) return;
+
+   eina_lock_take(&_writer_lock);
+   while (_writer_queue || _writer_job)
+     eina_condition_wait(&_writer_cond);
+   eina_lock_release(&_writer_lock);
+
+   _disk_cache_jobs_done();
+}
+
+void
+cserve2_disk_cache_file_changed(const char *path)
+{
+   if (!_cache_stamps) return;
+
+   eina_hash_del_by_key(_cache_stamps, path);
+}
+
+Shm_Handle *
+cserve2_disk_cache_load(const char *path, const char *key,
+                        const Evas_Image_Load_Opts *opts,
+                        int *w, int *h, Eina_Bool *alpha,
+                        Eina_Bool *alpha_sparse)
+{
+   const Disk_Cache_Header *header;
+   Disk_Cache_Entry *dce;
+   Shm_Handle *shm = NULL;
+   Eina_File *f;
+   char buf[4096], name[24], file[PATH_MAX];
+   const char *map;
+   char *shm_map;
+   size_t image_size;
+
+   if (!_cache_dir) return NULL;
+
+   if (!_disk_cache_key_get(path, key, opts, buf, sizeof(buf)))
+     return NULL;
+   _disk_cache_name_get(buf, name, sizeof(name));
+
+   dce = eina_hash_find(_cache_entries, name);
+   if (!dce) return NULL;
+
+   _disk_cache_file_path_get(name, file, sizeof(file));
+   f = eina_file_open(file, EINA_FALSE);
+   if (!f)
+     {
+        _disk_cache_entry_del(dce, EINA_FALSE);
+        return NULL;
+     }
+
+   map = eina_file_map_all(f, EINA_FILE_SEQUENTIAL);
+   if (!map) goto invalid;
+
+   header = (const Disk_Cache_Header *) map;
+   if ((eina_file_size_get(f) < sizeof(*header)) ||
+       (header->magic != DISK_CACHE_MAGIC) ||
+       (header->w != opts->scale_load.dst_w) ||
+       (header->h != opts->scale_load.dst_h) ||
+       (header->key_len != strlen(buf) + 1) ||
+       (header->data_offset < sizeof(*header) + header->key_len))
+     goto invalid;
+
+   image_size = (size_t) header->w * header->h * 4;
+   if (eina_file_size_get(f) != header->data_offset + image_size)
+     goto invalid;
+
+   if (memcmp(map + sizeof(*header), buf, header->key_len))
+     {
+        /* Another image hashed to the same name, keep the one on disk */
+        DBG("Disk cache collision on %s", name);
+        eina_file_map_free(f, (void *) map);
+        eina_file_close(f);
+        return NULL;
+     }
+
+   shm = cserve2_shm_request("img", image_size);
+   if (!shm) goto end;
+
+   shm_map = cserve2_shm_map(shm);
+   if (shm_map == MAP_FAILED)
+     {
+        cserve2_shm_unref(shm);
+        shm = NULL;
+        goto end;
+     }
+   memcpy(shm_map + cserve2_shm_map_offset_get(shm),
+          map + header->data_offset, image_size);
+   cserve2_shm_unmap(shm);
+
+   *w = header->w;
+   *h = header->h;
+   *alpha = header->alpha;
+   *alpha_sparse = header->alpha_sparse;
+
+   DBG("Loaded %dx%d scaled image of %s from the disk cache.",
+       *w, *h, path);
+   _disk_cache_entry_used(dce);
+
+end:
+   eina_file_map_free(f, (void *) map);
+   eina_file_close(f);
+   return shm;
+
+invalid:
+   WRN("Removing invalid disk cache entry %s", file);
+   if (map) eina_file_map_free(f, (void *) map);
+   eina_file_close(f);
+   _disk_cache_entry_del(dce, EINA_TRUE);
+   return NULL;
+}
+
+/* Queues the image for the writer, which owns a copy of it */
+void
+cserve2_disk_cache_save(const char *path, const char *key,
+                        const Evas_Image_Load_Opts *opts,
+                        const void *data, int w, int h,
+                        Eina_Bool alpha, Eina_Bool alpha_sparse)
+{
+   Disk_Cache_Entry *dce;
+   Disk_Cache_Job *job;
+   char buf[4096];
+   size_t image_size;
+
+   if (!_writer_running) return;
+   if ((w <= 0) || (h <= 0)) return;
+
+   if (_writer_count >= DISK_CACHE_QUEUE_MAX)
+     {
+        DBG("Disk cache writer is busy, not saving %dx%d image of %s",
+            w, h, path);
+        return;
+     }
+
+   if (!_disk_cache_key_get(path, key, opts, buf, sizeof(buf)))
+     return;
+
+   job = calloc(1, sizeof(*job));
+   if (!job) return;
+
+   _disk_cache_name_get(buf, job->name, sizeof(job->name));
+   job->header.magic = DISK_CACHE_MAGIC;
+   job->header.key_len = strlen(buf) + 1;
+   job->header.data_offset = sizeof(job->header) + job->header.key_len;
+   job->header.data_offset = (job->header.data_offset + 15) & ~15;
+   job->header.w = w;
+   job->header.h = h;
+   job->header.alpha = !!alpha;
+   job->header.alpha_sparse = !!alpha_sparse;
+   image_size = (size_t) w * h * 4;
+   job->size = job->header.data_offset + image_size;
+
+   if (job->size > _cache_max_size)
+     {
+        free(job);
+        return;
+     }
+
+   job->key = strdup(buf);
+   job->data = malloc(image_size);
+   if (!job->key || !job->data)
+     {
+        _disk_cache_job_free(job);
+        return;
+     }
+   memcpy(job->data, data, image_size);
+
+   /* a stale copy goes, and the new one counts from now on */
+   dce = eina_hash_find(_cache_entries, job->name);
+   if (dce) _disk_cache_entry_del(dce, EINA_FALSE);
+   _disk_cache_trim(job->size, job);
+   _cache_size += job->size;
+
+   eina_lock_take(&_writer_lock);
+   _writer_queue = eina_inlist_append(_writer_queue, EINA_INLIST_GET(job));
+   _writer_count++;
+   eina_condition_broadcast(&_writer_cond);
+   eina_lock_release(&_writer_lock);
+}
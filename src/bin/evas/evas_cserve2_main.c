@@ -394,6 +394,7 @@ main(int argc EINA_UNUSED, const char *argv[])
    cserve2_shared_index_init();
    cserve2_requests_init();
    cserve2_scale_init();
+   cserve2_disk_cache_init();
    cserve2_font_init();
    cserve2_cache_init();
    _clients_setup();
@@ -403,6 +404,7 @@ main(int argc EINA_UNUSED, const char *argv[])
    _clients_finish();
    cserve2_cache_shutdown();
    cserve2_font_shutdown();
+   cserve2_disk_cache_shutdown();
    cserve2_scale_shutdown();
    cserve2_requests_shutdown();
    cserve2_slaves_shutdown();
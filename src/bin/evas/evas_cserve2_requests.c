@@ -29,7 +29,8 @@ typedef struct _Slave_Worker Slave_Worker;
 /* This struct is used to match font request types to the respective slave
  * type, and the message type that will be used for that request. The order
  * of the request types on it is the order in which these requests will
- * be processed.
+ * be processed, so images being shown go before preloads, and those before
+ * speculative loads.
  */
 static const struct _Request_Match
 {
@@ -42,6 +43,7 @@ static const struct _Request_Match
 {
    { CSERVE2_REQ_IMAGE_OPEN, SLAVE_IMAGE, IMAGE_OPEN, 0 },
    { CSERVE2_REQ_IMAGE_LOAD, SLAVE_IMAGE, IMAGE_LOAD, 0 },
+   { CSERVE2_REQ_IMAGE_PRELOAD, SLAVE_IMAGE, IMAGE_LOAD, 1 },
    { CSERVE2_REQ_IMAGE_SPEC_LOAD, SLAVE_IMAGE, IMAGE_LOAD, 1 },
    { CSERVE2_REQ_FONT_LOAD, SLAVE_FONT, FONT_LOAD, 0 },
    { CSERVE2_REQ_FONT_GLYPHS_LOAD, SLAVE_FONT, FONT_GLYPHS_LOAD, 0 },
@@ -178,12 +180,32 @@ cserve2_request_waiter_add(Slave_Request *req, unsigned int rid, Client *client)
    _request_waiter_add(req, client, rid);
 }
 
+/* How urgent the interchangeable image load requests are, lower first.
+ * Other requests can't change type. */
+static int
+_request_load_urgency(Slave_Request_Type type)
+{
+   switch (type)
+     {
+      case CSERVE2_REQ_IMAGE_LOAD: return 0;
+      case CSERVE2_REQ_IMAGE_PRELOAD: return 1;
+      case CSERVE2_REQ_IMAGE_SPEC_LOAD: return 2;
+      default: return -1;
+     }
+}
+
+/* Requests only ever move to a more urgent queue: a preload must not turn
+ * an image someone is waiting for back into a background job. */
 void
 cserve2_request_type_set(Slave_Request *req, Slave_Request_Type type)
 {
    Eina_Inlist **from, **to;
+   int urgency, current;
 
-   if (req->processing || (type == req->type))
+   urgency = _request_load_urgency(type);
+   current = _request_load_urgency(req->type);
+   if (req->processing || (urgency < 0) || (current < 0) ||
+       (urgency >= current))
      return;
 
    from = &requests[req->type].waiting;
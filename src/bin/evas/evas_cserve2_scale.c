@@ -9,11 +9,13 @@ cserve2_scale_init(void)
    evas_common_image_init();
    evas_common_convert_init();
    evas_common_scale_init();
+   evas_thread_pool_init();
 }
 
 void
 cserve2_scale_shutdown(void)
 {
+   evas_thread_pool_shutdown();
    evas_common_image_shutdown();
 }
 
@@ -31,6 +33,56 @@ _cserve2_rgba_image_set(RGBA_Image *im, void *data, int w, int h, int alpha)
    im->cache_entry.allocated.h = h;
 }
 
+/* Big scales are cut into strips of destination rows that the evas thread
+ * pool works on in parallel. Each strip clips the same full scale, so the
+ * result is the same as doing it in one go. */
+#define SCALE_STRIP_ROWS 64
+#define SCALE_STRIP_MIN (512 * 512)
+
+typedef struct _Scale_Job Scale_Job;
+struct _Scale_Job
+{
+   RGBA_Image *src, *dst;
+   int src_x, src_y, src_w, src_h;
+   int dst_x, dst_y, dst_w, dst_h;
+   int rows;
+   int smooth;
+};
+
+static void
+_cserve2_rgba_image_scale_strip(void *data, unsigned int idx)
+{
+   Scale_Job *job = data;
+   RGBA_Draw_Context ct;
+   int y, h;
+
+   y = idx * job->rows;
+   h = job->dst->cache_entry.h - y;
+   if (h > job->rows) h = job->rows;
+
+   memset(&ct, 0, sizeof(ct));
+   ct.sli.h = 1;
+   ct.render_op = _EVAS_RENDER_COPY;
+   ct.clip.use = 1;
+   ct.clip.x = 0;
+   ct.clip.y = y;
+   ct.clip.w = job->dst->cache_entry.w;
+   ct.clip.h = h;
+
+   if (job->smooth)
+     evas_common_scale_rgba_in_to_out_clip_smooth(job->src, job->dst, &ct,
+                                                  job->src_x, job->src_y,
+                                                  job->src_w, job->src_h,
+                                                  job->dst_x, job->dst_y,
+                                                  job->dst_w, job->dst_h);
+   else
+     evas_common_scale_rgba_in_to_out_clip_sample(job->src, job->dst, &ct,
+                                                  job->src_x, job->src_y,
+                                                  job->src_w, job->src_h,
+                                                  job->dst_x, job->dst_y,
+                                                  job->dst_w, job->dst_h);
+}
+
 void
 cserve2_rgba_image_scale_do(void *src_data, int src_full_w, int src_full_h,
                             void *dst_data,
@@ -39,22 +91,32 @@ cserve2_rgba_image_scale_do(void *src_data, int src_full_w, int src_full_h,
                             int alpha, int smooth)
 {
    RGBA_Image src, dst;
-   RGBA_Draw_Context ct;
+   Scale_Job job;
+   unsigned int strips;
+
+   if ((dst_w <= 0) || (dst_h <= 0)) return;
 
    _cserve2_rgba_image_set(&src, src_data, src_full_w, src_full_h, alpha);
    _cserve2_rgba_image_set(&dst, dst_data, dst_w, dst_h, alpha);
    dst.flags = RGBA_IMAGE_NOTHING;
 
-   memset(&ct, 0, sizeof(ct));
-   ct.sli.h = 1;
-   ct.render_op = _EVAS_RENDER_COPY;
+   job.src = &src;
+   job.dst = &dst;
+   job.src_x = src_x;
+   job.src_y = src_y;
+   job.src_w = src_w;
+   job.src_h = src_h;
+   job.dst_x = dst_x;
+   job.dst_y = dst_y;
+   job.dst_w = dst_w;
+   job.dst_h = dst_h;
+   job.smooth = smooth;
 
-   if (smooth)
-     evas_common_scale_rgba_in_to_out_clip_smooth(&src, &dst, &ct,
-                                                  src_x, src_y, src_w, src_h,
-                                                  dst_x, dst_y, dst_w, dst_h);
+   if ((dst_w * dst_h) < SCALE_STRIP_MIN)
+     job.rows = dst_h;
    else
-     evas_common_scale_rgba_in_to_out_clip_sample(&src, &dst, &ct,
-                                                  src_x, src_y, src_w, src_h,
-                                                  dst_x, dst_y, dst_w, dst_h);
+     job.rows = SCALE_STRIP_ROWS;
+   strips = (dst_h + job.rows - 1) / job.rows;
+
+   evas_thread_pool_run(_cserve2_rgba_image_scale_strip, &job, strips);
 }
@@ -17,10 +17,15 @@
 #include "file/evas_module.h"
 #include "Evas_Loader.h"
 
+#include "evas_thread_pool.h"
+
 static Eina_Hash *loaders = NULL;
 static Eina_List *modules = NULL;
 static Eina_Prefix *pfx = NULL;
 
+/* used by the evas code built in, the thread pool logs there */
+int _evas_log_dom_global = -1;
+
 struct ext_loader_s
 {
    unsigned int length;
@@ -630,8 +635,14 @@ int main(int c, char **v)
                           PACKAGE_DATA_DIR,
                           PACKAGE_DATA_DIR);
 
+   _evas_log_dom_global = eina_log_domain_register
+     ("evas_cserve2_slave", EINA_COLOR_BLUE);
+   if (_evas_log_dom_global < 0)
+     _evas_log_dom_global = EINA_LOG_DOMAIN_GLOBAL;
+
    loaders = eina_hash_string_superfast_new(NULL);
    evas_module_init();
+   evas_thread_pool_init();
 
    wfd = atoi(v[1]);
    rfd = atoi(v[2]);
@@ -659,6 +670,7 @@ int main(int c, char **v)
           }
      }
 
+   evas_thread_pool_shutdown();
    evas_module_shutdown();
    eina_hash_free(loaders);
 
@@ -666,6 +678,8 @@ int main(int c, char **v)
       eina_module_free(m);
 
    eina_prefix_free(pfx);
+   if (_evas_log_dom_global != EINA_LOG_DOMAIN_GLOBAL)
+     eina_log_domain_unregister(_evas_log_dom_global);
    eina_shutdown();
 
    return 0;
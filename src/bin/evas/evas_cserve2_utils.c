@@ -1,7 +1,21 @@
 #include "evas_cserve2_slave.h"
+#include "evas_thread_pool.h"
 
-Eina_Bool
-evas_cserve2_image_premul_data(unsigned int *data, unsigned int len)
+/* Large images are premultiplied in strips on the evas thread pool, which
+ * the slave starts once and keeps between images */
+#define PREMUL_STRIP_LEN (256 * 1024)
+#define PREMUL_STRIP_MIN (4 * PREMUL_STRIP_LEN)
+
+typedef struct _Premul_Job Premul_Job;
+struct _Premul_Job
+{
+   unsigned int *data;
+   unsigned int len;
+   unsigned int *nas;
+};
+
+static unsigned int
+_premul_strip_do(unsigned int *data, unsigned int len)
 {
    unsigned int *de = data + len;
    unsigned int nas = 0;
@@ -19,5 +33,44 @@ evas_cserve2_image_premul_data(unsigned int *data, unsigned int len)
           nas++;
      }
 
+   return nas;
+}
+
+static void
+_premul_strip_cb(void *data, unsigned int idx)
+{
+   Premul_Job *job = data;
+   unsigned int start = idx * PREMUL_STRIP_LEN;
+   unsigned int len = PREMUL_STRIP_LEN;
+
+   if (len > job->len - start) len = job->len - start;
+   job->nas[idx] = _premul_strip_do(job->data + start, len);
+}
+
+Eina_Bool
+evas_cserve2_image_premul_data(unsigned int *data, unsigned int len)
+{
+   Premul_Job job;
+   unsigned int i, strips, nas = 0;
+
+   if (len < PREMUL_STRIP_MIN)
+     nas = _premul_strip_do(data, len);
+   else
+     {
+        strips = (len + PREMUL_STRIP_LEN - 1) / PREMUL_STRIP_LEN;
+        job.data = data;
+        job.len = len;
+        job.nas = malloc(strips * sizeof (unsigned int));
+        if (!job.nas)
+          nas = _premul_strip_do(data, len);
+        else
+          {
+             evas_thread_pool_run(_premul_strip_cb, &job, strips);
+             for (i = 0; i < strips; i++)
+               nas += job.nas[i];
+             free(job.nas);
+          }
+     }
+
    return ((ALPHA_SPARSE_INV_FRACTION * nas) >= len);
 }
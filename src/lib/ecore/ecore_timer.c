@@ -26,6 +26,20 @@ EAPI Eo_Op ECORE_TIMER_BASE_ID = EO_NOOP;
 typedef void (*Ecore_Timer_Bt_Func)();
 #endif
 
+/* Where a timer currently lives. Scheduled timers sit in a binary min-heap
+ * ordered by expiry, timers set during the current loop iteration wait in
+ * timers_new until _ecore_timer_enable_new(), frozen ones are kept in
+ * suspended and deleted ones in timers_dead until _ecore_timer_cleanup().
+ */
+typedef enum _Ecore_Timer_Queue
+{
+   ECORE_TIMER_QUEUE_NONE = 0,
+   ECORE_TIMER_QUEUE_HEAP,
+   ECORE_TIMER_QUEUE_NEW,
+   ECORE_TIMER_QUEUE_SUSPENDED,
+   ECORE_TIMER_QUEUE_DEAD
+} Ecore_Timer_Queue;
+
 struct _Ecore_Timer_Private_Data
 {
    EINA_INLIST;
@@ -35,6 +49,8 @@ struct _Ecore_Timer_Private_Data
    double              pending;
    Ecore_Task_Cb       func;
    void               *data;
+   unsigned long long  seq;
+   unsigned int        heap_index;
 
 #ifdef WANT_ECORE_TIMER_DUMP
    Ecore_Timer_Bt_Func timer_bt[ECORE_TIMER_DEBUG_BT_NUM];
@@ -43,25 +59,33 @@ struct _Ecore_Timer_Private_Data
 
    int                 references;
    unsigned char       delete_me : 1;
-   unsigned char       just_added : 1;
    unsigned char       frozen : 1;
+   unsigned char       queue : 3;
 };
 
 typedef struct _Ecore_Timer_Private_Data Ecore_Timer_Private_Data;
 
-static void _ecore_timer_set(Ecore_Timer *timer,
-                             double        at,
-                             double        in,
-                             Ecore_Task_Cb func,
-                             void         *data);
+static Eina_Bool _ecore_timer_set(Ecore_Timer *timer,
+                                  double        at,
+                                  double        in,
+                                  Ecore_Task_Cb func,
+                                  void         *data);
+static void _ecore_timer_unlink(Ecore_Timer_Private_Data *timer);
+static void _ecore_timer_heap_insert(Ecore_Timer_Private_Data *timer);
+static void _ecore_timer_dead_add(Ecore_Timer_Private_Data *timer);
 #ifdef WANT_ECORE_TIMER_DUMP
 static int _ecore_timer_cmp(const void *d1,
                             const void *d2);
 #endif
 
-static int timers_added = 0;
 static int timers_delete_me = 0;
-static Ecore_Timer_Private_Data *timers = NULL;
+static Ecore_Timer_Private_Data **timers = NULL;
+static unsigned int timers_count = 0;
+static unsigned int timers_alloc = 0;
+static unsigned int timers_queued = 0; /* on the heap, in timers_new or suspended */
+static unsigned long long timers_seq = 0;
+static Ecore_Timer_Private_Data *timers_new = NULL;
+static Ecore_Timer_Private_Data *timers_dead = NULL;
 static Ecore_Timer_Private_Data *timer_current = NULL;
 static Ecore_Timer_Private_Data *suspended = NULL;
 static double last_check = 0.0;
@@ -190,7 +214,12 @@ _ecore_timer_add(Ecore_Timer *obj,
    timer->timer_bt_num = backtrace((void **)(timer->timer_bt),
                                    ECORE_TIMER_DEBUG_BT_NUM);
 #endif
-   _ecore_timer_set(obj, now + in, in, func, (void *)data);
+   if (!_ecore_timer_set(obj, now + in, in, func, (void *)data))
+     {
+        eo_error_set(obj);
+        ERR("could not make room for the timer in the heap");
+        return EINA_FALSE;
+     }
    return EINA_TRUE;
 }
 
@@ -473,8 +502,10 @@ _timer_freeze(Eo *obj EINA_UNUSED, void *_pd, va_list *list EINA_UNUSED)
    if (timer->frozen)
      goto unlock;
 
-   timers = (Ecore_Timer_Private_Data *)eina_inlist_remove(EINA_INLIST_GET(timers), EINA_INLIST_GET(timer));
+   _ecore_timer_unlink(timer);
    suspended = (Ecore_Timer_Private_Data *)eina_inlist_prepend(EINA_INLIST_GET(suspended), EINA_INLIST_GET(timer));
+   timer->queue = ECORE_TIMER_QUEUE_SUSPENDED;
+   timers_queued++;
 
    now = ecore_time_get();
 
@@ -539,7 +570,7 @@ _timer_thaw(Eo *obj, void *_pd, va_list *list EINA_UNUSED)
    if (!timer->frozen)
      goto unlock;
 
-   suspended = (Ecore_Timer_Private_Data *)eina_inlist_remove(EINA_INLIST_GET(suspended), EINA_INLIST_GET(timer));
+   _ecore_timer_unlink(timer);
    now = ecore_time_get();
 
    _ecore_timer_set(obj, timer->pending + now, timer->in, timer->func, timer->data);
@@ -555,6 +586,7 @@ ecore_timer_dump(void)
    char *out;
    Ecore_Timer_Private_Data *tm;
    Eina_List *tmp = NULL;
+   unsigned int i;
    int living_timer = 0;
    int unknow_timer = 0;
 
@@ -562,7 +594,9 @@ ecore_timer_dump(void)
    _ecore_lock();
    result = eina_strbuf_new();
 
-   EINA_INLIST_FOREACH(timers, tm)
+   for (i = 0; i < timers_count; i++)
+     tmp = eina_list_sorted_insert(tmp, _ecore_timer_cmp, timers[i]);
+   EINA_INLIST_FOREACH(timers_new, tm)
      tmp = eina_list_sorted_insert(tmp, _ecore_timer_cmp, tm);
 
    EINA_LIST_FREE(tmp, tm)
@@ -631,12 +665,28 @@ _ecore_timer_delay(Ecore_Timer *obj,
      }
    else
      {
-        timers = (Ecore_Timer_Private_Data *)eina_inlist_remove(EINA_INLIST_GET(timers), EINA_INLIST_GET(timer));
+        _ecore_timer_unlink(timer);
         eo_data_unref(obj, timer);
         _ecore_timer_set(obj, timer->at + add, timer->in, timer->func, timer->data);
      }
 }
 
+static void
+_ecore_timer_free(Ecore_Timer_Private_Data *timer)
+{
+   /* keep the destructor from queueing it on timers_dead again */
+   timer->delete_me = 1;
+
+   /* a timer that never got set, see _ecore_timer_set(), holds no
+    * reference */
+   if (timer->func) eo_data_unref(timer->obj, timer);
+   eo_do(timer->obj, eo_parent_set(NULL));
+   if (eo_destructed_is(timer->obj))
+     eo_manual_free(timer->obj);
+   else
+     eo_manual_free_set(timer->obj, EINA_FALSE);
+}
+
 void *
 _ecore_timer_del(Ecore_Timer *obj)
 {
@@ -646,24 +696,16 @@ _ecore_timer_del(Ecore_Timer *obj)
      {
         void *data = timer->data;
 
-        eo_data_unref(obj, timer);
-        suspended = (Ecore_Timer_Private_Data *)eina_inlist_remove(EINA_INLIST_GET(suspended), EINA_INLIST_GET(timer));
-
         if (timer->delete_me)
           timers_delete_me--;
 
-        eo_do(obj, eo_parent_set(NULL));
-
-        if (eo_destructed_is(obj))
-          eo_manual_free(obj);
-        else
-          eo_manual_free_set(obj, EINA_FALSE);
+        _ecore_timer_unlink(timer);
+        _ecore_timer_free(timer);
         return data;
      }
 
    EINA_SAFETY_ON_TRUE_RETURN_VAL(timer->delete_me, NULL);
-   timer->delete_me = 1;
-   timers_delete_me++;
+   _ecore_timer_dead_add(timer);
    return timer->data;
 }
 
@@ -673,10 +715,7 @@ _destructor(Eo *obj, void *_pd, va_list *list EINA_UNUSED)
    Ecore_Timer_Private_Data *pd = _pd;
 
    if (!pd->delete_me)
-   {
-     pd->delete_me = 1;
-     timers_delete_me++;
-   }
+     _ecore_timer_dead_add(pd);
 
    eo_do_super(obj, MY_CLASS, eo_destructor());
 }
@@ -686,30 +725,36 @@ _ecore_timer_shutdown(void)
 {
    Ecore_Timer_Private_Data *timer;
 
-   while ((timer = timers))
+   while (timers_count)
      {
-        timers = (Ecore_Timer_Private_Data *)eina_inlist_remove(EINA_INLIST_GET(timers), EINA_INLIST_GET(timers));
+        timer = timers[0];
+        _ecore_timer_unlink(timer);
+        _ecore_timer_free(timer);
+     }
 
-        eo_data_unref(timer->obj, timer);
-        eo_do(timer->obj, eo_parent_set(NULL));
-        if (eo_destructed_is(timer->obj))
-          eo_manual_free(timer->obj);
-        else
-          eo_manual_free_set(timer->obj, EINA_FALSE);
+   while ((timer = timers_new))
+     {
+        _ecore_timer_unlink(timer);
+        _ecore_timer_free(timer);
      }
 
    while ((timer = suspended))
      {
-        suspended = (Ecore_Timer_Private_Data *)eina_inlist_remove(EINA_INLIST_GET(suspended), EINA_INLIST_GET(suspended));
+        _ecore_timer_unlink(timer);
+        _ecore_timer_free(timer);
+     }
 
-        eo_data_unref(timer->obj, timer);
-        eo_do(timer->obj, eo_parent_set(NULL));
-        if (eo_destructed_is(timer->obj))
-          eo_manual_free(timer->obj);
-        else
-          eo_manual_free_set(timer->obj, EINA_FALSE);
+   while ((timer = timers_dead))
+     {
+        _ecore_timer_unlink(timer);
+        _ecore_timer_free(timer);
      }
 
+   free(timers);
+   timers = NULL;
+   timers_alloc = 0;
+   timers_queued = 0;
+   timers_delete_me = 0;
    timer_current = NULL;
 }
 
@@ -720,55 +765,21 @@ _ecore_timer_cleanup(void)
    int in_use = 0, todo = timers_delete_me, done = 0;
 
    if (!timers_delete_me) return;
-   for (l = timers; l; )
-     {
-        Ecore_Timer_Private_Data *timer = l;
-
-        l = (Ecore_Timer_Private_Data *)EINA_INLIST_GET(l)->next;
-        if (timer->delete_me)
-          {
-             if (timer->references)
-               {
-                  in_use++;
-                  continue;
-               }
-             timers = (Ecore_Timer_Private_Data *)eina_inlist_remove(EINA_INLIST_GET(timers), EINA_INLIST_GET(timer));
-
-             eo_data_unref(timer->obj, timer);
-             eo_do(timer->obj, eo_parent_set(NULL));
-             if (eo_destructed_is(timer->obj))
-               eo_manual_free(timer->obj);
-             else
-               eo_manual_free_set(timer->obj, EINA_FALSE);
-             timers_delete_me--;
-             done++;
-             if (timers_delete_me == 0) return;
-          }
-     }
-   for (l = suspended; l; )
+   for (l = timers_dead; l; )
      {
         Ecore_Timer_Private_Data *timer = l;
 
         l = (Ecore_Timer_Private_Data *)EINA_INLIST_GET(l)->next;
-        if (timer->delete_me)
+        if (timer->references)
           {
-             if (timer->references)
-               {
-                  in_use++;
-                  continue;
-               }
-             suspended = (Ecore_Timer_Private_Data *)eina_inlist_remove(EINA_INLIST_GET(suspended), EINA_INLIST_GET(timer));
-
-             eo_data_unref(timer->obj, timer);
-             eo_do(timer->obj, eo_parent_set(NULL));
-             if (eo_destructed_is(timer->obj))
-                eo_manual_free(timer->obj);
-             else
-                eo_manual_free_set(timer->obj, EINA_FALSE);
-             timers_delete_me--;
-             done++;
-             if (timers_delete_me == 0) return;
+             in_use++;
+             continue;
           }
+        _ecore_timer_unlink(timer);
+        _ecore_timer_free(timer);
+        timers_delete_me--;
+        done++;
+        if (timers_delete_me == 0) return;
      }
 
    if ((!in_use) && (timers_delete_me))
@@ -786,56 +797,44 @@ _ecore_timer_enable_new(void)
 {
    Ecore_Timer_Private_Data *timer;
 
-   if (!timers_added) return;
-   timers_added = 0;
-   EINA_INLIST_FOREACH(timers, timer) timer->just_added = 0;
+   while ((timer = timers_new))
+     {
+        _ecore_timer_unlink(timer);
+        _ecore_timer_heap_insert(timer);
+     }
 }
 
 int
 _ecore_timers_exists(void)
 {
-   Ecore_Timer_Private_Data *timer = timers;
-
-   while ((timer) && (timer->delete_me))
-     timer = (Ecore_Timer_Private_Data *)EINA_INLIST_GET(timer)->next;
-
-   return !!timer;
+   /* deleted timers are moved to timers_dead right away */
+   return (timers_count > 0) || (timers_new != NULL);
 }
 
 static inline Ecore_Timer *
 _ecore_timer_first_get(void)
 {
-   Ecore_Timer *ret = NULL;
-   Ecore_Timer_Private_Data *timer = timers;
-
-   while ((timer) && ((timer->delete_me) || (timer->just_added)))
-     timer = (Ecore_Timer_Private_Data *)EINA_INLIST_GET(timer)->next;
-
-   if (timer)
-     ret = timer->obj;
-   return ret;
+   if (!timers_count) return NULL;
+   return timers[0]->obj;
 }
 
-static inline Ecore_Timer *
-_ecore_timer_after_get(Ecore_Timer *obj)
+/* Latest expiry below maxtime in the subtree rooted at idx. Children never
+ * expire before their parent, so only the timers inside the precision window
+ * are visited. */
+static double
+_ecore_timer_heap_window_get(unsigned int idx,
+                             double       maxtime,
+                             double       latest)
 {
-   Ecore_Timer *ret = NULL;
-   Ecore_Timer_Private_Data *base = eo_data_scope_get(obj, MY_CLASS);
-
-   Ecore_Timer_Private_Data *timer = (Ecore_Timer_Private_Data *)EINA_INLIST_GET(base)->next;
-   Ecore_Timer_Private_Data *valid_timer = NULL;
-   double maxtime = base->at + precision;
+   Ecore_Timer_Private_Data *timer;
 
-   while ((timer) && (timer->at < maxtime))
-     {
-        if (!((timer->delete_me) || (timer->just_added)))
-          valid_timer = timer;
-        timer = (Ecore_Timer_Private_Data *)EINA_INLIST_GET(timer)->next;
-     }
+   if (idx >= timers_count) return latest;
+   timer = timers[idx];
+   if (timer->at >= maxtime) return latest;
+   if (timer->at > latest) latest = timer->at;
 
-   if (valid_timer)
-     ret = valid_timer->obj;
-   return ret;
+   latest = _ecore_timer_heap_window_get(2 * idx + 1, maxtime, latest);
+   return _ecore_timer_heap_window_get(2 * idx + 2, maxtime, latest);
 }
 
 double
@@ -843,19 +842,21 @@ _ecore_timer_next_get(void)
 {
    double now;
    double in;
-   Ecore_Timer *first_obj, *second_obj;
+   double at;
+   Ecore_Timer *first_obj;
    Ecore_Timer_Private_Data *first;
 
    first_obj = _ecore_timer_first_get();
    if (!first_obj) return -1;
 
-   second_obj = _ecore_timer_after_get(first_obj);
-   if (second_obj) first_obj = second_obj;
-
    first = eo_data_scope_get(first_obj, MY_CLASS);
 
+   /* wake up once for every timer expiring within precision of the first */
+   at = _ecore_timer_heap_window_get(1, first->at + precision, first->at);
+   at = _ecore_timer_heap_window_get(2, first->at + precision, at);
+
    now = ecore_loop_time_get();
-   in = first->at - now;
+   in = at - now;
    if (in < 0) in = 0;
    return in;
 }
@@ -867,7 +868,7 @@ _ecore_timer_reschedule(Ecore_Timer *obj,
    Ecore_Timer_Private_Data *timer = eo_data_scope_get(obj, MY_CLASS);
    if ((timer->delete_me) || (timer->frozen)) return;
 
-   timers = (Ecore_Timer_Private_Data *)eina_inlist_remove(EINA_INLIST_GET(timers), EINA_INLIST_GET(timer));
+   _ecore_timer_unlink(timer);
    eo_data_unref(obj, timer);
 
    /* if the timer would have gone off more than 15 seconds ago,
@@ -897,43 +898,35 @@ _ecore_timer_expired_timers_call(double when)
 int
 _ecore_timer_expired_call(double when)
 {
-   if (!timers) return 0;
    if (last_check > when)
      {
         Ecore_Timer_Private_Data *timer;
-        /* User set time backwards */
-        EINA_INLIST_FOREACH(timers, timer) timer->at -= (last_check - when);
+        unsigned int i;
+
+        /* User set time backwards, shifting every timer keeps the heap valid */
+        for (i = 0; i < timers_count; i++)
+          timers[i]->at -= (last_check - when);
+        EINA_INLIST_FOREACH(timers_new, timer) timer->at -= (last_check - when);
      }
    last_check = when;
 
-   if (!timer_current)
-     {
-        /* regular main loop, start from head */
-        timer_current = timers;
-     }
-   else
+   if (timer_current)
      {
-        /* recursive main loop, continue from where we were */
+        /* recursive main loop, the timer being called is off the heap */
         Ecore_Timer_Private_Data *timer_old = timer_current;
-        timer_current = (Ecore_Timer_Private_Data *)EINA_INLIST_GET(timer_current)->next;
+        timer_current = NULL;
         _ecore_timer_reschedule(timer_old->obj, when);
      }
 
-   while (timer_current)
+   while (timers_count)
      {
-        Ecore_Timer_Private_Data *timer = timer_current;
+        Ecore_Timer_Private_Data *timer = timers[0];
 
         if (timer->at > when)
-          {
-             timer_current = NULL; /* ended walk, next should restart. */
-             return 0;
-          }
+          return 0;
 
-        if ((timer->just_added) || (timer->delete_me))
-          {
-             timer_current = (Ecore_Timer_Private_Data *)EINA_INLIST_GET(timer_current)->next;
-             continue;
-          }
+        _ecore_timer_unlink(timer);
+        timer_current = timer;
 
         timer->references++;
         if (!_ecore_call_task_cb(timer->func, timer->data))
@@ -942,45 +935,187 @@ _ecore_timer_expired_call(double when)
           }
         timer->references--;
 
-        if (timer_current) /* may have changed in recursive main loops */
-          timer_current = (Ecore_Timer_Private_Data *)EINA_INLIST_GET(timer_current)->next;
-
+        timer_current = NULL;
         _ecore_timer_reschedule(timer->obj, when);
      }
    return 0;
 }
 
+static inline Eina_Bool
+_ecore_timer_before(const Ecore_Timer_Private_Data *t1,
+                    const Ecore_Timer_Private_Data *t2)
+{
+   if (t1->at < t2->at) return EINA_TRUE;
+   if (t1->at > t2->at) return EINA_FALSE;
+   /* on a tie the most recently set timer goes first */
+   return t1->seq > t2->seq;
+}
+
+static inline void
+_ecore_timer_heap_store(Ecore_Timer_Private_Data *timer,
+                        unsigned int              idx)
+{
+   timers[idx] = timer;
+   timer->heap_index = idx;
+}
+
+static void
+_ecore_timer_heap_up(unsigned int idx)
+{
+   Ecore_Timer_Private_Data *timer = timers[idx];
+
+   while (idx > 0)
+     {
+        unsigned int parent = (idx - 1) / 2;
+
+        if (!_ecore_timer_before(timer, timers[parent])) break;
+        _ecore_timer_heap_store(timers[parent], idx);
+        idx = parent;
+     }
+   _ecore_timer_heap_store(timer, idx);
+}
+
+static void
+_ecore_timer_heap_down(unsigned int idx)
+{
+   Ecore_Timer_Private_Data *timer = timers[idx];
+
+   for (;;)
+     {
+        unsigned int child = 2 * idx + 1;
+
+        if (child >= timers_count) break;
+        if ((child + 1 < timers_count) &&
+            (_ecore_timer_before(timers[child + 1], timers[child])))
+          child++;
+        if (!_ecore_timer_before(timers[child], timer)) break;
+        _ecore_timer_heap_store(timers[child], idx);
+        idx = child;
+     }
+   _ecore_timer_heap_store(timer, idx);
+}
+
+/* every queued timer may end up on the heap, so room for all of them is
+ * made when one is queued, where failing can still be reported */
+static Eina_Bool
+_ecore_timer_heap_reserve(unsigned int count)
+{
+   Ecore_Timer_Private_Data **tmp;
+   unsigned int alloc;
+
+   if (count <= timers_alloc) return EINA_TRUE;
+   alloc = timers_alloc ? timers_alloc : 64;
+   while (alloc < count) alloc *= 2;
+
+   tmp = realloc(timers, alloc * sizeof (Ecore_Timer_Private_Data *));
+   if (!tmp)
+     {
+        ERR("Could not grow the timer heap to %u entries", alloc);
+        return EINA_FALSE;
+     }
+   timers = tmp;
+   timers_alloc = alloc;
+   return EINA_TRUE;
+}
+
+static void
+_ecore_timer_heap_insert(Ecore_Timer_Private_Data *timer)
+{
+   /* _ecore_timer_set() reserved the room for it */
+   timer->queue = ECORE_TIMER_QUEUE_HEAP;
+   timers_queued++;
+   _ecore_timer_heap_store(timer, timers_count++);
+   _ecore_timer_heap_up(timer->heap_index);
+}
+
+static void
+_ecore_timer_heap_remove(Ecore_Timer_Private_Data *timer)
+{
+   unsigned int idx = timer->heap_index;
+
+   timers_count--;
+   if (idx != timers_count)
+     {
+        _ecore_timer_heap_store(timers[timers_count], idx);
+        if ((idx > 0) && _ecore_timer_before(timers[idx], timers[(idx - 1) / 2]))
+          _ecore_timer_heap_up(idx);
+        else
+          _ecore_timer_heap_down(idx);
+     }
+   timers[timers_count] = NULL;
+}
+
+static void
+_ecore_timer_unlink(Ecore_Timer_Private_Data *timer)
+{
+   switch (timer->queue)
+     {
+      case ECORE_TIMER_QUEUE_HEAP:
+        _ecore_timer_heap_remove(timer);
+        timers_queued--;
+        break;
+      case ECORE_TIMER_QUEUE_NEW:
+        timers_new = (Ecore_Timer_Private_Data *)eina_inlist_remove(EINA_INLIST_GET(timers_new), EINA_INLIST_GET(timer));
+        timers_queued--;
+        break;
+      case ECORE_TIMER_QUEUE_SUSPENDED:
+        suspended = (Ecore_Timer_Private_Data *)eina_inlist_remove(EINA_INLIST_GET(suspended), EINA_INLIST_GET(timer));
+        timers_queued--;
+        break;
+      case ECORE_TIMER_QUEUE_DEAD:
+        timers_dead = (Ecore_Timer_Private_Data *)eina_inlist_remove(EINA_INLIST_GET(timers_dead), EINA_INLIST_GET(timer));
+        break;
+      default:
+        break;
+     }
+   timer->queue = ECORE_TIMER_QUEUE_NONE;
+}
+
 static void
+_ecore_timer_dead_add(Ecore_Timer_Private_Data *timer)
+{
+   timer->delete_me = 1;
+   timers_delete_me++;
+
+   _ecore_timer_unlink(timer);
+   timers_dead = (Ecore_Timer_Private_Data *)eina_inlist_append(EINA_INLIST_GET(timers_dead), EINA_INLIST_GET(timer));
+   timer->queue = ECORE_TIMER_QUEUE_DEAD;
+}
+
+static Eina_Bool
 _ecore_timer_set(Ecore_Timer  *obj,
                  double        at,
                  double        in,
                  Ecore_Task_Cb func,
                  void         *data)
 {
-   Ecore_Timer_Private_Data *t2;
+   Ecore_Timer_Private_Data *timer = eo_data_scope_get(obj, MY_CLASS);
 
-   Ecore_Timer_Private_Data *timer = eo_data_ref(obj, MY_CLASS);
+   /* make the room before touching the timer, so that failing leaves it
+    * as it was: not queued, without a reference and with no func. A
+    * timer that is already queued has its room. */
+   if ((!timer->delete_me) && (timer->queue == ECORE_TIMER_QUEUE_NONE) &&
+       (!_ecore_timer_heap_reserve(timers_queued + 1)))
+     return EINA_FALSE;
 
-   timers_added = 1;
+   eo_data_ref(obj, MY_CLASS);
    timer->at = at;
    timer->in = in;
    timer->func = func;
    timer->data = data;
-   timer->just_added = 1;
+   timer->seq = ++timers_seq;
    timer->frozen = 0;
    timer->pending = 0.0;
-   if (timers)
-     {
-        EINA_INLIST_REVERSE_FOREACH(EINA_INLIST_GET(timers), t2)
-          {
-             if (timer->at > t2->at)
-               {
-                  timers = (Ecore_Timer_Private_Data *)eina_inlist_append_relative(EINA_INLIST_GET(timers), EINA_INLIST_GET(timer), EINA_INLIST_GET(t2));
-                  return;
-               }
-          }
-     }
-   timers = (Ecore_Timer_Private_Data *)eina_inlist_prepend(EINA_INLIST_GET(timers), EINA_INLIST_GET(timer));
+
+   /* deleted timers stay on timers_dead until cleanup */
+   if (timer->delete_me) return EINA_TRUE;
+
+   /* timers only become due after _ecore_timer_enable_new() */
+   _ecore_timer_unlink(timer);
+   timers_new = (Ecore_Timer_Private_Data *)eina_inlist_append(EINA_INLIST_GET(timers_new), EINA_INLIST_GET(timer));
+   timer->queue = ECORE_TIMER_QUEUE_NEW;
+   timers_queued++;
+   return EINA_TRUE;
 }
 
 #ifdef WANT_ECORE_TIMER_DUMP
@@ -614,6 +614,15 @@ typedef void (*Ecore_Con_Dns_Cb)(const char *canonname,
                                  int addrlen,
                                  void *data);
 
+/**
+ * @typedef Ecore_Con_Send_Free_Cb
+ * A callback type for use with ecore_con_server_send_segment() and
+ * ecore_con_client_send_segment(), called with the segment once it has been
+ * written out or dropped.
+ * @since 1.10
+ */
+typedef void (*Ecore_Con_Send_Free_Cb)(void *data, const void *segment);
+
 /**
  * @typedef Ecore_Con_Type
  * @enum _Ecore_Con_Type
@@ -992,6 +1001,34 @@ EAPI double            ecore_con_server_uptime_get(Ecore_Con_Server *svr);
 EAPI int               ecore_con_server_send(Ecore_Con_Server *svr,
                                              const void *data,
                                              int size);
+/**
+ * Queues the given data to be sent to the given server without copying it.
+ *
+ * @param   svr     The given server.
+ * @param   data    The given data.
+ * @param   size    Length of the data, in bytes, to send.
+ * @param   free_cb Function called once the data is not needed anymore.
+ * @param   cb_data User data passed to @p free_cb.
+ * @return  The number of bytes queued. @c 0 will be returned if there is an
+ *          error, in which case @p free_cb is not called.
+ *
+ * This works like ecore_con_server_send(), except that @p data is not copied
+ * and must stay valid and unchanged until @p free_cb is called. That happens
+ * once all of it has been handed to the kernel, or when the connection goes
+ * away before that. Consecutive segments are written together with a single
+ * scatter-gather system call where possible, so a header sent with
+ * ecore_con_server_send() and a large body sent as a segment reach the socket
+ * without the body being copied.
+ *
+ * @see ecore_con_server_send()
+ * @see ecore_con_client_send_segment()
+ * @since 1.10
+ */
+EAPI int               ecore_con_server_send_segment(Ecore_Con_Server *svr,
+                                                     const void *data,
+                                                     int size,
+                                                     Ecore_Con_Send_Free_Cb free_cb,
+                                                     const void *cb_data);
 /**
  * Sets a limit on the number of clients that can be handled concurrently
  * by the given server, and a policy on what to do if excess clients try to
@@ -1073,6 +1110,40 @@ EAPI void              ecore_con_server_timeout_set(Ecore_Con_Server *svr, doubl
  */
 EAPI double            ecore_con_server_timeout_get(Ecore_Con_Server *svr);
 
+/**
+ * Set whether received data is handed out from pooled buffers
+ *
+ * @param svr The server object
+ * @param pool @c EINA_TRUE to use pooled receive buffers
+ *
+ * By default the data of every #ECORE_CON_EVENT_SERVER_DATA and
+ * #ECORE_CON_EVENT_CLIENT_DATA event is a copy that belongs to the event.
+ * With pooled buffers the socket is read straight into reference counted
+ * buffers that several consecutive data events share, which saves an
+ * allocation and a copy per read.
+ *
+ * When set on a server created with ecore_con_server_add() this applies to
+ * the data of all its clients.
+ *
+ * @warning With pooled buffers the event data is only valid until the event
+ * is freed, it must be copied to be kept and it must not be taken out of the
+ * event.
+ *
+ * @see ecore_con_server_recv_pool_get()
+ * @since 1.10
+ */
+EAPI void              ecore_con_server_recv_pool_set(Ecore_Con_Server *svr, Eina_Bool pool);
+/**
+ * Get whether received data is handed out from pooled buffers
+ *
+ * @param svr The server object
+ * @return @c EINA_TRUE if pooled receive buffers are used
+ *
+ * @see ecore_con_server_recv_pool_set()
+ * @since 1.10
+ */
+EAPI Eina_Bool         ecore_con_server_recv_pool_get(Ecore_Con_Server *svr);
+
 /**
  * Get the fd that the server is connected to
  *
@@ -1142,6 +1213,28 @@ EAPI int               ecore_con_client_fd_get(Ecore_Con_Client *cl);
 EAPI int               ecore_con_client_send(Ecore_Con_Client *cl,
                                              const void *data,
                                              int size);
+/**
+ * Queues the given data to be sent to the given client without copying it.
+ *
+ * @param   cl      The given client.
+ * @param   data    The given data.
+ * @param   size    Length of the data, in bytes, to send.
+ * @param   free_cb Function called once the data is not needed anymore.
+ * @param   cb_data User data passed to @p free_cb.
+ * @return  The number of bytes queued. @c 0 will be returned if there is an
+ *          error, in which case @p free_cb is not called.
+ *
+ * This is the client side counterpart of ecore_con_server_send_segment().
+ *
+ * @see ecore_con_client_send()
+ * @see ecore_con_server_send_segment()
+ * @since 1.10
+ */
+EAPI int               ecore_con_client_send_segment(Ecore_Con_Client *cl,
+                                                     const void *data,
+                                                     int size,
+                                                     Ecore_Con_Send_Free_Cb free_cb,
+                                                     const void *cb_data);
 /**
  * Retrieves the server representing the socket the client has
  * connected to.
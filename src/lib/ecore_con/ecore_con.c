@@ -30,6 +30,10 @@
 #include <sys/un.h>
 #endif
 
+#ifdef HAVE_SYS_UIO_H
+# include <sys/uio.h>
+#endif
+
 #ifdef HAVE_SYSTEMD
 # include <systemd/sd-daemon.h>
 #endif
@@ -93,6 +97,10 @@ static void        _ecore_con_event_server_del_free(void *data,
                                                     void *ev);
 static void        _ecore_con_event_server_data_free(void *data,
                                                      void *ev);
+static void        _ecore_con_event_client_data_pool_free(Ecore_Con_Server *svr,
+                                                          void *ev);
+static void        _ecore_con_event_server_data_pool_free(void *data,
+                                                          void *ev);
 static void        _ecore_con_event_server_error_free(void *data,
                                                       Ecore_Con_Event_Server_Error *e);
 static void        _ecore_con_event_client_error_free(Ecore_Con_Server *svr,
@@ -120,7 +128,7 @@ _ecore_con_client_kill(Ecore_Con_Client *cl)
    else
      {
         ecore_con_event_client_del(cl);
-        if (cl->buf) return;
+        if (cl->buf || cl->send_queue) return;
      }
    INF("Lost client %s", (cl->ip) ? cl->ip : "");
    if (cl->fd_handler)
@@ -172,6 +180,283 @@ int _ecore_con_log_dom = -1;
 Ecore_Con_Socks *_ecore_con_proxy_once = NULL;
 Ecore_Con_Socks *_ecore_con_proxy_global = NULL;
 
+/* Pooled receive buffers: reads land directly in a buffer and each data
+ * event gets the slice it was read into. A slice is preceded by a pointer to
+ * its buffer so the event can drop its reference when freed, and the buffer
+ * goes back to the pool once the connection moved on to another buffer and
+ * all the events using it are gone. */
+#define RBUF_SLICE_HEAD sizeof(Ecore_Con_Rbuf *)
+#define RBUF_SLICE_MIN 4096
+#define RBUF_POOL_MAX 8
+
+struct _Ecore_Con_Rbuf
+{
+   int references;
+   unsigned int used;
+   unsigned char data[READBUFSIZ];
+};
+
+static Eina_Trash *_ecore_con_rbuf_pool = NULL;
+static int _ecore_con_rbuf_pool_count = 0;
+
+static void
+_ecore_con_rbuf_unref(Ecore_Con_Rbuf *rbuf)
+{
+   if (--rbuf->references > 0) return;
+
+   if ((_ecore_con_init_count) && (_ecore_con_rbuf_pool_count < RBUF_POOL_MAX))
+     {
+        eina_trash_push(&_ecore_con_rbuf_pool, rbuf);
+        _ecore_con_rbuf_pool_count++;
+     }
+   else
+     free(rbuf);
+}
+
+static void
+_ecore_con_rbuf_pool_shutdown(void)
+{
+   Ecore_Con_Rbuf *rbuf;
+
+   EINA_TRASH_CLEAN(&_ecore_con_rbuf_pool, rbuf)
+     free(rbuf);
+   _ecore_con_rbuf_pool_count = 0;
+}
+
+/* Returns where to read next in the current buffer of a connection, taking
+ * a new one when there is not enough room left. */
+static unsigned char *
+_ecore_con_rbuf_reserve(Ecore_Con_Rbuf **current, size_t *size)
+{
+   Ecore_Con_Rbuf *rbuf = *current;
+
+   if ((!rbuf) ||
+       (rbuf->used + RBUF_SLICE_HEAD + RBUF_SLICE_MIN > sizeof(rbuf->data)))
+     {
+        if (rbuf) _ecore_con_rbuf_unref(rbuf);
+
+        rbuf = eina_trash_pop(&_ecore_con_rbuf_pool);
+        if (rbuf)
+          _ecore_con_rbuf_pool_count--;
+        else
+          {
+             rbuf = malloc(sizeof (Ecore_Con_Rbuf));
+             if (!rbuf)
+               {
+                  *current = NULL;
+                  return NULL;
+               }
+          }
+        /* the connection holds one reference while it fills the buffer */
+        rbuf->references = 1;
+        rbuf->used = 0;
+        *current = rbuf;
+     }
+
+   *size = sizeof(rbuf->data) - rbuf->used - RBUF_SLICE_HEAD;
+   return rbuf->data + rbuf->used + RBUF_SLICE_HEAD;
+}
+
+/* Hands num bytes read at buf over to a data event. */
+static unsigned char *
+_ecore_con_rbuf_commit(Ecore_Con_Rbuf *rbuf, unsigned char *buf, int num)
+{
+   memcpy(buf - RBUF_SLICE_HEAD, &rbuf, sizeof (Ecore_Con_Rbuf *));
+   rbuf->used += RBUF_SLICE_HEAD + num;
+   /* keep the slice heads aligned */
+   rbuf->used = (rbuf->used + RBUF_SLICE_HEAD - 1) & ~(RBUF_SLICE_HEAD - 1);
+   rbuf->references++;
+
+   return buf;
+}
+
+static void
+_ecore_con_rbuf_release(void *data)
+{
+   Ecore_Con_Rbuf *rbuf;
+
+   memcpy(&rbuf, (unsigned char *)data - RBUF_SLICE_HEAD, sizeof (Ecore_Con_Rbuf *));
+   _ecore_con_rbuf_unref(rbuf);
+}
+
+/* Send queue: data handed over with ecore_con_*_send_segment() is queued
+ * behind the connection's binbuf without being copied. Anything sent after
+ * a segment has to go behind it too, so ecore_con_*_send() then appends to a
+ * segment holding its own copy. Plain sockets write the binbuf and the queue
+ * with a single writev(). */
+#define SEND_IOV_MAX 64
+
+struct _Ecore_Con_Send_Segment
+{
+   EINA_INLIST;
+   const unsigned char *data;
+   Eina_Binbuf *copy;
+   size_t size;
+   size_t offset;
+   Ecore_Con_Send_Free_Cb free_cb;
+   const void *cb_data;
+};
+
+static const unsigned char *
+_ecore_con_send_segment_data(const Ecore_Con_Send_Segment *seg)
+{
+   if (seg->copy) return eina_binbuf_string_get(seg->copy);
+   return seg->data;
+}
+
+static void
+_ecore_con_send_segment_free(Ecore_Con_Send_Segment *seg)
+{
+   if (seg->copy)
+     eina_binbuf_free(seg->copy);
+   else if (seg->free_cb)
+     seg->free_cb((void *)seg->cb_data, seg->data);
+   free(seg);
+}
+
+static Eina_Bool
+_ecore_con_send_queue_add(Eina_Inlist **queue, const void *data, size_t size,
+                          Ecore_Con_Send_Free_Cb free_cb, const void *cb_data)
+{
+   Ecore_Con_Send_Segment *seg;
+
+   seg = calloc(1, sizeof (Ecore_Con_Send_Segment));
+   if (!seg) return EINA_FALSE;
+
+   seg->data = data;
+   seg->size = size;
+   seg->free_cb = free_cb;
+   seg->cb_data = cb_data;
+   *queue = eina_inlist_append(*queue, EINA_INLIST_GET(seg));
+
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_ecore_con_send_queue_copy(Eina_Inlist **queue, const void *data, size_t size)
+{
+   Ecore_Con_Send_Segment *seg = NULL;
+
+   if (*queue)
+     seg = EINA_INLIST_CONTAINER_GET((*queue)->last, Ecore_Con_Send_Segment);
+
+   if ((!seg) || (!seg->copy))
+     {
+        seg = calloc(1, sizeof (Ecore_Con_Send_Segment));
+        if (!seg) return EINA_FALSE;
+        seg->copy = eina_binbuf_new();
+        if (!seg->copy)
+          {
+             free(seg);
+             return EINA_FALSE;
+          }
+        *queue = eina_inlist_append(*queue, EINA_INLIST_GET(seg));
+     }
+
+   if (!eina_binbuf_append_length(seg->copy, data, size))
+     {
+        /* don't leave an empty segment behind */
+        if (!seg->size)
+          {
+             *queue = eina_inlist_remove(*queue, EINA_INLIST_GET(seg));
+             _ecore_con_send_segment_free(seg);
+          }
+        return EINA_FALSE;
+     }
+   seg->size += size;
+
+   return EINA_TRUE;
+}
+
+/* Drops count written bytes from the head of the queue. */
+static void
+_ecore_con_send_queue_consume(Eina_Inlist **queue, size_t count)
+{
+   while ((*queue) && (count > 0))
+     {
+        Ecore_Con_Send_Segment *seg;
+        size_t left;
+
+        seg = EINA_INLIST_CONTAINER_GET(*queue, Ecore_Con_Send_Segment);
+        left = seg->size - seg->offset;
+        if (count < left)
+          {
+             seg->offset += count;
+             return;
+          }
+        count -= left;
+        *queue = eina_inlist_remove(*queue, *queue);
+        _ecore_con_send_segment_free(seg);
+     }
+}
+
+static void
+_ecore_con_send_queue_clear(Eina_Inlist **queue)
+{
+   while (*queue)
+     {
+        Ecore_Con_Send_Segment *seg;
+
+        seg = EINA_INLIST_CONTAINER_GET(*queue, Ecore_Con_Send_Segment);
+        *queue = eina_inlist_remove(*queue, *queue);
+        _ecore_con_send_segment_free(seg);
+     }
+}
+
+/* Writes head (if any) followed by the queued segments. */
+static int
+_ecore_con_send_queue_write(int fd, const unsigned char *head, size_t head_len,
+                            Eina_Inlist *queue)
+{
+#ifdef HAVE_SYS_UIO_H
+   struct iovec iov[SEND_IOV_MAX];
+   Ecore_Con_Send_Segment *seg;
+   int n = 0;
+
+   if (head_len > 0)
+     {
+        iov[n].iov_base = (void *)head;
+        iov[n].iov_len = head_len;
+        n++;
+     }
+   EINA_INLIST_FOREACH(queue, seg)
+     {
+        if (n == SEND_IOV_MAX) break;
+        iov[n].iov_base = (void *)(_ecore_con_send_segment_data(seg) + seg->offset);
+        iov[n].iov_len = seg->size - seg->offset;
+        n++;
+     }
+
+   return writev(fd, iov, n);
+#else
+   Ecore_Con_Send_Segment *seg;
+
+   if (head_len > 0)
+     return write(fd, head, head_len);
+
+   seg = EINA_INLIST_CONTAINER_GET(queue, Ecore_Con_Send_Segment);
+   return write(fd, _ecore_con_send_segment_data(seg) + seg->offset,
+                seg->size - seg->offset);
+#endif
+}
+
+static void
+_ecore_con_cork_set(int fd, Ecore_Con_Type type, int state)
+{
+#ifdef TCP_CORK
+   if ((fd >= 0) && ((type & ECORE_CON_TYPE) == ECORE_CON_REMOTE_CORK))
+     {
+        if (setsockopt(fd, IPPROTO_TCP, TCP_CORK, (char *)&state, sizeof(int)) < 0)
+          /* realistically this isn't anything serious so we can just log and continue */
+          ERR("%s failed! %s", state ? "corking" : "uncorking", strerror(errno));
+     }
+#else
+   (void)fd;
+   (void)type;
+   (void)state;
+#endif
+}
+
 EAPI int
 ecore_con_init(void)
 {
@@ -255,6 +540,7 @@ ecore_con_shutdown(void)
      }
 
    ecore_con_socks_shutdown();
+   _ecore_con_rbuf_pool_shutdown();
    if (!_ecore_con_event_count) ecore_con_mempool_shutdown();
 
    ecore_con_info_shutdown();
@@ -569,6 +855,30 @@ ecore_con_server_timeout_get(Ecore_Con_Server *svr)
    return svr->created ? svr->client_disconnect_time : svr->disconnect_time;
 }
 
+EAPI void
+ecore_con_server_recv_pool_set(Ecore_Con_Server *svr, Eina_Bool pool)
+{
+   if (!ECORE_MAGIC_CHECK(svr, ECORE_MAGIC_CON_SERVER))
+     {
+        ECORE_MAGIC_FAIL(svr, ECORE_MAGIC_CON_SERVER, "ecore_con_server_recv_pool_set");
+        return;
+     }
+
+   svr->recv_pool = !!pool;
+}
+
+EAPI Eina_Bool
+ecore_con_server_recv_pool_get(Ecore_Con_Server *svr)
+{
+   if (!ECORE_MAGIC_CHECK(svr, ECORE_MAGIC_CON_SERVER))
+     {
+        ECORE_MAGIC_FAIL(svr, ECORE_MAGIC_CON_SERVER, "ecore_con_server_recv_pool_get");
+        return EINA_FALSE;
+     }
+
+   return svr->recv_pool;
+}
+
 EAPI void *
 ecore_con_server_del(Ecore_Con_Server *svr)
 {
@@ -688,19 +998,18 @@ ecore_con_server_send(Ecore_Con_Server *svr,
    if (svr->fd_handler)
      ecore_main_fd_handler_active_set(svr->fd_handler, ECORE_FD_READ | ECORE_FD_WRITE);
 
+   if (svr->send_queue)
+     {
+        if (!_ecore_con_send_queue_copy(&svr->send_queue, data, size))
+          ERR("_ecore_con_send_queue_copy() failed");
+        return size;
+     }
+
    if (!svr->buf)
      {
         svr->buf = eina_binbuf_new();
         EINA_SAFETY_ON_NULL_RETURN_VAL(svr->buf, 0);
-#ifdef TCP_CORK
-        if ((svr->fd >= 0) && ((svr->type & ECORE_CON_TYPE) == ECORE_CON_REMOTE_CORK))
-          {
-             int state = 1;
-             if (setsockopt(svr->fd, IPPROTO_TCP, TCP_CORK, (char *)&state, sizeof(int)) < 0)
-               /* realistically this isn't anything serious so we can just log and continue */
-               ERR("corking failed! %s", strerror(errno));
-          }
-#endif
+        _ecore_con_cork_set(svr->fd, svr->type, 1);
      }
    if (!eina_binbuf_append_length(svr->buf, data, size))
      ERR("eina_binbuf_append_length() failed");
@@ -708,6 +1017,40 @@ ecore_con_server_send(Ecore_Con_Server *svr,
    return size;
 }
 
+EAPI int
+ecore_con_server_send_segment(Ecore_Con_Server *svr,
+                              const void *data,
+                              int size,
+                              Ecore_Con_Send_Free_Cb free_cb,
+                              const void *cb_data)
+{
+   if (!ECORE_MAGIC_CHECK(svr, ECORE_MAGIC_CON_SERVER))
+     {
+        ECORE_MAGIC_FAIL(svr, ECORE_MAGIC_CON_SERVER, "ecore_con_server_send_segment");
+        return 0;
+     }
+
+   EINA_SAFETY_ON_TRUE_RETURN_VAL(svr->delete_me, 0);
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(data, 0);
+
+   EINA_SAFETY_ON_TRUE_RETURN_VAL(size < 1, 0);
+
+   if ((!svr->buf) && (!svr->send_queue))
+     _ecore_con_cork_set(svr->fd, svr->type, 1);
+
+   if (!_ecore_con_send_queue_add(&svr->send_queue, data, size, free_cb, cb_data))
+     {
+        ERR("_ecore_con_send_queue_add() failed");
+        return 0;
+     }
+
+   if (svr->fd_handler)
+     ecore_main_fd_handler_active_set(svr->fd_handler, ECORE_FD_READ | ECORE_FD_WRITE);
+
+   return size;
+}
+
 EAPI void
 ecore_con_server_client_limit_set(Ecore_Con_Server *svr,
                                   int client_limit,
@@ -800,21 +1143,18 @@ ecore_con_client_send(Ecore_Con_Client *cl,
    if (cl->host_server && ((cl->host_server->type & ECORE_CON_TYPE) == ECORE_CON_REMOTE_UDP))
      sendto(cl->host_server->fd, data, size, 0, (struct sockaddr *)cl->client_addr,
             cl->client_addr_len);
+   else if (cl->send_queue)
+     {
+        if (!_ecore_con_send_queue_copy(&cl->send_queue, data, size))
+          ERR("_ecore_con_send_queue_copy() failed");
+     }
    else 
      {
         if (!cl->buf)
           {
              cl->buf = eina_binbuf_new();
              EINA_SAFETY_ON_NULL_RETURN_VAL(cl->buf, 0);
-#ifdef TCP_CORK
-             if ((cl->fd >= 0) && ((cl->host_server->type & ECORE_CON_TYPE) == ECORE_CON_REMOTE_CORK))
-               {
-                  int state = 1;
-                  if (setsockopt(cl->fd, IPPROTO_TCP, TCP_CORK, (char *)&state, sizeof(int)) < 0)
-                    /* realistically this isn't anything serious so we can just log and continue */
-                    ERR("corking failed! %s", strerror(errno));
-               }
-#endif
+             _ecore_con_cork_set(cl->fd, cl->host_server->type, 1);
           }
         if (!eina_binbuf_append_length(cl->buf, data, size))
           ERR("eina_binbuf_append_length() failed");
@@ -822,6 +1162,48 @@ ecore_con_client_send(Ecore_Con_Client *cl,
    return size;
 }
 
+EAPI int
+ecore_con_client_send_segment(Ecore_Con_Client *cl,
+                              const void *data,
+                              int size,
+                              Ecore_Con_Send_Free_Cb free_cb,
+                              const void *cb_data)
+{
+   if (!ECORE_MAGIC_CHECK(cl, ECORE_MAGIC_CON_CLIENT))
+     {
+        ECORE_MAGIC_FAIL(cl, ECORE_MAGIC_CON_CLIENT, "ecore_con_client_send_segment");
+        return 0;
+     }
+
+   EINA_SAFETY_ON_TRUE_RETURN_VAL(cl->delete_me, 0);
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(data, 0);
+
+   EINA_SAFETY_ON_TRUE_RETURN_VAL(size < 1, 0);
+
+   if (cl->host_server && ((cl->host_server->type & ECORE_CON_TYPE) == ECORE_CON_REMOTE_UDP))
+     {
+        sendto(cl->host_server->fd, data, size, 0, (struct sockaddr *)cl->client_addr,
+               cl->client_addr_len);
+        if (free_cb) free_cb((void *)cb_data, data);
+        return size;
+     }
+
+   if ((!cl->buf) && (!cl->send_queue))
+     _ecore_con_cork_set(cl->fd, cl->host_server->type, 1);
+
+   if (!_ecore_con_send_queue_add(&cl->send_queue, data, size, free_cb, cb_data))
+     {
+        ERR("_ecore_con_send_queue_add() failed");
+        return 0;
+     }
+
+   if (cl->fd_handler)
+     ecore_main_fd_handler_active_set(cl->fd_handler, ECORE_FD_READ | ECORE_FD_WRITE);
+
+   return size;
+}
+
 EAPI Ecore_Con_Server *
 ecore_con_client_server_get(Ecore_Con_Client *cl)
 {
@@ -1079,13 +1461,15 @@ ecore_con_event_server_write(Ecore_Con_Server *svr, int num)
    _ecore_con_event_count++;
 }
 
-void
-ecore_con_event_server_data(Ecore_Con_Server *svr, unsigned char *buf, int num, Eina_Bool duplicate)
+/* Returns EINA_FALSE when no event was queued, buf is then still the
+ * caller's. */
+static Eina_Bool
+_ecore_con_event_server_data_add(Ecore_Con_Server *svr, unsigned char *buf, int num, Eina_Bool duplicate, Ecore_End_Cb free_cb)
 {
    Ecore_Con_Event_Server_Data *e;
 
    e = ecore_con_event_server_data_alloc();
-   EINA_SAFETY_ON_NULL_RETURN(e);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(e, EINA_FALSE);
 
    svr->event_count = eina_list_append(svr->event_count, e);
    _ecore_con_server_timer_update(svr);
@@ -1097,16 +1481,23 @@ ecore_con_event_server_data(Ecore_Con_Server *svr, unsigned char *buf, int num,
           {
              ERR("server data allocation failure !");
              _ecore_con_event_server_data_free(NULL, e);
-             return;
+             return EINA_FALSE;
           }
         memcpy(e->data, buf, num);
      }
    else
      e->data = buf;
    e->size = num;
-   ecore_event_add(ECORE_CON_EVENT_SERVER_DATA, e,
-                   _ecore_con_event_server_data_free, NULL);
+   ecore_event_add(ECORE_CON_EVENT_SERVER_DATA, e, free_cb, NULL);
    _ecore_con_event_count++;
+   return EINA_TRUE;
+}
+
+void
+ecore_con_event_server_data(Ecore_Con_Server *svr, unsigned char *buf, int num, Eina_Bool duplicate)
+{
+   _ecore_con_event_server_data_add(svr, buf, num, duplicate,
+                                    _ecore_con_event_server_data_free);
 }
 
 void
@@ -1166,13 +1557,15 @@ ecore_con_event_client_write(Ecore_Con_Client *cl, int num)
    _ecore_con_event_count++;
 }
 
-void
-ecore_con_event_client_data(Ecore_Con_Client *cl, unsigned char *buf, int num, Eina_Bool duplicate)
+/* Returns EINA_FALSE when no event was queued, buf is then still the
+ * caller's. */
+static Eina_Bool
+_ecore_con_event_client_data_add(Ecore_Con_Client *cl, unsigned char *buf, int num, Eina_Bool duplicate, Ecore_End_Cb free_cb)
 {
    Ecore_Con_Event_Client_Data *e;
 
    e = ecore_con_event_client_data_alloc();
-   EINA_SAFETY_ON_NULL_RETURN(e);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(e, EINA_FALSE);
 
    cl->event_count = eina_list_append(cl->event_count, e);
    cl->host_server->event_count = eina_list_append(cl->host_server->event_count, e);
@@ -1185,16 +1578,23 @@ ecore_con_event_client_data(Ecore_Con_Client *cl, unsigned char *buf, int num, E
           {
              ERR("client data allocation failure !");
              _ecore_con_event_client_data_free(cl->host_server, e);
-             return;
+             return EINA_FALSE;
           }
         memcpy(e->data, buf, num);
      }
    else
      e->data = buf;
    e->size = num;
-   ecore_event_add(ECORE_CON_EVENT_CLIENT_DATA, e,
-                   (Ecore_End_Cb)_ecore_con_event_client_data_free, cl->host_server);
+   ecore_event_add(ECORE_CON_EVENT_CLIENT_DATA, e, free_cb, cl->host_server);
    _ecore_con_event_count++;
+   return EINA_TRUE;
+}
+
+void
+ecore_con_event_client_data(Ecore_Con_Client *cl, unsigned char *buf, int num, Eina_Bool duplicate)
+{
+   _ecore_con_event_client_data_add(cl, buf, num, duplicate,
+                                    (Ecore_End_Cb)_ecore_con_event_client_data_free);
 }
 
 void
@@ -1251,7 +1651,7 @@ _ecore_con_server_free(Ecore_Con_Server *svr)
      }
 
    t_start = ecore_time_get();
-   while (svr->buf && (!svr->delete_me))
+   while ((svr->buf || svr->send_queue) && (!svr->delete_me))
      {
         _ecore_con_server_flush(svr);
         t = ecore_time_get();
@@ -1274,6 +1674,11 @@ _ecore_con_server_free(Ecore_Con_Server *svr)
    if (svr->buf)
      eina_binbuf_free(svr->buf);
 
+   _ecore_con_send_queue_clear(&svr->send_queue);
+
+   if (svr->rbuf)
+     _ecore_con_rbuf_unref(svr->rbuf);
+
    EINA_LIST_FREE(svr->clients, cl)
      {
         Ecore_Con_Event_Server_Add *ev;
@@ -1321,7 +1726,7 @@ _ecore_con_client_free(Ecore_Con_Client *cl)
    if (cl->event_count) return;
 
    t_start = ecore_time_get();
-   while ((cl->buf) && (!cl->delete_me))
+   while ((cl->buf || cl->send_queue) && (!cl->delete_me))
      {
         _ecore_con_client_flush(cl);
         t = ecore_time_get();
@@ -1346,6 +1751,10 @@ _ecore_con_client_free(Ecore_Con_Client *cl)
 
    if (cl->buf) eina_binbuf_free(cl->buf);
 
+   _ecore_con_send_queue_clear(&cl->send_queue);
+
+   if (cl->rbuf) _ecore_con_rbuf_unref(cl->rbuf);
+
    if (cl->host_server->type & ECORE_CON_SSL)
      ecore_con_ssl_client_shutdown(cl);
 
@@ -1862,7 +2271,7 @@ svr_try_connect_plain(Ecore_Con_Server *svr)
 
    if (svr->fd_handler)
      {
-        if (svr->buf)
+        if (svr->buf || svr->send_queue)
           ecore_main_fd_handler_active_set(svr->fd_handler, ECORE_FD_WRITE);
         else
           ecore_main_fd_handler_active_set(svr->fd_handler, ECORE_FD_READ);
@@ -2006,8 +2415,9 @@ static void
 _ecore_con_cl_read(Ecore_Con_Server *svr)
 {
    int num = 0;
+   unsigned int i;
    Eina_Bool lost_server = EINA_TRUE;
-   unsigned char buf[READBUFSIZ];
+   unsigned char stack_buf[READBUFSIZ];
 
    DBG("svr=%p", svr);
 
@@ -2023,30 +2433,60 @@ _ecore_con_cl_read(Ecore_Con_Server *svr)
         _ecore_con_server_timer_update(svr);
      }
 
-   if (svr->ecs_state || !(svr->type & ECORE_CON_SSL))
-     {
-        errno = 0;
-        num = read(svr->fd, buf, sizeof(buf));
-        /* 0 is not a valid return value for a tcp socket */
-        if ((num > 0) || ((num < 0) && (errno == EAGAIN)))
-          lost_server = EINA_FALSE;
-        else if (num < 0)
-          ecore_con_event_server_error(svr, strerror(errno));
-     }
-   else
+   /* drain what is available, a short read means there is nothing left */
+   for (i = 0; i < READBATCH; i++)
      {
-        num = ecore_con_ssl_server_read(svr, buf, sizeof(buf));
-        /* this is not an actual 0 return, 0 here just means non-fatal error such as EAGAIN */
-        if (num >= 0)
-          lost_server = EINA_FALSE;
-     }
+        unsigned char *buf = NULL;
+        size_t size = 0;
 
-   if ((!svr->delete_me) && (num > 0))
-     {
-        if (svr->ecs_state)
-          ecore_con_socks_read(svr, buf, num);
+        if (i > 0) lost_server = EINA_TRUE;
+
+        if (svr->recv_pool && (!svr->ecs_state))
+          buf = _ecore_con_rbuf_reserve(&svr->rbuf, &size);
+        if (!buf)
+          {
+             buf = stack_buf;
+             size = sizeof(stack_buf);
+          }
+
+        if (svr->ecs_state || !(svr->type & ECORE_CON_SSL))
+          {
+             errno = 0;
+             num = read(svr->fd, buf, size);
+             /* 0 is not a valid return value for a tcp socket */
+             if ((num > 0) || ((num < 0) && (errno == EAGAIN)))
+               lost_server = EINA_FALSE;
+             else if (num < 0)
+               ecore_con_event_server_error(svr, strerror(errno));
+          }
         else
-          ecore_con_event_server_data(svr, buf, num, EINA_TRUE);
+          {
+             num = ecore_con_ssl_server_read(svr, buf, size);
+             /* this is not an actual 0 return, 0 here just means non-fatal error such as EAGAIN */
+             if (num >= 0)
+               lost_server = EINA_FALSE;
+          }
+
+        if ((!svr->delete_me) && (num > 0))
+          {
+             if (svr->ecs_state)
+               ecore_con_socks_read(svr, buf, num);
+             else if (buf != stack_buf)
+               {
+                  buf = _ecore_con_rbuf_commit(svr->rbuf, buf, num);
+                  /* without an event, nothing else drops the reference */
+                  if (!_ecore_con_event_server_data_add(svr, buf, num, EINA_FALSE,
+                                                        _ecore_con_event_server_data_pool_free))
+                    _ecore_con_rbuf_release(buf);
+               }
+             else
+               ecore_con_event_server_data(svr, buf, num, EINA_TRUE);
+          }
+
+        /* the proxy handshake reads one reply at a time */
+        if (lost_server || svr->delete_me || svr->ecs_state ||
+            (num < (int)size))
+          break;
      }
 
    if (lost_server)
@@ -2221,8 +2661,9 @@ static void
 _ecore_con_svr_cl_read(Ecore_Con_Client *cl)
 {
    int num = 0;
+   unsigned int i;
    Eina_Bool lost_client = EINA_TRUE;
-   unsigned char buf[READBUFSIZ];
+   unsigned char stack_buf[READBUFSIZ];
 
    DBG("cl=%p", cl);
 
@@ -2237,25 +2678,56 @@ _ecore_con_svr_cl_read(Ecore_Con_Client *cl)
         _ecore_con_cl_timer_update(cl);
      }
 
-   if (!(cl->host_server->type & ECORE_CON_SSL) && (!cl->upgrade))
+   /* drain what is available, a short read means there is nothing left */
+   for (i = 0; i < READBATCH; i++)
      {
-        num = read(cl->fd, buf, sizeof(buf));
-        /* 0 is not a valid return value for a tcp socket */
-        if ((num > 0) || ((num < 0) && ((errno == EAGAIN) || (errno == EINTR))))
-          lost_client = EINA_FALSE;
-        else if (num < 0)
-          ecore_con_event_client_error(cl, strerror(errno));
-     }
-   else
-     {
-        num = ecore_con_ssl_client_read(cl, buf, sizeof(buf));
-        /* this is not an actual 0 return, 0 here just means non-fatal error such as EAGAIN */
-        if (num >= 0)
-          lost_client = EINA_FALSE;
-     }
+        unsigned char *buf = NULL;
+        size_t size = 0;
 
-   if ((!cl->delete_me) && (num > 0))
-     ecore_con_event_client_data(cl, buf, num, EINA_TRUE);
+        if (i > 0) lost_client = EINA_TRUE;
+
+        if (cl->host_server->recv_pool)
+          buf = _ecore_con_rbuf_reserve(&cl->rbuf, &size);
+        if (!buf)
+          {
+             buf = stack_buf;
+             size = sizeof(stack_buf);
+          }
+
+        if (!(cl->host_server->type & ECORE_CON_SSL) && (!cl->upgrade))
+          {
+             num = read(cl->fd, buf, size);
+             /* 0 is not a valid return value for a tcp socket */
+             if ((num > 0) || ((num < 0) && ((errno == EAGAIN) || (errno == EINTR))))
+               lost_client = EINA_FALSE;
+             else if (num < 0)
+               ecore_con_event_client_error(cl, strerror(errno));
+          }
+        else
+          {
+             num = ecore_con_ssl_client_read(cl, buf, size);
+             /* this is not an actual 0 return, 0 here just means non-fatal error such as EAGAIN */
+             if (num >= 0)
+               lost_client = EINA_FALSE;
+          }
+
+        if ((!cl->delete_me) && (num > 0))
+          {
+             if (buf != stack_buf)
+               {
+                  buf = _ecore_con_rbuf_commit(cl->rbuf, buf, num);
+                  /* without an event, nothing else drops the reference */
+                  if (!_ecore_con_event_client_data_add(cl, buf, num, EINA_FALSE,
+                                                        (Ecore_End_Cb)_ecore_con_event_client_data_pool_free))
+                    _ecore_con_rbuf_release(buf);
+               }
+             else
+               ecore_con_event_client_data(cl, buf, num, EINA_TRUE);
+          }
+
+        if (lost_client || cl->delete_me || (num < (int)size))
+          break;
+     }
 
    if (lost_client) _ecore_con_client_kill(cl);
 }
@@ -2294,11 +2766,12 @@ static void
 _ecore_con_server_flush(Ecore_Con_Server *svr)
 {
    int count;
-   size_t num;
-   size_t buf_len;
-   size_t *buf_offset;
-   const unsigned char *buf;
-   Eina_Binbuf *buf_p;
+   size_t num = 0;
+   size_t buf_len = 0;
+   size_t *buf_offset = NULL;
+   const unsigned char *buf = NULL;
+   Eina_Binbuf *buf_p = NULL;
+   Eina_Bool queued;
 
    DBG("(svr=%p,buf=%p)", svr, svr->buf);
    if (!svr->fd_handler) return;
@@ -2307,7 +2780,10 @@ _ecore_con_server_flush(Ecore_Con_Server *svr)
      return;
 #endif
 
-   if ((!svr->buf) && (!svr->ecs_buf))
+   /* the proxy handshake goes out before any queued segment */
+   queued = (svr->send_queue) && (!svr->ecs_buf);
+
+   if ((!svr->buf) && (!svr->ecs_buf) && (!queued))
      {
         ecore_main_fd_handler_active_set(svr->fd_handler, ECORE_FD_READ);
         return;
@@ -2318,14 +2794,17 @@ _ecore_con_server_flush(Ecore_Con_Server *svr)
         buf_p = svr->buf;
         buf_offset = &(svr->write_buf_offset);
      }
-   else
+   else if (svr->ecs_buf)
      {
         buf_p = svr->ecs_buf;
         buf_offset = &(svr->ecs_buf_offset);
      }
-   buf = eina_binbuf_string_get(buf_p);
-   buf_len = eina_binbuf_length_get(buf_p);
-   num = buf_len - *buf_offset;
+   if (buf_p)
+     {
+        buf = eina_binbuf_string_get(buf_p);
+        buf_len = eina_binbuf_length_get(buf_p);
+        num = buf_len - *buf_offset;
+     }
 
    /* check whether we need to write anything at all.
     * we must not write zero bytes with SSL_write() since it
@@ -2334,7 +2813,7 @@ _ecore_con_server_flush(Ecore_Con_Server *svr)
    /* we thank Tommy[D] for needing to check negative buffer sizes
     * here because his system is amazing.
     */
-   if (num <= 0) return;
+   if ((num <= 0) && (!queued)) return;
 
    if ((!svr->ecs_state) && svr->handshaking)
      {
@@ -2346,9 +2825,23 @@ _ecore_con_server_flush(Ecore_Con_Server *svr)
      }
 
    if (svr->ecs_state || (!(svr->type & ECORE_CON_SSL)))
-     count = write(svr->fd, buf + *buf_offset, num);
-   else
+     {
+        if (queued)
+          count = _ecore_con_send_queue_write(svr->fd, buf ? buf + *buf_offset : NULL,
+                                              num, svr->send_queue);
+        else
+          count = write(svr->fd, buf + *buf_offset, num);
+     }
+   else if (num > 0)
      count = ecore_con_ssl_server_write(svr, buf + *buf_offset, num);
+   else
+     {
+        Ecore_Con_Send_Segment *seg;
+
+        seg = EINA_INLIST_CONTAINER_GET(svr->send_queue, Ecore_Con_Send_Segment);
+        count = ecore_con_ssl_server_write(svr, _ecore_con_send_segment_data(seg) + seg->offset,
+                                           seg->size - seg->offset);
+     }
 
    if (count < 0)
      {
@@ -2362,41 +2855,43 @@ _ecore_con_server_flush(Ecore_Con_Server *svr)
 
    if (count && (!svr->ecs_state)) ecore_con_event_server_write(svr, count);
 
-   if (!eina_binbuf_remove(buf_p, 0, count))
-     *buf_offset += count;
-   else
-     {
-        *buf_offset = 0;
-        buf_len -= count;
-     }
-   if (*buf_offset >= buf_len)
+   if ((size_t)count > num)
+     _ecore_con_send_queue_consume(&svr->send_queue, count - num);
+
+   if (buf_p)
      {
-        *buf_offset = 0;
-        eina_binbuf_free(buf_p);
+        size_t done = ((size_t)count > num) ? num : (size_t)count;
 
-        if (svr->ecs_buf)
+        if (!eina_binbuf_remove(buf_p, 0, done))
+          *buf_offset += done;
+        else
           {
-             svr->ecs_buf = NULL;
-             INF("PROXY STATE++");
-             svr->ecs_state++;
+             *buf_offset = 0;
+             buf_len -= done;
           }
-        else
+        if (*buf_offset >= buf_len)
           {
-             svr->buf = NULL;
-#ifdef TCP_CORK
-             if ((svr->type & ECORE_CON_TYPE) == ECORE_CON_REMOTE_CORK)
+             *buf_offset = 0;
+             eina_binbuf_free(buf_p);
+
+             if (svr->ecs_buf)
                {
-                  int state = 0;
-                  if (setsockopt(svr->fd, IPPROTO_TCP, TCP_CORK, (char *)&state, sizeof(int)) < 0)
-                    /* realistically this isn't anything serious so we can just log and continue */
-                    ERR("uncorking failed! %s", strerror(errno));
+                  svr->ecs_buf = NULL;
+                  INF("PROXY STATE++");
+                  svr->ecs_state++;
                }
-#endif
+             else
+               svr->buf = NULL;
           }
+     }
+
+   if ((!svr->buf) && (!svr->ecs_buf) && (!svr->send_queue))
+     {
+        _ecore_con_cork_set(svr->fd, svr->type, 0);
         if (svr->fd_handler)
           ecore_main_fd_handler_active_set(svr->fd_handler, ECORE_FD_READ);
      }
-   else if ((count < num) && svr->fd_handler)
+   else if (((size_t)count < num) && svr->fd_handler)
      ecore_main_fd_handler_active_set(svr->fd_handler, ECORE_FD_WRITE);
 }
 
@@ -2412,7 +2907,7 @@ _ecore_con_client_flush(Ecore_Con_Client *cl)
      return;
 #endif
 
-   if (!cl->buf)
+   if ((!cl->buf) && (!cl->send_queue))
      {
         ecore_main_fd_handler_active_set(cl->fd_handler, ECORE_FD_READ);
         return;
@@ -2428,13 +2923,31 @@ _ecore_con_client_flush(Ecore_Con_Client *cl)
 
    if (!count)
      {
-        if (!cl->buf) return;
-        num = eina_binbuf_length_get(cl->buf) - cl->buf_offset;
-        if (num <= 0) return;
+        const unsigned char *buf = NULL;
+
+        if (cl->buf)
+          {
+             buf = eina_binbuf_string_get(cl->buf) + cl->buf_offset;
+             num = eina_binbuf_length_get(cl->buf) - cl->buf_offset;
+          }
+        if ((num <= 0) && (!cl->send_queue)) return;
         if (!(cl->host_server->type & ECORE_CON_SSL) && (!cl->upgrade))
-          count = write(cl->fd, eina_binbuf_string_get(cl->buf) + cl->buf_offset, num);
+          {
+             if (cl->send_queue)
+               count = _ecore_con_send_queue_write(cl->fd, buf, num, cl->send_queue);
+             else
+               count = write(cl->fd, buf, num);
+          }
+        else if (num > 0)
+          count = ecore_con_ssl_client_write(cl, buf, num);
         else
-          count = ecore_con_ssl_client_write(cl, eina_binbuf_string_get(cl->buf) + cl->buf_offset, num);
+          {
+             Ecore_Con_Send_Segment *seg;
+
+             seg = EINA_INLIST_CONTAINER_GET(cl->send_queue, Ecore_Con_Send_Segment);
+             count = ecore_con_ssl_client_write(cl, _ecore_con_send_segment_data(seg) + seg->offset,
+                                                seg->size - seg->offset);
+          }
      }
 
    if (count < 0)
@@ -2449,25 +2962,26 @@ _ecore_con_client_flush(Ecore_Con_Client *cl)
      }
 
    if (count) ecore_con_event_client_write(cl, count);
-   cl->buf_offset += count, num -= count;
-   if (cl->buf_offset >= eina_binbuf_length_get(cl->buf))
+   if ((size_t)count > num)
+     _ecore_con_send_queue_consume(&cl->send_queue, count - num);
+   if (cl->buf)
      {
-        cl->buf_offset = 0;
-        eina_binbuf_free(cl->buf);
-        cl->buf = NULL;
-#ifdef TCP_CORK
-        if ((cl->host_server->type & ECORE_CON_TYPE) == ECORE_CON_REMOTE_CORK)
+        cl->buf_offset += ((size_t)count > num) ? num : (size_t)count;
+        if (cl->buf_offset >= eina_binbuf_length_get(cl->buf))
           {
-             int state = 0;
-             if (setsockopt(cl->fd, IPPROTO_TCP, TCP_CORK, (char *)&state, sizeof(int)) < 0)
-               /* realistically this isn't anything serious so we can just log and continue */
-               ERR("uncorking failed! %s", strerror(errno));
+             cl->buf_offset = 0;
+             eina_binbuf_free(cl->buf);
+             cl->buf = NULL;
           }
-#endif
+     }
+
+   if ((!cl->buf) && (!cl->send_queue))
+     {
+        _ecore_con_cork_set(cl->fd, cl->host_server->type, 0);
         if (cl->fd_handler)
           ecore_main_fd_handler_active_set(cl->fd_handler, ECORE_FD_READ);
      }
-   else if (cl->fd_handler && (num >= 0))
+   else if (cl->fd_handler)
      ecore_main_fd_handler_active_set(cl->fd_handler, ECORE_FD_WRITE);
 }
 
@@ -2608,6 +3122,17 @@ _ecore_con_event_client_data_free(Ecore_Con_Server *svr,
      ecore_con_mempool_shutdown();
 }
 
+static void
+_ecore_con_event_client_data_pool_free(Ecore_Con_Server *svr,
+                                       void *ev)
+{
+   Ecore_Con_Event_Client_Data *e = ev;
+
+   _ecore_con_rbuf_release(e->data);
+   e->data = NULL;
+   _ecore_con_event_client_data_free(svr, ev);
+}
+
 static void
 _ecore_con_event_server_add_free(void *data EINA_UNUSED,
                                  void *ev)
@@ -2684,6 +3209,17 @@ _ecore_con_event_server_data_free(void *data EINA_UNUSED,
      ecore_con_mempool_shutdown();
 }
 
+static void
+_ecore_con_event_server_data_pool_free(void *data,
+                                       void *ev)
+{
+   Ecore_Con_Event_Server_Data *e = ev;
+
+   _ecore_con_rbuf_release(e->data);
+   e->data = NULL;
+   _ecore_con_event_server_data_free(data, ev);
+}
+
 static void
 _ecore_con_event_server_error_free(void *data EINA_UNUSED, Ecore_Con_Event_Server_Error *e)
 {
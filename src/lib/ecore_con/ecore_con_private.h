@@ -19,6 +19,8 @@
 #endif
 
 #define READBUFSIZ 65536
+/* maximum number of reads done on a stream socket per wakeup */
+#define READBATCH 16
 
 extern int _ecore_con_log_dom;
 
@@ -56,6 +58,8 @@ typedef struct _Ecore_Con_Lookup Ecore_Con_Lookup;
 typedef struct _Ecore_Con_Info Ecore_Con_Info;
 typedef struct Ecore_Con_Socks Ecore_Con_Socks_v4;
 typedef struct Ecore_Con_Socks_v5 Ecore_Con_Socks_v5;
+typedef struct _Ecore_Con_Rbuf Ecore_Con_Rbuf;
+typedef struct _Ecore_Con_Send_Segment Ecore_Con_Send_Segment;
 typedef void (*Ecore_Con_Info_Cb)(void *data, Ecore_Con_Info *infos);
 
 typedef enum _Ecore_Con_State
@@ -103,8 +107,10 @@ struct _Ecore_Con_Client
    Ecore_Fd_Handler *fd_handler;
    size_t buf_offset;
    Eina_Binbuf *buf;
+   Eina_Inlist *send_queue; /* segments queued after buf */
    const char *ip;
    Eina_List *event_count;
+   Ecore_Con_Rbuf *rbuf; /* pooled receive buffer being filled */
    struct sockaddr *client_addr;
    int client_addr_len;
    double start_time;
@@ -137,8 +143,10 @@ struct _Ecore_Con_Server
    unsigned int client_count;
    Eina_Binbuf *buf;
    size_t write_buf_offset;
+   Eina_Inlist *send_queue; /* segments queued after buf */
    Eina_List *infos;
    Eina_List *event_count;
+   Ecore_Con_Rbuf *rbuf; /* pooled receive buffer being filled */
    int client_limit;
    pid_t ppid;
    /* socks */
@@ -184,6 +192,7 @@ struct _Ecore_Con_Server
    Eina_Bool verify_basic : 1; /* @c EINA_TRUE if certificates will be verified only against the hostname */
    Eina_Bool reject_excess_clients : 1;
    Eina_Bool delete_me : 1; /* del event has been queued */
+   Eina_Bool recv_pool : 1; /* data events point into pooled receive buffers */
 #ifdef _WIN32
    Eina_Bool want_write : 1;
    Eina_Bool read_stop : 1;
@@ -69,14 +69,79 @@ edje_cache_emp_free(Edje_Part_Collection_Directory_Entry *ce)
 }
 
 
-void
-_edje_programs_patterns_init(Edje_Part_Collection *edc)
+/* The programs that need globbing, in the order the matchers index them */
+EAPI Edje_Program **
+_edje_programs_globing_get(Edje_Part_Collection *edc, unsigned int *count)
+{
+   Edje_Program **all;
+   unsigned int i, j;
+
+   *count = 0;
+   j = edc->programs.strncmp_count
+     + edc->programs.strrncmp_count
+     + edc->programs.fnmatch_count
+     + edc->programs.nocmp_count;
+   if (j == 0) return NULL;
+
+   all = malloc(sizeof (Edje_Program *) * j);
+   if (!all) return NULL;
+   j = 0;
+
+   /* FIXME: Build specialized data type for each case */
+#define EDJE_LOAD_PROGRAMS_ADD(Array, Edc, It, Git, All)		\
+   for (It = 0; It < Edc->programs.Array##_count; ++It, ++Git)		\
+     All[Git] = Edc->programs.Array[It];
+
+   EDJE_LOAD_PROGRAMS_ADD(fnmatch, edc, i, j, all);
+   EDJE_LOAD_PROGRAMS_ADD(strncmp, edc, i, j, all);
+   EDJE_LOAD_PROGRAMS_ADD(strrncmp, edc, i, j, all);
+   /* FIXME: Do a special pass for that one */
+   EDJE_LOAD_PROGRAMS_ADD(nocmp, edc, i, j, all);
+
+   *count = j;
+   return all;
+}
+
+/* Precompile the globbing programs for _edje_programs_patterns_build(),
+ * uncompressed so they can be used from the mapped file. */
+EAPI Eina_Bool
+_edje_programs_automata_write(Eet_File *ef, Edje_Part_Collection *edc)
+{
+   Edje_Program **all;
+   unsigned int count;
+   void *data = NULL;
+   char buf[256];
+   int size = 0;
+   Eina_Bool ret = EINA_TRUE;
+
+   snprintf(buf, sizeof(buf), "edje/signals/%i", edc->id);
+
+   all = _edje_programs_globing_get(edc, &count);
+   if (all) data = edje_match_programs_automata_build(all, count, &size);
+   free(all);
+
+   /* too big, or nothing to glob: the runtime matcher does it */
+   if (!data)
+     {
+        eet_delete(ef, buf);
+        return EINA_TRUE;
+     }
+
+   if (eet_write(ef, buf, data, size, 0) <= 0)
+     ret = EINA_FALSE;
+   free(data);
+
+   return ret;
+}
+
+static void
+_edje_programs_patterns_build(Edje_Part_Collection *edc, Eet_File *ef, int id)
 {
    Edje_Signals_Sources_Patterns *ssp = &edc->patterns.programs;
    Edje_Program **all;
    unsigned int i, j;
 
-   if (ssp->signals_patterns)
+   if (ssp->signals_patterns || edc->patterns.automata)
      return;
 
    if (getenv("EDJE_DUMP_PROGRAMS"))
@@ -97,33 +162,44 @@ _edje_programs_patterns_init(Edje_Part_Collection *edc)
 				 edc->programs.strcmp_count,
 				 &ssp->exact_match);
 
-   j = edc->programs.strncmp_count
-     + edc->programs.strrncmp_count
-     + edc->programs.fnmatch_count
-     + edc->programs.nocmp_count;
-   if (j == 0) return;
-
-   all = malloc(sizeof (Edje_Program *) * j);
+   all = _edje_programs_globing_get(edc, &j);
    if (!all) return;
-   j = 0;
-
-   /* FIXME: Build specialized data type for each case */
-#define EDJE_LOAD_PROGRAMS_ADD(Array, Edc, It, Git, All)		\
-   for (It = 0; It < Edc->programs.Array##_count; ++It, ++Git)		\
-     All[Git] = Edc->programs.Array[It];
-
-   EDJE_LOAD_PROGRAMS_ADD(fnmatch, edc, i, j, all);
-   EDJE_LOAD_PROGRAMS_ADD(strncmp, edc, i, j, all);
-   EDJE_LOAD_PROGRAMS_ADD(strrncmp, edc, i, j, all);
-   /* FIXME: Do a special pass for that one */
-   EDJE_LOAD_PROGRAMS_ADD(nocmp, edc, i, j, all);
 
    ssp->u.programs.globing = all;
    ssp->u.programs.count = j;
+
+   /* edje_cc already turned them into automata, use them in place */
+   if (ef)
+     {
+        const void *direct;
+        void *data;
+        char buf[256];
+        int size;
+
+        snprintf(buf, sizeof(buf), "edje/signals/%i", id);
+        direct = eet_read_direct(ef, buf, &size);
+        if (direct)
+          edc->patterns.automata =
+            edje_match_programs_automata_load(direct, size, EINA_FALSE, all, j);
+        else if ((data = eet_read(ef, buf, &size)))
+          {
+             edc->patterns.automata =
+               edje_match_programs_automata_load(data, size, EINA_TRUE, all, j);
+             if (!edc->patterns.automata) free(data);
+          }
+        if (edc->patterns.automata) return;
+     }
+
    ssp->signals_patterns = edje_match_programs_signal_init(all, j);
    ssp->sources_patterns = edje_match_programs_source_init(all, j);
 }
 
+void
+_edje_programs_patterns_init(Edje_Part_Collection *edc)
+{
+   _edje_programs_patterns_build(edc, NULL, -1);
+}
+
 static Edje_Part_Collection *
 _edje_file_coll_open(Edje_File *edf, const char *coll)
 {
@@ -219,7 +295,7 @@ _edje_file_coll_open(Edje_File *edf, const char *coll)
 
    ce->ref = edc;
 
-   _edje_programs_patterns_init(edc);
+   _edje_programs_patterns_build(edc, edf->ef, id);
 
    n = edc->programs.fnmatch_count +
      edc->programs.strcmp_count +
@@ -252,6 +328,8 @@ _edje_file_coll_open(Edje_File *edf, const char *coll)
 	 }
      }
 
+   _edje_calc_graph_build(edc);
+
    return edc;
 }
 
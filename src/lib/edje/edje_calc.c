@@ -660,6 +660,261 @@ _edje_recalc(Edje *ed)
 //   ed->postponed = EINA_TRUE;
 }
 
+typedef struct _Edje_Calc_Graph_Deps Edje_Calc_Graph_Deps;
+struct _Edje_Calc_Graph_Deps
+{
+   unsigned int *seen;
+   unsigned int *deps;
+   unsigned int  count;
+   unsigned int  parts_count;
+   unsigned int  part;
+   unsigned int  stamp;
+};
+
+static void
+_edje_calc_graph_dep_add(Edje_Calc_Graph_Deps *gd, int id)
+{
+   unsigned int dep;
+
+   if (id < 0) return;
+   dep = id % gd->parts_count;
+   if ((dep == gd->part) || (gd->seen[dep] == gd->stamp)) return;
+   gd->seen[dep] = gd->stamp;
+   gd->deps[gd->count++] = dep;
+}
+
+static void
+_edje_calc_graph_desc_deps_add(Edje_Calc_Graph_Deps *gd, Edje_Part *ep,
+                               Edje_Part_Description_Common *desc)
+{
+   if (!desc) return;
+
+   _edje_calc_graph_dep_add(gd, desc->rel1.id_x);
+   _edje_calc_graph_dep_add(gd, desc->rel1.id_y);
+   _edje_calc_graph_dep_add(gd, desc->rel2.id_x);
+   _edje_calc_graph_dep_add(gd, desc->rel2.id_y);
+   _edje_calc_graph_dep_add(gd, desc->map.rot.id_center);
+   _edje_calc_graph_dep_add(gd, desc->map.id_light);
+   _edje_calc_graph_dep_add(gd, desc->map.id_persp);
+
+   switch (ep->type)
+     {
+      case EDJE_PART_TYPE_TEXT:
+      case EDJE_PART_TYPE_TEXTBLOCK:
+        {
+           Edje_Part_Description_Text *text;
+
+           text = (Edje_Part_Description_Text *)desc;
+           _edje_calc_graph_dep_add(gd, text->text.id_source);
+           _edje_calc_graph_dep_add(gd, text->text.id_text_source);
+           break;
+        }
+      case EDJE_PART_TYPE_PROXY:
+        {
+           Edje_Part_Description_Proxy *proxy;
+
+           proxy = (Edje_Part_Description_Proxy *)desc;
+           _edje_calc_graph_dep_add(gd, proxy->proxy.id);
+           break;
+        }
+      default:
+        break;
+     }
+}
+
+/* Every part another one can be placed relative to, in any of its states */
+static void
+_edje_calc_graph_part_deps_get(Edje_Calc_Graph_Deps *gd, Edje_Part_Collection *edc,
+                               unsigned int part)
+{
+   Edje_Part *ep = edc->parts[part];
+   unsigned int i;
+
+   gd->part = part;
+   gd->count = 0;
+   gd->stamp++;
+
+   _edje_calc_graph_desc_deps_add(gd, ep, ep->default_desc);
+   for (i = 0; i < ep->other.desc_count; i++)
+     _edje_calc_graph_desc_deps_add(gd, ep, ep->other.desc[i]);
+   _edje_calc_graph_dep_add(gd, ep->dragable.confine_id);
+   _edje_calc_graph_dep_add(gd, ep->dragable.threshold_id);
+}
+
+void
+_edje_calc_graph_build(Edje_Part_Collection *edc)
+{
+   Edje_Calc_Graph_Deps gd;
+   unsigned int *pending, *next;
+   unsigned int *order, *index, *dependents;
+   unsigned int n, i, j, edges = 0, head, tail;
+
+   _edje_calc_graph_free(edc);
+
+   n = edc->parts_count;
+   if (!n) return;
+
+   gd.seen = calloc(n, sizeof (unsigned int));
+   gd.deps = malloc(n * sizeof (unsigned int));
+   pending = calloc(n, sizeof (unsigned int));
+   next = calloc(n + 1, sizeof (unsigned int));
+   if (!gd.seen || !gd.deps || !pending || !next) goto on_error;
+   gd.parts_count = n;
+   gd.stamp = 0;
+
+   /* count the edges to lay the dependents out in one array */
+   for (i = 0; i < n; i++)
+     {
+        _edje_calc_graph_part_deps_get(&gd, edc, i);
+        for (j = 0; j < gd.count; j++)
+          next[gd.deps[j] + 1]++;
+        pending[i] = gd.count;
+        edges += gd.count;
+     }
+
+   order = malloc((n + n + 1 + edges) * sizeof (unsigned int));
+   if (!order) goto on_error;
+   index = order + n;
+   dependents = index + n + 1;
+
+   index[0] = 0;
+   for (i = 0; i < n; i++)
+     {
+        index[i + 1] = index[i] + next[i + 1];
+        next[i] = index[i];
+     }
+   for (i = 0; i < n; i++)
+     {
+        _edje_calc_graph_part_deps_get(&gd, edc, i);
+        for (j = 0; j < gd.count; j++)
+          dependents[next[gd.deps[j]]++] = i;
+     }
+
+   /* parts nothing depends on go first, in their stacking order */
+   head = tail = 0;
+   for (i = 0; i < n; i++)
+     if (!pending[i]) order[tail++] = i;
+   while (head < tail)
+     {
+        unsigned int part = order[head++];
+
+        for (j = index[part]; j < index[part + 1]; j++)
+          if (--pending[dependents[j]] == 0)
+            order[tail++] = dependents[j];
+     }
+
+   edc->calc_graph.cyclic = (tail < n);
+   /* the recalc reports the loop, just keep every part in the order */
+   for (i = 0; (i < n) && (tail < n); i++)
+     if (pending[i]) order[tail++] = i;
+
+   edc->calc_graph.order = order;
+   edc->calc_graph.dependents_index = index;
+   edc->calc_graph.dependents = dependents;
+   edc->calc_graph.count = n;
+
+ on_error:
+   free(gd.seen);
+   free(gd.deps);
+   free(pending);
+   free(next);
+}
+
+void
+_edje_calc_graph_free(Edje_Part_Collection *edc)
+{
+   /* index and dependents live in the same allocation */
+   free(edc->calc_graph.order);
+   edc->calc_graph.order = NULL;
+   edc->calc_graph.dependents_index = NULL;
+   edc->calc_graph.dependents = NULL;
+   edc->calc_graph.count = 0;
+   edc->calc_graph.cyclic = EINA_FALSE;
+}
+
+#ifdef EDJE_CALC_CACHE
+/* Parts whose geometry can change without any part being invalidated:
+ * they follow a child object, a physics body or the perspective. */
+static Eina_Bool
+_edje_part_recalc_volatile(Edje_Real_Part *ep)
+{
+   switch (ep->part->type)
+     {
+      case EDJE_PART_TYPE_SWALLOW:
+        if ((ep->type == EDJE_RP_TYPE_SWALLOW) && ep->typedata.swallow &&
+            ep->typedata.swallow->swallowed_object)
+          return EINA_TRUE;
+        break;
+      case EDJE_PART_TYPE_GROUP:
+      case EDJE_PART_TYPE_EXTERNAL:
+      case EDJE_PART_TYPE_BOX:
+      case EDJE_PART_TYPE_TABLE:
+        return EINA_TRUE;
+      default:
+        break;
+     }
+#ifdef HAVE_EPHYSICS
+   if (ep->body) return EINA_TRUE;
+#endif
+   if (ep->param1.description && ep->param1.description->map.on)
+     return EINA_TRUE;
+   if (ep->param2 && ep->param2->description &&
+       ep->param2->description->map.on)
+     return EINA_TRUE;
+   return EINA_FALSE;
+}
+
+/* Only recalc the parts that changed and the ones placed relative to them,
+ * in dependency order. Returns EINA_FALSE when everything needs to go. */
+static Eina_Bool
+_edje_recalc_dirty_do(Edje *ed)
+{
+   Edje_Part_Collection *edc = ed->collection;
+   unsigned int i, j;
+
+   if (ed->all_part_change || ed->need_map_update || ed->calc_only)
+     return EINA_FALSE;
+   if (!edc || (edc->parts_count != ed->table_parts_size))
+     return EINA_FALSE;
+   if (!edc->calc_graph.order || (edc->calc_graph.count != edc->parts_count))
+     _edje_calc_graph_build(edc);
+   if (!edc->calc_graph.order || edc->calc_graph.cyclic)
+     return EINA_FALSE;
+
+   /* Clean parts stay calculated from last time. A part is dirty if it was
+    * invalidated or something it depends on is dirty, and the order makes
+    * sure all of those were seen before it. */
+   for (i = 0; i < ed->table_parts_size; i++)
+     {
+        unsigned int part = edc->calc_graph.order[i];
+        Edje_Real_Part *ep = ed->table_parts[part];
+
+        ep->calculating = FLAG_NONE;
+        if (ep->invalidate || _edje_part_recalc_volatile(ep) ||
+            (ed->text_part_change &&
+             ((ep->part->type == EDJE_PART_TYPE_TEXT) ||
+              (ep->part->type == EDJE_PART_TYPE_TEXTBLOCK))))
+          ep->calculated = FLAG_NONE;
+        if (ep->calculated == FLAG_XY) continue;
+
+        ep->calculated = FLAG_NONE;
+        for (j = edc->calc_graph.dependents_index[part];
+             j < edc->calc_graph.dependents_index[part + 1]; j++)
+          ed->table_parts[edc->calc_graph.dependents[j]]->calculated = FLAG_NONE;
+     }
+   for (i = 0; i < ed->table_parts_size; i++)
+     {
+        Edje_Real_Part *ep;
+
+        ep = ed->table_parts[edc->calc_graph.order[i]];
+        if (ep->calculated != FLAG_XY)
+          _edje_part_recalc(ed, ep, (~ep->calculated) & FLAG_XY, NULL);
+     }
+
+   return EINA_TRUE;
+}
+#endif
+
 void
 _edje_recalc_do(Edje *ed)
 {
@@ -673,21 +928,26 @@ _edje_recalc_do(Edje *ed)
    if (!ed->dirty) return;
    ed->dirty = EINA_FALSE;
    ed->state++;
-   for (i = 0; i < ed->table_parts_size; i++)
+#ifdef EDJE_CALC_CACHE
+   if (!_edje_recalc_dirty_do(ed))
+#endif
      {
-        Edje_Real_Part *ep;
+        for (i = 0; i < ed->table_parts_size; i++)
+          {
+             Edje_Real_Part *ep;
 
-        ep = ed->table_parts[i];
-        ep->calculated = FLAG_NONE;
-        ep->calculating = FLAG_NONE;
-     }
-   for (i = 0; i < ed->table_parts_size; i++)
-     {
-        Edje_Real_Part *ep;
+             ep = ed->table_parts[i];
+             ep->calculated = FLAG_NONE;
+             ep->calculating = FLAG_NONE;
+          }
+        for (i = 0; i < ed->table_parts_size; i++)
+          {
+             Edje_Real_Part *ep;
 
-        ep = ed->table_parts[i];
-        if (ep->calculated != FLAG_XY)
-          _edje_part_recalc(ed, ep, (~ep->calculated) & FLAG_XY, NULL);
+             ep = ed->table_parts[i];
+             if (ep->calculated != FLAG_XY)
+               _edje_part_recalc(ed, ep, (~ep->calculated) & FLAG_XY, NULL);
+          }
      }
    if (!ed->calc_only) ed->recalc = EINA_FALSE;
 #ifdef EDJE_CALC_CACHE
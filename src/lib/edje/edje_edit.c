@@ -1187,6 +1187,8 @@ edje_edit_group_del(Evas_Object *obj, const char *group_name)
      }
    snprintf(buf, sizeof(buf), "edje/collections/%d", e->id);
    eet_delete(eetf, buf);
+   snprintf(buf, sizeof(buf), "edje/signals/%d", e->id);
+   eet_delete(eetf, buf);
    snprintf(buf, sizeof(buf), "edje/scripts/embryo/compiled/%d", e->id);
    eet_delete(eetf, buf);
    snprintf(buf, sizeof(buf), "edje/scripts/embryo/source/%d", e->id);
@@ -8016,7 +8018,8 @@ _edje_edit_collection_save(Eet_File *eetf, Edje_Part_Collection *epc)
 
    snprintf(buf, sizeof(buf), "edje/collections/%i", epc->id);
 
-   if (eet_data_write(eetf, _edje_edd_edje_part_collection, buf, epc, 1) > 0)
+   if ((eet_data_write(eetf, _edje_edd_edje_part_collection, buf, epc, 1) > 0) &&
+       _edje_programs_automata_write(eetf, epc))
      return EINA_TRUE;
 
    ERR("Error. unable to write \"%s\" part entry", buf);
@@ -349,6 +349,9 @@ _edje_programs_patterns_clean(Edje_Part_Collection *edc)
 
    free(edc->patterns.programs.u.programs.globing);
    edc->patterns.programs.u.programs.globing = NULL;
+
+   edje_match_automata_free(edc->patterns.automata);
+   edc->patterns.automata = NULL;
 }
 
 #ifdef HAVE_EPHYSICS
@@ -1699,6 +1702,7 @@ _edje_collection_free(Edje_File *edf, Edje_Part_Collection *ec, Edje_Part_Collec
    if (ec->patterns.table_programs) free(ec->patterns.table_programs);
    ec->patterns.table_programs = NULL;
    ec->patterns.table_programs_size = 0;
+   _edje_calc_graph_free(ec);
 
    if (ec->script) embryo_program_free(ec->script);
    _edje_lua2_script_unload(ec);
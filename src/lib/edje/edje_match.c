@@ -96,25 +96,26 @@ _edje_match_states_insert(Edje_States *list,
    unsigned int i;
 
    i = (idx * (patterns_max_length + 1)) + pos;
-
-   if (i < list->size)
-     {
-	if (list->has[i]) return;
-     }
+   if (list->has[i]) return;
    list->has[i] = 1;
 
    i = list->size;
    list->states[i].idx = idx;
    list->states[i].pos = pos;
-   list->has[i] = 0;
    list->size++;
 }
 
 static void
 _edje_match_states_clear(Edje_States *list,
                          EINA_UNUSED unsigned int patterns_size,
-                         EINA_UNUSED unsigned int patterns_max_length)
+                         unsigned int patterns_max_length)
 {
+   unsigned int i;
+
+   /* only what was inserted is set */
+   for (i = 0; i < list->size; ++i)
+     list->has[(list->states[i].idx * (patterns_max_length + 1))
+               + list->states[i].pos] = 0;
    list->size = 0;
 }
 
@@ -235,14 +236,12 @@ _edje_match_patterns_exec_init_states(Edje_States *states,
 {
    unsigned int i;
 
-   states->size = patterns_size;
+   /* both lists still hold what the last match left */
+   _edje_match_states_clear(states, patterns_size, patterns_max_length);
+   _edje_match_states_clear(states + 1, patterns_size, patterns_max_length);
 
    for (i = 0; i < patterns_size; ++i)
-     {
-        states->states[i].idx = i;
-        states->states[i].pos = 0;
-        states->has[i * (patterns_max_length + 1)] = 1;
-     }
+     _edje_match_states_insert(states, patterns_max_length, i, 0);
 }
 
 /* Exported function. */
@@ -465,6 +464,19 @@ _edje_match_collection_dir_exec_finals(const unsigned int *finals,
    return EINA_FALSE;
 }
 
+static int
+_edje_match_idx_cmp(const void *a, const void *b)
+{
+   const unsigned int *i1 = a;
+   const unsigned int *i2 = b;
+
+   if (*i1 != *i2) return *i1 < *i2 ? -1 : 1;
+   return 0;
+}
+
+/* The matched programs run once each, in the order of the globbing table,
+ * whatever the order the states were reached in. The precompiled automata
+ * can only give that order, both have to agree. */
 static Eina_Bool
 edje_match_programs_exec_check_finals(const unsigned int *signal_finals,
                                       const unsigned int *source_finals,
@@ -475,12 +487,22 @@ edje_match_programs_exec_check_finals(const unsigned int *signal_finals,
                                       void               *data,
                                       Eina_Bool           prop EINA_UNUSED)
 {
+   unsigned int stack[64];
+   unsigned int *matched = stack;
+   unsigned int count = 0;
    unsigned int i;
    unsigned int j;
+   Eina_Bool r = EINA_TRUE;
 
    /* when not enought memory, they could be NULL */
    if (!signal_finals || !source_finals) return EINA_TRUE;
 
+   if (signal_states->size > sizeof (stack) / sizeof (stack[0]))
+     {
+        matched = malloc(signal_states->size * sizeof (unsigned int));
+        if (!matched) return EINA_TRUE;
+     }
+
    for (i = 0; i < signal_states->size; ++i)
      {
         if (signal_states->states[i].pos >= signal_finals[signal_states->states[i].idx])
@@ -490,20 +512,33 @@ edje_match_programs_exec_check_finals(const unsigned int *signal_finals,
                   if (signal_states->states[i].idx == source_states->states[j].idx
                       && source_states->states[j].pos >= source_finals[source_states->states[j].idx])
                     {
-                       Edje_Program  *pr;
-
-                       pr = programs[signal_states->states[i].idx];
-                       if (pr)
-                         {
-                            if (func(pr, data))
-                               return EINA_FALSE;
-                         }
+                       matched[count++] = signal_states->states[i].idx;
+                       break;
                     }
                }
           }
      }
 
-   return EINA_TRUE;
+   qsort(matched, count, sizeof (unsigned int), _edje_match_idx_cmp);
+   for (i = 0; i < count; ++i)
+     {
+        Edje_Program  *pr;
+
+        if (i && (matched[i] == matched[i - 1])) continue;
+
+        pr = programs[matched[i]];
+        if (pr)
+          {
+             if (func(pr, data))
+               {
+                  r = EINA_FALSE;
+                  break;
+               }
+          }
+     }
+
+   if (matched != stack) free(matched);
+   return r;
 }
 
 static int
@@ -881,3 +916,644 @@ edje_match_signal_source_free(Edje_Signal_Source_Char *key, EINA_UNUSED void *da
    eina_inarray_flush(&key->list);
    free(key);
 }
+
+/* Precompiled automata: edje_cc turns the signal and source patterns of
+ * the globbing programs into two DFAs, written next to the collection.
+ * A DFA state is the set of pattern positions the matcher above would
+ * hold after reading the same characters, so both agree on what matches.
+ * A state only keeps the sorted list of the programs it accepts, which is
+ * why both run them in the order of the globbing table. */
+
+#define EDJE_MATCH_AUTOMATON_STATES_MAX 2048
+#define EDJE_MATCH_AUTOMATON_ERROR (EDJE_MATCH_AUTOMATON_DEAD - 1)
+#define EDJE_MATCH_AUTOMATON_HEADER 5
+/* states and classes counts, then the class of each of the 256 bytes */
+#define EDJE_MATCH_AUTOMATON_PREFIX (2 + (256 / sizeof (unsigned int)))
+
+typedef struct _Edje_Match_Item Edje_Match_Item;
+typedef struct _Edje_Match_Set Edje_Match_Set;
+typedef struct _Edje_Match_Builder Edje_Match_Builder;
+
+struct _Edje_Match_Item
+{
+   unsigned int idx;
+   unsigned int pos;
+};
+
+struct _Edje_Match_Set
+{
+   unsigned int    count;
+   Edje_Match_Item items[];
+};
+
+struct _Edje_Match_Builder
+{
+   const char         **patterns;
+   unsigned int        *finals;
+   unsigned int        *offsets; /* of each pattern in the per position arrays */
+   unsigned int        *tokens; /* length of the token at a position, 0 for '*' */
+   unsigned char       *sets; /* bytes the token at a position matches */
+   unsigned char       *has;
+   Edje_Match_Item     *closure;
+   Edje_Match_Item     *next;
+   unsigned int         count;
+
+   unsigned char        classes[256];
+   unsigned char        representatives[256];
+   unsigned int         classes_count;
+
+   Eina_Hash           *states; /* Edje_Match_Set -> state + 1 */
+   Eina_Array          *sets_by_state;
+   Eina_Inarray         transitions;
+   Eina_Inarray         accepts_index;
+   Eina_Inarray         accepts;
+};
+
+#define EDJE_MATCH_SET_HAS(Set, C) ((Set)[(C) >> 3] & (1 << ((C) & 7)))
+#define EDJE_MATCH_SET_ADD(Set, C) ((Set)[(C) >> 3] |= (1 << ((C) & 7)))
+
+/* Same grammar and quirks as _edje_match_patterns_exec_token(), but for
+ * every byte at once. Returns the token length, 0 on a syntax error. */
+static unsigned int
+_edje_match_token_set_get(const char *tok, unsigned char *set)
+{
+   unsigned int pos, b;
+   Eina_Bool neg;
+
+   memset(set, 0, 32);
+   switch (*tok)
+     {
+      case '\\':
+         if (!tok[1]) return 0;
+         EDJE_MATCH_SET_ADD(set, (unsigned char)tok[1]);
+         return 2;
+
+      case '?':
+         for (b = 1; b < 256; b++)
+           EDJE_MATCH_SET_ADD(set, b);
+         return 1;
+
+      case '[':
+         break;
+
+      default:
+         EDJE_MATCH_SET_ADD(set, (unsigned char)*tok);
+         return 1;
+     }
+
+   if (!tok[1]) return 0;
+   neg = (tok[1] == '!');
+   pos = 1 + neg;
+   do
+     {
+        const char *cl = tok + pos;
+
+        if (!*cl) return 0;
+        if ((cl[1] == '-') && (cl[2] != ']'))
+          {
+             if (!cl[2]) return 0;
+             for (b = 1; b < 256; b++)
+               if ((cl[0] <= (char)b) && ((char)b <= cl[2]))
+                 EDJE_MATCH_SET_ADD(set, b);
+             pos += 3;
+          }
+        else
+          {
+             EDJE_MATCH_SET_ADD(set, (unsigned char)*cl);
+             pos += 1;
+          }
+     }
+   while (tok[pos] && (tok[pos] != ']'));
+   if (!tok[pos]) return 0;
+
+   if (neg)
+     {
+        for (b = 0; b < 32; b++)
+          set[b] = ~set[b];
+        set[0] &= ~1;
+     }
+
+   return pos + 1;
+}
+
+/* Refine the byte classes so that the set is a union of classes */
+static void
+_edje_match_classes_split(Edje_Match_Builder *b, const unsigned char *set)
+{
+   unsigned int map[512];
+   unsigned int i, n = 0;
+
+   for (i = 0; i < 512; i++)
+     map[i] = 512;
+   for (i = 0; i < 256; i++)
+     {
+        unsigned int k;
+
+        k = (b->classes[i] * 2) + !!EDJE_MATCH_SET_HAS(set, i);
+        if (map[k] == 512) map[k] = n++;
+        b->classes[i] = map[k];
+     }
+   b->classes_count = n;
+}
+
+static unsigned int
+_edje_match_set_key_length(const void *key)
+{
+   const Edje_Match_Set *set = key;
+
+   return sizeof (Edje_Match_Set) + set->count * sizeof (Edje_Match_Item);
+}
+
+static int
+_edje_match_set_key_cmp(const void *key1, int key1_length,
+                        const void *key2, int key2_length)
+{
+   if (key1_length != key2_length) return key1_length - key2_length;
+   return memcmp(key1, key2, key1_length);
+}
+
+static int
+_edje_match_set_key_hash(const void *key, int key_length)
+{
+   return eina_hash_superfast(key, key_length);
+}
+
+static int
+_edje_match_item_cmp(const void *a, const void *b)
+{
+   const Edje_Match_Item *i1 = a;
+   const Edje_Match_Item *i2 = b;
+
+   if (i1->idx != i2->idx) return i1->idx < i2->idx ? -1 : 1;
+   if (i1->pos != i2->pos) return i1->pos < i2->pos ? -1 : 1;
+   return 0;
+}
+
+static Eina_Bool
+_edje_match_builder_init(Edje_Match_Builder *b, const char **patterns,
+                         unsigned int count)
+{
+   unsigned int i, total = 0;
+
+   memset(b, 0, sizeof (*b));
+   b->patterns = patterns;
+   b->count = count;
+   eina_inarray_step_set(&b->transitions, sizeof (Eina_Inarray), sizeof (unsigned int), 256);
+   eina_inarray_step_set(&b->accepts_index, sizeof (Eina_Inarray), sizeof (unsigned int), 64);
+   eina_inarray_step_set(&b->accepts, sizeof (Eina_Inarray), sizeof (unsigned int), 64);
+
+   b->finals = malloc(count * sizeof (unsigned int));
+   b->offsets = malloc(count * sizeof (unsigned int));
+   if (!b->finals || !b->offsets) return EINA_FALSE;
+   for (i = 0; i < count; i++)
+     {
+        unsigned int j;
+
+        b->offsets[i] = total;
+        b->finals[i] = 0;
+        for (j = 0; patterns[i][j]; j++)
+          if (patterns[i][j] != '*')
+            b->finals[i] = j + 1;
+        total += j + 1;
+     }
+
+   b->tokens = calloc(total, sizeof (unsigned int));
+   b->sets = calloc(total, 32);
+   b->has = calloc(total, 1);
+   b->closure = malloc(total * sizeof (Edje_Match_Item));
+   b->next = malloc(total * sizeof (Edje_Match_Item));
+   b->states = eina_hash_new(EINA_KEY_LENGTH(_edje_match_set_key_length),
+                             EINA_KEY_CMP(_edje_match_set_key_cmp),
+                             EINA_KEY_HASH(_edje_match_set_key_hash),
+                             NULL, 8);
+   b->sets_by_state = eina_array_new(64);
+   if (!b->tokens || !b->sets || !b->has || !b->closure || !b->next ||
+       !b->states || !b->sets_by_state)
+     return EINA_FALSE;
+
+   /* Tokenize everything once, and find which bytes always behave the same */
+   b->classes_count = 1;
+   for (i = 0; i < count; i++)
+     {
+        unsigned int pos = 0;
+
+        while (patterns[i][pos])
+          {
+             unsigned int off = b->offsets[i] + pos;
+
+             if (patterns[i][pos] == '*')
+               {
+                  pos++;
+                  continue;
+               }
+             b->tokens[off] = _edje_match_token_set_get(patterns[i] + pos,
+                                                        b->sets + off * 32);
+             /* the matcher would give up on the whole signal there */
+             if (!b->tokens[off]) return EINA_FALSE;
+             _edje_match_classes_split(b, b->sets + off * 32);
+             pos += b->tokens[off];
+          }
+     }
+   for (i = 256; i > 0; i--)
+     b->representatives[b->classes[i - 1]] = i - 1;
+
+   return EINA_TRUE;
+}
+
+static void
+_edje_match_builder_shutdown(Edje_Match_Builder *b)
+{
+   if (b->states) eina_hash_free(b->states);
+   if (b->sets_by_state)
+     {
+        while (eina_array_count(b->sets_by_state))
+          free(eina_array_pop(b->sets_by_state));
+        eina_array_free(b->sets_by_state);
+     }
+   eina_inarray_flush(&b->transitions);
+   eina_inarray_flush(&b->accepts_index);
+   eina_inarray_flush(&b->accepts);
+   free(b->finals);
+   free(b->offsets);
+   free(b->tokens);
+   free(b->sets);
+   free(b->has);
+   free(b->closure);
+   free(b->next);
+}
+
+static void
+_edje_match_item_add(Edje_Match_Builder *b, Edje_Match_Item *items,
+                     unsigned int *n, unsigned int idx, unsigned int pos)
+{
+   unsigned int off = b->offsets[idx] + pos;
+
+   if (b->has[off]) return;
+   b->has[off] = 1;
+   items[*n].idx = idx;
+   items[*n].pos = pos;
+   (*n)++;
+}
+
+static void
+_edje_match_items_clear(Edje_Match_Builder *b, const Edje_Match_Item *items,
+                        unsigned int n)
+{
+   unsigned int i;
+
+   for (i = 0; i < n; i++)
+     b->has[b->offsets[items[i].idx] + items[i].pos] = 0;
+}
+
+/* Returns the state for those items, adding it if it is new */
+static unsigned int
+_edje_match_state_get(Edje_Match_Builder *b, Edje_Match_Item *items,
+                      unsigned int n)
+{
+   Edje_Match_Set *set;
+   uintptr_t state;
+   unsigned int i, last;
+
+   if (!n) return EDJE_MATCH_AUTOMATON_DEAD;
+
+   qsort(items, n, sizeof (Edje_Match_Item), _edje_match_item_cmp);
+   set = malloc(sizeof (Edje_Match_Set) + n * sizeof (Edje_Match_Item));
+   if (!set) return EDJE_MATCH_AUTOMATON_ERROR;
+   set->count = n;
+   memcpy(set->items, items, n * sizeof (Edje_Match_Item));
+
+   state = (uintptr_t)eina_hash_find(b->states, set);
+   if (state)
+     {
+        free(set);
+        return state - 1;
+     }
+
+   state = eina_array_count(b->sets_by_state);
+   if (state >= EDJE_MATCH_AUTOMATON_STATES_MAX)
+     {
+        free(set);
+        return EDJE_MATCH_AUTOMATON_ERROR;
+     }
+   eina_hash_direct_add(b->states, set, (void *)(state + 1));
+   eina_array_push(b->sets_by_state, set);
+
+   /* the patterns already matched when the string ends here */
+   i = eina_inarray_count(&b->accepts);
+   eina_inarray_push(&b->accepts_index, &i);
+   last = b->count;
+   for (i = 0; i < n; i++)
+     if ((items[i].pos >= b->finals[items[i].idx]) && (items[i].idx != last))
+       {
+          last = items[i].idx;
+          eina_inarray_push(&b->accepts, &last);
+       }
+
+   return state;
+}
+
+static Eina_Bool
+_edje_match_automaton_build(Edje_Match_Builder *b)
+{
+   unsigned int i, n, state;
+
+   n = 0;
+   for (i = 0; i < b->count; i++)
+     _edje_match_item_add(b, b->next, &n, i, 0);
+   _edje_match_items_clear(b, b->next, n);
+   if (_edje_match_state_get(b, b->next, n) != 0) return EINA_FALSE;
+
+   for (state = 0; state < eina_array_count(b->sets_by_state); state++)
+     {
+        const Edje_Match_Set *set = eina_array_data_get(b->sets_by_state, state);
+        unsigned int c, k, m;
+
+        /* a '*' can also match nothing */
+        m = 0;
+        for (i = 0; i < set->count; i++)
+          _edje_match_item_add(b, b->closure, &m, set->items[i].idx, set->items[i].pos);
+        for (i = 0; i < m; i++)
+          if (b->patterns[b->closure[i].idx][b->closure[i].pos] == '*')
+            _edje_match_item_add(b, b->closure, &m, b->closure[i].idx, b->closure[i].pos + 1);
+        _edje_match_items_clear(b, b->closure, m);
+
+        for (c = 0; c < b->classes_count; c++)
+          {
+             unsigned char byte = b->representatives[c];
+             unsigned int next;
+
+             n = 0;
+             for (k = 0; k < m; k++)
+               {
+                  const Edje_Match_Item *it = &b->closure[k];
+                  unsigned int off = b->offsets[it->idx] + it->pos;
+                  char ch = b->patterns[it->idx][it->pos];
+
+                  if (!ch) continue;
+                  if (ch == '*')
+                    _edje_match_item_add(b, b->next, &n, it->idx, it->pos);
+                  else if (byte && EDJE_MATCH_SET_HAS(b->sets + off * 32, byte))
+                    _edje_match_item_add(b, b->next, &n, it->idx, it->pos + b->tokens[off]);
+               }
+             _edje_match_items_clear(b, b->next, n);
+
+             next = _edje_match_state_get(b, b->next, n);
+             if (next == EDJE_MATCH_AUTOMATON_ERROR) return EINA_FALSE;
+             eina_inarray_push(&b->transitions, &next);
+          }
+     }
+
+   i = eina_inarray_count(&b->accepts);
+   eina_inarray_push(&b->accepts_index, &i);
+
+   return EINA_TRUE;
+}
+
+static unsigned int
+_edje_match_automaton_size(const Edje_Match_Builder *b)
+{
+   return EDJE_MATCH_AUTOMATON_PREFIX +
+     eina_inarray_count(&b->transitions) +
+     eina_inarray_count(&b->accepts_index) +
+     eina_inarray_count(&b->accepts);
+}
+
+static void
+_edje_match_automaton_write(const Edje_Match_Builder *b, unsigned int *w)
+{
+   unsigned int n;
+
+   w[0] = eina_array_count(b->sets_by_state);
+   w[1] = b->classes_count;
+   memcpy(w + 2, b->classes, 256);
+   w += EDJE_MATCH_AUTOMATON_PREFIX;
+
+   n = eina_inarray_count(&b->transitions);
+   if (n) memcpy(w, b->transitions.members, n * sizeof (unsigned int));
+   w += n;
+   n = eina_inarray_count(&b->accepts_index);
+   memcpy(w, b->accepts_index.members, n * sizeof (unsigned int));
+   w += n;
+   n = eina_inarray_count(&b->accepts);
+   if (n) memcpy(w, b->accepts.members, n * sizeof (unsigned int));
+}
+
+static unsigned int
+_edje_match_programs_hash(Edje_Program * const *programs, unsigned int count)
+{
+   unsigned int h = 5381;
+   unsigned int i;
+
+   for (i = 0; i < count; i++)
+     {
+        const char *s;
+
+        for (s = programs[i]->signal ? programs[i]->signal : ""; *s; s++)
+          h = (h * 33) ^ (unsigned char)*s;
+        h = h * 33;
+        for (s = programs[i]->source ? programs[i]->source : ""; *s; s++)
+          h = (h * 33) ^ (unsigned char)*s;
+        h = h * 33;
+     }
+
+   return h ^ count;
+}
+
+EAPI void *
+edje_match_programs_automata_build(Edje_Program * const *programs,
+                                   unsigned int count, int *size)
+{
+   Edje_Match_Builder signals, sources;
+   const char **patterns;
+   unsigned int *r = NULL;
+   unsigned int i, words;
+
+   *size = 0;
+   if (!count) return NULL;
+
+   memset(&signals, 0, sizeof (signals));
+   memset(&sources, 0, sizeof (sources));
+
+   patterns = malloc(2 * count * sizeof (char *));
+   if (!patterns) return NULL;
+   for (i = 0; i < count; i++)
+     {
+        patterns[i] = programs[i]->signal ? programs[i]->signal : "";
+        patterns[count + i] = programs[i]->source ? programs[i]->source : "";
+     }
+
+   if (!_edje_match_builder_init(&signals, patterns, count) ||
+       !_edje_match_builder_init(&sources, patterns + count, count) ||
+       !_edje_match_automaton_build(&signals) ||
+       !_edje_match_automaton_build(&sources))
+     goto end;
+
+   words = EDJE_MATCH_AUTOMATON_HEADER +
+     _edje_match_automaton_size(&signals) +
+     _edje_match_automaton_size(&sources);
+   r = malloc(words * sizeof (unsigned int));
+   if (!r) goto end;
+
+   r[0] = EDJE_MATCH_AUTOMATON_MAGIC;
+   r[1] = count;
+   r[2] = _edje_match_programs_hash(programs, count);
+   r[3] = EDJE_MATCH_AUTOMATON_HEADER;
+   r[4] = r[3] + _edje_match_automaton_size(&signals);
+   _edje_match_automaton_write(&signals, r + r[3]);
+   _edje_match_automaton_write(&sources, r + r[4]);
+   *size = words * sizeof (unsigned int);
+
+ end:
+   _edje_match_builder_shutdown(&signals);
+   _edje_match_builder_shutdown(&sources);
+   free(patterns);
+   return r;
+}
+
+static Eina_Bool
+_edje_match_automaton_map(Edje_Match_Automaton *a, const unsigned int *w,
+                          unsigned int words, unsigned int offset,
+                          unsigned int count)
+{
+   unsigned long long transitions;
+   unsigned int i;
+
+   if ((offset > words) || (words - offset < EDJE_MATCH_AUTOMATON_PREFIX))
+     return EINA_FALSE;
+   a->states_count = w[offset];
+   a->classes_count = w[offset + 1];
+   if (!a->states_count || !a->classes_count || (a->classes_count > 256))
+     return EINA_FALSE;
+   a->classes = (const unsigned char *)(w + offset + 2);
+   offset += EDJE_MATCH_AUTOMATON_PREFIX;
+
+   transitions = (unsigned long long)a->states_count * a->classes_count;
+   if (transitions + a->states_count + 1 > words - offset) return EINA_FALSE;
+   a->transitions = w + offset;
+   a->accepts_index = a->transitions + transitions;
+   a->accepts = a->accepts_index + a->states_count + 1;
+   offset += transitions + a->states_count + 1;
+
+   for (i = 0; i < 256; i++)
+     if (a->classes[i] >= a->classes_count) return EINA_FALSE;
+   for (i = 0; i < transitions; i++)
+     if ((a->transitions[i] >= a->states_count) &&
+         (a->transitions[i] != EDJE_MATCH_AUTOMATON_DEAD))
+       return EINA_FALSE;
+   for (i = 0; i < a->states_count; i++)
+     if (a->accepts_index[i] > a->accepts_index[i + 1]) return EINA_FALSE;
+   if ((a->accepts_index[0] != 0) ||
+       (a->accepts_index[a->states_count] > words - offset))
+     return EINA_FALSE;
+   for (i = 0; i < a->accepts_index[a->states_count]; i++)
+     if (a->accepts[i] >= count) return EINA_FALSE;
+
+   return EINA_TRUE;
+}
+
+Edje_Match_Automata *
+edje_match_programs_automata_load(const void *data, int size, Eina_Bool owned,
+                                  Edje_Program * const *programs,
+                                  unsigned int count)
+{
+   Edje_Match_Automata *ma;
+   const unsigned int *w = data;
+   void *copy = NULL;
+   unsigned int words;
+
+   if ((size <= 0) || (size % sizeof (unsigned int))) return NULL;
+   words = size / sizeof (unsigned int);
+   if (words < EDJE_MATCH_AUTOMATON_HEADER) return NULL;
+
+   /* Used straight from the mapped file when it is aligned enough */
+   if (!owned && ((uintptr_t)data % sizeof (unsigned int)))
+     {
+        copy = malloc(size);
+        if (!copy) return NULL;
+        memcpy(copy, data, size);
+        w = copy;
+     }
+
+   /* Another endianness, or the programs changed since it was written */
+   if ((w[0] != EDJE_MATCH_AUTOMATON_MAGIC) || (w[1] != count) ||
+       (w[2] != _edje_match_programs_hash(programs, count)))
+     goto on_error;
+
+   ma = calloc(1, sizeof (Edje_Match_Automata));
+   if (!ma) goto on_error;
+   if (!_edje_match_automaton_map(&ma->signals, w, words, w[3], count) ||
+       !_edje_match_automaton_map(&ma->sources, w, words, w[4], count))
+     {
+        free(ma);
+        goto on_error;
+     }
+   ma->data = owned ? (void *)data : copy;
+
+   return ma;
+
+ on_error:
+   free(copy);
+   return NULL;
+}
+
+void
+edje_match_automata_free(Edje_Match_Automata *ma)
+{
+   if (!ma) return;
+   free(ma->data);
+   free(ma);
+}
+
+static unsigned int
+_edje_match_automaton_run(const Edje_Match_Automaton *a, const char *string)
+{
+   const unsigned char *c;
+   unsigned int state = 0;
+
+   for (c = (const unsigned char *)string; *c; c++)
+     {
+        state = a->transitions[state * a->classes_count + a->classes[*c]];
+        if (state == EDJE_MATCH_AUTOMATON_DEAD) break;
+     }
+
+   return state;
+}
+
+Eina_Bool
+edje_match_programs_automata_exec(const Edje_Match_Automata *ma,
+                                  const char *sig,
+                                  const char *source,
+                                  Edje_Program **programs,
+                                  Eina_Bool (*func)(Edje_Program *pr, void *data),
+                                  void *data)
+{
+   unsigned int sig_state, src_state;
+   unsigned int i, j, ie, je;
+
+   sig_state = _edje_match_automaton_run(&ma->signals, sig);
+   if (sig_state == EDJE_MATCH_AUTOMATON_DEAD) return EINA_TRUE;
+   src_state = _edje_match_automaton_run(&ma->sources, source);
+   if (src_state == EDJE_MATCH_AUTOMATON_DEAD) return EINA_TRUE;
+
+   /* both lists are sorted, the programs are the ones in both */
+   i = ma->signals.accepts_index[sig_state];
+   ie = ma->signals.accepts_index[sig_state + 1];
+   j = ma->sources.accepts_index[src_state];
+   je = ma->sources.accepts_index[src_state + 1];
+   while ((i < ie) && (j < je))
+     {
+        unsigned int idx = ma->signals.accepts[i];
+
+        if (idx < ma->sources.accepts[j]) i++;
+        else if (idx > ma->sources.accepts[j]) j++;
+        else
+          {
+             if (programs[idx] && func(programs[idx], data))
+               return EINA_FALSE;
+             i++;
+             j++;
+          }
+     }
+
+   return EINA_TRUE;
+}
@@ -334,6 +334,8 @@ typedef struct _Edje_Signal_Source_Char Edje_Signal_Source_Char;
 typedef struct _Edje_Text_Insert_Filter_Callback Edje_Text_Insert_Filter_Callback;
 typedef struct _Edje_Markup_Filter_Callback Edje_Markup_Filter_Callback;
 typedef struct _Edje_Signals_Sources_Patterns Edje_Signals_Sources_Patterns;
+typedef struct _Edje_Match_Automaton Edje_Match_Automaton;
+typedef struct _Edje_Match_Automata Edje_Match_Automata;
 typedef struct _Edje_Signal_Callback_Flags Edje_Signal_Callback_Flags;
 typedef struct _Edje_Signal_Callback_Group Edje_Signal_Callback_Group;
 typedef struct _Edje_Signal_Callback_Match Edje_Signal_Callback_Match;
@@ -937,7 +939,17 @@ struct _Edje_Part_Collection
 
       Edje_Program **table_programs;
       int            table_programs_size;
+
+      Edje_Match_Automata *automata; /* the globbing programs, precompiled by edje_cc */
    } patterns;
+
+   struct {
+      unsigned int  *order; /* parts sorted so each comes after the parts it depends on */
+      unsigned int  *dependents_index; /* parts_count + 1 offsets in dependents */
+      unsigned int  *dependents; /* parts that depend on a part, by dependents_index */
+      unsigned int   count; /* parts_count the graph was built for */
+      Eina_Bool      cyclic; /* a dependency loop, order is not usable */
+   } calc_graph;
    /* *** *** */
 
    unsigned char    script_only;
@@ -1806,6 +1818,27 @@ struct _Edje_Patterns
    unsigned int    finals[];
 };
 
+#define EDJE_MATCH_AUTOMATON_MAGIC 0x45444d31 /* "EDM1" in the byte order of the writer */
+#define EDJE_MATCH_AUTOMATON_DEAD 0xffffffff
+
+/* A DFA over a set of patterns, as written in the .edj */
+struct _Edje_Match_Automaton
+{
+   const unsigned char *classes; /* character class of each byte */
+   const unsigned int  *transitions; /* states_count x classes_count */
+   const unsigned int  *accepts_index; /* states_count + 1 offsets in accepts */
+   const unsigned int  *accepts; /* sorted patterns matched in each state */
+   unsigned int         states_count;
+   unsigned int         classes_count;
+};
+
+struct _Edje_Match_Automata
+{
+   Edje_Match_Automaton signals;
+   Edje_Match_Automaton sources;
+   void                *data; /* only set when not used in place from the file */
+};
+
 typedef enum _Edje_User_Defined_Type 
 {
    EDJE_USER_SWALLOW,
@@ -1895,6 +1928,21 @@ int edje_match_callback_exec(const Edje_Signals_Sources_Patterns *ssp,
 
 void             edje_match_patterns_free(Edje_Patterns *ppat);
 
+EAPI void           *edje_match_programs_automata_build(Edje_Program * const *programs,
+                                                        unsigned int count,
+                                                        int *size);
+Edje_Match_Automata *edje_match_programs_automata_load(const void *data, int size,
+                                                       Eina_Bool owned,
+                                                       Edje_Program * const *programs,
+                                                       unsigned int count);
+Eina_Bool            edje_match_programs_automata_exec(const Edje_Match_Automata *ma,
+                                                       const char *signal,
+                                                       const char *source,
+                                                       Edje_Program **programs,
+                                                       Eina_Bool (*func)(Edje_Program *pr, void *data),
+                                                       void *data);
+void                 edje_match_automata_free(Edje_Match_Automata *ma);
+
 Eina_List *edje_match_program_hash_build(Edje_Program * const * programs,
 					 unsigned int count,
 					 Eina_Rbtree **tree);
@@ -2014,6 +2062,8 @@ void  _edje_program_end(Edje *ed, Edje_Running_Program *runp);
 void  _edje_program_run(Edje *ed, Edje_Program *pr, Eina_Bool force, const char *ssig, const char *ssrc);
 void _edje_programs_patterns_clean(Edje_Part_Collection *ed);
 void _edje_programs_patterns_init(Edje_Part_Collection *ed);
+EAPI Edje_Program **_edje_programs_globing_get(Edje_Part_Collection *edc, unsigned int *count);
+EAPI Eina_Bool _edje_programs_automata_write(Eet_File *ef, Edje_Part_Collection *edc);
 void  _edje_emit(Edje *ed, const char *sig, const char *src);
 void _edje_emit_full(Edje *ed, const char *sig, const char *src, void *data, void (*free_func)(void *));
 void _edje_emit_handle(Edje *ed, const char *sig, const char *src, Edje_Message_Signal_Data *data, Eina_Bool prop);
@@ -2432,6 +2482,8 @@ Eina_Bool _edje_multisense_internal_sound_sample_play(Edje *ed, const char *samp
 Eina_Bool _edje_multisense_internal_sound_tone_play(Edje *ed, const char *tone_name, const double duration, int channel);
 
 void _edje_part_recalc(Edje *ed, Edje_Real_Part *ep, int flags, Edje_Calc_Params *state);
+void _edje_calc_graph_build(Edje_Part_Collection *edc);
+void _edje_calc_graph_free(Edje_Part_Collection *edc);
 
 void _edje_user_definition_remove(Edje_User_Defined *eud, Evas_Object *child);
 void _edje_user_definition_free(Edje_User_Defined *eud);
@@ -1321,7 +1321,17 @@ _edje_emit_handle(Edje *ed, const char *sig, const char *src,
 #endif
                   Edje_Program *pr;
 
-                  if (ed->collection->patterns.programs.u.programs.globing)
+                  if (ed->collection->patterns.automata)
+                    {
+                       if (edje_match_programs_automata_exec(ed->collection->patterns.automata,
+                                                             sig,
+                                                             src,
+                                                             ed->collection->patterns.programs.u.programs.globing,
+                                                             _edje_glob_callback,
+                                                             &data) == 0)
+                         goto break_prog;
+                    }
+                  else if (ed->collection->patterns.programs.u.programs.globing)
                     if (edje_match_programs_exec(ed->collection->patterns.programs.signals_patterns,
                                                  ed->collection->patterns.programs.sources_patterns,
                                                  sig,
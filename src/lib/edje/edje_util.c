@@ -3932,6 +3932,9 @@ _calc_force(Eo *obj EINA_UNUSED, void *_pd, va_list *list EINA_UNUSED)
 #ifdef EDJE_CALC_CACHE
    ed->all_part_change = EINA_TRUE;
 #endif
+   /* edje_edit changes the relations between parts and then forces a
+    * calc, pick them up next time */
+   if (ed->collection) _edje_calc_graph_free(ed->collection);
 
    pf2 = _edje_freeze_val;
    pf = ed->freeze;
@@ -649,6 +649,100 @@ eet_close(Eet_File *ef);
 EAPI Eet_Error
 eet_sync(Eet_File *ef);
 
+/**
+ * Set whether flushing an eet file appends to it instead of rewriting it.
+ * @param ef A valid eet file handle opened for writing.
+ * @param append EINA_TRUE to append, EINA_FALSE to rewrite (default).
+ * @return An eet error identifier.
+ *
+ * By default every eet_sync() or eet_close() writes the whole file again,
+ * which gets expensive when a big file only sees a few small updates. In
+ * append mode only the entries written since the last flush, followed by
+ * a new directory, are added at the end of the file and its header is
+ * then pointed at that directory. The previous versions of rewritten and
+ * deleted entries stay in the file until eet_compact() is called.
+ *
+ * The first flush of a file that was not written in the indexed layout
+ * (see eet_indexed_set()), or of a signed file, is still a full rewrite.
+ *
+ * The header is rewritten in place, under a lock that eet_open() in other
+ * processes waits for, so they never see half of it. Those that opened
+ * the file earlier keep reading what it held then. When another process
+ * is opening or appending to the file at the time of the flush, it is a
+ * full rewrite too.
+ *
+ * @see eet_compact()
+ *
+ * @since 1.10
+ * @ingroup Eet_File_Group
+ */
+EAPI Eet_Error
+eet_append_set(Eet_File *ef, Eina_Bool append);
+
+/**
+ * Tell whether flushing an eet file appends to it.
+ * @param ef A valid eet file handle.
+ * @return EINA_TRUE if flushes append, EINA_FALSE otherwise.
+ *
+ * @see eet_append_set()
+ *
+ * @since 1.10
+ * @ingroup Eet_File_Group
+ */
+EAPI Eina_Bool
+eet_append_get(Eet_File *ef);
+
+/**
+ * Set whether an eet file is written with a hashed index.
+ * @param ef A valid eet file handle opened for writing.
+ * @param indexed EINA_TRUE for the indexed layout, EINA_FALSE for the
+ *        classic one (default).
+ * @return An eet error identifier.
+ *
+ * The indexed layout lets eet_open() find entries without building a hash
+ * of the whole directory, and is needed to append to a file, so
+ * eet_append_set() turns it on. Files in that layout can't be read by eet
+ * versions older than 1.10, which is why it isn't the default. A file that
+ * was read in the indexed layout keeps it when rewritten.
+ *
+ * @see eet_append_set()
+ *
+ * @since 1.10
+ * @ingroup Eet_File_Group
+ */
+EAPI Eet_Error
+eet_indexed_set(Eet_File *ef, Eina_Bool indexed);
+
+/**
+ * Tell whether an eet file is written with a hashed index.
+ * @param ef A valid eet file handle.
+ * @return EINA_TRUE if it is, EINA_FALSE otherwise.
+ *
+ * @see eet_indexed_set()
+ *
+ * @since 1.10
+ * @ingroup Eet_File_Group
+ */
+EAPI Eina_Bool
+eet_indexed_get(Eet_File *ef);
+
+/**
+ * Rewrite an eet file, reclaiming the space left by appends.
+ * @param ef A valid eet file handle opened for writing.
+ * @return An eet error identifier.
+ *
+ * This function writes the current content of the file in one go, like
+ * eet_sync() does out of append mode, even if nothing changed. The append
+ * mode of @p ef is left as it was.
+ *
+ * @see eet_append_set()
+ *
+ * @since 1.10
+ * @ingroup Eet_File_Group
+ */
+EAPI Eet_Error
+eet_compact(Eet_File *ef);
+
 /**
  * Return a handle to the shared string dictionary of the Eet file
  * @param ef A valid eet file handle.
@@ -32,6 +32,8 @@ struct _Eet_String
    int           len;
 
    int           next;
+
+   unsigned int  offset; /* position in the file, 0 until written */
 };
 struct _Eet_Dictionary
 {
@@ -97,6 +99,9 @@ struct _Eet_File
    unsigned char        writes_pending : 1;
    unsigned char        delete_me_now : 1;
    unsigned char        readfp_owned : 1;
+   unsigned char        append : 1;
+   unsigned char        appendable : 1;
+   unsigned char        indexed : 1;
 };
 
 struct _Eet_File_Header
@@ -109,6 +114,16 @@ struct _Eet_File_Directory
 {
    int             size;
    Eet_File_Node **nodes;
+
+   /* on-disk index of a version 4 file, nodes are only created on lookup */
+   const int         *index;
+   const int         *entries;
+   unsigned char     *loaded;
+   unsigned long int  tables_offset;
+   unsigned long int  tables_end;
+   unsigned int       index_size;
+   unsigned int       count;
+   unsigned int       pending;
 };
 
 struct _Eet_File_Node
@@ -118,6 +133,7 @@ struct _Eet_File_Node
    Eet_File_Node    *next; /* FIXME: make buckets linked lists */
 
    unsigned int      offset;
+   unsigned int      name_offset; /* 0 until the name is in the file */
    unsigned int      name_size;
    unsigned int      size;
    unsigned int      data_size;
@@ -128,6 +144,7 @@ struct _Eet_File_Node
    unsigned char     compression : 1;
    unsigned char     ciphered : 1;
    unsigned char     alias : 1;
+   unsigned char     on_disk : 1; /* data at offset is up to date */
 };
 
 #if 0
@@ -186,6 +203,45 @@ char signature[signature_length]; /* The signature. */
 char x509[x509_length]; /* The public certificate. */
 #endif /* if 0 */
 
+#if 0
+/* Version 4 */
+/* NB: all int's are stored in network byte order on disk */
+/* file format: */
+int magic; /* magic number ie 0x1ee70f43 */
+int num_directory_entries; /* number of directory entries in the tables */
+int num_dictionary_entries; /* number of dictionary entries in the tables */
+int index_size; /* log2 of the number of index buckets */
+int signature_offset; /* end of the eet content, where a signature may start */
+int tables_offset; /* where the tables start, int aligned */
+/* the tables, right after the header when the file is written in one go,
+ * or at the end of the last append otherwise: */
+int index[1 << index_size]; /* first directory entry of each bucket or -1,
+                               buckets are an unseeded djb2 of the name */
+struct
+{
+   int data_offset; /* bytes offset into file for data chunk */
+   int size; /* size of the data chunk */
+   int data_size; /* size of the (uncompressed) data chunk */
+   int name_offset; /* bytes offset into file for name string */
+   int name_size; /* length in bytes of the name field */
+   int flags; /* same bit flags as version 3 */
+   int next; /* next directory entry in the same bucket or -1 */
+} directory[num_directory_entries];
+struct
+{
+   int hash;
+   int offset;
+   int size;
+   int prev;
+   int next;
+} dictionary[num_dictionary_entries];
+/* names, strings and data can be anywhere between the header and
+ * signature_offset outside of the tables. A full write lays them out
+ * like version 3, an append adds the changed ones before the new tables
+ * and leaves the previous ones unreferenced until the file is compacted.
+ * Signed files are always written in one go. */
+#endif /* if 0 */
+
 /*
  * variable and macros used for the eina_log module
  */
@@ -252,6 +308,8 @@ eet_dictionary_string_get_hash(const Eet_Dictionary *ed,
 
 int _eet_hash_gen(const char *key,
                   int hash_size);
+unsigned int _eet_hash_index_gen(const char *key,
+                                 int         len);
 
 const void *
 eet_identity_check(const void *data_base,
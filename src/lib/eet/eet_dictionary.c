@@ -157,6 +157,7 @@ eet_dictionary_string_add(Eet_Dictionary *ed,
 
    current->str = str;
    current->len = len;
+   current->offset = 0;
 
    if (idx == -1)
      {
@@ -74,6 +74,18 @@ EAPI Eet_Version *eet_version = &_version;
 #define EET_FILE2_DICTIONARY_ENTRY_SIZE  (sizeof(int) * \
                                           EET_FILE2_DICTIONARY_ENTRY_COUNT)
 
+#define EET_MAGIC_FILE3       0x1ee70f43
+
+#define EET_FILE3_HEADER_COUNT           6
+#define EET_FILE3_DIRECTORY_ENTRY_COUNT  7
+#define EET_FILE3_INDEX_SIZE_MIN         4
+#define EET_FILE3_INDEX_SIZE_MAX         24
+
+#define EET_FILE3_HEADER_SIZE            (sizeof(int) * \
+                                          EET_FILE3_HEADER_COUNT)
+#define EET_FILE3_DIRECTORY_ENTRY_SIZE   (sizeof(int) * \
+                                          EET_FILE3_DIRECTORY_ENTRY_COUNT)
+
 /* prototypes of internal calls */
 static Eet_File *
 eet_cache_find(const char *path,
@@ -315,21 +327,371 @@ eet_string_match(const char *s1,
     return !strcmp(s1, s2);
 }
 
-/* flush out writes to a v2 eet file */
+/* lock the first size bytes of fd, all of it for 0, or unlock them with
+ * F_UNLCK. Closing any descriptor of the file drops the lock too. */
+static Eina_Bool
+eet_file_lock(int       fd,
+              short     type,
+              off_t     size,
+              Eina_Bool wait)
+{
+   struct flock fl;
+   int ret;
+
+   memset(&fl, 0, sizeof (fl));
+   fl.l_type = type;
+   fl.l_whence = SEEK_SET;
+   fl.l_start = 0;
+   fl.l_len = size;
+
+   do
+     ret = fcntl(fd, wait ? F_SETLKW : F_SETLK, &fl);
+   while ((ret != 0) && (errno == EINTR));
+
+   return ret == 0;
+}
+
+/* size the on-disk index for about one entry per bucket */
+static int
+eet_flush_index_size(int num_directory_entries)
+{
+   int index_size;
+
+   for (index_size = EET_FILE3_INDEX_SIZE_MIN;
+        (index_size < EET_FILE3_INDEX_SIZE_MAX) &&
+        ((1 << index_size) < num_directory_entries);
+        index_size++)
+     ;
+
+   return index_size;
+}
+
+/* map the write error of fp to an eet error */
+static Eet_Error
+eet_flush_error(FILE *fp)
+{
+   if (!ferror(fp))
+     return EET_ERROR_WRITE_ERROR;
+
+   switch (errno)
+     {
+      case EFBIG: return EET_ERROR_WRITE_ERROR_FILE_TOO_BIG;
+
+      case EIO: return EET_ERROR_WRITE_ERROR_IO_ERROR;
+
+      case ENOSPC: return EET_ERROR_WRITE_ERROR_OUT_OF_SPACE;
+
+      case EPIPE: return EET_ERROR_WRITE_ERROR_FILE_CLOSED;
+
+      default: return EET_ERROR_WRITE_ERROR;
+     }
+}
+
+/* write the index (indexed files only), directory and dictionary at the
+ * current position of fp, pointing at the offsets already given to every
+ * node and dictionary string */
+static Eet_Error
+eet_flush_tables(Eet_File *ef,
+                 FILE     *fp,
+                 int       num_directory_entries,
+                 int       index_size)
+{
+   Eet_File_Node *efn;
+   Eet_Error error = EET_ERROR_NONE;
+   int *index = NULL;
+   int *chain = NULL;
+   int num;
+   int i;
+   int j;
+
+   num = (1 << ef->header->directory->size);
+   if (ef->indexed)
+     {
+        index = malloc(sizeof (int) * (1 << index_size));
+        chain = malloc(sizeof (int) * (num_directory_entries + 1));
+        if ((!index) || (!chain))
+          {
+             error = EET_ERROR_WRITE_ERROR;
+             goto on_error;
+          }
+
+        /* chain the entries of each bucket in directory order */
+        memset(index, 0xff, sizeof (int) * (1 << index_size));
+        for (i = 0, j = 0; i < num; i++)
+          {
+             for (efn = ef->header->directory->nodes[i]; efn; efn = efn->next, j++)
+               {
+                  int bucket;
+
+                  bucket = _eet_hash_index_gen(efn->name, efn->name_size - 1) &
+                    ((1 << index_size) - 1);
+                  chain[j] = index[bucket];
+                  index[bucket] = j;
+               }
+          }
+
+        /* write the bucket heads of the index */
+        for (i = 0; i < (1 << index_size); i++)
+          index[i] = (int)htonl((unsigned int)index[i]);
+        if (fwrite(index, sizeof (int) * (1 << index_size), 1, fp) != 1)
+          goto write_error;
+     }
+
+   /* write directories entry, only indexed ones have the chain */
+   for (i = 0, j = 0; i < num; i++)
+     {
+        for (efn = ef->header->directory->nodes[i]; efn; efn = efn->next, j++)
+          {
+             unsigned int flag;
+             int ibuf[EET_FILE3_DIRECTORY_ENTRY_COUNT];
+
+             flag = (efn->alias << 2) | (efn->ciphered << 1) | efn->compression;
+             flag |= efn->compression_type << 3;
+
+             ibuf[0] = (int)htonl((unsigned int)efn->offset);
+             ibuf[1] = (int)htonl((unsigned int)efn->size);
+             ibuf[2] = (int)htonl((unsigned int)efn->data_size);
+             ibuf[3] = (int)htonl((unsigned int)efn->name_offset);
+             ibuf[4] = (int)htonl((unsigned int)efn->name_size);
+             ibuf[5] = (int)htonl((unsigned int)flag);
+             if (ef->indexed)
+               ibuf[6] = (int)htonl((unsigned int)chain[j]);
+
+             if (fwrite(ibuf, ef->indexed ? EET_FILE3_DIRECTORY_ENTRY_SIZE :
+                        EET_FILE2_DIRECTORY_ENTRY_SIZE, 1, fp) != 1)
+               goto write_error;
+          }
+     }
+
+   /* write dictionary */
+   if (ef->ed)
+     {
+        for (j = 0; j < ef->ed->count; ++j)
+          {
+             int sbuf[EET_FILE2_DICTIONARY_ENTRY_COUNT];
+	     int prev = 0;
+
+             // We still use the prev as an hint for knowing if it is the head of the hash
+	     if (ef->ed->hash[ef->ed->all_hash[j]] == j)
+	       prev = -1;
+
+             sbuf[0] = (int)htonl((unsigned int)ef->ed->all_hash[j]);
+             sbuf[1] = (int)htonl((unsigned int)ef->ed->all[j].offset);
+             sbuf[2] = (int)htonl((unsigned int)ef->ed->all[j].len);
+             sbuf[3] = (int)htonl((unsigned int)prev);
+             sbuf[4] = (int)htonl((unsigned int)ef->ed->all[j].next);
+
+             if (fwrite(sbuf, sizeof (sbuf), 1, fp) != 1)
+               goto write_error;
+          }
+     }
+
+   free(index);
+   free(chain);
+   return EET_ERROR_NONE;
+
+write_error:
+   error = eet_flush_error(fp);
+on_error:
+   free(index);
+   free(chain);
+   return error;
+}
+
+/* write the header at the start of fp, the last three fields only exist
+ * in indexed files */
+static Eet_Error
+eet_flush_header(Eet_File    *ef,
+                 FILE        *fp,
+                 int          num_directory_entries,
+                 int          num_dictionary_entries,
+                 int          index_size,
+                 unsigned int signature_offset,
+                 unsigned int tables_offset)
+{
+   int head[EET_FILE3_HEADER_COUNT];
+   size_t size;
+
+   head[0] = (int)htonl((unsigned int)(ef->indexed ? EET_MAGIC_FILE3 :
+                                       EET_MAGIC_FILE2));
+   head[1] = (int)htonl((unsigned int)num_directory_entries);
+   head[2] = (int)htonl((unsigned int)num_dictionary_entries);
+   head[3] = (int)htonl((unsigned int)index_size);
+   head[4] = (int)htonl(signature_offset);
+   head[5] = (int)htonl(tables_offset);
+   size = ef->indexed ? EET_FILE3_HEADER_SIZE : EET_FILE2_HEADER_SIZE;
+
+   if ((fseek(fp, 0, SEEK_SET) != 0) ||
+       (fwrite(head, size, 1, fp) != 1))
+     return eet_flush_error(fp);
+
+   return EET_ERROR_NONE;
+}
+
+/* append the entries, names and strings changed since the last flush to
+ * an indexed (v3 magic) eet file, followed by fresh tables, and only then
+ * point the header at them. Until the header is rewritten the file still
+ * describes its previous content.
+ *
+ * The header is rewritten in place, on the inode others may have mapped.
+ * That is fine for whoever has already read it, but not for a process
+ * reading it at the same time, so all of this is done under a write lock
+ * on the file, and eet_internal_read3() reads the header under a read
+ * lock. When the lock can't be had right away, another process is
+ * opening or appending to the file, and it is rewritten as a new file
+ * instead, which leaves the one they have untouched. */
+static Eet_Error
+eet_flush_append(Eet_File *ef)
+{
+   static const char pad[sizeof (int)] = { 0 };
+   Eet_File_Node *efn;
+   FILE *fp;
+   Eet_Error error;
+   long offset;
+   long tables_offset;
+   int num_directory_entries = 0;
+   int num_dictionary_entries = 0;
+   int index_size;
+   int num;
+   int fd;
+   int i;
+   int j;
+
+   fd = open(ef->path, O_RDWR | O_BINARY);
+   if (fd < 0)
+     return EET_ERROR_NOT_WRITABLE;
+
+   fp = fdopen(fd, "r+b");
+   if (!fp)
+     {
+        close(fd);
+        return EET_ERROR_NOT_WRITABLE;
+     }
+
+   fcntl(fd, F_SETFD, FD_CLOEXEC);
+
+   /* released when fp is closed */
+   if (!eet_file_lock(fd, F_WRLCK, 0, EINA_FALSE))
+     {
+        fclose(fp);
+        ef->appendable = 0;
+        return eet_flush2(ef);
+     }
+
+   if (fseek(fp, 0, SEEK_END) != 0)
+     goto write_error;
+   offset = ftell(fp);
+   if (offset < (long)EET_FILE3_HEADER_SIZE)
+     goto write_error;
+
+   /* append data and names that are not in the file yet */
+   num = (1 << ef->header->directory->size);
+   for (i = 0; i < num; i++)
+     {
+        for (efn = ef->header->directory->nodes[i]; efn; efn = efn->next)
+          {
+             num_directory_entries++;
+
+             if (!efn->on_disk)
+               {
+                  if (fwrite(efn->data, efn->size, 1, fp) != 1)
+                    goto write_error;
+                  efn->offset = offset;
+                  efn->on_disk = 1;
+                  offset += efn->size;
+               }
+
+             if (!efn->name_offset)
+               {
+                  if (fwrite(efn->name, efn->name_size, 1, fp) != 1)
+                    goto write_error;
+                  efn->name_offset = offset;
+                  offset += efn->name_size;
+               }
+          }
+     }
+
+   /* and the strings added to the dictionary since then */
+   if (ef->ed)
+     {
+        num_dictionary_entries = ef->ed->count;
+
+        for (j = 0; j < ef->ed->count; ++j)
+          {
+             if (ef->ed->all[j].offset) continue;
+
+             if (fwrite(ef->ed->all[j].str, ef->ed->all[j].len, 1, fp) != 1)
+               goto write_error;
+             ef->ed->all[j].offset = offset;
+             offset += ef->ed->all[j].len;
+          }
+     }
+
+   /* the tables are read as int straight from the map */
+   if (offset % sizeof (int))
+     {
+        int padding = sizeof (int) - offset % sizeof (int);
+
+        if (fwrite(pad, padding, 1, fp) != 1)
+          goto write_error;
+        offset += padding;
+     }
+
+   tables_offset = offset;
+   index_size = eet_flush_index_size(num_directory_entries);
+   error = eet_flush_tables(ef, fp, num_directory_entries, index_size);
+   if (error != EET_ERROR_NONE)
+     goto on_error;
+   offset += sizeof (int) * (1 << index_size) +
+     EET_FILE3_DIRECTORY_ENTRY_SIZE * num_directory_entries +
+     EET_FILE2_DICTIONARY_ENTRY_SIZE * num_dictionary_entries;
+
+   /* everything the new tables point at has to be there first */
+   if (fflush(fp) != 0)
+     goto write_error;
+
+   error = eet_flush_header(ef, fp, num_directory_entries,
+                            num_dictionary_entries, index_size, offset,
+                            tables_offset);
+   if (error != EET_ERROR_NONE)
+     goto on_error;
+
+   if (fclose(fp) != 0)
+     {
+        ef->appendable = 0;
+        return EET_ERROR_WRITE_ERROR;
+     }
+
+   /* no more writes pending */
+   ef->writes_pending = 0;
+
+   return EET_ERROR_NONE;
+
+write_error:
+   error = eet_flush_error(fp);
+on_error:
+   /* offsets are not trustworthy anymore, rewrite everything next time */
+   ef->appendable = 0;
+   fclose(fp);
+   return error;
+}
+
+/* flush out writes to an eet file, indexed (v3 magic) or not (v2) */
 static Eet_Error
 eet_flush2(Eet_File *ef)
 {
    Eet_File_Node *efn;
    FILE *fp;
    Eet_Error error = EET_ERROR_NONE;
-   int head[EET_FILE2_HEADER_COUNT];
    int num_directory_entries = 0;
    int num_dictionary_entries = 0;
    int bytes_directory_entries = 0;
    int bytes_dictionary_entries = 0;
    int bytes_strings = 0;
+   int bytes_data = 0;
    int data_offset = 0;
    int strings_offset = 0;
+   int index_size;
    int num;
    int i;
    int j;
@@ -343,12 +705,18 @@ eet_flush2(Eet_File *ef)
    if (!ef->writes_pending)
      return EET_ERROR_NONE;
 
+   /* signed files get a new signature over everything */
+   if ((ef->append) && (ef->appendable) && (!ef->key) &&
+       (ef->mode != EET_FILE_MODE_READ))
+     return eet_flush_append(ef);
+
    if ((ef->mode == EET_FILE_MODE_READ_WRITE)
        || (ef->mode == EET_FILE_MODE_WRITE))
      {
         int fd;
 
         /* opening for write - delete old copy of file right away */
+        ef->appendable = 0;
         unlink(ef->path);
         fd = open(ef->path, O_CREAT | O_TRUNC | O_RDWR | O_BINARY, S_IRUSR | S_IWUSR);
         if (fd < 0) 
@@ -371,6 +739,7 @@ eet_flush2(Eet_File *ef)
           {
              num_directory_entries++;
              bytes_strings += strlen(efn->name) + 1;
+             bytes_data += efn->size;
           }
      }
    if (ef->ed)
@@ -382,83 +751,64 @@ eet_flush2(Eet_File *ef)
      }
 
    /* calculate section bytes size */
-   bytes_directory_entries = EET_FILE2_DIRECTORY_ENTRY_SIZE *
-     num_directory_entries + EET_FILE2_HEADER_SIZE;
+   if (ef->indexed)
+     {
+        index_size = eet_flush_index_size(num_directory_entries);
+        bytes_directory_entries = EET_FILE3_DIRECTORY_ENTRY_SIZE *
+          num_directory_entries + EET_FILE3_HEADER_SIZE +
+          sizeof (int) * (1 << index_size);
+     }
+   else
+     {
+        index_size = 0;
+        bytes_directory_entries = EET_FILE2_DIRECTORY_ENTRY_SIZE *
+          num_directory_entries + EET_FILE2_HEADER_SIZE;
+     }
    bytes_dictionary_entries = EET_FILE2_DICTIONARY_ENTRY_SIZE *
      num_dictionary_entries;
 
-   /* go thru and write the header */
-   head[0] = (int)htonl((unsigned int)EET_MAGIC_FILE2);
-   head[1] = (int)htonl((unsigned int)num_directory_entries);
-   head[2] = (int)htonl((unsigned int)num_dictionary_entries);
-
-   fseek(fp, 0, SEEK_SET);
-   if (fwrite(head, sizeof (head), 1, fp) != 1)
-     goto write_error;
-
    /* calculate per entry base offset */
    strings_offset = bytes_directory_entries + bytes_dictionary_entries;
    data_offset = bytes_directory_entries + bytes_dictionary_entries +
      bytes_strings;
 
-   /* write directories entry */
+   /* give every name, string and data chunk its place in the file */
    for (i = 0; i < num; i++)
      {
         for (efn = ef->header->directory->nodes[i]; efn; efn = efn->next)
           {
-             unsigned int flag;
-             int ibuf[EET_FILE2_DIRECTORY_ENTRY_COUNT];
-
-             flag = (efn->alias << 2) | (efn->ciphered << 1) | efn->compression;
-             flag |= efn->compression_type << 3;
-
+             efn->name_offset = strings_offset;
              efn->offset = data_offset;
-
-             ibuf[0] = (int)htonl((unsigned int)data_offset);
-             ibuf[1] = (int)htonl((unsigned int)efn->size);
-             ibuf[2] = (int)htonl((unsigned int)efn->data_size);
-             ibuf[3] = (int)htonl((unsigned int)strings_offset);
-             ibuf[4] = (int)htonl((unsigned int)efn->name_size);
-             ibuf[5] = (int)htonl((unsigned int)flag);
+             efn->on_disk = 1;
 
              strings_offset += efn->name_size;
              data_offset += efn->size;
-
-             if (fwrite(ibuf, sizeof(ibuf), 1, fp) != 1)
-               goto write_error;
           }
      }
 
-   /* write dictionary */
    if (ef->ed)
      {
-        int offset = strings_offset;
-
         /* calculate dictionary strings offset */
         ef->ed->offset = strings_offset;
 
         for (j = 0; j < ef->ed->count; ++j)
           {
-             int sbuf[EET_FILE2_DICTIONARY_ENTRY_COUNT];
-	     int prev = 0;
-
-             // We still use the prev as an hint for knowing if it is the head of the hash
-	     if (ef->ed->hash[ef->ed->all_hash[j]] == j)
-	       prev = -1;
-
-             sbuf[0] = (int)htonl((unsigned int)ef->ed->all_hash[j]);
-             sbuf[1] = (int)htonl((unsigned int)offset);
-             sbuf[2] = (int)htonl((unsigned int)ef->ed->all[j].len);
-             sbuf[3] = (int)htonl((unsigned int)prev);
-             sbuf[4] = (int)htonl((unsigned int)ef->ed->all[j].next);
-
-             offset += ef->ed->all[j].len;
-
-             if (fwrite(sbuf, sizeof (sbuf), 1, fp) != 1)
-               goto write_error;
+             ef->ed->all[j].offset = strings_offset;
+             strings_offset += ef->ed->all[j].len;
           }
      }
 
+   /* go thru and write the header */
+   error = eet_flush_header(ef, fp, num_directory_entries,
+                            num_dictionary_entries, index_size, data_offset,
+                            EET_FILE3_HEADER_SIZE);
+   if (error != EET_ERROR_NONE)
+     goto sign_error;
+
+   error = eet_flush_tables(ef, fp, num_directory_entries, index_size);
+   if (error != EET_ERROR_NONE)
+     goto sign_error;
+
    /* write directories name */
    for (i = 0; i < num; i++)
      {
@@ -497,6 +847,8 @@ eet_flush2(Eet_File *ef)
         if (error != EET_ERROR_NONE)
           goto sign_error;
      }
+   else if ((ef->indexed) && (!ferror(fp)))
+     ef->appendable = 1;
 
    /* no more writes pending */
    ef->writes_pending = 0;
@@ -506,21 +858,7 @@ eet_flush2(Eet_File *ef)
    return EET_ERROR_NONE;
 
 write_error:
-   if (ferror(fp))
-     {
-        switch (errno)
-          {
-           case EFBIG: error = EET_ERROR_WRITE_ERROR_FILE_TOO_BIG; break;
-
-           case EIO: error = EET_ERROR_WRITE_ERROR_IO_ERROR; break;
-
-           case ENOSPC: error = EET_ERROR_WRITE_ERROR_OUT_OF_SPACE; break;
-
-           case EPIPE: error = EET_ERROR_WRITE_ERROR_FILE_CLOSED; break;
-
-           default: error = EET_ERROR_WRITE_ERROR; break;
-          }
-     }
+   error = eet_flush_error(fp);
 
 sign_error:
    fclose(fp);
@@ -697,13 +1035,101 @@ eet_sync(Eet_File *ef)
        (ef->mode != EET_FILE_MODE_READ_WRITE))
      return EET_ERROR_NOT_WRITABLE;
 
-   if (!ef->writes_pending)
-     return EET_ERROR_NONE;
-
+   if (!ef->writes_pending)
+     return EET_ERROR_NONE;
+
+   LOCK_FILE(ef);
+
+   ret = eet_flush2(ef);
+
+   UNLOCK_FILE(ef);
+   return ret;
+}
+
+EAPI Eet_Error
+eet_append_set(Eet_File *ef,
+               Eina_Bool append)
+{
+   if (eet_check_pointer(ef))
+     return EET_ERROR_BAD_OBJECT;
+
+   if ((ef->mode != EET_FILE_MODE_WRITE) &&
+       (ef->mode != EET_FILE_MODE_READ_WRITE))
+     return EET_ERROR_NOT_WRITABLE;
+
+   LOCK_FILE(ef);
+   ef->append = !!append;
+   /* only indexed files can be appended to */
+   if (append) ef->indexed = 1;
+   UNLOCK_FILE(ef);
+
+   return EET_ERROR_NONE;
+}
+
+EAPI Eina_Bool
+eet_append_get(Eet_File *ef)
+{
+   if (eet_check_pointer(ef))
+     return EINA_FALSE;
+
+   return ef->append;
+}
+
+EAPI Eet_Error
+eet_indexed_set(Eet_File *ef,
+                Eina_Bool indexed)
+{
+   if (eet_check_pointer(ef))
+     return EET_ERROR_BAD_OBJECT;
+
+   if ((ef->mode != EET_FILE_MODE_WRITE) &&
+       (ef->mode != EET_FILE_MODE_READ_WRITE))
+     return EET_ERROR_NOT_WRITABLE;
+
+   LOCK_FILE(ef);
+   ef->indexed = !!indexed;
+   /* appending needs the index */
+   if (!indexed) ef->append = 0;
+   if (!indexed) ef->appendable = 0;
+   ef->writes_pending = 1;
+   UNLOCK_FILE(ef);
+
+   return EET_ERROR_NONE;
+}
+
+EAPI Eina_Bool
+eet_indexed_get(Eet_File *ef)
+{
+   if (eet_check_pointer(ef))
+     return EINA_FALSE;
+
+   return ef->indexed;
+}
+
+EAPI Eet_Error
+eet_compact(Eet_File *ef)
+{
+   Eet_Error ret;
+   unsigned char append;
+
+   if (eet_check_pointer(ef))
+     return EET_ERROR_BAD_OBJECT;
+
+   if ((ef->mode != EET_FILE_MODE_WRITE) &&
+       (ef->mode != EET_FILE_MODE_READ_WRITE))
+     return EET_ERROR_NOT_WRITABLE;
+
    LOCK_FILE(ef);
 
+   /* a full rewrite drops everything the appends left behind */
+   append = ef->append;
+   ef->append = 0;
+   ef->writes_pending = 1;
+
    ret = eet_flush2(ef);
 
+   ef->append = append;
+
    UNLOCK_FILE(ef);
    return ret;
 }
@@ -766,6 +1192,465 @@ eet_clearcache(void)
    UNLOCK_CACHE;
 }
 
+#define GET_INT(Value, Pointer, Index) \
+  {                                    \
+     Value = ntohl(*Pointer);          \
+     Pointer++;                        \
+     Index += sizeof(int);             \
+  }
+
+/* load the string dictionary shared by v2 and v3 files, no string can
+ * start before strings_base nor overlap [tables_start, tables_end) */
+static Eet_File *
+eet_internal_read_dictionary(Eet_File          *ef,
+                             const int         *dico,
+                             unsigned long int  num_dictionary_entries,
+                             unsigned long int  strings_base,
+                             unsigned long int  tables_start,
+                             unsigned long int  tables_end,
+                             unsigned long int *signature_base_offset)
+{
+   const char *start = (const char *)ef->data;
+   int idx = 0;
+   int j;
+
+   ef->ed = eet_dictionary_add();
+   if (eet_test_close(!ef->ed, ef))
+     return NULL;
+
+   INF("loading dictionary for '%s' with %lu entries of size %zu",
+       ef->path, num_dictionary_entries, sizeof(Eet_String));
+
+   ef->ed->all = calloc(1, num_dictionary_entries * sizeof(Eet_String));
+   if (eet_test_close(!ef->ed->all, ef))
+     return NULL;
+
+   ef->ed->all_hash = calloc(1, num_dictionary_entries * sizeof (unsigned char));
+   if (eet_test_close(!ef->ed->all_hash, ef))
+     return NULL;
+
+   ef->ed->all_allocated = calloc(1, ((num_dictionary_entries >> 3) + 1) * sizeof (unsigned char));
+   if (eet_test_close(!ef->ed->all_allocated, ef))
+     return NULL;
+
+   ef->ed->count = num_dictionary_entries;
+   ef->ed->total = num_dictionary_entries;
+   /* narrowed down to the strings below */
+   ef->ed->start = start + ef->data_size;
+   ef->ed->end = start + strings_base;
+
+   for (j = 0; j < ef->ed->count; ++j)
+     {
+        unsigned int offset;
+        int prev;
+        int hash;
+
+        GET_INT(hash, dico, idx);
+        GET_INT(offset, dico, idx);
+        GET_INT(ef->ed->all[j].len, dico, idx);
+        GET_INT(prev, dico, idx); // Let's ignore prev link for dictionary, use it only as an hint to head
+        GET_INT(ef->ed->all[j].next, dico, idx);
+
+        /* Hash value could be stored on 8bits data, but this will break alignment of all the others data.
+           So stick to int and check the value. */
+        if (eet_test_close(hash & 0xFFFFFF00, ef))
+          return NULL;
+
+        /* Check string position */
+        if (eet_test_close(!((ef->ed->all[j].len > 0)
+                             && (offset >= strings_base)
+                             && ((offset >= tables_end) ||
+                                 (offset + ef->ed->all[j].len <=
+                                  tables_start))
+                             && (offset + ef->ed->all[j].len <
+                                 ef->data_size)), ef))
+          return NULL;
+
+        ef->ed->all[j].str = start + offset;
+        ef->ed->all[j].offset = offset;
+
+        if (ef->ed->all[j].str < ef->ed->start)
+          ef->ed->start = ef->ed->all[j].str;
+        if (ef->ed->all[j].str + ef->ed->all[j].len > ef->ed->end)
+          ef->ed->end = ef->ed->all[j].str + ef->ed->all[j].len;
+
+        /* Check '\0' at the end of the string */
+        if (eet_test_close(ef->ed->all[j].str[ef->ed->all[j].len - 1] !=
+                           '\0', ef))
+          return NULL;
+
+        ef->ed->all_hash[j] = hash;
+        if (prev == -1)
+          ef->ed->hash[hash] = j;
+
+        /* compute the possible position of a signature */
+        if (*signature_base_offset < offset + ef->ed->all[j].len)
+          *signature_base_offset = offset + ef->ed->all[j].len;
+     }
+
+   return ef;
+}
+
+/* check the signature trailing the data stream, if any */
+static Eet_File *
+eet_internal_read_signature(Eet_File         *ef,
+                            unsigned long int signature_base_offset)
+{
+   ef->x509_der = NULL;
+   ef->x509_length = 0;
+   ef->signature = NULL;
+   ef->signature_length = 0;
+
+   if (signature_base_offset < ef->data_size)
+     {
+#ifdef HAVE_SIGNATURE
+        const unsigned char *buffer = ((const unsigned char *)ef->data) +
+          signature_base_offset;
+        ef->x509_der = eet_identity_check(ef->data,
+                                          signature_base_offset,
+                                          &ef->sha1,
+                                          &ef->sha1_length,
+                                          buffer,
+                                          ef->data_size - signature_base_offset,
+                                          &ef->signature,
+                                          &ef->signature_length,
+                                          &ef->x509_length);
+
+        if (eet_test_close(!ef->x509_der, ef))
+          return NULL;
+
+#else /* ifdef HAVE_SIGNATURE */
+        ERR(
+          "This file could be signed but you didn't compile the necessary code to check the signature.");
+#endif /* ifdef HAVE_SIGNATURE */
+     }
+
+   return ef;
+}
+
+/* check that a data or name chunk of a v3 file lies between the header
+ * and the end of the file without running into the tables */
+static Eina_Bool
+eet_internal_chunk_check(const Eet_File   *ef,
+                         unsigned long int offset,
+                         unsigned long int size)
+{
+   const Eet_File_Directory *directory = ef->header->directory;
+
+   if ((size == 0) ||
+       (offset < EET_FILE3_HEADER_SIZE) ||
+       (offset > ef->data_size) ||
+       (size > ef->data_size - offset))
+     return EINA_FALSE;
+
+   return (offset >= directory->tables_end) ||
+     (offset + size <= directory->tables_offset);
+}
+
+/* create the in-memory node for the on-disk directory entry idx of a v3
+ * file. Broken entries are logged and skipped, not retried. */
+static Eet_File_Node *
+eet_internal_node_load(Eet_File    *ef,
+                       unsigned int idx)
+{
+   Eet_File_Directory *directory = ef->header->directory;
+   const int *data;
+   const char *name;
+   Eet_File_Node *efn;
+   unsigned long int name_offset;
+   unsigned long int name_size;
+   int hash;
+   int flag;
+   int dummy = 0;
+
+   if (directory->loaded[idx >> 3] & (1 << (idx & 0x7)))
+     return NULL;
+   directory->loaded[idx >> 3] |= 1 << (idx & 0x7);
+   directory->pending--;
+
+   data = directory->entries + EET_FILE3_DIRECTORY_ENTRY_COUNT * idx;
+
+   efn = eet_file_node_malloc(1);
+   if (!efn) return NULL;
+
+   GET_INT(efn->offset, data, dummy);
+   GET_INT(efn->size, data, dummy);
+   GET_INT(efn->data_size, data, dummy);
+   GET_INT(name_offset, data, dummy);
+   GET_INT(name_size, data, dummy);
+   GET_INT(flag, data, dummy);
+
+   efn->compression = flag & 0x1 ? 1 : 0;
+   efn->ciphered = flag & 0x2 ? 1 : 0;
+   efn->alias = flag & 0x4 ? 1 : 0;
+   efn->compression_type = (flag >> 3) & 0xff;
+
+   name = (const char *)ef->data + name_offset;
+   if (!(eet_internal_chunk_check(ef, efn->offset, efn->size)
+         && eet_internal_chunk_check(ef, name_offset, name_size)
+         && (name[name_size - 1] == '\0')))
+     {
+        ERR("Broken directory entry %u in '%s'", idx, ef->path);
+        eet_file_node_mp_free(efn);
+        return NULL;
+     }
+
+   efn->free_name = 0;
+   efn->name = (char *)name;
+   efn->name_offset = name_offset;
+   efn->name_size = name_size;
+   efn->on_disk = 1;
+
+   hash = _eet_hash_gen(efn->name, directory->size);
+   efn->next = directory->nodes[hash];
+   directory->nodes[hash] = efn;
+
+   /* read-only mode, so currently we have no data loaded */
+   if (ef->mode == EET_FILE_MODE_READ)
+     efn->data = NULL;  /* read-write mode - read everything into ram */
+   else
+     {
+        efn->data = malloc(efn->size);
+        if (efn->data)
+          memcpy(efn->data, ef->data + efn->offset, efn->size);
+     }
+
+   return efn;
+}
+
+/* look up name in the on-disk index of a v3 file */
+static Eet_File_Node *
+eet_internal_node_find(Eet_File   *ef,
+                       const char *name)
+{
+   Eet_File_Directory *directory = ef->header->directory;
+   unsigned int len;
+   unsigned int idx;
+   unsigned int walked;
+   int bucket;
+
+   len = strlen(name) + 1;
+   bucket = _eet_hash_index_gen(name, len - 1) &
+     ((1 << directory->index_size) - 1);
+
+   idx = ntohl(directory->index[bucket]);
+   for (walked = 0;
+        (idx < directory->count) && (walked < directory->count);
+        walked++)
+     {
+        const int *entry = directory->entries +
+          EET_FILE3_DIRECTORY_ENTRY_COUNT * idx;
+        unsigned long int name_offset = ntohl(entry[3]);
+        unsigned long int name_size = ntohl(entry[4]);
+
+        if ((name_size == len)
+            && (name_offset + name_size < ef->data_size)
+            && (!memcmp(ef->data + name_offset, name, len)))
+          return eet_internal_node_load(ef, idx);
+
+        idx = ntohl(entry[6]);
+     }
+
+   return NULL;
+}
+
+/* make sure every directory entry has its in-memory node */
+static void
+eet_internal_directory_load(Eet_File *ef)
+{
+   Eet_File_Directory *directory = ef->header->directory;
+   unsigned int i;
+
+   for (i = 0; (directory->pending > 0) && (i < directory->count); i++)
+     eet_internal_node_load(ef, i);
+}
+
+/* take a read lock on the header of the indexed file ef maps, see
+ * eet_flush_append(), and make sure the map covers all of the file the
+ * header describes. Returns the locked descriptor, to be closed once the
+ * header is read, or -1 when the file can't be locked and is read as it
+ * is mapped. */
+static int
+eet_internal_read3_lock(Eet_File *ef)
+{
+   Eina_File *fp;
+   struct stat st;
+   int tries;
+   int fd;
+
+   if ((!ef->path) || (!ef->readfp))
+     return -1;
+
+   for (tries = 0; tries < 3; tries++)
+     {
+        fd = open(ef->path, O_RDONLY | O_BINARY);
+        if (fd < 0)
+          return -1;
+
+        if ((!eet_file_lock(fd, F_RDLCK, EET_FILE3_HEADER_SIZE, EINA_TRUE)) ||
+            (fstat(fd, &st) != 0))
+          {
+             close(fd);
+             return -1;
+          }
+        if ((unsigned long int)st.st_size == ef->data_size)
+          return fd;
+
+        /* appended to since it was mapped, map it again unlocked as
+         * closing the old map may drop the lock */
+        close(fd);
+        fp = eina_file_open(ef->path, EINA_FALSE);
+        if (!fp)
+          return -1;
+
+        eina_file_map_free(ef->readfp, (void *)ef->data);
+        if (ef->readfp_owned)
+          eina_file_close(ef->readfp);
+        ef->readfp = fp;
+        ef->readfp_owned = EINA_TRUE;
+        ef->data_size = eina_file_size_get(fp);
+        ef->data = eina_file_map_all(fp, EINA_FILE_SEQUENTIAL);
+        if (!ef->data)
+          return -1;
+     }
+
+   return -1;
+}
+
+static Eet_File *
+eet_internal_read3(Eet_File *ef)
+{
+   const int *data;
+   Eet_File_Directory *directory;
+   int idx = 0;
+   int lock_fd;
+   unsigned long int bytes_tables;
+   unsigned long int signature_base_offset;
+   unsigned long int tables_offset;
+   unsigned long int strings_end_offset;
+   unsigned long int num_directory_entries;
+   unsigned long int num_dictionary_entries;
+   unsigned long int index_size;
+
+   lock_fd = eet_internal_read3_lock(ef);
+   data = (const int *)ef->data;
+   if ((!data) || (ef->data_size < EET_FILE3_HEADER_SIZE) ||
+       ((int)ntohl(*data) != EET_MAGIC_FILE3))
+     {
+        if (lock_fd >= 0)
+          close(lock_fd);
+        eet_test_close(EINA_TRUE, ef);
+        return NULL;
+     }
+
+   idx += sizeof(int);
+   data++;
+
+   GET_INT(num_directory_entries, data, idx);
+   GET_INT(num_dictionary_entries, data, idx);
+   GET_INT(index_size, data, idx);
+   GET_INT(signature_base_offset, data, idx);
+   GET_INT(tables_offset, data, idx);
+
+   /* the rest is never written again once the header points at it */
+   if (lock_fd >= 0)
+     close(lock_fd);
+
+   /* reject sizes that can not fit in the file before doing any math */
+   if (eet_test_close((num_directory_entries >
+                       ef->data_size / EET_FILE3_DIRECTORY_ENTRY_SIZE) ||
+                      (num_dictionary_entries >
+                       ef->data_size / EET_FILE2_DICTIONARY_ENTRY_SIZE) ||
+                      (index_size < EET_FILE3_INDEX_SIZE_MIN) ||
+                      (index_size > EET_FILE3_INDEX_SIZE_MAX), ef))
+     return NULL;
+
+   bytes_tables = sizeof (int) * (1 << index_size) +
+     EET_FILE3_DIRECTORY_ENTRY_SIZE * num_directory_entries +
+     EET_FILE2_DICTIONARY_ENTRY_SIZE * num_dictionary_entries;
+
+   /* the aligned tables follow the header and end before the signature,
+    * itself in the file */
+   if (eet_test_close((tables_offset < EET_FILE3_HEADER_SIZE) ||
+                      (tables_offset % sizeof (int)) ||
+                      (signature_base_offset > ef->data_size) ||
+                      (tables_offset > signature_base_offset) ||
+                      (bytes_tables > signature_base_offset - tables_offset),
+                      ef))
+     return NULL;
+
+   /* allocate header */
+   ef->header = eet_file_header_calloc(1);
+   if (eet_test_close(!ef->header, ef))
+     return NULL;
+
+   ef->header->magic = EET_MAGIC_FILE_HEADER;
+
+   /* allocate directory block in ram */
+   ef->header->directory = eet_file_directory_calloc(1);
+   if (eet_test_close(!ef->header->directory, ef))
+     return NULL;
+   directory = ef->header->directory;
+
+   /* 8 bit hash table (256 buckets), only for the nodes looked up so far */
+   directory->size = 8;
+   directory->nodes =
+     calloc(1, sizeof(Eet_File_Node *) * (1 << directory->size));
+   if (eet_test_close(!directory->nodes, ef))
+     return NULL;
+
+   directory->loaded = calloc(1, (num_directory_entries >> 3) + 1);
+   if (eet_test_close(!directory->loaded, ef))
+     return NULL;
+
+   directory->index = (const int *)(ef->data + tables_offset);
+   directory->entries = directory->index + (1 << index_size);
+   directory->index_size = index_size;
+   directory->count = num_directory_entries;
+   directory->pending = num_directory_entries;
+   directory->tables_offset = tables_offset;
+   directory->tables_end = tables_offset + bytes_tables;
+
+   /* writers need every entry in ram anyway */
+   if (ef->mode != EET_FILE_MODE_READ)
+     eet_internal_directory_load(ef);
+
+   ef->ed = NULL;
+
+   if (num_dictionary_entries)
+     {
+        strings_end_offset = 0;
+        if (!eet_internal_read_dictionary(ef,
+                                          directory->entries +
+                                          EET_FILE3_DIRECTORY_ENTRY_COUNT *
+                                          num_directory_entries,
+                                          num_dictionary_entries,
+                                          EET_FILE3_HEADER_SIZE,
+                                          directory->tables_offset,
+                                          directory->tables_end,
+                                          &strings_end_offset))
+          return NULL;
+
+        if (eet_test_close(strings_end_offset > signature_base_offset, ef))
+          return NULL;
+     }
+
+   if (!eet_internal_read_signature(ef, signature_base_offset))
+     return NULL;
+
+   /* an unsigned file can be updated in place */
+   ef->appendable = (signature_base_offset == ef->data_size);
+   /* keep the layout it was written with */
+   ef->indexed = 1;
+
+   /* lookups will hop around the index, don't read ahead there */
+   if (ef->readfp)
+     eina_file_map_populate(ef->readfp, EINA_FILE_RANDOM, ef->data,
+                            tables_offset, bytes_tables);
+
+   return ef;
+}
+
 /* FIXME: MMAP race condition in READ_WRITE_MODE */
 static Eet_File *
 eet_internal_read2(Eet_File *ef)
@@ -786,13 +1671,6 @@ eet_internal_read2(Eet_File *ef)
 
    data++;
 
-#define GET_INT(Value, Pointer, Index) \
-  {                                    \
-     Value = ntohl(*Pointer);          \
-     Pointer++;                        \
-     Index += sizeof(int);             \
-  }
-
    /* get entries count and byte count */
    GET_INT(num_directory_entries, data, idx);
    /* get dictionary count and byte count */
@@ -926,7 +1804,6 @@ eet_internal_read2(Eet_File *ef)
         const int *dico = (const int *)ef->data +
           EET_FILE2_DIRECTORY_ENTRY_COUNT * num_directory_entries +
           EET_FILE2_HEADER_COUNT;
-        int j;
 
         if (eet_test_close((num_dictionary_entries *
                             (int)EET_FILE2_DICTIONARY_ENTRY_SIZE + idx) >
@@ -934,106 +1811,16 @@ eet_internal_read2(Eet_File *ef)
                            ef))
           return NULL;
 
-        ef->ed = eet_dictionary_add();
-        if (eet_test_close(!ef->ed, ef))
-          return NULL;
-
-        INF("loading dictionary for '%s' with %lu entries of size %zu",
-            ef->path, num_dictionary_entries, sizeof(Eet_String));
-
-        ef->ed->all = calloc(1, num_dictionary_entries * sizeof(Eet_String));
-        if (eet_test_close(!ef->ed->all, ef))
+        if (!eet_internal_read_dictionary(ef, dico, num_dictionary_entries,
+                                          bytes_dictionary_entries +
+                                          bytes_directory_entries,
+                                          0, 0,
+                                          &signature_base_offset))
           return NULL;
-
-	ef->ed->all_hash = calloc(1, num_dictionary_entries * sizeof (unsigned char));
-	if (eet_test_close(!ef->ed->all_hash, ef))
-	  return NULL;
-
-	ef->ed->all_allocated = calloc(1, ((num_dictionary_entries >> 3) + 1) * sizeof (unsigned char));
-	if (eet_test_close(!ef->ed->all_allocated, ef))
-	  return NULL;
-
-        ef->ed->count = num_dictionary_entries;
-        ef->ed->total = num_dictionary_entries;
-        ef->ed->start = start + bytes_dictionary_entries +
-          bytes_directory_entries;
-        ef->ed->end = ef->ed->start;
-
-        for (j = 0; j < ef->ed->count; ++j)
-          {
-             unsigned int offset;
-	     int prev;
-             int hash;
-
-             GET_INT(hash, dico, idx);
-             GET_INT(offset, dico, idx);
-             GET_INT(ef->ed->all[j].len, dico, idx);
-             GET_INT(prev, dico, idx); // Let's ignore prev link for dictionary, use it only as an hint to head
-             GET_INT(ef->ed->all[j].next, dico, idx);
-
-             /* Hash value could be stored on 8bits data, but this will break alignment of all the others data.
-                So stick to int and check the value. */
-             if (eet_test_close(hash & 0xFFFFFF00, ef))
-               return NULL;
-
-             /* Check string position */
-             if (eet_test_close(!((ef->ed->all[j].len > 0)
-                                  && (offset >
-                                      (bytes_dictionary_entries +
-                                       bytes_directory_entries))
-                                  && (offset + ef->ed->all[j].len <
-                                      ef->data_size)), ef))
-               return NULL;
-
-             ef->ed->all[j].str = start + offset;
-
-             if (ef->ed->all[j].str + ef->ed->all[j].len > ef->ed->end)
-               ef->ed->end = ef->ed->all[j].str + ef->ed->all[j].len;
-
-             /* Check '\0' at the end of the string */
-             if (eet_test_close(ef->ed->all[j].str[ef->ed->all[j].len - 1] !=
-                                '\0', ef))
-               return NULL;
-
-             ef->ed->all_hash[j] = hash;
-             if (prev == -1)
-               ef->ed->hash[hash] = j;
-
-             /* compute the possible position of a signature */
-             if (signature_base_offset < offset + ef->ed->all[j].len)
-               signature_base_offset = offset + ef->ed->all[j].len;
-          }
      }
 
-   /* Check if the file is signed */
-   ef->x509_der = NULL;
-   ef->x509_length = 0;
-   ef->signature = NULL;
-   ef->signature_length = 0;
-
-   if (signature_base_offset < ef->data_size)
-     {
-#ifdef HAVE_SIGNATURE
-        const unsigned char *buffer = ((const unsigned char *)ef->data) +
-          signature_base_offset;
-        ef->x509_der = eet_identity_check(ef->data,
-                                          signature_base_offset,
-                                          &ef->sha1,
-                                          &ef->sha1_length,
-                                          buffer,
-                                          ef->data_size - signature_base_offset,
-                                          &ef->signature,
-                                          &ef->signature_length,
-                                          &ef->x509_length);
-
-        if (eet_test_close(!ef->x509_der, ef))
-          return NULL;
-
-#else /* ifdef HAVE_SIGNATURE */
-        ERR(
-          "This file could be signed but you didn't compile the necessary code to check the signature.");
-#endif /* ifdef HAVE_SIGNATURE */
-     }
+   if (!eet_internal_read_signature(ef, signature_base_offset))
+     return NULL;
 
    /* At this stage we have a valid eet file, let's tell the system we are likely to need most of its data */
    if (ef->readfp && ef->ed)
@@ -1259,6 +2046,9 @@ eet_internal_read(Eet_File *ef)
       case EET_MAGIC_FILE2:
         return eet_internal_read2(ef);
 
+      case EET_MAGIC_FILE3:
+        return eet_internal_read3(ef);
+
       default:
         ef->delete_me_now = 1;
         eet_internal_close(ef, EINA_TRUE);
@@ -1345,6 +2135,7 @@ eet_internal_close(Eet_File *ef,
                   free(ef->header->directory->nodes);
                }
 
+             free(ef->header->directory->loaded);
              eet_file_directory_mp_free(ef->header->directory);
           }
 
@@ -1407,6 +2198,9 @@ eet_memopen_read(const void *data,
    ef->sha1 = NULL;
    ef->sha1_length = 0;
    ef->readfp_owned = EINA_FALSE;
+   ef->append = 0;
+   ef->appendable = 0;
+   ef->indexed = 0;
 
    /* eet_internal_read expects the cache lock to be held when it is called */
    LOCK_CACHE;
@@ -1468,6 +2262,9 @@ eet_mmap(const Eina_File *file)
    ef->sha1 = NULL;
    ef->sha1_length = 0;
    ef->readfp_owned = EINA_TRUE;
+   ef->append = 0;
+   ef->appendable = 0;
+   ef->indexed = 0;
 
    ef->data_size = eina_file_size_get(ef->readfp);
    ef->data = eina_file_map_all(ef->readfp, EINA_FILE_SEQUENTIAL);
@@ -1615,6 +2412,9 @@ open_error:
    ef->sha1 = NULL;
    ef->sha1_length = 0;
    ef->readfp_owned = EINA_TRUE;
+   ef->append = 0;
+   ef->appendable = 0;
+   ef->indexed = 0;
 
    ef->ed = (mode == EET_FILE_MODE_WRITE)
      || (!ef->readfp && mode == EET_FILE_MODE_READ_WRITE) ?
@@ -2307,6 +3107,7 @@ eet_alias(Eet_File   *ef,
               efn->data = data2;
               /* Put the offset above the limit to avoid direct access */
               efn->offset = ef->data_size + 1;
+              efn->on_disk = 0;
               exists_already = EINA_TRUE;
               break;
            }
@@ -2328,6 +3129,8 @@ eet_alias(Eet_File   *ef,
         ef->header->directory->nodes[hash] = efn;
         /* Put the offset above the limit to avoid direct access */
         efn->offset = ef->data_size + 1;
+        efn->name_offset = 0;
+        efn->on_disk = 0;
         efn->alias = 1;
         efn->ciphered = 0;
         efn->compression = !!comp;
@@ -2525,6 +3328,7 @@ eet_write_cipher(Eet_File   *ef,
               efn->data = data2;
               /* Put the offset above the limit to avoid direct access */
               efn->offset = ef->data_size + 1;
+              efn->on_disk = 0;
               exists_already = 1;
               break;
            }
@@ -2546,6 +3350,8 @@ eet_write_cipher(Eet_File   *ef,
         ef->header->directory->nodes[hash] = efn;
         /* Put the offset above the limit to avoid direct access */
         efn->offset = ef->data_size + 1;
+        efn->name_offset = 0;
+        efn->on_disk = 0;
         efn->alias = 0;
         efn->ciphered = cipher_key ? 1 : 0;
         efn->compression = !!comp;
@@ -2674,6 +3480,9 @@ eet_list(Eet_File   *ef,
 
    LOCK_FILE(ef);
 
+   if (ef->header->directory->pending)
+     eet_internal_directory_load(ef);
+
    /* loop through all entries */
    num = (1 << ef->header->directory->size);
    for (i = 0; i < num; i++)
@@ -2744,6 +3553,9 @@ eet_num_entries(Eet_File *ef)
 
    LOCK_FILE(ef);
 
+   if (ef->header->directory->pending)
+     eet_internal_directory_load(ef);
+
    /* loop through all entries */
    num = (1 << ef->header->directory->size);
    for (i = 0; i < num; i++)
@@ -2858,6 +3670,13 @@ eet_list_entries(Eet_File *ef)
    it = malloc(sizeof (Eet_Entries_Iterator));
    if (!it) return NULL;
 
+   if (ef->header && ef->header->directory->pending)
+     {
+        LOCK_FILE(ef);
+        eet_internal_directory_load(ef);
+        UNLOCK_FILE(ef);
+     }
+
    EINA_MAGIC_SET(&it->iterator, EINA_MAGIC_ITERATOR);
    it->ef = ef;
    it->efn = NULL;
@@ -2889,6 +3708,10 @@ find_node_by_name(Eet_File   *ef,
           return efn;
      }
 
+   /* not seen yet, ask the on-disk index */
+   if (ef->header->directory->pending)
+     return eet_internal_node_find(ef, name);
+
    return NULL;
 }
 
@@ -34,3 +34,17 @@ _eet_hash_gen(const char *key,
    return hash_num;
 }
 
+
+/* djb2, stored in files so unlike eina_hash_djb2() it must not be seeded */
+unsigned int
+_eet_hash_index_gen(const char *key,
+                    int         len)
+{
+   unsigned int hash_num = 5381;
+   const unsigned char *ptr;
+
+   for (ptr = (const unsigned char *)key; len > 0; ptr++, len--)
+     hash_num = ((hash_num << 5) + hash_num) ^ *ptr;
+
+   return hash_num;
+}
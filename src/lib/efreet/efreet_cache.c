@@ -66,6 +66,7 @@ static Eina_Hash           *icons = NULL;
 static Eina_Hash           *fallbacks = NULL;
 
 static const char          *icon_theme_cache_file = NULL;
+static const char          *mime_cache_file = NULL;
 
 static const char          *theme_name = NULL;
 
@@ -200,6 +201,7 @@ efreet_cache_shutdown(void)
 
     efreet_cache_edd_shutdown();
     IF_RELEASE(icon_theme_cache_file);
+    IF_RELEASE(mime_cache_file);
 
     if (old_desktop_caches)
         ERR("This application has not properly closed all its desktop references!");
@@ -280,6 +282,53 @@ efreet_icon_theme_cache_file(void)
     return icon_theme_cache_file;
 }
 
+/*
+ * Needs EAPI because of helper binaries
+ */
+EAPI const char *
+efreet_mime_cache_file(void)
+{
+    char tmp[PATH_MAX] = { '\0' };
+
+    if (mime_cache_file) return mime_cache_file;
+
+    snprintf(tmp, sizeof(tmp), "%s/efreet/mime_%s.cache",
+             efreet_cache_home_get(), efreet_hostname_get());
+    mime_cache_file = eina_stringshare_add(tmp);
+
+    return mime_cache_file;
+}
+
+/*
+ * Needs EAPI because of efreetd
+ *
+ * A monitor can't be put on a path that doesn't exist yet, so the nearest
+ * parent that does is returned instead. Its events tell when the path
+ * shows up, a level at a time.
+ */
+EAPI char *
+efreet_cache_watch_path_get(const char *path)
+{
+    char *dir, *parent;
+
+    EINA_SAFETY_ON_NULL_RETURN_VAL(path, NULL);
+
+    dir = strdup(path);
+    while ((dir) && (!ecore_file_exists(dir)))
+    {
+        parent = ecore_file_dir_get(dir);
+        if ((parent) && (!strcmp(parent, dir)))
+        {
+            free(parent);
+            parent = NULL;
+        }
+        free(dir);
+        dir = parent;
+    }
+
+    return dir;
+}
+
 /*
  * Needs EAPI because of helper binaries
  */
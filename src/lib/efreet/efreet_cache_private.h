@@ -9,6 +9,9 @@
 #define EFREET_ICON_CACHE_MAJOR 1
 #define EFREET_ICON_CACHE_MINOR 0
 
+#define EFREET_MIME_CACHE_MAJOR 1
+#define EFREET_MIME_CACHE_MINOR 0
+
 #define EFREET_CACHE_VERSION "__efreet//version"
 #define EFREET_CACHE_ICON_FALLBACK "__efreet_fallback"
 
@@ -16,6 +19,12 @@ EAPI const char *efreet_desktop_util_cache_file(void);
 EAPI const char *efreet_desktop_cache_file(void);
 EAPI const char *efreet_icon_cache_file(const char *theme);
 EAPI const char *efreet_icon_theme_cache_file(void);
+EAPI const char *efreet_mime_cache_file(void);
+EAPI char *efreet_cache_watch_path_get(const char *path);
+
+/* in libefreet_mime, for efreet_mime_cache_create */
+EAPI Eina_Bool efreet_mime_cache_valid(const char *file);
+EAPI Eina_Bool efreet_mime_cache_write(const char *file);
 
 EAPI Eet_Data_Descriptor *efreet_version_edd(void);
 EAPI Eet_Data_Descriptor *efreet_desktop_edd(void);
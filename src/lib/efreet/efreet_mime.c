@@ -21,6 +21,7 @@
 # include <winsock2.h>
 #endif
 
+#include <Eet.h>
 #include <Ecore.h>
 #include <Ecore_File.h>
 
@@ -31,10 +32,16 @@ static int _efreet_mime_log_dom = -1;
 #include "Efreet.h"
 #include "Efreet_Mime.h"
 #include "efreet_private.h"
+#include "efreet_cache_private.h"
+
+typedef struct Efreet_Mime_Cache Efreet_Mime_Cache;
 
 static Eina_List *globs = NULL;     /* contains Efreet_Mime_Glob structs */
 static Eina_List *magics = NULL;    /* contains Efreet_Mime_Magic structs */
 static Eina_Hash *wild = NULL;      /* contains *.ext and mime.types globs*/
+static Efreet_Mime_Cache *cache = NULL; /* globs and magics compiled from the above */
+static Eina_File *cache_file = NULL;  /* backs cache when it was built by efreetd */
+static const char **cache_mimes = NULL; /* stringshared mime types by id */
 static Eina_Hash *monitors = NULL;  /* contains file monitors */
 static Eina_Hash *mime_icons = NULL; /* contains cache with mime->icons */
 static Eina_Inlist *mime_icons_lru = NULL;
@@ -116,6 +123,119 @@ struct Efreet_Mime_Magic_Entry
    char *value;
 };
 
+/*
+ * The globs and magics are only parsed into the lists above to be compiled
+ * into the following tables, which is all lookups use. efreetd keeps them
+ * in a cache file which is mapped as is, so parsing only happens if that is
+ * missing or older than the files it was made from.
+ *
+ * Offsets are in bytes from the start of the cache, string offsets are from
+ * the start of the string pool where 0 is no string. Hash tables use open
+ * addressing on eina_hash_superfast(), a key of 0 is an empty bucket.
+ */
+#define EFREET_MIME_CACHE_MAGIC 0x454d494d
+#define EFREET_MIME_CACHE_NONE 0xffffffff
+
+/*
+ * Magic entries checking a range no longer than this get a prefilter key
+ * for each offset, longer ones always have to be checked.
+ */
+#define EFREET_MIME_MAGIC_KEY_RANGE 8
+
+struct Efreet_Mime_Cache
+{
+   unsigned int magic;
+   unsigned int major;
+   unsigned int minor;
+   unsigned int size;
+
+   unsigned int sources, sources_count;   /* files this was compiled from */
+   unsigned int strings, strings_size;
+   unsigned int mimes, mimes_count;       /* string offset by mime id */
+   unsigned int exts, exts_size;          /* extension -> mime id */
+
+   unsigned int globs, globs_count;       /* in the order they are tried */
+   unsigned int literals, literals_size;  /* glob without wildcards -> index */
+   unsigned int lowers, lowers_size;      /* lower case glob -> first index */
+   unsigned int suffixes, suffixes_count; /* trie of reversed "*tail" globs */
+   unsigned int patterns, patterns_count; /* index of every other glob */
+
+   unsigned int magics, magics_count;
+   unsigned int entries, entries_count;
+   unsigned int keys, keys_count;
+   unsigned int prefilter;                /* magic keys can be used */
+};
+
+typedef struct Efreet_Mime_Cache_Source Efreet_Mime_Cache_Source;
+struct Efreet_Mime_Cache_Source
+{
+   long long mtime;  /* -1 if the file doesn't exist */
+   long long size;
+   unsigned int path;
+   unsigned int pad;
+};
+
+typedef struct Efreet_Mime_Cache_Bucket Efreet_Mime_Cache_Bucket;
+struct Efreet_Mime_Cache_Bucket
+{
+   unsigned int key;
+   unsigned int value;
+};
+
+typedef struct Efreet_Mime_Cache_Glob Efreet_Mime_Cache_Glob;
+struct Efreet_Mime_Cache_Glob
+{
+   unsigned int glob;
+   unsigned int mime;
+};
+
+typedef struct Efreet_Mime_Cache_Suffix Efreet_Mime_Cache_Suffix;
+struct Efreet_Mime_Cache_Suffix
+{
+   unsigned int child;  /* node index, 0 is none as it is the root */
+   unsigned int next;
+   unsigned int glob;   /* glob index + 1 ending here, 0 if none */
+   unsigned int c;
+};
+
+/*
+ * A magic can only match if one of its top level entries does, so its keys
+ * are the first byte each of those has to find. Entries too far in the file
+ * for the buffer we read always have to be checked.
+ */
+typedef struct Efreet_Mime_Cache_Magic Efreet_Mime_Cache_Magic;
+struct Efreet_Mime_Cache_Magic
+{
+   unsigned int priority;
+   unsigned int mime;
+   unsigned int entries, entries_count;
+   unsigned int keys, keys_count;         /* no keys means always check */
+};
+
+typedef struct Efreet_Mime_Cache_Magic_Entry Efreet_Mime_Cache_Magic_Entry;
+struct Efreet_Mime_Cache_Magic_Entry
+{
+   unsigned int indent;
+   unsigned int offset;
+   unsigned int range_len;
+   unsigned int value_len;
+   unsigned int value;
+   unsigned int mask;
+};
+
+typedef struct Efreet_Mime_Cache_Magic_Key Efreet_Mime_Cache_Magic_Key;
+struct Efreet_Mime_Cache_Magic_Key
+{
+   unsigned int offset;
+   unsigned int value_len;
+   unsigned int c;
+};
+
+#define EFREET_MIME_CACHE_GET(type, section) \
+   ((const type *)((const char *)cache + cache->section))
+#define EFREET_MIME_CACHE_STRING(offset) \
+   ((const char *)cache + cache->strings + (offset))
+
 typedef struct Efreet_Mime_Icon_Entry_Head Efreet_Mime_Icon_Entry_Head;
 struct Efreet_Mime_Icon_Entry_Head
 {
@@ -143,6 +263,14 @@ static const char *efreet_mime_magic_check_priority(const char *file,
                                                     unsigned int start,
                                                     unsigned int end);
 static int efreet_mime_init_files(void);
+static void efreet_mime_load(void);
+static void efreet_mime_cache_free(void);
+static const char *efreet_mime_cache_mime_get(unsigned int id);
+static Efreet_Mime_Cache *efreet_mime_cache_map(const char *path, Eina_File **file);
+static Efreet_Mime_Cache *efreet_mime_sources_parse(void);
+static unsigned int efreet_mime_cache_hash_find(unsigned int table,
+                                                unsigned int size,
+                                                const char *key);
 static const char *efreet_mime_special_check(const char *file);
 static const char *efreet_mime_fallback_check(const char *file);
 static void efreet_mime_glob_free(void *data);
@@ -245,6 +373,7 @@ efreet_mime_shutdown(void)
    IF_FREE_LIST(magics, efreet_mime_magic_free);
    IF_FREE_HASH(monitors);
    IF_FREE_HASH(wild);
+   efreet_mime_cache_free();
    IF_FREE_HASH(mime_icons);
    eina_log_domain_unregister(_efreet_mime_log_dom);
    _efreet_mime_log_dom = -1;
@@ -387,13 +516,16 @@ efreet_mime_magic_type_get(const char *file)
 EAPI const char *
 efreet_mime_globs_type_get(const char *file)
 {
-   Eina_List *l;
-   Efreet_Mime_Glob *g;
+   const Efreet_Mime_Cache_Glob *g;
+   const Efreet_Mime_Cache_Suffix *nodes, *n;
+   const unsigned int *patterns;
+   unsigned int i, best, idx;
    char *sl, *p;
    const char *s;
-   char *ext, *mime;
+   char *ext;
 
    EINA_SAFETY_ON_NULL_RETURN_VAL(file, NULL);
+   if (!cache) return NULL;
 
    /* Check in the extension hash for the type */
    ext = strchr(file, '.');
@@ -406,25 +538,67 @@ efreet_mime_globs_type_get(const char *file)
         while (p)
           {
              p++;
-             if (p && (mime = eina_hash_find(wild, p))) return mime;
+             idx = efreet_mime_cache_hash_find(cache->exts, cache->exts_size, p);
+             if (idx != EFREET_MIME_CACHE_NONE)
+               return efreet_mime_cache_mime_get(idx);
              p = strchr(p, '.');
           }
      }
 
-   /* Fallback to the other globs if not found */
-   EINA_LIST_FOREACH(globs, l, g)
+   /*
+    * Fallback to the other globs if not found, the first one in the list
+    * that matches wins. Globs without wildcards and "*tail" ones can be
+    * looked up, only the others need fnmatch() and only up to the best
+    * match found so far.
+    */
+   g = EFREET_MIME_CACHE_GET(Efreet_Mime_Cache_Glob, globs);
+   best = efreet_mime_cache_hash_find(cache->literals, cache->literals_size, file);
+
+   nodes = EFREET_MIME_CACHE_GET(Efreet_Mime_Cache_Suffix, suffixes);
+   n = nodes;
+   if ((n->glob) && (n->glob - 1 < best)) best = n->glob - 1;
+   for (s = file + strlen(file); s > file; )
      {
-        if (efreet_mime_glob_match(file, g->glob))
-          return g->mime;
+        unsigned char c = *--s;
+
+        for (i = n->child; i; i = nodes[i].next)
+          if (nodes[i].c == c) break;
+        if (!i) break;
+        n = nodes + i;
+        if ((n->glob) && (n->glob - 1 < best)) best = n->glob - 1;
      }
 
+   patterns = EFREET_MIME_CACHE_GET(unsigned int, patterns);
+   for (i = 0; (i < cache->patterns_count) && (patterns[i] < best); i++)
+     {
+        if (efreet_mime_glob_match(file, EFREET_MIME_CACHE_STRING(g[patterns[i]].glob)))
+          {
+             best = patterns[i];
+             break;
+          }
+     }
+   if (best != EFREET_MIME_CACHE_NONE)
+     return efreet_mime_cache_mime_get(g[best].mime);
+
+   /*
+    * Last the case insensitive match, which uses the file name as the
+    * pattern. Without any special characters in it that is a plain compare
+    * with the lower case glob.
+    */
    ext = alloca(strlen(file) + 1);
    for (s = file, p = ext; *s; s++, p++) *p = tolower(*s);
    *p = 0;
-   EINA_LIST_FOREACH(globs, l, g)
+   if (!strpbrk(ext, "*?[\\"))
+     {
+        idx = efreet_mime_cache_hash_find(cache->lowers, cache->lowers_size, ext);
+        if (idx != EFREET_MIME_CACHE_NONE)
+          return efreet_mime_cache_mime_get(g[idx].mime);
+        return NULL;
+     }
+   for (i = 0; i < cache->globs_count; i++)
      {
-        if (efreet_mime_glob_case_match(ext, g->glob))
-          return g->mime;
+        if (efreet_mime_glob_case_match(ext, EFREET_MIME_CACHE_STRING(g[i].glob)))
+          return efreet_mime_cache_mime_get(g[i].mime);
      }
    return NULL;
 }
@@ -443,6 +617,54 @@ efreet_mime_fallback_type_get(const char *file)
    return efreet_mime_fallback_check(file);
 }
 
+/*
+ * Needs EAPI because of helper binaries
+ */
+EAPI Eina_Bool
+efreet_mime_cache_valid(const char *file)
+{
+   Efreet_Mime_Cache *c;
+   Eina_File *f = NULL;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(file, EINA_FALSE);
+
+   c = efreet_mime_cache_map(file, &f);
+   if (!c) return EINA_FALSE;
+
+   eina_file_map_free(f, c);
+   eina_file_close(f);
+   return EINA_TRUE;
+}
+
+/*
+ * Needs EAPI because of helper binaries
+ */
+EAPI Eina_Bool
+efreet_mime_cache_write(const char *file)
+{
+   Efreet_Mime_Cache *c;
+   FILE *f;
+   Eina_Bool ret;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(file, EINA_FALSE);
+
+   efreet_mime_endianess = efreet_mime_endian_check();
+   c = efreet_mime_sources_parse();
+   if (!c) return EINA_FALSE;
+
+   f = fopen(file, "wb");
+   if (!f)
+     {
+        free(c);
+        return EINA_FALSE;
+     }
+   ret = (fwrite(c, c->size, 1, f) == 1);
+   if (fclose(f)) ret = EINA_FALSE;
+   free(c);
+
+   return ret;
+}
+
 /**
  * @internal
  * @return Returns the endianess
@@ -552,6 +774,803 @@ efreet_mime_load_magics(Eina_List *datadirs, const char *datahome)
      }
 }
 
+typedef struct Efreet_Mime_Cache_Builder Efreet_Mime_Cache_Builder;
+struct Efreet_Mime_Cache_Builder
+{
+   Eina_Binbuf *strings;
+   Eina_Hash *mime_ids;        /* stringshared mime -> id + 1 */
+   Eina_Inarray *sources;
+   Eina_Inarray *mimes;
+   Eina_Inarray *exts;         /* Efreet_Mime_Cache_Item */
+};
+
+typedef struct Efreet_Mime_Cache_Item Efreet_Mime_Cache_Item;
+struct Efreet_Mime_Cache_Item
+{
+   const char *key;
+   unsigned int value;
+};
+
+/**
+ * @internal
+ * @return Returns the list of files globs and magics are read from
+ * @brief Lists the files in the order efreet_mime_load_globs() and
+ * efreet_mime_load_magics() read them, whether they exist or not.
+ */
+static Eina_List *
+efreet_mime_sources_get(void)
+{
+   Eina_List *sources = NULL, *datadirs, *l;
+   const char *datahome, *datadir;
+   char buf[4096];
+
+   if (!(datahome = efreet_data_home_get()))
+     return NULL;
+
+   if (!(datadirs = efreet_data_dirs_get()))
+     return NULL;
+
+   sources = eina_list_append(sources, eina_stringshare_add("/etc/mime.types"));
+
+   snprintf(buf, sizeof(buf), "%s/mime/globs", datahome);
+   sources = eina_list_append(sources, eina_stringshare_add(buf));
+   EINA_LIST_FOREACH(datadirs, l, datadir)
+     {
+        snprintf(buf, sizeof(buf), "%s/mime/globs", datadir);
+        sources = eina_list_append(sources, eina_stringshare_add(buf));
+     }
+
+   snprintf(buf, sizeof(buf), "%s/mime/magic", datahome);
+   sources = eina_list_append(sources, eina_stringshare_add(buf));
+   EINA_LIST_FOREACH(datadirs, l, datadir)
+     {
+        snprintf(buf, sizeof(buf), "%s/mime/magic", datadir);
+        sources = eina_list_append(sources, eina_stringshare_add(buf));
+     }
+
+   return sources;
+}
+
+static void
+efreet_mime_source_stat(const char *path, long long *mtime, long long *size)
+{
+   struct stat st;
+
+   if (stat(path, &st))
+     {
+        *mtime = -1;
+        *size = -1;
+        return;
+     }
+   *mtime = st.st_mtime;
+   *size = st.st_size;
+}
+
+static unsigned int
+efreet_mime_cache_bytes_add(Efreet_Mime_Cache_Builder *b,
+                            const char *data, unsigned int len)
+{
+   unsigned int offset;
+
+   if ((!data) || (!len)) return 0;
+   offset = eina_binbuf_length_get(b->strings);
+   eina_binbuf_append_length(b->strings, (const unsigned char *)data, len);
+   return offset;
+}
+
+/* Only the mimes repeat enough to be worth sharing, see
+ * efreet_mime_cache_mime_id(), hashing every string costs more than it saves */
+static unsigned int
+efreet_mime_cache_string_add(Efreet_Mime_Cache_Builder *b, const char *str)
+{
+   return efreet_mime_cache_bytes_add(b, str, strlen(str) + 1);
+}
+
+static unsigned int
+efreet_mime_cache_mime_id(Efreet_Mime_Cache_Builder *b, const char *mime)
+{
+   unsigned int id, offset;
+
+   id = (unsigned int)(uintptr_t)eina_hash_find(b->mime_ids, mime);
+   if (id) return id - 1;
+
+   offset = efreet_mime_cache_string_add(b, mime);
+   id = eina_inarray_push(b->mimes, &offset);
+   eina_hash_add(b->mime_ids, mime, (void *)(uintptr_t)(id + 1));
+   return id;
+}
+
+/**
+ * @internal
+ * @param b The cache being built
+ * @param items Efreet_Mime_Cache_Item of the table
+ * @param size Returns the number of buckets
+ * @return Returns the buckets
+ * @brief Builds a hash table for efreet_mime_cache_hash_find(), the first
+ * item of the same key is kept.
+ */
+static Efreet_Mime_Cache_Bucket *
+efreet_mime_cache_table_build(Efreet_Mime_Cache_Builder *b,
+                              Eina_Inarray *items, unsigned int *size)
+{
+   Efreet_Mime_Cache_Bucket *buckets;
+   Efreet_Mime_Cache_Item *it;
+   const char **keys;
+   unsigned int h, mask;
+
+   *size = 0;
+   if (!eina_inarray_count(items)) return NULL;
+
+   for (*size = 2; *size < eina_inarray_count(items) * 2; *size <<= 1) ;
+   mask = *size - 1;
+
+   buckets = NEW(Efreet_Mime_Cache_Bucket, *size);
+   keys = NEW(const char *, *size);
+   if ((!buckets) || (!keys))
+     {
+        IF_FREE(buckets);
+        IF_FREE(keys);
+        *size = 0;
+        return NULL;
+     }
+
+   EINA_INARRAY_FOREACH(items, it)
+     {
+        h = (unsigned int)eina_hash_superfast(it->key, strlen(it->key)) & mask;
+        while ((keys[h]) && (strcmp(keys[h], it->key)))
+          h = (h + 1) & mask;
+        if (keys[h]) continue;
+
+        keys[h] = it->key;
+        buckets[h].key = efreet_mime_cache_string_add(b, it->key);
+        buckets[h].value = it->value;
+     }
+   free(keys);
+
+   return buckets;
+}
+
+static Eina_Bool
+efreet_mime_cache_ext_add(const Eina_Hash *hash EINA_UNUSED, const void *key,
+                          void *data, void *fdata)
+{
+   Efreet_Mime_Cache_Builder *b = fdata;
+   Efreet_Mime_Cache_Item item;
+
+   item.key = key;
+   item.value = efreet_mime_cache_mime_id(b, data);
+   eina_inarray_push(b->exts, &item);
+   return EINA_TRUE;
+}
+
+static void
+efreet_mime_cache_suffix_add(Eina_Inarray *nodes, const char *tail,
+                             unsigned int idx)
+{
+   Efreet_Mime_Cache_Suffix *n, child;
+   const char *p;
+   unsigned int node = 0, i;
+
+   for (p = tail + strlen(tail); p > tail; )
+     {
+        unsigned char c = *--p;
+
+        n = eina_inarray_nth(nodes, node);
+        for (i = n->child; i; i = child.next)
+          {
+             child = *(Efreet_Mime_Cache_Suffix *)eina_inarray_nth(nodes, i);
+             if (child.c == c) break;
+          }
+        if (!i)
+          {
+             child.child = 0;
+             child.next = n->child;
+             child.glob = 0;
+             child.c = c;
+             i = eina_inarray_push(nodes, &child);
+             n = eina_inarray_nth(nodes, node);
+             n->child = i;
+          }
+        node = i;
+     }
+
+   n = eina_inarray_nth(nodes, node);
+   if (!n->glob) n->glob = idx + 1;
+}
+
+/**
+ * @internal
+ * @param b The cache being built, with the sources already added
+ * @return Returns the cache, to be freed with free()
+ * @brief Compiles the globs and magics lists into the cache tables.
+ */
+static Efreet_Mime_Cache *
+efreet_mime_cache_compile(Efreet_Mime_Cache_Builder *b)
+{
+   Efreet_Mime_Cache *c = NULL;
+   Efreet_Mime_Cache_Bucket *exts = NULL, *literals = NULL, *lowers = NULL;
+   Eina_Inarray *cglobs, *literal_items, *lower_items, *suffixes, *patterns;
+   Eina_Inarray *cmagics, *entries, *keys;
+   Eina_List *l, *ll, *lower_strs = NULL;
+   Efreet_Mime_Glob *g;
+   Efreet_Mime_Magic *m;
+   Efreet_Mime_Magic_Entry *e;
+   Efreet_Mime_Cache_Suffix root = { 0, 0, 0, 0 };
+   unsigned int idx, prefilter = 1, size = 0, i;
+   char *lower, *p;
+   const char *s;
+
+   cglobs = eina_inarray_new(sizeof(Efreet_Mime_Cache_Glob), 64);
+   literal_items = eina_inarray_new(sizeof(Efreet_Mime_Cache_Item), 64);
+   lower_items = eina_inarray_new(sizeof(Efreet_Mime_Cache_Item), 64);
+   suffixes = eina_inarray_new(sizeof(Efreet_Mime_Cache_Suffix), 64);
+   patterns = eina_inarray_new(sizeof(unsigned int), 16);
+   cmagics = eina_inarray_new(sizeof(Efreet_Mime_Cache_Magic), 64);
+   entries = eina_inarray_new(sizeof(Efreet_Mime_Cache_Magic_Entry), 256);
+   keys = eina_inarray_new(sizeof(Efreet_Mime_Cache_Magic_Key), 256);
+   if ((!cglobs) || (!literal_items) || (!lower_items) || (!suffixes) ||
+       (!patterns) || (!cmagics) || (!entries) || (!keys))
+     goto end;
+
+   if (wild) eina_hash_foreach(wild, efreet_mime_cache_ext_add, b);
+
+   /* "*" ends up on the root */
+   eina_inarray_push(suffixes, &root);
+   idx = 0;
+   EINA_LIST_FOREACH(globs, l, g)
+     {
+        Efreet_Mime_Cache_Glob cg;
+        Efreet_Mime_Cache_Item item;
+
+        cg.glob = efreet_mime_cache_string_add(b, g->glob);
+        cg.mime = efreet_mime_cache_mime_id(b, g->mime);
+        eina_inarray_push(cglobs, &cg);
+
+        item.value = idx;
+        if (!strpbrk(g->glob, "*?[\\"))
+          {
+             item.key = g->glob;
+             eina_inarray_push(literal_items, &item);
+          }
+        else if ((g->glob[0] == '*') && (!strpbrk(g->glob + 1, "*?[\\")))
+          efreet_mime_cache_suffix_add(suffixes, g->glob + 1, idx);
+        else
+          eina_inarray_push(patterns, &idx);
+
+        /* as efreet_mime_glob_case_match() lowers it */
+        lower = malloc(strlen(g->glob) + 1);
+        if (!lower) goto end;
+        for (p = lower, s = g->glob; *s; s++, p++) *p = tolower(*s);
+        *p = 0;
+        lower_strs = eina_list_append(lower_strs, lower);
+        if (!strpbrk(lower, "*?[\\"))
+          {
+             item.key = lower;
+             eina_inarray_push(lower_items, &item);
+          }
+        idx++;
+     }
+
+   EINA_LIST_FOREACH(magics, l, m)
+     {
+        Efreet_Mime_Cache_Magic cm;
+        Eina_Bool always = EINA_FALSE;
+
+        cm.priority = m->priority;
+        cm.mime = efreet_mime_cache_mime_id(b, m->mime);
+        cm.entries = eina_inarray_count(entries);
+        cm.keys = eina_inarray_count(keys);
+
+        /*
+         * The level a magic ends at carries over to the next one when
+         * that doesn't start at the top, skipping any would change it.
+         */
+        e = eina_list_data_get(m->entries);
+        if ((e) && (e->indent)) prefilter = 0;
+
+        EINA_LIST_FOREACH(m->entries, ll, e)
+          {
+             Efreet_Mime_Cache_Magic_Entry ce;
+             Efreet_Mime_Cache_Magic_Key key;
+
+             ce.indent = e->indent;
+             ce.offset = e->offset;
+             ce.range_len = e->range_len;
+             ce.value_len = e->value_len;
+             ce.value = efreet_mime_cache_bytes_add(b, e->value, e->value_len);
+             ce.mask = 0;
+             if (e->mask)
+               ce.mask = efreet_mime_cache_bytes_add(b, e->mask, e->value_len);
+             eina_inarray_push(entries, &ce);
+
+             if ((e->indent) || (!e->range_len)) continue;
+             if ((!e->value_len) || (e->range_len > EFREET_MIME_MAGIC_KEY_RANGE))
+               {
+                  always = EINA_TRUE;
+                  continue;
+               }
+             key.value_len = e->value_len;
+             key.c = (unsigned char)(e->mask ? (e->value[0] & e->mask[0]) : e->value[0]);
+             for (i = 0; i < e->range_len; i++)
+               {
+                  key.offset = e->offset + i;
+                  eina_inarray_push(keys, &key);
+               }
+          }
+
+        cm.entries_count = eina_inarray_count(entries) - cm.entries;
+        if (always)
+          {
+             while (eina_inarray_count(keys) > cm.keys)
+               eina_inarray_pop(keys);
+          }
+        cm.keys_count = eina_inarray_count(keys) - cm.keys;
+        eina_inarray_push(cmagics, &cm);
+     }
+
+   exts = efreet_mime_cache_table_build(b, b->exts, &i);
+   {
+      Efreet_Mime_Cache header;
+      struct
+      {
+         unsigned int *offset;
+         const void *data;
+         unsigned int size;
+      } sections[] = {
+         { &header.sources, NULL, 0 },
+         { &header.strings, NULL, 0 },
+         { &header.mimes, NULL, 0 },
+         { &header.exts, NULL, 0 },
+         { &header.globs, NULL, 0 },
+         { &header.literals, NULL, 0 },
+         { &header.lowers, NULL, 0 },
+         { &header.suffixes, NULL, 0 },
+         { &header.patterns, NULL, 0 },
+         { &header.magics, NULL, 0 },
+         { &header.entries, NULL, 0 },
+         { &header.keys, NULL, 0 }
+      };
+      unsigned int n;
+
+      memset(&header, 0, sizeof(header));
+      header.exts_size = i;
+      literals = efreet_mime_cache_table_build(b, literal_items, &header.literals_size);
+      lowers = efreet_mime_cache_table_build(b, lower_items, &header.lowers_size);
+      /* nothing is added to the strings after this */
+      eina_binbuf_append_char(b->strings, 0);
+
+#define SECTION(_n, _data, _count, _type) \
+      sections[_n].data = (_data); \
+      sections[_n].size = (_count) * sizeof(_type)
+      header.sources_count = eina_inarray_count(b->sources);
+      SECTION(0, b->sources->members, header.sources_count, Efreet_Mime_Cache_Source);
+      header.strings_size = eina_binbuf_length_get(b->strings);
+      SECTION(1, eina_binbuf_string_get(b->strings), header.strings_size, char);
+      header.mimes_count = eina_inarray_count(b->mimes);
+      SECTION(2, b->mimes->members, header.mimes_count, unsigned int);
+      SECTION(3, exts, header.exts_size, Efreet_Mime_Cache_Bucket);
+      header.globs_count = eina_inarray_count(cglobs);
+      SECTION(4, cglobs->members, header.globs_count, Efreet_Mime_Cache_Glob);
+      SECTION(5, literals, header.literals_size, Efreet_Mime_Cache_Bucket);
+      SECTION(6, lowers, header.lowers_size, Efreet_Mime_Cache_Bucket);
+      header.suffixes_count = eina_inarray_count(suffixes);
+      SECTION(7, suffixes->members, header.suffixes_count, Efreet_Mime_Cache_Suffix);
+      header.patterns_count = eina_inarray_count(patterns);
+      SECTION(8, patterns->members, header.patterns_count, unsigned int);
+      header.magics_count = eina_inarray_count(cmagics);
+      SECTION(9, cmagics->members, header.magics_count, Efreet_Mime_Cache_Magic);
+      header.entries_count = eina_inarray_count(entries);
+      SECTION(10, entries->members, header.entries_count, Efreet_Mime_Cache_Magic_Entry);
+      header.keys_count = eina_inarray_count(keys);
+      SECTION(11, keys->members, header.keys_count, Efreet_Mime_Cache_Magic_Key);
+#undef SECTION
+
+      /* keep every table 8 byte aligned, the map of the file is */
+      size = (sizeof(header) + 7) & ~7;
+      for (n = 0; n < sizeof(sections) / sizeof(sections[0]); n++)
+        {
+           *sections[n].offset = size;
+           size += (sections[n].size + 7) & ~7;
+        }
+
+      header.magic = EFREET_MIME_CACHE_MAGIC;
+      header.major = EFREET_MIME_CACHE_MAJOR;
+      header.minor = EFREET_MIME_CACHE_MINOR;
+      header.size = size;
+      header.prefilter = prefilter;
+
+      c = calloc(1, size);
+      if (!c) goto end;
+      memcpy(c, &header, sizeof(header));
+      for (n = 0; n < sizeof(sections) / sizeof(sections[0]); n++)
+        {
+           if (sections[n].size)
+             memcpy((char *)c + *sections[n].offset, sections[n].data,
+                    sections[n].size);
+        }
+   }
+
+end:
+   EINA_LIST_FREE(lower_strs, lower)
+     free(lower);
+   IF_FREE(exts);
+   IF_FREE(literals);
+   IF_FREE(lowers);
+   if (cglobs) eina_inarray_free(cglobs);
+   if (literal_items) eina_inarray_free(literal_items);
+   if (lower_items) eina_inarray_free(lower_items);
+   if (suffixes) eina_inarray_free(suffixes);
+   if (patterns) eina_inarray_free(patterns);
+   if (cmagics) eina_inarray_free(cmagics);
+   if (entries) eina_inarray_free(entries);
+   if (keys) eina_inarray_free(keys);
+
+   return c;
+}
+
+/**
+ * @internal
+ * @return Returns the cache, to be freed with free(), or NULL on failure
+ * @brief Parses the globs and magics files and compiles them.
+ */
+static Efreet_Mime_Cache *
+efreet_mime_sources_parse(void)
+{
+   Efreet_Mime_Cache_Builder b;
+   Efreet_Mime_Cache *c = NULL;
+   Eina_List *datadirs, *sources;
+   const char *datahome, *path;
+
+   if (!(datahome = efreet_data_home_get()))
+     return NULL;
+
+   if (!(datadirs = efreet_data_dirs_get()))
+     return NULL;
+
+   memset(&b, 0, sizeof(b));
+   b.strings = eina_binbuf_new();
+   b.mime_ids = eina_hash_stringshared_new(NULL);
+   b.sources = eina_inarray_new(sizeof(Efreet_Mime_Cache_Source), 8);
+   b.mimes = eina_inarray_new(sizeof(unsigned int), 256);
+   b.exts = eina_inarray_new(sizeof(Efreet_Mime_Cache_Item), 1024);
+   if ((!b.strings) || (!b.mime_ids) ||
+       (!b.sources) || (!b.mimes) || (!b.exts))
+     goto end;
+   /* no string is at 0 */
+   eina_binbuf_append_char(b.strings, 0);
+
+   /* before reading them, so that changes while we do aren't missed */
+   sources = efreet_mime_sources_get();
+   EINA_LIST_FREE(sources, path)
+     {
+        Efreet_Mime_Cache_Source source;
+
+        efreet_mime_source_stat(path, &source.mtime, &source.size);
+        source.path = efreet_mime_cache_string_add(&b, path);
+        source.pad = 0;
+        eina_inarray_push(b.sources, &source);
+        eina_stringshare_del(path);
+     }
+
+   efreet_mime_load_globs(datadirs, datahome);
+   efreet_mime_load_magics(datadirs, datahome);
+
+   c = efreet_mime_cache_compile(&b);
+
+   IF_FREE_LIST(globs, efreet_mime_glob_free);
+   IF_FREE_LIST(magics, efreet_mime_magic_free);
+   IF_FREE_HASH(wild);
+
+end:
+   if (b.strings) eina_binbuf_free(b.strings);
+   IF_FREE_HASH(b.mime_ids);
+   if (b.sources) eina_inarray_free(b.sources);
+   if (b.mimes) eina_inarray_free(b.mimes);
+   if (b.exts) eina_inarray_free(b.exts);
+
+   return c;
+}
+
+/**
+ * @internal
+ * @param c The cache to check
+ * @param table Offset of the hash table
+ * @param size The number of buckets
+ * @param values Returns EINA_FALSE if a bucket value is not below it
+ * @return Returns EINA_TRUE if efreet_mime_cache_hash_find() can use the
+ * table
+ * @brief Checks a hash table read from the cache file, it needs an empty
+ * bucket for lookups to end.
+ */
+static Eina_Bool
+efreet_mime_cache_table_check(const Efreet_Mime_Cache *c, unsigned int table,
+                              unsigned int size, unsigned int values)
+{
+   const Efreet_Mime_Cache_Bucket *buckets;
+   Eina_Bool empty = EINA_FALSE;
+   unsigned int i;
+
+   if (!size) return EINA_TRUE;
+   if (size & (size - 1)) return EINA_FALSE;
+
+   buckets = (const Efreet_Mime_Cache_Bucket *)((const char *)c + table);
+   for (i = 0; i < size; i++)
+     {
+        if (!buckets[i].key)
+          empty = EINA_TRUE;
+        else if ((buckets[i].key >= c->strings_size) ||
+                 (buckets[i].value >= values))
+          return EINA_FALSE;
+     }
+   return empty;
+}
+
+/**
+ * @internal
+ * @param c The cache to check, its sections already known to be in the file
+ * @return Returns EINA_TRUE if every index and offset in the tables is
+ * within what it refers to
+ * @brief Checks the content of the tables, so lookups never have to.
+ */
+static Eina_Bool
+efreet_mime_cache_tables_check(const Efreet_Mime_Cache *c)
+{
+   const unsigned int *mimes, *patterns;
+   const Efreet_Mime_Cache_Glob *g;
+   const Efreet_Mime_Cache_Suffix *n;
+   const Efreet_Mime_Cache_Magic *m;
+   const Efreet_Mime_Cache_Magic_Entry *e;
+   const Efreet_Mime_Cache_Magic_Key *k;
+   unsigned int i;
+
+#define TABLE(_type, _section) \
+   ((const _type *)((const char *)c + c->_section))
+   mimes = TABLE(unsigned int, mimes);
+   for (i = 0; i < c->mimes_count; i++)
+     if (mimes[i] >= c->strings_size) return EINA_FALSE;
+
+   if ((!efreet_mime_cache_table_check(c, c->exts, c->exts_size,
+                                       c->mimes_count)) ||
+       (!efreet_mime_cache_table_check(c, c->literals, c->literals_size,
+                                       c->globs_count)) ||
+       (!efreet_mime_cache_table_check(c, c->lowers, c->lowers_size,
+                                       c->globs_count)))
+     return EINA_FALSE;
+
+   g = TABLE(Efreet_Mime_Cache_Glob, globs);
+   for (i = 0; i < c->globs_count; i++)
+     {
+        if ((g[i].glob >= c->strings_size) || (g[i].mime >= c->mimes_count))
+          return EINA_FALSE;
+     }
+
+   /* children are added after their parent and siblings before them, so
+    * walking the trie always ends */
+   n = TABLE(Efreet_Mime_Cache_Suffix, suffixes);
+   for (i = 0; i < c->suffixes_count; i++)
+     {
+        if (((n[i].child) &&
+             ((n[i].child <= i) || (n[i].child >= c->suffixes_count))) ||
+            ((n[i].next) && (n[i].next >= i)) ||
+            (n[i].glob > c->globs_count))
+          return EINA_FALSE;
+     }
+
+   patterns = TABLE(unsigned int, patterns);
+   for (i = 0; i < c->patterns_count; i++)
+     if (patterns[i] >= c->globs_count) return EINA_FALSE;
+
+   m = TABLE(Efreet_Mime_Cache_Magic, magics);
+   for (i = 0; i < c->magics_count; i++)
+     {
+        if ((m[i].mime >= c->mimes_count) ||
+            (m[i].entries > c->entries_count) ||
+            (m[i].entries_count > c->entries_count - m[i].entries) ||
+            (m[i].keys > c->keys_count) ||
+            (m[i].keys_count > c->keys_count - m[i].keys))
+          return EINA_FALSE;
+     }
+
+   /* the offsets in the file they look at must not wrap either */
+   e = TABLE(Efreet_Mime_Cache_Magic_Entry, entries);
+   for (i = 0; i < c->entries_count; i++)
+     {
+        if ((e[i].value >= c->strings_size) ||
+            (e[i].value_len > c->strings_size - e[i].value) ||
+            ((e[i].mask) &&
+             ((e[i].mask >= c->strings_size) ||
+              (e[i].value_len > c->strings_size - e[i].mask))) ||
+            ((unsigned long long)e[i].offset + e[i].range_len +
+             e[i].value_len > 0xffffffffULL))
+          return EINA_FALSE;
+     }
+
+   k = TABLE(Efreet_Mime_Cache_Magic_Key, keys);
+   for (i = 0; i < c->keys_count; i++)
+     {
+        if ((unsigned long long)k[i].offset + k[i].value_len > 0xffffffffULL)
+          return EINA_FALSE;
+     }
+#undef TABLE
+
+   return EINA_TRUE;
+}
+
+/**
+ * @internal
+ * @param c The cache to check
+ * @param size The size of the cache file
+ * @return Returns EINA_TRUE if the cache can be used
+ * @brief Checks the cache is sound and that none of the files it was
+ * compiled from changed since.
+ */
+static Eina_Bool
+efreet_mime_cache_check(const Efreet_Mime_Cache *c, size_t size)
+{
+   const Efreet_Mime_Cache_Source *source;
+   Eina_List *sources;
+   const char *path;
+   Eina_Bool ret = EINA_TRUE;
+   long long mtime, fsize;
+
+   if ((size < sizeof(*c)) ||
+       (c->magic != EFREET_MIME_CACHE_MAGIC) ||
+       (c->major != EFREET_MIME_CACHE_MAJOR) ||
+       (c->size != size))
+     return EINA_FALSE;
+
+#define SECTION_CHECK(_offset, _count, _type) \
+   if ((c->_offset > size) || ((_count) > (size - c->_offset) / sizeof(_type))) \
+     return EINA_FALSE
+   SECTION_CHECK(sources, c->sources_count, Efreet_Mime_Cache_Source);
+   SECTION_CHECK(strings, c->strings_size, char);
+   SECTION_CHECK(mimes, c->mimes_count, unsigned int);
+   SECTION_CHECK(exts, c->exts_size, Efreet_Mime_Cache_Bucket);
+   SECTION_CHECK(globs, c->globs_count, Efreet_Mime_Cache_Glob);
+   SECTION_CHECK(literals, c->literals_size, Efreet_Mime_Cache_Bucket);
+   SECTION_CHECK(lowers, c->lowers_size, Efreet_Mime_Cache_Bucket);
+   SECTION_CHECK(suffixes, c->suffixes_count, Efreet_Mime_Cache_Suffix);
+   SECTION_CHECK(patterns, c->patterns_count, unsigned int);
+   SECTION_CHECK(magics, c->magics_count, Efreet_Mime_Cache_Magic);
+   SECTION_CHECK(entries, c->entries_count, Efreet_Mime_Cache_Magic_Entry);
+   SECTION_CHECK(keys, c->keys_count, Efreet_Mime_Cache_Magic_Key);
+#undef SECTION_CHECK
+   if ((!c->strings_size) || (!c->suffixes_count) ||
+       (((const char *)c)[c->strings + c->strings_size - 1]) ||
+       (!efreet_mime_cache_tables_check(c)))
+     return EINA_FALSE;
+
+   source = (const Efreet_Mime_Cache_Source *)((const char *)c + c->sources);
+   sources = efreet_mime_sources_get();
+   if (eina_list_count(sources) != c->sources_count)
+     ret = EINA_FALSE;
+   EINA_LIST_FREE(sources, path)
+     {
+        if (ret)
+          {
+             efreet_mime_source_stat(path, &mtime, &fsize);
+             if ((source->path >= c->strings_size) ||
+                 (strcmp(path, (const char *)c + c->strings + source->path)) ||
+                 (source->mtime != mtime) || (source->size != fsize))
+               ret = EINA_FALSE;
+             source++;
+          }
+        eina_stringshare_del(path);
+     }
+
+   return ret;
+}
+
+/**
+ * @internal
+ * @param path The cache file
+ * @param file Returns the open file backing the cache
+ * @return Returns the mapped cache if it can be used, NULL otherwise
+ * @brief Maps the cache file efreetd keeps.
+ */
+static Efreet_Mime_Cache *
+efreet_mime_cache_map(const char *path, Eina_File **file)
+{
+   Efreet_Mime_Cache *c;
+   Eina_File *f;
+
+   f = eina_file_open(path, EINA_FALSE);
+   if (!f) return NULL;
+
+   c = eina_file_map_all(f, EINA_FILE_RANDOM);
+   if (!c) goto on_error;
+   if (!efreet_mime_cache_check(c, eina_file_size_get(f)))
+     {
+        eina_file_map_free(f, c);
+        goto on_error;
+     }
+
+   *file = f;
+   return c;
+
+on_error:
+   eina_file_close(f);
+   return NULL;
+}
+
+static void
+efreet_mime_cache_free(void)
+{
+   unsigned int i;
+
+   if (cache_mimes)
+     {
+        for (i = 0; i < cache->mimes_count; i++)
+          IF_RELEASE(cache_mimes[i]);
+        FREE(cache_mimes);
+     }
+
+   if (cache_file)
+     {
+        eina_file_map_free(cache_file, cache);
+        eina_file_close(cache_file);
+        cache_file = NULL;
+     }
+   else
+     IF_FREE(cache);
+   cache = NULL;
+}
+
+/**
+ * @internal
+ * @return Returns no value
+ * @brief Loads the globs and magics, from the cache when it is up to date
+ * and by parsing the files otherwise.
+ */
+static void
+efreet_mime_load(void)
+{
+   efreet_mime_cache_free();
+
+   cache = efreet_mime_cache_map(efreet_mime_cache_file(), &cache_file);
+   if (!cache)
+     {
+        INF("No up to date mime cache, parsing globs and magics");
+        cache = efreet_mime_sources_parse();
+     }
+   if ((cache) && (cache->mimes_count))
+     cache_mimes = NEW(const char *, cache->mimes_count);
+}
+
+static const char *
+efreet_mime_cache_mime_get(unsigned int id)
+{
+   const unsigned int *mimes;
+
+   if ((!cache_mimes) || (id >= cache->mimes_count)) return NULL;
+   if (!cache_mimes[id])
+     {
+        mimes = EFREET_MIME_CACHE_GET(unsigned int, mimes);
+        cache_mimes[id] = eina_stringshare_add(EFREET_MIME_CACHE_STRING(mimes[id]));
+     }
+   return cache_mimes[id];
+}
+
+static unsigned int
+efreet_mime_cache_hash_find(unsigned int table, unsigned int size,
+                            const char *key)
+{
+   const Efreet_Mime_Cache_Bucket *buckets;
+   unsigned int h;
+
+   if (!size) return EFREET_MIME_CACHE_NONE;
+
+   buckets = (const Efreet_Mime_Cache_Bucket *)((const char *)cache + table);
+   h = (unsigned int)eina_hash_superfast(key, strlen(key)) & (size - 1);
+   while (buckets[h].key)
+     {
+        if (!strcmp(EFREET_MIME_CACHE_STRING(buckets[h].key), key))
+          return buckets[h].value;
+        h = (h + 1) & (size - 1);
+     }
+   return EFREET_MIME_CACHE_NONE;
+}
+
 /**
  * @internal
  * @param data Data pointer passed to monitor_add
@@ -559,30 +1578,16 @@ efreet_mime_load_magics(Eina_List *datadirs, const char *datahome)
  * @param event The type of event
  * @param path Path to the file that was updated
  * @return Returns no value
- * @brief Callback for all file monitors.  Just reloads the appropriate
- * list depending on which file changed.  If it was a magic file
- * only the magic list is updated.  If it was a glob file or /etc/mime.types,
- * the globs are updated.
+ * @brief Callback for all file monitors.  Reloads the globs and magics,
+ * from the cache if efreetd already caught up with the change.
  */
 static void
 efreet_mime_cb_update_file(void *data EINA_UNUSED,
                            Ecore_File_Monitor *monitor EINA_UNUSED,
                            Ecore_File_Event event EINA_UNUSED,
-                           const char *path)
+                           const char *path EINA_UNUSED)
 {
-   Eina_List *datadirs = NULL;
-   const char *datahome = NULL;
-
-   if (!(datahome = efreet_data_home_get()))
-     return;
-
-   if (!(datadirs = efreet_data_dirs_get()))
-     return;
-
-   if (strstr(path, "magic"))
-     efreet_mime_load_magics(datadirs, datahome);
-   else
-     efreet_mime_load_globs(datadirs, datahome);
+   efreet_mime_load();
 }
 
 /**
@@ -622,8 +1627,7 @@ efreet_mime_init_files(void)
    efreet_mime_monitor_add("/etc/mime.types");
 
    /* Load our mime information */
-   efreet_mime_load_globs(datadirs, datahome);
-   efreet_mime_load_magics(datadirs, datahome);
+   efreet_mime_load();
 
    _mime_inode_symlink		   = eina_stringshare_add("inode/symlink");
    _mime_inode_fifo		   = eina_stringshare_add("inode/fifo");
@@ -1236,11 +2240,13 @@ efreet_mime_magic_check_priority(const char *file,
                                  unsigned int start,
                                  unsigned int end)
 {
-   Efreet_Mime_Magic *m = NULL;
-   Efreet_Mime_Magic_Entry *e = NULL;
-   Eina_List *l, *ll;
+   const Efreet_Mime_Cache_Magic *magic, *m;
+   const Efreet_Mime_Cache_Magic_Entry *entries, *e;
+   const Efreet_Mime_Cache_Magic_Key *keys, *k;
+   const char *value, *mask;
    FILE *f = NULL;
    unsigned int i = 0, offset = 0,level = 0, match = 0, bytes_read = 0;
+   unsigned int j, n;
    const char *last_mime = NULL;
    int c;
    char v, buf[EFREET_MIME_MAGIC_BUFFER_SIZE];
@@ -1248,7 +2254,7 @@ efreet_mime_magic_check_priority(const char *file,
    f = fopen(file, "rb");
    if (!f) return NULL;
 
-   if (!magics)
+   if ((!cache) || (!cache->magics_count))
      {
         fclose(f);
         return NULL;
@@ -1260,16 +2266,33 @@ efreet_mime_magic_check_priority(const char *file,
         return NULL;
      }
 
-   EINA_LIST_FOREACH(magics, l, m)
+   magic = EFREET_MIME_CACHE_GET(Efreet_Mime_Cache_Magic, magics);
+   entries = EFREET_MIME_CACHE_GET(Efreet_Mime_Cache_Magic_Entry, entries);
+   keys = EFREET_MIME_CACHE_GET(Efreet_Mime_Cache_Magic_Key, keys);
+   for (j = 0; j < cache->magics_count; j++)
      {
+        m = magic + j;
         if ((start != 0) && (m->priority > start))
           continue;
 
         if (m->priority < end)
           break;
 
-        EINA_LIST_FOREACH(m->entries, ll, e)
+        /* skip the magic if none of its top level entries can match */
+        if ((cache->prefilter) && (m->keys_count))
+          {
+             for (k = keys + m->keys; k < keys + m->keys + m->keys_count; k++)
+               {
+                  if ((k->offset + k->value_len) > bytes_read) break;
+                  if ((unsigned char)buf[k->offset] == k->c) break;
+               }
+             if (k == keys + m->keys + m->keys_count)
+               continue;
+          }
+
+        for (n = 0; n < m->entries_count; n++)
           {
+             e = entries + m->entries + n;
              if ((level < e->indent) && !match)
                continue;
 
@@ -1282,6 +2305,8 @@ efreet_mime_magic_check_priority(const char *file,
                   return last_mime;
                }
 
+             value = EFREET_MIME_CACHE_STRING(e->value);
+             mask = e->mask ? EFREET_MIME_CACHE_STRING(e->mask) : NULL;
              for (offset = e->offset; offset < e->offset + e->range_len; offset++)
                {
                   if (((offset + e->value_len) > bytes_read) &&
@@ -1296,8 +2321,8 @@ efreet_mime_magic_check_priority(const char *file,
                        else
                          c = buf[offset + i];
 
-                       v = e->value[i];
-                       if (e->mask) v &= e->mask[i];
+                       v = value[i];
+                       if (mask) v &= mask[i];
 
                        if (!(c == v))
                          {
@@ -1309,7 +2334,7 @@ efreet_mime_magic_check_priority(const char *file,
                   if (match)
                     {
                        level += 1;
-                       last_mime = m->mime;
+                       last_mime = efreet_mime_cache_mime_get(m->mime);
                        break;
                     }
                }
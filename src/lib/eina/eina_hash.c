@@ -66,8 +66,12 @@
 
 #define EINA_HASH_RBTREE_MASK       0xFFFF
 
+#define EINA_HASH_FLAT_POWER_MIN    3
+#define EINA_HASH_FLAT_POWER_MAX    30
+
 typedef struct _Eina_Hash_Head         Eina_Hash_Head;
 typedef struct _Eina_Hash_Element      Eina_Hash_Element;
+typedef struct _Eina_Hash_Slot         Eina_Hash_Slot;
 typedef struct _Eina_Hash_Foreach_Data Eina_Hash_Foreach_Data;
 typedef struct _Eina_Iterator_Hash     Eina_Iterator_Hash;
 typedef struct _Eina_Hash_Each         Eina_Hash_Each;
@@ -80,6 +84,7 @@ struct _Eina_Hash
    Eina_Free_Cb    data_free_cb;
 
    Eina_Rbtree   **buckets;
+   Eina_Hash_Slot *slots;
    int             size;
    int             mask;
 
@@ -87,6 +92,8 @@ struct _Eina_Hash
 
    int             buckets_power_size;
 
+   Eina_Bool       flat : 1;
+
    EINA_MAGIC
 };
 
@@ -105,6 +112,16 @@ struct _Eina_Hash_Element
    Eina_Hash_Tuple tuple;
 };
 
+/* One entry of a flat hash, stored inline in the slot array. distance is
+   the probe distance from the home slot plus one, 0 marks an empty slot. */
+struct _Eina_Hash_Slot
+{
+   Eina_Hash_Tuple tuple;
+   int             hash;
+   unsigned int    distance : 31;
+   unsigned int    owned : 1;
+};
+
 struct _Eina_Hash_Foreach_Data
 {
    Eina_Hash_Foreach cb;
@@ -126,6 +143,7 @@ struct _Eina_Iterator_Hash
    Eina_Iterator                     *list;
    Eina_Hash_Head                    *hash_head;
    Eina_Hash_Element                 *hash_element;
+   Eina_Hash_Tuple                   *tuple;
    int                                bucket;
 
    int                                index;
@@ -206,6 +224,215 @@ _eina_hash_key_rbtree_cmp_node(const Eina_Hash_Element *left,
    return EINA_RBTREE_RIGHT;
 }
 
+/* Flat hash: a single open addressed array of slots using robin hood
+   probing and backward shift deletion, so a lookup walks contiguous memory
+   and only touches the key when the stored hash matches. */
+
+static inline unsigned int
+_eina_hash_flat_home(const Eina_Hash *hash, int key_hash)
+{
+   /* Fibonacci hashing spreads weak hashes (djb2, small integers) over
+      the high bits we use. */
+   return ((unsigned int)key_hash * 0x9E3779B1U)
+     >> (32 - hash->buckets_power_size);
+}
+
+static void
+_eina_hash_flat_insert(Eina_Hash *hash, Eina_Hash_Slot slot)
+{
+   Eina_Hash_Slot tmp;
+   unsigned int idx;
+
+   slot.distance = 1;
+   idx = _eina_hash_flat_home(hash, slot.hash);
+
+   while (hash->slots[idx].distance)
+     {
+        /* Steal the slot from richer entries. */
+        if (hash->slots[idx].distance < slot.distance)
+          {
+             tmp = hash->slots[idx];
+             hash->slots[idx] = slot;
+             slot = tmp;
+          }
+
+        slot.distance++;
+        idx = (idx + 1) & hash->mask;
+     }
+
+   hash->slots[idx] = slot;
+}
+
+static Eina_Bool
+_eina_hash_flat_grow(Eina_Hash *hash)
+{
+   Eina_Hash_Slot *old_slots = hash->slots;
+   int old_size = hash->size;
+   int power;
+   int i;
+
+   power = old_slots ? hash->buckets_power_size + 1 : EINA_HASH_FLAT_POWER_MIN;
+   if (power > EINA_HASH_FLAT_POWER_MAX)
+     return EINA_FALSE;
+
+   hash->slots = calloc(1 << power, sizeof (Eina_Hash_Slot));
+   if (!hash->slots)
+     {
+        hash->slots = old_slots;
+        return EINA_FALSE;
+     }
+
+   hash->buckets_power_size = power;
+   hash->size = 1 << power;
+   hash->mask = hash->size - 1;
+
+   for (i = 0; i < old_size; i++)
+     if (old_slots[i].distance)
+       _eina_hash_flat_insert(hash, old_slots[i]);
+
+   free(old_slots);
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_eina_hash_flat_add(Eina_Hash *hash,
+                    const void *key, int key_length, int alloc_length,
+                    int key_hash,
+                    const void *data)
+{
+   Eina_Hash_Slot slot;
+
+   /* Keep the load factor under 7/8. */
+   if (((hash->population + 1) * 8 > hash->size * 7) &&
+       (!_eina_hash_flat_grow(hash)))
+     return EINA_FALSE;
+
+   slot.tuple.key_length = key_length;
+   slot.tuple.data = (void *)data;
+   slot.hash = key_hash;
+   slot.owned = 0;
+   if (alloc_length > 0)
+     {
+        slot.tuple.key = malloc(alloc_length);
+        if (!slot.tuple.key)
+          return EINA_FALSE;
+        memcpy((char *)slot.tuple.key, key, alloc_length);
+        slot.owned = 1;
+     }
+   else
+     slot.tuple.key = key;
+
+   /* Like the rbtree variant, duplicated keys are not looked up. */
+   _eina_hash_flat_insert(hash, slot);
+   hash->population++;
+   return EINA_TRUE;
+}
+
+static Eina_Hash_Slot *
+_eina_hash_flat_find_by_hash(const Eina_Hash *hash,
+                             const Eina_Hash_Tuple *tuple,
+                             int key_hash)
+{
+   Eina_Hash_Slot *slot;
+   unsigned int distance;
+   unsigned int idx;
+
+   if (!hash->slots)
+     return NULL;
+
+   idx = _eina_hash_flat_home(hash, key_hash);
+   for (distance = 1; ; distance++)
+     {
+        slot = hash->slots + idx;
+
+        /* An empty slot or a richer entry ends the probe sequence. */
+        if (slot->distance < distance)
+          return NULL;
+
+        if ((slot->hash == key_hash) &&
+            (!hash->key_cmp_cb(slot->tuple.key, slot->tuple.key_length,
+                               tuple->key, tuple->key_length)) &&
+            ((!tuple->data) || (tuple->data == slot->tuple.data)))
+          return slot;
+
+        idx = (idx + 1) & hash->mask;
+     }
+}
+
+static Eina_Hash_Slot *
+_eina_hash_flat_find_by_data(const Eina_Hash *hash, const void *data)
+{
+   int i;
+
+   if (!hash->slots)
+     return NULL;
+
+   for (i = 0; i < hash->size; i++)
+     if ((hash->slots[i].distance) && (hash->slots[i].tuple.data == data))
+       return hash->slots + i;
+
+   return NULL;
+}
+
+static Eina_Bool
+_eina_hash_flat_del(Eina_Hash *hash, Eina_Hash_Slot *slot)
+{
+   Eina_Hash_Tuple tuple = slot->tuple;
+   Eina_Bool owned = slot->owned;
+   unsigned int idx, next;
+
+   /* Shift the following entries back instead of leaving a tombstone. */
+   idx = slot - hash->slots;
+   for (next = (idx + 1) & hash->mask;
+        hash->slots[next].distance > 1;
+        next = (next + 1) & hash->mask)
+     {
+        hash->slots[idx] = hash->slots[next];
+        hash->slots[idx].distance--;
+        idx = next;
+     }
+   hash->slots[idx].distance = 0;
+
+   hash->population--;
+   if (hash->population == 0)
+     {
+        free(hash->slots);
+        hash->slots = NULL;
+        hash->size = 0;
+        hash->mask = 0;
+     }
+
+   if (hash->data_free_cb)
+     hash->data_free_cb(tuple.data);
+   if (owned)
+     free((void *)tuple.key);
+
+   return EINA_TRUE;
+}
+
+static void
+_eina_hash_flat_free(Eina_Hash *hash)
+{
+   int i;
+
+   for (i = 0; i < hash->size; i++)
+     {
+        if (!hash->slots[i].distance)
+          continue;
+
+        if (hash->data_free_cb)
+          hash->data_free_cb(hash->slots[i].tuple.data);
+        if (hash->slots[i].owned)
+          free((void *)hash->slots[i].tuple.key);
+     }
+
+   free(hash->slots);
+   hash->slots = NULL;
+   hash->size = 0;
+   hash->mask = 0;
+   hash->population = 0;
+}
+
 static inline Eina_Bool
 eina_hash_add_alloc_by_hash(Eina_Hash *hash,
                             const void *key, int key_length, int alloc_length,
@@ -221,6 +448,10 @@ eina_hash_add_alloc_by_hash(Eina_Hash *hash,
    EINA_SAFETY_ON_NULL_RETURN_VAL(data, EINA_FALSE);
    EINA_MAGIC_CHECK_HASH(hash);
 
+   if (hash->flat)
+     return _eina_hash_flat_add(hash, key, key_length, alloc_length,
+                                key_hash, data);
+
    /* Apply eina mask to hash. */
    hash_num = key_hash & hash->mask;
    key_hash >>= hash->buckets_power_size;
@@ -452,13 +683,24 @@ _eina_hash_del_by_key_hash(Eina_Hash *hash,
    EINA_SAFETY_ON_NULL_RETURN_VAL(key, EINA_FALSE);
    EINA_MAGIC_CHECK_HASH(hash);
 
-   if (!hash->buckets)
+   if (!hash->population)
      return EINA_FALSE;
 
    tuple.key = (void *)key;
    tuple.key_length = key_length;
    tuple.data = (void *)data;
 
+   if (hash->flat)
+     {
+        Eina_Hash_Slot *slot;
+
+        slot = _eina_hash_flat_find_by_hash(hash, &tuple, key_hash);
+        if (!slot)
+          return EINA_FALSE;
+
+        return _eina_hash_flat_del(hash, slot);
+     }
+
    hash_element = _eina_hash_find_by_hash(hash, &tuple, key_hash, &hash_head);
    if (!hash_element)
      return EINA_FALSE;
@@ -475,7 +717,7 @@ _eina_hash_del_by_key(Eina_Hash *hash, const void *key, const void *data)
    EINA_SAFETY_ON_NULL_RETURN_VAL(key, EINA_FALSE);
    EINA_MAGIC_CHECK_HASH(hash);
 
-   if (!hash->buckets)
+   if (!hash->population)
      return EINA_FALSE;
 
    key_length = hash->key_length_cb ? hash->key_length_cb(key) : 0;
@@ -510,6 +752,21 @@ _eina_stringshared_key_cmp(const char *key1, EINA_UNUSED int key1_length,
    return key1 - key2;
 }
 
+static int
+_eina_stringshared_key_hash(const char *key, EINA_UNUSED int key_length)
+{
+   /* Stringshared keys are compared by pointer, so hash the pointer too. */
+#ifdef EFL64
+   unsigned long long int ptr = (uintptr_t)key;
+
+   return eina_hash_int64(&ptr, sizeof (ptr));
+#else
+   unsigned int ptr = (uintptr_t)key;
+
+   return eina_hash_int32(&ptr, sizeof (ptr));
+#endif
+}
+
 static unsigned int
 _eina_int32_key_length(EINA_UNUSED const uint32_t *key)
 {
@@ -550,46 +807,46 @@ _eina_foreach_cb(const Eina_Hash *hash,
 static void *
 _eina_hash_iterator_data_get_content(Eina_Iterator_Hash *it)
 {
-   Eina_Hash_Element *stuff;
+   Eina_Hash_Tuple *stuff;
 
    EINA_MAGIC_CHECK_HASH_ITERATOR(it, NULL);
 
-   stuff = it->hash_element;
+   stuff = it->tuple;
 
    if (!stuff)
      return NULL;
 
-   return stuff->tuple.data;
+   return stuff->data;
 }
 
 static void *
 _eina_hash_iterator_key_get_content(Eina_Iterator_Hash *it)
 {
-   Eina_Hash_Element *stuff;
+   Eina_Hash_Tuple *stuff;
 
    EINA_MAGIC_CHECK_HASH_ITERATOR(it, NULL);
 
-   stuff = it->hash_element;
+   stuff = it->tuple;
 
    if (!stuff)
      return NULL;
 
-   return (void *)stuff->tuple.key;
+   return (void *)stuff->key;
 }
 
 static Eina_Hash_Tuple *
 _eina_hash_iterator_tuple_get_content(Eina_Iterator_Hash *it)
 {
-   Eina_Hash_Element *stuff;
+   Eina_Hash_Tuple *stuff;
 
    EINA_MAGIC_CHECK_HASH_ITERATOR(it, NULL);
 
-   stuff = it->hash_element;
+   stuff = it->tuple;
 
    if (!stuff)
      return NULL;
 
-   return &stuff->tuple;
+   return stuff;
 }
 
 static Eina_Bool
@@ -663,11 +920,37 @@ _eina_hash_iterator_next(Eina_Iterator_Hash *it, void **data)
    it->bucket = bucket;
 
    if (ok)
-     *data = it->get_content(it);
+     {
+        it->tuple = &it->hash_element->tuple;
+        *data = it->get_content(it);
+     }
 
    return ok;
 }
 
+static Eina_Bool
+_eina_hash_flat_iterator_next(Eina_Iterator_Hash *it, void **data)
+{
+   Eina_Hash_Slot *slot;
+
+   if (!(it->index < it->hash->population))
+     return EINA_FALSE;
+
+   while (it->bucket < it->hash->size)
+     {
+        slot = it->hash->slots + it->bucket++;
+        if (!slot->distance)
+          continue;
+
+        it->index++;
+        it->tuple = &slot->tuple;
+        *data = it->get_content(it);
+        return EINA_TRUE;
+     }
+
+   return EINA_FALSE;
+}
+
 static void *
 _eina_hash_iterator_get_container(Eina_Iterator_Hash *it)
 {
@@ -735,7 +1018,9 @@ eina_hash_new(Eina_Key_Length key_length_cb,
    new->key_hash_cb = key_hash_cb;
    new->data_free_cb = data_free_cb;
    new->buckets = NULL;
+   new->slots = NULL;
    new->population = 0;
+   new->flat = EINA_FALSE;
 
    new->size = 1 << buckets_power_size;
    new->mask = new->size - 1;
@@ -825,6 +1110,74 @@ eina_hash_stringshared_new(Eina_Free_Cb data_free_cb)
                         EINA_HASH_BUCKET_SIZE);
 }
 
+EAPI Eina_Hash *
+eina_hash_flat_new(Eina_Key_Length key_length_cb,
+                   Eina_Key_Cmp key_cmp_cb,
+                   Eina_Key_Hash key_hash_cb,
+                   Eina_Free_Cb data_free_cb)
+{
+   Eina_Hash *new;
+
+   new = eina_hash_new(key_length_cb, key_cmp_cb, key_hash_cb, data_free_cb,
+                       EINA_HASH_FLAT_POWER_MIN);
+   if (!new)
+     return NULL;
+
+   /* The slot array is allocated on first add and grows with population. */
+   new->flat = EINA_TRUE;
+   new->size = 0;
+   new->mask = 0;
+   new->buckets_power_size = 0;
+
+   return new;
+}
+
+EAPI Eina_Hash *
+eina_hash_string_flat_new(Eina_Free_Cb data_free_cb)
+{
+   return eina_hash_flat_new(EINA_KEY_LENGTH(_eina_string_key_length),
+                             EINA_KEY_CMP(_eina_string_key_cmp),
+                             EINA_KEY_HASH(eina_hash_superfast),
+                             data_free_cb);
+}
+
+EAPI Eina_Hash *
+eina_hash_int32_flat_new(Eina_Free_Cb data_free_cb)
+{
+   return eina_hash_flat_new(EINA_KEY_LENGTH(_eina_int32_key_length),
+                             EINA_KEY_CMP(_eina_int32_key_cmp),
+                             EINA_KEY_HASH(eina_hash_int32),
+                             data_free_cb);
+}
+
+EAPI Eina_Hash *
+eina_hash_int64_flat_new(Eina_Free_Cb data_free_cb)
+{
+   return eina_hash_flat_new(EINA_KEY_LENGTH(_eina_int64_key_length),
+                             EINA_KEY_CMP(_eina_int64_key_cmp),
+                             EINA_KEY_HASH(eina_hash_int64),
+                             data_free_cb);
+}
+
+EAPI Eina_Hash *
+eina_hash_pointer_flat_new(Eina_Free_Cb data_free_cb)
+{
+#ifdef EFL64
+   return eina_hash_int64_flat_new(data_free_cb);
+#else
+   return eina_hash_int32_flat_new(data_free_cb);
+#endif
+}
+
+EAPI Eina_Hash *
+eina_hash_stringshared_flat_new(Eina_Free_Cb data_free_cb)
+{
+   return eina_hash_flat_new(NULL,
+                             EINA_KEY_CMP(_eina_stringshared_key_cmp),
+                             EINA_KEY_HASH(_eina_stringshared_key_hash),
+                             data_free_cb);
+}
+
 EAPI int
 eina_hash_population(const Eina_Hash *hash)
 {
@@ -844,7 +1197,9 @@ eina_hash_free(Eina_Hash *hash)
 
    EINA_MAGIC_CHECK_HASH(hash);
 
-   if (hash->buckets)
+   if (hash->slots)
+     _eina_hash_flat_free(hash);
+   else if (hash->buckets)
      {
         for (i = 0; i < hash->size; i++)
           eina_rbtree_delete(hash->buckets[i], EINA_RBTREE_FREE_CB(_eina_hash_head_free), hash);
@@ -862,7 +1217,9 @@ eina_hash_free_buckets(Eina_Hash *hash)
 
    EINA_MAGIC_CHECK_HASH(hash);
 
-   if (hash->buckets)
+   if (hash->slots)
+     _eina_hash_flat_free(hash);
+   else if (hash->buckets)
      {
         for (i = 0; i < hash->size; i++)
           eina_rbtree_delete(hash->buckets[i],
@@ -966,6 +1323,17 @@ eina_hash_del_by_data(Eina_Hash *hash, const void *data)
    EINA_SAFETY_ON_NULL_RETURN_VAL(data, EINA_FALSE);
    EINA_MAGIC_CHECK_HASH(hash);
 
+   if (hash->flat)
+     {
+        Eina_Hash_Slot *slot;
+
+        slot = _eina_hash_flat_find_by_data(hash, data);
+        if (!slot)
+          goto error;
+
+        return _eina_hash_flat_del(hash, slot);
+     }
+
    hash_element = _eina_hash_find_by_data(hash, data, &key_hash, &hash_head);
    if (!hash_element)
      goto error;
@@ -1031,6 +1399,17 @@ eina_hash_find_by_hash(const Eina_Hash *hash,
    tuple.key_length = key_length;
    tuple.data = NULL;
 
+   if (hash->flat)
+     {
+        Eina_Hash_Slot *slot;
+
+        slot = _eina_hash_flat_find_by_hash(hash, &tuple, key_hash);
+        if (slot)
+          return slot->tuple.data;
+
+        return NULL;
+     }
+
    hash_element = _eina_hash_find_by_hash(hash, &tuple, key_hash, &hash_head);
    if (hash_element)
      return hash_element->tuple.data;
@@ -1078,6 +1457,20 @@ eina_hash_modify_by_hash(Eina_Hash *hash,
    tuple.key_length = key_length;
    tuple.data = NULL;
 
+   if (hash->flat)
+     {
+        Eina_Hash_Slot *slot;
+
+        slot = _eina_hash_flat_find_by_hash(hash, &tuple, key_hash);
+        if (slot)
+          {
+             old_data = slot->tuple.data;
+             slot->tuple.data = (void *)data;
+          }
+
+        return old_data;
+     }
+
    hash_element = _eina_hash_find_by_hash(hash, &tuple, key_hash, &hash_head);
    if (hash_element)
      {
@@ -1109,26 +1502,55 @@ eina_hash_set(Eina_Hash *hash, const void *key, const void *data)
    tuple.key_length = key_length;
    tuple.data = NULL;
 
-   hash_element = _eina_hash_find_by_hash(hash, &tuple, key_hash, &hash_head);
-   if (hash_element)
+   if (hash->flat)
      {
-        void *old_data = NULL;
-
-        old_data = hash_element->tuple.data;
+        Eina_Hash_Slot *slot;
 
-        if (data)
+        slot = _eina_hash_flat_find_by_hash(hash, &tuple, key_hash);
+        if (slot)
           {
-             hash_element->tuple.data = (void *)data;
+             void *old_data = slot->tuple.data;
+
+             if (data)
+               {
+                  slot->tuple.data = (void *)data;
+               }
+             else
+               {
+                  Eina_Free_Cb cb = hash->data_free_cb;
+                  hash->data_free_cb = NULL;
+                  _eina_hash_flat_del(hash, slot);
+                  hash->data_free_cb = cb;
+               }
+
+             return old_data;
           }
-        else
+     }
+   else
+     {
+        hash_element = _eina_hash_find_by_hash(hash, &tuple, key_hash,
+                                               &hash_head);
+        if (hash_element)
           {
-             Eina_Free_Cb cb = hash->data_free_cb;
-             hash->data_free_cb = NULL;
-             _eina_hash_del_by_hash_el(hash, hash_element, hash_head, key_hash);
-             hash->data_free_cb = cb;
-          }
+             void *old_data = NULL;
 
-        return old_data;
+             old_data = hash_element->tuple.data;
+
+             if (data)
+               {
+                  hash_element->tuple.data = (void *)data;
+               }
+             else
+               {
+                  Eina_Free_Cb cb = hash->data_free_cb;
+                  hash->data_free_cb = NULL;
+                  _eina_hash_del_by_hash_el(hash, hash_element, hash_head,
+                                            key_hash);
+                  hash->data_free_cb = cb;
+               }
+
+             return old_data;
+          }
      }
 
    if (!data) return NULL;
@@ -1230,7 +1652,10 @@ eina_hash_iterator_data_new(const Eina_Hash *hash)
    it->get_content = FUNC_ITERATOR_GET_CONTENT(_eina_hash_iterator_data_get_content);
 
    it->iterator.version = EINA_ITERATOR_VERSION;
-   it->iterator.next = FUNC_ITERATOR_NEXT(_eina_hash_iterator_next);
+   if (hash->flat)
+     it->iterator.next = FUNC_ITERATOR_NEXT(_eina_hash_flat_iterator_next);
+   else
+     it->iterator.next = FUNC_ITERATOR_NEXT(_eina_hash_iterator_next);
    it->iterator.get_container = FUNC_ITERATOR_GET_CONTAINER(
        _eina_hash_iterator_get_container);
    it->iterator.free = FUNC_ITERATOR_FREE(_eina_hash_iterator_free);
@@ -1257,7 +1682,10 @@ eina_hash_iterator_key_new(const Eina_Hash *hash)
        _eina_hash_iterator_key_get_content);
 
    it->iterator.version = EINA_ITERATOR_VERSION;
-   it->iterator.next = FUNC_ITERATOR_NEXT(_eina_hash_iterator_next);
+   if (hash->flat)
+     it->iterator.next = FUNC_ITERATOR_NEXT(_eina_hash_flat_iterator_next);
+   else
+     it->iterator.next = FUNC_ITERATOR_NEXT(_eina_hash_iterator_next);
    it->iterator.get_container = FUNC_ITERATOR_GET_CONTAINER(
        _eina_hash_iterator_get_container);
    it->iterator.free = FUNC_ITERATOR_FREE(_eina_hash_iterator_free);
@@ -1284,7 +1712,10 @@ eina_hash_iterator_tuple_new(const Eina_Hash *hash)
        _eina_hash_iterator_tuple_get_content);
 
    it->iterator.version = EINA_ITERATOR_VERSION;
-   it->iterator.next = FUNC_ITERATOR_NEXT(_eina_hash_iterator_next);
+   if (hash->flat)
+     it->iterator.next = FUNC_ITERATOR_NEXT(_eina_hash_flat_iterator_next);
+   else
+     it->iterator.next = FUNC_ITERATOR_NEXT(_eina_hash_iterator_next);
    it->iterator.get_container = FUNC_ITERATOR_GET_CONTAINER(
        _eina_hash_iterator_get_container);
    it->iterator.free = FUNC_ITERATOR_FREE(_eina_hash_iterator_free);
@@ -500,6 +500,121 @@ EAPI Eina_Hash *eina_hash_pointer_new(Eina_Free_Cb data_free_cb);
  */
 EAPI Eina_Hash *eina_hash_stringshared_new(Eina_Free_Cb data_free_cb);
 
+/**
+ * @brief Create a new flat hash table.
+ *
+ * @param key_length_cb The function called when getting the size of the key.
+ * @param key_cmp_cb The function called when comparing the keys.
+ * @param key_hash_cb The function called when getting the values.
+ * @param data_free_cb The function called on each value when the hash table is
+ * freed, or when an item is deleted from it. @c NULL can be passed as
+ * callback.
+ * @return The new hash table.
+ *
+ * This function creates a hash table with the same semantics as
+ * eina_hash_new(), but the entries are stored in one open addressed array
+ * (robin hood probing) instead of buckets of red black trees. A lookup
+ * then walks contiguous memory and only compares keys whose full hash
+ * matches, and adding an entry needs no allocation unless the key is
+ * copied. The array grows with the population, so there is no bucket size
+ * to choose. It is a good choice for hash tables that are looked up much
+ * more often than they are modified. As with eina_hash_new(), @p key_hash_cb
+ * should spread the keys over all 32 bits. On failure, @c NULL is
+ * returned. If @p key_cmp_cb or @p key_hash_cb are @c NULL, @c NULL is
+ * returned.
+ *
+ * Pointers to keys and values returned by iterators or by
+ * eina_hash_foreach() are only valid until the hash table is modified.
+ *
+ * Pre-defined functions are available to create a flat hash table. See
+ * eina_hash_string_flat_new(), eina_hash_int32_flat_new(),
+ * eina_hash_int64_flat_new(), eina_hash_pointer_flat_new() and
+ * eina_hash_stringshared_flat_new().
+ *
+ * @since 1.10
+ */
+EAPI Eina_Hash *eina_hash_flat_new(Eina_Key_Length key_length_cb,
+                                   Eina_Key_Cmp    key_cmp_cb,
+                                   Eina_Key_Hash   key_hash_cb,
+                                   Eina_Free_Cb    data_free_cb) EINA_MALLOC EINA_WARN_UNUSED_RESULT EINA_ARG_NONNULL(2, 3);
+
+/**
+ * @brief Create a new flat hash table for use with strings.
+ *
+ * @param data_free_cb  The function called on each value when the hash table
+ * is freed, or when an item is deleted from it. @c NULL can be passed as
+ * callback.
+ * @return  The new hash table.
+ *
+ * This function is the flat counterpart of
+ * eina_hash_string_superfast_new(). See eina_hash_flat_new().
+ *
+ * @since 1.10
+ */
+EAPI Eina_Hash *eina_hash_string_flat_new(Eina_Free_Cb data_free_cb);
+
+/**
+ * @brief Create a new flat hash table for use with 32bit integers.
+ *
+ * @param data_free_cb  The function called on each value when the hash table
+ * is freed, or when an item is deleted from it. @c NULL can be passed as
+ * callback.
+ * @return  The new hash table.
+ *
+ * This function is the flat counterpart of eina_hash_int32_new(). See
+ * eina_hash_flat_new().
+ *
+ * @since 1.10
+ */
+EAPI Eina_Hash *eina_hash_int32_flat_new(Eina_Free_Cb data_free_cb);
+
+/**
+ * @brief Create a new flat hash table for use with 64bit integers.
+ *
+ * @param data_free_cb  The function called on each value when the hash table
+ * is freed, or when an item is deleted from it. @c NULL can be passed as
+ * callback.
+ * @return  The new hash table.
+ *
+ * This function is the flat counterpart of eina_hash_int64_new(). See
+ * eina_hash_flat_new().
+ *
+ * @since 1.10
+ */
+EAPI Eina_Hash *eina_hash_int64_flat_new(Eina_Free_Cb data_free_cb);
+
+/**
+ * @brief Create a new flat hash table for use with pointers.
+ *
+ * @param data_free_cb  The function called on each value when the hash table
+ * is freed, or when an item is deleted from it. @c NULL can be passed as
+ * callback.
+ * @return  The new hash table.
+ *
+ * This function is the flat counterpart of eina_hash_pointer_new(). See
+ * eina_hash_flat_new().
+ *
+ * @since 1.10
+ */
+EAPI Eina_Hash *eina_hash_pointer_flat_new(Eina_Free_Cb data_free_cb);
+
+/**
+ * @brief Create a new flat hash table optimized for stringshared values.
+ *
+ * @param data_free_cb  The function called on each value when the hash table
+ * is freed, or when an item is deleted from it. @c NULL can be passed as
+ * callback.
+ * @return  The new hash table.
+ *
+ * This function is the flat counterpart of eina_hash_stringshared_new():
+ * values CAN NOT be looked up with pointers not equal to the original key
+ * pointer that was used to add a value. Unlike the latter, the key pointer
+ * itself is hashed. See eina_hash_flat_new().
+ *
+ * @since 1.10
+ */
+EAPI Eina_Hash *eina_hash_stringshared_flat_new(Eina_Free_Cb data_free_cb);
+
 /**
  * @brief Add an entry to the given hash table.
  *
@@ -124,6 +124,7 @@ struct _Eina_Share_Common_Population
 #endif
 
 typedef struct _Eina_Share_Common Eina_Share_Common;
+typedef struct _Eina_Share_Common_Bucket Eina_Share_Common_Bucket;
 typedef struct _Eina_Share_Common_Node Eina_Share_Common_Node;
 typedef struct _Eina_Share_Common_Head Eina_Share_Common_Head;
 
@@ -138,9 +139,17 @@ struct _Eina_Share
 #endif
 };
 
+/* Each bucket has its own lock, so threads adding or removing strings
+ * only contend when they hit the same bucket. */
+struct _Eina_Share_Common_Bucket
+{
+   Eina_Share_Common_Head *head;
+   Eina_Spinlock lock;
+};
+
 struct _Eina_Share_Common
 {
-   Eina_Share_Common_Head *buckets[EINA_SHARE_COMMON_BUCKETS];
+   Eina_Share_Common_Bucket buckets[EINA_SHARE_COMMON_BUCKETS];
 
    EINA_MAGIC
 };
@@ -151,6 +160,7 @@ struct _Eina_Share_Common_Node
 
    EINA_MAGIC
 
+   int hash;
    unsigned int length;
    unsigned int references;
    char str[];
@@ -173,6 +183,7 @@ struct _Eina_Share_Common_Head
 
 Eina_Bool _share_common_threads_activated = EINA_FALSE;
 
+/* only protects the population statistics, the table uses the bucket locks */
 static Eina_Spinlock _mutex_big;
 
 #ifdef EINA_STRINGSHARE_USAGE
@@ -288,8 +299,12 @@ _eina_share_common_population_head_add(Eina_Share *share,
                                        Eina_Share_Common_Head *head)
 {
    head->population++;
+
+   /* the head is under its bucket lock, the share wide maximum is not */
+   eina_spinlock_take(&_mutex_big);
    if (head->population > share->max_node_population)
       share->max_node_population = head->population;
+   eina_spinlock_release(&_mutex_big);
 }
 
 static void
@@ -308,15 +323,9 @@ static void _eina_share_common_population_shutdown(EINA_UNUSED Eina_Share *share
 }
 static void _eina_share_common_population_stats(EINA_UNUSED Eina_Share *share) {
 }
-static void eina_share_common_population_nolock_add(EINA_UNUSED Eina_Share *share,
-                                                    EINA_UNUSED int slen) {
-}
 void eina_share_common_population_add(EINA_UNUSED Eina_Share *share,
                                       EINA_UNUSED int slen) {
 }
-static void eina_share_common_population_nolock_del(EINA_UNUSED Eina_Share *share,
-                                                    EINA_UNUSED int slen) {
-}
 void eina_share_common_population_del(EINA_UNUSED Eina_Share *share,
                                       EINA_UNUSED int slen) {
 }
@@ -379,12 +388,14 @@ _eina_share_common_head_free(Eina_Share_Common_Head *ed, EINA_UNUSED void *data)
 
 static void
 _eina_share_common_node_init(Eina_Share_Common_Node *node,
+                             int hash,
                              const char *str,
                              int slen,
                              unsigned int null_size,
                              Eina_Magic node_magic)
 {
    EINA_MAGIC_SET(node, node_magic);
+   node->hash = hash;
    node->references = 1;
    node->length = slen;
    memcpy(node->str, str, slen);
@@ -422,6 +433,7 @@ _eina_share_common_add_head(Eina_Share *share,
    head->hash = hash;
    head->head = &head->builtin_node;
    _eina_share_common_node_init(head->head,
+                                hash,
                                 str,
                                 slen,
                                 null_size,
@@ -606,6 +618,7 @@ eina_share_common_init(Eina_Share **_share,
                        const char *node_magic_STR)
 {
    Eina_Share *share;
+   unsigned int i;
 
    share = *_share = calloc(sizeof(Eina_Share), 1);
    if (!share) goto on_error;
@@ -613,6 +626,9 @@ eina_share_common_init(Eina_Share **_share,
    share->share = calloc(1, sizeof(Eina_Share_Common));
    if (!share->share) goto on_error;
 
+   for (i = 0; i < EINA_SHARE_COMMON_BUCKETS; i++)
+     eina_spinlock_new(&share->share->buckets[i].lock);
+
    share->node_magic = node_magic;
 #define EMS(n) eina_magic_string_static_set(n, n ## _STR)
    EMS(EINA_MAGIC_SHARE);
@@ -659,11 +675,15 @@ eina_share_common_shutdown(Eina_Share **_share)
    /* remove any string still in the table */
    for (i = 0; i < EINA_SHARE_COMMON_BUCKETS; i++)
      {
-        eina_rbtree_delete(EINA_RBTREE_GET(
-                              share->share->buckets[i]),
+        Eina_Share_Common_Bucket *bucket = share->share->buckets + i;
+
+        eina_spinlock_take(&bucket->lock);
+        eina_rbtree_delete(EINA_RBTREE_GET(bucket->head),
                            EINA_RBTREE_FREE_CB(
                               _eina_share_common_head_free), NULL);
-        share->share->buckets[i] = NULL;
+        bucket->head = NULL;
+        eina_spinlock_release(&bucket->lock);
+        eina_spinlock_free(&bucket->lock);
      }
    MAGIC_FREE(share->share);
 
@@ -731,7 +751,8 @@ eina_share_common_add_length(Eina_Share *share,
                              unsigned int slen,
                              unsigned int null_size)
 {
-   Eina_Share_Common_Head **p_bucket, *ed;
+   Eina_Share_Common_Bucket *bucket;
+   Eina_Share_Common_Head *ed;
    Eina_Share_Common_Node *el;
    int hash;
 
@@ -745,48 +766,48 @@ eina_share_common_add_length(Eina_Share *share,
 
    hash = eina_hash_superfast(str, slen);
 
-   eina_spinlock_take(&_mutex_big);
-   p_bucket = share->share->buckets + EINA_SHARE_COMMON_BUCKET_IDX(hash);
+   bucket = share->share->buckets + EINA_SHARE_COMMON_BUCKET_IDX(hash);
+   eina_spinlock_take(&bucket->lock);
 
-   ed = _eina_share_common_find_hash(*p_bucket, EINA_SHARE_COMMON_NODE_HASH(hash));
+   ed = _eina_share_common_find_hash(bucket->head, EINA_SHARE_COMMON_NODE_HASH(hash));
    if (!ed)
      {
         const char *s = _eina_share_common_add_head(share,
-                                                    p_bucket,
+                                                    &bucket->head,
                                                     hash,
                                                     str,
                                                     slen,
                                                     null_size);
-        eina_spinlock_release(&_mutex_big);
+        eina_spinlock_release(&bucket->lock);
         return s;
      }
 
-   EINA_MAGIC_CHECK_SHARE_COMMON_HEAD(ed, eina_spinlock_release(&_mutex_big), NULL);
+   EINA_MAGIC_CHECK_SHARE_COMMON_HEAD(ed, eina_spinlock_release(&bucket->lock), NULL);
 
    el = _eina_share_common_head_find(ed, str, slen);
    if (el)
      {
         EINA_MAGIC_CHECK_SHARE_COMMON_NODE(el,
                                            share->node_magic,
-                                           eina_spinlock_release(&_mutex_big));
+                                           eina_spinlock_release(&bucket->lock));
         el->references++;
-                                           eina_spinlock_release(&_mutex_big);
+        eina_spinlock_release(&bucket->lock);
         return el->str;
      }
 
    el = _eina_share_common_node_alloc(slen, null_size);
    if (!el)
      {
-                                           eina_spinlock_release(&_mutex_big);
+        eina_spinlock_release(&bucket->lock);
         return NULL;
      }
 
-   _eina_share_common_node_init(el, str, slen, null_size, share->node_magic);
+   _eina_share_common_node_init(el, hash, str, slen, null_size, share->node_magic);
    el->next = ed->head;
    ed->head = el;
    _eina_share_common_population_head_add(share, ed);
 
-   eina_spinlock_release(&_mutex_big);
+   eina_spinlock_release(&bucket->lock);
 
    return el->str;
 }
@@ -794,23 +815,24 @@ eina_share_common_add_length(Eina_Share *share,
 const char *
 eina_share_common_ref(Eina_Share *share, const char *str)
 {
+   Eina_Share_Common_Bucket *bucket;
    Eina_Share_Common_Node *node;
 
    if (!str)
       return NULL;
 
-   eina_spinlock_take(&_mutex_big);
    node = _eina_share_common_node_from_str(str, share->node_magic);
    if (!node)
-     {
-        eina_spinlock_release(&_mutex_big);
-        return str;
-     }
+     return str;
+
+   /* the caller holds a reference, so the node can't go away and its hash
+    * can be read without the lock */
+   bucket = share->share->buckets + EINA_SHARE_COMMON_BUCKET_IDX(node->hash);
+   eina_spinlock_take(&bucket->lock);
    node->references++;
+   eina_spinlock_release(&bucket->lock);
 
-   eina_share_common_population_nolock_add(share, node->length);
-
-   eina_spinlock_release(&_mutex_big);
+   eina_share_common_population_add(share, node->length);
 
    return str;
 }
@@ -820,25 +842,27 @@ Eina_Bool
 eina_share_common_del(Eina_Share *share, const char *str)
 {
    unsigned int slen;
+   Eina_Share_Common_Bucket *bucket;
    Eina_Share_Common_Head *ed;
-   Eina_Share_Common_Head **p_bucket;
    Eina_Share_Common_Node *node;
 
    if (!str)
       return EINA_TRUE;
 
-   eina_spinlock_take(&_mutex_big);
-
    node = _eina_share_common_node_from_str(str, share->node_magic);
    if (!node)
-      goto on_error;
+      return EINA_FALSE;
 
    slen = node->length;
-   eina_share_common_population_nolock_del(share, slen);
+   eina_share_common_population_del(share, slen);
+
+   bucket = share->share->buckets + EINA_SHARE_COMMON_BUCKET_IDX(node->hash);
+   eina_spinlock_take(&bucket->lock);
+
    if (node->references > 1)
      {
         node->references--;
-        eina_spinlock_release(&_mutex_big);
+        eina_spinlock_release(&bucket->lock);
         return EINA_TRUE;
      }
 
@@ -848,7 +872,7 @@ eina_share_common_del(Eina_Share *share, const char *str)
    if (!ed)
       goto on_error;
 
-   EINA_MAGIC_CHECK_SHARE_COMMON_HEAD(ed, eina_spinlock_release(&_mutex_big), EINA_FALSE);
+   EINA_MAGIC_CHECK_SHARE_COMMON_HEAD(ed, eina_spinlock_release(&bucket->lock), EINA_FALSE);
 
    if (node != &ed->builtin_node)
      {
@@ -858,19 +882,16 @@ eina_share_common_del(Eina_Share *share, const char *str)
      }
 
    if (!ed->head || ed->head->references == 0)
-     {
-        p_bucket = share->share->buckets + EINA_SHARE_COMMON_BUCKET_IDX(ed->hash);
-        _eina_share_common_del_head(p_bucket, ed);
-     }
+     _eina_share_common_del_head(&bucket->head, ed);
    else
       _eina_share_common_population_head_del(share, ed);
 
-   eina_spinlock_release(&_mutex_big);
+   eina_spinlock_release(&bucket->lock);
 
    return EINA_TRUE;
 
 on_error:
-   eina_spinlock_release(&_mutex_big);
+   eina_spinlock_release(&bucket->lock);
    /* possible segfault happened before here, but... */
    return EINA_FALSE;
 }
@@ -906,21 +927,26 @@ eina_share_common_dump(Eina_Share *share, void (*additional_dump)(
    printf("DDD:   len   ref string\n");
    printf("DDD:-------------------\n");
 
-   eina_spinlock_take(&_mutex_big);
    for (i = 0; i < EINA_SHARE_COMMON_BUCKETS; i++)
      {
-        if (!share->share->buckets[i])
+        Eina_Share_Common_Bucket *bucket = share->share->buckets + i;
+
+        eina_spinlock_take(&bucket->lock);
+        if (!bucket->head)
           {
+             eina_spinlock_release(&bucket->lock);
              continue; //	printf("DDD: BUCKET # %i (HEAD=%i, NODE=%i)\n", i,
 
           }
 
 //	       sizeof(Eina_Share_Common_Head), sizeof(Eina_Share_Common_Node));
-        it = eina_rbtree_iterator_prefix(
-              (Eina_Rbtree *)share->share->buckets[i]);
+        it = eina_rbtree_iterator_prefix((Eina_Rbtree *)bucket->head);
         eina_iterator_foreach(it, EINA_EACH_CB(eina_iterator_array_check), &di);
         eina_iterator_free(it);
+        eina_spinlock_release(&bucket->lock);
      }
+
+   eina_spinlock_take(&_mutex_big);
    if (additional_dump)
       additional_dump(&di);
 
@@ -551,6 +551,33 @@ EAPI Eio_File *eio_dir_unlink(const char *path,
 			      Eio_Done_Cb done_cb,
 			      Eio_Error_Cb error_cb,
 			      const void *data);
+
+/**
+ * @brief Set how many files eio_dir_copy() and eio_dir_move() handle at once.
+ * @param count The number of files in flight, values below 1 are taken as 1.
+ *
+ * By default the files of a tree are copied one after the other. With a
+ * bigger count, that many worker threads pick the next pending file as soon
+ * as they are done with their previous one, which helps a lot with trees of
+ * many small files on storage that can serve parallel requests. Progress
+ * is then reported once per finished file through the usual
+ * EIO_DIR_COPY or EIO_DIR_MOVE Eio_Progress, without the per file
+ * EIO_FILE_COPY steps. The value is read when an operation starts, so
+ * changing it doesn't affect the ones already running.
+ *
+ * @see eio_dir_copy_concurrency_get()
+ * @since 1.10
+ */
+EAPI void eio_dir_copy_concurrency_set(unsigned int count);
+
+/**
+ * @brief Get how many files eio_dir_copy() and eio_dir_move() handle at once.
+ * @return The number of files in flight, 1 by default.
+ *
+ * @see eio_dir_copy_concurrency_set()
+ * @since 1.10
+ */
+EAPI unsigned int eio_dir_copy_concurrency_get(void);
 /**
  * @}
  */
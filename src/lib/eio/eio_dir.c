@@ -28,6 +28,8 @@
  * @cond LOCAL
  */
 
+static unsigned int _eio_dir_copy_concurrency = 1;
+
 static int
 eio_strcmp(const void *a, const void *b)
 {
@@ -354,6 +356,194 @@ _eio_dir_chmod(Ecore_Thread *thread, Eio_Dir_Copy *order,
    return EINA_FALSE;
 }
 
+static Eina_Bool
+_eio_dir_batch_progress(void *data,
+                        unsigned long long done EINA_UNUSED,
+                        unsigned long long total EINA_UNUSED)
+{
+   Eio_Dir_Copy_Batch *batch = data;
+   Eina_Bool go_on;
+
+   /* stop in the middle of a file as soon as another worker failed */
+   eina_lock_take(&batch->lock);
+   go_on = !batch->error;
+   eina_lock_release(&batch->lock);
+
+   return go_on && !ecore_thread_check(batch->thread);
+}
+
+static Eina_Bool
+_eio_dir_batch_file(Eio_Dir_Copy_Batch *batch, const char *file)
+{
+   char target[PATH_MAX];
+
+   /* build target file path */
+   _eio_dir_target(batch->order, target, file,
+                   batch->length_source, batch->length_dest);
+
+   /* first try to rename */
+   if (batch->op == EIO_FILE_MOVE)
+     {
+        if (rename(file, target) == 0)
+          return EINA_TRUE;
+        if (errno != EXDEV)
+          return EINA_FALSE;
+     }
+
+   /* then do a real copy */
+   if (!eina_file_copy(file, target,
+                       (EINA_FILE_COPY_PERMISSION |
+                        EINA_FILE_COPY_XATTR),
+                       _eio_dir_batch_progress,
+                       batch))
+     return EINA_FALSE;
+
+   /* and unlink the original */
+   if (batch->op == EIO_FILE_MOVE)
+     return unlink(file) == 0;
+
+   return EINA_TRUE;
+}
+
+static void *
+_eio_dir_batch_worker(void *data, Eina_Thread t EINA_UNUSED)
+{
+   Eio_Dir_Copy_Batch *batch = data;
+   const char *file;
+   Eina_Bool ok;
+   int error;
+
+   eina_lock_take(&batch->lock);
+   while (!batch->error &&
+          batch->next < batch->files_count &&
+          !ecore_thread_check(batch->thread))
+     {
+        file = batch->files[batch->next++];
+        eina_lock_release(&batch->lock);
+
+        errno = 0;
+        ok = _eio_dir_batch_file(batch, file);
+        error = errno;
+
+        eina_lock_take(&batch->lock);
+        if (ok)
+          batch->done++;
+        else if (!batch->error)
+          batch->error = error ? error : EIO;
+        eina_condition_signal(&batch->cond);
+     }
+   batch->running--;
+   eina_condition_signal(&batch->cond);
+   eina_lock_release(&batch->lock);
+
+   return NULL;
+}
+
+static Eina_Bool
+_eio_dir_batch(Ecore_Thread *thread, Eio_Dir_Copy *order, Eio_File_Op op,
+               long long *step, long long count,
+               int length_source, int length_dest)
+{
+   Eio_Dir_Copy_Batch batch;
+   Eina_Thread *workers;
+   const char *file;
+   Eina_List *l;
+   unsigned int spawned;
+   unsigned int reported;
+   unsigned int i;
+
+   memset(&batch, 0, sizeof (Eio_Dir_Copy_Batch));
+   batch.order = order;
+   batch.thread = thread;
+   batch.length_source = length_source;
+   batch.length_dest = length_dest;
+   batch.op = op;
+
+   batch.files_count = eina_list_count(order->files);
+   if (!batch.files_count) return EINA_TRUE;
+
+   batch.files = malloc(batch.files_count * sizeof (const char *));
+   workers = malloc(order->concurrency * sizeof (Eina_Thread));
+   if (!batch.files || !workers)
+     {
+        free(batch.files);
+        free(workers);
+        eio_file_thread_error(&order->progress.common, thread);
+        return EINA_FALSE;
+     }
+
+   i = 0;
+   EINA_LIST_FOREACH(order->files, l, file)
+     batch.files[i++] = file;
+
+   eina_lock_new(&batch.lock);
+   eina_condition_new(&batch.cond, &batch.lock);
+
+   /* workers can't send feedback from their own thread, so this one just
+    * waits for them and reports the aggregated progress */
+   eina_lock_take(&batch.lock);
+   for (spawned = 0;
+        spawned < order->concurrency && spawned < batch.files_count;
+        spawned++)
+     {
+        if (!eina_thread_create(&workers[spawned], EINA_THREAD_BACKGROUND, -1,
+                                _eio_dir_batch_worker, &batch))
+          break;
+        batch.running++;
+     }
+
+   if (!spawned)
+     {
+        /* no thread at all, copy everything from here */
+        batch.running = 1;
+        eina_lock_release(&batch.lock);
+        _eio_dir_batch_worker(&batch, eina_thread_self());
+        eina_lock_take(&batch.lock);
+     }
+
+   reported = 0;
+   while (batch.running)
+     {
+        eina_condition_wait(&batch.cond);
+
+        if (batch.done != reported)
+          {
+             reported = batch.done;
+             eina_lock_release(&batch.lock);
+
+             /* inform main thread */
+             eio_progress_send(thread, &order->progress, *step + reported, count);
+
+             eina_lock_take(&batch.lock);
+          }
+     }
+   eina_lock_release(&batch.lock);
+
+   for (i = 0; i < spawned; i++)
+     eina_thread_join(workers[i]);
+
+   *step += batch.done;
+   if (batch.done != reported)
+     eio_progress_send(thread, &order->progress, *step, count);
+
+   eina_condition_free(&batch.cond);
+   eina_lock_free(&batch.lock);
+   free(workers);
+   free(batch.files);
+
+   EINA_LIST_FREE(order->files, file)
+     eina_stringshare_del(file);
+
+   if (batch.error)
+     {
+        errno = batch.error;
+        eio_file_thread_error(&order->progress.common, thread);
+        return EINA_FALSE;
+     }
+
+   return !ecore_thread_check(thread);
+}
+
 static void
 _eio_dir_copy_heavy(void *data, Ecore_Thread *thread)
 {
@@ -385,6 +575,11 @@ _eio_dir_copy_heavy(void *data, Ecore_Thread *thread)
    if (!_eio_dir_mkdir(thread, copy, &step, count, length_source, length_dest))
      goto on_error;
 
+   /* copy files from several threads at once if asked to */
+   if ((copy->concurrency > 1) &&
+       (!_eio_dir_batch(thread, copy, EIO_FILE_COPY, &step, count, length_source, length_dest)))
+     goto on_error;
+
    /* copy all files */
    EINA_LIST_FREE(copy->files, file)
      {
@@ -515,6 +710,11 @@ _eio_dir_move_heavy(void *data, Ecore_Thread *thread)
    if (!_eio_dir_mkdir(thread, move, &step, count, length_source, length_dest))
      goto on_error;
 
+   /* move files from several threads at once if asked to */
+   if ((move->concurrency > 1) &&
+       (!_eio_dir_batch(thread, move, EIO_FILE_MOVE, &step, count, length_source, length_dest)))
+     goto on_error;
+
    /* move file around */
    EINA_LIST_FREE(move->files, file)
      {
@@ -831,6 +1031,7 @@ eio_dir_copy(const char *source,
    copy->files = NULL;
    copy->dirs = NULL;
    copy->links = NULL;
+   copy->concurrency = _eio_dir_copy_concurrency;
 
    if (!eio_long_file_set(&copy->progress.common,
                           done_cb,
@@ -872,6 +1073,7 @@ eio_dir_move(const char *source,
    move->files = NULL;
    move->dirs = NULL;
    move->links = NULL;
+   move->concurrency = _eio_dir_copy_concurrency;
 
    if (!eio_long_file_set(&move->progress.common,
                           done_cb,
@@ -999,3 +1201,16 @@ eio_dir_direct_ls(const char *dir,
 
    return &async->ls.common;
 }
+
+EAPI void
+eio_dir_copy_concurrency_set(unsigned int count)
+{
+   if (count < 1) count = 1;
+   _eio_dir_copy_concurrency = count;
+}
+
+EAPI unsigned int
+eio_dir_copy_concurrency_get(void)
+{
+   return _eio_dir_copy_concurrency;
+}
@@ -127,6 +127,7 @@ typedef struct _Eio_Monitor_Backend Eio_Monitor_Backend;
 typedef struct _Eio_File_Xattr Eio_File_Xattr;
 
 typedef struct _Eio_Dir_Copy Eio_Dir_Copy;
+typedef struct _Eio_Dir_Copy_Batch Eio_Dir_Copy_Batch;
 
 typedef struct _Eio_File_Direct_Info Eio_File_Direct_Info;
 typedef struct _Eio_File_Char Eio_File_Char;
@@ -403,6 +404,29 @@ struct _Eio_Dir_Copy
    Eina_List *files;
    Eina_List *dirs;
    Eina_List *links;
+
+   unsigned int concurrency;
+};
+
+struct _Eio_Dir_Copy_Batch
+{
+   Eio_Dir_Copy *order;
+   Ecore_Thread *thread;
+
+   Eina_Lock lock;
+   Eina_Condition cond;
+
+   const char **files;
+   unsigned int files_count;
+   unsigned int next; /* next file to hand out */
+   unsigned int done; /* files fully copied or moved */
+   unsigned int running; /* worker threads still alive */
+
+   int length_source;
+   int length_dest;
+   int error;
+
+   Eio_File_Op op;
 };
 
 struct _Eio_File_Chown
@@ -834,11 +834,164 @@ extra_arguments_check(DBusMessage *msg, Eldbus_Signal_Handler *sh)
    return EINA_TRUE;
 }
 
+#define SIGNAL_INDEX_KEYS 8
+#define SIGNAL_DISPATCH_STACK 32
+
+#define SIGNAL_HANDLER_FROM_INDEX_NODE(node) \
+  ((Eldbus_Signal_Handler *)((char *)(node) - \
+                             offsetof(Eldbus_Signal_Handler, index_node)))
+
+static size_t
+_signal_index_key_len(const char *path, const char *interface, const char *member)
+{
+   return (path ? strlen(path) : 0) + (interface ? strlen(interface) : 0) +
+     (member ? strlen(member) : 0) + 3;
+}
+
+/* NULL is a wildcard; none of these can contain a newline */
+static void
+_signal_index_key_set(char *key, size_t len, const char *path, const char *interface, const char *member)
+{
+   snprintf(key, len, "%s\n%s\n%s", path ? path : "",
+            interface ? interface : "", member ? member : "");
+}
+
+static void
+_signal_index_add(Eldbus_Connection *conn, Eldbus_Signal_Handler *sh)
+{
+   Eldbus_Signal_Bucket *bucket;
+   size_t len;
+   char *key;
+
+   len = _signal_index_key_len(sh->path, sh->interface, sh->member);
+   key = alloca(len);
+   _signal_index_key_set(key, len, sh->path, sh->interface, sh->member);
+
+   bucket = eina_hash_find(conn->signal_index, key);
+   if (!bucket)
+     {
+        bucket = malloc(sizeof(Eldbus_Signal_Bucket) + len);
+        EINA_SAFETY_ON_NULL_RETURN(bucket);
+        bucket->handlers = NULL;
+        memcpy(bucket->key, key, len);
+        if (!eina_hash_direct_add(conn->signal_index, bucket->key, bucket))
+          {
+             free(bucket);
+             return;
+          }
+     }
+
+   bucket->handlers = eina_inlist_append(bucket->handlers, &sh->index_node);
+   sh->bucket = bucket;
+}
+
+static void
+_signal_index_del(Eldbus_Connection *conn, Eldbus_Signal_Handler *sh)
+{
+   Eldbus_Signal_Bucket *bucket = sh->bucket;
+
+   if (!bucket) return;
+   sh->bucket = NULL;
+   bucket->handlers = eina_inlist_remove(bucket->handlers, &sh->index_node);
+   if (!bucket->handlers)
+     eina_hash_del_by_key(conn->signal_index, bucket->key);
+}
+
+/*
+ * Gather the live handlers that may want this signal: those whose path,
+ * interface and member are either the ones of the message or wildcards.
+ * Each bucket is already in registration order, so they are merged by
+ * serial. Returns how many were found, which may not be in *handlers if
+ * they did not fit and a bigger array could not be allocated.
+ */
+static unsigned int
+_signal_handlers_collect(Eldbus_Connection *conn, DBusMessage *msg, Eldbus_Signal_Handler ***handlers, unsigned int size)
+{
+   Eina_Inlist *cursors[SIGNAL_INDEX_KEYS];
+   const char *path, *interface, *member;
+   Eldbus_Signal_Handler **ret = *handlers;
+   unsigned int i, ncursors = 0, count = 0;
+   size_t len;
+   char *key;
+
+   path = dbus_message_get_path(msg);
+   interface = dbus_message_get_interface(msg);
+   member = dbus_message_get_member(msg);
+
+   len = _signal_index_key_len(path, interface, member);
+   key = alloca(len);
+   for (i = 0; i < SIGNAL_INDEX_KEYS; i++)
+     {
+        Eldbus_Signal_Bucket *bucket;
+
+        /* each bit of i asks for the message's own value rather than a
+         * wildcard, which can only match if the message has one */
+        if (((i & 1) && !path) || ((i & 2) && !interface) ||
+            ((i & 4) && !member))
+          continue;
+
+        _signal_index_key_set(key, len, (i & 1) ? path : NULL,
+                              (i & 2) ? interface : NULL,
+                              (i & 4) ? member : NULL);
+        bucket = eina_hash_find(conn->signal_index, key);
+        if (bucket) cursors[ncursors++] = bucket->handlers;
+     }
+
+   while (ncursors)
+     {
+        Eldbus_Signal_Handler *sh, *first = NULL;
+        unsigned int first_idx = 0;
+
+        for (i = 0; i < ncursors; i++)
+          {
+             sh = SIGNAL_HANDLER_FROM_INDEX_NODE(cursors[i]);
+             if ((!first) || (sh->serial < first->serial))
+               {
+                  first = sh;
+                  first_idx = i;
+               }
+          }
+
+        cursors[first_idx] = cursors[first_idx]->next;
+        if (!cursors[first_idx])
+          cursors[first_idx] = cursors[--ncursors];
+
+        if (first->dangling) continue;
+
+        if (count == size)
+          {
+             Eldbus_Signal_Handler **tmp;
+
+             size *= 2;
+             if (ret == *handlers)
+               {
+                  tmp = malloc(size * sizeof(Eldbus_Signal_Handler *));
+                  if (tmp) memcpy(tmp, ret, count * sizeof(Eldbus_Signal_Handler *));
+               }
+             else
+               tmp = realloc(ret, size * sizeof(Eldbus_Signal_Handler *));
+             if (!tmp)
+               {
+                  ERR("Could not dispatch all the handlers of %s.%s",
+                      interface, member);
+                  break;
+               }
+             ret = tmp;
+          }
+        ret[count++] = first;
+     }
+
+   *handlers = ret;
+   return count;
+}
+
 static void
 cb_signal_dispatcher(Eldbus_Connection *conn, DBusMessage *msg)
 {
+   Eldbus_Signal_Handler *stack[SIGNAL_DISPATCH_STACK];
+   Eldbus_Signal_Handler **handlers = stack;
    Eldbus_Message *eldbus_msg;
-   Eina_Inlist *next;
+   unsigned int i, count;
 
    eldbus_msg = eldbus_message_new(EINA_FALSE);
    EINA_SAFETY_ON_NULL_RETURN(eldbus_msg);
@@ -849,18 +1002,21 @@ cb_signal_dispatcher(Eldbus_Connection *conn, DBusMessage *msg)
 
    eldbus_connection_ref(conn);
    eldbus_init();
+
    /*
-    * Do the walking open-coded so we don't crash if a callback
-    * removes other signal handlers from the list and we don't own
-    * yet a reference to them.
+    * Only the handlers indexed under this path, interface and member are
+    * looked at. They are all referenced before the first callback so that
+    * one removing others, or itself, is safe; removed ones are dangling
+    * from then on and skipped.
     */
-   next = conn->signal_handlers;
-   while (next != NULL)
-     {
-        Eldbus_Signal_Handler *sh;
+   count = _signal_handlers_collect(conn, msg, &handlers,
+                                    SIGNAL_DISPATCH_STACK);
+   for (i = 0; i < count; i++)
+     eldbus_signal_handler_ref(handlers[i]);
 
-        sh = EINA_INLIST_CONTAINER_GET(next, Eldbus_Signal_Handler);
-        next = next->next;
+   for (i = 0; i < count; i++)
+     {
+        Eldbus_Signal_Handler *sh = handlers[i];
 
         if (sh->dangling) continue;
         if (sh->sender)
@@ -875,17 +1031,9 @@ cb_signal_dispatcher(Eldbus_Connection *conn, DBusMessage *msg)
              else
                if (!dbus_message_has_sender(msg, sh->sender)) continue;
           }
-        if (sh->path && !dbus_message_has_path(msg, sh->path)) continue;
-        if (sh->interface && !dbus_message_has_interface(msg, sh->interface))
-          continue;
-        if (sh->member && !dbus_message_has_member(msg, sh->member)) continue;
         if (!extra_arguments_check(msg, sh)) continue;
 
-        eldbus_signal_handler_ref(sh);
         sh->cb((void *)sh->cb_data, eldbus_msg);
-        /* update next signal handler because the list may have changed */
-        next = EINA_INLIST_GET(sh)->next;
-        eldbus_signal_handler_unref(sh);
 
         /*
          * Rewind iterator so another signal handler matching the same signal
@@ -895,6 +1043,10 @@ cb_signal_dispatcher(Eldbus_Connection *conn, DBusMessage *msg)
                                &eldbus_msg->iterator->dbus_iterator);
      }
 
+   for (i = 0; i < count; i++)
+     eldbus_signal_handler_unref(handlers[i]);
+   if (handlers != stack) free(handlers);
+
    eldbus_message_unref(eldbus_msg);
    eldbus_connection_unref(conn);
    eldbus_shutdown();
@@ -1019,6 +1171,7 @@ _connection_get(Eldbus_Connection_Type type, const char *address)
    conn->refcount = 1;
    EINA_MAGIC_SET(conn, ELDBUS_CONNECTION_MAGIC);
    conn->names = eina_hash_string_superfast_new(NULL);
+   conn->signal_index = eina_hash_string_superfast_new(free);
    eldbus_connection_setup(conn);
 
    eldbus_signal_handler_add(conn, NULL, DBUS_PATH_LOCAL, DBUS_INTERFACE_LOCAL,
@@ -1197,6 +1350,7 @@ _eldbus_connection_free(Eldbus_Connection *conn)
           ERR("conn=%p alive signal=%p %s.%s path=%s", conn, h, h->interface,
               h->member, h->path);
      }
+   eina_hash_free(conn->signal_index);
 
    for (i = 0; i < ELDBUS_CONNECTION_EVENT_LAST; i++)
      {
@@ -1508,6 +1662,8 @@ eldbus_connection_signal_handler_add(Eldbus_Connection *conn, Eldbus_Signal_Hand
    EINA_SAFETY_ON_NULL_RETURN(handler);
    conn->signal_handlers = eina_inlist_append(conn->signal_handlers,
                                               EINA_INLIST_GET(handler));
+   handler->serial = conn->signal_serial++;
+   _signal_index_add(conn, handler);
 }
 
 void
@@ -1526,6 +1682,7 @@ eldbus_connection_signal_handler_del(Eldbus_Connection *conn, Eldbus_Signal_Hand
    EINA_SAFETY_ON_NULL_RETURN(handler);
    conn->signal_handlers = eina_inlist_remove(conn->signal_handlers,
                                               EINA_INLIST_GET(handler));
+   _signal_index_del(conn, handler);
 }
 
 void
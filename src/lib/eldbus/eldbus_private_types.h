@@ -33,6 +33,14 @@ typedef struct _Eldbus_Object_Context_Event
 } Eldbus_Object_Context_Event;
 
 
+/* Signal handlers sharing the same path, interface and member, any of
+ * which may be a wildcard, in registration order */
+typedef struct _Eldbus_Signal_Bucket
+{
+   Eina_Inlist *handlers; //Eldbus_Signal_Handler, by index_node
+   char         key[];
+} Eldbus_Signal_Bucket;
+
 typedef struct _Eldbus_Connection_Context_Event
 {
    Eina_Inlist *list;
@@ -51,6 +59,8 @@ struct _Eldbus_Connection
    Eina_Inlist                   *data;
    Eina_Inlist                   *cbs_free;
    Eina_Inlist                   *signal_handlers;
+   Eina_Hash                     *signal_index; //Eldbus_Signal_Bucket
+   unsigned long long             signal_serial;
    Eina_Inlist                   *pendings;
    Eina_Inlist                   *fd_handlers;
    Eina_Inlist                   *timeouts;
@@ -83,6 +93,9 @@ struct _Eldbus_Signal_Handler
 {
    EINA_MAGIC;
    EINA_INLIST;
+   Eina_Inlist               index_node;
+   Eldbus_Signal_Bucket     *bucket;
+   unsigned long long        serial;
    int                       refcount;
    const char               *sender;
    const char               *path;
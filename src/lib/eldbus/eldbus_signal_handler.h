@@ -18,6 +18,15 @@
  * @param member name of the signal
  * @param cb callback that will be called when this signal is received
  * @param cb_data data that will be passed to callback
+ *
+ * Any of @p sender, @p path, @p interface and @p member may be NULL to
+ * match every value. Handlers matching a signal are called in the order
+ * they were added.
+ *
+ * A handler added from inside a signal callback is not called for the
+ * signal being dispatched, only for the following ones. A handler deleted
+ * from inside a callback, including the running one, is not called
+ * anymore, even for the signal being dispatched.
  */
 EAPI Eldbus_Signal_Handler *eldbus_signal_handler_add(Eldbus_Connection *conn, const char *sender, const char *path, const char *interface, const char *member, Eldbus_Signal_Cb cb, const void *cb_data) EINA_ARG_NONNULL(1, 6);
 
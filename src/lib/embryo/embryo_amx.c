@@ -45,7 +45,6 @@
 static void _embryo_byte_swap_16 (unsigned short *v);
 static void _embryo_byte_swap_32 (unsigned int *v);
 #endif
-static int  _embryo_native_call  (Embryo_Program *ep, Embryo_Cell idx, Embryo_Cell *result, Embryo_Cell *params);
 static int  _embryo_func_get     (Embryo_Program *ep, int idx, char *funcname);
 static int  _embryo_var_get      (Embryo_Program *ep, int idx, char *varname, Embryo_Cell *ep_addr);
 static int  _embryo_program_init (Embryo_Program *ep, void *code);
@@ -71,7 +70,7 @@ _embryo_byte_swap_32(unsigned int *v)
 }
 #endif
 
-static int
+int
 _embryo_native_call(Embryo_Program *ep, Embryo_Cell idx, Embryo_Cell *result, Embryo_Cell *params)
 {
    Embryo_Header    *hdr;
@@ -233,6 +232,8 @@ _embryo_program_init(Embryo_Program *ep, void *code)
    _embryo_rand_init(ep);
    _embryo_str_init(ep);
    _embryo_time_init(ep);
+   /* translate the code once now, to run it faster after */
+   _embryo_threaded_init(ep);
    return 1;
 }
 
@@ -335,6 +336,7 @@ embryo_program_free(Embryo_Program *ep)
 
    if (ep->base) free(ep->base);
    if ((!ep->dont_free_code) && (ep->code)) free(ep->code);
+   if (ep->threaded) free(ep->threaded);
    if (ep->native_calls) free(ep->native_calls);
    for (i = 0; i < ep->params_size; i++)
      {
@@ -1115,8 +1117,34 @@ embryo_program_run(Embryo_Program *ep, Embryo_Function fn)
    ep->run_count++;
 
    max_run_cycles = ep->max_run_cycles;
+   cycle_count = 0;
+   if (ep->threaded)
+     {
+	Embryo_Status status;
+
+	/* hand the registers over, as if resuming from sleep */
+	ep->pri = pri;
+	ep->alt = alt;
+	ep->frm = frm;
+	ep->stk = stk;
+	ep->hea = hea;
+	ep->cip = (Embryo_Cell)((unsigned char *)cip - code);
+	ep->reset_stk = reset_stk;
+	ep->reset_hea = reset_hea;
+	if (_embryo_threaded_run(ep, max_run_cycles, &status, &cycle_count))
+	  return status;
+	/* it jumped to a cell that isn't an instruction, go on from there */
+	frm = ep->frm;
+	stk = ep->stk;
+	hea = ep->hea;
+	pri = ep->pri;
+	alt = ep->alt;
+	reset_stk = ep->reset_stk;
+	reset_hea = ep->reset_hea;
+	cip = (Embryo_Cell *)(code + (int)ep->cip);
+     }
    /* start running */
-   for (cycle_count = 0;;)
+   for (;;)
      {
 	if (max_run_cycles > 0)
 	  {
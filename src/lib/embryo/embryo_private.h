@@ -189,6 +189,7 @@ __entryswap32(*((unsigned int *)(entry) + 1))) \
 typedef struct _Embryo_Param        Embryo_Param;
 typedef struct _Embryo_Header       Embryo_Header;
 typedef struct _Embryo_Func_Stub    Embryo_Func_Stub;
+typedef struct _Embryo_Threaded_Cell Embryo_Threaded_Cell;
 
 typedef Embryo_Cell (*Embryo_Native)(Embryo_Program *ep, Embryo_Cell *params);
 
@@ -200,6 +201,17 @@ struct _Embryo_Param
    Embryo_Cell  cell;
 };
 
+/* one per code cell, see embryo_threaded.c */
+struct _Embryo_Threaded_Cell
+{
+   const void *op; /* handler to run when this cell is an instruction */
+   union
+   {
+      Embryo_Cell           cell; /* the cell itself */
+      Embryo_Threaded_Cell *addr; /* resolved target of jumps and calls */
+   } arg;
+};
+
 struct _Embryo_Program
 {
    unsigned char *base; /* points to the Embryo_Program header ("ephdr") plus the code, optionally also the data */
@@ -239,6 +251,8 @@ struct _Embryo_Program
    int            max_run_cycles;
 
    void          *data;
+
+   Embryo_Threaded_Cell *threaded; /* the code translated at load, or NULL */
 };
 
 #if defined (_MSC_VER) || (defined (__SUNPRO_C) && __SUNPRO_C < 0x5100)
@@ -287,4 +301,10 @@ void _embryo_rand_init(Embryo_Program *ep);
 void _embryo_str_init(Embryo_Program *ep);
 void _embryo_time_init(Embryo_Program *ep);
 
+int           _embryo_native_call(Embryo_Program *ep, Embryo_Cell idx, Embryo_Cell *result, Embryo_Cell *params);
+void          _embryo_threaded_init(Embryo_Program *ep);
+/* 0 if embryo_program_run() has to go on from the registers left in ep,
+ * after cycle_count cycles */
+int           _embryo_threaded_run(Embryo_Program *ep, int max_run_cycles, Embryo_Status *status, int *cycle_count);
+
 #endif
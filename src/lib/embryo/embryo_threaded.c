@@ -0,0 +1,1261 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <Eina.h>
+
+#include "Embryo.h"
+#include "embryo_private.h"
+
+/*
+ * Direct threaded code for embryo_program_run().
+ *
+ * When a program is loaded, its code is translated into one
+ * Embryo_Threaded_Cell per code cell. Instructions get the address of
+ * their handler, so going to the next one is a single indirect jump with
+ * no opcode to decode, and the operands of jumps, calls and case tables get
+ * the cell they go to. Cell n is still at code offset n * sizeof(Embryo_Cell),
+ * so return addresses on the stack and ep->cip are the same as for the
+ * classic interpreter in embryo_amx.c, which a sleeping program may resume
+ * in and the other way around.
+ *
+ * A few pairs of instructions the compiler emits all the time (loading a
+ * variable then pushing it, or loading the value to compare to then
+ * jumping on the result) are run by a single handler. The second
+ * instruction keeps its own handler, for the jumps landing on it.
+ *
+ * Code jumping outside of itself or in the middle of an instruction isn't
+ * translated and runs in the classic interpreter, as does everything when
+ * EMBRYO_NO_THREADED is set. Jumps computed at run time (RET, RETN,
+ * JUMP_PRI, CALL_PRI, SCTRL 6) can still land on a cell that is not the
+ * start of an instruction: the registers are then handed back to
+ * embryo_program_run(), which goes on from there as it always did.
+ *
+ * This needs the gcc "labels as values" extension.
+ */
+
+#ifdef __GNUC__
+# define EMBRYO_EXEC_THREADED
+#endif
+
+#ifdef EMBRYO_EXEC_THREADED
+
+/* handlers that are not one of an opcode */
+enum
+{
+   EMBRYO_THREADED_INVALID = EMBRYO_OP_NUM_OPCODES,
+   EMBRYO_THREADED_END,
+   EMBRYO_THREADED_LOAD_PRI_PUSH_PRI,
+   EMBRYO_THREADED_LOAD_S_PRI_PUSH_PRI,
+   EMBRYO_THREADED_LOAD_S_PRI_CONST_ALT,
+   EMBRYO_THREADED_LOAD_S_PRI_LOAD_S_ALT,
+   EMBRYO_THREADED_CONST_ALT_JEQ,
+   EMBRYO_THREADED_CONST_ALT_JNEQ,
+   EMBRYO_THREADED_CONST_ALT_JSLESS,
+   EMBRYO_THREADED_CONST_ALT_JSLEQ,
+   EMBRYO_THREADED_CONST_ALT_JSGRTR,
+   EMBRYO_THREADED_CONST_ALT_JSGEQ,
+   EMBRYO_THREADED_LOAD_S_ALT_JEQ,
+   EMBRYO_THREADED_LOAD_S_ALT_JNEQ,
+   EMBRYO_THREADED_LOAD_S_ALT_JSLESS,
+   EMBRYO_THREADED_LOAD_S_ALT_JSLEQ,
+   EMBRYO_THREADED_LOAD_S_ALT_JSGRTR,
+   EMBRYO_THREADED_LOAD_S_ALT_JSGEQ,
+   EMBRYO_THREADED_NUM
+};
+
+typedef struct _Embryo_Threaded_Pair Embryo_Threaded_Pair;
+struct _Embryo_Threaded_Pair
+{
+   unsigned char first;
+   unsigned char second;
+   unsigned char handler;
+};
+
+/* the first instruction of all of these has one operand */
+static const Embryo_Threaded_Pair _embryo_threaded_pairs[] =
+{
+   { EMBRYO_OP_LOAD_PRI, EMBRYO_OP_PUSH_PRI, EMBRYO_THREADED_LOAD_PRI_PUSH_PRI },
+   { EMBRYO_OP_LOAD_S_PRI, EMBRYO_OP_PUSH_PRI, EMBRYO_THREADED_LOAD_S_PRI_PUSH_PRI },
+   { EMBRYO_OP_LOAD_S_PRI, EMBRYO_OP_CONST_ALT, EMBRYO_THREADED_LOAD_S_PRI_CONST_ALT },
+   { EMBRYO_OP_LOAD_S_PRI, EMBRYO_OP_LOAD_S_ALT, EMBRYO_THREADED_LOAD_S_PRI_LOAD_S_ALT },
+   { EMBRYO_OP_CONST_ALT, EMBRYO_OP_JEQ, EMBRYO_THREADED_CONST_ALT_JEQ },
+   { EMBRYO_OP_CONST_ALT, EMBRYO_OP_JNEQ, EMBRYO_THREADED_CONST_ALT_JNEQ },
+   { EMBRYO_OP_CONST_ALT, EMBRYO_OP_JSLESS, EMBRYO_THREADED_CONST_ALT_JSLESS },
+   { EMBRYO_OP_CONST_ALT, EMBRYO_OP_JSLEQ, EMBRYO_THREADED_CONST_ALT_JSLEQ },
+   { EMBRYO_OP_CONST_ALT, EMBRYO_OP_JSGRTR, EMBRYO_THREADED_CONST_ALT_JSGRTR },
+   { EMBRYO_OP_CONST_ALT, EMBRYO_OP_JSGEQ, EMBRYO_THREADED_CONST_ALT_JSGEQ },
+   { EMBRYO_OP_LOAD_S_ALT, EMBRYO_OP_JEQ, EMBRYO_THREADED_LOAD_S_ALT_JEQ },
+   { EMBRYO_OP_LOAD_S_ALT, EMBRYO_OP_JNEQ, EMBRYO_THREADED_LOAD_S_ALT_JNEQ },
+   { EMBRYO_OP_LOAD_S_ALT, EMBRYO_OP_JSLESS, EMBRYO_THREADED_LOAD_S_ALT_JSLESS },
+   { EMBRYO_OP_LOAD_S_ALT, EMBRYO_OP_JSLEQ, EMBRYO_THREADED_LOAD_S_ALT_JSLEQ },
+   { EMBRYO_OP_LOAD_S_ALT, EMBRYO_OP_JSGRTR, EMBRYO_THREADED_LOAD_S_ALT_JSGRTR },
+   { EMBRYO_OP_LOAD_S_ALT, EMBRYO_OP_JSGEQ, EMBRYO_THREADED_LOAD_S_ALT_JSGEQ }
+};
+
+/* operands read by each opcode in embryo_program_run(), the debug opcodes
+ * it skips have none there either. EMBRYO_OP_CASETBL is special. */
+static const unsigned char _embryo_threaded_operands[EMBRYO_OP_NUM_OPCODES] =
+{
+   [EMBRYO_OP_LOAD_PRI] = 1, [EMBRYO_OP_LOAD_ALT] = 1,
+   [EMBRYO_OP_LOAD_S_PRI] = 1, [EMBRYO_OP_LOAD_S_ALT] = 1,
+   [EMBRYO_OP_LREF_PRI] = 1, [EMBRYO_OP_LREF_ALT] = 1,
+   [EMBRYO_OP_LREF_S_PRI] = 1, [EMBRYO_OP_LREF_S_ALT] = 1,
+   [EMBRYO_OP_LODB_I] = 1,
+   [EMBRYO_OP_CONST_PRI] = 1, [EMBRYO_OP_CONST_ALT] = 1,
+   [EMBRYO_OP_ADDR_PRI] = 1, [EMBRYO_OP_ADDR_ALT] = 1,
+   [EMBRYO_OP_STOR_PRI] = 1, [EMBRYO_OP_STOR_ALT] = 1,
+   [EMBRYO_OP_STOR_S_PRI] = 1, [EMBRYO_OP_STOR_S_ALT] = 1,
+   [EMBRYO_OP_SREF_PRI] = 1, [EMBRYO_OP_SREF_ALT] = 1,
+   [EMBRYO_OP_SREF_S_PRI] = 1, [EMBRYO_OP_SREF_S_ALT] = 1,
+   [EMBRYO_OP_STRB_I] = 1,
+   [EMBRYO_OP_LIDX_B] = 1, [EMBRYO_OP_IDXADDR_B] = 1,
+   [EMBRYO_OP_ALIGN_PRI] = 1, [EMBRYO_OP_ALIGN_ALT] = 1,
+   [EMBRYO_OP_LCTRL] = 1, [EMBRYO_OP_SCTRL] = 1,
+   [EMBRYO_OP_PUSH_R] = 1, [EMBRYO_OP_PUSH_C] = 1,
+   [EMBRYO_OP_PUSH] = 1, [EMBRYO_OP_PUSH_S] = 1,
+   [EMBRYO_OP_STACK] = 1, [EMBRYO_OP_HEAP] = 1,
+   [EMBRYO_OP_CALL] = 1, [EMBRYO_OP_JUMP] = 1, [EMBRYO_OP_JREL] = 1,
+   [EMBRYO_OP_JZER] = 1, [EMBRYO_OP_JNZ] = 1,
+   [EMBRYO_OP_JEQ] = 1, [EMBRYO_OP_JNEQ] = 1,
+   [EMBRYO_OP_JLESS] = 1, [EMBRYO_OP_JLEQ] = 1,
+   [EMBRYO_OP_JGRTR] = 1, [EMBRYO_OP_JGEQ] = 1,
+   [EMBRYO_OP_JSLESS] = 1, [EMBRYO_OP_JSLEQ] = 1,
+   [EMBRYO_OP_JSGRTR] = 1, [EMBRYO_OP_JSGEQ] = 1,
+   [EMBRYO_OP_SHL_C_PRI] = 1, [EMBRYO_OP_SHL_C_ALT] = 1,
+   [EMBRYO_OP_SHR_C_PRI] = 1, [EMBRYO_OP_SHR_C_ALT] = 1,
+   [EMBRYO_OP_ADD_C] = 1, [EMBRYO_OP_SMUL_C] = 1,
+   [EMBRYO_OP_ZERO] = 1, [EMBRYO_OP_ZERO_S] = 1,
+   [EMBRYO_OP_EQ_C_PRI] = 1, [EMBRYO_OP_EQ_C_ALT] = 1,
+   [EMBRYO_OP_INC] = 1, [EMBRYO_OP_INC_S] = 1,
+   [EMBRYO_OP_DEC] = 1, [EMBRYO_OP_DEC_S] = 1,
+   [EMBRYO_OP_MOVS] = 1, [EMBRYO_OP_CMPS] = 1, [EMBRYO_OP_FILL] = 1,
+   [EMBRYO_OP_HALT] = 1, [EMBRYO_OP_BOUNDS] = 1,
+   [EMBRYO_OP_SYSREQ_C] = 1, [EMBRYO_OP_SYSREQ_D] = 1,
+   [EMBRYO_OP_SWITCH] = 1, [EMBRYO_OP_PUSHADDR] = 1
+};
+
+/* the handler bodies below are the ones of embryo_program_run(), these
+ * give them the same meaning on threaded cells */
+#undef GETPARAM
+#define GETPARAM(v)         (v = (cip++)->arg.cell)
+#undef TOOLONG
+#define TOOLONG(ep)         {(ep)->pri = pri; (ep)->cip = CODE_OFFSET(cip); (ep)->alt = alt; (ep)->frm = frm; (ep)->stk = stk; (ep)->hea = hea; (ep)->reset_stk = reset_stk; (ep)->reset_hea = reset_hea; (ep)->run_count--; (ep)->max_run_cycles = max_run_cycles; return EMBRYO_PROGRAM_TOOLONG;}
+
+#define CODE_OFFSET(c)      ((Embryo_Cell)(((c) - tc) * sizeof(Embryo_Cell)))
+#define JUMPTO(offs) \
+   if (((Embryo_UCell)(offs) >= codesize) || \
+       ((offs) & (sizeof(Embryo_Cell) - 1))) \
+     ABORT(ep, EMBRYO_ERROR_MEMACCESS); \
+   cip = tc + ((offs) / sizeof(Embryo_Cell))
+#define JUMPIF(cond) \
+   if (cond) cip = cip->arg.addr; \
+   else cip++
+
+#define CASE(x) x:
+#define BREAK \
+   if (max_run_cycles > 0) \
+     { \
+        if (cycle_count >= max_run_cycles) \
+          TOOLONG(ep); \
+        cycle_count++; \
+     } \
+   goto *(cip++)->op
+/* a pair counts as the two instructions it runs, when the second one is
+ * over the limit only the first one is run, as its own handler would */
+#define PAIR(first) \
+   if (max_run_cycles > 0) \
+     { \
+        if (cycle_count >= max_run_cycles) \
+          goto first; \
+        cycle_count++; \
+     }
+
+/* with ep NULL, returns the handlers in handlers. Sets classic_cycles to
+ * the cycles run so far if the classic interpreter has to go on. */
+static Embryo_Status
+_embryo_threaded_exec(Embryo_Program *ep, int max_run_cycles,
+                      int *classic_cycles, const void * const **handlers)
+{
+   static const void * const table[EMBRYO_THREADED_NUM] =
+     {
+        &&EMBRYO_OP_NONE,
+        &&EMBRYO_OP_LOAD_PRI,
+        &&EMBRYO_OP_LOAD_ALT,
+        &&EMBRYO_OP_LOAD_S_PRI,
+        &&EMBRYO_OP_LOAD_S_ALT,
+        &&EMBRYO_OP_LREF_PRI,
+        &&EMBRYO_OP_LREF_ALT,
+        &&EMBRYO_OP_LREF_S_PRI,
+        &&EMBRYO_OP_LREF_S_ALT,
+        &&EMBRYO_OP_LOAD_I,
+        &&EMBRYO_OP_LODB_I,
+        &&EMBRYO_OP_CONST_PRI,
+        &&EMBRYO_OP_CONST_ALT,
+        &&EMBRYO_OP_ADDR_PRI,
+        &&EMBRYO_OP_ADDR_ALT,
+        &&EMBRYO_OP_STOR_PRI,
+        &&EMBRYO_OP_STOR_ALT,
+        &&EMBRYO_OP_STOR_S_PRI,
+        &&EMBRYO_OP_STOR_S_ALT,
+        &&EMBRYO_OP_SREF_PRI,
+        &&EMBRYO_OP_SREF_ALT,
+        &&EMBRYO_OP_SREF_S_PRI,
+        &&EMBRYO_OP_SREF_S_ALT,
+        &&EMBRYO_OP_STOR_I,
+        &&EMBRYO_OP_STRB_I,
+        &&EMBRYO_OP_LIDX,
+        &&EMBRYO_OP_LIDX_B,
+        &&EMBRYO_OP_IDXADDR,
+        &&EMBRYO_OP_IDXADDR_B,
+        &&EMBRYO_OP_ALIGN_PRI,
+        &&EMBRYO_OP_ALIGN_ALT,
+        &&EMBRYO_OP_LCTRL,
+        &&EMBRYO_OP_SCTRL,
+        &&EMBRYO_OP_MOVE_PRI,
+        &&EMBRYO_OP_MOVE_ALT,
+        &&EMBRYO_OP_XCHG,
+        &&EMBRYO_OP_PUSH_PRI,
+        &&EMBRYO_OP_PUSH_ALT,
+        &&EMBRYO_OP_PUSH_R,
+        &&EMBRYO_OP_PUSH_C,
+        &&EMBRYO_OP_PUSH,
+        &&EMBRYO_OP_PUSH_S,
+        &&EMBRYO_OP_POP_PRI,
+        &&EMBRYO_OP_POP_ALT,
+        &&EMBRYO_OP_STACK,
+        &&EMBRYO_OP_HEAP,
+        &&EMBRYO_OP_PROC,
+        &&EMBRYO_OP_RET,
+        &&EMBRYO_OP_RETN,
+        &&EMBRYO_OP_CALL,
+        &&EMBRYO_OP_CALL_PRI,
+        &&EMBRYO_OP_JUMP,
+        &&EMBRYO_OP_JREL,
+        &&EMBRYO_OP_JZER,
+        &&EMBRYO_OP_JNZ,
+        &&EMBRYO_OP_JEQ,
+        &&EMBRYO_OP_JNEQ,
+        &&EMBRYO_OP_JLESS,
+        &&EMBRYO_OP_JLEQ,
+        &&EMBRYO_OP_JGRTR,
+        &&EMBRYO_OP_JGEQ,
+        &&EMBRYO_OP_JSLESS,
+        &&EMBRYO_OP_JSLEQ,
+        &&EMBRYO_OP_JSGRTR,
+        &&EMBRYO_OP_JSGEQ,
+        &&EMBRYO_OP_SHL,
+        &&EMBRYO_OP_SHR,
+        &&EMBRYO_OP_SSHR,
+        &&EMBRYO_OP_SHL_C_PRI,
+        &&EMBRYO_OP_SHL_C_ALT,
+        &&EMBRYO_OP_SHR_C_PRI,
+        &&EMBRYO_OP_SHR_C_ALT,
+        &&EMBRYO_OP_SMUL,
+        &&EMBRYO_OP_SDIV,
+        &&EMBRYO_OP_SDIV_ALT,
+        &&EMBRYO_OP_UMUL,
+        &&EMBRYO_OP_UDIV,
+        &&EMBRYO_OP_UDIV_ALT,
+        &&EMBRYO_OP_ADD,
+        &&EMBRYO_OP_SUB,
+        &&EMBRYO_OP_SUB_ALT,
+        &&EMBRYO_OP_AND,
+        &&EMBRYO_OP_OR,
+        &&EMBRYO_OP_XOR,
+        &&EMBRYO_OP_NOT,
+        &&EMBRYO_OP_NEG,
+        &&EMBRYO_OP_INVERT,
+        &&EMBRYO_OP_ADD_C,
+        &&EMBRYO_OP_SMUL_C,
+        &&EMBRYO_OP_ZERO_PRI,
+        &&EMBRYO_OP_ZERO_ALT,
+        &&EMBRYO_OP_ZERO,
+        &&EMBRYO_OP_ZERO_S,
+        &&EMBRYO_OP_SIGN_PRI,
+        &&EMBRYO_OP_SIGN_ALT,
+        &&EMBRYO_OP_EQ,
+        &&EMBRYO_OP_NEQ,
+        &&EMBRYO_OP_LESS,
+        &&EMBRYO_OP_LEQ,
+        &&EMBRYO_OP_GRTR,
+        &&EMBRYO_OP_GEQ,
+        &&EMBRYO_OP_SLESS,
+        &&EMBRYO_OP_SLEQ,
+        &&EMBRYO_OP_SGRTR,
+        &&EMBRYO_OP_SGEQ,
+        &&EMBRYO_OP_EQ_C_PRI,
+        &&EMBRYO_OP_EQ_C_ALT,
+        &&EMBRYO_OP_INC_PRI,
+        &&EMBRYO_OP_INC_ALT,
+        &&EMBRYO_OP_INC,
+        &&EMBRYO_OP_INC_S,
+        &&EMBRYO_OP_INC_I,
+        &&EMBRYO_OP_DEC_PRI,
+        &&EMBRYO_OP_DEC_ALT,
+        &&EMBRYO_OP_DEC,
+        &&EMBRYO_OP_DEC_S,
+        &&EMBRYO_OP_DEC_I,
+        &&EMBRYO_OP_MOVS,
+        &&EMBRYO_OP_CMPS,
+        &&EMBRYO_OP_FILL,
+        &&EMBRYO_OP_HALT,
+        &&EMBRYO_OP_BOUNDS,
+        &&EMBRYO_OP_SYSREQ_PRI,
+        &&EMBRYO_OP_SYSREQ_C,
+        &&EMBRYO_OP_FILE,
+        &&EMBRYO_OP_LINE,
+        &&EMBRYO_OP_SYMBOL,
+        &&EMBRYO_OP_SRANGE,
+        &&EMBRYO_OP_JUMP_PRI,
+        &&EMBRYO_OP_SWITCH,
+        &&EMBRYO_OP_CASETBL,
+        &&EMBRYO_OP_SWAP_PRI,
+        &&EMBRYO_OP_SWAP_ALT,
+        &&EMBRYO_OP_PUSHADDR,
+        &&EMBRYO_OP_NOP,
+        &&EMBRYO_OP_SYSREQ_D,
+        &&EMBRYO_OP_SYMTAG,
+        &&EMBRYO_THREADED_INVALID,
+        &&EMBRYO_THREADED_END,
+        &&EMBRYO_THREADED_LOAD_PRI_PUSH_PRI,
+        &&EMBRYO_THREADED_LOAD_S_PRI_PUSH_PRI,
+        &&EMBRYO_THREADED_LOAD_S_PRI_CONST_ALT,
+        &&EMBRYO_THREADED_LOAD_S_PRI_LOAD_S_ALT,
+        &&EMBRYO_THREADED_CONST_ALT_JEQ,
+        &&EMBRYO_THREADED_CONST_ALT_JNEQ,
+        &&EMBRYO_THREADED_CONST_ALT_JSLESS,
+        &&EMBRYO_THREADED_CONST_ALT_JSLEQ,
+        &&EMBRYO_THREADED_CONST_ALT_JSGRTR,
+        &&EMBRYO_THREADED_CONST_ALT_JSGEQ,
+        &&EMBRYO_THREADED_LOAD_S_ALT_JEQ,
+        &&EMBRYO_THREADED_LOAD_S_ALT_JNEQ,
+        &&EMBRYO_THREADED_LOAD_S_ALT_JSLESS,
+        &&EMBRYO_THREADED_LOAD_S_ALT_JSLEQ,
+        &&EMBRYO_THREADED_LOAD_S_ALT_JSGRTR,
+        &&EMBRYO_THREADED_LOAD_S_ALT_JSGEQ
+     };
+   Embryo_Header        *hdr;
+   Embryo_Threaded_Cell *tc, *cip;
+   unsigned char        *data;
+   Embryo_Cell           pri, alt, stk, frm, hea;
+   Embryo_Cell           reset_stk, reset_hea;
+   Embryo_UCell          codesize;
+   Embryo_Cell           offs;
+   int                   i, num;
+   int                   cycle_count = 0;
+
+   if (!ep)
+     {
+        *handlers = table;
+        return EMBRYO_PROGRAM_OK;
+     }
+
+   /* embryo_program_run() left all registers in ep, as when sleeping */
+   hdr = (Embryo_Header *)ep->base;
+   codesize = (Embryo_UCell)(hdr->dat - hdr->cod);
+   data = ep->base + (int)hdr->dat;
+   tc = ep->threaded;
+   frm = ep->frm;
+   stk = ep->stk;
+   hea = ep->hea;
+   pri = ep->pri;
+   alt = ep->alt;
+   reset_stk = ep->reset_stk;
+   reset_hea = ep->reset_hea;
+   JUMPTO(ep->cip);
+   BREAK;
+
+   CASE(EMBRYO_OP_LOAD_PRI);
+   GETPARAM(offs);
+   pri = *(Embryo_Cell *)(data + (int)offs);
+   BREAK;
+   CASE(EMBRYO_OP_LOAD_ALT);
+   GETPARAM(offs);
+   alt = *(Embryo_Cell *)(data + (int)offs);
+   BREAK;
+   CASE(EMBRYO_OP_LOAD_S_PRI);
+   GETPARAM(offs);
+   pri = *(Embryo_Cell *)(data + (int)frm + (int)offs);
+   BREAK;
+   CASE(EMBRYO_OP_LOAD_S_ALT);
+   GETPARAM(offs);
+   alt = *(Embryo_Cell *)(data + (int)frm + (int)offs);
+   BREAK;
+   CASE(EMBRYO_OP_LREF_PRI);
+   GETPARAM(offs);
+   offs = *(Embryo_Cell *)(data + (int)offs);
+   pri = *(Embryo_Cell *)(data + (int)offs);
+   BREAK;
+   CASE(EMBRYO_OP_LREF_ALT);
+   GETPARAM(offs);
+   offs = *(Embryo_Cell *)(data + (int)offs);
+   alt = *(Embryo_Cell *)(data + (int)offs);
+   BREAK;
+   CASE(EMBRYO_OP_LREF_S_PRI);
+   GETPARAM(offs);
+   offs = *(Embryo_Cell *)(data + (int)frm + (int)offs);
+   pri = *(Embryo_Cell *)(data + (int)offs);
+   BREAK;
+   CASE(EMBRYO_OP_LREF_S_ALT);
+   GETPARAM(offs);
+   offs = *(Embryo_Cell *)(data + (int)frm + (int)offs);
+   alt = *(Embryo_Cell *)(data + (int)offs);
+   BREAK;
+   CASE(EMBRYO_OP_LOAD_I);
+   CHKMEM(pri);
+   pri = *(Embryo_Cell *)(data + (int)pri);
+   BREAK;
+   CASE(EMBRYO_OP_LODB_I);
+   GETPARAM(offs);
+   CHKMEM(pri);
+   switch (offs)
+     {
+      case 1:
+        pri = *(data + (int)pri);
+        break;
+      case 2:
+        pri = *(unsigned short *)(data + (int)pri);
+        break;
+      case 4:
+        pri = *(unsigned int *)(data + (int)pri);
+        break;
+      default:
+        ABORT(ep, EMBRYO_ERROR_INVINSTR);
+        break;
+     }
+   BREAK;
+   CASE(EMBRYO_OP_CONST_PRI);
+   GETPARAM(pri);
+   BREAK;
+   CASE(EMBRYO_OP_CONST_ALT);
+   GETPARAM(alt);
+   BREAK;
+   CASE(EMBRYO_OP_ADDR_PRI);
+   GETPARAM(pri);
+   pri += frm;
+   BREAK;
+   CASE(EMBRYO_OP_ADDR_ALT);
+   GETPARAM(alt);
+   alt += frm;
+   BREAK;
+   CASE(EMBRYO_OP_STOR_PRI);
+   GETPARAM(offs);
+   *(Embryo_Cell *)(data + (int)offs) = pri;
+   BREAK;
+   CASE(EMBRYO_OP_STOR_ALT);
+   GETPARAM(offs);
+   *(Embryo_Cell *)(data + (int)offs) = alt;
+   BREAK;
+   CASE(EMBRYO_OP_STOR_S_PRI);
+   GETPARAM(offs);
+   *(Embryo_Cell *)(data + (int)frm + (int)offs) = pri;
+   BREAK;
+   CASE(EMBRYO_OP_STOR_S_ALT);
+   GETPARAM(offs);
+   *(Embryo_Cell *)(data + (int)frm + (int)offs) = alt;
+   BREAK;
+   CASE(EMBRYO_OP_SREF_PRI);
+   GETPARAM(offs);
+   offs = *(Embryo_Cell *)(data + (int)offs);
+   *(Embryo_Cell *)(data + (int)offs) = pri;
+   BREAK;
+   CASE(EMBRYO_OP_SREF_ALT);
+   GETPARAM(offs);
+   offs = *(Embryo_Cell *)(data + (int)offs);
+   *(Embryo_Cell *)(data + (int)offs) = alt;
+   BREAK;
+   CASE(EMBRYO_OP_SREF_S_PRI);
+   GETPARAM(offs);
+   offs = *(Embryo_Cell *)(data + (int)frm + (int)offs);
+   *(Embryo_Cell *)(data + (int)offs) = pri;
+   BREAK;
+   CASE(EMBRYO_OP_SREF_S_ALT);
+   GETPARAM(offs);
+   offs = *(Embryo_Cell *)(data + (int)frm + (int)offs);
+   *(Embryo_Cell *)(data + (int)offs) = alt;
+   BREAK;
+   CASE(EMBRYO_OP_STOR_I);
+   CHKMEM(alt);
+   *(Embryo_Cell *)(data + (int)alt) = pri;
+   BREAK;
+   CASE(EMBRYO_OP_STRB_I);
+   GETPARAM(offs);
+   CHKMEM(alt);
+   switch (offs)
+     {
+      case 1:
+        *(data + (int)alt) = (unsigned char)pri;
+        break;
+      case 2:
+        *(unsigned short *)(data + (int)alt) = (unsigned short)pri;
+        break;
+      case 4:
+        *(unsigned int *)(data + (int)alt) = (unsigned int)pri;
+        break;
+      default:
+        ABORT(ep, EMBRYO_ERROR_INVINSTR);
+        break;
+     }
+   BREAK;
+   CASE(EMBRYO_OP_LIDX);
+   offs = (pri * sizeof(Embryo_Cell)) + alt;
+   CHKMEM(offs);
+   pri = *(Embryo_Cell *)(data + (int)offs);
+   BREAK;
+   CASE(EMBRYO_OP_LIDX_B);
+   GETPARAM(offs);
+   offs = (pri << (int)offs) + alt;
+   CHKMEM(offs);
+   pri = *(Embryo_Cell *)(data + (int)offs);
+   BREAK;
+   CASE(EMBRYO_OP_IDXADDR);
+   pri = (pri * sizeof(Embryo_Cell)) + alt;
+   BREAK;
+   CASE(EMBRYO_OP_IDXADDR_B);
+   GETPARAM(offs);
+   pri = (pri << (int)offs) + alt;
+   BREAK;
+   CASE(EMBRYO_OP_ALIGN_PRI);
+   GETPARAM(offs);
+#ifdef WORDS_BIGENDIAN
+   if ((size_t)offs < sizeof(Embryo_Cell))
+     pri ^= sizeof(Embryo_Cell) - offs;
+#endif
+   BREAK;
+   CASE(EMBRYO_OP_ALIGN_ALT);
+   GETPARAM(offs);
+#ifdef WORDS_BIGENDIAN
+   if ((size_t)offs < sizeof(Embryo_Cell))
+     alt ^= sizeof(Embryo_Cell) - offs;
+#endif
+   BREAK;
+   CASE(EMBRYO_OP_LCTRL);
+   GETPARAM(offs);
+   switch (offs)
+     {
+      case 0:
+        pri = hdr->cod;
+        break;
+      case 1:
+        pri = hdr->dat;
+        break;
+      case 2:
+        pri = hea;
+        break;
+      case 3:
+        pri = ep->stp;
+        break;
+      case 4:
+        pri = stk;
+        break;
+      case 5:
+        pri = frm;
+        break;
+      case 6:
+        pri = CODE_OFFSET(cip);
+        break;
+      default:
+        ABORT(ep, EMBRYO_ERROR_INVINSTR);
+        break;
+     }
+   BREAK;
+   CASE(EMBRYO_OP_SCTRL);
+   GETPARAM(offs);
+   switch (offs)
+     {
+      case 0:
+      case 1:
+      case 2:
+        hea = pri;
+        break;
+      case 3:
+        /* cannot change these parameters */
+        break;
+      case 4:
+        stk = pri;
+        break;
+      case 5:
+        frm = pri;
+        break;
+      case 6:
+        JUMPTO(pri);
+        break;
+      default:
+        ABORT(ep, EMBRYO_ERROR_INVINSTR);
+        break;
+     }
+   BREAK;
+   CASE(EMBRYO_OP_MOVE_PRI);
+   pri = alt;
+   BREAK;
+   CASE(EMBRYO_OP_MOVE_ALT);
+   alt = pri;
+   BREAK;
+   CASE(EMBRYO_OP_XCHG);
+   offs = pri;         /* offs is a temporary variable */
+   pri = alt;
+   alt = offs;
+   BREAK;
+   CASE(EMBRYO_OP_PUSH_PRI);
+   PUSH(pri);
+   BREAK;
+   CASE(EMBRYO_OP_PUSH_ALT);
+   PUSH(alt);
+   BREAK;
+   CASE(EMBRYO_OP_PUSH_C);
+   GETPARAM(offs);
+   PUSH(offs);
+   BREAK;
+   CASE(EMBRYO_OP_PUSH_R);
+   GETPARAM(offs);
+   while (offs--) PUSH(pri);
+   BREAK;
+   CASE(EMBRYO_OP_PUSH);
+   GETPARAM(offs);
+   PUSH(*(Embryo_Cell *)(data + (int)offs));
+   BREAK;
+   CASE(EMBRYO_OP_PUSH_S);
+   GETPARAM(offs);
+   PUSH(*(Embryo_Cell *)(data + (int)frm + (int)offs));
+   BREAK;
+   CASE(EMBRYO_OP_POP_PRI);
+   POP(pri);
+   BREAK;
+   CASE(EMBRYO_OP_POP_ALT);
+   POP(alt);
+   BREAK;
+   CASE(EMBRYO_OP_STACK);
+   GETPARAM(offs);
+   alt = stk;
+   stk += offs;
+   CHKMARGIN();
+   CHKSTACK();
+   BREAK;
+   CASE(EMBRYO_OP_HEAP);
+   GETPARAM(offs);
+   alt = hea;
+   hea += offs;
+   CHKMARGIN();
+   CHKHEAP();
+   BREAK;
+   CASE(EMBRYO_OP_PROC);
+   PUSH(frm);
+   frm = stk;
+   CHKMARGIN();
+   BREAK;
+   CASE(EMBRYO_OP_RET);
+   POP(frm);
+   POP(offs);
+   JUMPTO(offs);
+   BREAK;
+   CASE(EMBRYO_OP_RETN);
+   POP(frm);
+   POP(offs);
+   JUMPTO(offs);
+   stk += *(Embryo_Cell *)(data + (int)stk) + sizeof(Embryo_Cell); /* remove parameters from the stack */
+   ep->stk = stk;
+   BREAK;
+   CASE(EMBRYO_OP_CALL);
+   PUSH(CODE_OFFSET(cip + 1)); /* skip address */
+   cip = cip->arg.addr;
+   BREAK;
+   CASE(EMBRYO_OP_CALL_PRI);
+   PUSH(CODE_OFFSET(cip));
+   JUMPTO(pri);
+   BREAK;
+   CASE(EMBRYO_OP_JUMP);
+   CASE(EMBRYO_OP_JREL);
+   cip = cip->arg.addr;
+   BREAK;
+   CASE(EMBRYO_OP_JZER);
+   JUMPIF(pri == 0);
+   BREAK;
+   CASE(EMBRYO_OP_JNZ);
+   JUMPIF(pri != 0);
+   BREAK;
+   CASE(EMBRYO_OP_JEQ);
+   JUMPIF(pri == alt);
+   BREAK;
+   CASE(EMBRYO_OP_JNEQ);
+   JUMPIF(pri != alt);
+   BREAK;
+   CASE(EMBRYO_OP_JLESS);
+   JUMPIF((Embryo_UCell)pri < (Embryo_UCell)alt);
+   BREAK;
+   CASE(EMBRYO_OP_JLEQ);
+   JUMPIF((Embryo_UCell)pri <= (Embryo_UCell)alt);
+   BREAK;
+   CASE(EMBRYO_OP_JGRTR);
+   JUMPIF((Embryo_UCell)pri > (Embryo_UCell)alt);
+   BREAK;
+   CASE(EMBRYO_OP_JGEQ);
+   JUMPIF((Embryo_UCell)pri >= (Embryo_UCell)alt);
+   BREAK;
+   CASE(EMBRYO_OP_JSLESS);
+   JUMPIF(pri < alt);
+   BREAK;
+   CASE(EMBRYO_OP_JSLEQ);
+   JUMPIF(pri <= alt);
+   BREAK;
+   CASE(EMBRYO_OP_JSGRTR);
+   JUMPIF(pri > alt);
+   BREAK;
+   CASE(EMBRYO_OP_JSGEQ);
+   JUMPIF(pri >= alt);
+   BREAK;
+   CASE(EMBRYO_OP_SHL);
+   pri <<= alt;
+   BREAK;
+   CASE(EMBRYO_OP_SHR);
+   pri = (Embryo_UCell)pri >> (int)alt;
+   BREAK;
+   CASE(EMBRYO_OP_SSHR);
+   pri >>= alt;
+   BREAK;
+   CASE(EMBRYO_OP_SHL_C_PRI);
+   GETPARAM(offs);
+   pri <<= offs;
+   BREAK;
+   CASE(EMBRYO_OP_SHL_C_ALT);
+   GETPARAM(offs);
+   alt <<= offs;
+   BREAK;
+   CASE(EMBRYO_OP_SHR_C_PRI);
+   GETPARAM(offs);
+   pri = (Embryo_UCell)pri >> (int)offs;
+   BREAK;
+   CASE(EMBRYO_OP_SHR_C_ALT);
+   GETPARAM(offs);
+   alt = (Embryo_UCell)alt >> (int)offs;
+   BREAK;
+   CASE(EMBRYO_OP_SMUL);
+   pri *= alt;
+   BREAK;
+   CASE(EMBRYO_OP_SDIV);
+   if (alt == 0) ABORT(ep, EMBRYO_ERROR_DIVIDE);
+   /* divide must always round down; this is a bit
+    * involved to do in a machine-independent way.
+    */
+   offs = ((pri % alt) + alt) % alt; /* true modulus */
+   pri = (pri - offs) / alt;         /* division result */
+   alt = offs;
+   BREAK;
+   CASE(EMBRYO_OP_SDIV_ALT);
+   if (pri == 0) ABORT(ep, EMBRYO_ERROR_DIVIDE);
+   /* divide must always round down; this is a bit
+    * involved to do in a machine-independent way.
+    */
+   offs = ((alt % pri) + pri) % pri; /* true modulus */
+   pri = (alt - offs) / pri;         /* division result */
+   alt = offs;
+   BREAK;
+   CASE(EMBRYO_OP_UMUL);
+   pri = (Embryo_UCell)pri * (Embryo_UCell)alt;
+   BREAK;
+   CASE(EMBRYO_OP_UDIV);
+   if (alt == 0) ABORT(ep, EMBRYO_ERROR_DIVIDE);
+   offs = (Embryo_UCell)pri % (Embryo_UCell)alt; /* temporary storage */
+   pri = (Embryo_UCell)pri / (Embryo_UCell)alt;
+   alt = offs;
+   BREAK;
+   CASE(EMBRYO_OP_UDIV_ALT);
+   if (pri == 0) ABORT(ep, EMBRYO_ERROR_DIVIDE);
+   offs = (Embryo_UCell)alt % (Embryo_UCell)pri; /* temporary storage */
+   pri = (Embryo_UCell)alt / (Embryo_UCell)pri;
+   alt = offs;
+   BREAK;
+   CASE(EMBRYO_OP_ADD);
+   pri += alt;
+   BREAK;
+   CASE(EMBRYO_OP_SUB);
+   pri -= alt;
+   BREAK;
+   CASE(EMBRYO_OP_SUB_ALT);
+   pri = alt - pri;
+   BREAK;
+   CASE(EMBRYO_OP_AND);
+   pri &= alt;
+   BREAK;
+   CASE(EMBRYO_OP_OR);
+   pri |= alt;
+   BREAK;
+   CASE(EMBRYO_OP_XOR);
+   pri ^= alt;
+   BREAK;
+   CASE(EMBRYO_OP_NOT);
+   pri = !pri;
+   BREAK;
+   CASE(EMBRYO_OP_NEG);
+   pri = -pri;
+   BREAK;
+   CASE(EMBRYO_OP_INVERT);
+   pri = ~pri;
+   BREAK;
+   CASE(EMBRYO_OP_ADD_C);
+   GETPARAM(offs);
+   pri += offs;
+   BREAK;
+   CASE(EMBRYO_OP_SMUL_C);
+   GETPARAM(offs);
+   pri *= offs;
+   BREAK;
+   CASE(EMBRYO_OP_ZERO_PRI);
+   pri = 0;
+   BREAK;
+   CASE(EMBRYO_OP_ZERO_ALT);
+   alt = 0;
+   BREAK;
+   CASE(EMBRYO_OP_ZERO);
+   GETPARAM(offs);
+   *(Embryo_Cell *)(data + (int)offs) = 0;
+   BREAK;
+   CASE(EMBRYO_OP_ZERO_S);
+   GETPARAM(offs);
+   *(Embryo_Cell *)(data + (int)frm + (int)offs) = 0;
+   BREAK;
+   CASE(EMBRYO_OP_SIGN_PRI);
+   if ((pri & 0xff) >= 0x80) pri |= ~(Embryo_UCell)0xff;
+   BREAK;
+   CASE(EMBRYO_OP_SIGN_ALT);
+   if ((alt & 0xff) >= 0x80) alt |= ~(Embryo_UCell)0xff;
+   BREAK;
+   CASE(EMBRYO_OP_EQ);
+   pri = (pri == alt) ? 1 : 0;
+   BREAK;
+   CASE(EMBRYO_OP_NEQ);
+   pri = (pri != alt) ? 1 : 0;
+   BREAK;
+   CASE(EMBRYO_OP_LESS);
+   pri = ((Embryo_UCell)pri < (Embryo_UCell)alt) ? 1 : 0;
+   BREAK;
+   CASE(EMBRYO_OP_LEQ);
+   pri = ((Embryo_UCell)pri <= (Embryo_UCell)alt) ? 1 : 0;
+   BREAK;
+   CASE(EMBRYO_OP_GRTR);
+   pri = ((Embryo_UCell)pri > (Embryo_UCell)alt) ? 1 : 0;
+   BREAK;
+   CASE(EMBRYO_OP_GEQ);
+   pri = ((Embryo_UCell)pri >= (Embryo_UCell)alt) ? 1 : 0;
+   BREAK;
+   CASE(EMBRYO_OP_SLESS);
+   pri = (pri < alt) ? 1 : 0;
+   BREAK;
+   CASE(EMBRYO_OP_SLEQ);
+   pri = (pri <= alt) ? 1 : 0;
+   BREAK;
+   CASE(EMBRYO_OP_SGRTR);
+   pri = (pri > alt) ? 1 : 0;
+   BREAK;
+   CASE(EMBRYO_OP_SGEQ);
+   pri = (pri >= alt) ? 1 : 0;
+   BREAK;
+   CASE(EMBRYO_OP_EQ_C_PRI);
+   GETPARAM(offs);
+   pri = (pri == offs) ? 1 : 0;
+   BREAK;
+   CASE(EMBRYO_OP_EQ_C_ALT);
+   GETPARAM(offs);
+   pri = (alt == offs) ? 1 : 0;
+   BREAK;
+   CASE(EMBRYO_OP_INC_PRI);
+   pri++;
+   BREAK;
+   CASE(EMBRYO_OP_INC_ALT);
+   alt++;
+   BREAK;
+   CASE(EMBRYO_OP_INC);
+   GETPARAM(offs);
+   *(Embryo_Cell *)(data + (int)offs) += 1;
+   BREAK;
+   CASE(EMBRYO_OP_INC_S);
+   GETPARAM(offs);
+   *(Embryo_Cell *)(data + (int)frm + (int)offs) += 1;
+   BREAK;
+   CASE(EMBRYO_OP_INC_I);
+   *(Embryo_Cell *)(data + (int)pri) += 1;
+   BREAK;
+   CASE(EMBRYO_OP_DEC_PRI);
+   pri--;
+   BREAK;
+   CASE(EMBRYO_OP_DEC_ALT);
+   alt--;
+   BREAK;
+   CASE(EMBRYO_OP_DEC);
+   GETPARAM(offs);
+   *(Embryo_Cell *)(data + (int)offs) -= 1;
+   BREAK;
+   CASE(EMBRYO_OP_DEC_S);
+   GETPARAM(offs);
+   *(Embryo_Cell *)(data + (int)frm + (int)offs) -= 1;
+   BREAK;
+   CASE(EMBRYO_OP_DEC_I);
+   *(Embryo_Cell *)(data + (int)pri) -= 1;
+   BREAK;
+   CASE(EMBRYO_OP_MOVS);
+   GETPARAM(offs);
+   CHKMEM(pri);
+   CHKMEM(pri + offs);
+   CHKMEM(alt);
+   CHKMEM(alt + offs);
+   memcpy(data+(int)alt, data+(int)pri, (int)offs);
+   BREAK;
+   CASE(EMBRYO_OP_CMPS);
+   GETPARAM(offs);
+   CHKMEM(pri);
+   CHKMEM(pri + offs);
+   CHKMEM(alt);
+   CHKMEM(alt + offs);
+   pri = memcmp(data + (int)alt, data + (int)pri, (int)offs);
+   BREAK;
+   CASE(EMBRYO_OP_FILL);
+   GETPARAM(offs);
+   CHKMEM(alt);
+   CHKMEM(alt + offs);
+   for (i = (int)alt;
+        (size_t)offs >= sizeof(Embryo_Cell);
+        i += sizeof(Embryo_Cell), offs -= sizeof(Embryo_Cell))
+     *(Embryo_Cell *)(data + i) = pri;
+   BREAK;
+   CASE(EMBRYO_OP_HALT);
+   GETPARAM(offs);
+   ep->retval = pri;
+   /* store complete status */
+   ep->frm = frm;
+   ep->stk = stk;
+   ep->hea = hea;
+   ep->pri = pri;
+   ep->alt = alt;
+   ep->cip = CODE_OFFSET(cip);
+   if (offs == EMBRYO_ERROR_SLEEP)
+     {
+        ep->reset_stk = reset_stk;
+        ep->reset_hea = reset_hea;
+        ep->run_count--;
+        return EMBRYO_PROGRAM_SLEEP;
+     }
+   OK(ep, (int)offs);
+   CASE(EMBRYO_OP_BOUNDS);
+   GETPARAM(offs);
+   if ((Embryo_UCell)pri > (Embryo_UCell)offs)
+     ABORT(ep, EMBRYO_ERROR_BOUNDS);
+   BREAK;
+   CASE(EMBRYO_OP_SYSREQ_PRI);
+   offs = pri;
+   goto sysreq;
+   CASE(EMBRYO_OP_SYSREQ_C);
+   CASE(EMBRYO_OP_SYSREQ_D);
+   GETPARAM(offs);
+sysreq:
+   /* save a few registers */
+   ep->cip = CODE_OFFSET(cip);
+   ep->hea = hea;
+   ep->frm = frm;
+   ep->stk = stk;
+   num = _embryo_native_call(ep, offs, &pri, (Embryo_Cell *)(data + (int)stk));
+   if (num != EMBRYO_ERROR_NONE)
+     {
+        if (num == EMBRYO_ERROR_SLEEP)
+          {
+             ep->pri = pri;
+             ep->alt = alt;
+             ep->reset_stk = reset_stk;
+             ep->reset_hea = reset_hea;
+             ep->run_count--;
+             return EMBRYO_PROGRAM_SLEEP;
+          }
+        ABORT(ep, num);
+     }
+   BREAK;
+   CASE(EMBRYO_OP_JUMP_PRI);
+   JUMPTO(pri);
+   BREAK;
+   CASE(EMBRYO_OP_SWITCH);
+     {
+        Embryo_Threaded_Cell *cptr;
+
+        /* +1, to skip the "casetbl" opcode */
+        cptr = cip->arg.addr + 1;
+        /* number of records in the case table */
+        num = (int)cptr->arg.cell;
+        /* preset to "none-matched" case */
+        cip = (cptr + 1)->arg.addr;
+        for (cptr += 2;
+             (num > 0) && (cptr->arg.cell != pri);
+             num--, cptr += 2);
+        /* case found */
+        if (num > 0)
+          cip = (cptr + 1)->arg.addr;
+     }
+   BREAK;
+   CASE(EMBRYO_OP_SWAP_PRI);
+   offs = *(Embryo_Cell *)(data + (int)stk);
+   *(Embryo_Cell *)(data + (int)stk) = pri;
+   pri = offs;
+   BREAK;
+   CASE(EMBRYO_OP_SWAP_ALT);
+   offs = *(Embryo_Cell *)(data + (int)stk);
+   *(Embryo_Cell *)(data + (int)stk) = alt;
+   alt = offs;
+   BREAK;
+   CASE(EMBRYO_OP_PUSHADDR);
+   GETPARAM(offs);
+   PUSH(frm + offs);
+   BREAK;
+   CASE(EMBRYO_OP_NOP);
+   BREAK;
+   CASE(EMBRYO_OP_NONE);
+   CASE(EMBRYO_OP_FILE);
+   CASE(EMBRYO_OP_LINE);
+   CASE(EMBRYO_OP_SYMBOL);
+   CASE(EMBRYO_OP_SRANGE);
+   CASE(EMBRYO_OP_CASETBL);
+   CASE(EMBRYO_OP_SYMTAG);
+   BREAK;
+
+   CASE(EMBRYO_THREADED_INVALID);
+   /* a computed jump to an operand, which is run as an instruction */
+   cip--;
+   ep->pri = pri;
+   ep->alt = alt;
+   ep->frm = frm;
+   ep->stk = stk;
+   ep->hea = hea;
+   ep->cip = CODE_OFFSET(cip);
+   ep->reset_stk = reset_stk;
+   ep->reset_hea = reset_hea;
+   /* it was counted before getting here, it is again there */
+   *classic_cycles = (max_run_cycles > 0) ? cycle_count - 1 : 0;
+   return EMBRYO_PROGRAM_OK;
+   CASE(EMBRYO_THREADED_END);
+   ABORT(ep, EMBRYO_ERROR_MEMACCESS);
+
+   /* load/push */
+   CASE(EMBRYO_THREADED_LOAD_PRI_PUSH_PRI);
+   PAIR(EMBRYO_OP_LOAD_PRI);
+   pri = *(Embryo_Cell *)(data + (int)cip[0].arg.cell);
+   PUSH(pri);
+   cip += 2;
+   BREAK;
+   CASE(EMBRYO_THREADED_LOAD_S_PRI_PUSH_PRI);
+   PAIR(EMBRYO_OP_LOAD_S_PRI);
+   pri = *(Embryo_Cell *)(data + (int)frm + (int)cip[0].arg.cell);
+   PUSH(pri);
+   cip += 2;
+   BREAK;
+   CASE(EMBRYO_THREADED_LOAD_S_PRI_CONST_ALT);
+   PAIR(EMBRYO_OP_LOAD_S_PRI);
+   pri = *(Embryo_Cell *)(data + (int)frm + (int)cip[0].arg.cell);
+   alt = cip[2].arg.cell;
+   cip += 3;
+   BREAK;
+   CASE(EMBRYO_THREADED_LOAD_S_PRI_LOAD_S_ALT);
+   PAIR(EMBRYO_OP_LOAD_S_PRI);
+   pri = *(Embryo_Cell *)(data + (int)frm + (int)cip[0].arg.cell);
+   alt = *(Embryo_Cell *)(data + (int)frm + (int)cip[2].arg.cell);
+   cip += 3;
+   BREAK;
+
+   /* compare/jump */
+#define PAIR_JUMP(first, load, jump, cond) \
+   CASE(EMBRYO_THREADED_##first##_##jump); \
+   PAIR(EMBRYO_OP_##first); \
+   alt = load; \
+   cip += 2; \
+   JUMPIF(cond); \
+   BREAK
+#define CONST_ALT cip[0].arg.cell
+#define LOAD_S_ALT *(Embryo_Cell *)(data + (int)frm + (int)cip[0].arg.cell)
+   PAIR_JUMP(CONST_ALT, CONST_ALT, JEQ, pri == alt);
+   PAIR_JUMP(CONST_ALT, CONST_ALT, JNEQ, pri != alt);
+   PAIR_JUMP(CONST_ALT, CONST_ALT, JSLESS, pri < alt);
+   PAIR_JUMP(CONST_ALT, CONST_ALT, JSLEQ, pri <= alt);
+   PAIR_JUMP(CONST_ALT, CONST_ALT, JSGRTR, pri > alt);
+   PAIR_JUMP(CONST_ALT, CONST_ALT, JSGEQ, pri >= alt);
+   PAIR_JUMP(LOAD_S_ALT, LOAD_S_ALT, JEQ, pri == alt);
+   PAIR_JUMP(LOAD_S_ALT, LOAD_S_ALT, JNEQ, pri != alt);
+   PAIR_JUMP(LOAD_S_ALT, LOAD_S_ALT, JSLESS, pri < alt);
+   PAIR_JUMP(LOAD_S_ALT, LOAD_S_ALT, JSLEQ, pri <= alt);
+   PAIR_JUMP(LOAD_S_ALT, LOAD_S_ALT, JSGRTR, pri > alt);
+   PAIR_JUMP(LOAD_S_ALT, LOAD_S_ALT, JSGEQ, pri >= alt);
+#undef LOAD_S_ALT
+#undef CONST_ALT
+#undef PAIR_JUMP
+}
+
+/* number of cells after the opcode at code[i], -1 if past the end */
+static int
+_embryo_threaded_operands_get(const Embryo_Cell *code, int n, int i)
+{
+   unsigned char op = (unsigned char)code[i];
+   int num;
+
+   if (op >= EMBRYO_OP_NUM_OPCODES) return 0;
+   if (op != EMBRYO_OP_CASETBL)
+     num = _embryo_threaded_operands[op];
+   else
+     {
+        /* records, the default address and the records themselves */
+        if ((i + 1 >= n) || (code[i + 1] < 0) || (code[i + 1] >= n)) return -1;
+        num = 2 + (2 * code[i + 1]);
+     }
+   if (i + num >= n) return -1;
+   return num;
+}
+
+/* the cell offs is the code offset of, if it is an instruction */
+static Embryo_Threaded_Cell *
+_embryo_threaded_addr_get(Embryo_Threaded_Cell *tc, int n, Embryo_Cell offs,
+                          const void *invalid)
+{
+   if ((offs < 0) || (offs & (sizeof(Embryo_Cell) - 1))) return NULL;
+   offs /= sizeof(Embryo_Cell);
+   if ((offs >= n) || (tc[offs].op == invalid)) return NULL;
+   return tc + offs;
+}
+
+void
+_embryo_threaded_init(Embryo_Program *ep)
+{
+   const void * const *handlers;
+   Embryo_Header *hdr;
+   Embryo_Threaded_Cell *tc;
+   const Embryo_Cell *code;
+   const char *s;
+   unsigned char op;
+   int i, j, k, n, num;
+
+   s = getenv("EMBRYO_NO_THREADED");
+   if ((s) && (atoi(s))) return;
+
+   hdr = (Embryo_Header *)ep->code;
+   if ((hdr->cod <= 0) || (hdr->dat <= hdr->cod) ||
+       ((hdr->dat - hdr->cod) % sizeof(Embryo_Cell)) ||
+       ((unsigned int)hdr->dat > hdr->size))
+     return;
+   code = (const Embryo_Cell *)(ep->code + (int)hdr->cod);
+   n = (hdr->dat - hdr->cod) / sizeof(Embryo_Cell);
+
+   /* one more, to stop running past the end of the code */
+   tc = malloc((n + 1) * sizeof(Embryo_Threaded_Cell));
+   if (!tc) return;
+   _embryo_threaded_exec(NULL, 0, NULL, &handlers);
+
+   for (i = 0; i < n; i++)
+     {
+        tc[i].op = handlers[EMBRYO_THREADED_INVALID];
+        tc[i].arg.cell = code[i];
+     }
+   tc[n].op = handlers[EMBRYO_THREADED_END];
+   tc[n].arg.cell = 0;
+
+   /* find the instructions */
+   for (i = 0; i < n; i += num + 1)
+     {
+        op = (unsigned char)code[i];
+        if (op >= EMBRYO_OP_NUM_OPCODES) op = EMBRYO_OP_NONE;
+        num = _embryo_threaded_operands_get(code, n, i);
+        if (num < 0) goto error;
+        tc[i].op = handlers[op];
+     }
+
+   /* resolve where they go, and pair them */
+   for (i = 0; i < n; i += num + 1)
+     {
+        op = (unsigned char)code[i];
+        num = _embryo_threaded_operands_get(code, n, i);
+        switch (op)
+          {
+           case EMBRYO_OP_CALL:
+           case EMBRYO_OP_JUMP:
+           case EMBRYO_OP_JZER:
+           case EMBRYO_OP_JNZ:
+           case EMBRYO_OP_JEQ:
+           case EMBRYO_OP_JNEQ:
+           case EMBRYO_OP_JLESS:
+           case EMBRYO_OP_JLEQ:
+           case EMBRYO_OP_JGRTR:
+           case EMBRYO_OP_JGEQ:
+           case EMBRYO_OP_JSLESS:
+           case EMBRYO_OP_JSLEQ:
+           case EMBRYO_OP_JSGRTR:
+           case EMBRYO_OP_JSGEQ:
+             tc[i + 1].arg.addr = _embryo_threaded_addr_get
+               (tc, n, code[i + 1], handlers[EMBRYO_THREADED_INVALID]);
+             if (!tc[i + 1].arg.addr) goto error;
+             break;
+           case EMBRYO_OP_JREL:
+             tc[i + 1].arg.addr = _embryo_threaded_addr_get
+               (tc, n, ((i + 2) * sizeof(Embryo_Cell)) + code[i + 1],
+                handlers[EMBRYO_THREADED_INVALID]);
+             if (!tc[i + 1].arg.addr) goto error;
+             break;
+           case EMBRYO_OP_SWITCH:
+             tc[i + 1].arg.addr = _embryo_threaded_addr_get
+               (tc, n, code[i + 1], handlers[EMBRYO_THREADED_INVALID]);
+             if ((!tc[i + 1].arg.addr) ||
+                 (tc[i + 1].arg.addr->op != handlers[EMBRYO_OP_CASETBL]))
+               goto error;
+             break;
+           case EMBRYO_OP_CASETBL:
+             /* the default and then the address of each record */
+             for (k = i + 2; k <= i + num; k += 2)
+               {
+                  tc[k].arg.addr = _embryo_threaded_addr_get
+                    (tc, n, code[k], handlers[EMBRYO_THREADED_INVALID]);
+                  if (!tc[k].arg.addr) goto error;
+               }
+             break;
+           default:
+             break;
+          }
+
+        j = i + num + 1;
+        if (j >= n) continue;
+        for (k = 0; k < (int)EINA_C_ARRAY_LENGTH(_embryo_threaded_pairs); k++)
+          {
+             if ((_embryo_threaded_pairs[k].first == op) &&
+                 (_embryo_threaded_pairs[k].second == (unsigned char)code[j]))
+               {
+                  tc[i].op = handlers[_embryo_threaded_pairs[k].handler];
+                  break;
+               }
+          }
+     }
+
+   ep->threaded = tc;
+   return;
+
+error:
+   free(tc);
+}
+
+int
+_embryo_threaded_run(Embryo_Program *ep, int max_run_cycles,
+                     Embryo_Status *status, int *cycle_count)
+{
+   *cycle_count = -1;
+   *status = _embryo_threaded_exec(ep, max_run_cycles, cycle_count, NULL);
+   return (*cycle_count < 0);
+}
+
+#else
+
+void
+_embryo_threaded_init(Embryo_Program *ep EINA_UNUSED)
+{
+}
+
+int
+_embryo_threaded_run(Embryo_Program *ep, int max_run_cycles EINA_UNUSED,
+                     Embryo_Status *status, int *cycle_count EINA_UNUSED)
+{
+   ep->error = EMBRYO_ERROR_INIT;
+   *status = EMBRYO_PROGRAM_FAIL;
+   return 1;
+}
+
+#endif
@@ -262,6 +262,19 @@ typedef unsigned int Eo_Op;
  */
 typedef void (*eo_op_func_type)(Eo *, void *class_data, va_list *list);
 
+/**
+ * @typedef eo_op_func_direct_type
+ * The generic type of the direct op functions. A direct function takes the
+ * object and its class data followed by the op parameters as typed
+ * arguments, it is stored as this type and cast back to its real type by
+ * eo_do_direct().
+ *
+ * @see EO_OP_FUNC_DIRECT
+ * @see eo_do_direct
+ * @since 1.10
+ */
+typedef void (*eo_op_func_direct_type)(void);
+
 /**
  * @addtogroup Eo_Events Eo's Event Handling
  * @{
@@ -390,6 +403,7 @@ struct _Eo_Op_Func_Description
    Eo_Op op; /**< The op */
    eo_op_func_type func; /**< The function to call for the op. */
    Eo_Op_Type op_type; /**< The type of the op */
+   eo_op_func_direct_type direct; /**< The typed function to call for the op from eo_do_direct(), can be @c NULL. @since 1.10 */
 };
 
 /**
@@ -403,7 +417,21 @@ typedef struct _Eo_Op_Func_Description Eo_Op_Func_Description;
  * A convenience macro to be used when populating the #Eo_Op_Func_Description
  * array.
  */
-#define EO_OP_FUNC(op, func) { op, EO_TYPECHECK(eo_op_func_type, func), EO_OP_TYPE_REGULAR }
+#define EO_OP_FUNC(op, func) { op, EO_TYPECHECK(eo_op_func_type, func), EO_OP_TYPE_REGULAR, NULL }
+
+/**
+ * @def EO_OP_FUNC_DIRECT(op, func, direct_type, direct)
+ * A convenience macro to be used when populating the #Eo_Op_Func_Description
+ * array.
+ * The same as #EO_OP_FUNC but also sets the function called by
+ * eo_do_direct(). @p direct must be of type @p direct_type and do the same
+ * as @p func. It is only used as long as no subclass overrides the op.
+ *
+ * @see EO_OP_FUNC
+ * @see eo_do_direct
+ * @since 1.10
+ */
+#define EO_OP_FUNC_DIRECT(op, func, direct_type, direct) { op, EO_TYPECHECK(eo_op_func_type, func), EO_OP_TYPE_REGULAR, (eo_op_func_direct_type) EO_TYPECHECK(direct_type, direct) }
 
 /**
  * @def EO_OP_FUNC_CLASS(op, func)
@@ -413,14 +441,14 @@ typedef struct _Eo_Op_Func_Description Eo_Op_Func_Description;
  *
  * @see EO_OP_FUNC
  */
-#define EO_OP_FUNC_CLASS(op, func) { op, EO_TYPECHECK(eo_op_func_type, func), EO_OP_TYPE_CLASS }
+#define EO_OP_FUNC_CLASS(op, func) { op, EO_TYPECHECK(eo_op_func_type, func), EO_OP_TYPE_CLASS, NULL }
 
 /**
  * @def EO_OP_FUNC_SENTINEL
  * A convenience macro to be used when populating the #Eo_Op_Func_Description
  * array. It must appear at the end of the ARRAY.
  */
-#define EO_OP_FUNC_SENTINEL { 0, NULL, EO_OP_TYPE_INVALID }
+#define EO_OP_FUNC_SENTINEL { 0, NULL, EO_OP_TYPE_INVALID, NULL }
 
 /**
  * @struct _Eo_Op_Description
@@ -630,6 +658,131 @@ EAPI Eina_Bool eo_do_internal(const char *file, int line, const Eo *obj, ...);
  */
 EAPI Eina_Bool eo_vdo_internal(const char *file, int line, const Eo *obj, va_list *ops);
 
+/**
+ * @struct _Eo_Call_Cache
+ * The per call site cache used by eo_do_direct().
+ * Don't touch it if you don't know what you are doing.
+ * @internal
+ * @since 1.10
+ */
+struct _Eo_Call_Cache
+{
+   const void *klass; /**< The class of the last object called. */
+   eo_op_func_direct_type func; /**< Its direct function, @c NULL if none. */
+   ptrdiff_t data_offset; /**< Offset of the class data, -1 if none. */
+   Eo_Op op; /**< The op the cache was filled for. */
+   unsigned int generation; /**< Invalidates the cache on eo_shutdown(). */
+};
+
+/**
+ * @typedef Eo_Call_Cache
+ * A convenience typedef for #_Eo_Call_Cache
+ * @since 1.10
+ */
+typedef struct _Eo_Call_Cache Eo_Call_Cache;
+
+/**
+ * @struct _Eo_Call
+ * A resolved direct call, filled by eo_call_resolve().
+ * Don't touch it if you don't know what you are doing.
+ * @internal
+ * @since 1.10
+ */
+struct _Eo_Call
+{
+   eo_op_func_direct_type func; /**< The function to call. */
+   Eo *self; /**< The object to pass to func. */
+   void *data; /**< The class data to pass to func. */
+   void *ref; /**< The referenced object. */
+   Eina_Bool prev_error; /**< The error state to restore. */
+};
+
+/**
+ * @typedef Eo_Call
+ * A convenience typedef for #_Eo_Call
+ * @since 1.10
+ */
+typedef struct _Eo_Call Eo_Call;
+
+/**
+ * @brief Resolves the direct function of an op for an object.
+ * @param obj The object to work on.
+ * @param op The op to resolve.
+ * @param cache The call site cache.
+ * @param call The call to fill.
+ * @return @c EINA_FALSE if the op has to be called with eo_do().
+ *
+ * On success, call->func is either the function to call, in which case
+ * eo_call_end() has to be called afterwards, or @c NULL if @p obj is not a
+ * valid object.
+ * Use #eo_do_direct instead of this function.
+ *
+ * @see #eo_do_direct
+ * @since 1.10
+ */
+EAPI Eina_Bool eo_call_resolve(const Eo *obj, Eo_Op op, Eo_Call_Cache *cache, Eo_Call *call);
+
+/**
+ * @brief Ends a direct call started by eo_call_resolve().
+ * @param call The call.
+ * @return @c EINA_TRUE on success.
+ *
+ * Use #eo_do_direct instead of this function.
+ *
+ * @see #eo_do_direct
+ * @since 1.10
+ */
+EAPI Eina_Bool eo_call_end(Eo_Call *call);
+
+#define _EO_DIRECT_OP(op, ...) op
+#define _EO_DIRECT_ARGS(op, ...) , ## __VA_ARGS__
+#define _EO_DIRECT_EXPAND(macro, ...) macro(__VA_ARGS__)
+
+/**
+ * @def eo_do_direct(obj, direct_type, op)
+ * Calls one op of an object like eo_do(), but without packing the
+ * parameters in a va_list.
+ *
+ * @param obj The object to work on.
+ * @param direct_type The type of the direct function of the op.
+ * @param op The op and its parameters, as passed to eo_do().
+ * @return @c EINA_TRUE on success.
+ *
+ * The function implementing @p op for the class of @p obj is looked up
+ * once and cached at the call site, then called directly with typed
+ * arguments if the class registered one with #EO_OP_FUNC_DIRECT. Otherwise
+ * it falls back to eo_do(). This is meant for hot paths calling the same
+ * op on objects of the same class over and over, like the legacy wrappers.
+ * A call site must only be used from one thread at a time.
+ *
+ * @code
+ * eo_do_direct(obj, evas_obj_position_set_func, evas_obj_position_set(x, y));
+ * @endcode
+ *
+ * @see eo_do
+ * @see EO_OP_FUNC_DIRECT
+ * @since 1.10
+ */
+#define eo_do_direct(obj, direct_type, op) \
+   ({ \
+    static Eo_Call_Cache ___cache; \
+    Eo_Call ___call; \
+    Eina_Bool ___ret = EINA_FALSE; \
+    if (eo_call_resolve(obj, _EO_DIRECT_EXPAND(_EO_DIRECT_OP, op), \
+                        &___cache, &___call)) \
+      { \
+         if (___call.func) \
+           { \
+              ((direct_type) ___call.func)(___call.self, ___call.data \
+                                           _EO_DIRECT_EXPAND(_EO_DIRECT_ARGS, op)); \
+              ___ret = eo_call_end(&___call); \
+           } \
+      } \
+    else \
+      ___ret = eo_do(obj, op); \
+    ___ret; \
+    })
+
 /**
  * @brief Calls the super function for the specific op.
  * @param obj The object to work on
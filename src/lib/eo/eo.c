@@ -20,6 +20,8 @@ static _Eo_Class **_eo_classes;
 static Eo_Id _eo_classes_last_id;
 static Eina_Bool _eo_init_count = 0;
 static Eo_Op _eo_ops_last_id = 0;
+/* Bumped on every eo_init(), invalidates the eo_do_direct() caches. */
+static unsigned int _eo_generation = 0;
 
 static size_t _eo_sz = 0;
 static size_t _eo_class_sz = 0;
@@ -96,7 +98,7 @@ _dich_func_get(const _Eo_Class *klass, Eo_Op op)
 }
 
 static inline void
-_dich_func_set(_Eo_Class *klass, Eo_Op op, eo_op_func_type func)
+_dich_func_set(_Eo_Class *klass, Eo_Op op, eo_op_func_type func, eo_op_func_direct_type direct)
 {
    size_t idx1 = DICH_CHAIN1(op);
    Dich_Chain1 *chain1 = &klass->chain[idx1];
@@ -110,6 +112,7 @@ _dich_func_set(_Eo_Class *klass, Eo_Op op, eo_op_func_type func)
      }
 
    chain1->funcs[DICH_CHAIN_LAST(op)].func = func;
+   chain1->funcs[DICH_CHAIN_LAST(op)].direct = direct;
    chain1->funcs[DICH_CHAIN_LAST(op)].src = klass;
 }
 
@@ -417,6 +420,73 @@ eo_vdo_internal(const char *file, int line, const Eo *obj_id, va_list *ops)
      }
 }
 
+static void
+_eo_call_cache_fill(const _Eo_Object *obj, Eo_Op op, Eo_Call_Cache *cache)
+{
+   const op_type_funcs *func = _dich_func_get(obj->klass, op);
+
+   cache->klass = obj->klass;
+   cache->op = op;
+   cache->generation = _eo_generation;
+   cache->func = NULL;
+   cache->data_offset = -1;
+
+   /* Only the most derived implementation is called directly, an override
+    * without a direct function resets it in the dich. */
+   if (func && func->direct)
+     {
+        void *data = _eo_data_scope_get(obj, func->src);
+
+        /* The data layout only depends on the object's class. */
+        if (data)
+          cache->data_offset = (char *) data - (char *) obj;
+        cache->func = func->direct;
+     }
+}
+
+EAPI Eina_Bool
+eo_call_resolve(const Eo *obj_id, Eo_Op op, Eo_Call_Cache *cache, Eo_Call *call)
+{
+   call->func = NULL;
+
+   /* Class ops always go through eo_do(). */
+   if (EINA_UNLIKELY(_eo_is_a_class(obj_id)))
+     return EINA_FALSE;
+
+   EO_OBJ_POINTER_RETURN_VAL(obj_id, obj, EINA_TRUE);
+
+   if (EINA_UNLIKELY((cache->klass != obj->klass) || (cache->op != op) ||
+                     (cache->generation != _eo_generation)))
+     _eo_call_cache_fill(obj, op, cache);
+
+   if (!cache->func)
+     return EINA_FALSE;
+
+   call->func = cache->func;
+   call->self = (Eo *) obj_id;
+   call->data = (cache->data_offset < 0) ?
+      NULL : ((char *) obj) + cache->data_offset;
+   call->prev_error = obj->do_error;
+   call->ref = _eo_ref(obj);
+
+   return EINA_TRUE;
+}
+
+EAPI Eina_Bool
+eo_call_end(Eo_Call *call)
+{
+   _Eo_Object *obj = call->ref;
+   Eina_Bool ret = EINA_TRUE;
+
+   if (obj->do_error)
+     ret = EINA_FALSE;
+
+   obj->do_error = call->prev_error;
+   _eo_unref(obj);
+
+   return ret;
+}
+
 EAPI Eina_Bool
 eo_do_super_internal(const char *file, int line, const Eo *obj_id, const Eo_Class *cur_klass_id, Eo_Op op, ...)
 {
@@ -657,7 +727,7 @@ eo_class_funcs_set(Eo_Class *klass_id, const Eo_Op_Func_Description *func_descs)
                }
              else if (EINA_LIKELY(itr->op_type == op_desc->op_type))
                {
-                  _dich_func_set(klass, itr->op, itr->func);
+                  _dich_func_set(klass, itr->op, itr->func, itr->direct);
                }
              else
                {
@@ -985,17 +1055,17 @@ eo_class_new(const Eo_Class_Description *desc, const Eo_Class *parent_id, ...)
              const _Eo_Class *extn = *extn_itr;
              /* Set it in the dich. */
              _dich_func_set(klass, extn->base_id +
-                   extn->desc->ops.count, _eo_class_isa_func);
+                   extn->desc->ops.count, _eo_class_isa_func, NULL);
           }
 
         _dich_func_set(klass, klass->base_id + klass->desc->ops.count,
-              _eo_class_isa_func);
+              _eo_class_isa_func, NULL);
 
         if (klass->parent)
           {
              _dich_func_set(klass,
                    klass->parent->base_id + klass->parent->desc->ops.count,
-                   _eo_class_isa_func);
+                   _eo_class_isa_func, NULL);
           }
      }
 
@@ -1411,6 +1481,8 @@ eo_init(void)
 
    eina_init();
 
+   _eo_generation++;
+
    _eo_sz = EO_ALIGN_SIZE(sizeof(_Eo_Object));
    _eo_class_sz = EO_ALIGN_SIZE(sizeof(_Eo_Class));
 
@@ -112,6 +112,7 @@ typedef struct _Dich_Chain1 Dich_Chain1;
 typedef struct
 {
    eo_op_func_type func;
+   eo_op_func_direct_type direct;
    const _Eo_Class *src;
 } op_type_funcs;
 
@@ -399,6 +399,7 @@ typedef struct _Evas_Event_Key_Down      Evas_Event_Key_Down; /**< Event structu
 typedef struct _Evas_Event_Key_Up        Evas_Event_Key_Up; /**< Event structure for #EVAS_CALLBACK_KEY_UP event callbacks */
 typedef struct _Evas_Event_Hold          Evas_Event_Hold; /**< Event structure for #EVAS_CALLBACK_HOLD event callbacks */
 typedef struct _Evas_Event_Render_Post   Evas_Event_Render_Post; /**< Event structure that may come with #EVAS_CALLBACK_RENDER_POST event callbacks @since 1.8 */
+typedef struct _Evas_Render_Stats        Evas_Render_Stats; /**< Timings and counters of one rendered frame, see evas_render_stats_get() @since 1.10 */
 
 typedef enum _Evas_Alloc_Error
 {
@@ -772,6 +773,21 @@ struct _Evas_Event_Render_Post /** Send when the frame rendering is done @since
    Eina_List *updated_area; /**< A list of rectangle that were updated in the canvas */
 };
 
+struct _Evas_Render_Stats /** Timings and counters of one rendered frame @since 1.10 */
+{
+   unsigned int       frame; /**< Serial number of the frame on its canvas, starting at 1 */
+   Eina_Bool          async; /**< Whether the frame was drawn by the render thread */
+   double             phase1; /**< Seconds spent calculating and pre-rendering the changed objects */
+   double             updates; /**< Seconds spent building the regions to redraw */
+   double             render; /**< Seconds spent drawing, until the render thread finished for asynchronous frames */
+   double             flush; /**< Seconds spent flushing the drawn regions to the output */
+   double             total; /**< Seconds from the start of the frame until it was flushed */
+   unsigned int       objects; /**< Objects active in the frame */
+   unsigned int       objects_drawn; /**< Objects drawn, an object drawn in two regions counts twice */
+   unsigned int       regions; /**< Regions redrawn */
+   unsigned long long pixels; /**< Pixels covered by the redrawn regions */
+};
+
 struct _Evas_Event_Hold /** Hold change event */
 {
    int              hold; /**< The hold flag */
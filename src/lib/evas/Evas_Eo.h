@@ -258,6 +258,11 @@ enum
    EVAS_CANVAS_SUB_ID_SMART_OBJECTS_CALCULATE_COUNT_GET,
    EVAS_CANVAS_SUB_ID_RENDER_ASYNC,
    EVAS_CANVAS_SUB_ID_TREE_OBJECTS_AT_XY_GET,
+   EVAS_CANVAS_SUB_ID_RENDER_STATS_SIZE_SET,
+   EVAS_CANVAS_SUB_ID_RENDER_STATS_SIZE_GET,
+   EVAS_CANVAS_SUB_ID_RENDER_STATS_GET,
+   EVAS_CANVAS_SUB_ID_EVENT_SPATIAL_INDEX_SET,
+   EVAS_CANVAS_SUB_ID_EVENT_SPATIAL_INDEX_GET,
    EVAS_CANVAS_SUB_ID_LAST
 };
 
@@ -743,6 +748,68 @@ enum
  */
 #define evas_canvas_render_dump() EVAS_CANVAS_ID(EVAS_CANVAS_SUB_ID_RENDER_DUMP)
 
+/**
+ * @def evas_canvas_render_stats_size_set
+ * @since 1.10
+ *
+ * Set how many of the last rendered frames the canvas keeps statistics for.
+ *
+ * @param[in] frames
+ *
+ * @see evas_render_stats_size_set
+ */
+#define evas_canvas_render_stats_size_set(frames) EVAS_CANVAS_ID(EVAS_CANVAS_SUB_ID_RENDER_STATS_SIZE_SET), EO_TYPECHECK(unsigned int, frames)
+
+/**
+ * @def evas_canvas_render_stats_size_get
+ * @since 1.10
+ *
+ * Get how many of the last rendered frames the canvas keeps statistics for.
+ *
+ * @param[out] ret
+ *
+ * @see evas_render_stats_size_get
+ */
+#define evas_canvas_render_stats_size_get(ret) EVAS_CANVAS_ID(EVAS_CANVAS_SUB_ID_RENDER_STATS_SIZE_GET), EO_TYPECHECK(unsigned int *, ret)
+
+/**
+ * @def evas_canvas_render_stats_get
+ * @since 1.10
+ *
+ * Get the statistics of the last frames rendered by the canvas.
+ *
+ * @param[out] stats
+ * @param[in] count
+ * @param[out] ret
+ *
+ * @see evas_render_stats_get
+ */
+#define evas_canvas_render_stats_get(stats, count, ret) EVAS_CANVAS_ID(EVAS_CANVAS_SUB_ID_RENDER_STATS_GET), EO_TYPECHECK(Evas_Render_Stats *, stats), EO_TYPECHECK(unsigned int, count), EO_TYPECHECK(unsigned int *, ret)
+
+/**
+ * @def evas_canvas_event_spatial_index_set
+ * @since 1.10
+ *
+ * Enable or disable the spatial index used to find the objects under a point.
+ *
+ * @param[in] enabled
+ *
+ * @see evas_event_spatial_index_set
+ */
+#define evas_canvas_event_spatial_index_set(enabled) EVAS_CANVAS_ID(EVAS_CANVAS_SUB_ID_EVENT_SPATIAL_INDEX_SET), EO_TYPECHECK(Eina_Bool, enabled)
+
+/**
+ * @def evas_canvas_event_spatial_index_get
+ * @since 1.10
+ *
+ * Get whether the canvas uses a spatial index to find the objects under a point.
+ *
+ * @param[out] ret
+ *
+ * @see evas_event_spatial_index_get
+ */
+#define evas_canvas_event_spatial_index_get(ret) EVAS_CANVAS_ID(EVAS_CANVAS_SUB_ID_EVENT_SPATIAL_INDEX_GET), EO_TYPECHECK(Eina_Bool *, ret)
+
 /**
  * @}
  */
@@ -2351,6 +2418,8 @@ enum
    EVAS_OBJ_TEXTBLOCK_SUB_ID_SIZE_FORMATTED_GET,
    EVAS_OBJ_TEXTBLOCK_SUB_ID_SIZE_NATIVE_GET,
    EVAS_OBJ_TEXTBLOCK_SUB_ID_STYLE_INSETS_GET,
+   EVAS_OBJ_TEXTBLOCK_SUB_ID_VIRTUAL_LAYOUT_SET,
+   EVAS_OBJ_TEXTBLOCK_SUB_ID_VIRTUAL_LAYOUT_GET,
    EVAS_OBJ_TEXTBLOCK_SUB_ID_LAST
 };
 
@@ -2682,6 +2751,30 @@ enum
  * @see evas_object_textblock_style_insets_get
  */
 #define evas_obj_textblock_style_insets_get(l, r, t, b) EVAS_OBJ_TEXTBLOCK_ID(EVAS_OBJ_TEXTBLOCK_SUB_ID_STYLE_INSETS_GET), EO_TYPECHECK(Evas_Coord *, l), EO_TYPECHECK(Evas_Coord *, r), EO_TYPECHECK(Evas_Coord *, t), EO_TYPECHECK(Evas_Coord *, b)
+
+/**
+ * @def evas_obj_textblock_virtual_layout_set
+ * @since 1.10
+ *
+ * Sets if only the paragraphs in view are laid out.
+ *
+ * @param[in] enabled
+ *
+ * @see evas_object_textblock_virtual_layout_set
+ */
+#define evas_obj_textblock_virtual_layout_set(enabled) EVAS_OBJ_TEXTBLOCK_ID(EVAS_OBJ_TEXTBLOCK_SUB_ID_VIRTUAL_LAYOUT_SET), EO_TYPECHECK(Eina_Bool, enabled)
+
+/**
+ * @def evas_obj_textblock_virtual_layout_get
+ * @since 1.10
+ *
+ * Gets if only the paragraphs in view are laid out.
+ *
+ * @param[out] enabled
+ *
+ * @see evas_object_textblock_virtual_layout_get
+ */
+#define evas_obj_textblock_virtual_layout_get(enabled) EVAS_OBJ_TEXTBLOCK_ID(EVAS_OBJ_TEXTBLOCK_SUB_ID_VIRTUAL_LAYOUT_GET), EO_TYPECHECK(Eina_Bool *, enabled)
 /**
  * @}
  */
@@ -4543,6 +4636,13 @@ enum
  */
 #define evas_obj_position_set(x, y) EVAS_OBJ_ID(EVAS_OBJ_SUB_ID_POSITION_SET), EO_TYPECHECK(Evas_Coord, x), EO_TYPECHECK(Evas_Coord, y)
 
+/**
+ * @typedef evas_obj_position_set_func
+ * The direct function of #evas_obj_position_set, for eo_do_direct().
+ * @since 1.10
+ */
+typedef void (*evas_obj_position_set_func)(Eo *obj, void *class_data, Evas_Coord x, Evas_Coord y);
+
 /**
  * @def evas_obj_position_get
  * @since 1.8
@@ -4568,6 +4668,13 @@ enum
  */
 #define evas_obj_size_set(w, h) EVAS_OBJ_ID(EVAS_OBJ_SUB_ID_SIZE_SET), EO_TYPECHECK(Evas_Coord, w), EO_TYPECHECK(Evas_Coord, h)
 
+/**
+ * @typedef evas_obj_size_set_func
+ * The direct function of #evas_obj_size_set, for eo_do_direct().
+ * @since 1.10
+ */
+typedef void (*evas_obj_size_set_func)(Eo *obj, void *class_data, Evas_Coord w, Evas_Coord h);
+
 /**
  * @def evas_obj_size_get
  * @since 1.8
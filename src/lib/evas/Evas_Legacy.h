@@ -320,6 +320,55 @@ EAPI void              evas_render_idle_flush(Evas *e) EINA_ARG_NONNULL(1);
  */
 EAPI void              evas_render_dump(Evas *e) EINA_ARG_NONNULL(1);
 
+/**
+ * Set how many of the last rendered frames a canvas keeps statistics for.
+ *
+ * @param e The given canvas pointer.
+ * @param frames The number of frames to keep, 0 to stop collecting them.
+ *
+ * Every canvas records the time spent in each render phase and a few
+ * counters for its last frames, see evas_render_stats_get(). Changing the
+ * size drops the frames recorded so far. The default is 32 frames.
+ *
+ * @see evas_render_stats_size_get()
+ *
+ * @ingroup Evas_Canvas
+ * @since 1.10
+ */
+EAPI void              evas_render_stats_size_set(Evas *e, unsigned int frames) EINA_ARG_NONNULL(1);
+
+/**
+ * Get how many of the last rendered frames a canvas keeps statistics for.
+ *
+ * @param e The given canvas pointer.
+ * @return The number of frames kept.
+ *
+ * @see evas_render_stats_size_set()
+ *
+ * @ingroup Evas_Canvas
+ * @since 1.10
+ */
+EAPI unsigned int      evas_render_stats_size_get(const Evas *e) EINA_ARG_NONNULL(1) EINA_WARN_UNUSED_RESULT;
+
+/**
+ * Get the statistics of the last frames rendered by a canvas.
+ *
+ * @param e The given canvas pointer.
+ * @param stats An array of at least @p count elements to fill.
+ * @param count The number of frames wanted.
+ * @return The number of frames copied into @p stats.
+ *
+ * The frames are copied newest first. Only frames that were actually drawn
+ * are recorded, an asynchronous frame is only recorded once its render
+ * post callback has been called.
+ *
+ * @see evas_render_stats_size_set()
+ *
+ * @ingroup Evas_Canvas
+ * @since 1.10
+ */
+EAPI unsigned int      evas_render_stats_get(const Evas *e, Evas_Render_Stats *stats, unsigned int count) EINA_ARG_NONNULL(1);
+
 
 /**
  * @}
@@ -1056,6 +1105,38 @@ EAPI int              evas_event_freeze_get(const Evas *e) EINA_WARN_UNUSED_RESU
  * out on new objects if the state change demands it.
  */
 EAPI void             evas_event_thaw_eval(Evas *e) EINA_ARG_NONNULL(1);
+
+/**
+ * Enable or disable the spatial index used to find the objects under a point
+ *
+ * @param e The given canvas pointer.
+ * @param enabled EINA_TRUE to use the index, EINA_FALSE to walk every object.
+ *
+ * Without the index, every mouse move walks all the objects of the canvas
+ * layers and of the smart objects under the pointer. With it, the layers and
+ * smart objects holding many objects keep them in a quadtree updated as they
+ * move, and only the objects near the pointer are tested. This also applies
+ * to evas_tree_objects_at_xy_get(), evas_objects_at_xy_get(),
+ * evas_objects_in_rectangle_get() and friends. The results are the same
+ * either way, it is disabled by default.
+ *
+ * @see evas_event_spatial_index_get()
+ *
+ * @since 1.10
+ */
+EAPI void             evas_event_spatial_index_set(Evas *e, Eina_Bool enabled) EINA_ARG_NONNULL(1);
+
+/**
+ * Get whether the canvas uses a spatial index to find the objects under a point
+ *
+ * @param e The given canvas pointer.
+ * @return EINA_TRUE if the index is used.
+ *
+ * @see evas_event_spatial_index_set()
+ *
+ * @since 1.10
+ */
+EAPI Eina_Bool        evas_event_spatial_index_get(const Evas *e) EINA_WARN_UNUSED_RESULT EINA_ARG_NONNULL(1);
 /**
  * @}
  */
@@ -5752,6 +5833,36 @@ EAPI void                                     evas_object_textblock_legacy_newli
  */
 EAPI Eina_Bool                                evas_object_textblock_legacy_newline_get(const Evas_Object *obj) EINA_WARN_UNUSED_RESULT EINA_ARG_NONNULL(1);
 
+/**
+ * @brief Sets if only the paragraphs in view are laid out.
+ *
+ * Meant for very long texts. Only the paragraphs that can be seen through
+ * the object's clippers and the canvas viewport, and as much above and
+ * below, are laid out in full. The height of the others is estimated from
+ * the average line height and character width, and refined when they come
+ * into view. The formatted and native sizes are estimates too, and may
+ * change while scrolling.
+ *
+ * Cursor and line queries lay out the paragraphs they need.
+ *
+ * @param obj The given textblock object.
+ * @param enabled @c EINA_TRUE to lay out only what is in view, @c EINA_FALSE
+ * to lay out everything (default).
+ * @since 1.10
+ */
+EAPI void                                     evas_object_textblock_virtual_layout_set(Evas_Object *obj, Eina_Bool enabled) EINA_ARG_NONNULL(1);
+
+/**
+ * @brief Gets if only the paragraphs in view are laid out.
+ *
+ * @param obj The given textblock object.
+ * @return @c EINA_TRUE if only what is in view is laid out, @c EINA_FALSE
+ * otherwise.
+ * @see evas_object_textblock_virtual_layout_set()
+ * @since 1.10
+ */
+EAPI Eina_Bool                                evas_object_textblock_virtual_layout_get(const Evas_Object *obj) EINA_WARN_UNUSED_RESULT EINA_ARG_NONNULL(1);
+
 /**
  * Sets the tetxblock's text to the markup text.
  *
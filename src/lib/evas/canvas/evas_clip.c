@@ -15,6 +15,8 @@ evas_object_clip_dirty(Evas_Object *eo_obj EINA_UNUSED, Evas_Object_Protected_Da
      }
    EINA_COW_STATE_WRITE_END(obj, state_write, cur);
 
+   if (obj->event_index.item) eina_quadtree_change(obj->event_index.item);
+
    EINA_LIST_FOREACH(obj->clip.clipees, l, clipee)
      {
         evas_object_clip_dirty(clipee->object, clipee);
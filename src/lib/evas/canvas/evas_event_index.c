@@ -0,0 +1,386 @@
+#include "evas_common_private.h"
+#include "evas_private.h"
+
+/* Optional spatial index over the object lists walked by the event code.
+ *
+ * Each layer and each smart object with enough members gets an
+ * Eina_QuadTree of its direct children, built lazily on the first query.
+ * A query returns the children whose hit area may contain the target,
+ * ordered bottom to top, and the caller runs its usual tests on them
+ * only. The boxes are conservative: anything the linear walk could find
+ * must be returned, returning too much is fine. */
+
+#define EVAS_EVENT_INDEX_MIN_OBJECTS 32
+
+struct _Evas_Event_Index
+{
+   Eina_QuadTree *tree;
+   Eina_Array     hits;
+   Evas_Layer    *layer; // owner, either a layer
+   Evas_Object   *smart; // or a smart object
+   int            w, h;
+   unsigned int   rank;
+   Eina_Bool      order_dirty : 1;
+};
+
+static const Eina_Inlist *
+_evas_event_index_list_get(const Evas_Event_Index *idx)
+{
+   if (idx->smart) return evas_object_smart_members_get_direct(idx->smart);
+   if (!idx->layer->objects) return NULL;
+   return EINA_INLIST_GET(idx->layer->objects);
+}
+
+/* grows box to cover the rectangle with its edges included, the hit tests
+ * of the smart objects are inclusive and an empty rectangle still
+ * intersects the bigger ones around it */
+static void
+_evas_event_index_rect_add(Eina_Rectangle *box, Eina_Bool *empty,
+                           int x, int y, int w, int h)
+{
+   int x2, y2;
+
+   if (w < 0)
+     {
+        x += w;
+        w = -w;
+     }
+   if (h < 0)
+     {
+        y += h;
+        h = -h;
+     }
+   w++;
+   h++;
+   if (*empty)
+     {
+        EINA_RECTANGLE_SET(box, x, y, w, h);
+        *empty = EINA_FALSE;
+        return;
+     }
+   x2 = MAX(box->x + box->w, x + w);
+   y2 = MAX(box->y + box->h, y + h);
+   box->x = MIN(box->x, x);
+   box->y = MIN(box->y, y);
+   box->w = x2 - box->x;
+   box->h = y2 - box->y;
+}
+
+/* area where the object can be hit, EINA_FALSE if it can be anywhere */
+static Eina_Bool
+_evas_event_index_box_get(Evas_Object_Protected_Data *obj, Eina_Rectangle *box)
+{
+   Evas_Coord_Rectangle bb;
+   Eina_Bool empty = EINA_TRUE;
+
+   // a dirty clip is recalculated by some of the walks before testing it
+   if (obj->cur->cache.clip.dirty) return EINA_FALSE;
+
+   _evas_event_index_rect_add(box, &empty,
+                              obj->cur->cache.clip.x, obj->cur->cache.clip.y,
+                              obj->cur->cache.clip.w, obj->cur->cache.clip.h);
+   if (!obj->is_smart) return EINA_TRUE;
+
+   // mapped children can land anywhere
+   if (obj->child_has_map) return EINA_FALSE;
+
+   evas_object_smart_bounding_box_update(obj->object, obj);
+   evas_object_smart_bounding_box_get(obj->object, &bb, NULL);
+   _evas_event_index_rect_add(box, &empty, bb.x, bb.y, bb.w, bb.h);
+   _evas_event_index_rect_add(box, &empty,
+                              obj->cur->geometry.x, obj->cur->geometry.y,
+                              obj->cur->geometry.w, obj->cur->geometry.h);
+   return EINA_TRUE;
+}
+
+static Eina_Quad_Direction
+_evas_event_index_side(int start, int len, int middle)
+{
+   if (start + len <= middle) return EINA_QUAD_LEFT;
+   if (start >= middle) return EINA_QUAD_RIGHT;
+   return EINA_QUAD_BOTH;
+}
+
+static Eina_Quad_Direction
+_evas_event_index_vertical(const void *object, size_t middle)
+{
+   Eina_Rectangle box;
+
+   if (!_evas_event_index_box_get((Evas_Object_Protected_Data *)object, &box))
+     return EINA_QUAD_BOTH;
+   return _evas_event_index_side(box.y, box.h, middle);
+}
+
+static Eina_Quad_Direction
+_evas_event_index_horizontal(const void *object, size_t middle)
+{
+   Eina_Rectangle box;
+
+   if (!_evas_event_index_box_get((Evas_Object_Protected_Data *)object, &box))
+     return EINA_QUAD_BOTH;
+   return _evas_event_index_side(box.x, box.w, middle);
+}
+
+static Evas_Event_Index **
+_evas_event_index_slot_get(Evas_Object_Protected_Data *obj)
+{
+   Evas_Object_Protected_Data *parent;
+
+   if (!obj->smart.parent) return &obj->layer->event_index;
+   parent = eo_data_scope_get(obj->smart.parent, EVAS_OBJ_CLASS);
+   if (!parent) return NULL;
+   return &parent->event_index.members;
+}
+
+static Evas_Event_Index *
+_evas_event_index_new(Evas_Object_Protected_Data *member, int w, int h)
+{
+   Evas_Event_Index *idx;
+   Evas_Object_Protected_Data *obj;
+
+   idx = calloc(1, sizeof (Evas_Event_Index));
+   if (!idx) return NULL;
+   idx->tree = eina_quadtree_new(w, h,
+                                 _evas_event_index_vertical,
+                                 _evas_event_index_horizontal);
+   if (!idx->tree)
+     {
+        free(idx);
+        return NULL;
+     }
+   eina_array_step_set(&idx->hits, sizeof (Eina_Array), 32);
+   idx->w = w;
+   idx->h = h;
+   idx->smart = member->smart.parent;
+   if (!idx->smart) idx->layer = member->layer;
+
+   EINA_INLIST_FOREACH(_evas_event_index_list_get(idx), obj)
+     evas_event_index_add(idx, obj);
+
+   return idx;
+}
+
+void
+evas_event_index_free(Evas_Event_Index *idx)
+{
+   Evas_Object_Protected_Data *obj;
+
+   if (!idx) return;
+   EINA_INLIST_FOREACH(_evas_event_index_list_get(idx), obj)
+     obj->event_index.item = NULL;
+   eina_quadtree_free(idx->tree);
+   eina_array_flush(&idx->hits);
+   free(idx);
+}
+
+void
+evas_event_index_add(Evas_Event_Index *idx, Evas_Object_Protected_Data *obj)
+{
+   if (!idx) return;
+   // objects always join at the top of their list
+   obj->event_index.item = eina_quadtree_add(idx->tree, obj);
+   obj->event_index.rank = idx->rank++;
+}
+
+void
+evas_event_index_del(Evas_Object_Protected_Data *obj)
+{
+   if (!obj->event_index.item) return;
+   // queue it as changed first so the tree drops its cached collision list
+   eina_quadtree_change(obj->event_index.item);
+   eina_quadtree_del(obj->event_index.item);
+   obj->event_index.item = NULL;
+}
+
+void
+evas_event_index_change(Evas_Object_Protected_Data *obj)
+{
+   if (!obj->layer->evas->spatial_index) return;
+   // a smart object hit area covers its members, so update the parents too
+   while (obj)
+     {
+        if (obj->event_index.item) eina_quadtree_change(obj->event_index.item);
+        if (!obj->smart.parent) break;
+        obj = eo_data_scope_get(obj->smart.parent, EVAS_OBJ_CLASS);
+     }
+}
+
+void
+evas_event_index_restack(Evas_Object_Protected_Data *obj)
+{
+   Evas_Event_Index **slot;
+
+   if ((!obj->layer) || (!obj->layer->evas->spatial_index)) return;
+   slot = _evas_event_index_slot_get(obj);
+   if ((slot) && (*slot)) (*slot)->order_dirty = EINA_TRUE;
+}
+
+static int
+_evas_event_index_rank_cmp(const void *a, const void *b)
+{
+   const Evas_Object_Protected_Data *oa = *(const Evas_Object_Protected_Data **)a;
+   const Evas_Object_Protected_Data *ob = *(const Evas_Object_Protected_Data **)b;
+
+   if (oa->event_index.rank < ob->event_index.rank) return -1;
+   if (oa->event_index.rank > ob->event_index.rank) return 1;
+   return 0;
+}
+
+/* candidates of the list ending with last that may be hit inside the given
+ * rectangle, bottom first, or NULL when the list should just be walked */
+static Eina_Array *
+_evas_event_index_collide(Evas_Object_Protected_Data *last,
+                          int x, int y, int w, int h)
+{
+   Evas_Public_Data *e = last->layer->evas;
+   Evas_Event_Index **slot, *idx;
+   Evas_Object_Protected_Data *obj;
+   Eina_Inlist *l;
+   int aw, ah, n;
+
+   if (!e->spatial_index) return NULL;
+
+   // the tree covers the canvas from its origin to the end of the viewport,
+   // anything reaching outside of that is left to the linear walk
+   aw = MAX(e->viewport.x + e->viewport.w, 1);
+   ah = MAX(e->viewport.y + e->viewport.h, 1);
+   if ((x < 0) || (y < 0) || (x + w > aw) || (y + h > ah)) return NULL;
+
+   slot = _evas_event_index_slot_get(last);
+   if (!slot) return NULL;
+   idx = *slot;
+
+   // short lists are cheaper to walk
+   for (l = EINA_INLIST_GET(last), n = 0;
+        l && (n < EVAS_EVENT_INDEX_MIN_OBJECTS);
+        l = l->prev, n++);
+   if (n < EVAS_EVENT_INDEX_MIN_OBJECTS) return NULL;
+
+   if (!idx)
+     {
+        idx = *slot = _evas_event_index_new(last, aw, ah);
+        if (!idx) return NULL;
+     }
+   else if ((idx->w != aw) || (idx->h != ah))
+     {
+        eina_quadtree_resize(idx->tree, aw, ah);
+        idx->w = aw;
+        idx->h = ah;
+     }
+
+   if (idx->order_dirty)
+     {
+        idx->rank = 0;
+        EINA_INLIST_FOREACH(_evas_event_index_list_get(idx), obj)
+          obj->event_index.rank = idx->rank++;
+        idx->order_dirty = EINA_FALSE;
+     }
+
+   // the collision list is made of the tree items themselves and breaks as
+   // soon as one of them changes, copy it right away
+   eina_array_clean(&idx->hits);
+   for (l = eina_quadtree_collide(idx->tree, x, y, w, h); l; l = l->next)
+     {
+        obj = eina_quadtree_object(l);
+        if (obj) eina_array_push(&idx->hits, obj);
+     }
+   if (eina_array_count(&idx->hits) > 1)
+     qsort(idx->hits.data, eina_array_count(&idx->hits), sizeof (void *),
+           _evas_event_index_rank_cmp);
+
+   return &idx->hits;
+}
+
+Evas_Object_Protected_Data *
+evas_event_index_walk_first(Evas_Event_Index_Walk *walk,
+                            Evas_Object_Protected_Data *last,
+                            int x, int y, int w, int h)
+{
+   walk->hits = NULL;
+   walk->i = 0;
+   if (!last) return NULL;
+   // only a walk over the whole list can be answered from the index
+   if (!EINA_INLIST_GET(last)->next)
+     walk->hits = _evas_event_index_collide(last, x, y, w, h);
+   if (!walk->hits) return last;
+   walk->i = eina_array_count(walk->hits);
+   return evas_event_index_walk_prev(walk, NULL);
+}
+
+Evas_Object_Protected_Data *
+evas_event_index_walk_prev(Evas_Event_Index_Walk *walk,
+                           Evas_Object_Protected_Data *obj)
+{
+   if (!walk->hits)
+     {
+        if (!EINA_INLIST_GET(obj)->prev) return NULL;
+        return _EINA_INLIST_CONTAINER(obj, EINA_INLIST_GET(obj)->prev);
+     }
+   if (!walk->i) return NULL;
+   return eina_array_data_get(walk->hits, --walk->i);
+}
+
+static void
+_evas_event_index_clear(const Eina_Inlist *list)
+{
+   Evas_Object_Protected_Data *obj;
+
+   EINA_INLIST_FOREACH(list, obj)
+     {
+        if (!obj->is_smart) continue;
+        _evas_event_index_clear(evas_object_smart_members_get_direct(obj->object));
+        evas_event_index_free(obj->event_index.members);
+        obj->event_index.members = NULL;
+     }
+}
+
+EAPI void
+evas_event_spatial_index_set(Evas *eo_e, Eina_Bool enabled)
+{
+   MAGIC_CHECK(eo_e, Evas, MAGIC_EVAS);
+   return;
+   MAGIC_CHECK_END();
+   eo_do(eo_e, evas_canvas_event_spatial_index_set(enabled));
+}
+
+void
+_canvas_event_spatial_index_set(Eo *eo_e EINA_UNUSED, void *_pd, va_list *list)
+{
+   Eina_Bool enabled = va_arg(*list, int);
+   Evas_Public_Data *e = _pd;
+   Evas_Layer *lay;
+
+   enabled = !!enabled;
+   if (e->spatial_index == enabled) return;
+   e->spatial_index = enabled;
+   if (enabled) return;
+
+   // the indexes are not kept up to date while disabled, drop them all
+   EINA_INLIST_FOREACH((EINA_INLIST_GET(e->layers)), lay)
+     {
+        if (lay->objects)
+          _evas_event_index_clear(EINA_INLIST_GET(lay->objects));
+        evas_event_index_free(lay->event_index);
+        lay->event_index = NULL;
+     }
+}
+
+EAPI Eina_Bool
+evas_event_spatial_index_get(const Evas *eo_e)
+{
+   MAGIC_CHECK(eo_e, Evas, MAGIC_EVAS);
+   return EINA_FALSE;
+   MAGIC_CHECK_END();
+   Eina_Bool ret = EINA_FALSE;
+   eo_do((Eo *)eo_e, evas_canvas_event_spatial_index_get(&ret));
+   return ret;
+}
+
+void
+_canvas_event_spatial_index_get(Eo *eo_e EINA_UNUSED, void *_pd, va_list *list)
+{
+   Eina_Bool *ret = va_arg(*list, Eina_Bool *);
+   const Evas_Public_Data *e = _pd;
+
+   *ret = e->spatial_index;
+}
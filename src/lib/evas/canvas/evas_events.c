@@ -39,12 +39,16 @@ _evas_event_object_list_raw_in_get(Evas *eo_e, Eina_List *in,
 {
    Evas_Object *eo_obj;
    Evas_Object_Protected_Data *obj = NULL;
+   Evas_Event_Index_Walk walk = { NULL, 0 };
    int inside;
 
    if (!list) return in;
-   for (obj = _EINA_INLIST_CONTAINER(obj, list); 
-        obj; 
-        obj = _EINA_INLIST_CONTAINER(obj, EINA_INLIST_GET(obj)->prev))
+   // the objects above stop must all be seen, so walk those linearly
+   for (obj = (stop ? _EINA_INLIST_CONTAINER(obj, list) :
+               evas_event_index_walk_first(&walk, _EINA_INLIST_CONTAINER(obj, list),
+                                           x, y, 1, 1));
+        obj;
+        obj = evas_event_index_walk_prev(&walk, obj))
      {
         eo_obj = obj->object;
         if (eo_obj == stop)
@@ -66,6 +66,7 @@ evas_init(void)
    _evas_preload_thread_init();
 
    evas_thread_init();
+   evas_thread_pool_init();
 
    eina_log_timing(_evas_log_dom_global,
 		   EINA_LOG_STATE_STOP,
@@ -120,6 +121,7 @@ evas_shutdown(void)
    evas_object_image_load_opts_cow = NULL;
    evas_object_image_state_cow = NULL;
 
+   evas_thread_pool_shutdown();
    evas_thread_shutdown();
    _evas_preload_thread_shutdown();
    evas_async_events_shutdown();
@@ -165,6 +167,7 @@ _constructor(Eo *eo_obj, void *class_data, va_list *list EINA_UNUSED)
    e->framespace.w = 0;
    e->framespace.h = 0;
    e->hinting = EVAS_FONT_HINTING_BYTECODE;
+   e->stats.size = EVAS_RENDER_STATS_DEFAULT_SIZE;
    e->name_hash = eina_hash_string_superfast_new(NULL);
    eina_clist_init(&e->calc_list);
    eina_clist_init(&e->calc_done);
@@ -300,6 +303,8 @@ _destructor(Eo *eo_e, void *_pd, va_list *list EINA_UNUSED)
    eina_array_flush(&e->glyph_unref_queue);
    eina_array_flush(&e->texts_unref_queue);
 
+   free(e->stats.frames);
+
    EINA_LIST_FREE(e->touch_points, touch_point)
      free(touch_point);
 
@@ -1123,6 +1128,11 @@ _class_constructor(Eo_Class *klass)
         EO_OP_FUNC(EVAS_CANVAS_ID(EVAS_CANVAS_SUB_ID_SMART_OBJECTS_CALCULATE_COUNT_GET), _canvas_smart_objects_calculate_count_get),
         EO_OP_FUNC(EVAS_CANVAS_ID(EVAS_CANVAS_SUB_ID_RENDER_ASYNC), _canvas_render_async),
         EO_OP_FUNC(EVAS_CANVAS_ID(EVAS_CANVAS_SUB_ID_TREE_OBJECTS_AT_XY_GET), _canvas_tree_objects_at_xy_get),
+        EO_OP_FUNC(EVAS_CANVAS_ID(EVAS_CANVAS_SUB_ID_RENDER_STATS_SIZE_SET), _canvas_render_stats_size_set),
+        EO_OP_FUNC(EVAS_CANVAS_ID(EVAS_CANVAS_SUB_ID_RENDER_STATS_SIZE_GET), _canvas_render_stats_size_get),
+        EO_OP_FUNC(EVAS_CANVAS_ID(EVAS_CANVAS_SUB_ID_RENDER_STATS_GET), _canvas_render_stats_get),
+        EO_OP_FUNC(EVAS_CANVAS_ID(EVAS_CANVAS_SUB_ID_EVENT_SPATIAL_INDEX_SET), _canvas_event_spatial_index_set),
+        EO_OP_FUNC(EVAS_CANVAS_ID(EVAS_CANVAS_SUB_ID_EVENT_SPATIAL_INDEX_GET), _canvas_event_spatial_index_get),
         EO_OP_FUNC_SENTINEL
    };
 
@@ -1228,6 +1238,11 @@ static const Eo_Op_Description op_desc[] = {
      EO_OP_DESCRIPTION(EVAS_CANVAS_SUB_ID_SMART_OBJECTS_CALCULATE_COUNT_GET, "Get the internal counter that counts the number of smart calculations."),
      EO_OP_DESCRIPTION(EVAS_CANVAS_SUB_ID_RENDER_ASYNC, "Renders the canvas asynchronously."),
      EO_OP_DESCRIPTION(EVAS_CANVAS_SUB_ID_TREE_OBJECTS_AT_XY_GET, "Retrieve a list of Evas objects lying over a given position in a canvas."),
+     EO_OP_DESCRIPTION(EVAS_CANVAS_SUB_ID_RENDER_STATS_SIZE_SET, "Set how many of the last rendered frames the canvas keeps statistics for."),
+     EO_OP_DESCRIPTION(EVAS_CANVAS_SUB_ID_RENDER_STATS_SIZE_GET, "Get how many of the last rendered frames the canvas keeps statistics for."),
+     EO_OP_DESCRIPTION(EVAS_CANVAS_SUB_ID_RENDER_STATS_GET, "Get the statistics of the last frames rendered by the canvas."),
+     EO_OP_DESCRIPTION(EVAS_CANVAS_SUB_ID_EVENT_SPATIAL_INDEX_SET, "Enable or disable the spatial index used to find the objects under a point."),
+     EO_OP_DESCRIPTION(EVAS_CANVAS_SUB_ID_EVENT_SPATIAL_INDEX_GET, "Get whether the canvas uses a spatial index to find the objects under a point."),
      EO_OP_DESCRIPTION_SENTINEL
 };
 
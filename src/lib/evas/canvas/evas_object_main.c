@@ -16,11 +16,11 @@ _show(Evas_Object *eo_obj, Evas_Object_Protected_Data *obj);
 static void
 _hide(Evas_Object *eo_obj, Evas_Object_Protected_Data *obj);
 
-static Eina_Inlist *
-get_layer_objects(Evas_Layer *l)
+static Evas_Object_Protected_Data *
+get_layer_objects_last(Evas_Layer *l)
 {
    if ((!l) || (!l->objects)) return NULL;
-   return (EINA_INLIST_GET(l->objects));
+   return _EINA_INLIST_CONTAINER(l->objects, EINA_INLIST_GET(l->objects)->last);
 }
 
 /* evas internal stuff */
@@ -211,6 +211,7 @@ evas_object_change(Evas_Object *eo_obj, Evas_Object_Protected_Data *obj)
    Eina_Bool movch = EINA_FALSE;
 
    if (!obj->layer) return;
+   evas_event_index_change(obj);
    if (obj->layer->evas->nochange) return;
    obj->layer->evas->changed = EINA_TRUE;
 
@@ -697,17 +698,15 @@ evas_object_move(Evas_Object *eo_obj, Evas_Coord x, Evas_Coord y)
    MAGIC_CHECK(eo_obj, Evas_Object, MAGIC_OBJ);
    return;
    MAGIC_CHECK_END();
-   eo_do(eo_obj, evas_obj_position_set(x, y));
+   eo_do_direct(eo_obj, evas_obj_position_set_func,
+                evas_obj_position_set(x, y));
 }
 
 static void
-_position_set(Eo *eo_obj, void *_pd, va_list *list)
+_position_set_direct(Eo *eo_obj, void *_pd, Evas_Coord x, Evas_Coord y)
 {
    Evas_Object_Protected_Data *obj = _pd;
 
-   Evas_Coord x = va_arg(*list, Evas_Coord);
-   Evas_Coord y = va_arg(*list, Evas_Coord);
-
    Eina_Bool is, was = EINA_FALSE;
    Eina_Bool pass = EINA_FALSE, freeze = EINA_FALSE;
    Eina_Bool source_invisible = EINA_FALSE;
@@ -778,22 +777,29 @@ _position_set(Eo *eo_obj, void *_pd, va_list *list)
    evas_object_inform_call_move(eo_obj, obj);
 }
 
+static void
+_position_set(Eo *eo_obj, void *_pd, va_list *list)
+{
+   Evas_Coord x = va_arg(*list, Evas_Coord);
+   Evas_Coord y = va_arg(*list, Evas_Coord);
+
+   _position_set_direct(eo_obj, _pd, x, y);
+}
+
 EAPI void
 evas_object_resize(Evas_Object *eo_obj, Evas_Coord w, Evas_Coord h)
 {
    MAGIC_CHECK(eo_obj, Evas_Object, MAGIC_OBJ);
    return;
    MAGIC_CHECK_END();
-   eo_do(eo_obj, evas_obj_size_set(w, h));
+   eo_do_direct(eo_obj, evas_obj_size_set_func, evas_obj_size_set(w, h));
 }
 
 static void
-_size_set(Eo *eo_obj, void *_pd, va_list *list)
+_size_set_direct(Eo *eo_obj, void *_pd, Evas_Coord w, Evas_Coord h)
 {
    Evas_Object_Protected_Data *obj = _pd;
 
-   Evas_Coord w = va_arg(*list, Evas_Coord);
-   Evas_Coord h = va_arg(*list, Evas_Coord);
    Eina_Bool is, was = EINA_FALSE;
    Eina_Bool pass = EINA_FALSE, freeze = EINA_FALSE;
    Eina_Bool source_invisible = EINA_FALSE;
@@ -868,6 +874,15 @@ _size_set(Eo *eo_obj, void *_pd, va_list *list)
    evas_object_inform_call_resize(eo_obj);
 }
 
+static void
+_size_set(Eo *eo_obj, void *_pd, va_list *list)
+{
+   Evas_Coord w = va_arg(*list, Evas_Coord);
+   Evas_Coord h = va_arg(*list, Evas_Coord);
+
+   _size_set_direct(eo_obj, _pd, w, h);
+}
+
 EAPI void
 evas_object_geometry_get(const Evas_Object *eo_obj, Evas_Coord *x, Evas_Coord *y, Evas_Coord *w, Evas_Coord *h)
 {
@@ -2018,8 +2033,12 @@ _canvas_object_top_at_xy_get(Eo *eo_e EINA_UNUSED, void *_pd, va_list *list)
      {
         Evas_Object *eo_obj;
         Evas_Object_Protected_Data *obj;
+        Evas_Event_Index_Walk walk;
 
-        EINA_INLIST_REVERSE_FOREACH(get_layer_objects(lay), obj)
+        for (obj = evas_event_index_walk_first(&walk, get_layer_objects_last(lay),
+                                               xx, yy, 1, 1);
+             obj;
+             obj = evas_event_index_walk_prev(&walk, obj))
           {
              eo_obj = obj->object;
              if (obj->delete_me) continue;
@@ -2090,8 +2109,12 @@ _canvas_object_top_in_rectangle_get(Eo *eo_e EINA_UNUSED, void *_pd, va_list *li
      {
         Evas_Object *eo_obj;
         Evas_Object_Protected_Data *obj;
+        Evas_Event_Index_Walk walk;
 
-        EINA_INLIST_REVERSE_FOREACH(get_layer_objects(lay), obj)
+        for (obj = evas_event_index_walk_first(&walk, get_layer_objects_last(lay),
+                                               xx, yy, ww, hh);
+             obj;
+             obj = evas_event_index_walk_prev(&walk, obj))
           {
              eo_obj = obj->object;
              if (obj->delete_me) continue;
@@ -2144,8 +2167,12 @@ _canvas_objects_at_xy_get(Eo *eo_e EINA_UNUSED, void *_pd, va_list *list)
      {
         Evas_Object *eo_obj;
         Evas_Object_Protected_Data *obj;
+        Evas_Event_Index_Walk walk;
 
-        EINA_INLIST_REVERSE_FOREACH(get_layer_objects(lay), obj)
+        for (obj = evas_event_index_walk_first(&walk, get_layer_objects_last(lay),
+                                               xx, yy, 1, 1);
+             obj;
+             obj = evas_event_index_walk_prev(&walk, obj))
           {
              eo_obj = obj->object;
              // FIXME - Daniel: we don't know yet how to handle the next line
@@ -2216,8 +2243,12 @@ _canvas_objects_in_rectangle_get(Eo *eo_e EINA_UNUSED, void *_pd, va_list *list)
      {
         Evas_Object *eo_obj;
         Evas_Object_Protected_Data *obj;
+        Evas_Event_Index_Walk walk;
 
-        EINA_INLIST_REVERSE_FOREACH(get_layer_objects(lay), obj)
+        for (obj = evas_event_index_walk_first(&walk, get_layer_objects_last(lay),
+                                               xx, yy, ww, hh);
+             obj;
+             obj = evas_event_index_walk_prev(&walk, obj))
           {
              eo_obj = obj->object;
              // FIXME - Daniel: we don't know yet how to handle the next line
@@ -2437,9 +2468,9 @@ _class_constructor(Eo_Class *klass)
         EO_OP_FUNC(EO_BASE_ID(EO_BASE_SUB_ID_DESTRUCTOR), _destructor),
         EO_OP_FUNC(EO_BASE_ID(EO_BASE_SUB_ID_DBG_INFO_GET), _dbg_info_get),
         EO_OP_FUNC(EVAS_COMMON_ID(EVAS_COMMON_SUB_ID_EVAS_GET), _evas_get),
-        EO_OP_FUNC(EVAS_OBJ_ID(EVAS_OBJ_SUB_ID_POSITION_SET), _position_set),
+        EO_OP_FUNC_DIRECT(EVAS_OBJ_ID(EVAS_OBJ_SUB_ID_POSITION_SET), _position_set, evas_obj_position_set_func, _position_set_direct),
         EO_OP_FUNC(EVAS_OBJ_ID(EVAS_OBJ_SUB_ID_POSITION_GET), _position_get),
-        EO_OP_FUNC(EVAS_OBJ_ID(EVAS_OBJ_SUB_ID_SIZE_SET), _size_set),
+        EO_OP_FUNC_DIRECT(EVAS_OBJ_ID(EVAS_OBJ_SUB_ID_SIZE_SET), _size_set, evas_obj_size_set_func, _size_set_direct),
         EO_OP_FUNC(EVAS_OBJ_ID(EVAS_OBJ_SUB_ID_SIZE_GET), _size_get),
         EO_OP_FUNC(EVAS_OBJ_ID(EVAS_OBJ_SUB_ID_SIZE_HINT_MIN_SET), _size_hint_min_set),
         EO_OP_FUNC(EVAS_OBJ_ID(EVAS_OBJ_SUB_ID_SIZE_HINT_MIN_GET), _size_hint_min_get),
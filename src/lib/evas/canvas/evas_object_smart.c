@@ -293,6 +293,7 @@ _smart_member_add(Eo *smart_obj, void *_pd, va_list *list)
    obj->layer->usage++;
    obj->smart.parent = smart_obj;
    o->contained = eina_inlist_append(o->contained, EINA_INLIST_GET(obj));
+   evas_event_index_add(smart->event_index.members, obj);
    eo_data_ref(eo_obj, NULL);
    evas_object_smart_member_cache_invalidate(eo_obj, EINA_TRUE, EINA_TRUE,
                                              EINA_TRUE);
@@ -331,6 +332,7 @@ _smart_member_del(Eo *smart_obj, void *_pd EINA_UNUSED, va_list *list)
      smart->smart.smart->smart_class->member_del(smart_obj, eo_obj);
 
    Evas_Object_Smart *o = eo_data_scope_get(smart_obj, MY_CLASS);
+   evas_event_index_del(obj);
    o->contained = eina_inlist_remove(o->contained, EINA_INLIST_GET(obj));
    eo_data_unref(eo_obj, obj);
    o->member_count--;
@@ -1447,6 +1449,8 @@ evas_object_smart_cleanup(Evas_Object *eo_obj)
              Evas_Object *contained_obj = ((Evas_Object_Protected_Data *)o->contained)->object;
              evas_object_smart_member_del(contained_obj);
           }
+        evas_event_index_free(obj->event_index.members);
+        obj->event_index.members = NULL;
 
         while (o->callbacks)
           {
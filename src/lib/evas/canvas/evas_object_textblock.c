@@ -350,11 +350,21 @@ struct _Evas_Object_Textblock_Paragraph
    Eina_List                         *logical_items;
    Evas_BiDi_Paragraph_Props         *bidi_props; /* Only valid during layout */
    Evas_BiDi_Direction                direction;
+   char                              *line_breaks; /* Prepared by the pool, only valid during layout */
+   const char                        *line_breaks_lang; /* The language line_breaks are for */
    Evas_Coord                         y, w, h;
+   Evas_Coord                         layout_w; /* The width the lines were laid out for */
+   Evas_Coord                         fit_w; /* The narrowest width keeping the same lines */
+   Evas_Coord                         wmax; /* The paragraph's part of the formatted width */
+   Evas_Coord                         est_line_h; /* Line height to estimate with */
    int                                line_no;
+   int                                line_count; /* Number of lines when estimated */
    Eina_Bool                          is_bidi : 1;
    Eina_Bool                          visible : 1;
    Eina_Bool                          rendered : 1;
+   Eina_Bool                          width_dependent : 1; /* Wrapped or aligned against the width */
+   Eina_Bool                          estimated : 1; /* No items or lines, only an estimated size */
+   Eina_Bool                          est_wrap : 1; /* Estimate as wrapping */
 };
 
 struct _Evas_Object_Textblock_Line
@@ -477,6 +487,8 @@ struct _Evas_Textblock_Cursor
 
 /* Size of the index array */
 #define TEXTBLOCK_PAR_INDEX_SIZE 10
+/* Paragraphs to prepare at least before sharing the work with the pool */
+#define TEXTBLOCK_PAR_POOL_MIN 16
 struct _Evas_Object_Textblock
 {
    DATA32                              magic;
@@ -507,6 +519,14 @@ struct _Evas_Object_Textblock
       int                              w, h, oneline_h;
       Eina_Bool                        valid : 1;
    } formatted, native;
+   struct {
+      Evas_Object_Textblock_Node_Text *realize; /* Lay this one out even if outside */
+      Evas_Coord                       y, h; /* The part laid out in full */
+      Evas_Coord                       line_h; /* Average line height */
+      double                           char_w; /* Average char advance */
+      Eina_Bool                        enabled : 1;
+      Eina_Bool                        rerun : 1;
+   } virtual_layout;
    Eina_Bool                           redraw : 1;
    Eina_Bool                           changed : 1;
    Eina_Bool                           content_changed : 1;
@@ -2462,8 +2482,11 @@ struct _Ctxt
    int have_underline, have_underline2;
    double align, valign;
    Textblock_Position position;
+   int virt_y, virt_h;
+   int virt_lines, virt_lines_h, virt_adv, virt_chars, virt_realized;
    Eina_Bool align_auto : 1;
    Eina_Bool width_changed : 1;
+   Eina_Bool virt_missed : 1;
 };
 
 static void _layout_text_add_logical_item(Ctxt *c, Evas_Object_Textblock_Text_Item *ti, Eina_List *rel);
@@ -2755,6 +2778,53 @@ _layout_paragraph_new(Ctxt *c, Evas_Object_Textblock_Node_Text *n,
 }
 
 #ifdef BIDI_SUPPORT
+/**
+ * @internal
+ * Calculate the bidi paragraph props of a text node. Only reads the node, so
+ * the pool can run it.
+ *
+ * @param o The textblock
+ * @param n The text node
+ * @return The new props, or NULL if there's no bidi text.
+ */
+static Evas_BiDi_Paragraph_Props *
+_layout_bidi_props_get(const Evas_Object_Textblock *o,
+      const Evas_Object_Textblock_Node_Text *n)
+{
+   Evas_BiDi_Paragraph_Props *props;
+   const Eina_Unicode *text;
+   int *segment_idxs = NULL;
+
+   text = eina_ustrbuf_string_get(n->unicode);
+
+   if (o->bidi_delimiters)
+      segment_idxs = evas_bidi_segment_idxs_get(text, o->bidi_delimiters);
+
+   props = evas_bidi_paragraph_props_get(text,
+         eina_ustrbuf_length_get(n->unicode), segment_idxs);
+   if (segment_idxs) free(segment_idxs);
+
+   return props;
+}
+
+/**
+ * @internal
+ * Set the paragraph's bidi props, taking over the reference.
+ *
+ * @param par The paragraph to update
+ * @param props The new props
+ */
+static inline void
+_layout_bidi_props_set(Evas_Object_Textblock_Paragraph *par,
+      Evas_BiDi_Paragraph_Props *props)
+{
+   evas_bidi_paragraph_props_unref(par->bidi_props);
+   par->bidi_props = props;
+   par->direction = EVAS_BIDI_PARAGRAPH_DIRECTION_IS_RTL(par->bidi_props) ?
+      EVAS_BIDI_DIRECTION_RTL : EVAS_BIDI_DIRECTION_LTR;
+   par->is_bidi = !!par->bidi_props;
+}
+
 /**
  * @internal
  * Update bidi paragraph props.
@@ -2767,21 +2837,7 @@ _layout_update_bidi_props(const Evas_Object_Textblock *o,
 {
    if (par->text_node)
      {
-        const Eina_Unicode *text;
-        int *segment_idxs = NULL;
-        text = eina_ustrbuf_string_get(par->text_node->unicode);
-
-        if (o->bidi_delimiters)
-           segment_idxs = evas_bidi_segment_idxs_get(text, o->bidi_delimiters);
-
-        evas_bidi_paragraph_props_unref(par->bidi_props);
-        par->bidi_props = evas_bidi_paragraph_props_get(text,
-              eina_ustrbuf_length_get(par->text_node->unicode),
-              segment_idxs);
-        par->direction = EVAS_BIDI_PARAGRAPH_DIRECTION_IS_RTL(par->bidi_props) ?
-           EVAS_BIDI_DIRECTION_RTL : EVAS_BIDI_DIRECTION_LTR;
-        par->is_bidi = !!par->bidi_props;
-        if (segment_idxs) free(segment_idxs);
+        _layout_bidi_props_set(par, _layout_bidi_props_get(o, par->text_node));
      }
 }
 #endif
@@ -2807,25 +2863,40 @@ _paragraph_clear(const Evas_Object *obj EINA_UNUSED,
 
 /**
  * @internal
- * Free the layout paragraph and all of it's lines and logical items.
+ * Free all of the lines and logical items of the layout paragraph.
  */
 static void
-_paragraph_free(const Evas_Object *eo_obj, Evas_Object_Textblock_Paragraph *par)
+_paragraph_items_free(const Evas_Object *eo_obj,
+      Evas_Object_Textblock_Paragraph *par)
 {
-   Evas_Object_Textblock *o = eo_data_scope_get(eo_obj, MY_CLASS);
-   _paragraph_clear(eo_obj, par);
+   Evas_Object_Textblock_Item *it;
 
+   _paragraph_clear(eo_obj, par);
+   EINA_LIST_FREE(par->logical_items, it)
      {
-        Evas_Object_Textblock_Item *it;
-        EINA_LIST_FREE(par->logical_items, it)
-          {
-             _item_free(eo_obj, NULL, it);
-          }
+        _item_free(eo_obj, NULL, it);
      }
+   free(par->line_breaks);
+   par->line_breaks = NULL;
 #ifdef BIDI_SUPPORT
    if (par->bidi_props)
-      evas_bidi_paragraph_props_unref(par->bidi_props);
+     {
+        evas_bidi_paragraph_props_unref(par->bidi_props);
+        par->bidi_props = NULL;
+     }
 #endif
+}
+
+/**
+ * @internal
+ * Free the layout paragraph and all of it's lines and logical items.
+ */
+static void
+_paragraph_free(const Evas_Object *eo_obj, Evas_Object_Textblock_Paragraph *par)
+{
+   Evas_Object_Textblock *o = eo_data_scope_get(eo_obj, MY_CLASS);
+   _paragraph_items_free(eo_obj, par);
+
    /* If we are the active par of the text node, set to NULL */
    if (par->text_node && (par->text_node->par == par))
       par->text_node->par = NULL;
@@ -3401,6 +3472,10 @@ loop_advance:
         c->ln->x = c->marginl + c->o->style_pad.l;
      }
 
+   /* Any alignment but left moves the line when the width changes */
+   if (_layout_line_align_get(c) != 0.0)
+      c->par->width_dependent = EINA_TRUE;
+
    c->par->h = c->ln->y + c->ln->h;
    if (c->ln->w > c->par->w)
      c->par->w = c->ln->w;
@@ -3408,6 +3483,8 @@ loop_advance:
      {
         Evas_Coord new_wmax = c->ln->w +
            c->marginl + c->marginr - (c->o->style_pad.l + c->o->style_pad.r);
+        if (new_wmax > c->par->wmax)
+           c->par->wmax = new_wmax;
         if (new_wmax > c->wmax)
            c->wmax = new_wmax;
      }
@@ -4425,6 +4502,329 @@ _layout_paragraph_render(Evas_Object_Textblock *o,
 #endif
 }
 
+/**
+ * @internal
+ * Check if the lines of the current paragraph still hold for the layout
+ * width. They do if the width didn't change, or if nothing in the
+ * paragraph was wrapped or aligned against the width and it still fits.
+ *
+ * @param c the context to work on - Not NULL.
+ * @return #EINA_TRUE if the lines can be kept, #EINA_FALSE otherwise.
+ */
+static Eina_Bool
+_layout_par_width_valid(const Ctxt *c)
+{
+   if (!c->width_changed || (c->par->layout_w == c->w))
+      return EINA_TRUE;
+   if (c->par->width_dependent)
+      return EINA_FALSE;
+   return ((c->w < 0) || (c->w >= c->par->fit_w));
+}
+
+/**
+ * @internal
+ * Check if the current paragraph can keep its lines as they are.
+ *
+ * @param c the context to work on - Not NULL.
+ * @return #EINA_TRUE if the lines can be kept, #EINA_FALSE otherwise.
+ */
+static Eina_Bool
+_layout_par_lines_valid(const Ctxt *c)
+{
+   return (!c->par->text_node->is_new && !c->par->text_node->dirty &&
+         _layout_par_width_valid(c) && c->par->lines &&
+         !c->o->have_ellipsis);
+}
+
+/**
+ * @internal
+ * The language to find line breaks with for a format.
+ */
+static inline const char *
+_layout_line_breaks_lang_get(const Evas_Object_Textblock_Format *fmt)
+{
+   return (fmt->font.fdesc) ? fmt->font.fdesc->lang : "";
+}
+
+static void
+_layout_line_breaks_job(void *data, unsigned int idx)
+{
+   Evas_Object_Textblock_Paragraph *par =
+      ((Evas_Object_Textblock_Paragraph **) data)[idx];
+   size_t len = eina_ustrbuf_length_get(par->text_node->unicode);
+
+   par->line_breaks = malloc(len);
+   if (!par->line_breaks) return;
+   set_linebreaks_utf32((const utf32_t *)
+         eina_ustrbuf_string_get(par->text_node->unicode),
+         len, par->line_breaks_lang, par->line_breaks);
+}
+
+/**
+ * @internal
+ * Find the line breaks of the paragraphs that are going to be wrapped by
+ * words, spreading them over the thread pool. Only the text is read, the
+ * rest of the layout has to stay on this thread as it queries the fonts.
+ * _layout_par() takes them over, or finds them itself as before.
+ *
+ * @param c the context to work on - Not NULL.
+ */
+static void
+_layout_pars_line_breaks_prepare(Ctxt *c)
+{
+   Evas_Object_Textblock_Paragraph **pars;
+   unsigned int count = 0;
+   Evas_Coord avail;
+
+   if ((c->w < 0) || (evas_thread_pool_threads_get() < 2) ||
+         (c->o->num_paragraphs < TEXTBLOCK_PAR_POOL_MIN))
+      return;
+
+   pars = malloc(c->o->num_paragraphs * sizeof(*pars));
+   if (!pars) return;
+
+   avail = c->w - c->o->style_pad.l - c->o->style_pad.r;
+   EINA_INLIST_FOREACH(c->paragraphs, c->par)
+     {
+        Evas_Object_Textblock_Item *it, *first;
+        Evas_Coord adv = 0;
+        Eina_List *l;
+
+        if (count == (unsigned int) c->o->num_paragraphs)
+           break;
+        if (c->par->estimated || !c->par->text_node ||
+              !c->par->logical_items || _layout_par_lines_valid(c))
+           continue;
+
+        first = _ITEM(eina_list_data_get(c->par->logical_items));
+        if (!first->format->wrap_word && !first->format->wrap_mixed)
+           continue;
+
+        /* Only worth it if it doesn't fit in one line */
+        EINA_LIST_FOREACH(c->par->logical_items, l, it)
+           adv += it->adv;
+        if (adv <= avail)
+           continue;
+
+        c->par->line_breaks_lang = _layout_line_breaks_lang_get(first->format);
+        pars[count++] = c->par;
+     }
+   c->par = NULL;
+
+   if (count >= TEXTBLOCK_PAR_POOL_MIN)
+      evas_thread_pool_run(_layout_line_breaks_job, pars, count);
+
+   free(pars);
+}
+
+/**
+ * @internal
+ * Get the vertical part of the object that can be seen through its
+ * clippers and the viewport.
+ *
+ * @param eo_obj the evas object - Not NULL.
+ * @param[out] y the start of the visible part, relative to the object.
+ * @param[out] h the height of the visible part, 0 if nothing is visible.
+ * @return #EINA_FALSE if it can't be known, #EINA_TRUE otherwise.
+ */
+static Eina_Bool
+_layout_virtual_window_get(const Evas_Object *eo_obj, Evas_Coord *y,
+      Evas_Coord *h)
+{
+   Evas_Object_Protected_Data *obj = eo_data_scope_get(eo_obj, EVAS_OBJ_CLASS);
+   Evas_Object_Protected_Data *clipper;
+   Evas_Public_Data *e;
+   Evas_Coord top, bottom;
+
+   if (!obj->layer || ((obj->map->cur.map) && (obj->map->cur.usemap)))
+      return EINA_FALSE;
+
+   /* The object's height doesn't count, the text may overflow it */
+   e = obj->layer->evas;
+   top = e->viewport.y;
+   bottom = e->viewport.y + e->viewport.h;
+   for (clipper = obj->cur->clipper ; clipper ;
+         clipper = clipper->cur->clipper)
+     {
+        if ((clipper->map->cur.map) && (clipper->map->cur.usemap))
+           return EINA_FALSE;
+        if (clipper->cur->geometry.y > top)
+           top = clipper->cur->geometry.y;
+        if (clipper->cur->geometry.y + clipper->cur->geometry.h < bottom)
+           bottom = clipper->cur->geometry.y + clipper->cur->geometry.h;
+     }
+   if (obj->cur->geometry.y > top)
+      top = obj->cur->geometry.y;
+   if (bottom < top)
+      bottom = top;
+
+   *y = top - obj->cur->geometry.y;
+   *h = bottom - top;
+   return EINA_TRUE;
+}
+
+/**
+ * @internal
+ * Check if what is visible of the object is still in the part of it that
+ * was laid out in full.
+ *
+ * @param eo_obj the evas object - Not NULL.
+ * @param o the textblock - Not NULL.
+ * @return #EINA_TRUE if it is, #EINA_FALSE if a relayout is needed.
+ */
+static Eina_Bool
+_layout_virtual_window_valid(const Evas_Object *eo_obj,
+      const Evas_Object_Textblock *o)
+{
+   Evas_Coord y, h;
+
+   if (!_layout_virtual_window_get(eo_obj, &y, &h))
+      return (o->virtual_layout.h < 0);
+   /* Nothing to show, keep whatever there is */
+   if (h == 0)
+      return EINA_TRUE;
+   if (o->virtual_layout.h < 0)
+      return EINA_TRUE;
+
+   return ((y >= o->virtual_layout.y) &&
+         (y + h <= o->virtual_layout.y + o->virtual_layout.h));
+}
+
+/**
+ * @internal
+ * Check if a vertical range of the layout is in the part laid out in full.
+ *
+ * @param c the context to work on - Not NULL.
+ * @param y the start of the range.
+ * @param h the height of the range.
+ * @return #EINA_TRUE if it is, #EINA_FALSE otherwise.
+ */
+static inline Eina_Bool
+_layout_virtual_window_has(const Ctxt *c, Evas_Coord y, Evas_Coord h)
+{
+   if (c->virt_h < 0)
+      return EINA_TRUE;
+   return ((y < c->virt_y + c->virt_h) && (y + h > c->virt_y));
+}
+
+/**
+ * @internal
+ * Estimate the size of a paragraph that is not laid out, using the
+ * average line height and char advance of the paragraphs that are.
+ *
+ * @param c the context to work on - Not NULL.
+ * @param par the paragraph to estimate - Not NULL.
+ */
+static void
+_layout_par_estimate(Ctxt *c, Evas_Object_Textblock_Paragraph *par)
+{
+   Evas_Coord line_h, avail, w;
+   double char_w;
+   size_t len = 0;
+
+   line_h = (c->o->virtual_layout.line_h > 0) ?
+      c->o->virtual_layout.line_h : par->est_line_h;
+   char_w = (c->o->virtual_layout.char_w > 0.0) ?
+      c->o->virtual_layout.char_w : (line_h / 2.0);
+   if (par->text_node)
+      len = eina_ustrbuf_length_get(par->text_node->unicode);
+   w = len * char_w;
+   avail = c->w - c->o->style_pad.l - c->o->style_pad.r;
+
+   par->line_count = 1;
+   if (par->est_wrap && (c->w >= 0) && (avail > 0) && (w > avail))
+     {
+        par->line_count = (w + avail - 1) / avail;
+        w = avail;
+     }
+   par->h = par->line_count * line_h;
+   par->w = par->wmax = w;
+   /* Estimate again whenever the width changes */
+   par->layout_w = c->w;
+   par->width_dependent = EINA_TRUE;
+}
+
+/**
+ * @internal
+ * Free the items and lines of a paragraph that went out of view. Its size
+ * stays the one it was laid out with, as long as the width allows.
+ *
+ * @param c the context to work on - Not NULL.
+ * @param par the paragraph to evict - Not NULL.
+ */
+static void
+_layout_paragraph_evict(Ctxt *c, Evas_Object_Textblock_Paragraph *par)
+{
+   Evas_Object_Textblock_Item *it;
+   Evas_Object_Textblock_Line *ln;
+
+   it = _ITEM(eina_list_data_get(par->logical_items));
+   if (it && it->format)
+      par->est_wrap = (it->format->wrap_word || it->format->wrap_char ||
+            it->format->wrap_mixed);
+
+   par->line_count = 0;
+   EINA_INLIST_FOREACH(par->lines, ln)
+      par->line_count++;
+
+   _paragraph_items_free(c->obj, par);
+   par->estimated = EINA_TRUE;
+   par->rendered = EINA_FALSE;
+
+   if (par->line_count > 0)
+      par->est_line_h = par->h / par->line_count;
+   else
+      _layout_par_estimate(c, par);
+}
+
+/**
+ * @internal
+ * Account for an estimated paragraph in the layout.
+ *
+ * @param c the context to work on - Not NULL.
+ */
+static void
+_layout_par_estimated(Ctxt *c)
+{
+   Evas_Object_Textblock_Paragraph *par = c->par;
+
+   par->visible = 1;
+   par->line_no = c->line_no;
+   if (!_layout_par_width_valid(c))
+      _layout_par_estimate(c, par);
+
+   c->line_no += par->line_count;
+   if (par->wmax > c->wmax)
+      c->wmax = par->wmax;
+   if (c->position == TEXTBLOCK_POSITION_START)
+      c->position = TEXTBLOCK_POSITION_ELSE;
+
+   /* The estimates before it were off, it has to be laid out after all */
+   if (_layout_virtual_window_has(c, par->y, par->h))
+      c->virt_missed = EINA_TRUE;
+}
+
+/**
+ * @internal
+ * Add the lines of a laid out paragraph to the averages estimates use.
+ *
+ * @param c the context to work on - Not NULL.
+ */
+static void
+_layout_virtual_stats_add(Ctxt *c)
+{
+   Evas_Object_Textblock_Line *ln;
+
+   EINA_INLIST_FOREACH(c->par->lines, ln)
+     {
+        c->virt_lines++;
+        c->virt_lines_h += ln->h;
+        c->virt_adv += ln->w;
+     }
+   if (c->par->text_node)
+      c->virt_chars += eina_ustrbuf_length_get(c->par->text_node->unicode);
+}
+
 /* 0 means go ahead, 1 means break without an error, 2 means
  * break with an error, should probably clean this a bit (enum/macro)
  * FIXME ^ */
@@ -4437,6 +4837,12 @@ _layout_par(Ctxt *c)
    int wrap = -1;
    char *line_breaks = NULL;
 
+   if (c->par->estimated)
+     {
+        _layout_par_estimated(c);
+        return 0;
+     }
+
    if (!c->par->logical_items)
      return 2;
 
@@ -4449,13 +4855,15 @@ _layout_par(Ctxt *c)
 
    if (c->par->text_node)
      {
-        /* Skip this paragraph if width is the same, there is no ellipsis
-         * and we aren't just calculating. */
-        if (!c->par->text_node->is_new && !c->par->text_node->dirty &&
-              !c->width_changed && c->par->lines &&
-              !c->o->have_ellipsis)
+        /* Skip this paragraph if its lines still hold for this width,
+         * there is no ellipsis and we aren't just calculating. */
+        if (_layout_par_lines_valid(c))
           {
              Evas_Object_Textblock_Line *ln;
+
+             /* The lines are kept, but they still count in the width */
+             if (c->par->wmax > c->wmax)
+                c->wmax = c->par->wmax;
              /* Update c->line_no */
              ln = (Evas_Object_Textblock_Line *)
                 EINA_INLIST_GET(c->par->lines)->last;
@@ -4499,6 +4907,9 @@ _layout_par(Ctxt *c)
      }
 
    c->y = c->par->y;
+   c->par->w = c->par->wmax = c->par->fit_w = 0;
+   c->par->layout_w = c->w;
+   c->par->width_dependent = EINA_FALSE;
 
    it = _ITEM(eina_list_data_get(c->par->logical_items));
    _layout_line_new(c, it->format);
@@ -4542,6 +4953,15 @@ _layout_par(Ctxt *c)
           }
 
 
+        /* Remember the width needed to lay this item out unwrapped */
+          {
+             Evas_Coord fit_w = c->x + it->adv +
+                c->o->style_pad.l + c->o->style_pad.r +
+                c->marginl + c->marginr;
+             if (fit_w > c->par->fit_w)
+                c->par->fit_w = fit_w;
+          }
+
         /* Check if we need to wrap, i.e the text is bigger than the width,
            or we already found a wrap point. */
         if ((c->w >= 0) &&
@@ -4549,6 +4969,7 @@ _layout_par(Ctxt *c)
                 (c->w - c->o->style_pad.l - c->o->style_pad.r -
                  c->marginl - c->marginr)) || (wrap > 0)))
           {
+             c->par->width_dependent = EINA_TRUE;
              /* Handle ellipsis here. If we don't have more width left
               * and no height left, or no more width left and no wrapping. */
              if ((it->format->ellipsis == 1.0) && (c->h >= 0) &&
@@ -4581,16 +5002,25 @@ _layout_par(Ctxt *c)
                        if (it->format->wrap_word || it->format->wrap_mixed)
                          {
                             const char *lang;
-                            lang = (it->format->font.fdesc) ?
-                               it->format->font.fdesc->lang : "";
-                            size_t len =
-                               eina_ustrbuf_length_get(
-                                     it->text_node->unicode);
-                            line_breaks = malloc(len);
-                            set_linebreaks_utf32((const utf32_t *)
-                                  eina_ustrbuf_string_get(
-                                     it->text_node->unicode),
-                                  len, lang, line_breaks);
+                            lang = _layout_line_breaks_lang_get(it->format);
+                            /* Use the ones the pool prepared if they fit */
+                            if (c->par->line_breaks &&
+                                  (c->par->line_breaks_lang == lang))
+                              {
+                                 line_breaks = c->par->line_breaks;
+                                 c->par->line_breaks = NULL;
+                              }
+                            else
+                              {
+                                 size_t len =
+                                    eina_ustrbuf_length_get(
+                                          it->text_node->unicode);
+                                 line_breaks = malloc(len);
+                                 set_linebreaks_utf32((const utf32_t *)
+                                       eina_ustrbuf_string_get(
+                                          it->text_node->unicode),
+                                       len, lang, line_breaks);
+                              }
                          }
                     }
                   if (c->ln->items)
@@ -4749,6 +5179,11 @@ _layout_par(Ctxt *c)
 end:
    if (line_breaks)
       free(line_breaks);
+   if (c->par->line_breaks)
+     {
+        free(c->par->line_breaks);
+        c->par->line_breaks = NULL;
+     }
 
    return ret;
 }
@@ -4853,6 +5288,115 @@ _format_changes_invalidate_text_nodes(Ctxt *c)
 }
 
 
+/**
+ * @internal
+ * Update the format stack and the style paddings with the formats of a
+ * text node, without creating any items for it.
+ *
+ * @param c the context to work on - Not NULL.
+ * @param n the text node - Not NULL.
+ */
+static void
+_layout_pre_formats_skip(Ctxt *c, Evas_Object_Textblock_Node_Text *n,
+      int *style_pad_l, int *style_pad_r, int *style_pad_t, int *style_pad_b)
+{
+   Evas_Object_Textblock_Node_Format *fnode;
+
+   fnode = n->format_node;
+   while (fnode && (fnode->text_node == n))
+     {
+        /* Only do this if this actually changes format */
+        if (fnode->format_change)
+          {
+             int pl = 0, pr = 0, pt = 0, pb = 0;
+             _layout_do_format(c->obj, c, &c->fmt, fnode,
+                               &pl, &pr, &pt, &pb, EINA_FALSE);
+             fnode->pad.l = pl;
+             fnode->pad.r = pr;
+             fnode->pad.t = pt;
+             fnode->pad.b = pb;
+          }
+        if (fnode->pad.l > *style_pad_l) *style_pad_l = fnode->pad.l;
+        if (fnode->pad.r > *style_pad_r) *style_pad_r = fnode->pad.r;
+        if (fnode->pad.t > *style_pad_t) *style_pad_t = fnode->pad.t;
+        if (fnode->pad.b > *style_pad_b) *style_pad_b = fnode->pad.b;
+        fnode->is_new = EINA_FALSE;
+        fnode = _NODE_FORMAT(EINA_INLIST_GET(fnode)->next);
+     }
+}
+
+#ifdef BIDI_SUPPORT
+typedef struct
+{
+   const Evas_Object_Textblock *o;
+   Evas_Object_Textblock_Node_Text **nodes;
+   Evas_BiDi_Paragraph_Props **props;
+   unsigned int count;
+   unsigned int pos;
+} Layout_Bidi_Prepare;
+
+static void
+_layout_bidi_props_job(void *data, unsigned int idx)
+{
+   Layout_Bidi_Prepare *bp = data;
+
+   bp->props[idx] = _layout_bidi_props_get(bp->o, bp->nodes[idx]);
+}
+
+/**
+ * @internal
+ * Calculate the bidi props of the new and changed text nodes over the
+ * thread pool, for _layout_pre() to pick up in order.
+ *
+ * @param c the context to work on - Not NULL.
+ * @param bp where to keep them.
+ */
+static void
+_layout_bidi_props_prepare(Ctxt *c, Layout_Bidi_Prepare *bp)
+{
+   Evas_Object_Textblock_Node_Text *n;
+   unsigned int count = 0;
+
+   memset(bp, 0, sizeof(*bp));
+   /* Out of view paragraphs don't need them in virtual mode */
+   if (c->o->virtual_layout.enabled || (evas_thread_pool_threads_get() < 2))
+      return;
+
+   EINA_INLIST_FOREACH(c->o->text_nodes, n)
+     {
+        if (n->is_new || n->dirty) count++;
+     }
+   if (count < TEXTBLOCK_PAR_POOL_MIN)
+      return;
+
+   bp->nodes = malloc(count * sizeof(*bp->nodes));
+   bp->props = calloc(count, sizeof(*bp->props));
+   if (!bp->nodes || !bp->props)
+     {
+        free(bp->nodes);
+        free(bp->props);
+        memset(bp, 0, sizeof(*bp));
+        return;
+     }
+
+   bp->o = c->o;
+   EINA_INLIST_FOREACH(c->o->text_nodes, n)
+     {
+        if (n->is_new || n->dirty) bp->nodes[bp->count++] = n;
+     }
+   evas_thread_pool_run(_layout_bidi_props_job, bp, bp->count);
+}
+
+static void
+_layout_bidi_props_prepare_done(Layout_Bidi_Prepare *bp)
+{
+   for ( ; bp->pos < bp->count ; bp->pos++)
+      evas_bidi_paragraph_props_unref(bp->props[bp->pos]);
+   free(bp->nodes);
+   free(bp->props);
+}
+#endif
+
 /** FIXME: Document */
 static void
 _layout_pre(Ctxt *c, int *style_pad_l, int *style_pad_r, int *style_pad_t,
@@ -4868,6 +5412,12 @@ _layout_pre(Ctxt *c, int *style_pad_l, int *style_pad_r, int *style_pad_t,
    if (o->content_changed)
      {
         Evas_Object_Textblock_Node_Text *n;
+        Evas_Coord vy = 0; /* Roughly where the paragraph will be */
+#ifdef BIDI_SUPPORT
+        Layout_Bidi_Prepare bp;
+
+        _layout_bidi_props_prepare(c, &bp);
+#endif
         c->o->have_ellipsis = 0;
         c->par = c->paragraphs = o->paragraphs;
         /* Go through all the text nodes to create the logical layout */
@@ -4909,33 +5459,29 @@ _layout_pre(Ctxt *c, int *style_pad_l, int *style_pad_r, int *style_pad_t,
                                 EINA_INLIST_GET(prev_par));
                        _paragraph_free(eo_obj, prev_par);
                     }
+                  else if (c->par->estimated &&
+                        ((n == o->virtual_layout.realize) ||
+                         _layout_virtual_window_has(c, vy, c->par->h)))
+                    {
+                       /* Came into view, lay it out for real. */
+                       c->par->estimated = EINA_FALSE;
+                       c->virt_realized++;
+                    }
                   else
                     {
+                       /* Went out of view, only keep its size. */
+                       if (!c->par->estimated && !o->virtual_layout.realize &&
+                             !_layout_virtual_window_has(c, vy, c->par->h))
+                          _layout_paragraph_evict(c, c->par);
+                       vy += c->par->h;
+
                        c->par = (Evas_Object_Textblock_Paragraph *)
                           EINA_INLIST_GET(c->par)->next;
 
                        /* Update the format stack according to the node's
                         * formats */
-                       fnode = n->format_node;
-                       while (fnode && (fnode->text_node == n))
-                         {
-                            /* Only do this if this actually changes format */
-                            if (fnode->format_change)
-                              {
-                                 int pl = 0, pr = 0, pt = 0, pb = 0;
-                                 _layout_do_format(eo_obj, c, &c->fmt, fnode,
-                                                   &pl, &pr, &pt, &pb, EINA_FALSE);
-                                 fnode->pad.l = pl;
-                                 fnode->pad.r = pr;
-                                 fnode->pad.t = pt;
-                                 fnode->pad.b = pb;
-                              }
-                            if (fnode->pad.l > *style_pad_l) *style_pad_l = fnode->pad.l;
-                            if (fnode->pad.r > *style_pad_r) *style_pad_r = fnode->pad.r;
-                            if (fnode->pad.t > *style_pad_t) *style_pad_t = fnode->pad.t;
-                            if (fnode->pad.b > *style_pad_b) *style_pad_b = fnode->pad.b;
-                            fnode = _NODE_FORMAT(EINA_INLIST_GET(fnode)->next);
-                         }
+                       _layout_pre_formats_skip(c, n, style_pad_l,
+                             style_pad_r, style_pad_t, style_pad_b);
                        continue;
                     }
                }
@@ -4945,8 +5491,40 @@ _layout_pre(Ctxt *c, int *style_pad_l, int *style_pad_r, int *style_pad_t,
                   _layout_paragraph_new(c, n, EINA_FALSE);
                }
 
+             /* Out of view paragraphs are only estimated */
+             if (o->virtual_layout.enabled && (n->is_new || n->dirty))
+               {
+                  Evas_Coord asc = 0, desc = 0;
+
+                  _layout_item_ascent_descent_adjust(eo_obj, &asc, &desc,
+                        NULL, c->fmt);
+                  c->par->est_line_h = asc + desc;
+                  c->par->est_wrap = (c->fmt->wrap_word ||
+                        c->fmt->wrap_char || c->fmt->wrap_mixed);
+                  _layout_par_estimate(c, c->par);
+
+                  if ((n != o->virtual_layout.realize) &&
+                        !_layout_virtual_window_has(c, vy, c->par->h))
+                    {
+                       c->par->estimated = EINA_TRUE;
+                       n->is_new = EINA_FALSE;
+                       n->dirty = EINA_FALSE;
+                       vy += c->par->h;
+
+                       _layout_pre_formats_skip(c, n, style_pad_l,
+                             style_pad_r, style_pad_t, style_pad_b);
+                       c->par = (Evas_Object_Textblock_Paragraph *)
+                          EINA_INLIST_GET(c->par)->next;
+                       continue;
+                    }
+               }
+             vy += c->par->h;
+
 #ifdef BIDI_SUPPORT
-             _layout_update_bidi_props(c->o, c->par);
+             if ((bp.pos < bp.count) && (bp.nodes[bp.pos] == n))
+                _layout_bidi_props_set(c->par, bp.props[bp.pos++]);
+             else
+                _layout_update_bidi_props(c->o, c->par);
 #endif
 
              /* For each text node to thorugh all of it's format nodes
@@ -5014,6 +5592,9 @@ _layout_pre(Ctxt *c, int *style_pad_l, int *style_pad_r, int *style_pad_t,
           }
         o->paragraphs = c->paragraphs;
         c->par = NULL;
+#ifdef BIDI_SUPPORT
+        _layout_bidi_props_prepare_done(&bp);
+#endif
      }
    else
      {
@@ -5066,6 +5647,18 @@ _layout(const Evas_Object *eo_obj, int w, int h, int *w_ret, int *h_ret)
    c->align_auto = EINA_TRUE;
    c->ln = NULL;
    c->width_changed = (obj->cur->geometry.w != o->last_w);
+   c->virt_missed = EINA_FALSE;
+   c->virt_lines = c->virt_lines_h = c->virt_adv = c->virt_chars = 0;
+   c->virt_realized = 0;
+   c->virt_y = 0;
+   c->virt_h = -1;
+   if (o->virtual_layout.enabled &&
+         _layout_virtual_window_get(eo_obj, &c->virt_y, &c->virt_h))
+     {
+        /* Lay out the visible part and as much above and below it */
+        c->virt_y -= c->virt_h;
+        c->virt_h *= 3;
+     }
 
    /* Start of logical layout creation */
    /* setup default base style */
@@ -5110,7 +5703,7 @@ _layout(const Evas_Object *eo_obj, int w, int h, int *w_ret, int *h_ret)
      }
    c->par = (Evas_Object_Textblock_Paragraph *)
       EINA_INLIST_GET(c->paragraphs)->last;
-   if (!c->par->logical_items)
+   if (!c->par->logical_items && !c->par->estimated)
      {
         Evas_Object_Textblock_Text_Item *ti;
         ti = _layout_text_item_new(c, c->fmt);
@@ -5122,6 +5715,7 @@ _layout(const Evas_Object *eo_obj, int w, int h, int *w_ret, int *h_ret)
    /* End of logical layout creation */
 
    /* Start of visual layout creation */
+   _layout_pars_line_breaks_prepare(c);
    {
       Evas_Object_Textblock_Paragraph *last_vis_par = NULL;
       int par_index_step = o->num_paragraphs / TEXTBLOCK_PAR_INDEX_SIZE;
@@ -5146,6 +5740,9 @@ _layout(const Evas_Object *eo_obj, int w, int h, int *w_ret, int *h_ret)
                 break;
              }
 
+           if (o->virtual_layout.enabled && !c->par->estimated)
+              _layout_virtual_stats_add(c);
+
            if ((par_index_pos < TEXTBLOCK_PAR_INDEX_SIZE) && (--par_count == 0))
              {
                 par_count = par_index_step;
@@ -5162,6 +5759,8 @@ _layout(const Evas_Object *eo_obj, int w, int h, int *w_ret, int *h_ret)
            while (c->par)
              {
                 c->par->visible = 0;
+                free(c->par->line_breaks);
+                c->par->line_breaks = NULL;
                 c->par = (Evas_Object_Textblock_Paragraph *)
                    EINA_INLIST_GET(c->par)->next;
              }
@@ -5190,6 +5789,15 @@ _layout(const Evas_Object *eo_obj, int w, int h, int *w_ret, int *h_ret)
    if (w_ret) *w_ret = c->wmax;
    if (h_ret) *h_ret = c->hmax;
 
+   o->virtual_layout.y = c->virt_y;
+   o->virtual_layout.h = c->virt_h;
+   if (c->virt_lines > 0)
+     {
+        o->virtual_layout.line_h = c->virt_lines_h / c->virt_lines;
+        if (c->virt_chars > 0)
+           o->virtual_layout.char_w = (double) c->virt_adv / c->virt_chars;
+     }
+
    /* Vertically align the textblock */
    if ((o->valign > 0.0) && (c->h > c->hmax))
      {
@@ -5212,6 +5820,17 @@ _layout(const Evas_Object *eo_obj, int w, int h, int *w_ret, int *h_ret)
         LYDBG("ZZ: ... layout #2\n");
         _layout(eo_obj, w, h, w_ret, h_ret);
      }
+   else if (c->virt_missed && (!o->virtual_layout.rerun || c->virt_realized))
+     {
+        /* Estimated paragraphs turned out to be in view, lay them out.
+         * Stop if the last round didn't get any of them in. */
+        Eina_Bool rerun = o->virtual_layout.rerun;
+
+        o->content_changed = 1;
+        o->virtual_layout.rerun = EINA_TRUE;
+        _layout(eo_obj, w, h, w_ret, h_ret);
+        o->virtual_layout.rerun = rerun;
+     }
 }
 
 /*
@@ -5264,6 +5883,72 @@ _relayout_if_needed(Evas_Object *eo_obj, const Evas_Object_Textblock *o)
      }
 }
 
+/*
+ * @internal
+ * Lay out an estimated paragraph for real, even if it's out of view.
+ * Nothing is evicted on the way, so the other paragraphs stay as they are.
+ */
+static void
+_layout_paragraph_realize(Evas_Object *eo_obj, Evas_Object_Textblock *o,
+      Evas_Object_Textblock_Paragraph *par)
+{
+   Evas_Object_Protected_Data *obj;
+
+   if (!par->estimated || !par->text_node)
+      return;
+
+   o->virtual_layout.realize = par->text_node;
+   o->content_changed = 1;
+   _relayout(eo_obj);
+   o->virtual_layout.realize = NULL;
+
+   obj = eo_data_scope_get(eo_obj, EVAS_OBJ_CLASS);
+   evas_object_change(eo_obj, obj);
+}
+
+/*
+ * @internal
+ * Find the paragraph at y, laying it out for real if it's estimated.
+ * That moves the paragraphs after it, so look again until it settles.
+ */
+static Evas_Object_Textblock_Paragraph *
+_layout_paragraph_by_y_realize(Evas_Object *eo_obj, Evas_Object_Textblock *o,
+      Evas_Coord y)
+{
+   Evas_Object_Textblock_Paragraph *par;
+
+   par = _layout_find_paragraph_by_y(o, y);
+   while (par && par->estimated)
+     {
+        _layout_paragraph_realize(eo_obj, o, par);
+        if (par->estimated)
+           break;
+        par = _layout_find_paragraph_by_y(o, y);
+     }
+   return par;
+}
+
+/*
+ * @internal
+ * Find the paragraph of a line, laying it out for real if it's estimated.
+ */
+static Evas_Object_Textblock_Paragraph *
+_layout_paragraph_by_line_no_realize(Evas_Object *eo_obj,
+      Evas_Object_Textblock *o, int line_no)
+{
+   Evas_Object_Textblock_Paragraph *par;
+
+   par = _layout_find_paragraph_by_line_no(o, line_no);
+   while (par && par->estimated)
+     {
+        _layout_paragraph_realize(eo_obj, o, par);
+        if (par->estimated)
+           break;
+        par = _layout_find_paragraph_by_line_no(o, line_no);
+     }
+   return par;
+}
+
 /**
  * @internal
  * Find the layout item and line that match the text node and position passed.
@@ -5287,6 +5972,7 @@ _find_layout_item_line_match(Evas_Object *eo_obj, Evas_Object_Textblock_Node_Tex
    found_par = n->par;
    if (found_par)
      {
+        _layout_paragraph_realize(eo_obj, o, found_par);
         _layout_paragraph_render(o, found_par);
         EINA_INLIST_FOREACH(found_par->lines, ln)
           {
@@ -5340,7 +6026,7 @@ _find_layout_line_num(const Evas_Object *eo_obj, int line)
    Evas_Object_Textblock_Line *ln;
    Evas_Object_Textblock *o = eo_data_scope_get(eo_obj, MY_CLASS);
 
-   par = _layout_find_paragraph_by_line_no(o, line);
+   par = _layout_paragraph_by_line_no_realize((Evas_Object *) eo_obj, o, line);
    if (par)
      {
         _layout_paragraph_render(o, par);
@@ -5775,6 +6461,43 @@ _textblock_legacy_newline_get(Eo *eo_obj EINA_UNUSED, void *_pd, va_list *list)
    if (newline) *newline = o->legacy_newline;
 }
 
+EAPI void
+evas_object_textblock_virtual_layout_set(Evas_Object *eo_obj, Eina_Bool enabled)
+{
+   eo_do(eo_obj, evas_obj_textblock_virtual_layout_set(enabled));
+}
+
+static void
+_textblock_virtual_layout_set(Eo *eo_obj, void *_pd, va_list *list)
+{
+   Evas_Object_Textblock *o = _pd;
+   Eina_Bool enabled = va_arg(*list, int);
+   enabled = !!enabled;
+   if (o->virtual_layout.enabled == enabled)
+      return;
+
+   /* When turned off, the estimated paragraphs are laid out on the next
+    * layout as they are all in view. */
+   o->virtual_layout.enabled = enabled;
+   _evas_textblock_changed(o, eo_obj);
+}
+
+EAPI Eina_Bool
+evas_object_textblock_virtual_layout_get(const Evas_Object *eo_obj)
+{
+   Eina_Bool enabled = EINA_FALSE;
+   eo_do((Eo *)eo_obj, evas_obj_textblock_virtual_layout_get(&enabled));
+   return enabled;
+}
+
+static void
+_textblock_virtual_layout_get(Eo *eo_obj EINA_UNUSED, void *_pd, va_list *list)
+{
+   const Evas_Object_Textblock *o = _pd;
+   Eina_Bool *enabled = va_arg(*list, Eina_Bool *);
+   if (enabled) *enabled = o->virtual_layout.enabled;
+}
+
 EAPI void
 evas_object_textblock_valign_set(Evas_Object *eo_obj, double align)
 {
@@ -9673,7 +10396,7 @@ evas_textblock_cursor_char_coord_set(Evas_Textblock_Cursor *cur, Evas_Coord x, E
    x += o->style_pad.l;
    y += o->style_pad.t;
 
-   found_par = _layout_find_paragraph_by_y(o, y);
+   found_par = _layout_paragraph_by_y_realize(cur->obj, o, y);
    if (found_par)
      {
         _layout_paragraph_render(o, found_par);
@@ -9786,7 +10509,7 @@ evas_textblock_cursor_line_coord_set(Evas_Textblock_Cursor *cur, Evas_Coord y)
 
    y += o->style_pad.t;
 
-   found_par = _layout_find_paragraph_by_y(o, y);
+   found_par = _layout_paragraph_by_y_realize(cur->obj, o, y);
 
    if (found_par)
      {
@@ -10543,7 +11266,16 @@ _textblock_size_native_get(Eo *eo_obj, void *_pd, va_list *list)
         EINA_INLIST_FOREACH(o->paragraphs, par)
           {
              Evas_Coord tw, th;
-             _size_native_calc_paragraph_size(eo_obj, o, par, &position, &tw, &th);
+             if (par->estimated)
+               {
+                  /* Not laid out, go with the estimate */
+                  tw = par->wmax;
+                  th = par->h;
+                  position = TEXTBLOCK_POSITION_ELSE;
+               }
+             else
+                _size_native_calc_paragraph_size(eo_obj, o, par, &position,
+                      &tw, &th);
              if (tw > wmax)
                 wmax = tw;
              hmax += th;
@@ -11166,12 +11898,17 @@ evas_object_textblock_render(Evas_Object *eo_obj EINA_UNUSED,
 }
 
 static void
-evas_object_textblock_coords_recalc(Evas_Object *eo_obj EINA_UNUSED,
+evas_object_textblock_coords_recalc(Evas_Object *eo_obj,
                                     Evas_Object_Protected_Data *obj,
                                     void *type_private_data)
 {
    Evas_Object_Textblock *o = type_private_data;
 
+   // in virtual layout, what is visible may have left what is laid out
+   if (o->virtual_layout.enabled && o->formatted.valid &&
+       !_layout_virtual_window_valid(eo_obj, o))
+     o->content_changed = 1;
+
    if (
        // width changed thus we may have to re-wrap or change centering etc.
        (obj->cur->geometry.w != o->last_w) ||
@@ -11483,6 +12220,8 @@ _class_constructor(Eo_Class *klass)
         EO_OP_FUNC(EVAS_OBJ_TEXTBLOCK_ID(EVAS_OBJ_TEXTBLOCK_SUB_ID_SIZE_FORMATTED_GET), _textblock_size_formatted_get),
         EO_OP_FUNC(EVAS_OBJ_TEXTBLOCK_ID(EVAS_OBJ_TEXTBLOCK_SUB_ID_SIZE_NATIVE_GET), _textblock_size_native_get),
         EO_OP_FUNC(EVAS_OBJ_TEXTBLOCK_ID(EVAS_OBJ_TEXTBLOCK_SUB_ID_STYLE_INSETS_GET), _textblock_style_insets_get),
+        EO_OP_FUNC(EVAS_OBJ_TEXTBLOCK_ID(EVAS_OBJ_TEXTBLOCK_SUB_ID_VIRTUAL_LAYOUT_SET), _textblock_virtual_layout_set),
+        EO_OP_FUNC(EVAS_OBJ_TEXTBLOCK_ID(EVAS_OBJ_TEXTBLOCK_SUB_ID_VIRTUAL_LAYOUT_GET), _textblock_virtual_layout_get),
         EO_OP_FUNC_SENTINEL
    };
    eo_class_funcs_set(klass, func_desc);
@@ -11514,6 +12253,8 @@ static const Eo_Op_Description op_desc[] = {
      EO_OP_DESCRIPTION(EVAS_OBJ_TEXTBLOCK_SUB_ID_SIZE_FORMATTED_GET, "Get the formatted width and height."),
      EO_OP_DESCRIPTION(EVAS_OBJ_TEXTBLOCK_SUB_ID_SIZE_NATIVE_GET, "Get the native width and height."),
      EO_OP_DESCRIPTION(EVAS_OBJ_TEXTBLOCK_SUB_ID_STYLE_INSETS_GET, "? evas_object_textblock_style_insets_get"),
+     EO_OP_DESCRIPTION(EVAS_OBJ_TEXTBLOCK_SUB_ID_VIRTUAL_LAYOUT_SET, "Sets if only the paragraphs in view are laid out."),
+     EO_OP_DESCRIPTION(EVAS_OBJ_TEXTBLOCK_SUB_ID_VIRTUAL_LAYOUT_GET, "Gets if only the paragraphs in view are laid out."),
      EO_OP_DESCRIPTION_SENTINEL
 };
 static const Eo_Class_Description class_desc = {
@@ -1692,6 +1692,8 @@ evas_render_updates_internal(Evas *eo_e,
           }
      }
 
+   _evas_render_stats_begin(e, do_draw, do_async);
+
 #ifdef EVAS_CSERVE2
    if (evas_cserve2_use_get())
       evas_cserve2_dispatch();
@@ -1790,6 +1792,7 @@ evas_render_updates_internal(Evas *eo_e,
         _evas_render_prev_cur_clip_cache_add(e, obj);
      }
    OBJS_ARRAY_CLEAN(&e->restack_objects);
+   _evas_render_stats_mark(e, &e->stats.cur.phase1);
 
    /* phase 3. add exposes */
    EINA_LIST_FREE(e->damages, r)
@@ -1859,6 +1862,8 @@ evas_render_updates_internal(Evas *eo_e,
           /*	  obscuring_objects = eina_list_append(obscuring_objects, obj); */
           OBJ_ARRAY_PUSH(&e->obscuring_objects, obj);
      }
+   _evas_render_stats_mark(e, &e->stats.cur.updates);
+   e->stats.cur.objects = e->active_objects.count;
 
    /* save this list */
    /*    obscuring_objects_orig = obscuring_objects; */
@@ -1880,6 +1885,8 @@ evas_render_updates_internal(Evas *eo_e,
              Render_Updates *ru;
 
              RD("  [--- UPDATE %i %i %ix%i\n", ux, uy, uw, uh);
+             e->stats.cur.regions++;
+             e->stats.cur.pixels += (unsigned long long)uw * uh;
              if (do_async)
                {
                   ru = malloc(sizeof(*ru));
@@ -1993,6 +2000,7 @@ evas_render_updates_internal(Evas *eo_e,
                                  _evas_render_cutout_add(e, obj2, off_x + fx, off_y + fy);
                               }
 #endif
+                            e->stats.cur.objects_drawn++;
                             clean_them |= evas_render_mapped(e, eo_obj, obj, e->engine.data.context,
                                                              surface, off_x + fx,
                                                              off_y + fy, 0,
@@ -2027,18 +2035,25 @@ evas_render_updates_internal(Evas *eo_e,
              e->rendering = EINA_TRUE;
              _rendering_evases = eina_list_append(_rendering_evases, e);
 
+             /* the render thread finishes the frame statistics from here */
              evas_thread_queue_flush((Evas_Thread_Command_Cb)done_func, done_data);
           }
-        else if (haveup)
+        else
           {
-             EINA_LIST_FOREACH(e->video_objects, ll, eo_obj)
+             _evas_render_stats_mark(e, &e->stats.cur.render);
+             if (haveup)
                {
-                  _evas_object_image_video_overlay_do(eo_obj);
+                  EINA_LIST_FOREACH(e->video_objects, ll, eo_obj)
+                    {
+                       _evas_object_image_video_overlay_do(eo_obj);
+                    }
+                  _cb_always_call(eo_e, EVAS_CALLBACK_RENDER_FLUSH_PRE, NULL);
+                  e->engine.func->output_flush(e->engine.data.output,
+                                               EVAS_RENDER_MODE_SYNC);
+                  _cb_always_call(eo_e, EVAS_CALLBACK_RENDER_FLUSH_POST, NULL);
+                  _evas_render_stats_mark(e, &e->stats.cur.flush);
                }
-             _cb_always_call(eo_e, EVAS_CALLBACK_RENDER_FLUSH_PRE, NULL);
-             e->engine.func->output_flush(e->engine.data.output,
-                                          EVAS_RENDER_MODE_SYNC);
-             _cb_always_call(eo_e, EVAS_CALLBACK_RENDER_FLUSH_POST, NULL);
+             _evas_render_stats_end(e, haveup);
           }
      }
 
@@ -2244,11 +2259,15 @@ evas_render_wakeup(Evas *eo_e)
           {
              _evas_object_image_video_overlay_do(eo_obj);
           }
+        /* don't count the wait for the mainloop as flush time */
+        _evas_render_stats_mark(e, NULL);
         _cb_always_call(eo_e, EVAS_CALLBACK_RENDER_FLUSH_PRE, NULL);
         e->engine.func->output_flush(e->engine.data.output,
                                      EVAS_RENDER_MODE_ASYNC_END);
         _cb_always_call(eo_e, EVAS_CALLBACK_RENDER_FLUSH_POST, NULL);
+        _evas_render_stats_mark(e, &e->stats.cur.flush);
      }
+   _evas_render_stats_end(e, haveup);
 
    /* clear redraws */
    e->engine.func->output_redraws_clear(e->engine.data.output);
@@ -2289,6 +2308,9 @@ evas_render_async_wakeup(void *target, Evas_Callback_Type type EINA_UNUSED, void
 static void
 evas_render_pipe_wakeup(void *data)
 {
+   Evas_Public_Data *e = data;
+
+   _evas_render_stats_mark(e, &e->stats.cur.render);
    evas_async_events_put(data, 0, NULL, evas_render_async_wakeup);
 }
 
@@ -153,11 +153,16 @@ _evas_render2_stage_last(Eo *eo_e, Eina_Bool make_updates)
    // if we did do rendering flush output to target and call callbacks
    if (e->render.updates)
      {
+        // don't count the wait for the mainloop as flush time
+        _evas_render_stats_mark(e, NULL);
         _evas_render2_always_call(eo_e, EVAS_CALLBACK_RENDER_FLUSH_PRE, NULL);
         e->engine.func->output_flush(e->engine.data.output,
                                      EVAS_RENDER_MODE_ASYNC_END);
         _evas_render2_always_call(eo_e, EVAS_CALLBACK_RENDER_FLUSH_POST, NULL);
+        _evas_render_stats_mark(e, &e->stats.cur.flush);
      }
+   // the frame is done, record its statistics if it drew anything
+   _evas_render_stats_end(e, !!e->render.updates);
    // clear our previous rendering stuff from the engine
    e->engine.func->output_redraws_clear(e->engine.data.output);
    // stop tracking canvas as being async rendered
@@ -196,6 +201,12 @@ _evas_render2_object_process(Evas_Public_Data *e,
    // XXX: this needs to become parallel, BUT we need new object methods to
    // call to make that possible as the current ones work on a single global
    // engine handle and single orderted redraw queue.
+
+   // count the objects evas_render.c would list as active, smart ones and
+   // their members alike
+   evas_object_clip_recalc(obj);
+   if ((obj->delete_me) || (evas_object_is_active(obj->object, obj)))
+     e->stats.cur.objects++;
    if (obj->smart.smart)
      {
         EINA_INLIST_FOREACH
@@ -210,7 +221,6 @@ _evas_render2_stage_generate_object_updates(Evas_Public_Data *e)
 {
    Evas_Layer *lay;
 
-   // XXX: should time this
    EINA_INLIST_FOREACH(e->layers, lay)
      {
         Evas_Object_Protected_Data *obj;
@@ -218,6 +228,7 @@ _evas_render2_stage_generate_object_updates(Evas_Public_Data *e)
         EINA_INLIST_FOREACH(lay->objects, obj)
           _evas_render2_object_process(e, obj);
      }
+   _evas_render_stats_mark(e, &e->stats.cur.phase1);
 }
 
 static void
@@ -226,7 +237,6 @@ _evas_render2_stage_explicit_updates(Evas_Public_Data *e)
    Eina_Rectangle *r;
    Eina_List *l;
 
-   // XXX: should time this
    // if the output size changed, add a full redraw
    if ((e->output.changed) || (e->framespace.changed))
      {
@@ -248,6 +258,7 @@ _evas_render2_stage_explicit_updates(Evas_Public_Data *e)
    EINA_LIST_FOREACH(e->obscures, l, r)
      e->engine.func->output_redraws_rect_del(e->engine.data.output,
                                              r->x, r->y, r->w, r->h);
+   _evas_render_stats_mark(e, &e->stats.cur.updates);
 }
 
 static void
@@ -297,6 +308,7 @@ _evas_render2_th_render(void *data)
    Evas_Public_Data *e = data;
    printf("th rend %p\n", e);
    _evas_render2_stage_render_do(e);
+   _evas_render_stats_mark(e, &e->stats.cur.render);
 }
 
 // major functions (called from evas_render.c)
@@ -318,6 +330,8 @@ _evas_render2_begin(Eo *eo_e, Eina_Bool make_updates,
    // check viewport size is same as output - not allowed to differ
    if ((e->output.w != e->viewport.w) || (e->output.h != e->viewport.h))
      ERR("viewport size != output size!");
+   // start collecting this frame's statistics
+   _evas_render_stats_begin(e, do_draw, do_async);
    // call canvas callbacks saying we are in the pre-render state
    _evas_render2_always_call(eo_e, EVAS_CALLBACK_RENDER_PRE, NULL);
    // we have to calculate smare objects before render so do that here
@@ -344,7 +358,11 @@ _evas_render2_begin(Eo *eo_e, Eina_Bool make_updates,
              evas_thread_queue_flush(_evas_render2_wakeup_send, eo_e);
           }
         // or if not async, do rendering inline now
-        else _evas_render2_stage_render_do(e);
+        else
+          {
+             _evas_render2_stage_render_do(e);
+             _evas_render_stats_mark(e, &e->stats.cur.render);
+          }
      }
    // reset flags since rendering is processed now
    _evas_render2_stage_reset(e);
@@ -65,6 +65,7 @@ _raise(Eo *eo_obj, void *_pd, va_list *list EINA_UNUSED)
         if (obj->in_layer)
           obj->layer->objects = (Evas_Object_Protected_Data *)eina_inlist_demote(EINA_INLIST_GET(obj->layer->objects), EINA_INLIST_GET(obj));
      }
+   evas_event_index_restack(obj);
    if (obj->clip.clipees)
      {
         evas_object_inform_call_restack(eo_obj);
@@ -123,6 +124,7 @@ _lower(Eo *eo_obj, void *_pd, va_list *list EINA_UNUSED)
           obj->layer->objects = (Evas_Object_Protected_Data *)eina_inlist_promote(EINA_INLIST_GET(obj->layer->objects),
                                                                                  EINA_INLIST_GET(obj));
      }
+   evas_event_index_restack(obj);
    if (obj->clip.clipees)
      {
         evas_object_inform_call_restack(eo_obj);
@@ -211,6 +213,7 @@ _stack_above(Eo *eo_obj, void *_pd, va_list *list)
                                                                                             EINA_INLIST_GET(above));
           }
      }
+   evas_event_index_restack(obj);
    if (obj->clip.clipees)
      {
         evas_object_inform_call_restack(eo_obj);
@@ -299,6 +302,7 @@ _stack_below(Eo *eo_obj, void *_pd, va_list *list)
                                                                                EINA_INLIST_GET(below));
           }
      }
+   evas_event_index_restack(obj);
    if (obj->clip.clipees)
      {
         evas_object_inform_call_restack(eo_obj);
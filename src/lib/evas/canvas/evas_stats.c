@@ -1,5 +1,10 @@
 #include "evas_common_private.h"
 #include "evas_private.h"
+#ifdef HAVE_CLOCK_GETTIME
+# include <time.h>
+#else
+# include <sys/time.h>
+#endif
 //#include "evas_cs.h"
 
 EAPI Eina_Bool
@@ -47,3 +52,140 @@ EAPI void
 evas_cserve_disconnect(void)
 {
 }
+
+static double
+_evas_render_stats_time_get(void)
+{
+#ifdef HAVE_CLOCK_GETTIME
+   struct timespec t;
+
+   clock_gettime(CLOCK_MONOTONIC, &t);
+   return (double)t.tv_sec + ((double)t.tv_nsec / 1000000000.0);
+#else
+   struct timeval tv;
+
+   gettimeofday(&tv, NULL);
+   return (double)tv.tv_sec + ((double)tv.tv_usec / 1000000.0);
+#endif
+}
+
+void
+_evas_render_stats_begin(Evas_Public_Data *e, Eina_Bool do_draw, Eina_Bool do_async)
+{
+   memset(&e->stats.cur, 0, sizeof(e->stats.cur));
+   // frames that are not drawn (evas_norender) are not recorded
+   e->stats.active = ((e->stats.size > 0) && (do_draw));
+   if (!e->stats.active) return;
+   e->stats.cur.async = do_async;
+   e->stats.start = e->stats.stamp = _evas_render_stats_time_get();
+}
+
+void
+_evas_render_stats_mark(Evas_Public_Data *e, double *phase)
+{
+   double t;
+
+   // may be called from the render thread, but the mainloop does not
+   // touch the current frame until the thread is done with it. a NULL
+   // phase only restarts the clock
+   if (!e->stats.active) return;
+   t = _evas_render_stats_time_get();
+   if (phase) *phase += t - e->stats.stamp;
+   e->stats.stamp = t;
+}
+
+void
+_evas_render_stats_end(Evas_Public_Data *e, Eina_Bool drawn)
+{
+   if (!e->stats.active) return;
+   e->stats.active = EINA_FALSE;
+   // a frame with nothing to redraw would only water the averages down
+   if (!drawn) return;
+   if (!e->stats.frames)
+     {
+        e->stats.frames = malloc(e->stats.size * sizeof(Evas_Render_Stats));
+        if (!e->stats.frames) return;
+     }
+   e->stats.cur.frame = ++e->stats.serial;
+   e->stats.cur.total = e->stats.stamp - e->stats.start;
+   e->stats.frames[e->stats.next] = e->stats.cur;
+   e->stats.next = (e->stats.next + 1) % e->stats.size;
+   if (e->stats.count < e->stats.size) e->stats.count++;
+}
+
+EAPI void
+evas_render_stats_size_set(Evas *eo_e, unsigned int frames)
+{
+   MAGIC_CHECK(eo_e, Evas, MAGIC_EVAS);
+   return;
+   MAGIC_CHECK_END();
+   eo_do(eo_e, evas_canvas_render_stats_size_set(frames));
+}
+
+void
+_canvas_render_stats_size_set(Eo *eo_e EINA_UNUSED, void *_pd, va_list *list)
+{
+   unsigned int frames = va_arg(*list, unsigned int);
+   Evas_Public_Data *e = _pd;
+
+   if (frames == e->stats.size) return;
+   // an async frame still in flight is dropped with the old ring
+   e->stats.active = EINA_FALSE;
+   free(e->stats.frames);
+   e->stats.frames = NULL;
+   e->stats.size = frames;
+   e->stats.count = 0;
+   e->stats.next = 0;
+}
+
+EAPI unsigned int
+evas_render_stats_size_get(const Evas *eo_e)
+{
+   MAGIC_CHECK(eo_e, Evas, MAGIC_EVAS);
+   return 0;
+   MAGIC_CHECK_END();
+   unsigned int ret = 0;
+   eo_do((Eo *)eo_e, evas_canvas_render_stats_size_get(&ret));
+   return ret;
+}
+
+void
+_canvas_render_stats_size_get(Eo *eo_e EINA_UNUSED, void *_pd, va_list *list)
+{
+   unsigned int *ret = va_arg(*list, unsigned int *);
+   const Evas_Public_Data *e = _pd;
+
+   *ret = e->stats.size;
+}
+
+EAPI unsigned int
+evas_render_stats_get(const Evas *eo_e, Evas_Render_Stats *stats, unsigned int count)
+{
+   MAGIC_CHECK(eo_e, Evas, MAGIC_EVAS);
+   return 0;
+   MAGIC_CHECK_END();
+   unsigned int ret = 0;
+   eo_do((Eo *)eo_e, evas_canvas_render_stats_get(stats, count, &ret));
+   return ret;
+}
+
+void
+_canvas_render_stats_get(Eo *eo_e EINA_UNUSED, void *_pd, va_list *list)
+{
+   Evas_Render_Stats *stats = va_arg(*list, Evas_Render_Stats *);
+   unsigned int count = va_arg(*list, unsigned int);
+   unsigned int *ret = va_arg(*list, unsigned int *);
+   const Evas_Public_Data *e = _pd;
+   unsigned int i, idx;
+
+   if (!stats) count = 0;
+   if (count > e->stats.count) count = e->stats.count;
+   // walk back from the newest frame
+   idx = e->stats.next;
+   for (i = 0; i < count; i++)
+     {
+        idx = (idx + e->stats.size - 1) % e->stats.size;
+        stats[i] = e->stats.frames[idx];
+     }
+   if (ret) *ret = count;
+}
@@ -0,0 +1,45 @@
+/* blend color --> dst */
+
+#ifdef BUILD_AVX2
+
+static void
+_op_blend_c_dp_avx2(DATA32 *s EINA_UNUSED, DATA8 *m EINA_UNUSED, DATA32 c, DATA32 *d, int l) {
+
+   DATA32 alpha = 256 - (c >> 24);
+   const __m256i c0 = _mm256_set1_epi32(c);
+   const __m256i a0 = _mm256_set1_epi32(alpha);
+
+   LOOP_ALIGNED_U1_A8(d, l,
+      { /* UOP */
+
+         *d = c + MUL_256(alpha, *d);
+         d++; l--;
+      },
+      { /* A8OP */
+
+         __m256i d0 = _mm256_load_si256((__m256i *)d);
+
+         d0 = _mm256_add_epi32(c0, mul_256_avx2(a0, d0));
+
+         _mm256_store_si256((__m256i *)d, d0);
+
+         d += 8; l -= 8;
+      })
+}
+
+#define _op_blend_caa_dp_avx2 _op_blend_c_dp_avx2
+
+#define _op_blend_c_dpan_avx2 _op_blend_c_dp_avx2
+#define _op_blend_caa_dpan_avx2 _op_blend_c_dpan_avx2
+
+static void
+init_blend_color_span_funcs_avx2(void)
+{
+   op_blend_span_funcs[SP_N][SM_N][SC][DP][CPU_AVX2] = _op_blend_c_dp_avx2;
+   op_blend_span_funcs[SP_N][SM_N][SC_AA][DP][CPU_AVX2] = _op_blend_caa_dp_avx2;
+
+   op_blend_span_funcs[SP_N][SM_N][SC][DP_AN][CPU_AVX2] = _op_blend_c_dpan_avx2;
+   op_blend_span_funcs[SP_N][SM_N][SC_AA][DP_AN][CPU_AVX2] = _op_blend_caa_dpan_avx2;
+}
+
+#endif
@@ -0,0 +1,112 @@
+/* blend mask x color -> dst */
+
+#ifdef BUILD_AVX2
+
+static void
+_op_blend_mas_c_dp_avx2(DATA32 *s EINA_UNUSED, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+
+   int alpha = 256 - (c >> 24);
+   const __m256i c0 = _mm256_set1_epi32(c);
+
+   LOOP_ALIGNED_U1_A8(d, l,
+      { /* UOP */
+
+         DATA32 a = *m;
+         switch(a)
+           {
+           case 0:
+              break;
+           case 255:
+              *d = c + MUL_256(alpha, *d);
+              break;
+           default:
+                {
+                   DATA32 mc = MUL_SYM(a, c);
+                   a = 256 - (mc >> 24);
+                   *d = mc + MUL_256(a, *d);
+                }
+              break;
+           }
+         m++; d++; l--;
+      },
+      { /* A8OP */
+
+         __m256i d0 = _mm256_load_si256((__m256i *)d);
+         __m256i m0 = load8_mask_avx2(m);
+
+         /* a mask of 255 keeps the color as is and 0 leaves dst alone */
+         __m256i mc0 = mul_sym_avx2(m0, c0);
+         __m256i a0 = sub8_alpha_avx2(mc0);
+         d0 = _mm256_add_epi32(mc0, mul_256_avx2(a0, d0));
+
+         _mm256_store_si256((__m256i *)d, d0);
+
+         m += 8; d += 8; l -= 8;
+      })
+}
+
+static void
+_op_blend_mas_can_dp_avx2(DATA32 *s EINA_UNUSED, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+
+   const __m256i c0 = _mm256_set1_epi32(c);
+   const __m256i zero = _mm256_setzero_si256();
+   const __m256i c255 = _mm256_set1_epi32(255);
+   const __m256i ones = _mm256_set1_epi32(1);
+   int alpha;
+
+   LOOP_ALIGNED_U1_A8(d, l,
+      { /* UOP */
+
+         alpha = *m;
+         switch(alpha)
+           {
+           case 0:
+              break;
+           case 255:
+              *d = c;
+              break;
+           default:
+              alpha++;
+              *d = INTERP_256(alpha, c, *d);
+              break;
+           }
+         m++; d++; l--;
+      },
+      { /* A8OP */
+
+         __m256i d0 = _mm256_load_si256((__m256i *)d);
+         __m256i m0 = load8_mask_avx2(m);
+
+         __m256i r0 = interp_256_avx2(_mm256_add_epi32(m0, ones), c0, d0);
+         r0 = _mm256_blendv_epi8(r0, c0, _mm256_cmpeq_epi32(m0, c255));
+         d0 = _mm256_blendv_epi8(r0, d0, _mm256_cmpeq_epi32(m0, zero));
+
+         _mm256_store_si256((__m256i *)d, d0);
+
+         m += 8; d += 8; l -= 8;
+      })
+}
+
+#define _op_blend_mas_cn_dp_avx2 _op_blend_mas_can_dp_avx2
+#define _op_blend_mas_caa_dp_avx2 _op_blend_mas_c_dp_avx2
+
+#define _op_blend_mas_c_dpan_avx2 _op_blend_mas_c_dp_avx2
+#define _op_blend_mas_cn_dpan_avx2 _op_blend_mas_cn_dp_avx2
+#define _op_blend_mas_can_dpan_avx2 _op_blend_mas_can_dp_avx2
+#define _op_blend_mas_caa_dpan_avx2 _op_blend_mas_caa_dp_avx2
+
+static void
+init_blend_mask_color_span_funcs_avx2(void)
+{
+   op_blend_span_funcs[SP_N][SM_AS][SC][DP][CPU_AVX2] = _op_blend_mas_c_dp_avx2;
+   op_blend_span_funcs[SP_N][SM_AS][SC_N][DP][CPU_AVX2] = _op_blend_mas_cn_dp_avx2;
+   op_blend_span_funcs[SP_N][SM_AS][SC_AN][DP][CPU_AVX2] = _op_blend_mas_can_dp_avx2;
+   op_blend_span_funcs[SP_N][SM_AS][SC_AA][DP][CPU_AVX2] = _op_blend_mas_caa_dp_avx2;
+
+   op_blend_span_funcs[SP_N][SM_AS][SC][DP_AN][CPU_AVX2] = _op_blend_mas_c_dpan_avx2;
+   op_blend_span_funcs[SP_N][SM_AS][SC_N][DP_AN][CPU_AVX2] = _op_blend_mas_cn_dpan_avx2;
+   op_blend_span_funcs[SP_N][SM_AS][SC_AN][DP_AN][CPU_AVX2] = _op_blend_mas_can_dpan_avx2;
+   op_blend_span_funcs[SP_N][SM_AS][SC_AA][DP_AN][CPU_AVX2] = _op_blend_mas_caa_dpan_avx2;
+}
+
+#endif
@@ -0,0 +1,87 @@
+/* blend pixel --> dst */
+
+#ifdef BUILD_AVX2
+
+static void
+_op_blend_p_dp_avx2(DATA32 *s, DATA8 *m EINA_UNUSED, DATA32 c EINA_UNUSED, DATA32 *d, int l) {
+
+   LOOP_ALIGNED_U1_A8(d, l,
+      { /* UOP */
+
+         int alpha = 256 - (*s >> 24);
+         *d = *s + MUL_256(alpha, *d);
+         s++; d++; l--;
+      },
+      { /* A8OP */
+
+         __m256i s0 = _mm256_loadu_si256((__m256i *)s);
+         __m256i d0 = _mm256_load_si256((__m256i *)d);
+
+         __m256i a0 = sub8_alpha_avx2(s0);
+         d0 = _mm256_add_epi32(s0, mul_256_avx2(a0, d0));
+
+         _mm256_store_si256((__m256i *)d, d0);
+
+         s += 8; d += 8; l -= 8;
+      })
+}
+
+static void
+_op_blend_pas_dp_avx2(DATA32 *s, DATA8 *m EINA_UNUSED, DATA32 c EINA_UNUSED, DATA32 *d, int l) {
+
+   const __m256i zero = _mm256_setzero_si256();
+   int alpha;
+
+   LOOP_ALIGNED_U1_A8(d, l,
+      { /* UOP */
+         switch (*s & 0xff000000)
+           {
+           case 0:
+              break;
+           case 0xff000000:
+              *d = *s;
+              break;
+           default:
+              alpha = 256 - (*s >> 24);
+              *d = *s + MUL_256(alpha, *d);
+              break;
+           }
+         s++; d++; l--;
+      },
+      { /* A8OP */
+
+         __m256i s0 = _mm256_loadu_si256((__m256i *)s);
+         __m256i d0 = _mm256_load_si256((__m256i *)d);
+
+         __m256i a0 = sub8_alpha_avx2(s0);
+         __m256i r0 = _mm256_add_epi32(s0, mul_256_avx2(a0, d0));
+
+         /* fully transparent source leaves dst untouched */
+         __m256i zmask0 = _mm256_cmpeq_epi32(_mm256_srli_epi32(s0, 24), zero);
+         d0 = _mm256_blendv_epi8(r0, d0, zmask0);
+
+         _mm256_store_si256((__m256i *)d, d0);
+
+         s += 8; d += 8; l -= 8;
+      })
+}
+
+#define _op_blend_pan_dp_avx2 NULL
+
+#define _op_blend_p_dpan_avx2 _op_blend_p_dp_avx2
+#define _op_blend_pas_dpan_avx2 _op_blend_pas_dp_avx2
+#define _op_blend_pan_dpan_avx2 _op_blend_pan_dp_avx2
+
+static void
+init_blend_pixel_span_funcs_avx2(void)
+{
+   op_blend_span_funcs[SP][SM_N][SC_N][DP][CPU_AVX2] = _op_blend_p_dp_avx2;
+   op_blend_span_funcs[SP_AS][SM_N][SC_N][DP][CPU_AVX2] = _op_blend_pas_dp_avx2;
+   op_blend_span_funcs[SP_AN][SM_N][SC_N][DP][CPU_AVX2] = _op_blend_pan_dp_avx2;
+
+   op_blend_span_funcs[SP][SM_N][SC_N][DP_AN][CPU_AVX2] = _op_blend_p_dpan_avx2;
+   op_blend_span_funcs[SP_AS][SM_N][SC_N][DP_AN][CPU_AVX2] = _op_blend_pas_dpan_avx2;
+   op_blend_span_funcs[SP_AN][SM_N][SC_N][DP_AN][CPU_AVX2] = _op_blend_pan_dpan_avx2;
+}
+
+#endif
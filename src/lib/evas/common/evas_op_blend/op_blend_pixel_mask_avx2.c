@@ -0,0 +1,107 @@
+/* blend pixel x mask --> dst */
+
+#ifdef BUILD_AVX2
+
+static void
+_op_blend_p_mas_dp_avx2(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+
+   int alpha;
+
+   LOOP_ALIGNED_U1_A8(d, l,
+      { /* UOP */
+
+         alpha = *m;
+         switch(alpha)
+           {
+           case 0:
+              break;
+           case 255:
+              alpha = 256 - (*s >> 24);
+              *d = *s + MUL_256(alpha, *d);
+              break;
+           default:
+              c = MUL_SYM(alpha, *s);
+              alpha = 256 - (c >> 24);
+              *d = c + MUL_256(alpha, *d);
+              break;
+           }
+         m++; s++; d++; l--;
+      },
+      { /* A8OP */
+
+         __m256i s0 = _mm256_loadu_si256((__m256i *)s);
+         __m256i d0 = _mm256_load_si256((__m256i *)d);
+         __m256i m0 = load8_mask_avx2(m);
+
+         /* a mask of 255 keeps the source as is and 0 leaves dst alone */
+         __m256i c0 = mul_sym_avx2(m0, s0);
+         __m256i a0 = sub8_alpha_avx2(c0);
+         d0 = _mm256_add_epi32(c0, mul_256_avx2(a0, d0));
+
+         _mm256_store_si256((__m256i *)d, d0);
+
+         m += 8; s += 8; d += 8; l -= 8;
+      })
+}
+
+static void
+_op_blend_pas_mas_dp_avx2(DATA32 *s, DATA8 *m, DATA32 c EINA_UNUSED, DATA32 *d, int l) {
+
+   const __m256i zero = _mm256_setzero_si256();
+   const __m256i c255 = _mm256_set1_epi32(255);
+   const __m256i ones = _mm256_set1_epi32(1);
+   int alpha;
+
+   LOOP_ALIGNED_U1_A8(d, l,
+      { /* UOP */
+
+         alpha = *m;
+         switch(alpha)
+           {
+           case 0:
+              break;
+           case 255:
+              *d = *s;
+              break;
+           default:
+              alpha++;
+              *d = INTERP_256(alpha, *s, *d);
+              break;
+           }
+         m++; s++; d++; l--;
+      },
+      { /* A8OP */
+
+         __m256i s0 = _mm256_loadu_si256((__m256i *)s);
+         __m256i d0 = _mm256_load_si256((__m256i *)d);
+         __m256i m0 = load8_mask_avx2(m);
+
+         __m256i r0 = interp_256_avx2(_mm256_add_epi32(m0, ones), s0, d0);
+         r0 = _mm256_blendv_epi8(r0, s0, _mm256_cmpeq_epi32(m0, c255));
+         d0 = _mm256_blendv_epi8(r0, d0, _mm256_cmpeq_epi32(m0, zero));
+
+         _mm256_store_si256((__m256i *)d, d0);
+
+         m += 8; s += 8; d += 8; l -= 8;
+      })
+}
+
+#define _op_blend_pan_mas_dp_avx2 _op_blend_pas_mas_dp_avx2
+
+#define _op_blend_p_mas_dpan_avx2 _op_blend_p_mas_dp_avx2
+#define _op_blend_pas_mas_dpan_avx2 _op_blend_pas_mas_dp_avx2
+#define _op_blend_pan_mas_dpan_avx2 _op_blend_pan_mas_dp_avx2
+
+static void
+init_blend_pixel_mask_span_funcs_avx2(void)
+{
+   op_blend_span_funcs[SP][SM_AS][SC_N][DP][CPU_AVX2] = _op_blend_p_mas_dp_avx2;
+   op_blend_span_funcs[SP_AS][SM_AS][SC_N][DP][CPU_AVX2] = _op_blend_pas_mas_dp_avx2;
+   op_blend_span_funcs[SP_AN][SM_AS][SC_N][DP][CPU_AVX2] = _op_blend_pan_mas_dp_avx2;
+
+   op_blend_span_funcs[SP][SM_AS][SC_N][DP_AN][CPU_AVX2] = _op_blend_p_mas_dpan_avx2;
+   op_blend_span_funcs[SP_AS][SM_AS][SC_N][DP_AN][CPU_AVX2] = _op_blend_pas_mas_dpan_avx2;
+   op_blend_span_funcs[SP_AN][SM_AS][SC_N][DP_AN][CPU_AVX2] = _op_blend_pan_mas_dpan_avx2;
+}
+
+#endif
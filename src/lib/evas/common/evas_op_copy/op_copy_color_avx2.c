@@ -0,0 +1,47 @@
+/* copy color --> dst */
+
+#ifdef BUILD_AVX2
+
+static void
+_op_copy_c_dp_avx2(DATA32 *s EINA_UNUSED, DATA8 *m EINA_UNUSED, DATA32 c, DATA32 *d, int l) {
+
+   const __m256i c0 = _mm256_set1_epi32(c);
+
+   LOOP_ALIGNED_U1_A8(d, l,
+      { /* UOP */
+
+         *d = c;
+         d++; l--;
+      },
+      { /* A8OP */
+
+         _mm256_store_si256((__m256i *)d, c0);
+
+         d += 8; l -= 8;
+      })
+}
+
+#define _op_copy_cn_dp_avx2 _op_copy_c_dp_avx2
+#define _op_copy_can_dp_avx2 _op_copy_c_dp_avx2
+#define _op_copy_caa_dp_avx2 _op_copy_c_dp_avx2
+
+#define _op_copy_c_dpan_avx2 _op_copy_c_dp_avx2
+#define _op_copy_cn_dpan_avx2 _op_copy_c_dp_avx2
+#define _op_copy_can_dpan_avx2 _op_copy_c_dp_avx2
+#define _op_copy_caa_dpan_avx2 _op_copy_c_dp_avx2
+
+static void
+init_copy_color_span_funcs_avx2(void)
+{
+   op_copy_span_funcs[SP_N][SM_N][SC_N][DP][CPU_AVX2] = _op_copy_cn_dp_avx2;
+   op_copy_span_funcs[SP_N][SM_N][SC][DP][CPU_AVX2] = _op_copy_c_dp_avx2;
+   op_copy_span_funcs[SP_N][SM_N][SC_AN][DP][CPU_AVX2] = _op_copy_can_dp_avx2;
+   op_copy_span_funcs[SP_N][SM_N][SC_AA][DP][CPU_AVX2] = _op_copy_caa_dp_avx2;
+
+   op_copy_span_funcs[SP_N][SM_N][SC_N][DP_AN][CPU_AVX2] = _op_copy_cn_dpan_avx2;
+   op_copy_span_funcs[SP_N][SM_N][SC][DP_AN][CPU_AVX2] = _op_copy_c_dpan_avx2;
+   op_copy_span_funcs[SP_N][SM_N][SC_AN][DP_AN][CPU_AVX2] = _op_copy_can_dpan_avx2;
+   op_copy_span_funcs[SP_N][SM_N][SC_AA][DP_AN][CPU_AVX2] = _op_copy_caa_dpan_avx2;
+}
+
+#endif
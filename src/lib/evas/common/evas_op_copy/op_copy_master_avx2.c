@@ -0,0 +1,17 @@
+#define NEED_AVX2 1
+
+#include "evas_common_private.h"
+
+extern RGBA_Gfx_Func     op_copy_span_funcs[SP_LAST][SM_LAST][SC_LAST][DP_LAST][CPU_LAST];
+
+# include "op_copy_color_avx2.c"
+# include "op_copy_pixel_color_avx2.c"
+
+void
+evas_common_op_copy_init_avx2(void)
+{
+#ifdef BUILD_AVX2
+   init_copy_pixel_color_span_funcs_avx2();
+   init_copy_color_span_funcs_avx2();
+#endif
+}
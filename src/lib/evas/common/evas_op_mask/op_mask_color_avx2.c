@@ -0,0 +1,42 @@
+/* mask color --> dst */
+
+#ifdef BUILD_AVX2
+
+static void
+_op_mask_c_dp_avx2(DATA32 *s EINA_UNUSED, DATA8 *m EINA_UNUSED, DATA32 c, DATA32 *d, int l) {
+
+   c = 1 + (c >> 24);
+   const __m256i c0 = _mm256_set1_epi32(c);
+
+   LOOP_ALIGNED_U1_A8(d, l,
+      { /* UOP */
+
+         *d = MUL_256(c, *d);
+         d++; l--;
+      },
+      { /* A8OP */
+
+         __m256i d0 = _mm256_load_si256((__m256i *)d);
+
+         _mm256_store_si256((__m256i *)d, mul_256_avx2(c0, d0));
+
+         d += 8; l -= 8;
+      })
+}
+
+#define _op_mask_caa_dp_avx2 _op_mask_c_dp_avx2
+
+#define _op_mask_c_dpan_avx2 _op_mask_c_dp_avx2
+#define _op_mask_caa_dpan_avx2 _op_mask_caa_dp_avx2
+
+static void
+init_mask_color_span_funcs_avx2(void)
+{
+   op_mask_span_funcs[SP_N][SM_N][SC][DP][CPU_AVX2] = _op_mask_c_dp_avx2;
+   op_mask_span_funcs[SP_N][SM_N][SC_AA][DP][CPU_AVX2] = _op_mask_caa_dp_avx2;
+
+   op_mask_span_funcs[SP_N][SM_N][SC][DP_AN][CPU_AVX2] = _op_mask_c_dpan_avx2;
+   op_mask_span_funcs[SP_N][SM_N][SC_AA][DP_AN][CPU_AVX2] = _op_mask_caa_dpan_avx2;
+}
+
+#endif
@@ -0,0 +1,62 @@
+/* mask mask x color -> dst */
+
+#ifdef BUILD_AVX2
+
+static void
+_op_mask_mas_c_dp_avx2(DATA32 *s EINA_UNUSED, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+
+   c = 1 + (c >> 24);
+   const __m256i ca0 = _mm256_set1_epi32(257 - c);
+   const __m256i a256 = _mm256_set1_epi32(256);
+   int a;
+
+   LOOP_ALIGNED_U1_A8(d, l,
+      { /* UOP */
+
+         a = *m;
+         switch(a)
+           {
+           case 0:
+              break;
+           case 255:
+              *d = MUL_256(c, *d);
+              break;
+           default:
+              a = 256 - (((257 - c) * a) >> 8);
+              *d = MUL_256(a, *d);
+              break;
+           }
+         m++; d++; l--;
+      },
+      { /* A8OP */
+
+         __m256i d0 = _mm256_load_si256((__m256i *)d);
+         __m256i m0 = load8_mask_avx2(m);
+
+         /* the general case gives c for a mask of 255 and 256 for 0 */
+         m0 = _mm256_srli_epi32(_mm256_mullo_epi16(ca0, m0), 8);
+         m0 = _mm256_sub_epi32(a256, m0);
+         d0 = mul_256_avx2(m0, d0);
+
+         _mm256_store_si256((__m256i *)d, d0);
+
+         m += 8; d += 8; l -= 8;
+      })
+}
+
+#define _op_mask_mas_caa_dp_avx2 _op_mask_mas_c_dp_avx2
+
+#define _op_mask_mas_c_dpan_avx2 _op_mask_mas_c_dp_avx2
+#define _op_mask_mas_caa_dpan_avx2 _op_mask_mas_caa_dp_avx2
+
+static void
+init_mask_mask_color_span_funcs_avx2(void)
+{
+   op_mask_span_funcs[SP_N][SM_AS][SC][DP][CPU_AVX2] = _op_mask_mas_c_dp_avx2;
+   op_mask_span_funcs[SP_N][SM_AS][SC_AA][DP][CPU_AVX2] = _op_mask_mas_caa_dp_avx2;
+
+   op_mask_span_funcs[SP_N][SM_AS][SC][DP_AN][CPU_AVX2] = _op_mask_mas_c_dpan_avx2;
+   op_mask_span_funcs[SP_N][SM_AS][SC_AA][DP_AN][CPU_AVX2] = _op_mask_mas_caa_dpan_avx2;
+}
+
+#endif
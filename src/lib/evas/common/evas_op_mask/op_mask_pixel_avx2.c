@@ -0,0 +1,42 @@
+/* mask pixel --> dst */
+
+#ifdef BUILD_AVX2
+
+static void
+_op_mask_p_dp_avx2(DATA32 *s, DATA8 *m EINA_UNUSED, DATA32 c EINA_UNUSED, DATA32 *d, int l) {
+
+   LOOP_ALIGNED_U1_A8(d, l,
+      { /* UOP */
+
+         *d = MUL_SYM(*s >> 24, *d);
+         d++; s++; l--;
+      },
+      { /* A8OP */
+
+         __m256i s0 = _mm256_loadu_si256((__m256i *)s);
+         __m256i d0 = _mm256_load_si256((__m256i *)d);
+
+         d0 = mul_sym_avx2(_mm256_srli_epi32(s0, 24), d0);
+
+         _mm256_store_si256((__m256i *)d, d0);
+
+         d += 8; s += 8; l -= 8;
+      })
+}
+
+#define _op_mask_pas_dp_avx2 _op_mask_p_dp_avx2
+
+#define _op_mask_p_dpan_avx2 _op_mask_p_dp_avx2
+#define _op_mask_pas_dpan_avx2 _op_mask_pas_dp_avx2
+
+static void
+init_mask_pixel_span_funcs_avx2(void)
+{
+   op_mask_span_funcs[SP][SM_N][SC_N][DP][CPU_AVX2] = _op_mask_p_dp_avx2;
+   op_mask_span_funcs[SP_AS][SM_N][SC_N][DP][CPU_AVX2] = _op_mask_pas_dp_avx2;
+
+   op_mask_span_funcs[SP][SM_N][SC_N][DP_AN][CPU_AVX2] = _op_mask_p_dpan_avx2;
+   op_mask_span_funcs[SP_AS][SM_N][SC_N][DP_AN][CPU_AVX2] = _op_mask_pas_dpan_avx2;
+}
+
+#endif
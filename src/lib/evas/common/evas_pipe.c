@@ -3,17 +3,29 @@
 
 #ifdef BUILD_PIPE_RENDER
 
+/* ops are binned into square tiles of this size when the pipe is flushed */
+#define PIPE_TILE_SIZE 64
+
 typedef struct _Thinfo
 {
    RGBA_Image            *im;
    int                    thread_num;
    Eina_Thread            thread_id;
    Eina_Barrier          *barrier;
-   const Eina_Inlist     *tasks;
+   Eina_Spinlock          queue_lock;
+   unsigned int           queue_head, queue_tail;
+   RGBA_Pipe_Thread_Info  band; /* all ops go there when they can't be binned */
    Eina_Array             cutout_trash;
    Eina_Array             rects_task;
 } Thinfo;
 
+typedef struct _Pipe_Tile
+{
+   RGBA_Pipe_Thread_Info  info;
+   unsigned int           start; /* first op of this tile in bins */
+   unsigned int           count;
+} Pipe_Tile;
+
 static RGBA_Pipe *evas_common_pipe_add(RGBA_Pipe *pipe, RGBA_Pipe_Op **op);
 static void evas_common_pipe_draw_context_copy(RGBA_Draw_Context *dc, RGBA_Pipe_Op *op);
 static void evas_common_pipe_op_free(RGBA_Pipe_Op *op);
@@ -69,58 +81,94 @@ evas_common_pipe_op_free(RGBA_Pipe_Op *op)
    evas_common_draw_context_apply_clean_cutouts(&op->context.cutout);
 }
 
+static Eina_List *im_task = NULL;
+static Eina_List *text_task = NULL;
+static Thinfo task_thinfo[TH_MAX];
+static Eina_Barrier task_thbarrier[2];
+static LK(im_task_mutex);
+static LK(text_task_mutex);
+
+static int               thread_num = 0;
+static Thinfo            thinfo[TH_MAX];
+static Eina_Barrier      thbarrier[2];
+
+static Pipe_Tile           *tiles = NULL;
+static unsigned int         tiles_size = 0;
+static const RGBA_Pipe_Op **bins = NULL;
+static unsigned int         bins_size = 0;
+
 /* main api calls */
+static const Pipe_Tile *
+evas_common_pipe_tile_next(Thinfo *th)
+{
+   const Pipe_Tile *tile = NULL;
+   int i;
+
+   /* our own tiles first, from the front so we stay next to the last one */
+   eina_spinlock_take(&(th->queue_lock));
+   if (th->queue_head < th->queue_tail)
+     tile = &(tiles[th->queue_head++]);
+   eina_spinlock_release(&(th->queue_lock));
+   if (tile) return tile;
+
+   /* then steal from the back of the other threads */
+   for (i = 1; i < thread_num; i++)
+     {
+        Thinfo *victim = &(thinfo[(th->thread_num + i) % thread_num]);
+
+        eina_spinlock_take(&(victim->queue_lock));
+        if (victim->queue_head < victim->queue_tail)
+          tile = &(tiles[--victim->queue_tail]);
+        eina_spinlock_release(&(victim->queue_lock));
+        if (tile) return tile;
+     }
+
+   return NULL;
+}
+
 static void *
 evas_common_pipe_thread(void *data, Eina_Thread t EINA_UNUSED)
 {
-   Thinfo *thinfo;
+   Thinfo *th;
 
 // INF("TH [...........");
-   thinfo = data;
+   th = data;
    for (;;)
      {
-        const RGBA_Pipe_Thread_Info *info;
-        RGBA_Pipe *p;
+        const Pipe_Tile *tile;
 
         /* wait for start signal */
-// INF(" TH %i START...", thinfo->thread_num);
-        eina_barrier_wait(&(thinfo->barrier[0]));
+// INF(" TH %i START...", th->thread_num);
+        eina_barrier_wait(&(th->barrier[0]));
+
+        if (th->band.area.h > 0)
+          {
+             RGBA_Pipe *p;
+             int i;
+
+             for (p = th->im->cache_entry.pipe; p; p = (RGBA_Pipe *)(EINA_INLIST_GET(p))->next)
+               for (i = 0; i < p->op_num; i++)
+                 if (p->op[i].render && p->op[i].op_func)
+                   p->op[i].op_func(th->im, &(p->op[i]), &(th->band));
+          }
 
-        EINA_INLIST_FOREACH(thinfo->tasks, info)
+        while ((tile = evas_common_pipe_tile_next(th)))
           {
-             EINA_INLIST_FOREACH(EINA_INLIST_GET(thinfo->im->cache_entry.pipe), p)
+             unsigned int i;
+
+             for (i = 0; i < tile->count; i++)
                {
-                  int i;
+                  const RGBA_Pipe_Op *op = bins[tile->start + i];
 
-                  for (i = 0; i < p->op_num; i++)
-                    {
-                       if (p->op[i].op_func && p->op[i].render)
-                         p->op[i].op_func(thinfo->im, &(p->op[i]), info);
-                    }
+                  op->op_func(th->im, op, &(tile->info));
                }
           }
 
-        thinfo->tasks = NULL;
-
-        eina_barrier_wait(&(thinfo->barrier[1]));
+        eina_barrier_wait(&(th->barrier[1]));
      }
    return NULL;
 }
 
-static Eina_List *im_task = NULL;
-static Eina_List *text_task = NULL;
-static Thinfo task_thinfo[TH_MAX];
-static Eina_Barrier task_thbarrier[2];
-static LK(im_task_mutex);
-static LK(text_task_mutex);
-
-static int               thread_num = 0;
-static Thinfo            thinfo[TH_MAX];
-static Eina_Barrier      thbarrier[2];
-
-static RGBA_Pipe_Thread_Info *buf = NULL;
-static unsigned int           buf_size = 0;
-
 static Cutout_Rects *
 evas_pipe_cutout_rects_pop(Thinfo *info)
 {
@@ -159,58 +207,6 @@ evas_pipe_prepare_push(RGBA_Pipe_Op *op)
    current++;
 }
 
-static void
-evas_common_pipe_begin(RGBA_Image *im)
-{
-#define SZ 128
-   unsigned int x, y, cpu;
-   RGBA_Pipe_Thread_Info *info;
-   unsigned int estimatex, estimatey;
-   unsigned int needed_size;
-
-   if (!im->cache_entry.pipe) return;
-   if (thread_num == 1) return;
-
-   if (im->cache_entry.w * im->cache_entry.h / thread_num < SZ * SZ)
-     {
-        estimatex = im->cache_entry.w;
-        estimatey = im->cache_entry.h / thread_num;
-        if (estimatey == 0) estimatey = 1;
-     }
-   else
-     {
-        estimatex = SZ;
-        estimatey = SZ;
-     }
-
-   needed_size = ((im->cache_entry.w / estimatex) + 1 ) * ((im->cache_entry.h /  estimatey) + 1);
-   if (buf_size < needed_size)
-     {
-        buf = realloc(buf, sizeof (RGBA_Pipe_Thread_Info) * needed_size);
-        buf_size = needed_size;
-     }
-
-   info = buf;
-   cpu = 0;
-   for (y = 0; y < im->cache_entry.h; y += estimatey)
-     for (x = 0; x < im->cache_entry.w; x += estimatex)
-       {
-          EINA_RECTANGLE_SET(&info->area, x, y,
-                             (x + estimatex > im->cache_entry.w) ? im->cache_entry.w - x : estimatex,
-                             (y + estimatey > im->cache_entry.h) ? im->cache_entry.h - y : estimatey);
-
-	  thinfo[cpu].im = im;
-          thinfo[cpu].tasks = eina_inlist_prepend((void*) thinfo[cpu].tasks, EINA_INLIST_GET(info));
-          cpu++;
-          if (cpu >= (unsigned int) thread_num) cpu = 0;
-
-          info++;
-       }
-
-   /* tell worker threads to start */
-   eina_barrier_wait(&(thbarrier[0]));
-}
-
 EAPI void
 evas_common_pipe_flush(RGBA_Image *im)
 {
@@ -474,11 +470,7 @@ evas_common_pipe_text_draw(RGBA_Image *dst, RGBA_Draw_Context *dc,
 static void
 evas_common_pipe_op_image_free(RGBA_Pipe_Op *op)
 {
-   op->op.image.src->ref--;
-   if (op->op.image.src->ref == 0)
-     {
-        evas_cache_image_drop(&op->op.image.src->cache_entry);
-     }
+   evas_cache_image_drop(&op->op.image.src->cache_entry);
    evas_common_pipe_op_free(op);
 }
 
@@ -577,7 +569,7 @@ evas_common_pipe_image_draw(RGBA_Image *src, RGBA_Image *dst,
    op->op.image.dy = dst_region_y;
    op->op.image.dw = dst_region_w;
    op->op.image.dh = dst_region_h;
-   src->ref++;
+   evas_cache_image_ref(&src->cache_entry);
    op->op.image.src = src;
    op->op_func = evas_common_pipe_image_draw_do;
    op->free_func = evas_common_pipe_op_image_free;
@@ -591,9 +583,7 @@ evas_common_pipe_image_draw(RGBA_Image *src, RGBA_Image *dst,
 static void
 evas_common_pipe_op_map_free(RGBA_Pipe_Op *op)
 {
-   op->op.map.src->ref--;
-   if (op->op.map.src->ref == 0)
-     evas_cache_image_drop(&op->op.map.src->cache_entry);
+   evas_cache_image_drop(&op->op.map.src->cache_entry);
    /* free(op->op.map.p); */
    evas_common_pipe_op_free(op);
 }
@@ -644,7 +634,7 @@ evas_common_pipe_map_draw(RGBA_Image *src, RGBA_Image *dst,
 
    op->op.map.smooth = smooth;
    op->op.map.level = level;
-   src->ref++;
+   evas_cache_image_ref(&src->cache_entry);
    op->op.map.src = src;
    op->op.map.m = m;
    op->op_func = evas_common_pipe_map_draw_do;
@@ -656,6 +646,221 @@ evas_common_pipe_map_draw(RGBA_Image *src, RGBA_Image *dst,
    evas_common_pipe_image_load(src);
 }
 
+/**************** TILES *****************/
+static Eina_Bool
+evas_common_pipe_op_tiles(const RGBA_Image *im, const RGBA_Pipe_Op *op, Eina_Rectangle *tr)
+{
+   int x, y, w, h;
+
+   /* the area an op may touch, it only has to be large enough as every
+    * tile clips the op again when drawing it */
+   if (op->op_func == evas_common_pipe_rectangle_draw_do)
+     {
+        x = op->op.rect.x;
+        y = op->op.rect.y;
+        w = op->op.rect.w;
+        h = op->op.rect.h;
+     }
+   else if (op->op_func == evas_common_pipe_image_draw_do)
+     {
+        x = op->op.image.dx;
+        y = op->op.image.dy;
+        w = op->op.image.dw;
+        h = op->op.image.dh;
+     }
+   else if (op->op_func == evas_common_pipe_line_draw_do)
+     {
+        x = MIN(op->op.line.x0, op->op.line.x1) - 1;
+        y = MIN(op->op.line.y0, op->op.line.y1) - 1;
+        w = abs(op->op.line.x1 - op->op.line.x0) + 3;
+        h = abs(op->op.line.y1 - op->op.line.y0) + 3;
+     }
+   else if ((op->op_func == evas_common_pipe_poly_draw_do) &&
+            (op->op.poly.points))
+     {
+        const RGBA_Polygon_Point *pt;
+        int x1, y1;
+
+        x = x1 = op->op.poly.points->x;
+        y = y1 = op->op.poly.points->y;
+        EINA_INLIST_FOREACH(EINA_INLIST_GET(op->op.poly.points), pt)
+          {
+             if (pt->x < x) x = pt->x;
+             if (pt->y < y) y = pt->y;
+             if (pt->x > x1) x1 = pt->x;
+             if (pt->y > y1) y1 = pt->y;
+          }
+        x += op->op.poly.x - 1;
+        y += op->op.poly.y - 1;
+        w = x1 + op->op.poly.x + 2 - x;
+        h = y1 + op->op.poly.y + 2 - y;
+     }
+   else if ((op->op_func == evas_common_pipe_map_draw_do) &&
+            (op->op.map.m->count > 0))
+     {
+        const RGBA_Map *m = op->op.map.m;
+        int i, x1, y1;
+
+        x = x1 = m->pts[0].x >> FP;
+        y = y1 = m->pts[0].y >> FP;
+        for (i = 1; i < m->count; i++)
+          {
+             if ((m->pts[i].x >> FP) < x) x = m->pts[i].x >> FP;
+             if ((m->pts[i].y >> FP) < y) y = m->pts[i].y >> FP;
+             if ((m->pts[i].x >> FP) > x1) x1 = m->pts[i].x >> FP;
+             if ((m->pts[i].y >> FP) > y1) y1 = m->pts[i].y >> FP;
+          }
+        x -= 1;
+        y -= 1;
+        w = x1 + 3 - x;
+        h = y1 + 3 - y;
+     }
+   else
+     {
+        /* text: the glyphs are not known yet, rely on the clip */
+        x = 0;
+        y = 0;
+        w = im->cache_entry.w;
+        h = im->cache_entry.h;
+     }
+
+   if (op->context.clip.use)
+     RECTS_CLIP_TO_RECT(x, y, w, h,
+                        op->context.clip.x, op->context.clip.y,
+                        op->context.clip.w, op->context.clip.h);
+   RECTS_CLIP_TO_RECT(x, y, w, h, 0, 0, im->cache_entry.w, im->cache_entry.h);
+   if ((w <= 0) || (h <= 0)) return EINA_FALSE;
+
+   EINA_RECTANGLE_SET(tr, x / PIPE_TILE_SIZE, y / PIPE_TILE_SIZE,
+                      ((x + w - 1) / PIPE_TILE_SIZE) - (x / PIPE_TILE_SIZE) + 1,
+                      ((y + h - 1) / PIPE_TILE_SIZE) - (y / PIPE_TILE_SIZE) + 1);
+   return EINA_TRUE;
+}
+
+static void
+evas_common_pipe_begin(RGBA_Image *im)
+{
+   RGBA_Pipe *p;
+   Pipe_Tile *tile;
+   Eina_Rectangle tr;
+   unsigned int tiles_w, tiles_h, needed_size, total;
+   int x, y, i, cpu;
+
+   if (!im->cache_entry.pipe) return;
+   if (thread_num == 1) return;
+
+   tiles_w = (im->cache_entry.w + PIPE_TILE_SIZE - 1) / PIPE_TILE_SIZE;
+   tiles_h = (im->cache_entry.h + PIPE_TILE_SIZE - 1) / PIPE_TILE_SIZE;
+   needed_size = tiles_w * tiles_h;
+   if (tiles_size < needed_size)
+     {
+        tile = realloc(tiles, sizeof (Pipe_Tile) * needed_size);
+        if (!tile)
+          {
+             ERR("Not enough memory for %u pipe tiles.", needed_size);
+             goto untiled;
+          }
+        tiles = tile;
+        tiles_size = needed_size;
+     }
+
+   tile = tiles;
+   for (y = 0; y < (int)tiles_h; y++)
+     for (x = 0; x < (int)tiles_w; x++)
+       {
+          EINA_RECTANGLE_SET(&tile->info.area,
+                             x * PIPE_TILE_SIZE, y * PIPE_TILE_SIZE,
+                             MIN(PIPE_TILE_SIZE, (int)im->cache_entry.w - x * PIPE_TILE_SIZE),
+                             MIN(PIPE_TILE_SIZE, (int)im->cache_entry.h - y * PIPE_TILE_SIZE));
+          tile->start = 0;
+          tile->count = 0;
+          tile++;
+       }
+
+   /* bin every op into the tiles it overlaps, once for all threads */
+   total = 0;
+   for (p = im->cache_entry.pipe; p; p = (RGBA_Pipe *)(EINA_INLIST_GET(p))->next)
+     for (i = 0; i < p->op_num; i++)
+       {
+          if ((!p->op[i].op_func) || (!p->op[i].render)) continue;
+          if (!evas_common_pipe_op_tiles(im, &(p->op[i]), &tr)) continue;
+
+          for (y = tr.y; y < tr.y + tr.h; y++)
+            for (x = tr.x; x < tr.x + tr.w; x++)
+              tiles[y * tiles_w + x].count++;
+          total += tr.w * tr.h;
+       }
+
+   if (bins_size < total)
+     {
+        const RGBA_Pipe_Op **tmp;
+
+        tmp = realloc(bins, sizeof (RGBA_Pipe_Op *) * total);
+        if (!tmp)
+          {
+             ERR("Not enough memory to bin %u pipe ops.", total);
+             goto untiled;
+          }
+        bins = tmp;
+        bins_size = total;
+     }
+
+   if (total)
+     {
+        unsigned int start = 0;
+
+        for (tile = tiles; tile < tiles + needed_size; tile++)
+          {
+             tile->start = start;
+             start += tile->count;
+             tile->count = 0;
+          }
+
+        /* ops keep their pipe order inside each tile */
+        for (p = im->cache_entry.pipe; p; p = (RGBA_Pipe *)(EINA_INLIST_GET(p))->next)
+          for (i = 0; i < p->op_num; i++)
+            {
+               if ((!p->op[i].op_func) || (!p->op[i].render)) continue;
+               if (!evas_common_pipe_op_tiles(im, &(p->op[i]), &tr)) continue;
+
+               for (y = tr.y; y < tr.y + tr.h; y++)
+                 for (x = tr.x; x < tr.x + tr.w; x++)
+                   {
+                      tile = &(tiles[y * tiles_w + x]);
+                      bins[tile->start + tile->count++] = &(p->op[i]);
+                   }
+            }
+     }
+
+   /* every thread starts on its own run of neighbouring tiles and steals
+    * from the others once done */
+   for (cpu = 0; cpu < thread_num; cpu++)
+     {
+        thinfo[cpu].im = im;
+        thinfo[cpu].queue_head = (needed_size * cpu) / thread_num;
+        thinfo[cpu].queue_tail = (needed_size * (cpu + 1)) / thread_num;
+        thinfo[cpu].band.area.h = 0;
+     }
+
+   /* tell worker threads to start */
+   eina_barrier_wait(&(thbarrier[0]));
+   return;
+
+ untiled:
+   /* every thread runs all the ops over its own band of the image */
+   for (cpu = 0; cpu < thread_num; cpu++)
+     {
+        y = (im->cache_entry.h * cpu) / thread_num;
+        thinfo[cpu].im = im;
+        thinfo[cpu].queue_head = 0;
+        thinfo[cpu].queue_tail = 0;
+        EINA_RECTANGLE_SET(&(thinfo[cpu].band.area), 0, y, im->cache_entry.w,
+                           ((im->cache_entry.h * (cpu + 1)) / thread_num) - y);
+     }
+
+   eina_barrier_wait(&(thbarrier[0]));
+}
+
 static void
 evas_common_pipe_map_render(RGBA_Image *root)
 {
@@ -852,6 +1057,10 @@ evas_common_pipe_init(void)
 
 	cpunum = eina_cpu_count();
 	thread_num = cpunum;
+        if (getenv("EVAS_PIPE_THREADS"))
+          thread_num = atoi(getenv("EVAS_PIPE_THREADS"));
+        if (thread_num < 1) thread_num = 1;
+        else if (thread_num > TH_MAX) thread_num = TH_MAX;
 // on  single cpu we still want this initted.. otherwise we block forever
 // waiting onm pthread barriers for async rendering on a single core!
 //	if (thread_num == 1) return EINA_FALSE;
@@ -866,7 +1075,7 @@ evas_common_pipe_init(void)
 	for (i = 0; i < thread_num; i++)
 	  {
 	     thinfo[i].thread_num = i;
-	     thinfo[i].tasks = NULL;
+             eina_spinlock_new(&(thinfo[i].queue_lock));
 	     thinfo[i].barrier = thbarrier;
 
              eina_thread_create(&(thinfo[i].thread_id), EINA_THREAD_NORMAL, i,
@@ -878,7 +1087,6 @@ evas_common_pipe_init(void)
 	for (i = 0; i < thread_num; i++)
 	  {
 	     task_thinfo[i].thread_num = i;
-	     task_thinfo[i].tasks = NULL;
 	     task_thinfo[i].barrier = task_thbarrier;
              eina_array_step_set(&task_thinfo[i].cutout_trash, sizeof (Eina_Array), 8);
              eina_array_step_set(&task_thinfo[i].rects_task, sizeof (Eina_Array), 8);
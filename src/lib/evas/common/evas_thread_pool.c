@@ -0,0 +1,224 @@
+#include "evas_common_private.h"
+
+/* A small fork/join pool: evas_thread_pool_run() hands out the indexes of a
+ * job to the workers and the calling thread, and returns once they are all
+ * done. Workers are only started the first time a job needs them. */
+
+#define POOL_MAX 32
+
+static Eina_Thread evas_thread_pool_workers[POOL_MAX];
+static unsigned int evas_thread_pool_started = 0;
+static unsigned int evas_thread_pool_max = 0;
+
+static Eina_Lock evas_thread_pool_run_lock;
+static Eina_Lock evas_thread_pool_lock;
+static Eina_Condition evas_thread_pool_wake;
+static Eina_Condition evas_thread_pool_done;
+static Eina_Spinlock evas_thread_pool_index_lock;
+
+/* The job being run, protected by evas_thread_pool_lock */
+static Evas_Thread_Pool_Cb evas_thread_pool_cb = NULL;
+static void *evas_thread_pool_data = NULL;
+static unsigned int evas_thread_pool_count = 0;
+static unsigned int evas_thread_pool_next = 0;
+static unsigned int evas_thread_pool_generation = 0;
+static unsigned int evas_thread_pool_busy = 0;
+static Eina_Bool evas_thread_pool_exit = EINA_FALSE;
+
+static int init_count = 0;
+
+static void
+evas_thread_pool_indexes_run(Evas_Thread_Pool_Cb cb, void *data,
+                             unsigned int count)
+{
+   while (1)
+     {
+        unsigned int idx;
+
+        eina_spinlock_take(&evas_thread_pool_index_lock);
+        idx = evas_thread_pool_next++;
+        eina_spinlock_release(&evas_thread_pool_index_lock);
+
+        if (idx >= count) break;
+        cb(data, idx);
+     }
+}
+
+static void *
+evas_thread_pool_worker_func(void *data, Eina_Thread thread EINA_UNUSED)
+{
+   unsigned int worker = (unsigned int)(uintptr_t)data;
+   unsigned int generation = 0;
+
+   eina_lock_take(&evas_thread_pool_lock);
+   while (1)
+     {
+        Evas_Thread_Pool_Cb cb;
+        void *cb_data;
+        unsigned int count;
+
+        while ((generation == evas_thread_pool_generation) &&
+               !evas_thread_pool_exit)
+          eina_condition_wait(&evas_thread_pool_wake);
+        if (evas_thread_pool_exit) break;
+
+        generation = evas_thread_pool_generation;
+        /* Woke up too late, the job is already done, or the pool was
+         * made smaller than this. */
+        if (!evas_thread_pool_cb || (worker + 1 >= evas_thread_pool_max))
+          continue;
+
+        cb = evas_thread_pool_cb;
+        cb_data = evas_thread_pool_data;
+        count = evas_thread_pool_count;
+        evas_thread_pool_busy++;
+        eina_lock_release(&evas_thread_pool_lock);
+
+        evas_thread_pool_indexes_run(cb, cb_data, count);
+
+        eina_lock_take(&evas_thread_pool_lock);
+        if (--evas_thread_pool_busy == 0)
+          eina_condition_broadcast(&evas_thread_pool_done);
+     }
+   eina_lock_release(&evas_thread_pool_lock);
+
+   return NULL;
+}
+
+static void
+evas_thread_pool_workers_start(void)
+{
+   while (evas_thread_pool_started + 1 < evas_thread_pool_max)
+     {
+        if (!eina_thread_create(&evas_thread_pool_workers[evas_thread_pool_started],
+                                EINA_THREAD_NORMAL, -1,
+                                evas_thread_pool_worker_func,
+                                (void *)(uintptr_t)evas_thread_pool_started))
+          {
+             ERR("Could not create pool thread, running with %u.",
+                 evas_thread_pool_started + 1);
+             evas_thread_pool_max = evas_thread_pool_started + 1;
+             break;
+          }
+        evas_thread_pool_started++;
+     }
+}
+
+EAPI unsigned int
+evas_thread_pool_threads_get(void)
+{
+   return evas_thread_pool_max;
+}
+
+EAPI void
+evas_thread_pool_threads_set(unsigned int threads)
+{
+   if (threads < 1) threads = 1;
+   else if (threads > POOL_MAX) threads = POOL_MAX;
+
+   /* Not while a job is running */
+   eina_lock_take(&evas_thread_pool_run_lock);
+   eina_lock_take(&evas_thread_pool_lock);
+   evas_thread_pool_max = threads;
+   eina_lock_release(&evas_thread_pool_lock);
+   eina_lock_release(&evas_thread_pool_run_lock);
+}
+
+EAPI void
+evas_thread_pool_run(Evas_Thread_Pool_Cb cb, void *data, unsigned int count)
+{
+   if (!count) return;
+
+   /* Nothing to share, or the pool is already running a job for another
+    * thread: do it all here rather than wait. */
+   if ((count == 1) || (evas_thread_pool_max < 2) ||
+       (eina_lock_take_try(&evas_thread_pool_run_lock) != EINA_LOCK_SUCCEED))
+     {
+        unsigned int i;
+
+        for (i = 0; i < count; i++)
+          cb(data, i);
+        return;
+     }
+
+   evas_thread_pool_workers_start();
+
+   eina_lock_take(&evas_thread_pool_lock);
+   evas_thread_pool_cb = cb;
+   evas_thread_pool_data = data;
+   evas_thread_pool_count = count;
+   evas_thread_pool_next = 0;
+   evas_thread_pool_generation++;
+   eina_condition_broadcast(&evas_thread_pool_wake);
+   eina_lock_release(&evas_thread_pool_lock);
+
+   evas_thread_pool_indexes_run(cb, data, count);
+
+   /* Wait for the workers that picked the job up; the ones that didn't
+    * will find no index left when they do. */
+   eina_lock_take(&evas_thread_pool_lock);
+   while (evas_thread_pool_busy)
+     eina_condition_wait(&evas_thread_pool_done);
+   evas_thread_pool_cb = NULL;
+   evas_thread_pool_data = NULL;
+   evas_thread_pool_count = 0;
+   eina_lock_release(&evas_thread_pool_lock);
+
+   eina_lock_release(&evas_thread_pool_run_lock);
+}
+
+EAPI void
+evas_thread_pool_init(void)
+{
+   const char *env;
+   int max;
+
+   if (init_count++) return;
+
+   eina_threads_init();
+
+   max = eina_cpu_count();
+   env = getenv("EVAS_POOL_THREADS");
+   if (env) max = atoi(env);
+   if (max < 1) max = 1;
+   else if (max > POOL_MAX) max = POOL_MAX;
+   evas_thread_pool_max = max;
+
+   evas_thread_pool_exit = EINA_FALSE;
+   evas_thread_pool_started = 0;
+
+   if (!eina_lock_new(&evas_thread_pool_run_lock) ||
+       !eina_lock_new(&evas_thread_pool_lock) ||
+       !eina_condition_new(&evas_thread_pool_wake, &evas_thread_pool_lock) ||
+       !eina_condition_new(&evas_thread_pool_done, &evas_thread_pool_lock) ||
+       !eina_spinlock_new(&evas_thread_pool_index_lock))
+     {
+        CRI("Could not create the thread pool locks");
+        evas_thread_pool_max = 1;
+     }
+}
+
+EAPI void
+evas_thread_pool_shutdown(void)
+{
+   unsigned int i;
+
+   if (--init_count) return;
+
+   eina_lock_take(&evas_thread_pool_lock);
+   evas_thread_pool_exit = EINA_TRUE;
+   eina_condition_broadcast(&evas_thread_pool_wake);
+   eina_lock_release(&evas_thread_pool_lock);
+
+   for (i = 0; i < evas_thread_pool_started; i++)
+     eina_thread_join(evas_thread_pool_workers[i]);
+   evas_thread_pool_started = 0;
+
+   eina_spinlock_free(&evas_thread_pool_index_lock);
+   eina_condition_free(&evas_thread_pool_done);
+   eina_condition_free(&evas_thread_pool_wake);
+   eina_lock_free(&evas_thread_pool_lock);
+   eina_lock_free(&evas_thread_pool_run_lock);
+
+   eina_threads_shutdown();
+}
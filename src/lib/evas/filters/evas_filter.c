@@ -1690,25 +1690,116 @@ _filter_command_run(Evas_Filter_Command *cmd)
    return func(cmd);
 }
 
+/* Consecutive commands that do not share any buffer they write to can run
+ * at the same time. Only the small ones are put together like that, big
+ * ones are already split into bands over the thread pool by themselves. */
+#define FILTER_WAVE_MAX 8
+
+typedef struct _Filter_Wave Filter_Wave;
+struct _Filter_Wave
+{
+   Evas_Filter_Command *cmds[FILTER_WAVE_MAX];
+   Eina_Bool ok[FILTER_WAVE_MAX];
+   unsigned int count;
+};
+
+static Eina_Bool
+_filter_buffer_same(const Evas_Filter_Buffer *a, const Evas_Filter_Buffer *b)
+{
+   if (!a || !b) return EINA_FALSE;
+   return (a == b) || (a->backing && (a->backing == b->backing));
+}
+
+static Eina_Bool
+_filter_command_concurrent(const Evas_Filter_Command *cmd)
+{
+   if (!cmd->input || !cmd->output) return EINA_FALSE;
+
+   // Others draw through the engine or allocate buffers while running
+   if ((cmd->mode != EVAS_FILTER_MODE_BLUR) &&
+       (cmd->mode != EVAS_FILTER_MODE_CURVE))
+     return EINA_FALSE;
+
+   return (cmd->output->w * cmd->output->h) < EVAS_FILTER_BAND_PIXELS_MIN;
+}
+
+static Eina_Bool
+_filter_wave_accepts(const Filter_Wave *wave, const Evas_Filter_Command *cmd)
+{
+   unsigned int i;
+
+   if (wave->count >= FILTER_WAVE_MAX) return EINA_FALSE;
+   if (!_filter_command_concurrent(cmd)) return EINA_FALSE;
+
+   for (i = 0; i < wave->count; i++)
+     {
+        const Evas_Filter_Command *prev = wave->cmds[i];
+
+        if (!_filter_command_concurrent(prev)) return EINA_FALSE;
+        if (_filter_buffer_same(prev->output, cmd->output) ||
+            _filter_buffer_same(prev->output, cmd->input) ||
+            _filter_buffer_same(prev->output, cmd->mask) ||
+            _filter_buffer_same(cmd->output, prev->input) ||
+            _filter_buffer_same(cmd->output, prev->mask))
+          return EINA_FALSE;
+     }
+
+   return EINA_TRUE;
+}
+
+static void
+_filter_wave_cb(void *data, unsigned int idx)
+{
+   Filter_Wave *wave = data;
+
+   wave->ok[idx] = _filter_command_run(wave->cmds[idx]);
+}
+
+static Eina_Bool
+_filter_wave_run(Filter_Wave *wave)
+{
+   unsigned int i, count = wave->count;
+
+   wave->count = 0;
+   if (count == 1)
+     return _filter_command_run(wave->cmds[0]);
+
+   evas_thread_pool_run(_filter_wave_cb, wave, count);
+   for (i = 0; i < count; i++)
+     if (!wave->ok[i]) return EINA_FALSE;
+
+   return EINA_TRUE;
+}
+
 static Eina_Bool
 _filter_chain_run(Evas_Filter_Context *ctx)
 {
    Evas_Filter_Command *cmd;
+   Filter_Wave wave;
    Eina_Bool ok = EINA_FALSE;
    void *buffer;
 
    ctx->running = EINA_TRUE;
+   wave.count = 0;
    EINA_INLIST_FOREACH(ctx->commands, cmd)
      {
-        ok = _filter_command_run(cmd);
-        if (!ok)
+        if (wave.count &&
+            (ctx->gl_engine || !_filter_wave_accepts(&wave, cmd)))
           {
-             ERR("Filter processing failed!");
-             goto end;
+             ok = _filter_wave_run(&wave);
+             if (!ok) goto fail;
           }
+        wave.cmds[wave.count++] = cmd;
      }
 
+   ok = _filter_wave_run(&wave);
+   if (!ok) goto fail;
+
    ok = _filter_target_render(ctx);
+   goto end;
+
+fail:
+   ERR("Filter processing failed!");
 
 end:
    ctx->running = EINA_FALSE;
@@ -60,6 +60,135 @@ _smallest_pow2_larger_than(int val)
 # define DEBUG_TIME_END() do {} while(0)
 #endif
 
+/* Big buffers are blurred in bands of rows (horizontal passes) or of
+ * columns (vertical passes), spread over the evas thread pool. */
+#define BLUR_BANDS_PER_THREAD 4
+
+typedef void (*Blur_Func_Rgba)(DATA32 *src, DATA32 *dst, int radius, int w, int h, int stride);
+typedef void (*Blur_Func_Alpha)(DATA8 *src, DATA8 *dst, int radius, int w, int h, int stride);
+
+typedef struct _Blur_Bands Blur_Bands;
+struct _Blur_Bands
+{
+   Blur_Func_Rgba func_rgba;
+   Blur_Func_Alpha func_alpha;
+   void *src, *dst;
+   int radius, w, h;
+   unsigned int count;
+   Eina_Bool vert : 1;
+};
+
+static void
+_blur_band_cb(void *data, unsigned int idx)
+{
+   Blur_Bands *b = data;
+   int len = b->vert ? b->w : b->h;
+   int start = ((long long) len * idx) / b->count;
+   int end = ((long long) len * (idx + 1)) / b->count;
+   int offset = b->vert ? start : start * b->w;
+   int w = b->vert ? end - start : b->w;
+   int h = b->vert ? b->h : end - start;
+
+   if (end <= start) return;
+
+   if (b->func_rgba)
+     b->func_rgba((DATA32 *) b->src + offset, (DATA32 *) b->dst + offset,
+                  b->radius, w, h, b->w);
+   else
+     b->func_alpha((DATA8 *) b->src + offset, (DATA8 *) b->dst + offset,
+                   b->radius, w, h, b->w);
+}
+
+static void
+_blur_bands_run(Blur_Func_Rgba func_rgba, Blur_Func_Alpha func_alpha,
+                void *src, void *dst, int radius, int w, int h, Eina_Bool vert)
+{
+   Blur_Bands b;
+   unsigned int threads = evas_thread_pool_threads_get();
+   unsigned int len = vert ? w : h;
+
+   b.func_rgba = func_rgba;
+   b.func_alpha = func_alpha;
+   b.src = src;
+   b.dst = dst;
+   b.radius = radius;
+   b.w = w;
+   b.h = h;
+   b.vert = vert;
+   b.count = 1;
+   if ((threads > 1) && ((w * h) >= EVAS_FILTER_BAND_PIXELS_MIN))
+     b.count = MIN(threads * BLUR_BANDS_PER_THREAD, len);
+
+   evas_thread_pool_run(_blur_band_cb, &b, b.count);
+}
+
+/* SIMD versions of the inner loops, when the cpu has them. Both work on
+ * bytes side by side: the channels of neighbouring pixels or neighbouring
+ * columns, and give the same results as the C code. */
+
+static int
+_box_blur_lanes_simd(DATA8 *src, DATA8 *dst, int radius, int len, int count,
+                     int step)
+{
+#if DIV_USING_BITSHIFT
+   DEFINE_DIAMETER(radius);
+
+   // The sums are kept on 16 bits
+   if ((len < (2 * radius + 1)) || (radius > 128)) return 0;
+
+# ifdef BUILD_AVX2
+   if (evas_common_cpu_has_feature(CPU_FEATURE_AVX2))
+     return evas_filter_blur_box_lanes_avx2(src, dst, radius, len, count,
+                                            step, numerator, pow2);
+# endif
+# ifdef BUILD_SSE3
+   if (evas_common_cpu_has_feature(CPU_FEATURE_SSE3))
+     return evas_filter_blur_box_lanes_sse3(src, dst, radius, len, count,
+                                            step, numerator, pow2);
+# endif
+# ifdef BUILD_NEON
+   if (evas_common_cpu_has_feature(CPU_FEATURE_NEON))
+     return evas_filter_blur_box_lanes_neon(src, dst, radius, len, count,
+                                            step, numerator, pow2);
+# endif
+#else
+   (void) src; (void) dst; (void) radius; (void) len; (void) count; (void) step;
+#endif
+   return 0;
+}
+
+static int
+_gaussian_blur_span_simd(DATA8 *src, DATA8 *dst, int count, int step,
+                         int diameter, int *weights, int pow2_divider)
+{
+   int k;
+
+   // The weights are multiplied on 16 bits
+   for (k = 0; k < diameter; k++)
+     if ((weights[k] < 0) || (weights[k] > 32767)) return 0;
+
+#ifdef BUILD_AVX2
+   if (evas_common_cpu_has_feature(CPU_FEATURE_AVX2))
+     return evas_filter_blur_gaussian_span_avx2(src, dst, count, step,
+                                                diameter, weights,
+                                                pow2_divider);
+#endif
+#ifdef BUILD_SSE3
+   if (evas_common_cpu_has_feature(CPU_FEATURE_SSE3))
+     return evas_filter_blur_gaussian_span_sse3(src, dst, count, step,
+                                                diameter, weights,
+                                                pow2_divider);
+#endif
+#ifdef BUILD_NEON
+   if (evas_common_cpu_has_feature(CPU_FEATURE_NEON))
+     return evas_filter_blur_gaussian_span_neon(src, dst, count, step,
+                                                diameter, weights,
+                                                pow2_divider);
+#endif
+   (void) src; (void) dst; (void) step; (void) pow2_divider;
+   return 0;
+}
+
 /* RGBA functions */
 
 static void
@@ -135,7 +264,7 @@ _box_blur_step_rgba(DATA32 *src, DATA32 *dst, int radius, int len, int step)
 }
 
 static void
-_box_blur_horiz_rgba(DATA32 *src, DATA32 *dst, int radius, int w, int h)
+_box_blur_horiz_rgba(DATA32 *src, DATA32 *dst, int radius, int w, int h, int stride)
 {
    int y;
    int step = sizeof(DATA32);
@@ -145,22 +274,27 @@ _box_blur_horiz_rgba(DATA32 *src, DATA32 *dst, int radius, int w, int h)
    for (y = 0; y < h; y++)
      {
         _box_blur_step_rgba(src, dst, radius, w, step);
-        src += w;
-        dst += w;
+        src += stride;
+        dst += stride;
      }
 
    DEBUG_TIME_END();
 }
 
 static void
-_box_blur_vert_rgba(DATA32 *src, DATA32 *dst, int radius, int w, int h)
+_box_blur_vert_rgba(DATA32 *src, DATA32 *dst, int radius, int w, int h, int stride)
 {
    int x;
-   int step = w * sizeof(DATA32);
+   int step = stride * sizeof(DATA32);
 
    DEBUG_TIME_BEGIN();
 
-   for (x = 0; x < w; x++)
+   x = _box_blur_lanes_simd((DATA8 *) src, (DATA8 *) dst, radius, h,
+                            w * sizeof(DATA32), step) / sizeof(DATA32);
+   src += x;
+   dst += x;
+
+   for (; x < w; x++)
      {
         _box_blur_step_rgba(src, dst, radius, h, step);
         src += 1;
@@ -188,8 +322,9 @@ _box_blur_horiz_apply_rgba(Evas_Filter_Command *cmd)
    EINA_SAFETY_ON_NULL_RETURN_VAL(out->image.data, EINA_FALSE);
    EINA_SAFETY_ON_FALSE_RETURN_VAL(out->cache_entry.w >= (2*r + 1), EINA_FALSE);
 
-   _box_blur_horiz_rgba(in->image.data, out->image.data, r,
-                        in->cache_entry.w, in->cache_entry.h);
+   _blur_bands_run(_box_blur_horiz_rgba, NULL,
+                   in->image.data, out->image.data, r,
+                   in->cache_entry.w, in->cache_entry.h, EINA_FALSE);
 
    return EINA_TRUE;
 }
@@ -212,8 +347,9 @@ _box_blur_vert_apply_rgba(Evas_Filter_Command *cmd)
    EINA_SAFETY_ON_NULL_RETURN_VAL(out->image.data, EINA_FALSE);
    EINA_SAFETY_ON_FALSE_RETURN_VAL(out->cache_entry.h >= (2*r + 1), EINA_FALSE);
 
-   _box_blur_vert_rgba(in->image.data, out->image.data, r,
-                       in->cache_entry.w, in->cache_entry.h);
+   _blur_bands_run(_box_blur_vert_rgba, NULL,
+                   in->image.data, out->image.data, r,
+                   in->cache_entry.w, in->cache_entry.h, EINA_TRUE);
 
    return EINA_TRUE;
 }
@@ -266,7 +402,7 @@ _box_blur_step_alpha(DATA8 *src, DATA8 *dst, int radius, int len, int step)
 }
 
 static void
-_box_blur_horiz_alpha(DATA8 *src, DATA8 *dst, int radius, int w, int h)
+_box_blur_horiz_alpha(DATA8 *src, DATA8 *dst, int radius, int w, int h, int stride)
 {
    int k;
 
@@ -275,23 +411,27 @@ _box_blur_horiz_alpha(DATA8 *src, DATA8 *dst, int radius, int w, int h)
    for (k = h; k; k--)
      {
         _box_blur_step_alpha(src, dst, radius, w, 1);
-        dst += w;
-        src += w;
+        dst += stride;
+        src += stride;
      }
 
    DEBUG_TIME_END();
 }
 
 static void
-_box_blur_vert_alpha(DATA8 *src, DATA8 *dst, int radius, int w, int h)
+_box_blur_vert_alpha(DATA8 *src, DATA8 *dst, int radius, int w, int h, int stride)
 {
    int k;
 
    DEBUG_TIME_BEGIN();
 
-   for (k = w; k; k--)
+   k = _box_blur_lanes_simd(src, dst, radius, h, w, stride);
+   src += k;
+   dst += k;
+
+   for (k = w - k; k; k--)
      {
-        _box_blur_step_alpha(src, dst, radius, h, w);
+        _box_blur_step_alpha(src, dst, radius, h, stride);
         dst += 1;
         src += 1;
      }
@@ -317,8 +457,9 @@ _box_blur_horiz_apply_alpha(Evas_Filter_Command *cmd)
    EINA_SAFETY_ON_NULL_RETURN_VAL(out->mask.data, EINA_FALSE);
    EINA_SAFETY_ON_FALSE_RETURN_VAL(out->cache_entry.w >= (2*r + 1), EINA_FALSE);
 
-   _box_blur_horiz_alpha(in->mask.data, out->mask.data, r,
-                         in->cache_entry.w, in->cache_entry.h);
+   _blur_bands_run(NULL, _box_blur_horiz_alpha,
+                   in->mask.data, out->mask.data, r,
+                   in->cache_entry.w, in->cache_entry.h, EINA_FALSE);
 
    return EINA_TRUE;
 }
@@ -341,8 +482,9 @@ _box_blur_vert_apply_alpha(Evas_Filter_Command *cmd)
    EINA_SAFETY_ON_NULL_RETURN_VAL(out->mask.data, EINA_FALSE);
    EINA_SAFETY_ON_FALSE_RETURN_VAL(out->cache_entry.h >= (2*r + 1), EINA_FALSE);
 
-   _box_blur_vert_alpha(in->mask.data, out->mask.data, r,
-                        in->cache_entry.w, in->cache_entry.h);
+   _blur_bands_run(NULL, _box_blur_vert_alpha,
+                   in->mask.data, out->mask.data, r,
+                   in->cache_entry.w, in->cache_entry.h, EINA_TRUE);
 
    return EINA_TRUE;
 }
@@ -432,14 +574,14 @@ _sin_blur_weights_get(int *weights, int *pow2_divider, int radius)
 }
 
 static void
-_gaussian_blur_step_alpha(DATA8 *src, DATA8 *dst, int radius, int len, int step,
-                          int *weights, int pow2_divider)
+_gaussian_blur_edges_alpha(DATA8 *src, DATA8 *dst, int radius, int len, int step,
+                           int *weights)
 {
    int j, k, acc, divider;
    DATA8 *s = src;
-   const int diameter = 2 * radius + 1;
    int left = MIN(radius, len);
    int right = MIN(radius, (len - radius));
+   int middle = MAX(0, len - (2 * radius));
 
    // left
    for (k = 0; k < left; k++, dst += step)
@@ -456,17 +598,9 @@ _gaussian_blur_step_alpha(DATA8 *src, DATA8 *dst, int radius, int len, int step,
         *dst = acc / divider;
      }
 
-   // middle
-   for (k = radius; k < (len - radius); k++, src += step, dst += step)
-     {
-        acc = 0;
-        s = src;
-        for (j = 0; j < diameter; j++, s += step)
-          acc += (*s) * weights[j];
-        *dst = acc >> pow2_divider;
-     }
-
    // right
+   src += middle * step;
+   dst += middle * step;
    for (k = 0; k < right; k++, dst += step, src += step)
      {
         acc = 0;
@@ -488,12 +622,48 @@ div_zero:
 }
 
 static void
-_gaussian_blur_step_rgba(DATA32 *src, DATA32 *dst, int radius, int len, int step,
-                         int *weights, int pow2_divider)
+_gaussian_blur_middle_alpha(DATA8 *src, DATA8 *dst, int count, int step,
+                            int diameter, int *weights, int pow2_divider)
+{
+   int j, k, acc;
+   DATA8 *s;
+
+   for (k = count; k > 0; k--, src += step, dst += step)
+     {
+        acc = 0;
+        s = src;
+        for (j = 0; j < diameter; j++, s += step)
+          acc += (*s) * weights[j];
+        *dst = acc >> pow2_divider;
+     }
+}
+
+static void
+_gaussian_blur_step_alpha(DATA8 *src, DATA8 *dst, int radius, int len, int step,
+                          int *weights, int pow2_divider)
 {
    const int diameter = 2 * radius + 1;
+   int count = len - (2 * radius);
+   int done = 0;
+
+   _gaussian_blur_edges_alpha(src, dst, radius, len, step, weights);
+   if (count <= 0) return;
+
+   dst += radius * step;
+   if (step == 1)
+     done = _gaussian_blur_span_simd(src, dst, count, 1, diameter, weights,
+                                     pow2_divider);
+   _gaussian_blur_middle_alpha(src + done, dst + done, count - done, step,
+                               diameter, weights, pow2_divider);
+}
+
+static void
+_gaussian_blur_edges_rgba(DATA32 *src, DATA32 *dst, int radius, int len, int step,
+                          int *weights)
+{
    int left = MIN(radius, len);
    int right = MIN(radius, (len - radius));
+   int middle = MAX(0, len - (2 * radius));
    int j, k;
 
    // left
@@ -518,25 +688,9 @@ _gaussian_blur_step_rgba(DATA32 *src, DATA32 *dst, int radius, int len, int step
         B_VAL(dst) = acc[BLUE]  / divider;
      }
 
-   // middle
-   for (k = len - (2 * radius); k > 0; k--, src += step, dst += step)
-     {
-        int acc[4] = {0};
-        DATA32 *s = src;
-        for (j = 0; j < diameter; j++, s += step)
-          {
-             acc[ALPHA] += A_VAL(s) * weights[j];
-             acc[RED]   += R_VAL(s) * weights[j];
-             acc[GREEN] += G_VAL(s) * weights[j];
-             acc[BLUE]  += B_VAL(s) * weights[j];
-          }
-        A_VAL(dst) = acc[ALPHA] >> pow2_divider;
-        R_VAL(dst) = acc[RED]   >> pow2_divider;
-        G_VAL(dst) = acc[GREEN] >> pow2_divider;
-        B_VAL(dst) = acc[BLUE]  >> pow2_divider;
-     }
-
    // right
+   src += middle * step;
+   dst += middle * step;
    for (k = 0; k < right; k++, dst += step, src += step)
      {
         int acc[4] = {0};
@@ -564,7 +718,73 @@ div_zero:
 }
 
 static void
-_gaussian_blur_horiz_alpha(DATA8 *src, DATA8 *dst, int radius, int w, int h)
+_gaussian_blur_middle_rgba(DATA32 *src, DATA32 *dst, int count, int step,
+                           int diameter, int *weights, int pow2_divider)
+{
+   int j, k;
+
+   for (k = count; k > 0; k--, src += step, dst += step)
+     {
+        int acc[4] = {0};
+        DATA32 *s = src;
+        for (j = 0; j < diameter; j++, s += step)
+          {
+             acc[ALPHA] += A_VAL(s) * weights[j];
+             acc[RED]   += R_VAL(s) * weights[j];
+             acc[GREEN] += G_VAL(s) * weights[j];
+             acc[BLUE]  += B_VAL(s) * weights[j];
+          }
+        A_VAL(dst) = acc[ALPHA] >> pow2_divider;
+        R_VAL(dst) = acc[RED]   >> pow2_divider;
+        G_VAL(dst) = acc[GREEN] >> pow2_divider;
+        B_VAL(dst) = acc[BLUE]  >> pow2_divider;
+     }
+}
+
+static void
+_gaussian_blur_step_rgba(DATA32 *src, DATA32 *dst, int radius, int len, int step,
+                         int *weights, int pow2_divider)
+{
+   const int diameter = 2 * radius + 1;
+   int count = len - (2 * radius);
+   int done = 0;
+
+   _gaussian_blur_edges_rgba(src, dst, radius, len, step, weights);
+   if (count <= 0) return;
+
+   dst += radius * step;
+   if (step == 1)
+     done = _gaussian_blur_span_simd((DATA8 *) src, (DATA8 *) dst,
+                                     count * sizeof(DATA32), sizeof(DATA32),
+                                     diameter, weights, pow2_divider)
+       / sizeof(DATA32);
+   _gaussian_blur_middle_rgba(src + done, dst + done, count - done, step,
+                              diameter, weights, pow2_divider);
+}
+
+/* Vertical passes do the middle rows of all the columns they can at once,
+ * then the edges of those columns. Returns how many bytes of each row
+ * that was. */
+static int
+_gaussian_blur_vert_simd(DATA8 *src, DATA8 *dst, int radius, int len,
+                         int count, int step, int *weights, int pow2_divider)
+{
+   const int diameter = 2 * radius + 1;
+   int k, done;
+
+   if (len < diameter) return 0;
+
+   done = _gaussian_blur_span_simd(src, dst + (radius * step), count, step,
+                                   diameter, weights, pow2_divider);
+   for (k = 1; done && (k < len - (2 * radius)); k++)
+     _gaussian_blur_span_simd(src + (k * step), dst + ((k + radius) * step),
+                              done, step, diameter, weights, pow2_divider);
+
+   return done;
+}
+
+static void
+_gaussian_blur_horiz_alpha(DATA8 *src, DATA8 *dst, int radius, int w, int h, int stride)
 {
    int *weights;
    int k, pow2_div = 0;
@@ -579,16 +799,16 @@ _gaussian_blur_horiz_alpha(DATA8 *src, DATA8 *dst, int radius, int w, int h)
    for (k = h; k; k--)
      {
         _gaussian_blur_step_alpha(src, dst, radius, w, 1, weights, pow2_div);
-        dst += w;
-        src += w;
+        dst += stride;
+        src += stride;
      }
 }
 
 static void
-_gaussian_blur_vert_alpha(DATA8 *src, DATA8 *dst, int radius, int w, int h)
+_gaussian_blur_vert_alpha(DATA8 *src, DATA8 *dst, int radius, int w, int h, int stride)
 {
    int *weights;
-   int k, pow2_div = 0;
+   int k, done, pow2_div = 0;
 
    weights = alloca((2 * radius + 1) * sizeof(int));
 
@@ -597,16 +817,25 @@ _gaussian_blur_vert_alpha(DATA8 *src, DATA8 *dst, int radius, int w, int h)
    else
      _sin_blur_weights_get(weights, &pow2_div, radius);
 
-   for (k = w; k; k--)
+   done = _gaussian_blur_vert_simd(src, dst, radius, h, w, stride,
+                                   weights, pow2_div);
+   for (k = done; k; k--)
+     {
+        _gaussian_blur_edges_alpha(src, dst, radius, h, stride, weights);
+        dst += 1;
+        src += 1;
+     }
+
+   for (k = w - done; k; k--)
      {
-        _gaussian_blur_step_alpha(src, dst, radius, h, w, weights, pow2_div);
+        _gaussian_blur_step_alpha(src, dst, radius, h, stride, weights, pow2_div);
         dst += 1;
         src += 1;
      }
 }
 
 static void
-_gaussian_blur_horiz_rgba(DATA32 *src, DATA32 *dst, int radius, int w, int h)
+_gaussian_blur_horiz_rgba(DATA32 *src, DATA32 *dst, int radius, int w, int h, int stride)
 {
    int *weights;
    int k, pow2_div = 0;
@@ -621,16 +850,16 @@ _gaussian_blur_horiz_rgba(DATA32 *src, DATA32 *dst, int radius, int w, int h)
    for (k = h; k; k--)
      {
         _gaussian_blur_step_rgba(src, dst, radius, w, 1, weights, pow2_div);
-        dst += w;
-        src += w;
+        dst += stride;
+        src += stride;
      }
 }
 
 static void
-_gaussian_blur_vert_rgba(DATA32 *src, DATA32 *dst, int radius, int w, int h)
+_gaussian_blur_vert_rgba(DATA32 *src, DATA32 *dst, int radius, int w, int h, int stride)
 {
    int *weights;
-   int k, pow2_div = 0;
+   int k, done, pow2_div = 0;
 
    weights = alloca((2 * radius + 1) * sizeof(int));
 
@@ -639,9 +868,19 @@ _gaussian_blur_vert_rgba(DATA32 *src, DATA32 *dst, int radius, int w, int h)
    else
      _sin_blur_weights_get(weights, &pow2_div, radius);
 
-   for (k = w; k; k--)
+   done = _gaussian_blur_vert_simd((DATA8 *) src, (DATA8 *) dst, radius, h,
+                                   w * sizeof(DATA32), stride * sizeof(DATA32),
+                                   weights, pow2_div) / sizeof(DATA32);
+   for (k = done; k; k--)
+     {
+        _gaussian_blur_edges_rgba(src, dst, radius, h, stride, weights);
+        dst += 1;
+        src += 1;
+     }
+
+   for (k = w - done; k; k--)
      {
-        _gaussian_blur_step_rgba(src, dst, radius, h, w, weights, pow2_div);
+        _gaussian_blur_step_rgba(src, dst, radius, h, stride, weights, pow2_div);
         dst += 1;
         src += 1;
      }
@@ -665,8 +904,9 @@ _gaussian_blur_horiz_apply_alpha(Evas_Filter_Command *cmd)
    EINA_SAFETY_ON_NULL_RETURN_VAL(out->mask.data, EINA_FALSE);
    EINA_SAFETY_ON_FALSE_RETURN_VAL(out->cache_entry.w >= (2*r + 1), EINA_FALSE);
 
-   _gaussian_blur_horiz_alpha(in->mask.data, out->mask.data, r,
-                              in->cache_entry.w, in->cache_entry.h);
+   _blur_bands_run(NULL, _gaussian_blur_horiz_alpha,
+                   in->mask.data, out->mask.data, r,
+                   in->cache_entry.w, in->cache_entry.h, EINA_FALSE);
 
    return EINA_TRUE;
 }
@@ -689,8 +929,9 @@ _gaussian_blur_vert_apply_alpha(Evas_Filter_Command *cmd)
    EINA_SAFETY_ON_NULL_RETURN_VAL(out->mask.data, EINA_FALSE);
    EINA_SAFETY_ON_FALSE_RETURN_VAL(out->cache_entry.h >= (2*r + 1), EINA_FALSE);
 
-   _gaussian_blur_vert_alpha(in->mask.data, out->mask.data, r,
-                             in->cache_entry.w, in->cache_entry.h);
+   _blur_bands_run(NULL, _gaussian_blur_vert_alpha,
+                   in->mask.data, out->mask.data, r,
+                   in->cache_entry.w, in->cache_entry.h, EINA_TRUE);
 
    return EINA_TRUE;
 }
@@ -713,8 +954,9 @@ _gaussian_blur_horiz_apply_rgba(Evas_Filter_Command *cmd)
    EINA_SAFETY_ON_NULL_RETURN_VAL(out->image.data, EINA_FALSE);
    EINA_SAFETY_ON_FALSE_RETURN_VAL(out->cache_entry.w >= (2*r + 1), EINA_FALSE);
 
-   _gaussian_blur_horiz_rgba(in->image.data, out->image.data, r,
-                             in->cache_entry.w, in->cache_entry.h);
+   _blur_bands_run(_gaussian_blur_horiz_rgba, NULL,
+                   in->image.data, out->image.data, r,
+                   in->cache_entry.w, in->cache_entry.h, EINA_FALSE);
 
    return EINA_TRUE;
 }
@@ -737,8 +979,9 @@ _gaussian_blur_vert_apply_rgba(Evas_Filter_Command *cmd)
    EINA_SAFETY_ON_NULL_RETURN_VAL(out->image.data, EINA_FALSE);
    EINA_SAFETY_ON_FALSE_RETURN_VAL(out->cache_entry.h >= (2*r + 1), EINA_FALSE);
 
-   _gaussian_blur_vert_rgba(in->image.data, out->image.data, r,
-                            in->cache_entry.w, in->cache_entry.h);
+   _blur_bands_run(_gaussian_blur_vert_rgba, NULL,
+                   in->image.data, out->image.data, r,
+                   in->cache_entry.w, in->cache_entry.h, EINA_TRUE);
 
    return EINA_TRUE;
 }
@@ -0,0 +1,138 @@
+#include "evas_filter.h"
+#include "evas_filter_private.h"
+
+#ifdef BUILD_AVX2
+# include <immintrin.h>
+
+/* Same as evas_filter_blur_sse3.c, twice as wide */
+
+static inline __m256i
+_div_by_diameter(__m256i acc, __m256i numerator, __m128i shift)
+{
+   __m256i lo = _mm256_mullo_epi16(acc, numerator);
+   __m256i hi = _mm256_mulhi_epu16(acc, numerator);
+   __m256i p0 = _mm256_srl_epi32(_mm256_unpacklo_epi16(lo, hi), shift);
+   __m256i p1 = _mm256_srl_epi32(_mm256_unpackhi_epi16(lo, hi), shift);
+
+   return _mm256_packs_epi32(p0, p1);
+}
+
+static inline void
+_div_by_int(__m256i acc_lo, __m256i acc_hi, int divider, DATA8 *d)
+{
+   unsigned short acc[32];
+   int k;
+
+   _mm256_storeu_si256((__m256i *) acc, acc_lo);
+   _mm256_storeu_si256((__m256i *) (acc + 16), acc_hi);
+   for (k = 0; k < 32; k++)
+     d[k] = acc[k] / divider;
+}
+
+#define LOAD_LO(p) _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *) (p)))
+#define LOAD_HI(p) _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *) ((p) + 16)))
+
+int
+evas_filter_blur_box_lanes_avx2(const DATA8 *src, DATA8 *dst, int radius,
+                                int len, int count, int step,
+                                int numerator, int pow2)
+{
+   const __m256i num = _mm256_set1_epi16(numerator);
+   const __m128i shift = _mm_cvtsi32_si128(pow2);
+   int i, k;
+
+   for (i = 0; i + 32 <= count; i += 32)
+     {
+        const DATA8 *sr = src + i, *sl = src + i;
+        DATA8 *d = dst + i;
+        __m256i lo = _mm256_setzero_si256(), hi = _mm256_setzero_si256(), v;
+
+        for (k = radius; k; k--, sr += step)
+          {
+             lo = _mm256_add_epi16(lo, LOAD_LO(sr));
+             hi = _mm256_add_epi16(hi, LOAD_HI(sr));
+          }
+
+        for (k = 0; k < radius; k++, sr += step, d += step)
+          {
+             lo = _mm256_add_epi16(lo, LOAD_LO(sr));
+             hi = _mm256_add_epi16(hi, LOAD_HI(sr));
+             _div_by_int(lo, hi, k + radius + 1, d);
+          }
+
+        for (k = len - (2 * radius); k > 0; k--, sr += step, sl += step, d += step)
+          {
+             lo = _mm256_add_epi16(lo, LOAD_LO(sr));
+             hi = _mm256_add_epi16(hi, LOAD_HI(sr));
+
+             v = _mm256_packus_epi16(_div_by_diameter(lo, num, shift),
+                                     _div_by_diameter(hi, num, shift));
+             v = _mm256_permute4x64_epi64(v, 0xd8);
+             _mm256_storeu_si256((__m256i *) d, v);
+
+             lo = _mm256_sub_epi16(lo, LOAD_LO(sl));
+             hi = _mm256_sub_epi16(hi, LOAD_HI(sl));
+          }
+
+        for (k = radius; k; k--, sl += step, d += step)
+          {
+             _div_by_int(lo, hi, k + radius, d);
+             lo = _mm256_sub_epi16(lo, LOAD_LO(sl));
+             hi = _mm256_sub_epi16(hi, LOAD_HI(sl));
+          }
+     }
+
+   return i;
+}
+
+int
+evas_filter_blur_gaussian_span_avx2(const DATA8 *src, DATA8 *dst, int count,
+                                    int step, int diameter, const int *weights,
+                                    int pow2)
+{
+   const __m256i zero = _mm256_setzero_si256();
+   const __m128i shift = _mm_cvtsi32_si128(pow2);
+   int i, j;
+
+   /* everything stays within 128 bit lanes, so no permutes are needed */
+   for (i = 0; i + 32 <= count; i += 32)
+     {
+        const DATA8 *s = src + i;
+        __m256i acc0 = zero, acc1 = zero, acc2 = zero, acc3 = zero;
+        __m256i a, b, w, lo, hi;
+
+        for (j = 0; j < diameter; j += 2, s += 2 * step)
+          {
+             a = _mm256_loadu_si256((const __m256i *) s);
+             if (j + 1 < diameter)
+               {
+                  b = _mm256_loadu_si256((const __m256i *) (s + step));
+                  w = _mm256_set1_epi32((weights[j + 1] << 16) | weights[j]);
+               }
+             else
+               {
+                  b = zero;
+                  w = _mm256_set1_epi32(weights[j]);
+               }
+
+             lo = _mm256_unpacklo_epi8(a, b);
+             hi = _mm256_unpackhi_epi8(a, b);
+             acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(_mm256_unpacklo_epi8(lo, zero), w));
+             acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(_mm256_unpackhi_epi8(lo, zero), w));
+             acc2 = _mm256_add_epi32(acc2, _mm256_madd_epi16(_mm256_unpacklo_epi8(hi, zero), w));
+             acc3 = _mm256_add_epi32(acc3, _mm256_madd_epi16(_mm256_unpackhi_epi8(hi, zero), w));
+          }
+
+        acc0 = _mm256_srl_epi32(acc0, shift);
+        acc1 = _mm256_srl_epi32(acc1, shift);
+        acc2 = _mm256_srl_epi32(acc2, shift);
+        acc3 = _mm256_srl_epi32(acc3, shift);
+        _mm256_storeu_si256((__m256i *) (dst + i),
+                            _mm256_packus_epi16(_mm256_packs_epi32(acc0, acc1),
+                                                _mm256_packs_epi32(acc2, acc3)));
+     }
+
+   return i;
+}
+
+#endif
@@ -0,0 +1,126 @@
+#include "evas_filter.h"
+#include "evas_filter_private.h"
+
+#ifdef BUILD_NEON
+# include <arm_neon.h>
+
+/* See evas_filter_blur_sse3.c, this is the same on 16 bytes at a time */
+
+static inline uint8x8_t
+_div_by_diameter(uint16x8_t acc, uint16_t numerator, int32x4_t shift)
+{
+   uint32x4_t p0 = vmull_n_u16(vget_low_u16(acc), numerator);
+   uint32x4_t p1 = vmull_n_u16(vget_high_u16(acc), numerator);
+
+   p0 = vshlq_u32(p0, shift);
+   p1 = vshlq_u32(p1, shift);
+   return vmovn_u16(vcombine_u16(vmovn_u32(p0), vmovn_u32(p1)));
+}
+
+static inline void
+_div_by_int(uint16x8_t acc_lo, uint16x8_t acc_hi, int divider, DATA8 *d)
+{
+   uint16_t acc[16];
+   int k;
+
+   vst1q_u16(acc, acc_lo);
+   vst1q_u16(acc + 8, acc_hi);
+   for (k = 0; k < 16; k++)
+     d[k] = acc[k] / divider;
+}
+
+int
+evas_filter_blur_box_lanes_neon(const DATA8 *src, DATA8 *dst, int radius,
+                                int len, int count, int step,
+                                int numerator, int pow2)
+{
+   const int32x4_t shift = vdupq_n_s32(-pow2);
+   int i, k;
+
+   for (i = 0; i + 16 <= count; i += 16)
+     {
+        const DATA8 *sr = src + i, *sl = src + i;
+        DATA8 *d = dst + i;
+        uint16x8_t lo = vdupq_n_u16(0), hi = vdupq_n_u16(0);
+        uint8x16_t v;
+
+        for (k = radius; k; k--, sr += step)
+          {
+             v = vld1q_u8(sr);
+             lo = vaddw_u8(lo, vget_low_u8(v));
+             hi = vaddw_u8(hi, vget_high_u8(v));
+          }
+
+        for (k = 0; k < radius; k++, sr += step, d += step)
+          {
+             v = vld1q_u8(sr);
+             lo = vaddw_u8(lo, vget_low_u8(v));
+             hi = vaddw_u8(hi, vget_high_u8(v));
+             _div_by_int(lo, hi, k + radius + 1, d);
+          }
+
+        for (k = len - (2 * radius); k > 0; k--, sr += step, sl += step, d += step)
+          {
+             v = vld1q_u8(sr);
+             lo = vaddw_u8(lo, vget_low_u8(v));
+             hi = vaddw_u8(hi, vget_high_u8(v));
+
+             vst1q_u8(d, vcombine_u8(_div_by_diameter(lo, numerator, shift),
+                                     _div_by_diameter(hi, numerator, shift)));
+
+             v = vld1q_u8(sl);
+             lo = vsubw_u8(lo, vget_low_u8(v));
+             hi = vsubw_u8(hi, vget_high_u8(v));
+          }
+
+        for (k = radius; k; k--, sl += step, d += step)
+          {
+             _div_by_int(lo, hi, k + radius, d);
+             v = vld1q_u8(sl);
+             lo = vsubw_u8(lo, vget_low_u8(v));
+             hi = vsubw_u8(hi, vget_high_u8(v));
+          }
+     }
+
+   return i;
+}
+
+int
+evas_filter_blur_gaussian_span_neon(const DATA8 *src, DATA8 *dst, int count,
+                                    int step, int diameter, const int *weights,
+                                    int pow2)
+{
+   const int32x4_t shift = vdupq_n_s32(-pow2);
+   int i, j;
+
+   for (i = 0; i + 16 <= count; i += 16)
+     {
+        const DATA8 *s = src + i;
+        uint32x4_t acc0 = vdupq_n_u32(0), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+
+        for (j = 0; j < diameter; j++, s += step)
+          {
+             uint8x16_t v = vld1q_u8(s);
+             uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+             uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+             uint16_t w = weights[j];
+
+             acc0 = vmlal_n_u16(acc0, vget_low_u16(lo), w);
+             acc1 = vmlal_n_u16(acc1, vget_high_u16(lo), w);
+             acc2 = vmlal_n_u16(acc2, vget_low_u16(hi), w);
+             acc3 = vmlal_n_u16(acc3, vget_high_u16(hi), w);
+          }
+
+        acc0 = vshlq_u32(acc0, shift);
+        acc1 = vshlq_u32(acc1, shift);
+        acc2 = vshlq_u32(acc2, shift);
+        acc3 = vshlq_u32(acc3, shift);
+        vst1q_u8(dst + i,
+                 vcombine_u8(vmovn_u16(vcombine_u16(vmovn_u32(acc0), vmovn_u32(acc1))),
+                             vmovn_u16(vcombine_u16(vmovn_u32(acc2), vmovn_u32(acc3)))));
+     }
+
+   return i;
+}
+
+#endif
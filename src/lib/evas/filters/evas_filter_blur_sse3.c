@@ -0,0 +1,142 @@
+#include "evas_filter.h"
+#include "evas_filter_private.h"
+
+#ifdef BUILD_SSE3
+# include <emmintrin.h>
+
+/* See evas_filter_blur.c for the C versions these have to match bit for
+ * bit. Only SSE2 instructions are needed, this is built with the SSE3
+ * code as that is what the cpu is checked for. */
+
+static inline __m128i
+_div_by_diameter(__m128i acc, __m128i numerator, __m128i shift)
+{
+   __m128i lo = _mm_mullo_epi16(acc, numerator);
+   __m128i hi = _mm_mulhi_epu16(acc, numerator);
+   __m128i p0 = _mm_srl_epi32(_mm_unpacklo_epi16(lo, hi), shift);
+   __m128i p1 = _mm_srl_epi32(_mm_unpackhi_epi16(lo, hi), shift);
+
+   return _mm_packs_epi32(p0, p1);
+}
+
+static inline void
+_div_by_int(__m128i acc_lo, __m128i acc_hi, int divider, DATA8 *d)
+{
+   unsigned short acc[16];
+   int k;
+
+   _mm_storeu_si128((__m128i *) acc, acc_lo);
+   _mm_storeu_si128((__m128i *) (acc + 8), acc_hi);
+   for (k = 0; k < 16; k++)
+     d[k] = acc[k] / divider;
+}
+
+int
+evas_filter_blur_box_lanes_sse3(const DATA8 *src, DATA8 *dst, int radius,
+                                int len, int count, int step,
+                                int numerator, int pow2)
+{
+   const __m128i zero = _mm_setzero_si128();
+   const __m128i num = _mm_set1_epi16(numerator);
+   const __m128i shift = _mm_cvtsi32_si128(pow2);
+   int i, k;
+
+   for (i = 0; i + 16 <= count; i += 16)
+     {
+        const DATA8 *sr = src + i, *sl = src + i;
+        DATA8 *d = dst + i;
+        __m128i lo = zero, hi = zero, v;
+
+        for (k = radius; k; k--, sr += step)
+          {
+             v = _mm_loadu_si128((const __m128i *) sr);
+             lo = _mm_add_epi16(lo, _mm_unpacklo_epi8(v, zero));
+             hi = _mm_add_epi16(hi, _mm_unpackhi_epi8(v, zero));
+          }
+
+        for (k = 0; k < radius; k++, sr += step, d += step)
+          {
+             v = _mm_loadu_si128((const __m128i *) sr);
+             lo = _mm_add_epi16(lo, _mm_unpacklo_epi8(v, zero));
+             hi = _mm_add_epi16(hi, _mm_unpackhi_epi8(v, zero));
+             _div_by_int(lo, hi, k + radius + 1, d);
+          }
+
+        for (k = len - (2 * radius); k > 0; k--, sr += step, sl += step, d += step)
+          {
+             v = _mm_loadu_si128((const __m128i *) sr);
+             lo = _mm_add_epi16(lo, _mm_unpacklo_epi8(v, zero));
+             hi = _mm_add_epi16(hi, _mm_unpackhi_epi8(v, zero));
+
+             v = _mm_packus_epi16(_div_by_diameter(lo, num, shift),
+                                  _div_by_diameter(hi, num, shift));
+             _mm_storeu_si128((__m128i *) d, v);
+
+             v = _mm_loadu_si128((const __m128i *) sl);
+             lo = _mm_sub_epi16(lo, _mm_unpacklo_epi8(v, zero));
+             hi = _mm_sub_epi16(hi, _mm_unpackhi_epi8(v, zero));
+          }
+
+        for (k = radius; k; k--, sl += step, d += step)
+          {
+             _div_by_int(lo, hi, k + radius, d);
+             v = _mm_loadu_si128((const __m128i *) sl);
+             lo = _mm_sub_epi16(lo, _mm_unpacklo_epi8(v, zero));
+             hi = _mm_sub_epi16(hi, _mm_unpackhi_epi8(v, zero));
+          }
+     }
+
+   return i;
+}
+
+int
+evas_filter_blur_gaussian_span_sse3(const DATA8 *src, DATA8 *dst, int count,
+                                    int step, int diameter, const int *weights,
+                                    int pow2)
+{
+   const __m128i zero = _mm_setzero_si128();
+   const __m128i shift = _mm_cvtsi32_si128(pow2);
+   int i, j;
+
+   for (i = 0; i + 16 <= count; i += 16)
+     {
+        const DATA8 *s = src + i;
+        __m128i acc0 = zero, acc1 = zero, acc2 = zero, acc3 = zero;
+        __m128i a, b, w, lo, hi;
+
+        /* two taps at a time, interleaved so that madd does both */
+        for (j = 0; j < diameter; j += 2, s += 2 * step)
+          {
+             a = _mm_loadu_si128((const __m128i *) s);
+             if (j + 1 < diameter)
+               {
+                  b = _mm_loadu_si128((const __m128i *) (s + step));
+                  w = _mm_set1_epi32((weights[j + 1] << 16) | weights[j]);
+               }
+             else
+               {
+                  b = zero;
+                  w = _mm_set1_epi32(weights[j]);
+               }
+
+             lo = _mm_unpacklo_epi8(a, b);
+             hi = _mm_unpackhi_epi8(a, b);
+             acc0 = _mm_add_epi32(acc0, _mm_madd_epi16(_mm_unpacklo_epi8(lo, zero), w));
+             acc1 = _mm_add_epi32(acc1, _mm_madd_epi16(_mm_unpackhi_epi8(lo, zero), w));
+             acc2 = _mm_add_epi32(acc2, _mm_madd_epi16(_mm_unpacklo_epi8(hi, zero), w));
+             acc3 = _mm_add_epi32(acc3, _mm_madd_epi16(_mm_unpackhi_epi8(hi, zero), w));
+          }
+
+        acc0 = _mm_srl_epi32(acc0, shift);
+        acc1 = _mm_srl_epi32(acc1, shift);
+        acc2 = _mm_srl_epi32(acc2, shift);
+        acc3 = _mm_srl_epi32(acc3, shift);
+        _mm_storeu_si128((__m128i *) (dst + i),
+                         _mm_packus_epi16(_mm_packs_epi32(acc0, acc1),
+                                          _mm_packs_epi32(acc2, acc3)));
+     }
+
+   return i;
+}
+
+#endif
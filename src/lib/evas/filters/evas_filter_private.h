@@ -33,6 +33,10 @@
 #define ENFN ctx->evas->engine.func
 #define ENDT ctx->evas->engine.data.output
 
+// Below this many pixels, a command is not worth splitting into bands
+// and rather runs next to other small commands
+#define EVAS_FILTER_BAND_PIXELS_MIN (128 * 128)
+
 #define BUFFERS_LOCK() do { if (cmd->input) cmd->input->locked = 1; if (cmd->output) cmd->output->locked = 1; if (cmd->mask) cmd->mask->locked = 1; } while (0)
 #define BUFFERS_UNLOCK() do { if (cmd->input) cmd->input->locked = 0; if (cmd->output) cmd->output->locked = 0; if (cmd->mask) cmd->mask->locked = 0; } while (0)
 
@@ -186,6 +190,21 @@ Evas_Filter_Apply_Func   evas_filter_fill_cpu_func_get(Evas_Filter_Command *cmd)
 Evas_Filter_Apply_Func   evas_filter_mask_cpu_func_get(Evas_Filter_Command *cmd);
 Evas_Filter_Apply_Func   evas_filter_transform_cpu_func_get(Evas_Filter_Command *cmd);
 
+/* SIMD blur loops. They return how many of the count bytes they did, the
+ * C code in evas_filter_blur.c takes care of the rest. */
+#ifdef BUILD_SSE3
+int evas_filter_blur_box_lanes_sse3(const DATA8 *src, DATA8 *dst, int radius, int len, int count, int step, int numerator, int pow2);
+int evas_filter_blur_gaussian_span_sse3(const DATA8 *src, DATA8 *dst, int count, int step, int diameter, const int *weights, int pow2);
+#endif
+#ifdef BUILD_AVX2
+int evas_filter_blur_box_lanes_avx2(const DATA8 *src, DATA8 *dst, int radius, int len, int count, int step, int numerator, int pow2);
+int evas_filter_blur_gaussian_span_avx2(const DATA8 *src, DATA8 *dst, int count, int step, int diameter, const int *weights, int pow2);
+#endif
+#ifdef BUILD_NEON
+int evas_filter_blur_box_lanes_neon(const DATA8 *src, DATA8 *dst, int radius, int len, int count, int step, int numerator, int pow2);
+int evas_filter_blur_gaussian_span_neon(const DATA8 *src, DATA8 *dst, int count, int step, int diameter, const int *weights, int pow2);
+#endif
+
 /* Utility functions */
 void _clip_to_target(int *sx, int *sy, int sw, int sh, int ox, int oy, int dw, int dh, int *dx, int *dy, int *rows, int *cols);
 Eina_Bool evas_filter_buffer_alloc(Evas_Filter_Buffer *fb, int w, int h);
@@ -13,6 +13,12 @@
 # endif
 #endif
 
+#ifdef NEED_AVX2
+# if defined BUILD_AVX2
+#  include <immintrin.h>
+# endif
+#endif
+
 /* src pixel flags: */
 
 /* pixels none */
@@ -77,8 +83,10 @@
 #define CPU_NEON 5
 /* CPU SSE3 */
 #define CPU_SSE3 6
+/* CPU AVX2 */
+#define CPU_AVX2 7
 /* cpu flags count */
-#define CPU_LAST 7
+#define CPU_LAST 8
 
 
 /* some useful constants */
@@ -409,6 +417,125 @@ mul3_sym_sse3(__m128i x, __m128i y) {
 #endif
 #endif
 
+/* some useful AVX2 inline functions */
+
+#ifdef NEED_AVX2
+#ifdef BUILD_AVX2
+
+/* all of these give the same bits as the C macros of the same name */
+
+static EFL_ALWAYS_INLINE __m256i
+load8_mask_avx2(const DATA8 *m) {
+
+   /* one mask byte per 32bit lane */
+   return _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)m));
+}
+
+static EFL_ALWAYS_INLINE __m256i
+sub8_alpha_avx2(__m256i c) {
+
+   return _mm256_sub_epi32(_mm256_set1_epi32(256), _mm256_srli_epi32(c, 24));
+}
+
+static EFL_ALWAYS_INLINE __m256i
+mul_256_avx2(__m256i a, __m256i c) {
+
+   const __m256i ga = _mm256_set1_epi32(0x00ff00ff);
+
+   /* alpha (0 - 256) in both words of each pixel */
+   __m256i a0 = _mm256_or_si256(a, _mm256_slli_epi32(a, 16));
+
+   /* alpha and green */
+   __m256i c0 = _mm256_and_si256(_mm256_srli_epi32(c, 8), ga);
+   c0 = _mm256_mullo_epi16(a0, c0);
+   c0 = _mm256_andnot_si256(ga, c0);
+
+   /* red and blue */
+   __m256i c1 = _mm256_and_si256(c, ga);
+   c1 = _mm256_mullo_epi16(a0, c1);
+   c1 = _mm256_and_si256(_mm256_srli_epi32(c1, 8), ga);
+
+   return _mm256_add_epi32(c0, c1);
+}
+
+static EFL_ALWAYS_INLINE __m256i
+mul_sym_avx2(__m256i a, __m256i c) {
+
+   const __m256i ga = _mm256_set1_epi32(0x00ff00ff);
+
+   /* alpha (0 - 255) in both words of each pixel */
+   __m256i a0 = _mm256_or_si256(a, _mm256_slli_epi32(a, 16));
+
+   __m256i c0 = _mm256_and_si256(_mm256_srli_epi32(c, 8), ga);
+   c0 = _mm256_mullo_epi16(a0, c0);
+   c0 = _mm256_add_epi16(c0, ga);
+   c0 = _mm256_andnot_si256(ga, c0);
+
+   __m256i c1 = _mm256_and_si256(c, ga);
+   c1 = _mm256_mullo_epi16(a0, c1);
+   c1 = _mm256_add_epi16(c1, ga);
+   c1 = _mm256_and_si256(_mm256_srli_epi32(c1, 8), ga);
+
+   return _mm256_add_epi32(c0, c1);
+}
+
+static EFL_ALWAYS_INLINE __m256i
+mul_bytes_avx2(__m256i x, __m256i y, __m256i round) {
+
+   const __m256i zero = _mm256_setzero_si256();
+
+   /* unpack and pack both work per 128bit lane, so pixels stay in place */
+   __m256i r_l = _mm256_mullo_epi16(_mm256_unpacklo_epi8(x, zero),
+                                    _mm256_unpacklo_epi8(y, zero));
+   __m256i r_h = _mm256_mullo_epi16(_mm256_unpackhi_epi8(x, zero),
+                                    _mm256_unpackhi_epi8(y, zero));
+
+   r_l = _mm256_srli_epi16(_mm256_add_epi16(r_l, round), 8);
+   r_h = _mm256_srli_epi16(_mm256_add_epi16(r_h, round), 8);
+
+   return _mm256_packus_epi16(r_l, r_h);
+}
+
+static EFL_ALWAYS_INLINE __m256i
+mul4_sym_avx2(__m256i x, __m256i y) {
+
+   return mul_bytes_avx2(x, y, _mm256_set1_epi16(0xff));
+}
+
+static EFL_ALWAYS_INLINE __m256i
+mul3_sym_avx2(__m256i x, __m256i y) {
+
+   /* MUL3_SYM doesn't round green and drops alpha */
+   const __m256i round = _mm256_set1_epi64x(0x000000ff000000ffLL);
+
+   return _mm256_and_si256(mul_bytes_avx2(x, y, round),
+                           _mm256_set1_epi32(0x00ffffff));
+}
+
+static EFL_ALWAYS_INLINE __m256i
+interp_256_avx2(__m256i a, __m256i c0, __m256i c1) {
+
+   const __m256i ga = _mm256_set1_epi32(0x00ff00ff);
+
+   /* the channel differences borrow across each other, so stay in dwords */
+   __m256i h0 = _mm256_and_si256(_mm256_srli_epi32(c0, 8), ga);
+   __m256i h1 = _mm256_and_si256(_mm256_srli_epi32(c1, 8), ga);
+   __m256i h = _mm256_mullo_epi32(_mm256_sub_epi32(h0, h1), a);
+   h = _mm256_add_epi32(h, _mm256_andnot_si256(ga, c1));
+   h = _mm256_andnot_si256(ga, h);
+
+   __m256i l0 = _mm256_and_si256(c0, ga);
+   __m256i l1 = _mm256_and_si256(c1, ga);
+   __m256i l = _mm256_mullo_epi32(_mm256_sub_epi32(l0, l1), a);
+   l = _mm256_add_epi32(_mm256_srli_epi32(l, 8), l1);
+   l = _mm256_and_si256(l, ga);
+
+   return _mm256_add_epi32(h, l);
+}
+
+#endif
+#endif
+
 #define LOOP_ALIGNED_U1_A48(DEST, LENGTH, UOP, A4OP, A8OP) \
    { \
       while((uintptr_t)DEST & 0xF && LENGTH) UOP \
@@ -432,4 +559,13 @@ mul3_sym_sse3(__m128i x, __m128i y) {
       } \
    }
 
+#define LOOP_ALIGNED_U1_A8(DEST, LENGTH, UOP, A8OP) \
+   { \
+      while((uintptr_t)DEST & 0x1F && LENGTH) UOP \
+   \
+      while(LENGTH >= 8) A8OP \
+   \
+      while(LENGTH) UOP \
+   }
+
 #endif
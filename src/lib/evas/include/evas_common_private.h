@@ -186,7 +186,7 @@ extern EAPI int _evas_log_dom_global;
 
 # define TH(x)  pthread_t x
 # define THI(x) int x
-# define TH_MAX 8
+# define TH_MAX 32
 
 #include <ft2build.h>
 #include FT_FREETYPE_H
@@ -490,7 +490,8 @@ typedef enum _CPU_Features
    CPU_FEATURE_VIS     = (1 << 4),
    CPU_FEATURE_VIS2    = (1 << 5),
    CPU_FEATURE_NEON    = (1 << 6),
-   CPU_FEATURE_SSE3    = (1 << 7)
+   CPU_FEATURE_SSE3    = (1 << 7),
+   CPU_FEATURE_AVX2    = (1 << 8)
 } CPU_Features;
 
 typedef enum _Font_Hint_Flags
@@ -1159,6 +1160,7 @@ struct _Convert_Pal
         (((a) << 24) + ((r) << 16) + ((g) << 8) + (b))
 
 #include "evas_blend_ops.h"
+#include "evas_thread_pool.h"
 
 #define _EVAS_RENDER_FILL        -1
 #define _EVAS_RENDER_BLEND        0
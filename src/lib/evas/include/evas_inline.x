@@ -333,6 +333,8 @@ evas_object_clip_recalc(Evas_Object_Protected_Data *obj)
         state_write->cache.clip.dirty = EINA_FALSE;
      }
    EINA_COW_STATE_WRITE_END(obj, state_write, cur);
+
+   if (obj->event_index.item) eina_quadtree_change(obj->event_index.item);
 }
 
 #endif
@@ -19,6 +19,8 @@
 
 #define RENDER_METHOD_INVALID            0x00000000
 
+#define EVAS_RENDER_STATS_DEFAULT_SIZE   32
+
 /* #define REND_DBG 1 */
 
 typedef struct _Evas_Layer                  Evas_Layer;
@@ -46,6 +48,8 @@ typedef struct _Evas_Coord_Touch_Point      Evas_Coord_Touch_Point;
 typedef struct _Evas_Object_Proxy_Data      Evas_Object_Proxy_Data;
 typedef struct _Evas_Object_Map_Data        Evas_Object_Map_Data;
 typedef struct _Evas_Proxy_Render_Data      Evas_Proxy_Render_Data;
+typedef struct _Evas_Event_Index            Evas_Event_Index;
+typedef struct _Evas_Event_Index_Walk       Evas_Event_Index_Walk;
 
 typedef struct _Evas_Object_Protected_State Evas_Object_Protected_State;
 typedef struct _Evas_Object_Protected_Data  Evas_Object_Protected_Data;
@@ -443,6 +447,14 @@ struct _Evas_Public_Data
    
    Eina_List     *outputs;
 
+   struct {
+      Evas_Render_Stats *frames; // ring of the last recorded frames
+      Evas_Render_Stats  cur; // frame being rendered
+      double             start, stamp;
+      unsigned int       size, count, next, serial;
+      Eina_Bool          active : 1;
+   } stats;
+
    unsigned char  changed : 1;
    unsigned char  delete_me : 1;
    unsigned char  invalidate : 1;
@@ -450,6 +462,7 @@ struct _Evas_Public_Data
    unsigned char  focus : 1;
    Eina_Bool      is_frozen : 1;
    Eina_Bool      rendering : 1;
+   Eina_Bool      spatial_index : 1;
 };
 
 struct _Evas_Layer
@@ -462,6 +475,7 @@ struct _Evas_Layer
    Evas_Public_Data *evas;
 
    void             *engine_data;
+   Evas_Event_Index *event_index; // hit testing index of the objects
    int               usage;
    unsigned char     delete_me : 1;
 };
@@ -632,6 +646,12 @@ struct _Evas_Object_Protected_Data
         int                      in_move, in_resize;
    } doing;
 
+   struct {
+      Evas_Event_Index        *members; // index of the smart members
+      Eina_QuadTree_Item      *item; // entry in the index of our layer or parent
+      unsigned int             rank; // stacking position in that index
+   } event_index;
+
    unsigned int                ref;
 
    unsigned char               delete_me;
@@ -1155,6 +1175,11 @@ void _canvas_event_feed_hold(Eo *e, void *_pd, va_list *list);
 void _canvas_event_refeed_event(Eo *e, void *_pd, va_list *list);
 void _canvas_event_down_count_get(Eo *e, void *_pd, va_list *list);
 void _canvas_tree_objects_at_xy_get(Eo *e, void *_pd, va_list *list);
+void _canvas_render_stats_size_set(Eo *e, void *_pd, va_list *list);
+void _canvas_render_stats_size_get(Eo *e, void *_pd, va_list *list);
+void _canvas_render_stats_get(Eo *e, void *_pd, va_list *list);
+void _canvas_event_spatial_index_set(Eo *e, void *_pd, va_list *list);
+void _canvas_event_spatial_index_get(Eo *e, void *_pd, va_list *list);
 void _canvas_focus_get(Eo *e, void *_pd, va_list *list);
 void _canvas_font_path_clear(Eo *e, void *_pd, va_list *list);
 void _canvas_font_path_append(Eo *e, void *_pd, va_list *list);
@@ -1270,6 +1295,25 @@ Eina_Bool evas_render_mapped(Evas_Public_Data *e, Evas_Object *obj,
 void evas_render_invalidate(Evas *e);
 void evas_render_object_recalc(Evas_Object *obj);
 
+void _evas_render_stats_begin(Evas_Public_Data *e, Eina_Bool do_draw, Eina_Bool do_async);
+void _evas_render_stats_mark(Evas_Public_Data *e, double *phase);
+void _evas_render_stats_end(Evas_Public_Data *e, Eina_Bool drawn);
+
+/* spatial index used by the event code, see evas_event_index.c */
+struct _Evas_Event_Index_Walk
+{
+   Eina_Array   *hits;
+   unsigned int  i;
+};
+
+void evas_event_index_free(Evas_Event_Index *idx);
+void evas_event_index_add(Evas_Event_Index *idx, Evas_Object_Protected_Data *obj);
+void evas_event_index_del(Evas_Object_Protected_Data *obj);
+void evas_event_index_change(Evas_Object_Protected_Data *obj);
+void evas_event_index_restack(Evas_Object_Protected_Data *obj);
+Evas_Object_Protected_Data *evas_event_index_walk_first(Evas_Event_Index_Walk *walk, Evas_Object_Protected_Data *last, int x, int y, int w, int h);
+Evas_Object_Protected_Data *evas_event_index_walk_prev(Evas_Event_Index_Walk *walk, Evas_Object_Protected_Data *obj);
+
 Eina_Bool evas_map_inside_get(const Evas_Map *m, Evas_Coord x, Evas_Coord y);
 Eina_Bool evas_map_coords_get(const Evas_Map *m, Evas_Coord x, Evas_Coord y, Evas_Coord *mx, Evas_Coord *my, int grab);
 Eina_Bool evas_object_map_update(Evas_Object *obj, int x, int y, int imagew, int imageh, int uvw, int uvh);
@@ -0,0 +1,16 @@
+#ifndef EVAS_THREAD_POOL_H
+#define EVAS_THREAD_POOL_H
+
+/* Fork/join pool shared by the layout, filters and cserve2 code, see
+ * evas_thread_pool.c. Only needs Eina and EAPI, so the tests can include
+ * it without the rest of the private headers. */
+
+typedef void (*Evas_Thread_Pool_Cb)(void *data, unsigned int idx);
+
+EAPI void         evas_thread_pool_init(void);
+EAPI void         evas_thread_pool_shutdown(void);
+EAPI unsigned int evas_thread_pool_threads_get(void);
+EAPI void         evas_thread_pool_threads_set(unsigned int threads);
+EAPI void         evas_thread_pool_run(Evas_Thread_Pool_Cb cb, void *data, unsigned int count);
+
+#endif
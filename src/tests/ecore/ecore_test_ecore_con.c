@@ -255,6 +255,284 @@ START_TEST(ecore_test_ecore_con_server)
 }
 END_TEST
 
+#define RECV_POOL_SIZE (1024 * 1024 + 123)
+
+static int _recv_pool_received = 0;
+
+static Eina_Bool
+_recv_pool_client_add(void *data EINA_UNUSED, int type EINA_UNUSED, void *ev EINA_UNUSED)
+{
+   return ECORE_CALLBACK_RENEW;
+}
+
+static Eina_Bool
+_recv_pool_server_add(void *data, int type EINA_UNUSED, void *ev)
+{
+   Ecore_Con_Event_Server_Add *event = ev;
+   const unsigned char *payload = data;
+   int ret;
+
+   ret = ecore_con_server_send(event->server, payload, RECV_POOL_SIZE);
+   fail_if(ret != RECV_POOL_SIZE);
+   ecore_con_server_flush(event->server);
+
+   return ECORE_CALLBACK_RENEW;
+}
+
+static Eina_Bool
+_recv_pool_client_data(void *data, int type EINA_UNUSED, void *ev)
+{
+   Ecore_Con_Event_Client_Data *event = ev;
+   const unsigned char *payload = data;
+
+   fail_if(event->size <= 0);
+   fail_if(_recv_pool_received + event->size > RECV_POOL_SIZE);
+   fail_if(memcmp(event->data, payload + _recv_pool_received, event->size) != 0);
+   _recv_pool_received += event->size;
+
+   if (_recv_pool_received == RECV_POOL_SIZE)
+     ecore_main_loop_quit();
+
+   return ECORE_CALLBACK_RENEW;
+}
+
+START_TEST(ecore_test_ecore_con_server_recv_pool)
+{
+   Ecore_Con_Server *server;
+   Ecore_Con_Server *client;
+   Ecore_Event_Handler *handlers[3];
+   unsigned char *payload;
+   int ret, i;
+
+   ret = eina_init();
+   fail_if(ret != 1);
+   ret = ecore_init();
+   fail_if(ret < 1);
+   ret = ecore_con_init();
+   fail_if(ret != 1);
+
+   payload = malloc(RECV_POOL_SIZE);
+   fail_if(!payload);
+   for (i = 0; i < RECV_POOL_SIZE; i++)
+     payload[i] = (i * 7) ^ (i >> 9);
+
+   handlers[0] = ecore_event_handler_add(ECORE_CON_EVENT_CLIENT_ADD,
+       _recv_pool_client_add, NULL);
+   handlers[1] = ecore_event_handler_add(ECORE_CON_EVENT_CLIENT_DATA,
+       _recv_pool_client_data, payload);
+   handlers[2] = ecore_event_handler_add(ECORE_CON_EVENT_SERVER_ADD,
+       _recv_pool_server_add, payload);
+
+   server = ecore_con_server_add(ECORE_CON_REMOTE_TCP, "127.0.0.1", 1235,
+       NULL);
+   fail_if(server == NULL);
+
+   fail_if(ecore_con_server_recv_pool_get(server));
+   ecore_con_server_recv_pool_set(server, EINA_TRUE);
+   fail_if(!ecore_con_server_recv_pool_get(server));
+
+   client = ecore_con_server_connect(ECORE_CON_REMOTE_TCP, "127.0.0.1", 1235,
+       NULL);
+   fail_if(client == NULL);
+
+   ecore_main_loop_begin();
+
+   fail_if(_recv_pool_received != RECV_POOL_SIZE);
+
+   ecore_con_server_del(client);
+   ecore_con_server_del(server);
+
+   for (i = 0; i < 3; i++)
+     ecore_event_handler_del(handlers[i]);
+   free(payload);
+
+   ret = ecore_con_shutdown();
+   fail_if(ret != 0);
+   ret = ecore_shutdown();
+   ret = eina_shutdown();
+}
+END_TEST
+
+static Eina_Bool
+_client_recv_pool_client_add(void *data, int type EINA_UNUSED, void *ev)
+{
+   Ecore_Con_Event_Client_Add *event = ev;
+   const unsigned char *payload = data;
+   int ret;
+
+   ret = ecore_con_client_send(event->client, payload, RECV_POOL_SIZE);
+   fail_if(ret != RECV_POOL_SIZE);
+   ecore_con_client_flush(event->client);
+
+   return ECORE_CALLBACK_RENEW;
+}
+
+static Eina_Bool
+_client_recv_pool_server_data(void *data, int type EINA_UNUSED, void *ev)
+{
+   Ecore_Con_Event_Server_Data *event = ev;
+   const unsigned char *payload = data;
+
+   fail_if(event->size <= 0);
+   fail_if(_recv_pool_received + event->size > RECV_POOL_SIZE);
+   fail_if(memcmp(event->data, payload + _recv_pool_received, event->size) != 0);
+   _recv_pool_received += event->size;
+
+   if (_recv_pool_received == RECV_POOL_SIZE)
+     ecore_main_loop_quit();
+
+   return ECORE_CALLBACK_RENEW;
+}
+
+START_TEST(ecore_test_ecore_con_client_recv_pool)
+{
+   Ecore_Con_Server *server;
+   Ecore_Con_Server *client;
+   Ecore_Event_Handler *handlers[2];
+   unsigned char *payload;
+   int ret, i;
+
+   ret = eina_init();
+   fail_if(ret != 1);
+   ret = ecore_init();
+   fail_if(ret < 1);
+   ret = ecore_con_init();
+   fail_if(ret != 1);
+
+   payload = malloc(RECV_POOL_SIZE);
+   fail_if(!payload);
+   for (i = 0; i < RECV_POOL_SIZE; i++)
+     payload[i] = (i * 13) ^ (i >> 11);
+
+   _recv_pool_received = 0;
+   handlers[0] = ecore_event_handler_add(ECORE_CON_EVENT_CLIENT_ADD,
+       _client_recv_pool_client_add, payload);
+   handlers[1] = ecore_event_handler_add(ECORE_CON_EVENT_SERVER_DATA,
+       _client_recv_pool_server_data, payload);
+
+   server = ecore_con_server_add(ECORE_CON_REMOTE_TCP, "127.0.0.1", 1237,
+       NULL);
+   fail_if(server == NULL);
+
+   /* the connecting side reads into the pool this time */
+   client = ecore_con_server_connect(ECORE_CON_REMOTE_TCP, "127.0.0.1", 1237,
+       NULL);
+   fail_if(client == NULL);
+   ecore_con_server_recv_pool_set(client, EINA_TRUE);
+   fail_if(!ecore_con_server_recv_pool_get(client));
+
+   ecore_main_loop_begin();
+
+   fail_if(_recv_pool_received != RECV_POOL_SIZE);
+
+   ecore_con_server_del(client);
+   ecore_con_server_del(server);
+
+   for (i = 0; i < 2; i++)
+     ecore_event_handler_del(handlers[i]);
+   free(payload);
+
+   ret = ecore_con_shutdown();
+   fail_if(ret != 0);
+   ret = ecore_shutdown();
+   ret = eina_shutdown();
+}
+END_TEST
+
+#define SEGMENT_HEAD "HEAD"
+#define SEGMENT_TAIL "TAIL"
+
+static int _send_segment_freed = 0;
+
+static void
+_send_segment_free(void *data, const void *segment)
+{
+   fail_if(segment != data);
+   _send_segment_freed++;
+}
+
+static Eina_Bool
+_send_segment_server_add(void *data, int type EINA_UNUSED, void *ev)
+{
+   Ecore_Con_Event_Server_Add *event = ev;
+   const unsigned char *payload = data;
+   int ret;
+
+   ret = ecore_con_server_send(event->server, payload, strlen(SEGMENT_HEAD));
+   fail_if(ret != strlen(SEGMENT_HEAD));
+   ret = ecore_con_server_send_segment(event->server,
+                                      payload + strlen(SEGMENT_HEAD),
+                                      RECV_POOL_SIZE - strlen(SEGMENT_HEAD) - strlen(SEGMENT_TAIL),
+                                      _send_segment_free,
+                                      payload + strlen(SEGMENT_HEAD));
+   fail_if(ret <= 0);
+   /* goes out after the segment */
+   ret = ecore_con_server_send(event->server,
+                               payload + RECV_POOL_SIZE - strlen(SEGMENT_TAIL),
+                               strlen(SEGMENT_TAIL));
+   fail_if(ret != strlen(SEGMENT_TAIL));
+
+   return ECORE_CALLBACK_RENEW;
+}
+
+START_TEST(ecore_test_ecore_con_server_send_segment)
+{
+   Ecore_Con_Server *server;
+   Ecore_Con_Server *client;
+   Ecore_Event_Handler *handlers[3];
+   unsigned char *payload;
+   int ret, i;
+
+   ret = eina_init();
+   fail_if(ret != 1);
+   ret = ecore_init();
+   fail_if(ret < 1);
+   ret = ecore_con_init();
+   fail_if(ret != 1);
+
+   payload = malloc(RECV_POOL_SIZE);
+   fail_if(!payload);
+   for (i = 0; i < RECV_POOL_SIZE; i++)
+     payload[i] = (i * 7) ^ (i >> 9);
+   memcpy(payload, SEGMENT_HEAD, strlen(SEGMENT_HEAD));
+   memcpy(payload + RECV_POOL_SIZE - strlen(SEGMENT_TAIL), SEGMENT_TAIL,
+          strlen(SEGMENT_TAIL));
+
+   _recv_pool_received = 0;
+   handlers[0] = ecore_event_handler_add(ECORE_CON_EVENT_CLIENT_ADD,
+       _recv_pool_client_add, NULL);
+   handlers[1] = ecore_event_handler_add(ECORE_CON_EVENT_CLIENT_DATA,
+       _recv_pool_client_data, payload);
+   handlers[2] = ecore_event_handler_add(ECORE_CON_EVENT_SERVER_ADD,
+       _send_segment_server_add, payload);
+
+   server = ecore_con_server_add(ECORE_CON_REMOTE_TCP, "127.0.0.1", 1236,
+       NULL);
+   fail_if(server == NULL);
+
+   client = ecore_con_server_connect(ECORE_CON_REMOTE_TCP, "127.0.0.1", 1236,
+       NULL);
+   fail_if(client == NULL);
+
+   ecore_main_loop_begin();
+
+   fail_if(_recv_pool_received != RECV_POOL_SIZE);
+   fail_if(_send_segment_freed != 1);
+
+   ecore_con_server_del(client);
+   ecore_con_server_del(server);
+
+   for (i = 0; i < 3; i++)
+     ecore_event_handler_del(handlers[i]);
+   free(payload);
+
+   ret = ecore_con_shutdown();
+   fail_if(ret != 0);
+   ret = ecore_shutdown();
+   ret = eina_shutdown();
+}
+END_TEST
+
 START_TEST(ecore_test_ecore_con_init)
 {
    int ret;
@@ -308,5 +586,8 @@ void ecore_test_ecore_con(TCase *tc)
 {
    tcase_add_test(tc, ecore_test_ecore_con_init);
    tcase_add_test(tc, ecore_test_ecore_con_server);
+   tcase_add_test(tc, ecore_test_ecore_con_server_recv_pool);
+   tcase_add_test(tc, ecore_test_ecore_con_client_recv_pool);
+   tcase_add_test(tc, ecore_test_ecore_con_server_send_segment);
    tcase_add_test(tc, ecore_test_ecore_con_dns);
 }
@@ -7,6 +7,8 @@
 
 #include <Eina.h>
 #include <Edje.h>
+#define EDJE_EDIT_IS_UNSTABLE_AND_I_KNOW_ABOUT_IT
+#include <Edje_Edit.h>
 
 #include "edje_suite.h"
 #include "edje_tests_helpers.h"
@@ -150,6 +152,136 @@ START_TEST(edje_test_complex_layout)
 }
 END_TEST
 
+START_TEST(edje_test_dependencies_recalc)
+{
+   int x, y, w, h;
+   Evas *evas = EDJE_TEST_INIT_EVAS();
+   Evas_Object *obj, *still;
+
+   obj = edje_object_add(evas);
+   fail_unless(edje_object_file_set(obj, test_layout_get("complex_layout.edj"), "test_dependencies"));
+   evas_object_resize(obj, 1000, 1000);
+
+   edje_object_part_geometry_get(obj, "tail", &x, &y, &w, &h);
+   fail_if(x != 100 || y != 100);
+   fail_if(w != 100 || h != 100);
+
+   /* Moved behind edje's back: a recalc of "still" would put its object
+    * back where the part is. */
+   still = (Evas_Object *)edje_object_part_object_get(obj, "still");
+   fail_if(!still);
+   evas_object_move(still, 0, 0);
+
+   /* Only "anchor" changes state, the parts placed relative to it follow
+    * and the one that is not does not move. */
+   edje_object_signal_emit(obj, "anchor,move", "test");
+   edje_object_message_signal_process(obj);
+
+   edje_object_part_geometry_get(obj, "anchor", &x, &y, &w, &h);
+   fail_if(x != 500 || y != 500);
+   fail_if(w != 100 || h != 100);
+
+   edje_object_part_geometry_get(obj, "follower", &x, &y, &w, &h);
+   fail_if(x != 600 || y != 500);
+   fail_if(w != 100 || h != 100);
+
+   edje_object_part_geometry_get(obj, "tail", &x, &y, &w, &h);
+   fail_if(x != 600 || y != 600);
+   fail_if(w != 100 || h != 100);
+
+   edje_object_part_geometry_get(obj, "still", &x, &y, &w, &h);
+   fail_if(x != 900 || y != 900);
+   fail_if(w != 100 || h != 100);
+
+   /* the parts that moved were recalculated, "still" was not */
+   evas_object_geometry_get(edje_object_part_object_get(obj, "tail"),
+                            &x, &y, NULL, NULL);
+   fail_if(x != 600 || y != 600);
+   evas_object_geometry_get(still, &x, &y, NULL, NULL);
+   fail_if(x != 0 || y != 0);
+
+   /* a resize still goes through every part */
+   evas_object_resize(obj, 2000, 2000);
+   edje_object_part_geometry_get(obj, "still", &x, &y, &w, &h);
+   fail_if(x != 1800 || y != 1800);
+   evas_object_geometry_get(still, &x, &y, NULL, NULL);
+   fail_if(x != 1800 || y != 1800);
+
+   EDJE_TEST_FREE_EVAS();
+}
+END_TEST
+
+static void
+_signal_ran_cb(void *data, Evas_Object *obj EINA_UNUSED,
+               const char *emission EINA_UNUSED, const char *source)
+{
+   Eina_Strbuf *ran = data;
+
+   if (eina_strbuf_length_get(ran))
+     eina_strbuf_append_char(ran, ',');
+   eina_strbuf_append(ran, source);
+}
+
+/* Every program of test_signals.edj emits "ran" with its name */
+static void
+_signals_order_check(Evas_Object *obj, const char *sig, const char *src,
+                     const char *expected)
+{
+   Eina_Strbuf *ran = eina_strbuf_new();
+
+   edje_object_signal_callback_add(obj, "ran", "*", _signal_ran_cb, ran);
+   edje_object_signal_emit(obj, sig, src);
+   /* once for the signal, once for what the programs emitted */
+   edje_object_message_signal_process(obj);
+   edje_object_message_signal_process(obj);
+   edje_object_signal_callback_del_full(obj, "ran", "*", _signal_ran_cb, ran);
+
+   ck_assert_str_eq(eina_strbuf_string_get(ran), expected);
+   eina_strbuf_free(ran);
+}
+
+/* The globbed programs run once each, in the order they are declared
+ * here, then the literal ones. */
+static void
+_signals_order_checks(Evas_Object *obj)
+{
+   _signals_order_check(obj, "ba", "test", "suffix,prefix,any,class,exact");
+   _signals_order_check(obj, "bb", "test", "prefix,any,class");
+   _signals_order_check(obj, "ca", "test", "suffix,any");
+   _signals_order_check(obj, "aaaa", "test", "suffix,any");
+   _signals_order_check(obj, "ba", "other", "other_source");
+   _signals_order_check(obj, "ba", "none", "");
+}
+
+START_TEST(edje_test_signals_order)
+{
+   Evas *evas = EDJE_TEST_INIT_EVAS();
+   Evas_Object *obj;
+
+   /* edje_cc precompiled the matchers of the group */
+   obj = edje_object_add(evas);
+   fail_unless(edje_object_file_set(obj, test_layout_get("test_signals.edj"), "test_group"));
+   _signals_order_checks(obj);
+
+   EDJE_TEST_FREE_EVAS();
+}
+END_TEST
+
+START_TEST(edje_test_signals_order_edit)
+{
+   Evas *evas = EDJE_TEST_INIT_EVAS();
+   Evas_Object *obj;
+
+   /* adding a program builds the matchers again at runtime */
+   obj = edje_edit_object_add(evas);
+   fail_unless(edje_object_file_set(obj, test_layout_get("test_signals.edj"), "test_group"));
+   fail_unless(edje_edit_program_add(obj, "added"));
+   _signals_order_checks(obj);
+
+   EDJE_TEST_FREE_EVAS();
+}
+END_TEST
+
 void edje_test_edje(TCase *tc)
 {    
    tcase_add_test(tc, edje_test_edje_init);
@@ -157,4 +289,7 @@ void edje_test_edje(TCase *tc)
    tcase_add_test(tc, edje_test_edje_load);
    tcase_add_test(tc, edje_test_simple_layout_geometry);
    tcase_add_test(tc, edje_test_complex_layout);
+   tcase_add_test(tc, edje_test_dependencies_recalc);
+   tcase_add_test(tc, edje_test_signals_order);
+   tcase_add_test(tc, edje_test_signals_order_edit);
 }
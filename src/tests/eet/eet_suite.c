@@ -4,6 +4,7 @@
 
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/wait.h>
 #include <stdlib.h>
 #include <string.h>
 #include <strings.h>
@@ -1027,6 +1028,297 @@ START_TEST(eet_file_simple_write)
    eet_shutdown();
 } /* START_TEST */
 
+END_TEST
+START_TEST(eet_file_many_entries)
+{
+   Eet_File *ef;
+   char *file = strdup("/tmp/eet_suite_testXXXXXX");
+   char key[64];
+   char value[64];
+   char *test;
+   char **list;
+   int size;
+   int i;
+
+   eet_init();
+
+   fail_if(!(file = tmpnam(file)));
+
+   ef = eet_open(file, EET_FILE_MODE_WRITE);
+   fail_if(!ef);
+
+   for (i = 0; i < 20000; i++)
+     {
+        snprintf(key, sizeof (key), "keys/%i", i);
+        snprintf(value, sizeof (value), "value %i", i * 3);
+        fail_if(!eet_write(ef, key, value, strlen(value) + 1, i & 1));
+     }
+
+   eet_close(ef);
+
+   /* Lookups go through the on-disk index, in any order */
+   ef = eet_open(file, EET_FILE_MODE_READ);
+   fail_if(!ef);
+
+   for (i = 19999; i >= 0; i -= 7)
+     {
+        snprintf(key, sizeof (key), "keys/%i", i);
+        snprintf(value, sizeof (value), "value %i", i * 3);
+        test = eet_read(ef, key, &size);
+        fail_if(!test);
+        fail_if(size != (int)strlen(value) + 1);
+        fail_if(strcmp(test, value) != 0);
+        free(test);
+     }
+
+   fail_if(eet_read(ef, "keys/20000", &size) != NULL);
+   fail_if(eet_read(ef, "keys/", &size) != NULL);
+
+   /* Listing still sees entries that were never looked up */
+   fail_if(eet_num_entries(ef) != 20000);
+   list = eet_list(ef, "keys/1999*", &size);
+   fail_if(size != 11);
+   free(list);
+
+   eet_close(ef);
+
+   /* Rewriting keeps everything reachable */
+   ef = eet_open(file, EET_FILE_MODE_READ_WRITE);
+   fail_if(!ef);
+   fail_if(!eet_delete(ef, "keys/42"));
+   fail_if(!eet_write(ef, "keys/new", "new", 4, 0));
+   eet_close(ef);
+
+   ef = eet_open(file, EET_FILE_MODE_READ);
+   fail_if(!ef);
+   fail_if(eet_read(ef, "keys/42", &size) != NULL);
+   test = eet_read(ef, "keys/new", &size);
+   fail_if(!test || strcmp(test, "new") != 0);
+   free(test);
+   test = eet_read(ef, "keys/43", &size);
+   fail_if(!test || strcmp(test, "value 129") != 0);
+   free(test);
+   fail_if(eet_num_entries(ef) != 20000);
+   eet_close(ef);
+
+   fail_if(unlink(file) != 0);
+
+   eet_shutdown();
+}
+END_TEST
+START_TEST(eet_file_append)
+{
+   Eet_File *ef;
+   char *file = strdup("/tmp/eet_suite_testXXXXXX");
+   char key[64];
+   char value[64];
+   char *test;
+   struct stat st;
+   off_t written;
+   off_t appended;
+   int size;
+   int i;
+
+   eet_init();
+
+   fail_if(!(file = tmpnam(file)));
+
+   ef = eet_open(file, EET_FILE_MODE_WRITE);
+   fail_if(!ef);
+
+   for (i = 0; i < 1000; i++)
+     {
+        snprintf(key, sizeof (key), "keys/%i", i);
+        snprintf(value, sizeof (value), "value %i", i);
+        fail_if(!eet_write(ef, key, value, strlen(value) + 1, i & 1));
+     }
+
+   eet_close(ef);
+
+   /* Files are written in the classic layout unless asked otherwise */
+   ef = eet_open(file, EET_FILE_MODE_READ);
+   fail_if(!ef);
+   fail_if(eet_indexed_get(ef));
+   eet_close(ef);
+
+   ef = eet_open(file, EET_FILE_MODE_READ_WRITE);
+   fail_if(!ef);
+   fail_if(eet_indexed_set(ef, EINA_TRUE) != EET_ERROR_NONE);
+   fail_if(eet_close(ef) != EET_ERROR_NONE);
+
+   ef = eet_open(file, EET_FILE_MODE_READ);
+   fail_if(!ef);
+   fail_if(!eet_indexed_get(ef));
+   test = eet_read(ef, "keys/999", &size);
+   fail_if(!test || strcmp(test, "value 999") != 0);
+   free(test);
+   eet_close(ef);
+
+   fail_if(stat(file, &st) != 0);
+   written = st.st_size;
+
+   /* Each update only adds to the end of the file */
+   for (i = 0; i < 3; i++)
+     {
+        ef = eet_open(file, EET_FILE_MODE_READ_WRITE);
+        fail_if(!ef);
+        fail_if(eet_append_set(ef, EINA_TRUE) != EET_ERROR_NONE);
+        fail_if(!eet_append_get(ef));
+
+        snprintf(value, sizeof (value), "update %i", i);
+        fail_if(!eet_write(ef, "keys/10", value, strlen(value) + 1, 1));
+        fail_if(!eet_write(ef, "keys/new", value, strlen(value) + 1, 0));
+        snprintf(key, sizeof (key), "keys/%i", 20 + i);
+        fail_if(!eet_delete(ef, key));
+
+        fail_if(eet_close(ef) != EET_ERROR_NONE);
+
+        fail_if(stat(file, &st) != 0);
+        fail_if(st.st_size <= written);
+        written = st.st_size;
+     }
+   appended = written;
+
+   ef = eet_open(file, EET_FILE_MODE_READ);
+   fail_if(!ef);
+   test = eet_read(ef, "keys/10", &size);
+   fail_if(!test || strcmp(test, "update 2") != 0);
+   free(test);
+   test = eet_read(ef, "keys/new", &size);
+   fail_if(!test || strcmp(test, "update 2") != 0);
+   free(test);
+   fail_if(eet_read(ef, "keys/21", &size) != NULL);
+   test = eet_read(ef, "keys/999", &size);
+   fail_if(!test || strcmp(test, "value 999") != 0);
+   free(test);
+   fail_if(eet_num_entries(ef) != 998);
+   eet_close(ef);
+
+   /* Compacting drops the stale copies and keeps the content */
+   ef = eet_open(file, EET_FILE_MODE_READ_WRITE);
+   fail_if(!ef);
+   fail_if(eet_compact(ef) != EET_ERROR_NONE);
+   eet_close(ef);
+
+   fail_if(stat(file, &st) != 0);
+   fail_if(st.st_size >= appended);
+
+   ef = eet_open(file, EET_FILE_MODE_READ);
+   fail_if(!ef);
+   test = eet_read(ef, "keys/10", &size);
+   fail_if(!test || strcmp(test, "update 2") != 0);
+   free(test);
+   fail_if(eet_read(ef, "keys/22", &size) != NULL);
+   fail_if(eet_num_entries(ef) != 998);
+   eet_close(ef);
+
+   fail_if(unlink(file) != 0);
+
+   eet_shutdown();
+}
+END_TEST
+
+/* appends to file, and tells whether the file is the same one after */
+static Eina_Bool
+_eet_file_append_in_place(const char *file, const char *value)
+{
+   Eet_File *ef;
+   struct stat st;
+   ino_t inode;
+   char *test;
+   int size;
+
+   fail_if(stat(file, &st) != 0);
+   inode = st.st_ino;
+
+   ef = eet_open(file, EET_FILE_MODE_READ_WRITE);
+   fail_if(!ef);
+   fail_if(eet_append_set(ef, EINA_TRUE) != EET_ERROR_NONE);
+   fail_if(!eet_write(ef, "keys/10", value, strlen(value) + 1, 0));
+   fail_if(eet_close(ef) != EET_ERROR_NONE);
+
+   ef = eet_open(file, EET_FILE_MODE_READ);
+   fail_if(!ef);
+   test = eet_read(ef, "keys/10", &size);
+   fail_if(!test || strcmp(test, value) != 0);
+   free(test);
+   fail_if(eet_num_entries(ef) != 100);
+   eet_close(ef);
+
+   fail_if(stat(file, &st) != 0);
+   return st.st_ino == inode;
+}
+
+START_TEST(eet_file_append_locked)
+{
+   Eet_File *ef;
+   char *file = strdup("/tmp/eet_suite_testXXXXXX");
+   char key[64];
+   char value[64];
+   struct flock fl;
+   int locked[2];
+   int done[2];
+   pid_t pid;
+   char c;
+   int fd;
+   int i;
+
+   eet_init();
+
+   fail_if(!(file = tmpnam(file)));
+
+   ef = eet_open(file, EET_FILE_MODE_WRITE);
+   fail_if(!ef);
+   fail_if(eet_indexed_set(ef, EINA_TRUE) != EET_ERROR_NONE);
+   for (i = 0; i < 100; i++)
+     {
+        snprintf(key, sizeof (key), "keys/%i", i);
+        snprintf(value, sizeof (value), "value %i", i);
+        fail_if(!eet_write(ef, key, value, strlen(value) + 1, 0));
+     }
+   fail_if(eet_close(ef) != EET_ERROR_NONE);
+
+   fail_if(!_eet_file_append_in_place(file, "alone"));
+
+   /* another process reading the header, as eet_open() does */
+   fail_if(pipe(locked) != 0);
+   fail_if(pipe(done) != 0);
+   pid = fork();
+   fail_if(pid < 0);
+   if (pid == 0)
+     {
+        /* reading done gets 0 if the test dies before releasing it */
+        close(done[1]);
+        fd = open(file, O_RDONLY);
+        if (fd < 0) _exit(1);
+        memset(&fl, 0, sizeof (fl));
+        fl.l_type = F_RDLCK;
+        fl.l_whence = SEEK_SET;
+        fl.l_len = sizeof (int);
+        if (fcntl(fd, F_SETLK, &fl) != 0) _exit(1);
+        if (write(locked[1], "l", 1) != 1) _exit(1);
+        if (read(done[0], &c, 1) != 1) _exit(1);
+        _exit(0);
+     }
+   close(done[0]);
+   fail_if(read(locked[0], &c, 1) != 1);
+
+   /* then the header is left alone, the file is rewritten */
+   fail_if(_eet_file_append_in_place(file, "while read"));
+
+   fail_if(write(done[1], "d", 1) != 1);
+   fail_if(waitpid(pid, &i, 0) != pid);
+   fail_if(!WIFEXITED(i) || (WEXITSTATUS(i) != 0));
+   close(locked[0]);
+   close(locked[1]);
+   close(done[1]);
+
+   fail_if(!_eet_file_append_in_place(file, "alone again"));
+
+   fail_if(unlink(file) != 0);
+
+   eet_shutdown();
+}
 END_TEST
 START_TEST(eet_file_data_test)
 {
@@ -2773,6 +3065,9 @@ eet_suite(void)
 
    tc = tcase_create("Eet File");
    tcase_add_test(tc, eet_file_simple_write);
+   tcase_add_test(tc, eet_file_many_entries);
+   tcase_add_test(tc, eet_file_append);
+   tcase_add_test(tc, eet_file_append_locked);
    tcase_add_test(tc, eet_file_data_test);
    tcase_add_test(tc, eet_file_data_dump_test);
    tcase_add_test(tc, eet_file_fp);
@@ -20,6 +20,7 @@ struct _Efreet_Test_Case
 static const Efreet_Test_Case etc[] = {
   { "Efreet", efreet_test_efreet },
   { "Efreet Cache", efreet_test_efreet_cache },
+  { "Efreet Mime", efreet_test_efreet_mime },
   { NULL, NULL }
 };
 
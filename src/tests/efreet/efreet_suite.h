@@ -5,6 +5,7 @@
 
 void efreet_test_efreet(TCase *tc);
 void efreet_test_efreet_cache(TCase *tc);
+void efreet_test_efreet_mime(TCase *tc);
 
 
 #endif /* _EFREET_SUITE_H */
@@ -0,0 +1,349 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <Eet.h>
+#include <Efreet.h>
+#include <Efreet_Mime.h>
+
+#include "efreet_suite.h"
+#include "efreet_cache_private.h"
+
+/*
+ * Word offsets in the header of the mime cache, see Efreet_Mime_Cache in
+ * efreet_mime.c. Only used to break a cache on purpose.
+ */
+#define CACHE_SIZE 3
+#define CACHE_STRINGS_SIZE 7
+#define CACHE_MIMES 8
+#define CACHE_EXTS 10
+#define CACHE_EXTS_SIZE 11
+#define CACHE_GLOBS 12
+#define CACHE_SUFFIXES 18
+#define CACHE_SUFFIXES_COUNT 19
+#define CACHE_PATTERNS 20
+#define CACHE_ENTRIES 24
+
+static Eina_Tmpstr *root = NULL;
+
+static const struct
+{
+   const char *name;
+   const char *mime;
+} globs[] = {
+   { "file.eftest", "text/x-eftest-ext" },
+   { "FILE.EFTEST", "text/x-eftest-ext" },
+   { "EfTestMakefile", "text/x-eftest-literal" },
+   { "EFTESTMAKEFILE", "text/x-eftest-literal" },
+   { "backup-eftest~", "text/x-eftest-suffix" },
+   { "Eftest1.log", "text/x-eftest-pattern" },
+   { "eftest-unknown", NULL }
+};
+
+static const struct
+{
+   const char *name;
+   const char *data;
+   unsigned int size;
+   const char *mime;
+} magics[] = {
+   { "magic.dat", "EFTM and more", 13, "application/x-eftest-magic" },
+   { "nested.dat", "NS..ok", 6, "application/x-eftest-nested" },
+   { "half.dat", "NS..no", 6, NULL },
+   { "text.dat", "just some text", 14, NULL }
+};
+
+static void
+_file_write(const char *name, const char *data, unsigned int size)
+{
+   char path[PATH_MAX];
+   FILE *f;
+
+   snprintf(path, sizeof(path), "%s/%s", root, name);
+   f = fopen(path, "wb");
+   fail_if(!f);
+   fail_if(fwrite(data, 1, size, f) != size);
+   fclose(f);
+}
+
+static void
+_mime_data_create(void)
+{
+   static const char glob_data[] =
+      "# globs of efreet_test_efreet_mime\n"
+      "text/x-eftest-ext:*.eftest\n"
+      "text/x-eftest-literal:EfTestMakefile\n"
+      "text/x-eftest-suffix:*-eftest~\n"
+      "text/x-eftest-pattern:[Ee]ftest*.log\n";
+   static const char magic_data[] =
+      "MIME-Magic\0\n"
+      "[60:application/x-eftest-magic]\n"
+      ">0=\0\4EFTM\n"
+      "[50:application/x-eftest-nested]\n"
+      ">0=\0\2NS\n"
+      "1>4=\0\2ok\n";
+   char path[PATH_MAX];
+   unsigned int i;
+
+   fail_if(!eina_file_mkdtemp("efreet_test_mime_XXXXXX", &root));
+
+   /* only our data, not the data of the system the test runs on */
+   snprintf(path, sizeof(path), "%s/data", root);
+   setenv("XDG_DATA_HOME", path, 1);
+   fail_if(mkdir(path, 0755) != 0);
+   snprintf(path, sizeof(path), "%s/none", root);
+   setenv("XDG_DATA_DIRS", path, 1);
+   snprintf(path, sizeof(path), "%s/cache", root);
+   setenv("XDG_CACHE_HOME", path, 1);
+   fail_if(mkdir(path, 0700) != 0);
+   snprintf(path, sizeof(path), "%s/cache/efreet", root);
+   fail_if(mkdir(path, 0700) != 0);
+   snprintf(path, sizeof(path), "%s/data/mime", root);
+   fail_if(mkdir(path, 0755) != 0);
+
+   _file_write("data/mime/globs", glob_data, sizeof(glob_data) - 1);
+   _file_write("data/mime/magic", magic_data, sizeof(magic_data) - 1);
+   for (i = 0; i < sizeof(magics) / sizeof(magics[0]); i++)
+     _file_write(magics[i].name, magics[i].data, magics[i].size);
+
+   fail_if(!efreet_init());
+}
+
+static void
+_tree_remove(const char *path)
+{
+   Eina_Iterator *it;
+   const char *file;
+
+   it = eina_file_ls(path);
+   EINA_ITERATOR_FOREACH(it, file)
+     {
+        if (unlink(file) != 0) _tree_remove(file);
+        eina_stringshare_del(file);
+     }
+   eina_iterator_free(it);
+   rmdir(path);
+}
+
+static void
+_mime_data_remove(void)
+{
+   efreet_shutdown();
+   _tree_remove(root);
+   eina_tmpstr_del(root);
+   root = NULL;
+}
+
+static void
+_mime_str_eq(const char *got, const char *expected)
+{
+   if (!expected)
+     fail_if(got != NULL);
+   else
+     fail_if((!got) || (strcmp(got, expected)));
+}
+
+/* what efreet_mime finds, whether it parsed the files or mapped a cache */
+static void
+_mime_check(void)
+{
+   char path[PATH_MAX];
+   unsigned int i;
+
+   fail_if(!efreet_mime_init());
+   for (i = 0; i < sizeof(globs) / sizeof(globs[0]); i++)
+     _mime_str_eq(efreet_mime_globs_type_get(globs[i].name), globs[i].mime);
+   for (i = 0; i < sizeof(magics) / sizeof(magics[0]); i++)
+     {
+        snprintf(path, sizeof(path), "%s/%s", root, magics[i].name);
+        _mime_str_eq(efreet_mime_magic_type_get(path), magics[i].mime);
+     }
+   efreet_mime_shutdown();
+}
+
+static unsigned int *
+_cache_read(const char *path, unsigned int *size)
+{
+   unsigned int *c;
+   struct stat st;
+   FILE *f;
+
+   fail_if(stat(path, &st) != 0);
+   *size = st.st_size;
+   c = malloc(*size);
+   fail_if(!c);
+   f = fopen(path, "rb");
+   fail_if(!f);
+   fail_if(fread(c, 1, *size, f) != *size);
+   fclose(f);
+
+   return c;
+}
+
+static Eina_Bool
+_cache_valid(const unsigned int *c, unsigned int size)
+{
+   char path[PATH_MAX];
+   Eina_Bool ret;
+   FILE *f;
+
+   snprintf(path, sizeof(path), "%s/broken.cache", root);
+   f = fopen(path, "wb");
+   fail_if(!f);
+   fail_if(fwrite(c, 1, size, f) != size);
+   fclose(f);
+   ret = efreet_mime_cache_valid(path);
+   unlink(path);
+
+   return ret;
+}
+
+START_TEST(efreet_test_efreet_mime_globs_magic)
+{
+   _mime_data_create();
+
+   /* no cache, the files are parsed */
+   unlink(efreet_mime_cache_file());
+   _mime_check();
+
+   /* the same from the cache efreetd writes */
+   fail_if(!efreet_mime_cache_write(efreet_mime_cache_file()));
+   fail_if(!efreet_mime_cache_valid(efreet_mime_cache_file()));
+   _mime_check();
+
+   _mime_data_remove();
+}
+END_TEST
+
+START_TEST(efreet_test_efreet_mime_cache_corrupt)
+{
+   unsigned int *c, *copy;
+   unsigned int size, i;
+   char *b;
+
+   _mime_data_create();
+   fail_if(!efreet_mime_cache_write(efreet_mime_cache_file()));
+   c = _cache_read(efreet_mime_cache_file(), &size);
+   copy = malloc(size);
+   fail_if(!copy);
+   b = (char *)copy;
+   fail_if(!_cache_valid(c, size));
+
+   /* truncated, as it is and with the size it claims fixed */
+   fail_if(_cache_valid(c, size / 2));
+   memcpy(copy, c, size / 2);
+   copy[CACHE_SIZE] = size / 2;
+   fail_if(_cache_valid(copy, size / 2));
+
+   /* a mime id past the mimes */
+   memcpy(copy, c, size);
+   ((unsigned int *)(b + copy[CACHE_GLOBS]))[1] = 0xffff;
+   fail_if(_cache_valid(copy, size));
+
+   /* a mime string past the strings */
+   memcpy(copy, c, size);
+   ((unsigned int *)(b + copy[CACHE_MIMES]))[0] = copy[CACHE_STRINGS_SIZE];
+   fail_if(_cache_valid(copy, size));
+
+   /* a glob index past the globs */
+   memcpy(copy, c, size);
+   ((unsigned int *)(b + copy[CACHE_PATTERNS]))[0] = 0xffff;
+   fail_if(_cache_valid(copy, size));
+
+   /* a hash table without an empty bucket, lookups would never end */
+   memcpy(copy, c, size);
+   for (i = 0; i < copy[CACHE_EXTS_SIZE]; i++)
+     ((unsigned int *)(b + copy[CACHE_EXTS]))[i * 2] = 1;
+   fail_if(_cache_valid(copy, size));
+
+   /* a suffix trie with a loop in it, or a child past the nodes */
+   fail_if(c[CACHE_SUFFIXES_COUNT] < 2);
+   memcpy(copy, c, size);
+   ((unsigned int *)(b + copy[CACHE_SUFFIXES]))[4 + 1] = 1;
+   fail_if(_cache_valid(copy, size));
+   memcpy(copy, c, size);
+   ((unsigned int *)(b + copy[CACHE_SUFFIXES]))[0] = copy[CACHE_SUFFIXES_COUNT];
+   fail_if(_cache_valid(copy, size));
+
+   /* a magic value past the strings */
+   memcpy(copy, c, size);
+   ((unsigned int *)(b + copy[CACHE_ENTRIES]))[4] = copy[CACHE_STRINGS_SIZE];
+   fail_if(_cache_valid(copy, size));
+
+   /* a broken cache is not used, the files are parsed instead */
+   memcpy(copy, c, size);
+   ((unsigned int *)(b + copy[CACHE_GLOBS]))[1] = 0xffff;
+   fail_if(_cache_valid(copy, size));
+   {
+      FILE *f;
+
+      f = fopen(efreet_mime_cache_file(), "wb");
+      fail_if(!f);
+      fail_if(fwrite(copy, 1, size, f) != size);
+      fclose(f);
+   }
+   _mime_check();
+
+   free(copy);
+   free(c);
+   _mime_data_remove();
+}
+END_TEST
+
+static void
+_watch_path_eq(const char *path, const char *expected)
+{
+   char buf[PATH_MAX];
+   char *watch;
+
+   snprintf(buf, sizeof(buf), "%s%s", root, expected);
+   watch = efreet_cache_watch_path_get(path);
+   fail_if(!watch);
+   fail_if(strcmp(watch, buf), "watching %s instead of %s", watch, buf);
+   free(watch);
+}
+
+START_TEST(efreet_test_efreet_mime_dir_created)
+{
+   static const char late_data[] = "text/x-eftest-late:*.eftestlate\n";
+   char path[PATH_MAX], dir[PATH_MAX];
+
+   _mime_data_create();
+   fail_if(!efreet_mime_cache_write(efreet_mime_cache_file()));
+
+   /* XDG_DATA_DIRS is there but doesn't exist, efreetd has to watch the
+    * nearest parent and follow the mime dir down as it is created */
+   snprintf(dir, sizeof(dir), "%s/none", root);
+   snprintf(path, sizeof(path), "%s/none/mime", root);
+   _watch_path_eq(path, "");
+   fail_if(mkdir(dir, 0755) != 0);
+   _watch_path_eq(path, "/none");
+   fail_if(mkdir(path, 0755) != 0);
+   _watch_path_eq(path, "/none/mime");
+   snprintf(path, sizeof(path), "%s/data/mime", root);
+   _watch_path_eq(path, "/data/mime");
+
+   /* the cache written before knows nothing of it and is not used */
+   _file_write("none/mime/globs", late_data, sizeof(late_data) - 1);
+   fail_if(!efreet_mime_init());
+   _mime_str_eq(efreet_mime_globs_type_get("file.eftestlate"),
+                "text/x-eftest-late");
+   efreet_mime_shutdown();
+   _mime_check();
+
+   _mime_data_remove();
+}
+END_TEST
+
+void efreet_test_efreet_mime(TCase *tc)
+{
+   tcase_add_test(tc, efreet_test_efreet_mime_globs_magic);
+   tcase_add_test(tc, efreet_test_efreet_mime_cache_corrupt);
+   tcase_add_test(tc, efreet_test_efreet_mime_dir_created);
+}
@@ -324,6 +324,218 @@ START_TEST(eina_hash_string_fuzze)
 }
 END_TEST
 
+START_TEST(eina_hash_flat_simple)
+{
+   Eina_Hash *hash = NULL;
+   Eina_Iterator *it;
+   int *test;
+   int array[] = { 1, 42, 4, 5, 6 };
+   int count = 0;
+
+   fail_if(eina_init() != 2);
+
+   hash = eina_hash_string_flat_new(NULL);
+   fail_if(hash == NULL);
+
+   fail_if(eina_hash_add(hash, "1", &array[0]) != EINA_TRUE);
+   fail_if(eina_hash_add(hash, "42", &array[1]) != EINA_TRUE);
+   fail_if(eina_hash_direct_add(hash, "4", &array[2]) != EINA_TRUE);
+   fail_if(eina_hash_direct_add(hash, "5", &array[3]) != EINA_TRUE);
+   fail_if(eina_hash_add(hash, "", "") != EINA_TRUE);
+
+   test = eina_hash_find(hash, "4");
+   fail_if(!test);
+   fail_if(*test != 4);
+
+   test = eina_hash_find(hash, "42");
+   fail_if(!test);
+   fail_if(*test != 42);
+
+   eina_hash_foreach(hash, eina_foreach_check, NULL);
+
+   it = eina_hash_iterator_key_new(hash);
+   EINA_ITERATOR_FOREACH(it, test)
+     count++;
+   eina_iterator_free(it);
+   fail_if(count != 5);
+
+   test = eina_hash_modify(hash, "5", &array[4]);
+   fail_if(!test);
+   fail_if(*test != 5);
+
+   test = eina_hash_find(hash, "5");
+   fail_if(!test);
+   fail_if(*test != 6);
+
+   fail_if(eina_hash_population(hash) != 5);
+
+   fail_if(eina_hash_find(hash, "120") != NULL);
+
+   fail_if(eina_hash_set(hash, "120", &array[0]) != NULL);
+   fail_if(eina_hash_set(hash, "120", NULL) != &array[0]);
+   fail_if(eina_hash_find(hash, "120") != NULL);
+
+   fail_if(eina_hash_move(hash, "42", "43") != EINA_TRUE);
+   fail_if(eina_hash_find(hash, "42") != NULL);
+   fail_if(eina_hash_find(hash, "43") != &array[1]);
+
+   fail_if(eina_hash_del(hash, "5", NULL) != EINA_TRUE);
+   fail_if(eina_hash_find(hash, "5") != NULL);
+
+   fail_if(eina_hash_del(hash, NULL, &array[2]) != EINA_TRUE);
+   fail_if(eina_hash_find(hash, "4") != NULL);
+
+   fail_if(eina_hash_del(hash, NULL, &array[2]) != EINA_FALSE);
+
+   fail_if(eina_hash_del(hash, "1", NULL) != EINA_TRUE);
+   fail_if(eina_hash_del(hash, "43", NULL) != EINA_TRUE);
+   fail_if(eina_hash_del(hash, "", NULL) != EINA_TRUE);
+   fail_if(eina_hash_population(hash) != 0);
+   fail_if(eina_hash_del(hash, "1", NULL) != EINA_FALSE);
+
+   fail_if(eina_hash_add(hash, "7", &array[0]) != EINA_TRUE);
+   fail_if(eina_hash_add(hash, "7", &array[1]) != EINA_TRUE);
+   fail_if(eina_hash_del(hash, "7", &array[0]) != EINA_TRUE);
+   fail_if(eina_hash_find(hash, "7") != &array[1]);
+
+   eina_hash_free(hash);
+
+   fail_if(eina_shutdown() != 1);
+}
+END_TEST
+
+START_TEST(eina_hash_flat_all_int)
+{
+   Eina_Hash *hash;
+   int64_t j[] = { 4321312301243122, 6, 7, 128 };
+   int i[] = { 42, 6, 7, 0 };
+   const char *s;
+   int64_t *test2;
+   int *test;
+   void *p;
+   int it;
+
+   fail_if(eina_init() != 2);
+
+   hash = eina_hash_int32_flat_new(NULL);
+   fail_if(hash == NULL);
+
+   for (it = 0; it < 4; ++it)
+     fail_if(eina_hash_add(hash, &i[it], &i[it]) != EINA_TRUE);
+
+   fail_if(eina_hash_del(hash, &i[1], &i[1]) != EINA_TRUE);
+   test = eina_hash_find(hash, &i[2]);
+   fail_if(test != &i[2]);
+
+   test = eina_hash_find(hash, &i[3]);
+   fail_if(test != &i[3]);
+
+   eina_hash_free(hash);
+
+   hash = eina_hash_int64_flat_new(NULL);
+   fail_if(hash == NULL);
+
+   for (it = 0; it < 4; ++it)
+     fail_if(eina_hash_add(hash, &j[it], &j[it]) != EINA_TRUE);
+
+   fail_if(eina_hash_del(hash, &j[1], &j[1]) != EINA_TRUE);
+   test2 = eina_hash_find(hash, &j[0]);
+   fail_if(test2 != &j[0]);
+
+   eina_hash_free(hash);
+
+   hash = eina_hash_pointer_flat_new(NULL);
+   fail_if(hash == NULL);
+
+   for (it = 0; it < 4; ++it)
+     {
+        p = &i[it];
+        fail_if(eina_hash_add(hash, &p, &j[it]) != EINA_TRUE);
+     }
+
+   p = &i[1];
+   fail_if(eina_hash_find(hash, &p) != &j[1]);
+
+   eina_hash_free(hash);
+
+   hash = eina_hash_stringshared_flat_new(NULL);
+   fail_if(hash == NULL);
+
+   s = eina_stringshare_add("key");
+   fail_if(eina_hash_add(hash, s, &i[0]) != EINA_TRUE);
+   fail_if(eina_hash_find(hash, s) != &i[0]);
+   fail_if(eina_hash_del(hash, s, NULL) != EINA_TRUE);
+   eina_stringshare_del(s);
+
+   eina_hash_free(hash);
+
+   fail_if(eina_shutdown() != 1);
+}
+END_TEST
+
+START_TEST(eina_hash_flat_fuzze)
+{
+   Eina_Hash *hash, *ref;
+   Eina_Iterator *it;
+   unsigned int *r;
+   unsigned int i;
+   unsigned int seed;
+   int count;
+
+   eina_init();
+
+   seed = time(NULL);
+   srand(seed);
+
+   /* A small key range so adds and deletes hit existing keys often and
+      the table keeps growing and shrinking back to empty. */
+   hash = eina_hash_int32_flat_new(NULL);
+   ref = eina_hash_int32_new(free);
+
+   for (i = 0; i < 200000; ++i)
+     {
+        unsigned int tr;
+
+        tr = rand() % 4096;
+        r = eina_hash_find(ref, &tr);
+        fail_if(eina_hash_find(hash, &tr) != r);
+
+        if (r)
+          {
+             fail_if(eina_hash_del(hash, &tr, NULL) != EINA_TRUE);
+             eina_hash_del(ref, &tr, r);
+          }
+        else
+          {
+             r = malloc(sizeof (unsigned int));
+             *r = tr;
+             fail_if(eina_hash_add(hash, &tr, r) != EINA_TRUE);
+             eina_hash_direct_add(ref, r, r);
+          }
+
+        fail_if(eina_hash_population(hash) != eina_hash_population(ref));
+     }
+
+   count = 0;
+   it = eina_hash_iterator_tuple_new(hash);
+   EINA_ITERATOR_FOREACH(it, r)
+     {
+        Eina_Hash_Tuple *t = (Eina_Hash_Tuple *)r;
+
+        fail_if(*(unsigned int *)t->key != *(unsigned int *)t->data);
+        fail_if(eina_hash_find(ref, t->key) != t->data);
+        count++;
+     }
+   eina_iterator_free(it);
+   fail_if(count != eina_hash_population(ref));
+
+   eina_hash_free(hash);
+   eina_hash_free(ref);
+
+   eina_shutdown();
+}
+END_TEST
+
 START_TEST(eina_hash_seed)
 {
    eina_init();
@@ -343,4 +555,7 @@ void eina_test_hash(TCase *tc)
    tcase_add_test(tc, eina_hash_seed);
    tcase_add_test(tc, eina_hash_int32_fuzze);
    tcase_add_test(tc, eina_hash_string_fuzze);
+   tcase_add_test(tc, eina_hash_flat_simple);
+   tcase_add_test(tc, eina_hash_flat_all_int);
+   tcase_add_test(tc, eina_hash_flat_fuzze);
 }
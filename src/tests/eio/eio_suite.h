@@ -0,0 +1,8 @@
+#ifndef _EIO_SUITE_H
+#define _EIO_SUITE_H
+
+#include <check.h>
+
+void eio_test_dir_copy(TCase *tc);
+
+#endif
@@ -0,0 +1,245 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <Eina.h>
+#include <Ecore.h>
+#include <Eio.h>
+
+#include "eio_suite.h"
+
+#define DIR_COUNT 7
+#define FILE_COUNT 200
+
+static int copy_error = 0;
+
+static void
+_done_cb(void *data EINA_UNUSED, Eio_File *handler EINA_UNUSED)
+{
+   ecore_main_loop_quit();
+}
+
+static void
+_error_cb(void *data EINA_UNUSED, Eio_File *handler EINA_UNUSED, int error)
+{
+   copy_error = error;
+   ecore_main_loop_quit();
+}
+
+static Eina_Bool
+_file_write(const char *path, int seed, size_t size)
+{
+   unsigned char *buffer;
+   size_t i;
+   int fd;
+
+   buffer = malloc(size + 1);
+   if (!buffer) return EINA_FALSE;
+   for (i = 0; i < size; i++)
+     buffer[i] = (seed * 31 + i) & 0xff;
+
+   fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+   if (fd < 0)
+     {
+        free(buffer);
+        return EINA_FALSE;
+     }
+   if (write(fd, buffer, size) != (ssize_t)size)
+     {
+        close(fd);
+        free(buffer);
+        return EINA_FALSE;
+     }
+   close(fd);
+   free(buffer);
+   return EINA_TRUE;
+}
+
+/* a few directories, some nested, holding files of all sizes */
+static Eina_Bool
+_tree_build(const char *root)
+{
+   char path[PATH_MAX];
+   int i;
+
+   if (mkdir(root, 0755) != 0) return EINA_FALSE;
+   for (i = 0; i < DIR_COUNT; i++)
+     {
+        if (i % 3)
+          snprintf(path, sizeof (path), "%s/%i/%i", root, i - i % 3, i);
+        else
+          snprintf(path, sizeof (path), "%s/%i", root, i);
+        if (mkdir(path, 0755) != 0) return EINA_FALSE;
+     }
+   for (i = 0; i < FILE_COUNT; i++)
+     {
+        int d = i % DIR_COUNT;
+
+        if (d % 3)
+          snprintf(path, sizeof (path), "%s/%i/%i/%i", root, d - d % 3, d, i);
+        else
+          snprintf(path, sizeof (path), "%s/%i/%i", root, d, i);
+        /* empty, small and larger than a copy buffer */
+        if (!_file_write(path, i, (i * 977) % (3 * 65536 + 1)))
+          return EINA_FALSE;
+     }
+   snprintf(path, sizeof (path), "%s/0/link", root);
+   if (symlink("3", path) != 0) return EINA_FALSE;
+
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_file_same(const char *a, const char *b)
+{
+   Eina_File *fa, *fb;
+   void *ma, *mb;
+   Eina_Bool r = EINA_FALSE;
+
+   fa = eina_file_open(a, EINA_FALSE);
+   fb = eina_file_open(b, EINA_FALSE);
+   if (!fa || !fb) goto end;
+   if (eina_file_size_get(fa) != eina_file_size_get(fb)) goto end;
+   if (eina_file_size_get(fa) == 0)
+     {
+        r = EINA_TRUE;
+        goto end;
+     }
+
+   ma = eina_file_map_all(fa, EINA_FILE_SEQUENTIAL);
+   mb = eina_file_map_all(fb, EINA_FILE_SEQUENTIAL);
+   if (ma && mb)
+     r = !memcmp(ma, mb, eina_file_size_get(fa));
+   if (ma) eina_file_map_free(fa, ma);
+   if (mb) eina_file_map_free(fb, mb);
+
+ end:
+   if (fa) eina_file_close(fa);
+   if (fb) eina_file_close(fb);
+   return r;
+}
+
+/* returns the number of entries of the tree at src that are also in dst,
+ * with the same type and content, -1 on the first mismatch */
+static int
+_tree_compare(const char *src, const char *dst)
+{
+   Eina_Iterator *it;
+   Eina_File_Direct_Info *info;
+   int count = 0;
+
+   it = eina_file_direct_ls(src);
+   if (!it) return -1;
+   EINA_ITERATOR_FOREACH(it, info)
+     {
+        char path[PATH_MAX];
+        struct stat sst, dst_st;
+
+        snprintf(path, sizeof (path), "%s/%s", dst, info->path + info->name_start);
+        if (lstat(info->path, &sst) || lstat(path, &dst_st)) goto fail;
+        if ((sst.st_mode & S_IFMT) != (dst_st.st_mode & S_IFMT)) goto fail;
+
+        if (S_ISDIR(sst.st_mode))
+          {
+             int sub = _tree_compare(info->path, path);
+
+             if (sub < 0) goto fail;
+             count += sub;
+          }
+        else if (S_ISLNK(sst.st_mode))
+          {
+             char a[PATH_MAX], b[PATH_MAX];
+             ssize_t la, lb;
+
+             la = readlink(info->path, a, sizeof (a));
+             lb = readlink(path, b, sizeof (b));
+             if ((la < 0) || (la != lb) || memcmp(a, b, la)) goto fail;
+          }
+        else if (!_file_same(info->path, path))
+          goto fail;
+        count++;
+     }
+   eina_iterator_free(it);
+   return count;
+
+ fail:
+   eina_iterator_free(it);
+   return -1;
+}
+
+static void
+_tree_del(const char *root)
+{
+   char path[PATH_MAX];
+
+   /* eio_dir_unlink() leaves links behind */
+   snprintf(path, sizeof (path), "%s/src/0/link", root);
+   unlink(path);
+   snprintf(path, sizeof (path), "%s/dst/0/link", root);
+   unlink(path);
+
+   if (eio_dir_unlink(root, NULL, NULL, _done_cb, _error_cb, NULL))
+     ecore_main_loop_begin();
+   rmdir(root);
+}
+
+static void
+_dir_copy_check(unsigned int concurrency)
+{
+   Eina_Tmpstr *root;
+   char src[PATH_MAX], dst[PATH_MAX];
+   int copied, original;
+
+   fail_if(!eina_file_mkdtemp("eio_test_XXXXXX", &root));
+   snprintf(src, sizeof (src), "%s/src", root);
+   snprintf(dst, sizeof (dst), "%s/dst", root);
+   fail_if(!_tree_build(src));
+
+   copy_error = 0;
+   eio_dir_copy_concurrency_set(concurrency);
+   fail_if(eio_dir_copy_concurrency_get() != concurrency);
+   fail_if(!eio_dir_copy(src, dst, NULL, NULL, _done_cb, _error_cb, NULL));
+   ecore_main_loop_begin();
+   eio_dir_copy_concurrency_set(1);
+   fail_if(copy_error != 0, "copy failed: %s", strerror(copy_error));
+
+   /* everything was copied and nothing else */
+   original = _tree_compare(src, src);
+   copied = _tree_compare(src, dst);
+   fail_if(original != FILE_COUNT + DIR_COUNT + 1);
+   fail_if(copied != original);
+   fail_if(_tree_compare(dst, src) != original);
+
+   _tree_del(root);
+   eina_tmpstr_del(root);
+}
+
+START_TEST(eio_test_dir_copy_sequential)
+{
+   fail_if(eio_init() < 1);
+   _dir_copy_check(1);
+   eio_shutdown();
+}
+END_TEST
+
+START_TEST(eio_test_dir_copy_concurrent)
+{
+   fail_if(eio_init() < 1);
+   _dir_copy_check(4);
+   _dir_copy_check(FILE_COUNT * 2);
+   eio_shutdown();
+}
+END_TEST
+
+void
+eio_test_dir_copy(TCase *tc)
+{
+   tcase_add_test(tc, eio_test_dir_copy_sequential);
+   tcase_add_test(tc, eio_test_dir_copy_concurrent);
+}
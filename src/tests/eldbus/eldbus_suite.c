@@ -19,6 +19,7 @@ struct _Eldbus_Test_Case
 
 static const Eldbus_Test_Case etc[] = {
   { "eldbus_init", eldbus_test_eldbus_init },
+  { "eldbus_signal_handler", eldbus_test_signal_handler },
   { }
 };
 
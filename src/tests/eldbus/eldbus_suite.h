@@ -4,5 +4,6 @@
 #include <check.h>
 
 void eldbus_test_eldbus_init(TCase *tc);
+void eldbus_test_signal_handler(TCase *tc);
 
 #endif
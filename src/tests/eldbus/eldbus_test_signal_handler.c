@@ -0,0 +1,351 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include <Eina.h>
+#include <Ecore.h>
+#include <Eldbus.h>
+
+#include "eldbus_suite.h"
+
+#define PATH_A "/org/enlightenment/test/a"
+#define PATH_B "/org/enlightenment/test/b"
+#define IFACE "org.enlightenment.Test"
+#define IFACE_OTHER "org.enlightenment.Other"
+
+enum { PING, PONG };
+
+static const Eldbus_Signal signals[] = {
+   [PING] = { "Ping", NULL, 0 },
+   [PONG] = { "Pong", NULL, 0 },
+   { }
+};
+
+static const Eldbus_Service_Interface_Desc iface_desc = {
+   IFACE, NULL, signals, NULL, NULL, NULL
+};
+
+static const Eldbus_Service_Interface_Desc other_desc = {
+   IFACE_OTHER, NULL, signals, NULL, NULL, NULL
+};
+
+static Eldbus_Connection *conn = NULL;
+static pid_t bus_pid = 0;
+
+/* ids of the handlers in the order they were called */
+static int calls[64];
+static unsigned int ncalls = 0;
+
+/* signals the last handler still has to see before the loop quits */
+static int pending = 0;
+
+static Eldbus_Signal_Handler *victim = NULL;
+static Eldbus_Signal_Handler *added = NULL;
+
+/*
+ * Run a private bus rather than relying on a session one, so the test
+ * only sees its own signals.
+ */
+static void
+_bus_start(void)
+{
+   char address[1024], pid[32];
+   FILE *f;
+
+   f = popen("dbus-daemon --session --fork --print-address=1 --print-pid=1",
+             "r");
+   fail_if(!f, "could not run dbus-daemon");
+   fail_if(!fgets(address, sizeof (address), f));
+   fail_if(!fgets(pid, sizeof (pid), f));
+   pclose(f);
+   address[strcspn(address, "\n")] = '\0';
+   bus_pid = atoi(pid);
+   fail_if(bus_pid <= 0);
+
+   fail_if(eldbus_init() < 1);
+   conn = eldbus_address_connection_get(address);
+   fail_if(!conn, "could not connect to %s", address);
+
+   ncalls = 0;
+   pending = 0;
+   victim = NULL;
+   added = NULL;
+}
+
+static void
+_bus_stop(void)
+{
+   eldbus_connection_unref(conn);
+   conn = NULL;
+   eldbus_shutdown();
+
+   kill(bus_pid, SIGTERM);
+   bus_pid = 0;
+}
+
+static Eina_Bool
+_timeout_cb(void *data EINA_UNUSED)
+{
+   ecore_main_loop_quit();
+   return EINA_FALSE;
+}
+
+/* dispatch until the last handler saw every signal that was emitted */
+static void
+_signals_wait(int count)
+{
+   Ecore_Timer *timer;
+
+   pending = count;
+   timer = ecore_timer_add(5.0, _timeout_cb, NULL);
+   ecore_main_loop_begin();
+   ecore_timer_del(timer);
+   fail_if(pending != 0, "%i signals never arrived", pending);
+}
+
+static void
+_record_cb(void *data, const Eldbus_Message *msg)
+{
+   /* full wildcards also get what the bus itself sends */
+   if (!strcmp(eldbus_message_sender_get(msg), "org.freedesktop.DBus"))
+     return;
+   if (ncalls < EINA_C_ARRAY_LENGTH(calls))
+     calls[ncalls++] = (intptr_t)data;
+}
+
+static void
+_last_cb(void *data EINA_UNUSED, const Eldbus_Message *msg EINA_UNUSED)
+{
+   if (--pending == 0) ecore_main_loop_quit();
+}
+
+static void
+_self_del_cb(void *data, const Eldbus_Message *msg)
+{
+   _record_cb(data, msg);
+   eldbus_signal_handler_del(victim);
+   victim = NULL;
+}
+
+static void
+_other_del_cb(void *data, const Eldbus_Message *msg)
+{
+   _record_cb(data, msg);
+   if (!victim) return;
+   eldbus_signal_handler_del(victim);
+   victim = NULL;
+}
+
+static void
+_add_cb(void *data, const Eldbus_Message *msg)
+{
+   _record_cb(data, msg);
+   if (added) return;
+   added = eldbus_signal_handler_add(conn, NULL, PATH_A, IFACE, "Ping",
+                                     _record_cb, (void *)(intptr_t)99);
+}
+
+static Eldbus_Signal_Handler *
+_handler_add(const char *path, const char *interface, const char *member,
+             Eldbus_Signal_Cb cb, int id)
+{
+   Eldbus_Signal_Handler *sh;
+
+   sh = eldbus_signal_handler_add(conn, NULL, path, interface, member,
+                                  cb, (void *)(intptr_t)id);
+   fail_if(!sh);
+   return sh;
+}
+
+static void
+_last_add(void)
+{
+   _handler_add(PATH_A, IFACE, "Ping", _last_cb, 0);
+}
+
+static void
+_calls_check(const int *expected, unsigned int count)
+{
+   unsigned int i;
+
+   fail_if(ncalls != count, "%u calls instead of %u", ncalls, count);
+   for (i = 0; i < count; i++)
+     fail_if(calls[i] != expected[i], "call %u went to %i instead of %i",
+             i, calls[i], expected[i]);
+}
+
+START_TEST(eldbus_test_signal_handler_wildcard)
+{
+   Eldbus_Service_Interface *a, *b, *other;
+   static const int expected[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+   ecore_init();
+   _bus_start();
+
+   a = eldbus_service_interface_register(conn, PATH_A, &iface_desc);
+   b = eldbus_service_interface_register(conn, PATH_B, &iface_desc);
+   other = eldbus_service_interface_register(conn, PATH_A, &other_desc);
+   fail_if(!a || !b || !other);
+
+   /* every combination of wildcards matching /a Test.Ping */
+   _handler_add(PATH_A, IFACE, "Ping", _record_cb, 1);
+   _handler_add(NULL, IFACE, "Ping", _record_cb, 2);
+   _handler_add(PATH_A, NULL, "Ping", _record_cb, 3);
+   _handler_add(PATH_A, IFACE, NULL, _record_cb, 4);
+   _handler_add(NULL, NULL, "Ping", _record_cb, 5);
+   _handler_add(NULL, IFACE, NULL, _record_cb, 6);
+   _handler_add(PATH_A, NULL, NULL, _record_cb, 7);
+   _handler_add(NULL, NULL, NULL, _record_cb, 8);
+
+   /* and some that must not match it */
+   _handler_add(PATH_B, IFACE, "Ping", _record_cb, 10);
+   _handler_add(PATH_A, IFACE_OTHER, "Ping", _record_cb, 11);
+   _handler_add(PATH_A, IFACE, "Pong", _record_cb, 12);
+   _handler_add(PATH_B, NULL, NULL, _record_cb, 13);
+   _handler_add(NULL, IFACE_OTHER, NULL, _record_cb, 14);
+   _handler_add(NULL, NULL, "Pong", _record_cb, 15);
+   _last_add();
+
+   fail_if(!eldbus_service_signal_emit(a, PING));
+   _signals_wait(1);
+   _calls_check(expected, EINA_C_ARRAY_LENGTH(expected));
+
+   eldbus_service_interface_unregister(other);
+   eldbus_service_interface_unregister(b);
+   eldbus_service_interface_unregister(a);
+   _bus_stop();
+   ecore_shutdown();
+}
+END_TEST
+
+START_TEST(eldbus_test_signal_handler_order)
+{
+   Eldbus_Service_Interface *a;
+   static const int expected[] = { 1, 2, 3, 4, 5, 6, 1, 2, 3, 4, 5, 6 };
+
+   ecore_init();
+   _bus_start();
+
+   a = eldbus_service_interface_register(conn, PATH_A, &iface_desc);
+   fail_if(!a);
+
+   /* interleaved between buckets, calls must still follow this order */
+   _handler_add(NULL, NULL, "Ping", _record_cb, 1);
+   _handler_add(PATH_A, IFACE, "Ping", _record_cb, 2);
+   _handler_add(PATH_A, NULL, NULL, _record_cb, 3);
+   _handler_add(NULL, NULL, "Ping", _record_cb, 4);
+   _handler_add(NULL, IFACE, NULL, _record_cb, 5);
+   _handler_add(PATH_A, IFACE, "Ping", _record_cb, 6);
+   _last_add();
+
+   fail_if(!eldbus_service_signal_emit(a, PING));
+   fail_if(!eldbus_service_signal_emit(a, PING));
+   _signals_wait(2);
+   _calls_check(expected, EINA_C_ARRAY_LENGTH(expected));
+
+   eldbus_service_interface_unregister(a);
+   _bus_stop();
+   ecore_shutdown();
+}
+END_TEST
+
+START_TEST(eldbus_test_signal_handler_del_self)
+{
+   Eldbus_Service_Interface *a;
+   static const int expected[] = { 1, 2, 3, 1, 3 };
+
+   ecore_init();
+   _bus_start();
+
+   a = eldbus_service_interface_register(conn, PATH_A, &iface_desc);
+   fail_if(!a);
+
+   _handler_add(PATH_A, NULL, NULL, _record_cb, 1);
+   victim = _handler_add(NULL, IFACE, "Ping", _self_del_cb, 2);
+   _handler_add(NULL, NULL, "Ping", _record_cb, 3);
+   _last_add();
+
+   fail_if(!eldbus_service_signal_emit(a, PING));
+   fail_if(!eldbus_service_signal_emit(a, PING));
+   _signals_wait(2);
+   _calls_check(expected, EINA_C_ARRAY_LENGTH(expected));
+
+   eldbus_service_interface_unregister(a);
+   _bus_stop();
+   ecore_shutdown();
+}
+END_TEST
+
+START_TEST(eldbus_test_signal_handler_del_pending)
+{
+   Eldbus_Service_Interface *a;
+   static const int expected[] = { 1, 3, 1, 3 };
+
+   ecore_init();
+   _bus_start();
+
+   a = eldbus_service_interface_register(conn, PATH_A, &iface_desc);
+   fail_if(!a);
+
+   /* 2 is in another bucket and already collected when 1 deletes it */
+   _handler_add(NULL, IFACE, NULL, _other_del_cb, 1);
+   victim = _handler_add(PATH_A, IFACE, "Ping", _record_cb, 2);
+   _handler_add(NULL, NULL, "Ping", _record_cb, 3);
+   _last_add();
+
+   fail_if(!eldbus_service_signal_emit(a, PING));
+   fail_if(!eldbus_service_signal_emit(a, PING));
+   _signals_wait(2);
+   _calls_check(expected, EINA_C_ARRAY_LENGTH(expected));
+
+   eldbus_service_interface_unregister(a);
+   _bus_stop();
+   ecore_shutdown();
+}
+END_TEST
+
+START_TEST(eldbus_test_signal_handler_add_dispatching)
+{
+   Eldbus_Service_Interface *a;
+   static const int expected[] = { 1, 2, 1, 2, 99 };
+
+   ecore_init();
+   _bus_start();
+
+   a = eldbus_service_interface_register(conn, PATH_A, &iface_desc);
+   fail_if(!a);
+
+   _handler_add(PATH_A, IFACE, "Ping", _add_cb, 1);
+   _handler_add(NULL, NULL, NULL, _record_cb, 2);
+   _last_add();
+
+   /* the handler added by 1 first sees the second signal */
+   fail_if(!eldbus_service_signal_emit(a, PING));
+   _signals_wait(1);
+   fail_if(!added);
+   fail_if(!eldbus_service_signal_emit(a, PING));
+   _signals_wait(1);
+   _calls_check(expected, EINA_C_ARRAY_LENGTH(expected));
+
+   eldbus_service_interface_unregister(a);
+   _bus_stop();
+   ecore_shutdown();
+}
+END_TEST
+
+void eldbus_test_signal_handler(TCase *tc)
+{
+   tcase_add_test(tc, eldbus_test_signal_handler_wildcard);
+   tcase_add_test(tc, eldbus_test_signal_handler_order);
+   tcase_add_test(tc, eldbus_test_signal_handler_del_self);
+   tcase_add_test(tc, eldbus_test_signal_handler_del_pending);
+   tcase_add_test(tc, eldbus_test_signal_handler_add_dispatching);
+}
@@ -0,0 +1,9 @@
+#ifndef _EMBRYO_SUITE_H
+#define _EMBRYO_SUITE_H
+
+#include <check.h>
+
+void embryo_test_embryo(TCase *tc);
+
+
+#endif /* _EMBRYO_SUITE_H */
@@ -0,0 +1,147 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <Eina.h>
+#include <Embryo.h>
+
+#include "embryo_private.h"
+#include "embryo_suite.h"
+
+#define TEST_AMX TESTS_BUILD_DIR "/data/test_embryo.amx"
+
+/* every public function of test_embryo.sma, with how much work to do */
+static const struct
+{
+   const char *name;
+   Embryo_Cell arg;
+} _functions[] = {
+   { "calls", 30 },
+   { "cases", 50 },
+   { "strs", 12 },
+   { "arrays", 40 },
+   { "floats", 30 },
+   { "jumps", 5 },
+   { "oob", 3 }
+};
+
+static Embryo_Cell
+_test_native(Embryo_Program *ep EINA_UNUSED, Embryo_Cell *params)
+{
+   return params[1] & 7;
+}
+
+static Embryo_Program *
+_program_load(Eina_Bool threaded)
+{
+   Embryo_Program *ep;
+
+   /* only looked at when the program is loaded */
+   if (threaded) unsetenv("EMBRYO_NO_THREADED");
+   else setenv("EMBRYO_NO_THREADED", "1", 1);
+   ep = embryo_program_load(TEST_AMX);
+   unsetenv("EMBRYO_NO_THREADED");
+   fail_if(!ep);
+
+#ifdef __GNUC__
+   fail_if((ep->threaded != NULL) != threaded);
+#endif
+   embryo_program_native_call_add(ep, "test_native", _test_native);
+   embryo_program_vm_push(ep);
+   return ep;
+}
+
+/* runs every function in slices of max_cycles, and returns where each
+ * slice stopped and what each function returned */
+static Eina_Inarray *
+_functions_run(Eina_Bool threaded, int max_cycles)
+{
+   Embryo_Program *ep;
+   Eina_Inarray *run;
+   Embryo_Status status;
+   Embryo_Function fn;
+   unsigned int i;
+
+   run = eina_inarray_new(sizeof(Embryo_Cell), 1024);
+   fail_if(!run);
+   ep = _program_load(threaded);
+   embryo_program_max_cycle_run_set(ep, max_cycles);
+
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(_functions); i++)
+     {
+        Embryo_Cell cell;
+
+        fn = embryo_program_function_find(ep, _functions[i].name);
+        fail_if(fn == EMBRYO_FUNCTION_NONE);
+        embryo_parameter_cell_push(ep, _functions[i].arg);
+        status = embryo_program_run(ep, fn);
+        while (status == EMBRYO_PROGRAM_TOOLONG)
+          {
+             eina_inarray_push(run, &ep->cip);
+             eina_inarray_push(run, &ep->stk);
+             status = embryo_program_run(ep, EMBRYO_FUNCTION_CONT);
+          }
+        if (status != EMBRYO_PROGRAM_OK)
+          fail("%s failed: %s", _functions[i].name,
+               embryo_error_string_get(embryo_program_error_get(ep)));
+        cell = embryo_program_return_value_get(ep);
+        eina_inarray_push(run, &cell);
+
+        /* jump_operand() runs the operand it jumps to */
+        if (!strcmp(_functions[i].name, "jumps"))
+          ck_assert_int_eq(cell, 70);
+     }
+
+   embryo_program_vm_pop(ep);
+   embryo_program_free(ep);
+   return run;
+}
+
+START_TEST(embryo_test_embryo_init)
+{
+   int ret;
+
+   ret = embryo_init();
+   fail_if(ret != 1);
+
+   ret = embryo_shutdown();
+   fail_if(ret != 0);
+}
+END_TEST
+
+START_TEST(embryo_test_embryo_threaded)
+{
+   static const int max_cycles[] = { 0, 1, 2, 3, 7, 64 };
+   Eina_Inarray *threaded, *classic;
+   unsigned int i;
+
+   embryo_init();
+
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(max_cycles); i++)
+     {
+        threaded = _functions_run(EINA_TRUE, max_cycles[i]);
+        classic = _functions_run(EINA_FALSE, max_cycles[i]);
+
+        /* the same results, stopping at the same places */
+        ck_assert_int_eq(eina_inarray_count(threaded),
+                         eina_inarray_count(classic));
+        fail_if(memcmp(threaded->members, classic->members,
+                       eina_inarray_count(classic) * sizeof(Embryo_Cell)));
+
+        eina_inarray_free(threaded);
+        eina_inarray_free(classic);
+     }
+
+   embryo_shutdown();
+}
+END_TEST
+
+void embryo_test_embryo(TCase *tc)
+{
+   tcase_add_test(tc, embryo_test_embryo_init);
+   tcase_add_test(tc, embryo_test_embryo_threaded);
+}
@@ -13,17 +13,23 @@ EAPI const Eo_Event_Description _EV_A_CHANGED =
         EO_EVENT_DESCRIPTION("a,changed", "Called when a has changed.");
 
 static void
-_a_set(Eo *obj EINA_UNUSED, void *class_data, va_list *list)
+_a_set_direct(Eo *obj, void *class_data, int a)
 {
    Simple_Public_Data *pd = class_data;
-   int a;
-   a = va_arg(*list, int);
    printf("%s %d\n", eo_class_name_get(MY_CLASS), a);
    pd->a = a;
 
    eo_do(obj, eo_event_callback_call(EV_A_CHANGED, &pd->a, NULL));
 }
 
+static void
+_a_set(Eo *obj, void *class_data, va_list *list)
+{
+   int a;
+   a = va_arg(*list, int);
+   _a_set_direct(obj, class_data, a);
+}
+
 static void
 _a_print(Eo *obj EINA_UNUSED, void *class_data, va_list *list)
 {
@@ -53,7 +59,7 @@ _class_constructor(Eo_Class *klass)
 {
    const Eo_Op_Func_Description func_desc[] = {
         EO_OP_FUNC(EO_BASE_ID(EO_BASE_SUB_ID_DBG_INFO_GET), _dbg_info_get),
-        EO_OP_FUNC(SIMPLE_ID(SIMPLE_SUB_ID_A_SET), _a_set),
+        EO_OP_FUNC_DIRECT(SIMPLE_ID(SIMPLE_SUB_ID_A_SET), _a_set, simple_a_set_func, _a_set_direct),
         EO_OP_FUNC(SIMPLE_ID(SIMPLE_SUB_ID_A_PRINT), _a_print),
         EO_OP_FUNC_CLASS(SIMPLE_ID(SIMPLE_SUB_ID_CLASS_HI_PRINT), _class_hi_print),
         EO_OP_FUNC_SENTINEL
@@ -18,6 +18,7 @@ typedef struct
 #define SIMPLE_ID(sub_id) (SIMPLE_BASE_ID + sub_id)
 
 #define simple_a_set(a) SIMPLE_ID(SIMPLE_SUB_ID_A_SET), EO_TYPECHECK(int, a)
+typedef void (*simple_a_set_func)(Eo *obj, void *class_data, int a);
 #define simple_a_print() SIMPLE_ID(SIMPLE_SUB_ID_A_PRINT)
 #define simple_class_hi_print() SIMPLE_ID(SIMPLE_SUB_ID_CLASS_HI_PRINT)
 
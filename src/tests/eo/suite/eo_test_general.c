@@ -833,6 +833,88 @@ START_TEST(eo_add_do_and_custom)
 }
 END_TEST
 
+static int _eo_do_direct_override_called = 0;
+static const Eo_Class *_eo_do_direct_override_class = NULL;
+
+static void
+_eo_do_direct_override_a_set(Eo *obj, void *class_data EINA_UNUSED, va_list *list)
+{
+   int a = va_arg(*list, int);
+
+   _eo_do_direct_override_called++;
+   eo_do_super(obj, _eo_do_direct_override_class, simple_a_set(a * 2));
+}
+
+static void
+_eo_do_direct_override_class_constructor(Eo_Class *klass)
+{
+   const Eo_Op_Func_Description func_desc[] = {
+        EO_OP_FUNC(SIMPLE_ID(SIMPLE_SUB_ID_A_SET), _eo_do_direct_override_a_set),
+        EO_OP_FUNC_SENTINEL
+   };
+
+   eo_class_funcs_set(klass, func_desc);
+}
+
+static Eina_Bool
+_eo_do_direct_a_set(Eo *obj, int a)
+{
+   /* A single call site for all the objects. */
+   return eo_do_direct(obj, simple_a_set_func, simple_a_set(a));
+}
+
+START_TEST(eo_do_direct_calls)
+{
+   Simple_Public_Data *pd, *pd2;
+   Eo *obj, *obj2;
+   int i;
+
+   static Eo_Class_Description class_desc = {
+        EO_VERSION,
+        "Override",
+        EO_CLASS_TYPE_REGULAR,
+        EO_CLASS_DESCRIPTION_OPS(NULL, NULL, 0),
+        NULL,
+        0,
+        _eo_do_direct_override_class_constructor,
+        NULL
+   };
+
+   eo_init();
+
+   _eo_do_direct_override_class = eo_class_new(&class_desc, SIMPLE_CLASS, NULL);
+   fail_if(!_eo_do_direct_override_class);
+
+   obj = eo_add(SIMPLE_CLASS, NULL);
+   fail_if(!obj);
+   obj2 = eo_add(_eo_do_direct_override_class, NULL);
+   fail_if(!obj2);
+
+   pd = eo_data_scope_get(obj, SIMPLE_CLASS);
+   pd2 = eo_data_scope_get(obj2, SIMPLE_CLASS);
+
+   /* Alternate the classes so the cache keeps being refilled. */
+   for (i = 1; i < 5; i++)
+     {
+        fail_if(!_eo_do_direct_a_set(obj, i));
+        fail_if(pd->a != i);
+        fail_if(!_eo_do_direct_a_set(obj2, i));
+        fail_if(pd2->a != i * 2);
+     }
+   fail_if(_eo_do_direct_override_called != 4);
+
+   eo_unref(obj2);
+   eo_unref(obj);
+
+#ifdef HAVE_EO_ID
+   /* Deleted objects are caught as with eo_do(). */
+   fail_if(_eo_do_direct_a_set(obj, 1));
+#endif
+
+   eo_shutdown();
+}
+END_TEST
+
 START_TEST(eo_pointers_indirection)
 {
 #ifdef HAVE_EO_ID
@@ -930,4 +1012,5 @@ void eo_test_general(TCase *tc)
    tcase_add_test(tc, eo_add_do_and_custom);
    tcase_add_test(tc, eo_signals);
    tcase_add_test(tc, eo_pointers_indirection);
+   tcase_add_test(tc, eo_do_direct_calls);
 }
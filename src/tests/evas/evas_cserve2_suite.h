@@ -0,0 +1,10 @@
+#ifndef _EVAS_CSERVE2_SUITE_H
+#define _EVAS_CSERVE2_SUITE_H
+
+#include <check.h>
+
+void evas_cserve2_test_premul(TCase *tc);
+void evas_cserve2_test_disk_cache(TCase *tc);
+
+
+#endif /* _EVAS_CSERVE2_SUITE_H */
@@ -0,0 +1,276 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include <utime.h>
+
+#include "evas_cserve2_suite.h"
+#include "evas_cserve2.h"
+
+/* What the server provides to the disk cache. The writer's pipe is never
+ * watched here, the tests flush the cache instead. */
+int _evas_cserve2_bin_log_dom = -1;
+
+Eina_Bool
+cserve2_fd_watch_add(int fd EINA_UNUSED, Fd_Flags flags EINA_UNUSED,
+                     Fd_Watch_Cb cb EINA_UNUSED, const void *data EINA_UNUSED)
+{
+   return EINA_TRUE;
+}
+
+Eina_Bool
+cserve2_fd_watch_del(int fd EINA_UNUSED)
+{
+   return EINA_TRUE;
+}
+
+#define CACHE_SIZE 64 // kbytes
+
+static char _dir[PATH_MAX];
+static char _cache[PATH_MAX];
+static char _image[PATH_MAX];
+
+static void
+_disk_cache_setup(void)
+{
+   char size[16];
+   FILE *f;
+
+   eina_init();
+   _evas_cserve2_bin_log_dom = eina_log_domain_register("evas_cserve2_test",
+                                                        NULL);
+
+   snprintf(_dir, sizeof(_dir), "/tmp/evas_cserve2_disk_cache_XXXXXX");
+   fail_if(!mkdtemp(_dir));
+   snprintf(_cache, sizeof(_cache), "%s/cache", _dir);
+   snprintf(_image, sizeof(_image), "%s/image.png", _dir);
+
+   /* only its path, size and mtime are looked at */
+   f = fopen(_image, "w");
+   fail_if(!f);
+   fputs("not really an image", f);
+   fclose(f);
+
+   snprintf(size, sizeof(size), "%d", CACHE_SIZE);
+   setenv("EVAS_CSERVE2_DISK_CACHE_DIR", _cache, 1);
+   setenv("EVAS_CSERVE2_DISK_CACHE_SIZE", size, 1);
+   cserve2_disk_cache_init();
+}
+
+static void
+_disk_cache_teardown(void)
+{
+   Eina_Iterator *it;
+   Eina_File_Direct_Info *info;
+
+   cserve2_disk_cache_shutdown();
+   unsetenv("EVAS_CSERVE2_DISK_CACHE_DIR");
+   unsetenv("EVAS_CSERVE2_DISK_CACHE_SIZE");
+
+   it = eina_file_direct_ls(_cache);
+   EINA_ITERATOR_FOREACH(it, info)
+     unlink(info->path);
+   eina_iterator_free(it);
+   rmdir(_cache);
+   unlink(_image);
+   rmdir(_dir);
+
+   eina_log_domain_unregister(_evas_cserve2_bin_log_dom);
+   _evas_cserve2_bin_log_dom = -1;
+   eina_shutdown();
+}
+
+static unsigned int
+_disk_cache_files_count(size_t *total)
+{
+   Eina_Iterator *it;
+   Eina_File_Direct_Info *info;
+   unsigned int count = 0;
+   struct stat st;
+
+   *total = 0;
+   it = eina_file_direct_ls(_cache);
+   fail_if(!it);
+   EINA_ITERATOR_FOREACH(it, info)
+     {
+        fail_if(stat(info->path, &st));
+        *total += st.st_size;
+        count++;
+     }
+   eina_iterator_free(it);
+
+   return count;
+}
+
+static void
+_opts_set(Evas_Image_Load_Opts *opts, int w, int h)
+{
+   memset(opts, 0, sizeof(*opts));
+   opts->scale_load.src_w = 1000;
+   opts->scale_load.src_h = 1000;
+   opts->scale_load.dst_w = w;
+   opts->scale_load.dst_h = h;
+   opts->scale_load.smooth = 1;
+}
+
+static unsigned int *
+_pixels_new(int w, int h, unsigned int seed)
+{
+   unsigned int *pixels;
+   int i;
+
+   pixels = malloc(w * h * 4);
+   fail_if(!pixels);
+   for (i = 0; i < w * h; i++)
+     pixels[i] = (seed + i) * 2654435761U;
+
+   return pixels;
+}
+
+/* checks the image loads back as it was saved, or doesn't load */
+static void
+_disk_cache_check(const Evas_Image_Load_Opts *opts, const unsigned int *pixels,
+                  Eina_Bool alpha)
+{
+   Eina_Bool alpha_got = !alpha, sparse_got = EINA_TRUE;
+   int w = 0, h = 0;
+   Shm_Handle *shm;
+   char *map;
+
+   shm = cserve2_disk_cache_load(_image, NULL, opts, &w, &h,
+                                 &alpha_got, &sparse_got);
+   if (!pixels)
+     {
+        fail_if(shm != NULL);
+        return;
+     }
+
+   fail_if(!shm);
+   ck_assert_int_eq(w, opts->scale_load.dst_w);
+   ck_assert_int_eq(h, opts->scale_load.dst_h);
+   ck_assert_int_eq(alpha_got, alpha);
+   ck_assert_int_eq(sparse_got, EINA_FALSE);
+
+   map = cserve2_shm_map(shm);
+   fail_if(map == MAP_FAILED);
+   fail_if(memcmp(map + cserve2_shm_map_offset_get(shm), pixels, w * h * 4));
+   cserve2_shm_unmap(shm);
+   cserve2_shm_unref(shm);
+}
+
+START_TEST(evas_cserve2_disk_cache_save_load)
+{
+   Evas_Image_Load_Opts opts, other;
+   unsigned int *pixels;
+   struct utimbuf times;
+   size_t total;
+
+   _disk_cache_setup();
+
+   _opts_set(&opts, 20, 10);
+   pixels = _pixels_new(20, 10, 1);
+
+   /* nothing there yet */
+   _disk_cache_check(&opts, NULL, EINA_FALSE);
+
+   cserve2_disk_cache_save(_image, NULL, &opts, pixels, 20, 10,
+                           EINA_TRUE, EINA_FALSE);
+   cserve2_disk_cache_flush();
+   ck_assert_int_eq(_disk_cache_files_count(&total), 1);
+   _disk_cache_check(&opts, pixels, EINA_TRUE);
+
+   /* another size or key of the same file is another entry */
+   _opts_set(&other, 10, 20);
+   _disk_cache_check(&other, NULL, EINA_FALSE);
+   fail_if(cserve2_disk_cache_load(_image, "key", &opts, NULL, NULL,
+                                   NULL, NULL) != NULL);
+
+   /* it is still there after a restart */
+   cserve2_disk_cache_shutdown();
+   cserve2_disk_cache_init();
+   _disk_cache_check(&opts, pixels, EINA_TRUE);
+
+   /* the source is only looked at again once it is known to change */
+   times.actime = times.modtime = time(NULL) - 3600;
+   fail_if(utime(_image, &times));
+   _disk_cache_check(&opts, pixels, EINA_TRUE);
+   cserve2_disk_cache_file_changed(_image);
+   _disk_cache_check(&opts, NULL, EINA_FALSE);
+
+   free(pixels);
+   _disk_cache_teardown();
+}
+END_TEST
+
+START_TEST(evas_cserve2_disk_cache_limit)
+{
+   Evas_Image_Load_Opts opts;
+   unsigned int *pixels[16];
+   unsigned int count;
+   size_t total;
+   int i;
+
+   _disk_cache_setup();
+
+   /* 16 images of 4 kbytes and their headers don't fit in 64 kbytes */
+   for (i = 0; i < 16; i++)
+     {
+        pixels[i] = _pixels_new(32 + i, 32, i);
+        _opts_set(&opts, 32 + i, 32);
+        cserve2_disk_cache_save(_image, NULL, &opts, pixels[i], 32 + i, 32,
+                                EINA_FALSE, EINA_FALSE);
+        cserve2_disk_cache_flush();
+     }
+
+   count = _disk_cache_files_count(&total);
+   fail_if(total > CACHE_SIZE * 1024);
+   fail_if(count >= 16);
+
+   /* the oldest ones went first */
+   for (i = 0; i < 16; i++)
+     {
+        _opts_set(&opts, 32 + i, 32);
+        _disk_cache_check(&opts, (i >= 16 - (int) count) ? pixels[i] : NULL,
+                          EINA_FALSE);
+     }
+
+   /* the pixels fit but not with the header */
+   free(pixels[0]);
+   pixels[0] = _pixels_new(128, 128, 0);
+   _opts_set(&opts, 128, 128);
+   cserve2_disk_cache_save(_image, NULL, &opts, pixels[0], 128, 128,
+                           EINA_FALSE, EINA_FALSE);
+   cserve2_disk_cache_flush();
+   _disk_cache_check(&opts, NULL, EINA_FALSE);
+   ck_assert_int_eq(_disk_cache_files_count(&total), count);
+
+   /* queued faster than written, still within the limit */
+   for (i = 0; i < 16; i++)
+     {
+        _opts_set(&opts, 32, 32);
+        opts.scale_load.src_x = 1 + i;
+        cserve2_disk_cache_save(_image, NULL, &opts, pixels[i], 32, 32,
+                                EINA_FALSE, EINA_FALSE);
+     }
+   cserve2_disk_cache_flush();
+   _disk_cache_files_count(&total);
+   fail_if(total > CACHE_SIZE * 1024);
+
+   for (i = 0; i < 16; i++)
+     free(pixels[i]);
+   _disk_cache_teardown();
+}
+END_TEST
+
+void evas_cserve2_test_disk_cache(TCase *tc)
+{
+   tcase_add_test(tc, evas_cserve2_disk_cache_save_load);
+   tcase_add_test(tc, evas_cserve2_disk_cache_limit);
+}
@@ -0,0 +1,99 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "evas_cserve2_suite.h"
+#include "evas_cserve2_slave.h"
+#include "evas_thread_pool.h"
+
+/* Same as the slave did before it cut images in strips */
+static Eina_Bool
+_premul_reference(unsigned int *data, unsigned int len)
+{
+   unsigned int *de = data + len;
+   unsigned int nas = 0;
+
+   while (data < de)
+     {
+        unsigned int  a = 1 + (*data >> 24);
+
+        *data = (*data & 0xff000000) +
+          (((((*data) >> 8) & 0xff) * a) & 0xff00) +
+          (((((*data) & 0x00ff00ff) * a) >> 8) & 0x00ff00ff);
+        data++;
+
+        if ((a == 1) || (a == 256))
+          nas++;
+     }
+
+   return ((ALPHA_SPARSE_INV_FRACTION * nas) >= len);
+}
+
+static void
+_image_fill(unsigned int *data, unsigned int len, Eina_Bool sparse)
+{
+   unsigned int seed = 0x2545f491;
+   unsigned int i;
+
+   for (i = 0; i < len; i++)
+     {
+        seed = (seed * 1103515245) + 12345;
+        data[i] = seed;
+        /* mostly fully opaque or fully transparent */
+        if (sparse && (i % 8))
+          data[i] = (i & 8) ? (seed | 0xff000000) : (seed & 0x00ffffff);
+     }
+}
+
+static void
+_premul_check(unsigned int len, Eina_Bool sparse)
+{
+   unsigned int *ref, *data;
+
+   ref = malloc(len * sizeof (unsigned int));
+   data = malloc(len * sizeof (unsigned int));
+   fail_if(!ref || !data);
+
+   _image_fill(ref, len, sparse);
+   memcpy(data, ref, len * sizeof (unsigned int));
+
+   ck_assert_int_eq(_premul_reference(ref, len), sparse);
+   ck_assert_int_eq(evas_cserve2_image_premul_data(data, len), sparse);
+   fail_if(memcmp(ref, data, len * sizeof (unsigned int)));
+
+   free(ref);
+   free(data);
+}
+
+START_TEST(evas_cserve2_premul_strips)
+{
+   unsigned int threads;
+
+   eina_init();
+   evas_thread_pool_init();
+   threads = evas_thread_pool_threads_get();
+
+   /* below and above the size cut in strips, with a partial last strip */
+   _premul_check(1000, EINA_FALSE);
+   _premul_check(1000, EINA_TRUE);
+   _premul_check(3 * 1024 * 1024 + 37, EINA_FALSE);
+   _premul_check(3 * 1024 * 1024 + 37, EINA_TRUE);
+
+   evas_thread_pool_threads_set(1);
+   _premul_check(2 * 1024 * 1024 + 1, EINA_TRUE);
+   evas_thread_pool_threads_set(4);
+   _premul_check(2 * 1024 * 1024 + 1, EINA_TRUE);
+   evas_thread_pool_threads_set(threads);
+
+   evas_thread_pool_shutdown();
+   eina_shutdown();
+}
+END_TEST
+
+void evas_cserve2_test_premul(TCase *tc)
+{
+   tcase_add_test(tc, evas_cserve2_premul_strips);
+}
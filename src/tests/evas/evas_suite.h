@@ -10,6 +10,7 @@ void evas_test_text(TCase *tc);
 void evas_test_callbacks(TCase *tc);
 void evas_test_render_engines(TCase *tc);
 void evas_test_filters(TCase *tc);
+void evas_test_render_ops(TCase *tc);
 
 
 #endif /* _EVAS_SUITE_H */
@@ -8,11 +8,16 @@
 #endif
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "evas_suite.h"
 #include "Evas.h"
 #include "Ecore_Evas.h"
+#include "Evas_Engine_Buffer.h"
 #include "../../lib/evas/include/evas_filter.h"
+#include "../../lib/evas/include/evas_thread_pool.h"
+#include "evas_tests_cpu.h"
 
 #if !defined(EFL_EO_API_SUPPORT) || !defined(EFL_BETA_API_SUPPORT)
 # define BUILD_FILTER_TESTS 0
@@ -439,6 +444,252 @@ START_TEST(evas_filter_text_render_test)
 }
 END_TEST
 
+/* The blur loops have SSE3, AVX2 and NEON versions that must give the
+ * same bits as the C code. Odd widths leave some columns to the C code
+ * after the vector loops, as in real use. */
+
+#define SIMD_OUT_W 213
+#define SIMD_OUT_H 97
+
+static const char *_simd_programs[] = {
+   "blur(1);", "blur(2);", "blur(5);", "blur(12);", "blur(31);", "blur(64);",
+   "blur(3,type=box);", "blur(9,type=box);", "blur(40,type=box);",
+   "blur(130,type=box);", "blur(rx=4,ry=19,type=gaussian);",
+   "blur(rx=27,ry=2,type=box);", "blur(7,ox=3,oy=-2);",
+   "buffer:a(alpha);blur(6,dst=a);blend(src=a,color=red);",
+   "buffer:a(alpha);blur(17,dst=a,type=box);blend(src=a,color=red);",
+   "grow(3);", "grow(-2);", "grow(9);"
+};
+
+static const int _simd_programs_count =
+  sizeof(_simd_programs) / sizeof(_simd_programs[0]);
+
+static void
+_programs_render(const char *const *programs, int count,
+                 unsigned int *pixels, int ow, int oh, int font_size)
+{
+   Evas *evas;
+   Evas_Engine_Info_Buffer *einfo;
+   Evas_Object *o;
+   int k;
+
+   evas_init();
+   for (k = 0; k < count; k++)
+     {
+        evas = evas_new();
+        evas_output_method_set(evas, evas_render_method_lookup("buffer"));
+        einfo = (Evas_Engine_Info_Buffer *)evas_engine_info_get(evas);
+        einfo->info.depth_type = EVAS_ENGINE_BUFFER_DEPTH_ARGB32;
+        einfo->info.dest_buffer = pixels + (k * ow * oh);
+        einfo->info.dest_buffer_row_bytes = ow * sizeof (unsigned int);
+        einfo->info.use_color_key = 0;
+        einfo->info.alpha_threshold = 0;
+        einfo->info.func.new_update_region = NULL;
+        einfo->info.func.free_update_region = NULL;
+        evas_engine_info_set(evas, (Evas_Engine_Info *)einfo);
+        evas_output_size_set(evas, ow, oh);
+        evas_output_viewport_set(evas, 0, 0, ow, oh);
+
+        o = evas_object_rectangle_add(evas);
+        evas_object_color_set(o, 30, 60, 90, 255);
+        evas_object_resize(o, ow, oh);
+        evas_object_show(o);
+
+        o = evas_object_text_add(evas);
+        evas_object_text_font_source_set(o, TEST_FONT_SOURCE);
+        evas_object_text_font_set(o, TEST_FONT_NAME, font_size);
+        evas_object_text_text_set(o, "Blur Wq%");
+        evas_object_color_set(o, 200, 140, 20, 220);
+        evas_object_move(o, 17, 21);
+        evas_object_show(o);
+        eo_do(o, evas_obj_text_filter_program_set(programs[k]));
+
+        evas_render(evas);
+        evas_free(evas);
+     }
+   evas_shutdown();
+}
+
+static void
+_simd_programs_render(unsigned int *pixels)
+{
+   _programs_render(_simd_programs, _simd_programs_count,
+                    pixels, SIMD_OUT_W, SIMD_OUT_H, 41);
+}
+
+/* plain C reference */
+static const char *const _simd_cpu_c[] = {
+   "EVAS_CPU_NO_SSE3", "EVAS_CPU_NO_AVX2", "EVAS_CPU_NO_NEON", NULL
+};
+
+/* SSE3 or NEON */
+static const char *const _simd_cpu_sse3_neon[] = {
+   "EVAS_CPU_NO_AVX2", NULL
+};
+
+static const char *const _simd_cpu_avx2[] = {
+   NULL
+};
+
+static void
+_simd_programs_check(const unsigned int *ref, unsigned int *simd, size_t size,
+                     const char *const *disable, const char *name)
+{
+   int k;
+
+   memset(simd, 0, size);
+   _cpu_render_child(disable, _simd_programs_render, simd, size);
+   for (k = 0; k < _simd_programs_count; k++)
+     {
+        size_t off = k * SIMD_OUT_W * SIMD_OUT_H;
+
+        if (memcmp(ref + off, simd + off, size / _simd_programs_count))
+          fail("%s blur differs from C with '%s'", name, _simd_programs[k]);
+     }
+}
+
+START_TEST(evas_filter_blur_simd_exact)
+{
+   Eina_Cpu_Features usable = _cpu_features_usable();
+   unsigned int *ref, *simd;
+   size_t size = _simd_programs_count * SIMD_OUT_W * SIMD_OUT_H
+     * sizeof (unsigned int);
+
+   if (!(usable & (EINA_CPU_SSE3 | EINA_CPU_NEON | EINA_CPU_AVX2)))
+     {
+        fprintf(stderr, "evas_filter_blur_simd_exact: no SIMD, skipped\n");
+        return;
+     }
+
+   ref = calloc(1, size);
+   simd = calloc(1, size);
+   fail_if(!ref || !simd);
+
+   _cpu_render_child(_simd_cpu_c, _simd_programs_render, ref, size);
+
+   if (usable & (EINA_CPU_SSE3 | EINA_CPU_NEON))
+     _simd_programs_check(ref, simd, size, _simd_cpu_sse3_neon, "SSE3/NEON");
+   else
+     fprintf(stderr, "evas_filter_blur_simd_exact: no SSE3/NEON, skipped\n");
+
+   if (usable & EINA_CPU_AVX2)
+     _simd_programs_check(ref, simd, size, _simd_cpu_avx2, "AVX2");
+   else
+     fprintf(stderr, "evas_filter_blur_simd_exact: no AVX2, skipped\n");
+
+   free(ref);
+   free(simd);
+}
+END_TEST
+
+/* Big enough for the blurs to be cut in bands when there are threads */
+#define THREADS_OUT_W 430
+#define THREADS_OUT_H 190
+
+START_TEST(evas_filter_blur_threads_exact)
+{
+   unsigned int *one, *many;
+   unsigned int threads;
+   size_t size = _simd_programs_count * THREADS_OUT_W * THREADS_OUT_H
+     * sizeof (unsigned int);
+   int k;
+
+   one = calloc(1, size);
+   many = calloc(1, size);
+   fail_if(!one || !many);
+
+   /* keeps the pool up, with its size, between the renders */
+   evas_init();
+   threads = evas_thread_pool_threads_get();
+
+   evas_thread_pool_threads_set(1);
+   _programs_render(_simd_programs, _simd_programs_count,
+                    one, THREADS_OUT_W, THREADS_OUT_H, 96);
+   evas_thread_pool_threads_set(4);
+   _programs_render(_simd_programs, _simd_programs_count,
+                    many, THREADS_OUT_W, THREADS_OUT_H, 96);
+
+   evas_thread_pool_threads_set(threads);
+   evas_shutdown();
+
+   for (k = 0; k < _simd_programs_count; k++)
+     {
+        size_t off = k * THREADS_OUT_W * THREADS_OUT_H;
+
+        if (memcmp(one + off, many + off, size / _simd_programs_count))
+          fail("Blur in bands differs from one thread with '%s'",
+               _simd_programs[k]);
+     }
+
+   free(one);
+   free(many);
+}
+END_TEST
+
+/* Each of these has consecutive small commands writing to different buffers,
+ * so they run side by side on the pool rather than one after the other */
+static const char *_wave_programs[] = {
+   "buffer:a(alpha);buffer:b(alpha);buffer:c(alpha);buffer:d(alpha);"
+   "blur(rx=2,ry=0,dst=a);blur(rx=0,ry=4,dst=b);"
+   "blur(rx=7,ry=0,dst=c,type=box);blur(rx=0,ry=9,dst=d);"
+   "blend(src=a,color=red);blend(src=b,color=green);"
+   "blend(src=c,color=blue);blend(src=d,color=white);",
+   "buffer:a(alpha);buffer:b(alpha);buffer:c(alpha);buffer:d(alpha);"
+   "curve(0:255-255:0,dst=a);curve(0:64-255:192,dst=b);"
+   "blur(rx=5,ry=0,dst=c);curve(0:0-128:255-255:255,dst=d);"
+   "blend(src=a,color=red,ox=-2);blend(src=b,color=green,oy=2);"
+   "blend(src=c,color=blue);blend(src=d,color=white);",
+   "buffer:a(alpha);buffer:b(alpha);buffer:c(rgba);"
+   "blur(3,dst=a);blur(8,dst=b,type=box);blur(rx=5,ry=1,dst=c);"
+   "blend(src=a,color=red);blend(src=b,color=green,ox=2);blend(src=c,oy=-3);"
+};
+
+static const int _wave_programs_count =
+  sizeof(_wave_programs) / sizeof(_wave_programs[0]);
+
+/* Small enough for every command to stay under EVAS_FILTER_BAND_PIXELS_MIN */
+#define WAVE_OUT_W 120
+#define WAVE_OUT_H 60
+
+START_TEST(evas_filter_wave_threads_exact)
+{
+   unsigned int *one, *many;
+   unsigned int threads;
+   size_t size = _wave_programs_count * WAVE_OUT_W * WAVE_OUT_H
+     * sizeof (unsigned int);
+   int k;
+
+   one = calloc(1, size);
+   many = calloc(1, size);
+   fail_if(!one || !many);
+
+   evas_init();
+   threads = evas_thread_pool_threads_get();
+
+   evas_thread_pool_threads_set(1);
+   _programs_render(_wave_programs, _wave_programs_count,
+                    one, WAVE_OUT_W, WAVE_OUT_H, 12);
+   evas_thread_pool_threads_set(4);
+   _programs_render(_wave_programs, _wave_programs_count,
+                    many, WAVE_OUT_W, WAVE_OUT_H, 12);
+
+   evas_thread_pool_threads_set(threads);
+   evas_shutdown();
+
+   for (k = 0; k < _wave_programs_count; k++)
+     {
+        size_t off = k * WAVE_OUT_W * WAVE_OUT_H;
+
+        if (memcmp(one + off, many + off, size / _wave_programs_count))
+          fail("Commands run side by side differ from one thread with '%s'",
+               _wave_programs[k]);
+     }
+
+   free(one);
+   free(many);
+}
+END_TEST
+
 #endif // BUILD_FILTER_TESTS
 
 void evas_test_filters(TCase *tc)
@@ -447,6 +698,9 @@ void evas_test_filters(TCase *tc)
    tcase_add_test(tc, evas_filter_parser);
    tcase_add_test(tc, evas_filter_text_padding_test);
    tcase_add_test(tc, evas_filter_text_render_test);
+   tcase_add_test(tc, evas_filter_blur_simd_exact);
+   tcase_add_test(tc, evas_filter_blur_threads_exact);
+   tcase_add_test(tc, evas_filter_wave_threads_exact);
 #else
    (void) tc;
 #endif
@@ -3,6 +3,7 @@
 #endif
 
 #include <stdio.h>
+#include <string.h>
 
 #include "evas_suite.h"
 #include "Evas.h"
@@ -30,7 +31,230 @@ START_TEST(evas_object_various)
 }
 END_TEST
 
+/* two canvases get the same scene and the same changes, only the first one
+ * uses the spatial index, the hit tests must agree all along */
+#define SPATIAL_OBJS 300
+
+typedef struct
+{
+   Evas *evas;
+   Evas_Object *objs[SPATIAL_OBJS];
+   Evas_Object *smart, *nested, *clipper;
+} Spatial_Scene;
+
+static unsigned int spatial_seed;
+
+static int
+_spatial_rand(int max)
+{
+   spatial_seed = (spatial_seed * 1103515245) + 12345;
+   return (spatial_seed >> 16) % max;
+}
+
+static Evas_Object *
+_spatial_rect_add(Spatial_Scene *sc, int i)
+{
+   Evas_Object *o;
+   char name[16];
+
+   o = evas_object_rectangle_add(sc->evas);
+   snprintf(name, sizeof (name), "%d", i);
+   evas_object_name_set(o, name);
+   sc->objs[i] = o;
+   return o;
+}
+
+static void
+_spatial_scene_add(Spatial_Scene *sc, Eina_Bool indexed)
+{
+   static Evas_Smart_Class klass = EVAS_SMART_CLASS_INIT_NAME_VERSION("spatial");
+   Evas_Smart *smart;
+   int i;
+
+   memset(sc, 0, sizeof (*sc));
+   sc->evas = EVAS_TEST_INIT_EVAS();
+   evas_event_spatial_index_set(sc->evas, indexed);
+   fail_if(evas_event_spatial_index_get(sc->evas) != indexed);
+
+   smart = evas_smart_class_new(&klass);
+   sc->smart = evas_object_smart_add(sc->evas, smart);
+   evas_object_move(sc->smart, 100, 100);
+   evas_object_resize(sc->smart, 200, 200);
+   evas_object_show(sc->smart);
+   sc->nested = evas_object_smart_add(sc->evas, smart);
+   evas_object_smart_member_add(sc->nested, sc->smart);
+   evas_object_move(sc->nested, 150, 150);
+   evas_object_resize(sc->nested, 100, 100);
+   evas_object_show(sc->nested);
+   sc->clipper = evas_object_rectangle_add(sc->evas);
+   evas_object_move(sc->clipper, 50, 50);
+   evas_object_resize(sc->clipper, 300, 300);
+   evas_object_show(sc->clipper);
+
+   spatial_seed = 42;
+   for (i = 0; i < SPATIAL_OBJS; i++)
+     {
+        Evas_Object *o = _spatial_rect_add(sc, i);
+
+        evas_object_move(o, _spatial_rand(560) - 30, _spatial_rand(560) - 30);
+        evas_object_resize(o, _spatial_rand(80), _spatial_rand(80));
+        if (_spatial_rand(10)) evas_object_show(o);
+        if (!_spatial_rand(10)) evas_object_pass_events_set(o, EINA_TRUE);
+        if (!_spatial_rand(10)) evas_object_layer_set(o, 1);
+        else if (i % 5 == 1) evas_object_smart_member_add(o, sc->smart);
+        else if (i % 5 == 2) evas_object_smart_member_add(o, sc->nested);
+        else if (i % 7 == 3) evas_object_clip_set(o, sc->clipper);
+     }
+}
+
+static void
+_spatial_scene_change(Spatial_Scene *sc, int round)
+{
+   int i, j;
+
+   spatial_seed = 1000 + round;
+   for (i = 0; i < 60; i++)
+     {
+        j = _spatial_rand(SPATIAL_OBJS);
+        if (!sc->objs[j]) continue;
+        switch (_spatial_rand(9))
+          {
+           case 0:
+             evas_object_move(sc->objs[j], _spatial_rand(560) - 30,
+                              _spatial_rand(560) - 30);
+             break;
+           case 1:
+             evas_object_resize(sc->objs[j], _spatial_rand(120),
+                                _spatial_rand(120));
+             break;
+           case 2:
+             evas_object_raise(sc->objs[j]);
+             break;
+           case 3:
+             evas_object_lower(sc->objs[j]);
+             break;
+           case 4:
+             if (evas_object_visible_get(sc->objs[j]))
+               evas_object_hide(sc->objs[j]);
+             else
+               evas_object_show(sc->objs[j]);
+             break;
+           case 5:
+             evas_object_del(sc->objs[j]);
+             sc->objs[j] = NULL;
+             break;
+           case 6:
+             evas_object_layer_set(sc->objs[j], _spatial_rand(3) - 1);
+             break;
+           case 7:
+             evas_object_smart_member_add(sc->objs[j], sc->nested);
+             break;
+           default:
+             evas_object_show(_spatial_rect_add(sc, j));
+             evas_object_move(sc->objs[j], _spatial_rand(500),
+                              _spatial_rand(500));
+             evas_object_resize(sc->objs[j], 40, 40);
+          }
+     }
+   evas_object_move(sc->clipper, _spatial_rand(200), _spatial_rand(200));
+   evas_object_move(sc->nested, _spatial_rand(400), _spatial_rand(400));
+}
+
+static char *
+_spatial_names(Eina_List *list)
+{
+   Eina_Strbuf *buf = eina_strbuf_new();
+   Evas_Object *o;
+   char *ret;
+
+   EINA_LIST_FREE(list, o)
+     {
+        eina_strbuf_append(buf, evas_object_name_get(o) ?
+                           evas_object_name_get(o) : "-");
+        eina_strbuf_append_char(buf, ' ');
+     }
+   ret = eina_strbuf_string_steal(buf);
+   eina_strbuf_free(buf);
+   return ret;
+}
+
+static void
+_spatial_scene_check(Spatial_Scene *a, Spatial_Scene *b)
+{
+   int x, y;
+
+   for (y = -20; y < 520; y += 7)
+     for (x = -20; x < 520; x += 11)
+       {
+          Evas_Object *ta, *tb;
+          char *sa, *sb;
+
+          sa = _spatial_names(evas_tree_objects_at_xy_get(a->evas, NULL, x, y));
+          sb = _spatial_names(evas_tree_objects_at_xy_get(b->evas, NULL, x, y));
+          fail_if(strcmp(sa, sb), "tree at %d,%d: %s != %s", x, y, sa, sb);
+          free(sa);
+          free(sb);
+
+          sa = _spatial_names(evas_objects_at_xy_get(a->evas, x, y,
+                                                     EINA_FALSE, EINA_FALSE));
+          sb = _spatial_names(evas_objects_at_xy_get(b->evas, x, y,
+                                                     EINA_FALSE, EINA_FALSE));
+          fail_if(strcmp(sa, sb), "at %d,%d: %s != %s", x, y, sa, sb);
+          free(sa);
+          free(sb);
+
+          sa = _spatial_names(evas_objects_in_rectangle_get(a->evas, x, y,
+                                                            30, 20, EINA_TRUE,
+                                                            EINA_TRUE));
+          sb = _spatial_names(evas_objects_in_rectangle_get(b->evas, x, y,
+                                                            30, 20, EINA_TRUE,
+                                                            EINA_TRUE));
+          fail_if(strcmp(sa, sb), "in %d,%d: %s != %s", x, y, sa, sb);
+          free(sa);
+          free(sb);
+
+          ta = evas_object_top_at_xy_get(a->evas, x, y, EINA_FALSE, EINA_FALSE);
+          tb = evas_object_top_at_xy_get(b->evas, x, y, EINA_FALSE, EINA_FALSE);
+          fail_if((!ta) != (!tb));
+          if (ta)
+            fail_if(strcmp(evas_object_name_get(ta) ? evas_object_name_get(ta) : "-",
+                           evas_object_name_get(tb) ? evas_object_name_get(tb) : "-"));
+       }
+}
+
+START_TEST(evas_object_spatial_index)
+{
+   Spatial_Scene a, b;
+   int round;
+
+   _spatial_scene_add(&a, EINA_TRUE);
+   _spatial_scene_add(&b, EINA_FALSE);
+   _spatial_scene_check(&a, &b);
+
+   for (round = 0; round < 6; round++)
+     {
+        _spatial_scene_change(&a, round);
+        _spatial_scene_change(&b, round);
+        _spatial_scene_check(&a, &b);
+     }
+
+   /* switching it off and back on rebuilds everything */
+   evas_event_spatial_index_set(a.evas, EINA_FALSE);
+   _spatial_scene_check(&a, &b);
+   evas_event_spatial_index_set(a.evas, EINA_TRUE);
+   _spatial_scene_change(&a, round);
+   _spatial_scene_change(&b, round);
+   _spatial_scene_check(&a, &b);
+
+   evas_free(a.evas);
+   evas_free(b.evas);
+   evas_shutdown();
+   evas_shutdown();
+}
+END_TEST
+
 void evas_test_object(TCase *tc)
 {
    tcase_add_test(tc, evas_object_various);
+   tcase_add_test(tc, evas_object_spatial_index);
 }
@@ -3,9 +3,11 @@
 #endif
 
 #include <stdio.h>
+#include <stdlib.h>
 
 #include "evas_suite.h"
 #include "Evas.h"
+#include "Evas_Engine_Buffer.h"
 
 static Eina_Bool
 _find_list(const Eina_List *lst, const char *item)
@@ -77,8 +79,105 @@ START_TEST(evas_render_lookup)
 }
 END_TEST
 
+START_TEST(evas_render_stats)
+{
+   Evas *evas;
+   Evas_Engine_Info_Buffer *einfo;
+   Evas_Object *o, *h;
+   Evas_Render_Stats stats[4];
+   unsigned int *pixels;
+
+   pixels = calloc(64 * 32, sizeof (unsigned int));
+   fail_if(!pixels);
+
+   evas_init();
+   evas = evas_new();
+   evas_output_method_set(evas, evas_render_method_lookup("buffer"));
+   einfo = (Evas_Engine_Info_Buffer *)evas_engine_info_get(evas);
+   einfo->info.depth_type = EVAS_ENGINE_BUFFER_DEPTH_ARGB32;
+   einfo->info.dest_buffer = pixels;
+   einfo->info.dest_buffer_row_bytes = 64 * sizeof (unsigned int);
+   evas_engine_info_set(evas, (Evas_Engine_Info *)einfo);
+   evas_output_size_set(evas, 64, 32);
+   evas_output_viewport_set(evas, 0, 0, 64, 32);
+
+   fail_if(evas_render_stats_size_get(evas) == 0);
+   fail_if(evas_render_stats_get(evas, stats, 4) != 0);
+
+   o = evas_object_rectangle_add(evas);
+   evas_object_resize(o, 10, 10);
+   evas_object_show(o);
+
+   /* first frame redraws the whole output */
+   evas_render(evas);
+   fail_if(evas_render_stats_get(evas, stats, 4) != 1);
+   fail_if(stats[0].frame != 1);
+   fail_if(stats[0].async);
+   fail_if(stats[0].objects != 1);
+   fail_if(stats[0].objects_drawn < 1);
+   fail_if(stats[0].regions < 1);
+   fail_if(stats[0].pixels != 64 * 32);
+   fail_if(stats[0].phase1 < 0.0 || stats[0].updates < 0.0 ||
+           stats[0].render < 0.0 || stats[0].flush < 0.0);
+   fail_if(stats[0].total < stats[0].phase1 + stats[0].updates +
+           stats[0].render + stats[0].flush - 0.000001);
+
+   /* nothing changed, no frame */
+   evas_render(evas);
+   fail_if(evas_render_stats_get(evas, stats, 4) != 1);
+
+   /* only the old and new position of the object are redrawn */
+   evas_object_move(o, 20, 0);
+   evas_render(evas);
+   fail_if(evas_render_stats_get(evas, stats, 4) != 2);
+   fail_if(stats[0].frame != 2);
+   fail_if(stats[1].frame != 1);
+   fail_if(stats[0].pixels == 0);
+   fail_if(stats[0].pixels >= 64 * 32);
+
+   /* a change that leaves nothing to redraw records no frame */
+   h = evas_object_rectangle_add(evas);
+   evas_object_move(h, 5, 5);
+   evas_render(evas);
+   fail_if(evas_render_stats_get(evas, stats, 4) != 2);
+   evas_object_del(h);
+
+   /* frames not drawn are not recorded */
+   evas_object_move(o, 30, 0);
+   evas_norender(evas);
+   fail_if(evas_render_stats_get(evas, stats, 4) != 2);
+
+   /* resizing drops the history and the ring keeps the newest frames */
+   evas_render_stats_size_set(evas, 2);
+   fail_if(evas_render_stats_size_get(evas) != 2);
+   fail_if(evas_render_stats_get(evas, stats, 4) != 0);
+   evas_object_move(o, 40, 0);
+   evas_render(evas);
+   evas_object_move(o, 50, 0);
+   evas_render(evas);
+   evas_object_move(o, 0, 10);
+   evas_render(evas);
+   fail_if(evas_render_stats_get(evas, stats, 4) != 2);
+   fail_if(stats[0].frame != 5);
+   fail_if(stats[1].frame != 4);
+   fail_if(evas_render_stats_get(evas, stats, 1) != 1);
+   fail_if(stats[0].frame != 5);
+
+   /* size 0 turns it off */
+   evas_render_stats_size_set(evas, 0);
+   evas_object_move(o, 0, 0);
+   evas_render(evas);
+   fail_if(evas_render_stats_get(evas, stats, 4) != 0);
+
+   evas_free(evas);
+   evas_shutdown();
+   free(pixels);
+}
+END_TEST
+
 void evas_test_render_engines(TCase *tc)
 {
    tcase_add_test(tc, evas_render_engines);
    tcase_add_test(tc, evas_render_lookup);
+   tcase_add_test(tc, evas_render_stats);
 }
@@ -0,0 +1,204 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "evas_suite.h"
+#include "Evas.h"
+#include "Evas_Engine_Buffer.h"
+#include "evas_tests_cpu.h"
+
+#define TEST_FONT_SOURCE TESTS_SRC_DIR "/TestFont.eet"
+
+/* odd sizes and offsets so every span has an unaligned head and tail */
+#define OUT_W 203
+#define OUT_H 121
+#define IMG_W 97
+#define IMG_H 53
+
+/* plain C reference */
+static const char *const _cpu_c[] = {
+   "EVAS_CPU_NO_MMX", "EVAS_CPU_NO_MMX2", "EVAS_CPU_NO_SSE",
+   "EVAS_CPU_NO_SSE3", "EVAS_CPU_NO_AVX2", NULL
+};
+
+/* only the widest vector paths, everything they lack falls back to C as
+ * in the reference */
+static const char *const _cpu_avx2[] = {
+   "EVAS_CPU_NO_MMX", "EVAS_CPU_NO_MMX2", "EVAS_CPU_NO_SSE",
+   "EVAS_CPU_NO_SSE3", NULL
+};
+
+static void
+_image_fill(unsigned int *data, Eina_Bool alpha)
+{
+   unsigned int seed = 0x1234567;
+   int i;
+
+   for (i = 0; i < IMG_W * IMG_H; i++)
+     {
+        unsigned int a, r, g, b;
+
+        seed = (seed * 1103515245) + 12345;
+        a = (seed >> 24) & 0xff;
+        /* some fully transparent and fully opaque runs */
+        if ((i / 13) % 5 == 0) a = 0;
+        else if ((i / 11) % 4 == 0) a = 0xff;
+        if (!alpha) a = 0xff;
+        r = ((seed >> 16) & 0xff) * a / 255;
+        g = ((seed >> 8) & 0xff) * a / 255;
+        b = (seed & 0xff) * a / 255;
+        data[i] = (a << 24) | (r << 16) | (g << 8) | b;
+     }
+}
+
+static Evas_Object *
+_image_add(Evas *evas, unsigned int *data, Eina_Bool alpha,
+           int x, int y, int r, int g, int b, int a, Evas_Render_Op op)
+{
+   Evas_Object *o;
+
+   o = evas_object_image_filled_add(evas);
+   evas_object_image_size_set(o, IMG_W, IMG_H);
+   evas_object_image_alpha_set(o, alpha);
+   evas_object_image_data_copy_set(o, data);
+   evas_object_image_smooth_scale_set(o, EINA_FALSE);
+   evas_object_color_set(o, r, g, b, a);
+   evas_object_render_op_set(o, op);
+   evas_object_move(o, x, y);
+   evas_object_resize(o, IMG_W, IMG_H);
+   evas_object_show(o);
+
+   return o;
+}
+
+static Evas_Object *
+_rect_add(Evas *evas, int x, int y, int w, int h,
+          int r, int g, int b, int a, Evas_Render_Op op)
+{
+   Evas_Object *o;
+
+   o = evas_object_rectangle_add(evas);
+   evas_object_color_set(o, r, g, b, a);
+   evas_object_render_op_set(o, op);
+   evas_object_move(o, x, y);
+   evas_object_resize(o, w, h);
+   evas_object_show(o);
+
+   return o;
+}
+
+static void
+_scene_render(unsigned int *pixels)
+{
+   Evas *evas;
+   Evas_Engine_Info_Buffer *einfo;
+   Evas_Object *o;
+   unsigned int *img, *img_solid;
+
+   img = malloc(IMG_W * IMG_H * sizeof (unsigned int));
+   img_solid = malloc(IMG_W * IMG_H * sizeof (unsigned int));
+   _image_fill(img, EINA_TRUE);
+   _image_fill(img_solid, EINA_FALSE);
+
+   evas_init();
+   evas = evas_new();
+   evas_output_method_set(evas, evas_render_method_lookup("buffer"));
+   einfo = (Evas_Engine_Info_Buffer *)evas_engine_info_get(evas);
+   einfo->info.depth_type = EVAS_ENGINE_BUFFER_DEPTH_ARGB32;
+   einfo->info.dest_buffer = pixels;
+   einfo->info.dest_buffer_row_bytes = OUT_W * sizeof (unsigned int);
+   einfo->info.use_color_key = 0;
+   einfo->info.alpha_threshold = 0;
+   einfo->info.func.new_update_region = NULL;
+   einfo->info.func.free_update_region = NULL;
+   evas_engine_info_set(evas, (Evas_Engine_Info *)einfo);
+   evas_output_size_set(evas, OUT_W, OUT_H);
+   evas_output_viewport_set(evas, 0, 0, OUT_W, OUT_H);
+
+   _rect_add(evas, 0, 0, OUT_W, OUT_H, 30, 60, 90, 255, EVAS_RENDER_BLEND);
+   _rect_add(evas, 3, 5, 150, 60, 60, 20, 10, 128, EVAS_RENDER_BLEND);
+   _rect_add(evas, 11, 70, 77, 31, 90, 0, 45, 200, EVAS_RENDER_COPY);
+
+   _image_add(evas, img, EINA_TRUE, 7, 9, 255, 255, 255, 255,
+              EVAS_RENDER_BLEND);
+   _image_add(evas, img, EINA_TRUE, 41, 27, 120, 90, 60, 180,
+              EVAS_RENDER_BLEND);
+   _image_add(evas, img, EINA_TRUE, 63, 3, 128, 128, 128, 128,
+              EVAS_RENDER_BLEND);
+   _image_add(evas, img, EINA_TRUE, 101, 51, 40, 180, 20, 255,
+              EVAS_RENDER_BLEND);
+   _image_add(evas, img_solid, EINA_FALSE, 99, 1, 100, 50, 25, 140,
+              EVAS_RENDER_BLEND);
+   _image_add(evas, img_solid, EINA_FALSE, 5, 61, 170, 200, 90, 255,
+              EVAS_RENDER_BLEND);
+
+   _image_add(evas, img, EINA_TRUE, 131, 67, 200, 100, 50, 220,
+              EVAS_RENDER_COPY);
+   _image_add(evas, img, EINA_TRUE, 17, 33, 255, 255, 255, 255,
+              EVAS_RENDER_MUL);
+   _image_add(evas, img, EINA_TRUE, 113, 13, 150, 120, 100, 160,
+              EVAS_RENDER_MUL);
+   _image_add(evas, img, EINA_TRUE, 71, 59, 255, 255, 255, 255,
+              EVAS_RENDER_MASK);
+
+   _rect_add(evas, 23, 15, 99, 41, 200, 160, 120, 210, EVAS_RENDER_MUL);
+   _rect_add(evas, 141, 29, 51, 77, 0, 0, 0, 100, EVAS_RENDER_MASK);
+
+   o = evas_object_text_add(evas);
+   evas_object_text_font_source_set(o, TEST_FONT_SOURCE);
+   evas_object_text_font_set(o, "DejaVuSans", 17);
+   evas_object_text_text_set(o, "Pixel exact? Yes!");
+   evas_object_color_set(o, 200, 100, 0, 220);
+   evas_object_move(o, 9, 41);
+   evas_object_show(o);
+
+   o = evas_object_text_add(evas);
+   evas_object_text_font_source_set(o, TEST_FONT_SOURCE);
+   evas_object_text_font_set(o, "DejaVuSans", 23);
+   evas_object_text_text_set(o, "Masked glyphs");
+   evas_object_color_set(o, 255, 255, 255, 255);
+   evas_object_move(o, 37, 83);
+   evas_object_show(o);
+
+   evas_render(evas);
+
+   evas_free(evas);
+   evas_shutdown();
+
+   free(img);
+   free(img_solid);
+}
+
+START_TEST(evas_render_ops_simd_exact)
+{
+   unsigned int *ref, *simd;
+   size_t size = OUT_W * OUT_H * sizeof (unsigned int);
+
+   if (!(_cpu_features_usable() & EINA_CPU_AVX2))
+     {
+        fprintf(stderr, "evas_render_ops_simd_exact: no AVX2, skipped\n");
+        return;
+     }
+
+   ref = calloc(1, size);
+   simd = calloc(1, size);
+   fail_if(!ref || !simd);
+
+   _cpu_render_child(_cpu_c, _scene_render, ref, size);
+   _cpu_render_child(_cpu_avx2, _scene_render, simd, size);
+
+   fail_if(memcmp(ref, simd, size) != 0);
+
+   free(ref);
+   free(simd);
+}
+END_TEST
+
+void evas_test_render_ops(TCase *tc)
+{
+   tcase_add_test(tc, evas_render_ops_simd_exact);
+}
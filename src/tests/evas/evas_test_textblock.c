@@ -8,6 +8,7 @@
 #endif
 
 #include <stdio.h>
+#include <string.h>
 
 #include <Eina.h>
 
@@ -15,6 +16,7 @@
 #include "Evas.h"
 
 #include "evas_tests_helpers.h"
+#include "../../lib/evas/include/evas_thread_pool.h"
 
 /* Functions defined in evas_object_textblock.c */
 EAPI Eina_Bool
@@ -2861,6 +2863,293 @@ START_TEST(evas_textblock_size)
 }
 END_TEST
 
+/* Check the layout of tb matches the one of a freshly laid out copy */
+static void
+_textblock_layout_fresh_check(Evas *evas, Evas_Object *tb)
+{
+   Evas_Object *fresh;
+   Evas_Coord w, h, fw, fh;
+   Evas_Coord x, y, lw, lh, fx, fy, flw, flh;
+   int line;
+
+   fresh = evas_object_textblock_add(evas);
+   evas_object_textblock_legacy_newline_set(fresh, EINA_FALSE);
+   evas_object_textblock_style_set(fresh, evas_object_textblock_style_get(tb));
+   if (evas_object_textblock_style_user_peek(tb))
+      evas_object_textblock_style_user_push(fresh,
+            (Evas_Textblock_Style *) evas_object_textblock_style_user_peek(tb));
+   evas_object_textblock_text_markup_set(fresh,
+         evas_object_textblock_text_markup_get(tb));
+   evas_object_geometry_get(tb, NULL, NULL, &w, &h);
+   evas_object_resize(fresh, w, h);
+
+   evas_object_textblock_size_formatted_get(tb, &w, &h);
+   evas_object_textblock_size_formatted_get(fresh, &fw, &fh);
+   ck_assert_int_eq(w, fw);
+   ck_assert_int_eq(h, fh);
+
+   for (line = 0 ;
+         evas_object_textblock_line_number_geometry_get(fresh, line,
+            &fx, &fy, &flw, &flh) ; line++)
+     {
+        fail_if(!evas_object_textblock_line_number_geometry_get(tb, line,
+                 &x, &y, &lw, &lh));
+        ck_assert_int_eq(x, fx);
+        ck_assert_int_eq(y, fy);
+        ck_assert_int_eq(lw, flw);
+        ck_assert_int_eq(lh, flh);
+     }
+   fail_if(evas_object_textblock_line_number_geometry_get(tb, line,
+            &x, &y, &lw, &lh));
+
+   evas_object_del(fresh);
+}
+
+START_TEST(evas_textblock_relayout)
+{
+   START_TB_TEST();
+   Evas_Textblock_Style *newst;
+   Evas_Coord w, h, nw, nh;
+   const char *buf = "This is the widest paragraph of them all."
+      "<ps/>Short.<ps/>A bit longer one.<ps/>End.";
+
+   evas_object_textblock_text_markup_set(tb, buf);
+   evas_object_resize(tb, 500, 500);
+   evas_object_textblock_size_formatted_get(tb, &w, &h);
+   evas_object_textblock_size_native_get(tb, &nw, &nh);
+   ck_assert_int_eq(w, nw);
+   ck_assert_int_eq(h, nh);
+
+   /* Only the edited paragraph is laid out again, the widest one must
+    * still count in the formatted width. */
+   evas_textblock_cursor_paragraph_first(cur);
+   evas_textblock_cursor_paragraph_next(cur);
+   evas_textblock_cursor_text_prepend(cur, "a");
+   evas_object_textblock_size_formatted_get(tb, &nw, &nh);
+   ck_assert_int_eq(w, nw);
+   ck_assert_int_eq(h, nh);
+   _textblock_layout_fresh_check(evas, tb);
+
+   /* Width changes the paragraphs don't depend on */
+   evas_object_resize(tb, 1000, 500);
+   _textblock_layout_fresh_check(evas, tb);
+   evas_object_resize(tb, w, 500);
+   _textblock_layout_fresh_check(evas, tb);
+
+   /* Wrapping paragraphs, narrowing, widening and editing */
+   newst = evas_textblock_style_new();
+   fail_if(!newst);
+   evas_textblock_style_set(newst, "DEFAULT='wrap=word'");
+   evas_object_textblock_style_user_push(tb, newst);
+   evas_object_resize(tb, w / 2, 500);
+   _textblock_layout_fresh_check(evas, tb);
+   evas_object_textblock_size_formatted_get(tb, NULL, &nh);
+   fail_if(nh <= h);
+   evas_textblock_cursor_paragraph_last(cur);
+   evas_textblock_cursor_text_prepend(cur, "The ");
+   _textblock_layout_fresh_check(evas, tb);
+   evas_object_resize(tb, w + 50, 500);
+   _textblock_layout_fresh_check(evas, tb);
+   evas_object_resize(tb, w / 3, 500);
+   _textblock_layout_fresh_check(evas, tb);
+
+   /* Aligned lines move with the width */
+   evas_textblock_style_set(newst, "DEFAULT='align=center'");
+   evas_object_resize(tb, 500, 500);
+   _textblock_layout_fresh_check(evas, tb);
+   evas_object_resize(tb, 700, 500);
+   _textblock_layout_fresh_check(evas, tb);
+
+   evas_object_textblock_style_user_pop(tb);
+   evas_textblock_style_free(newst);
+
+   END_TB_TEST();
+}
+END_TEST
+
+START_TEST(evas_textblock_virtual_layout)
+{
+   START_TB_TEST();
+   Evas_Object *fresh;
+   Evas_Textblock_Style *newst;
+   Evas_Textblock_Cursor *fcur;
+   Eina_Strbuf *buf;
+   Evas_Coord x, y, w, h, fx, fy, fw, fh;
+   int i, line;
+
+   buf = eina_strbuf_new();
+   for (i = 0 ; i < 500 ; i++)
+     {
+        if (i % 7 == 3)
+           eina_strbuf_append_printf(buf,
+                 "<font_size=%d>Paragraph %d</font_size><ps/>", 10 + i % 20, i);
+        else
+           eina_strbuf_append_printf(buf,
+                 "Paragraph %d is long enough to wrap a couple of times.<ps/>",
+                 i);
+     }
+
+   newst = evas_textblock_style_new();
+   fail_if(!newst);
+   evas_textblock_style_set(newst, "DEFAULT='wrap=word'");
+   evas_object_textblock_style_user_push(tb, newst);
+
+   fail_if(evas_object_textblock_virtual_layout_get(tb));
+   evas_object_textblock_virtual_layout_set(tb, EINA_TRUE);
+   fail_if(!evas_object_textblock_virtual_layout_get(tb));
+   evas_object_resize(tb, 200, 500);
+   evas_object_textblock_text_markup_set(tb, eina_strbuf_string_get(buf));
+
+   fresh = evas_object_textblock_add(evas);
+   evas_object_textblock_legacy_newline_set(fresh, EINA_FALSE);
+   evas_object_textblock_style_set(fresh, st);
+   evas_object_textblock_style_user_push(fresh, newst);
+   evas_object_resize(fresh, 200, 500);
+   evas_object_textblock_text_markup_set(fresh, eina_strbuf_string_get(buf));
+   fcur = evas_object_textblock_cursor_new(fresh);
+
+   /* Everything in view is laid out for real */
+   evas_object_textblock_size_formatted_get(tb, &w, &h);
+   fail_if((w <= 0) || (h <= 500));
+   for (line = 0 ;
+         evas_object_textblock_line_number_geometry_get(fresh, line,
+            &fx, &fy, &fw, &fh) && (fy < 500) ; line++)
+     {
+        fail_if(!evas_object_textblock_line_number_geometry_get(tb, line,
+                 &x, &y, &w, &h));
+        ck_assert_int_eq(x, fx);
+        ck_assert_int_eq(y, fy);
+        ck_assert_int_eq(w, fw);
+        ck_assert_int_eq(h, fh);
+     }
+
+   /* Paragraphs out of view are laid out when asked about */
+   evas_textblock_cursor_paragraph_last(cur);
+   evas_textblock_cursor_paragraph_prev(cur);
+   evas_textblock_cursor_paragraph_last(fcur);
+   evas_textblock_cursor_paragraph_prev(fcur);
+   evas_textblock_cursor_geometry_get(cur, &x, &y, &w, &h, NULL,
+         EVAS_TEXTBLOCK_CURSOR_BEFORE);
+   evas_textblock_cursor_geometry_get(fcur, &fx, &fy, &fw, &fh, NULL,
+         EVAS_TEXTBLOCK_CURSOR_BEFORE);
+   ck_assert_int_eq(x, fx);
+   ck_assert_int_eq(h, fh);
+
+   /* Scrolling and editing far away from the top */
+   evas_object_textblock_size_formatted_get(tb, NULL, &h);
+   evas_object_move(tb, 0, -h / 2);
+   fail_if(!evas_textblock_cursor_char_coord_set(cur, 10, h / 2 + 250));
+   evas_textblock_cursor_paragraph_char_first(cur);
+   evas_textblock_cursor_text_prepend(cur, "Edited: ");
+   evas_object_textblock_size_formatted_get(tb, &w, &h);
+   fail_if((w <= 0) || (h <= 500));
+
+   /* Turning it off lays out everything */
+   evas_object_textblock_virtual_layout_set(tb, EINA_FALSE);
+   _textblock_layout_fresh_check(evas, tb);
+
+   evas_textblock_cursor_free(fcur);
+   evas_object_del(fresh);
+   evas_object_textblock_style_user_pop(tb);
+   evas_textblock_style_free(newst);
+   eina_strbuf_free(buf);
+
+   END_TB_TEST();
+}
+END_TEST
+
+static void
+_textblock_pool_lines_get(Evas *evas, const char *markup, Eina_Inarray *lines)
+{
+   Evas_Object *tb;
+   Evas_Textblock_Style *st;
+   Evas_Textblock_Cursor *cur;
+   Evas_Coord geom[4];
+   int line;
+
+   tb = evas_object_textblock_add(evas);
+   fail_if(!tb);
+   evas_object_textblock_legacy_newline_set(tb, EINA_FALSE);
+   st = evas_textblock_style_new();
+   fail_if(!st);
+   evas_textblock_style_set(st, style_buf);
+   evas_object_textblock_style_set(tb, st);
+   evas_object_resize(tb, 150, 500);
+   evas_object_textblock_text_markup_set(tb, markup);
+   cur = evas_object_textblock_cursor_new(tb);
+
+   /* Lay it out, then change the width and part of the text */
+   for (line = 0 ; evas_object_textblock_line_number_geometry_get(tb, line,
+            &geom[0], &geom[1], &geom[2], &geom[3]) ; line++)
+      eina_inarray_push(lines, geom);
+
+   evas_object_resize(tb, 200, 500);
+   for (line = 0 ; line < 100 ; line++)
+     {
+        if (line % 3 == 0)
+           evas_textblock_cursor_text_prepend(cur, "more words ");
+        evas_textblock_cursor_paragraph_next(cur);
+     }
+   for (line = 0 ; evas_object_textblock_line_number_geometry_get(tb, line,
+            &geom[0], &geom[1], &geom[2], &geom[3]) ; line++)
+      eina_inarray_push(lines, geom);
+
+   evas_textblock_cursor_free(cur);
+   evas_object_del(tb);
+   evas_textblock_style_free(st);
+}
+
+START_TEST(evas_textblock_pool)
+{
+   START_TB_TEST();
+   Eina_Inarray *serial, *pool;
+   Eina_Strbuf *buf;
+   unsigned int threads;
+   int i;
+
+   /* The right to left and mixed paragraphs get their bidi properties
+    * from the pool too, when evas is built with fribidi */
+   buf = eina_strbuf_new();
+   for (i = 0 ; i < 200 ; i++)
+     {
+        if (i % 4 == 0)
+           eina_strbuf_append_printf(buf,
+                 "<wrap=mixed>Paragraph %d averyveryverylongword</wrap><ps/>",
+                 i);
+        else if (i % 4 == 1)
+           eina_strbuf_append_printf(buf,
+                 "<wrap=word>שלום %d עולם test עברית <b>efl</b> نص عربي"
+                 " ושורה ארוכה מספיק כדי לעטוף</wrap><ps/>", i);
+        else
+           eina_strbuf_append_printf(buf,
+                 "<wrap=word>Paragraph %d is long enough to wrap <b>a few</b>"
+                 " times.<br/>And it has a second line.</wrap><ps/>", i);
+     }
+
+   serial = eina_inarray_new(sizeof(Evas_Coord) * 4, 0);
+   pool = eina_inarray_new(sizeof(Evas_Coord) * 4, 0);
+
+   /* Paragraphs prepared on other threads are laid out the same */
+   threads = evas_thread_pool_threads_get();
+   evas_thread_pool_threads_set(1);
+   _textblock_pool_lines_get(evas, eina_strbuf_string_get(buf), serial);
+   evas_thread_pool_threads_set(4);
+   _textblock_pool_lines_get(evas, eina_strbuf_string_get(buf), pool);
+   evas_thread_pool_threads_set(threads);
+
+   fail_if(eina_inarray_count(serial) < 400);
+   ck_assert_int_eq(eina_inarray_count(serial), eina_inarray_count(pool));
+   fail_if(memcmp(serial->members, pool->members,
+            eina_inarray_count(serial) * serial->member_size));
+
+   eina_inarray_free(serial);
+   eina_inarray_free(pool);
+   eina_strbuf_free(buf);
+
+   END_TB_TEST();
+}
+END_TEST
+
 void evas_test_textblock(TCase *tc)
 {
    tcase_add_test(tc, evas_textblock_simple);
@@ -2869,6 +3158,9 @@ void evas_test_textblock(TCase *tc)
    tcase_add_test(tc, evas_textblock_split_cursor);
 #endif
    tcase_add_test(tc, evas_textblock_size);
+   tcase_add_test(tc, evas_textblock_relayout);
+   tcase_add_test(tc, evas_textblock_virtual_layout);
+   tcase_add_test(tc, evas_textblock_pool);
    tcase_add_test(tc, evas_textblock_editing);
    tcase_add_test(tc, evas_textblock_style);
    tcase_add_test(tc, evas_textblock_evas);
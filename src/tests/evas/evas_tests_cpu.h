@@ -0,0 +1,84 @@
+#ifndef EVAS_TESTS_CPU_H
+#define EVAS_TESTS_CPU_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+/* Evas picks the cpu features it uses once per process, reading the
+ * EVAS_CPU_NO_* variables, so every set of them has to be rendered in its
+ * own child. The variables are only ever set there, the test process
+ * keeps its environment. */
+
+typedef void (*Evas_Test_Cpu_Render)(unsigned int *pixels);
+
+/* the vector paths evas was built with that this cpu can run */
+static Eina_Cpu_Features
+_cpu_features_usable(void)
+{
+   Eina_Cpu_Features usable = 0;
+   Eina_Cpu_Features cpu;
+
+   eina_init();
+   cpu = eina_cpu_features_get();
+   eina_shutdown();
+
+#ifdef BUILD_SSE3
+   usable |= cpu & EINA_CPU_SSE3;
+#endif
+#ifdef BUILD_AVX2
+   usable |= cpu & EINA_CPU_AVX2;
+#endif
+#if defined(BUILD_NEON) && (defined(__arm__) || defined(__aarch64__))
+   /* eina doesn't detect it, evas probes it when it starts */
+   usable |= EINA_CPU_NEON;
+#endif
+   (void) cpu;
+
+   return usable;
+}
+
+/* render into pixels from a child with the NULL terminated list of
+ * EVAS_CPU_NO_* variables in disable set */
+static void
+_cpu_render_child(const char *const *disable, Evas_Test_Cpu_Render render,
+                  unsigned int *pixels, size_t size)
+{
+   size_t done;
+   int fds[2];
+   int status;
+   pid_t pid;
+
+   fail_if(pipe(fds) != 0);
+   pid = fork();
+   fail_if(pid < 0);
+   if (pid == 0)
+     {
+        close(fds[0]);
+        for (; *disable; disable++)
+          setenv(*disable, "1", 1);
+        render(pixels);
+        for (done = 0; done < size; )
+          {
+             ssize_t n = write(fds[1], (char *)pixels + done, size - done);
+             if (n <= 0) _exit(1);
+             done += n;
+          }
+        _exit(0);
+     }
+   close(fds[1]);
+
+   for (done = 0; done < size; )
+     {
+        ssize_t n = read(fds[0], (char *)pixels + done, size - done);
+        fail_if(n <= 0);
+        done += n;
+     }
+   close(fds[0]);
+   fail_if(waitpid(pid, &status, 0) != pid);
+   fail_if(!WIFEXITED(status) || (WEXITSTATUS(status) != 0));
+}
+
+#endif